@@ -182,14 +182,16 @@
                     {{ assert(member.annotation != "const*const*") }}
                     auto memberLength = {{member_length(member, "record.")}};
                     result += memberLength * {{member_transfer_sizeof(member)}};
-                    //* Structures might contain more pointers so we need to add their extra size as well.
-                    {% if member.type.category == "structure" %}
+                    //* Structures might contain more pointers so we need to add their extra size
+                    //* as well. Wire-transparent structures are plain data that cannot contain
+                    //* pointers, so the per-element walk is skipped for them.
+                    {% if member.type.category == "structure" and not member.type.is_wire_transparent %}
                         for (decltype(memberLength) i = 0; i < memberLength; ++i) {
                             {{assert(member.annotation == "const*")}}
                             result += {{as_cType(member.type.name)}}GetExtraRequiredSize(record.{{as_varName(member.name)}}[i]);
                         }
                     {% endif %}
-                {% elif member.type.category == "structure" %}
+                {% elif member.type.category == "structure" and not member.type.is_wire_transparent %}
                     result += {{as_cType(member.type.name)}}GetExtraRequiredSize(record.{{as_varName(member.name)}});
                 {% endif %}
             }
@@ -75,7 +75,10 @@ namespace dawn::wire::server {
                 case ObjectType::{{type.name.CamelCase()}}: {
                     auto* data = {{type.name.CamelCase()}}Objects().Get(objectId);
                     if (data == nullptr) {
-                        return false;
+                        //* Destroying an ID that was already freed server-side is benign: it
+                        //* happens when the client releases an object whose creation request
+                        //* failed after its callback ran speculatively.
+                        return {{type.name.CamelCase()}}Objects().IsFreedId(objectId);
                     }
                     if (data->state == AllocationState::Allocated) {
                         ASSERT(data->handle != nullptr);
@@ -89,6 +89,19 @@ namespace dawn::wire::server {
     {% endfor %}
 
     const volatile char* Server::HandleCommandsImpl(const volatile char* commands, size_t size) {
+        //* Mark the stream as being handled for the duration of this call: completions that
+        //* fire while it is set accumulate into watermarks flushed at the end of the stream,
+        //* while completions outside of it (e.g. from the embedder ticking the device) are
+        //* returned immediately. A local class is used so every return path resets the flag.
+        struct ScopedHandlingCommands {
+            explicit ScopedHandlingCommands(Server* server) : server(server) {
+                server->mIsHandlingCommands = true;
+            }
+            ~ScopedHandlingCommands() { server->mIsHandlingCommands = false; }
+            Server* server;
+        };
+        ScopedHandlingCommands scopedHandlingCommands(this);
+
         DeserializeBuffer deserializeBuffer(commands, size);
 
         while (deserializeBuffer.AvailableSize() >= sizeof(CmdHeader) + sizeof(WireCmd)) {
@@ -105,6 +118,10 @@ namespace dawn::wire::server {
 
             WireCmd cmdId = *static_cast<const volatile WireCmd*>(static_cast<const volatile void*>(
                 deserializeBuffer.Buffer() + sizeof(CmdHeader)));
+
+            // Give the server a chance to flush writes coalesced across the previous commands.
+            WillHandleCommand(cmdId);
+
             bool success = false;
             switch (cmdId) {
                 {% for command in cmd_records["command"] %}
@@ -126,6 +143,11 @@ namespace dawn::wire::server {
             return nullptr;
         }
 
+        // The end of the stream is also a barrier for coalesced queue writes, and the point
+        // where work-done watermarks accumulated during the stream are returned.
+        FlushPendingQueueWrites();
+        FlushQueueWorkDoneWatermarks();
+
         return commands;
     }
 
@@ -207,6 +207,39 @@ DAWN_NATIVE_EXPORT std::vector<const char*> GetProcMapNamesForTesting();
 
 DAWN_NATIVE_EXPORT bool DeviceTick(WGPUDevice device);
 
+// Registers a callback invoked with the device's current memory usage and OS-provided budget,
+// in bytes, whenever a backend observes that either changed (fed by DXGI memory budget queries
+// on D3D12 and VK_EXT_memory_budget on Vulkan). A budget of 0 means the backend cannot report
+// one. The embedder can react to pressure by calling ReduceMemoryUsage. Pass a null callback
+// to unregister.
+using MemoryBudgetCallback = void (*)(uint64_t currentUsage, uint64_t budget, void* userdata);
+DAWN_NATIVE_EXPORT void SetMemoryBudgetCallback(WGPUDevice device,
+                                                MemoryBudgetCallback callback,
+                                                void* userdata);
+
+// Frees as much memory retained by the device's internal pools and caches as possible (staging
+// buffer pools, pooled backend heaps) and flushes deferred deallocations for GPU work that
+// already completed. Resources still referenced by the application are unaffected.
+DAWN_NATIVE_EXPORT void ReduceMemoryUsage(WGPUDevice device);
+
+// A snapshot of the memory held by one of the device's internal allocators, in bytes.
+struct AllocatorMemoryInfo {
+    // Identifies the allocator, for example "upload staging". Points to a string literal.
+    const char* name = nullptr;
+    // Memory the allocator currently holds reserved from the OS or driver.
+    uint64_t reservedMemory = 0;
+    // The part of |reservedMemory| occupied by live allocations. The difference is pooled free
+    // memory plus fragmentation, which ReduceMemoryUsage can partially reclaim.
+    uint64_t usedMemory = 0;
+    // High-water mark of |usedMemory| over the device's lifetime, or 0 when the allocator
+    // doesn't track one.
+    uint64_t peakUsedMemory = 0;
+};
+
+// Returns a per-allocator breakdown of the memory the device holds, for OOM triage and
+// capacity planning. Which allocators are reported depends on the backend.
+DAWN_NATIVE_EXPORT std::vector<AllocatorMemoryInfo> GetMemoryReport(WGPUDevice device);
+
 // ErrorInjector functions used for testing only. Defined in dawn_native/ErrorInjector.cpp
 DAWN_NATIVE_EXPORT void EnableErrorInjector();
 DAWN_NATIVE_EXPORT void DisableErrorInjector();
@@ -15,11 +15,35 @@
 #ifndef INCLUDE_DAWN_NATIVE_NULLBACKEND_H_
 #define INCLUDE_DAWN_NATIVE_NULLBACKEND_H_
 
+#include <cstdint>
+
 #include "dawn/dawn_wsi.h"
 #include "dawn/native/DawnNative.h"
 
 namespace dawn::native::null {
 DAWN_NATIVE_EXPORT DawnSwapChainImplementation CreateNativeSwapChainImpl();
+
+// Per-command costs, in nanoseconds of simulated GPU time, charged by the null backend when
+// the null_backend_simulate_timeline toggle is enabled. Submissions then complete on a
+// simulated timeline instead of instantly, so frontend and wire scheduling can be load-tested
+// with many fake devices on one machine.
+struct DAWN_NATIVE_EXPORT SimulatedTimelineCosts {
+    // Fixed cost charged once per queue submission.
+    uint64_t submitOverheadNs = 20000;
+    // Cost of each draw in a render pass or render bundle.
+    uint64_t drawNs = 500;
+    // Cost of each dispatch in a compute pass.
+    uint64_t dispatchNs = 500;
+    // Cost of each copy or clear command.
+    uint64_t copyNs = 2000;
+    // Cost of every other command (state setting, debug markers, pass boundaries, ...).
+    uint64_t commandNs = 100;
+};
+
+// Replaces the cost model used by |device|. Has no effect unless the device was created with
+// the null_backend_simulate_timeline toggle enabled.
+DAWN_NATIVE_EXPORT void SetSimulatedTimelineCosts(WGPUDevice device,
+                                                  const SimulatedTimelineCosts& costs);
 }  // namespace dawn::native::null
 
 #endif  // INCLUDE_DAWN_NATIVE_NULLBACKEND_H_
@@ -31,6 +31,41 @@ enum class TraceCategory {
     GPUWork,     // Actual GPU work
 };
 
+// Always-on counters for hot-path instrumentation. Unlike trace events and histograms an
+// increment is a single relaxed atomic add on a thread-sharded cache line, cheap enough for
+// per-draw call sites, so fleet-wide monitoring does not require enabling tracing.
+enum class MetricCounter : uint32_t {
+    CommandsEncoded,       // Commands recorded into command buffers and bundles.
+    BarriersEmitted,       // Resource barriers handed to the backend API.
+    DescriptorsAllocated,  // Shader-visible descriptors (or descriptor sets) allocated.
+    ObjectCacheHits,       // Lookups served from the device object caches.
+    ObjectCacheMisses,     // Lookups that had to create a new object.
+    StagingBytesAllocated,  // Bytes allocated from upload staging memory.
+    StagingBufferPoolHits,    // Staging buffer acquisitions served from the device reuse pool.
+    StagingBufferPoolMisses,  // Staging buffer acquisitions that had to create a new buffer.
+    CommandAllocatorsCreated,   // Backend command allocators created because the pool was empty.
+    CommandAllocatorPoolWaits,  // Reservations that stalled on a fence with the pool at its cap.
+
+    Count,  // Must be last.
+};
+
+struct MetricsSnapshot {
+    uint64_t counters[static_cast<uint32_t>(MetricCounter::Count)] = {};
+
+    uint64_t Get(MetricCounter counter) const {
+        return counters[static_cast<uint32_t>(counter)];
+    }
+};
+
+// Adds |value| to |counter|. Process-global and thread-safe.
+DAWN_PLATFORM_EXPORT void AddMetric(MetricCounter counter, uint64_t value);
+
+// Returns a consistent-enough view of all counters: each counter is the sum of its shards,
+// read with relaxed loads, so totals may lag concurrent increments slightly.
+DAWN_PLATFORM_EXPORT MetricsSnapshot SnapshotMetrics();
+
+DAWN_PLATFORM_EXPORT void ResetMetricsForTesting();
+
 class DAWN_PLATFORM_EXPORT CachingInterface {
   public:
     CachingInterface();
@@ -50,6 +85,22 @@ class DAWN_PLATFORM_EXPORT CachingInterface {
                            const void* value,
                            size_t valueSize) = 0;
 
+    // Describes a cached value stored as a contiguous region of an open file.
+    struct FileRegion {
+        int fd = -1;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    // Optional zero-copy variant of LoadData. An embedder whose backing store is file-based
+    // may fill |regionOut| with the location of the value for |key| and return true; Dawn then
+    // memory-maps the region instead of copying the bytes onto the heap, so large values page
+    // in on demand and are shared between processes. The file descriptor only needs to stay
+    // valid for the duration of the call; the mapped bytes must not be mutated for the
+    // lifetime of the store entry. Returning false (the default) makes Dawn fall back to
+    // LoadData.
+    virtual bool LoadDataFileRegion(const void* key, size_t keySize, FileRegion* regionOut);
+
   private:
     CachingInterface(const CachingInterface&) = delete;
     CachingInterface& operator=(const CachingInterface&) = delete;
@@ -17,6 +17,7 @@
 
 #include <cstdint>
 #include <limits>
+#include <memory>
 
 #include "dawn/webgpu.h"
 #include "dawn/wire/dawn_wire_export.h"
@@ -50,6 +51,52 @@ class DAWN_WIRE_EXPORT CommandHandler {
     virtual const volatile char* HandleCommands(const volatile char* commands, size_t size) = 0;
 };
 
+// Wraps |serializer| so that each flush batch is framed and LZ4-compressed before being
+// forwarded, for transports where bandwidth is the bottleneck. Batches that do not shrink are
+// stored uncompressed in the frame. Commands produced through the returned serializer must be
+// handled through a handler wrapped with CreateDecompressingCommandHandler; both endpoints
+// must agree on whether compression is in use. |serializer| must outlive the returned object.
+DAWN_WIRE_EXPORT std::unique_ptr<CommandSerializer> CreateCompressingCommandSerializer(
+    CommandSerializer* serializer);
+
+// Runs the HandleCommands of several wrapped CommandHandlers on a shared pool of worker
+// threads. Commands for one wrapped handler always run in order and never concurrently, so
+// per-object ordering within a connection is preserved; distinct handlers (for example one
+// WireServer per client connection) run in parallel. Because processing is asynchronous, a
+// wrapped handler copies the command data, and processing errors surface on the next call
+// for that handler instead of the failing one.
+class DAWN_WIRE_EXPORT CommandHandlerPool {
+  public:
+    // threadCount == 0 selects the hardware concurrency.
+    explicit CommandHandlerPool(uint32_t threadCount = 0);
+    ~CommandHandlerPool();
+
+    // |handler| must outlive the returned object. The returned handler's destructor drains
+    // the commands already submitted for it.
+    std::unique_ptr<CommandHandler> Wrap(CommandHandler* handler);
+
+    // Blocks until all submitted commands have been processed.
+    void WaitIdle();
+
+  private:
+    class Impl;
+    std::shared_ptr<Impl> mImpl;
+};
+
+// Wraps |serializer| so that GetCmdSpace may be called from multiple threads without
+// contending on the shared buffer: each thread stages commands into its own buffer and the
+// staged commands are merged in recording order when Flush runs. Flush (and destruction) must
+// still be externally synchronized against recording, and per-object wire client state keeps
+// its usual threading requirements. |serializer| must outlive the returned object.
+DAWN_WIRE_EXPORT std::unique_ptr<CommandSerializer> CreateMultiProducerCommandSerializer(
+    CommandSerializer* serializer);
+
+// Wraps |handler| with the streaming decompressor matching CreateCompressingCommandSerializer,
+// reassembling frames that were split across transport packets. |handler| must outlive the
+// returned object.
+DAWN_WIRE_EXPORT std::unique_ptr<CommandHandler> CreateDecompressingCommandHandler(
+    CommandHandler* handler);
+
 }  // namespace dawn::wire
 
 // TODO(dawn:824): Remove once the deprecation period is passed.
@@ -61,6 +61,14 @@ struct ReservedInstance {
 struct DAWN_WIRE_EXPORT WireClientDescriptor {
     CommandSerializer* serializer;
     client::MemoryTransferService* memoryTransferService = nullptr;
+
+    // When set, RequestAdapter and RequestDevice callbacks fire immediately with a
+    // speculatively-successful result instead of waiting for the server's reply, so requests
+    // against an in-flight parent pipeline without round trips. If a request turns out to
+    // have failed, the error is backfilled asynchronously: a failed adapter fails subsequent
+    // RequestDevice calls on it, and a failed device runs its device lost callback. After a
+    // lost backfill the application must stop using the object and release it.
+    bool speculativeRequests = false;
 };
 
 class DAWN_WIRE_EXPORT WireClient : public CommandHandler {
@@ -159,7 +167,8 @@ class DAWN_WIRE_EXPORT MemoryTransferService {
 
         // Serialize a command to send the modified contents of
         // the subrange (offset, offset + size) of the allocation at buffer unmap
-        // This subrange is always the whole mapped region for now
+        // This subrange is the union of the writable ranges handed out for the mapping, or
+        // the whole mapped region when none were handed out
         // There could be nothing to be serialized (if using shared memory)
         virtual void SerializeDataUpdate(void* serializePointer, size_t offset, size_t size) = 0;
 
@@ -173,6 +182,12 @@ class DAWN_WIRE_EXPORT MemoryTransferService {
     MemoryTransferService& operator=(const MemoryTransferService&) = delete;
 };
 
+// Creates a MemoryTransferService that transfers mapped buffer data through POSIX shared
+// memory instead of copying it into the wire buffer. It must be paired with the server-side
+// service from WireServer.h and both sides must run on the same machine. Returns nullptr on
+// platforms without POSIX shared memory support.
+DAWN_WIRE_EXPORT std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService();
+
 // Backdoor to get the order of the ProcMap for testing
 DAWN_WIRE_EXPORT std::vector<const char*> GetProcMapNamesForTesting();
 }  // namespace client
@@ -34,6 +34,13 @@ struct DAWN_WIRE_EXPORT WireServerDescriptor {
     server::MemoryTransferService* memoryTransferService = nullptr;
 };
 
+// Framing of capture files written by WireServer::StartCapture: the two magic/version words,
+// then for each buffer passed to HandleCommands a little-endian uint64_t byte count followed by
+// the raw bytes. Replaying the buffers in order through another WireServer's HandleCommands
+// reproduces the stream exactly.
+static constexpr uint32_t kWireCaptureMagic = 0x64777363;   // 'dwsc'
+static constexpr uint32_t kWireCaptureVersion = 1;
+
 class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
   public:
     explicit WireServer(const WireServerDescriptor& descriptor);
@@ -70,6 +77,12 @@ class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
     // them periodically to ensure progress on asynchronous work is made.
     bool IsDeviceKnown(WGPUDevice device) const;
 
+    // Starts recording every buffer passed to HandleCommands to |filePath| in the format
+    // described above kWireCaptureMagic, for offline replay. Returns false if the file cannot
+    // be opened. Capture stops at StopCapture() or server destruction.
+    bool StartCapture(const char* filePath);
+    void StopCapture();
+
   private:
     std::unique_ptr<server::Server> mImpl;
 };
@@ -147,6 +160,10 @@ class DAWN_WIRE_EXPORT MemoryTransferService {
     MemoryTransferService(const MemoryTransferService&) = delete;
     MemoryTransferService& operator=(const MemoryTransferService&) = delete;
 };
+
+// Creates the server side of the shared memory MemoryTransferService; see the client-side
+// factory in WireClient.h. Returns nullptr on platforms without POSIX shared memory support.
+DAWN_WIRE_EXPORT std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService();
 }  // namespace server
 
 }  // namespace dawn::wire
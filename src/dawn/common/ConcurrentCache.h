@@ -15,40 +15,58 @@
 #ifndef SRC_DAWN_COMMON_CONCURRENTCACHE_H_
 #define SRC_DAWN_COMMON_CONCURRENTCACHE_H_
 
+#include <array>
 #include <mutex>
 #include <unordered_set>
 #include <utility>
 
 #include "dawn/common/NonCopyable.h"
 
+// The cache is sharded by the object's hash so that threads operating on different objects
+// (the common case when multiple threads create pipelines concurrently) lock different mutexes
+// and don't contend.
 template <typename T>
 class ConcurrentCache : public NonMovable {
   public:
     ConcurrentCache() = default;
 
     T* Find(T* object) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        auto iter = mCache.find(object);
-        if (iter == mCache.end()) {
+        Shard& shard = ShardFor(object);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto iter = shard.cache.find(object);
+        if (iter == shard.cache.end()) {
             return nullptr;
         }
         return *iter;
     }
 
     std::pair<T*, bool> Insert(T* object) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        auto [value, inserted] = mCache.insert(object);
+        Shard& shard = ShardFor(object);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto [value, inserted] = shard.cache.insert(object);
         return {*value, inserted};
     }
 
     size_t Erase(T* object) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        return mCache.erase(object);
+        Shard& shard = ShardFor(object);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.cache.erase(object);
     }
 
   private:
-    std::mutex mMutex;
-    std::unordered_set<T*, typename T::HashFunc, typename T::EqualityFunc> mCache;
+    static constexpr size_t kNumShards = 16;
+    static_assert((kNumShards & (kNumShards - 1)) == 0, "kNumShards must be a power of two");
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_set<T*, typename T::HashFunc, typename T::EqualityFunc> cache;
+    };
+
+    Shard& ShardFor(T* object) {
+        return mShards[typename T::HashFunc()(object) & (kNumShards - 1)];
+    }
+
+    std::array<Shard, kNumShards> mShards;
 };
 
 #endif  // SRC_DAWN_COMMON_CONCURRENTCACHE_H_
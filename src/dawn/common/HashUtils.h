@@ -16,12 +16,25 @@
 #define SRC_DAWN_COMMON_HASHUTILS_H_
 
 #include <bitset>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 
 #include "dawn/common/Platform.h"
 #include "dawn/common/TypedInteger.h"
 #include "dawn/common/ityp_bitset.h"
 
+// Use the CRC32C instructions for bulk hashing when the target ISA guarantees them at compile
+// time. There is deliberately no runtime dispatch: builds that don't enable the instructions
+// use the portable word-at-a-time path below.
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define DAWN_HASH_USE_HW_CRC32 1
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define DAWN_HASH_USE_HW_CRC32 1
+#endif
+
 // Wrapper around std::hash to make it a templated function instead of a functor. It is marginally
 // nicer, and avoids adding to the std namespace to add hashing of other types.
 template <typename T>
@@ -61,6 +74,71 @@ void HashCombine(size_t* hash, const T& value, const Args&... args) {
     HashCombine(hash, args...);
 }
 
+// Hashes a contiguous range of bytes in bulk instead of combining per-element hashes one at a
+// time. This is the fast path for descriptor hashing: shader sources, entry vectors and other
+// plain-old-data spans. The result is only meaningful as a process-local hash value; it differs
+// between platforms, builds and pointer widths, so it must never be serialized (CacheKey handles
+// persistent hashing separately).
+inline size_t HashBytes(const void* bytes, size_t size) {
+    const uint8_t* data = static_cast<const uint8_t*>(bytes);
+#if defined(DAWN_HASH_USE_HW_CRC32)
+    // CRC32C consumes 8 bytes per instruction with a latency of 3 cycles and is pipelined, so
+    // it beats the multiply-based fallback on every input size that matters here. Seed with the
+    // length so that ranges that are prefixes of each other hash differently.
+    uint32_t crc = static_cast<uint32_t>(size);
+    while (size >= sizeof(uint64_t)) {
+        uint64_t chunk;
+        memcpy(&chunk, data, sizeof(uint64_t));
+#if defined(__SSE4_2__)
+        crc = static_cast<uint32_t>(_mm_crc32_u64(crc, chunk));
+#else
+        crc = __crc32cd(crc, chunk);
+#endif
+        data += sizeof(uint64_t);
+        size -= sizeof(uint64_t);
+    }
+    while (size > 0) {
+#if defined(__SSE4_2__)
+        crc = _mm_crc32_u8(crc, *data);
+#else
+        crc = __crc32cb(crc, *data);
+#endif
+        data++;
+        size--;
+    }
+    // CRC32C only produces 32 bits; spread them over size_t so high hash bits are usable by
+    // power-of-two sized tables.
+#if DAWN_PLATFORM_IS(64_BIT)
+    return static_cast<size_t>(crc) * size_t(0x9e3779b97f4a7c16);
+#else
+    return static_cast<size_t>(crc) * size_t(0x9e3779b9);
+#endif
+#else
+    // Word-at-a-time FNV-1a. Not the strongest hash, but matches the quality of the existing
+    // HashCombine chain while touching every byte only once.
+#if DAWN_PLATFORM_IS(64_BIT)
+    const size_t kPrime = 0x100000001b3;
+    size_t hash = size_t(0xcbf29ce484222325) ^ size;
+#else
+    const size_t kPrime = 0x1000193;
+    size_t hash = size_t(0x811c9dc5) ^ size;
+#endif
+    while (size >= sizeof(size_t)) {
+        size_t chunk;
+        memcpy(&chunk, data, sizeof(size_t));
+        hash = (hash ^ chunk) * kPrime;
+        data += sizeof(size_t);
+        size -= sizeof(size_t);
+    }
+    while (size > 0) {
+        hash = (hash ^ *data) * kPrime;
+        data++;
+        size--;
+    }
+    return hash;
+#endif
+}
+
 // Workaround a bug between clang++ and libstdlibc++ by defining our own hashing for bitsets.
 // When _GLIBCXX_DEBUG is enabled libstdc++ wraps containers into debug containers. For bitset this
 // means what is normally std::bitset is defined as std::__cxx1988::bitset and is replaced by the
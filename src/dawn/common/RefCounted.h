@@ -81,4 +81,25 @@ Ref<T> AcquireRef(T* pointee) {
     return ref;
 }
 
+// BorrowedRef<T> is a non-owning reference to a RefCounted object. It annotates hot paths
+// (command recording state tracking in particular) where the holder relies on someone else -
+// typically the encoder or the recorded command list - to keep the object alive for as long as
+// the borrowed reference is used, so no ref-count traffic is needed at all.
+template <typename T>
+class BorrowedRef {
+  public:
+    constexpr BorrowedRef() = default;
+    // NOLINTNEXTLINE(runtime/explicit)
+    constexpr BorrowedRef(T* pointee) : mPointee(pointee) {}
+    // NOLINTNEXTLINE(runtime/explicit)
+    BorrowedRef(const Ref<T>& ref) : mPointee(ref.Get()) {}
+
+    T* Get() const { return mPointee; }
+    T* operator->() const { return mPointee; }
+    operator T*() const { return mPointee; }
+
+  private:
+    T* mPointee = nullptr;
+};
+
 #endif  // SRC_DAWN_COMMON_REFCOUNTED_H_
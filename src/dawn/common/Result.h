@@ -56,7 +56,10 @@ class Result;
 //    std::unique_ptr<E> AcquireError();
 
 // Specialization of Result for returning errors only via pointers. It is basically a pointer
-// where nullptr is both Success and Empty.
+// where nullptr is both Success and Empty. The pointer is stored raw (ownership is still
+// unique_ptr at the API boundary) so that the success hot path is a plain register-sized
+// value with no heap allocation and no smart-pointer bookkeeping; this matters because
+// MaybeError is the return type of every command encoding function.
 template <typename E>
 class [[nodiscard]] Result<void, E> {
   public:
@@ -75,7 +78,7 @@ class [[nodiscard]] Result<void, E> {
     std::unique_ptr<E> AcquireError();
 
   private:
-    std::unique_ptr<E> mError;
+    E* mError = nullptr;
 };
 
 // Uses SFINAE to try to get alignof(T) but fallback to Default if T isn't defined.
@@ -240,15 +243,18 @@ template <typename E>
 Result<void, E>::Result() {}
 
 template <typename E>
-Result<void, E>::Result(std::unique_ptr<E> error) : mError(std::move(error)) {}
+Result<void, E>::Result(std::unique_ptr<E> error) : mError(error.release()) {}
 
 template <typename E>
-Result<void, E>::Result(Result<void, E>&& other) : mError(std::move(other.mError)) {}
+Result<void, E>::Result(Result<void, E>&& other) : mError(other.mError) {
+    other.mError = nullptr;
+}
 
 template <typename E>
 Result<void, E>& Result<void, E>::operator=(Result<void, E>&& other) {
     ASSERT(mError == nullptr);
-    mError = std::move(other.mError);
+    mError = other.mError;
+    other.mError = nullptr;
     return *this;
 }
 
@@ -272,7 +278,9 @@ void Result<void, E>::AcquireSuccess() {}
 
 template <typename E>
 std::unique_ptr<E> Result<void, E>::AcquireError() {
-    return std::move(mError);
+    std::unique_ptr<E> error(mError);
+    mError = nullptr;
+    return error;
 }
 
 // Implementation details of the tagged pointer Results
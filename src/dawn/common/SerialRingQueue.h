@@ -0,0 +1,210 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_COMMON_SERIALRINGQUEUE_H_
+#define SRC_DAWN_COMMON_SERIALRINGQUEUE_H_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+
+// SerialRingQueue stores an associative list mapping a Serial to Value, with the same contract
+// as SerialQueue: Serials must be enqueued in (not strictly) increasing order, and are cleared
+// from the front. Unlike SerialQueue, every (serial, value) entry is stored inline in a flat
+// power-of-two ring buffer rather than one heap-allocated vector per serial bucket, so the
+// steady-state "enqueue at the last serial, clear up to the last completed serial" pattern of
+// in-flight resource tracking performs no allocation once the ring has grown to the queue's
+// high-water mark.
+//
+// Value must be default-constructible and move-assignable. Cleared entries are overwritten with
+// a default-constructed Value so that resources owned by the value are released eagerly.
+template <typename Serial, typename Value>
+class SerialRingQueue {
+  private:
+    struct Entry {
+        Serial serial{};
+        Value value{};
+    };
+
+  public:
+    class Iterator {
+      public:
+        Iterator(SerialRingQueue* queue, size_t offset) : mQueue(queue), mOffset(offset) {}
+        Iterator& operator++() {
+            mOffset++;
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return mOffset == other.mOffset; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+        Value& operator*() const { return mQueue->GetEntry(mOffset).value; }
+
+      private:
+        SerialRingQueue* mQueue;
+        size_t mOffset;
+    };
+
+    class ConstIterator {
+      public:
+        ConstIterator(const SerialRingQueue* queue, size_t offset)
+            : mQueue(queue), mOffset(offset) {}
+        ConstIterator& operator++() {
+            mOffset++;
+            return *this;
+        }
+
+        bool operator==(const ConstIterator& other) const { return mOffset == other.mOffset; }
+        bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+        const Value& operator*() const { return mQueue->GetEntry(mOffset).value; }
+
+      private:
+        const SerialRingQueue* mQueue;
+        size_t mOffset;
+    };
+
+    class BeginEnd {
+      public:
+        BeginEnd(SerialRingQueue* queue, size_t count) : mQueue(queue), mCount(count) {}
+
+        Iterator begin() const { return {mQueue, 0}; }
+        Iterator end() const { return {mQueue, mCount}; }
+
+      private:
+        SerialRingQueue* mQueue;
+        size_t mCount;
+    };
+
+    class ConstBeginEnd {
+      public:
+        ConstBeginEnd(const SerialRingQueue* queue, size_t count) : mQueue(queue), mCount(count) {}
+
+        ConstIterator begin() const { return {mQueue, 0}; }
+        ConstIterator end() const { return {mQueue, mCount}; }
+
+      private:
+        const SerialRingQueue* mQueue;
+        size_t mCount;
+    };
+
+    // The serial must be given in (not strictly) increasing order.
+    void Enqueue(const Value& value, Serial serial) {
+        Enqueue(Value(value), serial);
+    }
+
+    void Enqueue(Value&& value, Serial serial) {
+        DAWN_ASSERT(Empty() || LastSerial() <= serial);
+
+        if (mCount == mEntries.size()) {
+            Grow();
+        }
+        Entry& entry = GetEntry(mCount);
+        entry.serial = serial;
+        entry.value = std::move(value);
+        mCount++;
+    }
+
+    bool Empty() const {
+        return mCount == 0;
+    }
+
+    ConstBeginEnd IterateAll() const {
+        return {this, mCount};
+    }
+
+    // Iterates all values associated to a serial that is smaller OR EQUAL to the given serial.
+    ConstBeginEnd IterateUpTo(Serial serial) const {
+        return {this, CountUpTo(serial)};
+    }
+
+    BeginEnd IterateAll() {
+        return {this, mCount};
+    }
+
+    BeginEnd IterateUpTo(Serial serial) {
+        return {this, CountUpTo(serial)};
+    }
+
+    void Clear() {
+        ClearFront(mCount);
+    }
+
+    // Clears all values associated to a serial that is smaller OR EQUAL to the given serial.
+    void ClearUpTo(Serial serial) {
+        ClearFront(CountUpTo(serial));
+    }
+
+    Serial FirstSerial() const {
+        DAWN_ASSERT(!Empty());
+        return GetEntry(0).serial;
+    }
+
+    Serial LastSerial() const {
+        DAWN_ASSERT(!Empty());
+        return GetEntry(mCount - 1).serial;
+    }
+
+  private:
+    static constexpr size_t kInitialCapacity = 16;
+
+    Entry& GetEntry(size_t offset) {
+        return mEntries[(mHead + offset) & (mEntries.size() - 1)];
+    }
+
+    const Entry& GetEntry(size_t offset) const {
+        return mEntries[(mHead + offset) & (mEntries.size() - 1)];
+    }
+
+    // Returns the number of entries from the front that have a serial smaller or equal to
+    // the given serial.
+    size_t CountUpTo(Serial serial) const {
+        size_t count = 0;
+        while (count < mCount && GetEntry(count).serial <= serial) {
+            count++;
+        }
+        return count;
+    }
+
+    void ClearFront(size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            GetEntry(i).value = Value();
+        }
+        if (count == mCount) {
+            mHead = 0;
+            mCount = 0;
+        } else {
+            mHead = (mHead + count) & (mEntries.size() - 1);
+            mCount -= count;
+        }
+    }
+
+    void Grow() {
+        size_t newCapacity = std::max(kInitialCapacity, mEntries.size() * 2);
+        std::vector<Entry> entries(newCapacity);
+        for (size_t i = 0; i < mCount; i++) {
+            entries[i] = std::move(GetEntry(i));
+        }
+        mEntries = std::move(entries);
+        mHead = 0;
+    }
+
+    // The ring buffer. Its size is always zero or a power of two, so that wrapping indices
+    // is a mask instead of a modulo.
+    std::vector<Entry> mEntries;
+    size_t mHead = 0;
+    size_t mCount = 0;
+};
+
+#endif  // SRC_DAWN_COMMON_SERIALRINGQUEUE_H_
@@ -15,13 +15,31 @@
 #include "dawn/common/SlabAllocator.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <limits>
 #include <new>
+#include <unordered_map>
 
 #include "dawn/common/Assert.h"
 #include "dawn/common/Math.h"
 
+namespace {
+
+struct MagazineEntry {
+    uint64_t serial;
+    SlabAllocatorImpl::Magazine* magazine;
+};
+
+// Maps an allocator to this thread's magazine for it. Entries are keyed by the allocator's
+// address and validated against its serial, since an allocator may reuse the address of a
+// destroyed one whose entry is still in the map.
+thread_local std::unordered_map<const SlabAllocatorImpl*, MagazineEntry> tMagazines;
+
+std::atomic<uint64_t> sNextAllocatorSerial{1};
+
+}  // namespace
+
 // IndexLinkNode
 
 SlabAllocatorImpl::IndexLinkNode::IndexLinkNode(Index index, Index nextIndex)
@@ -67,7 +85,8 @@ SlabAllocatorImpl::SlabAllocatorImpl(Index blocksPerSlab,
           static_cast<size_t>(mSlabBlocksOffset) + mBlocksPerSlab * mBlockStride +
           // Pad the allocation size by mAllocationAlignment so that the aligned allocation still
           // fulfills the required size.
-          mAllocationAlignment) {
+          mAllocationAlignment),
+      mSerial(sNextAllocatorSerial.fetch_add(1)) {
     ASSERT(IsPowerOfTwo(mAllocationAlignment));
 }
 
@@ -80,9 +99,23 @@ SlabAllocatorImpl::SlabAllocatorImpl(SlabAllocatorImpl&& rhs)
       mTotalAllocationSize(rhs.mTotalAllocationSize),
       mAvailableSlabs(std::move(rhs.mAvailableSlabs)),
       mFullSlabs(std::move(rhs.mFullSlabs)),
-      mRecycledSlabs(std::move(rhs.mRecycledSlabs)) {}
+      mRecycledSlabs(std::move(rhs.mRecycledSlabs)),
+      mSerial(rhs.mSerial),
+      mMagazines(std::move(rhs.mMagazines)) {
+    // Invalidate the moved-from allocator's serial so thread-local magazine lookups against it
+    // never match.
+    rhs.mSerial = 0;
+}
 
-SlabAllocatorImpl::~SlabAllocatorImpl() = default;
+SlabAllocatorImpl::~SlabAllocatorImpl() {
+    // The caller must guarantee no thread is using the allocator anymore; drain the magazines
+    // so every cached block is returned to its slab before the slab lists are torn down.
+    for (std::unique_ptr<Magazine>& magazine : mMagazines) {
+        while (magazine->count > 0) {
+            DeallocateToSlabs(magazine->blocks[--magazine->count]);
+        }
+    }
+}
 
 SlabAllocatorImpl::IndexLinkNode* SlabAllocatorImpl::OffsetFrom(
     IndexLinkNode* node,
@@ -167,7 +200,44 @@ void SlabAllocatorImpl::Slab::Splice() {
     originalPrev->next = originalNext;
 }
 
+SlabAllocatorImpl::Magazine* SlabAllocatorImpl::GetOrCreateMagazine() {
+    auto it = tMagazines.find(this);
+    if (it != tMagazines.end() && it->second.serial == mSerial) {
+        return it->second.magazine;
+    }
+    auto magazine = std::make_unique<Magazine>();
+    Magazine* result = magazine.get();
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mMagazines.push_back(std::move(magazine));
+    }
+    tMagazines[this] = {mSerial, result};
+    return result;
+}
+
 void* SlabAllocatorImpl::Allocate() {
+    Magazine* magazine = GetOrCreateMagazine();
+    if (magazine->count > 0) {
+        return magazine->blocks[--magazine->count];
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    return AllocateFromSlabs();
+}
+
+void SlabAllocatorImpl::Deallocate(void* ptr) {
+    Magazine* magazine = GetOrCreateMagazine();
+    if (magazine->count == Magazine::kCapacity) {
+        // Return a batch of blocks to the shared slabs under a single lock acquisition.
+        std::lock_guard<std::mutex> lock(mMutex);
+        while (magazine->count > Magazine::kCapacity / 2) {
+            DeallocateToSlabs(magazine->blocks[--magazine->count]);
+        }
+    }
+    magazine->blocks[magazine->count++] = ptr;
+}
+
+void* SlabAllocatorImpl::AllocateFromSlabs() {
     if (mAvailableSlabs.next == nullptr) {
         GetNewSlab();
     }
@@ -185,7 +255,7 @@ void* SlabAllocatorImpl::Allocate() {
     return ObjectFromNode(node);
 }
 
-void SlabAllocatorImpl::Deallocate(void* ptr) {
+void SlabAllocatorImpl::DeallocateToSlabs(void* ptr) {
     IndexLinkNode* node = NodeFromObject(ptr);
 
     ASSERT(node->index < mBlocksPerSlab);
@@ -15,9 +15,13 @@
 #ifndef SRC_DAWN_COMMON_SLABALLOCATOR_H_
 #define SRC_DAWN_COMMON_SLABALLOCATOR_H_
 
+#include <array>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "dawn/common/Numeric.h"
 #include "dawn/common/PlacementAllocated.h"
@@ -54,6 +58,12 @@
 // Deallocation: When an object is deallocated, it can compute the pointer to its parent slab
 // because it stores the index of its own allocation. That block is then prepended to the slab's
 // free list.
+//
+// Threading: The slab lists are protected by a mutex, and each thread additionally keeps a
+// "magazine" of recently freed blocks per allocator. Deallocations push into the magazine and
+// allocations pop from it without taking the lock; blocks are exchanged with the shared slabs in
+// batches when a magazine fills up or runs dry, so balanced allocate/deallocate churn on one
+// thread rarely contends with other threads.
 class SlabAllocatorImpl {
   public:
     // Allocations host their current index and the index of the next free block.
@@ -61,6 +71,14 @@ class SlabAllocatorImpl {
     // TODO(crbug.com/dawn/825): Is uint8_t sufficient?
     using Index = uint16_t;
 
+    // A per-thread, per-allocator cache of free blocks. Only ever filled with blocks that were
+    // previously allocated, so the slabs' accounting and recycling behavior is unchanged.
+    struct Magazine {
+        static constexpr uint32_t kCapacity = 16;
+        std::array<void*, kCapacity> blocks;
+        uint32_t count = 0;
+    };
+
     SlabAllocatorImpl(SlabAllocatorImpl&& rhs);
 
   protected:
@@ -100,6 +118,14 @@ class SlabAllocatorImpl {
     void Deallocate(void* ptr);
 
   private:
+    // Returns this thread's magazine for this allocator, creating and registering it on first
+    // use.
+    Magazine* GetOrCreateMagazine();
+
+    // The slow paths servicing magazine misses and flushes. Both require |mMutex| to be held.
+    void* AllocateFromSlabs();
+    void DeallocateToSlabs(void* ptr);
+
     // The maximum value is reserved to indicate the end of the list.
     static Index kInvalidIndex;
 
@@ -160,6 +186,18 @@ class SlabAllocatorImpl {
     SentinelSlab mFullSlabs;       // Full slabs. Stored here so we can skip checking them.
     SentinelSlab mRecycledSlabs;   // Recycled slabs. Not immediately added to |mAvailableSlabs| so
                                    // we don't thrash the current "active" slab.
+
+    // Identifies this allocator in thread-local magazine lookups, so an allocator that reuses
+    // the address of a destroyed one doesn't pick up its stale magazines. 0 on moved-from
+    // allocators so they never match.
+    uint64_t mSerial;
+
+    // Protects the slab lists and |mMagazines|.
+    std::mutex mMutex;
+
+    // All magazines handed out to threads. The allocator owns them so it can drain the blocks
+    // they hold back into the slabs on destruction.
+    std::vector<std::unique_ptr<Magazine>> mMagazines;
 };
 
 template <typename T>
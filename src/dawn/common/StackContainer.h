@@ -13,6 +13,14 @@
 
 #include "dawn/common/Compiler.h"
 
+// When DAWN_TRACK_STACK_CONTAINER_SPILLS is defined, every stack container that outgrows its
+// inline capacity and falls back to a heap allocation logs the element size and capacities
+// involved. This is a debugging aid for tuning inline capacities of hot containers; the log
+// line identifies the offending container type well enough to find it with a grep.
+#if defined(DAWN_TRACK_STACK_CONTAINER_SPILLS)
+#include "dawn/common/Log.h"
+#endif
+
 // This allocator can be used with STL containers to provide a stack buffer
 // from which to allocate memory and overflows onto the heap. This stack buffer
 // would be allocated on the stack and allows us to avoid heap operations in
@@ -96,6 +104,13 @@ class StackAllocator : public std::allocator<T> {
             source_->used_stack_buffer_ = true;
             return source_->stack_buffer();
         } else {
+#if defined(DAWN_TRACK_STACK_CONTAINER_SPILLS)
+            if (source_ != nullptr) {
+                dawn::WarningLog() << "StackContainer spilled to the heap: inline capacity "
+                                   << stack_capacity << ", requested " << n << ", element size "
+                                   << sizeof(T);
+            }
+#endif
             return std::allocator<T>::allocate(n);
         }
     }
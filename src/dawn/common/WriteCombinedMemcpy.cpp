@@ -0,0 +1,88 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/common/WriteCombinedMemcpy.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "dawn/common/Platform.h"
+
+#if DAWN_PLATFORM_IS(X86)
+#include <emmintrin.h>
+#endif  // DAWN_PLATFORM_IS(X86)
+
+namespace {
+
+#if DAWN_PLATFORM_IS(X86)
+// Below this size the fixed cost of the store fence outweighs the cache savings; small copies
+// also fit within the CPU's write-combining buffers, so plain memcpy already combines well.
+constexpr size_t kStreamingCopyThreshold = 2048;
+#endif  // DAWN_PLATFORM_IS(X86)
+
+}  // namespace
+
+void MemcpyToWriteCombinedMemory(void* dst, const void* src, size_t size) {
+#if DAWN_PLATFORM_IS(X86)
+    if (size >= kStreamingCopyThreshold) {
+        uint8_t* dstBytes = static_cast<uint8_t*>(dst);
+        const uint8_t* srcBytes = static_cast<const uint8_t*>(src);
+
+        // Copy up to the first 16-byte boundary of the destination with memcpy. Streaming
+        // stores require an aligned destination; the source may stay unaligned because
+        // _mm_loadu_si128 is used below.
+        size_t headSize = (-reinterpret_cast<uintptr_t>(dstBytes)) & 15;
+        if (headSize != 0) {
+            memcpy(dstBytes, srcBytes, headSize);
+            dstBytes += headSize;
+            srcBytes += headSize;
+            size -= headSize;
+        }
+
+        // Stream a cache line (64 bytes) per iteration. Issuing the four stores back-to-back
+        // lets them coalesce into a single write-combining buffer flush.
+        while (size >= 64) {
+            __m128i chunk0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcBytes + 0));
+            __m128i chunk1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcBytes + 16));
+            __m128i chunk2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcBytes + 32));
+            __m128i chunk3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcBytes + 48));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dstBytes + 0), chunk0);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dstBytes + 16), chunk1);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dstBytes + 32), chunk2);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dstBytes + 48), chunk3);
+            dstBytes += 64;
+            srcBytes += 64;
+            size -= 64;
+        }
+        while (size >= 16) {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dstBytes),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcBytes)));
+            dstBytes += 16;
+            srcBytes += 16;
+            size -= 16;
+        }
+
+        // Streaming stores are weakly ordered; fence so the data is visible to later operations
+        // (including the GPU reading the upload heap) before the copy is considered done.
+        _mm_sfence();
+
+        if (size != 0) {
+            memcpy(dstBytes, srcBytes, size);
+        }
+        return;
+    }
+#endif  // DAWN_PLATFORM_IS(X86)
+
+    memcpy(dst, src, size);
+}
@@ -0,0 +1,30 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_COMMON_WRITECOMBINEDMEMCPY_H_
+#define SRC_DAWN_COMMON_WRITECOMBINEDMEMCPY_H_
+
+#include <cstddef>
+
+// Copies |size| bytes from |src| to |dst| where |dst| is expected to point into write-combined
+// memory, such as a mapped upload heap. On x86 the bulk of the copy uses non-temporal streaming
+// stores, which avoid reading the destination cache lines back into the cache (a plain memcpy
+// into uncached write-combined memory triggers those reads and pollutes the cache with lines
+// that will never be read again). On other architectures this is a plain memcpy.
+//
+// The destination may have any alignment; unaligned head and tail bytes fall back to memcpy.
+// The function issues a store fence before returning so the copied data is globally visible.
+void MemcpyToWriteCombinedMemory(void* dst, const void* src, size_t size);
+
+#endif  // SRC_DAWN_COMMON_WRITECOMBINEDMEMCPY_H_
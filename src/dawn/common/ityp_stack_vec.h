@@ -16,6 +16,7 @@
 #define SRC_DAWN_COMMON_ITYP_STACK_VEC_H_
 
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "dawn/common/Assert.h"
@@ -47,6 +48,10 @@ class stack_vec : private StackVector<Value, StaticCapacity> {
 
     void resize(Index size) { this->container().resize(static_cast<I>(size)); }
 
+    void push_back(const Value& value) { this->container().push_back(value); }
+
+    void push_back(Value&& value) { this->container().push_back(std::move(value)); }
+
     void reserve(Index size) { this->container().reserve(static_cast<I>(size)); }
 
     Value* data() { return this->container().data(); }
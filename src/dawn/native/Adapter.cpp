@@ -37,6 +37,8 @@ MaybeError AdapterBase::Initialize() {
     DAWN_TRY_CONTEXT(InitializeImpl(), "initializing adapter (backend=%s)", mBackend);
     InitializeVendorArchitectureImpl();
 
+    mTuningProfile = GetDefaultTuningProfile(mVendorId, mAdapterType);
+
     DAWN_TRY_CONTEXT(
         InitializeSupportedFeaturesImpl(),
         "gathering supported features for \"%s\" - \"%s\" (vendorId=%#06x deviceId=%#06x "
@@ -154,6 +156,14 @@ uint32_t AdapterBase::GetDeviceId() const {
     return mDeviceId;
 }
 
+const PerformanceTuningProfile& AdapterBase::GetTuningProfile() const {
+    return mTuningProfile;
+}
+
+void AdapterBase::SetTuningProfile(const PerformanceTuningProfile& profile) {
+    mTuningProfile = profile;
+}
+
 wgpu::BackendType AdapterBase::GetBackendType() const {
     return mBackend;
 }
@@ -24,6 +24,7 @@
 #include "dawn/native/Error.h"
 #include "dawn/native/Features.h"
 #include "dawn/native/Limits.h"
+#include "dawn/native/PerformanceTuning.h"
 #include "dawn/native/dawn_platform.h"
 
 namespace dawn::native {
@@ -49,6 +50,12 @@ class AdapterBase : public RefCounted {
 
     uint32_t GetVendorId() const;
     uint32_t GetDeviceId() const;
+
+    // Allocator and pool sizes tuned for this adapter's hardware class. Selected during
+    // Initialize; embedders may replace the profile before creating devices.
+    const PerformanceTuningProfile& GetTuningProfile() const;
+    void SetTuningProfile(const PerformanceTuningProfile& profile);
+
     wgpu::BackendType GetBackendType() const;
     InstanceBase* GetInstance() const;
 
@@ -94,6 +101,7 @@ class AdapterBase : public RefCounted {
     wgpu::BackendType mBackend;
     CombinedLimits mLimits;
     bool mUseTieredLimits = false;
+    PerformanceTuningProfile mTuningProfile;
 };
 
 }  // namespace dawn::native
@@ -14,21 +14,26 @@
 
 #include "dawn/native/AsyncTask.h"
 
+#include <algorithm>
+#include <thread>
 #include <utility>
 
+#include "dawn/common/Assert.h"
 #include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native {
 
 AsyncTaskManager::AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool)
-    : mWorkerTaskPool(workerTaskPool) {}
+    : mMaxConcurrentTasks(std::max(1u, std::thread::hardware_concurrency())),
+      mWorkerTaskPool(workerTaskPool) {}
 
-void AsyncTaskManager::PostTask(AsyncTask asyncTask) {
+void AsyncTaskManager::PostTask(AsyncTask asyncTask, TaskPriority priority) {
     // If these allocations becomes expensive, we can slab-allocate tasks.
     Ref<WaitableTask> waitableTask = AcquireRef(new WaitableTask());
     waitableTask->taskManager = this;
     waitableTask->asyncTask = std::move(asyncTask);
 
+    Ref<WaitableTask> taskToDispatch;
     {
         // We insert new waitableTask objects into mPendingTasks in main thread (PostTask()),
         // and we may remove waitableTask objects from mPendingTasks in either main thread
@@ -36,39 +41,130 @@ void AsyncTaskManager::PostTask(AsyncTask asyncTask) {
         // protected by a mutex.
         std::lock_guard<std::mutex> lock(mPendingTasksMutex);
         mPendingTasks.emplace(waitableTask.Get(), waitableTask);
+        mPendingTaskCount.store(mPendingTasks.size(), std::memory_order_release);
+        mQueuedTasks[static_cast<uint32_t>(priority)].push(std::move(waitableTask));
+
+        // The task to hand to the pool isn't necessarily the one that was just posted: a
+        // higher priority task may still be queued behind the concurrent task limit.
+        taskToDispatch = PopTaskToDispatch();
+    }
+
+    if (taskToDispatch != nullptr) {
+        DispatchTask(std::move(taskToDispatch));
+    }
+}
+
+void AsyncTaskManager::SetMaxConcurrentTasks(uint32_t maxConcurrentTasks) {
+    while (true) {
+        Ref<WaitableTask> taskToDispatch;
+        {
+            std::lock_guard<std::mutex> lock(mPendingTasksMutex);
+            mMaxConcurrentTasks = std::max(1u, maxConcurrentTasks);
+            taskToDispatch = PopTaskToDispatch();
+        }
+        if (taskToDispatch == nullptr) {
+            return;
+        }
+        DispatchTask(std::move(taskToDispatch));
+    }
+}
+
+Ref<AsyncTaskManager::WaitableTask> AsyncTaskManager::PopTaskToDispatch() {
+    if (mInFlightTaskCount >= mMaxConcurrentTasks) {
+        return nullptr;
+    }
+    for (uint32_t priority = kTaskPriorityCount; priority-- > 0;) {
+        std::queue<Ref<WaitableTask>>& queue = mQueuedTasks[priority];
+        if (!queue.empty()) {
+            Ref<WaitableTask> task = std::move(queue.front());
+            queue.pop();
+            mInFlightTaskCount++;
+            return task;
+        }
     }
+    return nullptr;
+}
 
+void AsyncTaskManager::DispatchTask(Ref<WaitableTask> task) {
     // Ref the task since it is accessed inside the worker function.
     // The worker function will acquire and release the task upon completion.
-    waitableTask->Reference();
-    waitableTask->waitableEvent =
-        mWorkerTaskPool->PostWorkerTask(DoWaitableTask, waitableTask.Get());
+    task->Reference();
+    std::unique_ptr<dawn::platform::WaitableEvent> waitableEvent =
+        mWorkerTaskPool->PostWorkerTask(DoWaitableTask, task.Get());
+
+    // Publish the event under the mutex: WaitAllPendingTasks can observe the task between the
+    // handoff to the pool and this assignment when a completing task dispatched it.
+    std::lock_guard<std::mutex> lock(mPendingTasksMutex);
+    task->waitableEvent = std::move(waitableEvent);
 }
 
 void AsyncTaskManager::HandleTaskCompletion(WaitableTask* task) {
-    std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-    auto iter = mPendingTasks.find(task);
-    if (iter != mPendingTasks.end()) {
-        mPendingTasks.erase(iter);
+    Ref<WaitableTask> taskToDispatch;
+    {
+        std::lock_guard<std::mutex> lock(mPendingTasksMutex);
+        auto iter = mPendingTasks.find(task);
+        if (iter != mPendingTasks.end()) {
+            mPendingTasks.erase(iter);
+            mPendingTaskCount.store(mPendingTasks.size(), std::memory_order_release);
+        }
+        ASSERT(mInFlightTaskCount > 0);
+        mInFlightTaskCount--;
+        taskToDispatch = PopTaskToDispatch();
+    }
+    if (taskToDispatch != nullptr) {
+        DispatchTask(std::move(taskToDispatch));
     }
 }
 
 void AsyncTaskManager::WaitAllPendingTasks() {
+    // Hand everything that is still queued to the pool regardless of the concurrent task
+    // limit: all of it has to finish before this function returns anyway.
+    while (true) {
+        Ref<WaitableTask> taskToDispatch;
+        {
+            std::lock_guard<std::mutex> lock(mPendingTasksMutex);
+            for (uint32_t priority = kTaskPriorityCount; priority-- > 0;) {
+                std::queue<Ref<WaitableTask>>& queue = mQueuedTasks[priority];
+                if (!queue.empty()) {
+                    taskToDispatch = std::move(queue.front());
+                    queue.pop();
+                    mInFlightTaskCount++;
+                    break;
+                }
+            }
+        }
+        if (taskToDispatch == nullptr) {
+            break;
+        }
+        DispatchTask(std::move(taskToDispatch));
+    }
+
     std::unordered_map<WaitableTask*, Ref<WaitableTask>> allPendingTasks;
 
     {
         std::lock_guard<std::mutex> lock(mPendingTasksMutex);
         allPendingTasks.swap(mPendingTasks);
+        mPendingTaskCount.store(0, std::memory_order_release);
     }
 
     for (auto& [_, task] : allPendingTasks) {
+        // Tasks dispatched from a worker thread may not have their waitable event published
+        // yet, see DispatchTask.
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(mPendingTasksMutex);
+                if (task->waitableEvent != nullptr) {
+                    break;
+                }
+            }
+            std::this_thread::yield();
+        }
         task->waitableEvent->Wait();
     }
 }
 
 bool AsyncTaskManager::HasPendingTasks() {
-    std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-    return !mPendingTasks.empty();
+    return mPendingTaskCount.load(std::memory_order_acquire) != 0;
 }
 
 void AsyncTaskManager::DoWaitableTask(void* task) {
@@ -15,9 +15,13 @@
 #ifndef SRC_DAWN_NATIVE_ASYNCTASK_H_
 #define SRC_DAWN_NATIVE_ASYNCTASK_H_
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <queue>
 #include <unordered_map>
 
 #include "dawn/common/RefCounted.h"
@@ -36,14 +40,31 @@ namespace dawn::native {
 // task if we need it for synchronous pipeline compilation.
 using AsyncTask = std::function<void()>;
 
+// Tasks posted at a higher priority are handed to the worker task pool before lower priority
+// ones; tasks of the same priority run in posting order.
+enum class TaskPriority : uint32_t {
+    Background = 0,
+    Normal = 1,
+    High = 2,
+};
+static constexpr uint32_t kTaskPriorityCount = 3;
+
 class AsyncTaskManager {
   public:
     explicit AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool);
 
-    void PostTask(AsyncTask asyncTask);
+    void PostTask(AsyncTask asyncTask, TaskPriority priority = TaskPriority::Normal);
     void WaitAllPendingTasks();
+    // A single atomic load, so the device's idle-tick fast path can poll it without taking
+    // mPendingTasksMutex.
     bool HasPendingTasks();
 
+    // Controls how many tasks may run on the worker task pool at once. Lowering the limit only
+    // affects tasks that haven't been handed to the pool yet. Note that prioritization can only
+    // reorder tasks that the manager still holds, so a limit close to the number of cores that
+    // the embedder dedicates to the pool gives the best scheduling control.
+    void SetMaxConcurrentTasks(uint32_t maxConcurrentTasks);
+
   private:
     class WaitableTask : public RefCounted {
       public:
@@ -58,8 +79,21 @@ class AsyncTaskManager {
     static void DoWaitableTask(void* task);
     void HandleTaskCompletion(WaitableTask* task);
 
+    // Pops the highest priority queued task if the in-flight limit allows dispatching one
+    // more, accounting for it as in-flight. Must be called with mPendingTasksMutex held.
+    Ref<WaitableTask> PopTaskToDispatch();
+    // Hands a task popped by PopTaskToDispatch to the worker task pool. Must be called
+    // without mPendingTasksMutex held.
+    void DispatchTask(Ref<WaitableTask> task);
+
     std::mutex mPendingTasksMutex;
     std::unordered_map<WaitableTask*, Ref<WaitableTask>> mPendingTasks;
+    // Mirrors mPendingTasks.size(); updated under mPendingTasksMutex, read lock-free by
+    // HasPendingTasks.
+    std::atomic<size_t> mPendingTaskCount{0};
+    std::array<std::queue<Ref<WaitableTask>>, kTaskPriorityCount> mQueuedTasks;
+    uint32_t mInFlightTaskCount = 0;
+    uint32_t mMaxConcurrentTasks;
     dawn::platform::WorkerTaskPool* mWorkerTaskPool;
 };
 
@@ -266,20 +266,20 @@ MaybeError ValidateBindGroupDescriptor(DeviceBase* device,
         descriptor->entryCount, static_cast<uint32_t>(descriptor->layout->GetBindingCount()),
         descriptor->layout, descriptor->layout->EntriesToString());
 
-    const BindGroupLayoutBase::BindingMap& bindingMap = descriptor->layout->GetBindingMap();
-    ASSERT(bindingMap.size() <= kMaxBindingsPerPipelineLayout);
+    ASSERT(descriptor->layout->GetBindingCount() <=
+           BindingIndex(kMaxBindingsPerPipelineLayout));
 
     ityp::bitset<BindingIndex, kMaxBindingsPerPipelineLayout> bindingsSet;
     for (uint32_t i = 0; i < descriptor->entryCount; ++i) {
         const BindGroupEntry& entry = descriptor->entries[i];
 
-        const auto& it = bindingMap.find(BindingNumber(entry.binding));
-        DAWN_INVALID_IF(it == bindingMap.end(),
+        DAWN_INVALID_IF(!descriptor->layout->HasBinding(BindingNumber(entry.binding)),
                         "In entries[%u], binding index %u not present in the bind group layout."
                         "\nExpected layout: %s",
                         i, entry.binding, descriptor->layout->EntriesToString());
 
-        BindingIndex bindingIndex = it->second;
+        BindingIndex bindingIndex =
+            descriptor->layout->GetBindingIndex(BindingNumber(entry.binding));
         ASSERT(bindingIndex < descriptor->layout->GetBindingCount());
 
         DAWN_INVALID_IF(bindingsSet[bindingIndex],
@@ -406,9 +406,9 @@ BindGroupBase::BindGroupBase(DeviceBase* device,
         if (externalTextureBindingEntry != nullptr) {
             mBoundExternalTextures.push_back(externalTextureBindingEntry->externalTexture);
 
-            ExternalTextureBindingExpansionMap expansions =
+            const ExternalTextureBindingExpansionMap& expansions =
                 mLayout->GetExternalTextureBindingExpansionMap();
-            ExternalTextureBindingExpansionMap::iterator it =
+            ExternalTextureBindingExpansionMap::const_iterator it =
                 expansions.find(BindingNumber(entry.binding));
 
             ASSERT(it != expansions.end());
@@ -309,6 +309,12 @@ bool BindingHasDynamicOffset(const BindGroupLayoutEntry& binding) {
     return false;
 }
 
+// TODO(crbug.com/dawn/1554): Support samplers baked into the layout (D3D12 static samplers,
+// VkDescriptorSetLayout immutable samplers). This needs new API surface: the sampler must be
+// referenced from the bind group layout descriptor so backends know it when they create the
+// backend layout objects, and bind group creation can then skip those descriptor writes.
+// Until then the D3D12 sampler heap cache deduplicates sampler descriptor heap allocations
+// between bind groups that use the same samplers.
 BindingInfo CreateBindGroupLayoutInfo(const BindGroupLayoutEntry& binding) {
     BindingInfo bindingInfo;
     bindingInfo.binding = BindingNumber(binding.binding);
@@ -443,6 +449,9 @@ bool CheckBufferBindingsFirst(ityp::span<BindingIndex, const BindingInfo> bindin
     return firstNonBufferIndex >= lastBufferIndex;
 }
 
+// Sentinel for holes in the direct binding index table.
+const BindingIndex kInvalidBindingIndex = std::numeric_limits<BindingIndex>::max();
+
 }  // namespace
 
 // BindGroupLayoutBase
@@ -475,6 +484,22 @@ BindGroupLayoutBase::BindGroupLayoutBase(DeviceBase* device,
     }
     ASSERT(CheckBufferBindingsFirst({mBindingInfo.data(), GetBindingCount()}));
     ASSERT(mBindingInfo.size() <= kMaxBindingsPerPipelineLayoutTyped);
+
+    // Build the flat BindingNumber -> BindingIndex lookup. mBindingMap is sorted by key so
+    // the sorted array can be copied directly; the direct table is only built when every
+    // binding number is small, which covers almost all layouts.
+    if (!mBindingMap.empty() &&
+        mBindingMap.rbegin()->first < BindingNumber(kMaxOptimalBindingsPerGroup)) {
+        mDirectBindingIndices.resize(mBindingMap.rbegin()->first + BindingNumber(1));
+        for (BindingIndex& index : mDirectBindingIndices) {
+            index = kInvalidBindingIndex;
+        }
+        for (const auto [bindingNumber, bindingIndex] : mBindingMap) {
+            mDirectBindingIndices[bindingNumber] = bindingIndex;
+        }
+    } else {
+        mSortedBindingNumbers.assign(mBindingMap.begin(), mBindingMap.end());
+    }
 }
 
 BindGroupLayoutBase::BindGroupLayoutBase(DeviceBase* device,
@@ -516,13 +541,28 @@ const BindGroupLayoutBase::BindingMap& BindGroupLayoutBase::GetBindingMap() cons
 }
 
 bool BindGroupLayoutBase::HasBinding(BindingNumber bindingNumber) const {
-    return mBindingMap.count(bindingNumber) != 0;
+    if (mDirectBindingIndices.size() != BindingNumber(0)) {
+        return bindingNumber < mDirectBindingIndices.size() &&
+               mDirectBindingIndices[bindingNumber] != kInvalidBindingIndex;
+    }
+    const auto& it = std::lower_bound(
+        mSortedBindingNumbers.begin(), mSortedBindingNumbers.end(), bindingNumber,
+        [](const auto& entry, BindingNumber number) { return entry.first < number; });
+    return it != mSortedBindingNumbers.end() && it->first == bindingNumber;
 }
 
 BindingIndex BindGroupLayoutBase::GetBindingIndex(BindingNumber bindingNumber) const {
     ASSERT(!IsError());
-    const auto& it = mBindingMap.find(bindingNumber);
-    ASSERT(it != mBindingMap.end());
+    if (mDirectBindingIndices.size() != BindingNumber(0)) {
+        ASSERT(bindingNumber < mDirectBindingIndices.size());
+        BindingIndex bindingIndex = mDirectBindingIndices[bindingNumber];
+        ASSERT(bindingIndex != kInvalidBindingIndex);
+        return bindingIndex;
+    }
+    const auto& it = std::lower_bound(
+        mSortedBindingNumbers.begin(), mSortedBindingNumbers.end(), bindingNumber,
+        [](const auto& entry, BindingNumber number) { return entry.first < number; });
+    ASSERT(it != mSortedBindingNumbers.end() && it->first == bindingNumber);
     return it->second;
 }
 
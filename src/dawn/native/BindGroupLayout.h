@@ -19,12 +19,14 @@
 #include <bitset>
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "dawn/common/Constants.h"
 #include "dawn/common/Math.h"
 #include "dawn/common/SlabAllocator.h"
 #include "dawn/common/ityp_span.h"
-#include "dawn/common/ityp_vector.h"
+#include "dawn/common/ityp_stack_vec.h"
 #include "dawn/native/BindingInfo.h"
 #include "dawn/native/CachedObject.h"
 #include "dawn/native/Error.h"
@@ -152,11 +154,22 @@ class BindGroupLayoutBase : public ApiObjectBase, public CachedObject {
     BindGroupLayoutBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
     BindingCounts mBindingCounts = {};
-    ityp::vector<BindingIndex, BindingInfo> mBindingInfo;
+    // Most bind group layouts fit in the inline capacity; only unusually large layouts
+    // spill to the heap.
+    ityp::stack_vec<BindingIndex, BindingInfo, kMaxOptimalBindingsPerGroup> mBindingInfo;
 
-    // Map from BindGroupLayoutEntry.binding to packed indices.
+    // Map from BindGroupLayoutEntry.binding to packed indices. Kept for sorted iteration,
+    // hashing and equality; lookups go through the flat structures below.
     BindingMap mBindingMap;
 
+    // Flat BindingNumber -> BindingIndex lookup for the hot bind group creation and
+    // validation paths. Layouts almost always use small binding numbers and get a direct
+    // index table; layouts with large binding numbers fall back to binary search of a
+    // sorted array.
+    ityp::stack_vec<BindingNumber, BindingIndex, kMaxOptimalBindingsPerGroup>
+        mDirectBindingIndices;
+    std::vector<std::pair<BindingNumber, BindingIndex>> mSortedBindingNumbers;
+
     ExternalTextureBindingExpansionMap mExternalTextureBindingExpansionMap;
 
     // Non-0 if this BindGroupLayout was created as part of a default PipelineLayout.
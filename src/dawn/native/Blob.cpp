@@ -15,10 +15,17 @@
 #include <utility>
 
 #include "dawn/common/Assert.h"
+#include "dawn/common/Compiler.h"
 #include "dawn/common/Math.h"
+#include "dawn/common/Platform.h"
 #include "dawn/native/Blob.h"
 #include "dawn/native/stream/Stream.h"
 
+#if DAWN_PLATFORM_IS(POSIX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace dawn::native {
 
 Blob CreateBlob(size_t size, size_t alignment) {
@@ -39,6 +46,32 @@ Blob CreateBlob(size_t size, size_t alignment) {
     }
 }
 
+Blob CreateBlobFromFileRegion(int fd, uint64_t offset, size_t size) {
+#if DAWN_PLATFORM_IS(POSIX)
+    if (size == 0) {
+        return Blob();
+    }
+    // mmap requires a page-aligned file offset; map from the enclosing page boundary and point
+    // the blob at the requested bytes within the mapping.
+    const uint64_t pageMask = static_cast<uint64_t>(getpagesize()) - 1;
+    const uint64_t mapOffset = offset & ~pageMask;
+    const size_t mapSize = size + static_cast<size_t>(offset - mapOffset);
+    void* mapping =
+        mmap(nullptr, mapSize, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(mapOffset));
+    if (mapping == MAP_FAILED) {
+        return Blob();
+    }
+    uint8_t* data = static_cast<uint8_t*>(mapping) + (offset - mapOffset);
+    return Blob::UnsafeCreateWithDeleter(data, size,
+                                         [mapping, mapSize]() { munmap(mapping, mapSize); });
+#else
+    DAWN_UNUSED(fd);
+    DAWN_UNUSED(offset);
+    DAWN_UNUSED(size);
+    return Blob();
+#endif
+}
+
 // static
 Blob Blob::UnsafeCreateWithDeleter(uint8_t* data, size_t size, std::function<void()> deleter) {
     return Blob(data, size, deleter);
@@ -62,6 +62,13 @@ class Blob {
 
 Blob CreateBlob(size_t size, size_t alignment = 1);
 
+// Creates a read-only Blob backed by a memory mapping of |size| bytes at |offset| in the file
+// referred to by |fd|, so the contents page in on demand and physical pages are shared between
+// processes mapping the same file. The mapping is created before returning; the caller may
+// close |fd| afterwards. Returns an empty Blob if the region cannot be mapped (including on
+// platforms without mmap). The mapping is read-only: writing through Data() is invalid.
+Blob CreateBlobFromFileRegion(int fd, uint64_t offset, size_t size);
+
 template <typename T, typename = std::enable_if_t<std::is_fundamental_v<T>>>
 Blob CreateBlob(std::vector<T> vec) {
     uint8_t* data = reinterpret_cast<uint8_t*>(vec.data());
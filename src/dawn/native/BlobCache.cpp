@@ -15,6 +15,7 @@
 #include "dawn/native/BlobCache.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "dawn/common/Assert.h"
 #include "dawn/common/Version_autogen.h"
@@ -24,15 +25,50 @@
 
 namespace dawn::native {
 
+namespace {
+
+// Upper bound on the size of a single stored value. The backing store belongs to the embedder
+// which is responsible for overall size management and eviction through its CachingInterface;
+// this bound just keeps a runaway value (e.g. a huge monolithic pipeline cache) from crowding
+// everything else out of that store.
+constexpr size_t kMaxValueSize = 64 * 1024 * 1024;
+
+// Budget for the in-memory LRU front of the cache, split evenly across its shards. Individual
+// values larger than a shard's slice are never memoized; typical entries (transformed shaders,
+// pipeline blobs) are a few KB.
+constexpr size_t kMaxInMemoryCacheSize = 8 * 1024 * 1024;
+
+}  // anonymous namespace
+
 BlobCache::BlobCache(dawn::platform::CachingInterface* cachingInterface)
     : mCache(cachingInterface) {}
 
 Blob BlobCache::Load(const CacheKey& key) {
-    std::lock_guard<std::mutex> lock(mMutex);
-    return LoadInternal(key);
+    return Load(key, stream::ComputeFingerprint(key.data(), key.size()));
+}
+
+Blob BlobCache::Load(const CacheKey& key, const stream::Fingerprint& fingerprint) {
+    Blob memoized = LoadFromMemoryCache(fingerprint);
+    if (!memoized.Empty()) {
+        return memoized;
+    }
+    Blob blob;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        blob = LoadInternal(key);
+    }
+    if (!blob.Empty()) {
+        StoreInMemoryCache(fingerprint, blob.Size(), blob.Data());
+    }
+    return blob;
+}
+
+Blob BlobCache::LoadFromFingerprint(const stream::Fingerprint& fingerprint) {
+    return LoadFromMemoryCache(fingerprint);
 }
 
 void BlobCache::Store(const CacheKey& key, size_t valueSize, const void* value) {
+    StoreInMemoryCache(stream::ComputeFingerprint(key.data(), key.size()), valueSize, value);
     std::lock_guard<std::mutex> lock(mMutex);
     StoreInternal(key, valueSize, value);
 }
@@ -46,6 +82,16 @@ Blob BlobCache::LoadInternal(const CacheKey& key) {
     if (mCache == nullptr) {
         return Blob();
     }
+    // Prefer the zero-copy path: if the embedder stores values in a file it can hand back the
+    // region directly and the blob is a demand-paged mapping instead of a heap copy.
+    dawn::platform::CachingInterface::FileRegion region;
+    if (mCache->LoadDataFileRegion(key.data(), key.size(), &region)) {
+        Blob mapped = CreateBlobFromFileRegion(region.fd, region.offset, region.size);
+        if (!mapped.Empty()) {
+            return mapped;
+        }
+        // Mapping failed; fall through to the copying load.
+    }
     const size_t expectedSize = mCache->LoadData(key.data(), key.size(), nullptr, 0);
     if (expectedSize > 0) {
         // Need to put this inside to trigger copy elision.
@@ -65,9 +111,64 @@ void BlobCache::StoreInternal(const CacheKey& key, size_t valueSize, const void*
     if (mCache == nullptr) {
         return;
     }
+    if (valueSize > kMaxValueSize) {
+        return;
+    }
     mCache->StoreData(key.data(), key.size(), value, valueSize);
 }
 
+BlobCache::MemoryCacheShard& BlobCache::GetMemoryCacheShard(
+    const stream::Fingerprint& fingerprint) {
+    // The fingerprint is already a hash of the whole key; any of its bits pick a shard evenly.
+    return mMemoryCacheShards[fingerprint.low % kNumMemoryCacheShards];
+}
+
+Blob BlobCache::LoadFromMemoryCache(const stream::Fingerprint& fingerprint) {
+    MemoryCacheShard& shard = GetMemoryCacheShard(fingerprint);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto iter = shard.index.find(fingerprint);
+    if (iter == shard.index.end()) {
+        return Blob();
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+    const std::vector<uint8_t>& data = iter->second->second;
+    Blob result = CreateBlob(data.size());
+    memcpy(result.Data(), data.data(), data.size());
+    return result;
+}
+
+void BlobCache::StoreInMemoryCache(const stream::Fingerprint& fingerprint,
+                                   size_t valueSize,
+                                   const void* value) {
+    constexpr size_t kShardBudget = kMaxInMemoryCacheSize / kNumMemoryCacheShards;
+    if (valueSize == 0 || valueSize > kShardBudget) {
+        return;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(value);
+
+    MemoryCacheShard& shard = GetMemoryCacheShard(fingerprint);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto iter = shard.index.find(fingerprint);
+    if (iter != shard.index.end()) {
+        shard.size -= iter->second->second.size();
+        iter->second->second.assign(bytes, bytes + valueSize);
+        shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+    } else {
+        shard.lru.emplace_front(fingerprint, std::vector<uint8_t>(bytes, bytes + valueSize));
+        shard.index.emplace(fingerprint, shard.lru.begin());
+    }
+    shard.size += valueSize;
+
+    while (shard.size > kShardBudget) {
+        const auto& oldest = shard.lru.back();
+        shard.size -= oldest.second.size();
+        shard.index.erase(oldest.first);
+        shard.lru.pop_back();
+    }
+}
+
 bool BlobCache::ValidateCacheKey(const CacheKey& key) {
     return std::search(key.begin(), key.end(), kDawnVersion.begin(), kDawnVersion.end()) !=
            key.end();
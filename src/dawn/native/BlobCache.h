@@ -15,11 +15,17 @@
 #ifndef SRC_DAWN_NATIVE_BLOBCACHE_H_
 #define SRC_DAWN_NATIVE_BLOBCACHE_H_
 
+#include <cstdint>
+#include <list>
 #include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "dawn/common/Platform.h"
 #include "dawn/native/Blob.h"
 #include "dawn/native/CacheResult.h"
+#include "dawn/native/stream/HashingSink.h"
 
 namespace dawn::platform {
 class CachingInterface;
@@ -39,6 +45,14 @@ class BlobCache {
     // Returns empty blob if the key is not found in the cache.
     Blob Load(const CacheKey& key);
 
+    // Same as Load() but reuses a fingerprint the caller already computed for the key.
+    Blob Load(const CacheKey& key, const stream::Fingerprint& fingerprint);
+
+    // Consults only the in-memory front using the fingerprint of a serialized key. This lets
+    // callers hash a key during traversal and defer materializing its bytes until the embedder
+    // cache must be queried (see CacheRequestImpl::LoadOrRun).
+    Blob LoadFromFingerprint(const stream::Fingerprint& fingerprint);
+
     // Value to store must be non-empty/non-null.
     void Store(const CacheKey& key, size_t valueSize, const void* value);
     void Store(const CacheKey& key, const Blob& value);
@@ -62,9 +76,40 @@ class BlobCache {
     // that the cache key contains the dawn version string in it.
     bool ValidateCacheKey(const CacheKey& key);
 
-    // Protects thread safety of access to mCache.
+    // In-memory front for the platform cache so that hot keys (e.g. Tint transform results
+    // reused across pipeline compiles) don't re-run the computation or go through embedder IO.
+    // This is also the only cache level when no CachingInterface is provided. Entries are
+    // indexed by key fingerprint so lookups never copy the key bytes. These lock the shard
+    // the fingerprint maps to internally.
+    Blob LoadFromMemoryCache(const stream::Fingerprint& fingerprint);
+    void StoreInMemoryCache(const stream::Fingerprint& fingerprint,
+                            size_t valueSize,
+                            const void* value);
+
+    // Serializes calls into the embedder CachingInterface, which is not required to be
+    // thread-safe.
     std::mutex mMutex;
     dawn::platform::CachingInterface* mCache;
+
+    // Entries ordered most to least recently used; evicted from the back once the total data
+    // size exceeds the shard's slice of the in-memory budget.
+    using MemoryCacheEntries = std::list<std::pair<stream::Fingerprint, std::vector<uint8_t>>>;
+
+    // The in-memory front is sharded by fingerprint so that threads compiling in parallel
+    // (e.g. the devices of one instance warming identical pipelines) mostly take disjoint
+    // locks instead of serializing on a single one.
+    static constexpr size_t kNumMemoryCacheShards = 8;
+    struct MemoryCacheShard {
+        std::mutex mutex;
+        MemoryCacheEntries lru;
+        std::unordered_map<stream::Fingerprint,
+                           MemoryCacheEntries::iterator,
+                           stream::Fingerprint::HashFunc>
+            index;
+        size_t size = 0;
+    };
+    MemoryCacheShard& GetMemoryCacheShard(const stream::Fingerprint& fingerprint);
+    MemoryCacheShard mMemoryCacheShards[kNumMemoryCacheShards];
 };
 
 }  // namespace dawn::native
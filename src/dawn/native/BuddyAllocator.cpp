@@ -23,13 +23,20 @@ BuddyAllocator::BuddyAllocator(uint64_t maxSize) : mMaxBlockSize(maxSize) {
     ASSERT(IsPowerOfTwo(maxSize));
 
     mFreeLists.resize(Log2(mMaxBlockSize) + 1);
+    ASSERT(mFreeLists.size() <= 64);  // Each level must have a bit in mFreeLevelMask.
 
     // Insert the level0 free block.
     mRoot = new BuddyBlock(maxSize, /*offset*/ 0);
     mFreeLists[0] = {mRoot};
+    mFreeLevelMask = 1;
 }
 
 BuddyAllocator::~BuddyAllocator() {
+    while (mBlockPool != nullptr) {
+        BuddyBlock* next = mBlockPool->free.pNext;
+        delete mBlockPool;
+        mBlockPool = next;
+    }
     if (mRoot) {
         DeleteBlock(mRoot);
     }
@@ -81,6 +88,21 @@ uint64_t BuddyAllocator::GetNextFreeAlignedBlock(size_t allocationBlockLevel,
     //  Allocate(size=8, alignment=4) will be satified by using F1.
     //  Allocate(size=8, alignment=16) will be satisified by using F2.
     //
+    // Every block at a level is naturally aligned to that level's block size, so when the
+    // alignment does not exceed the allocation's block size any free block at the candidate
+    // levels is usable: the smallest one is found with a single find-first-set over the
+    // per-level occupancy mask.
+    if (alignment <= (mMaxBlockSize >> allocationBlockLevel)) {
+        uint64_t candidateLevels =
+            mFreeLevelMask &
+            (allocationBlockLevel >= 63 ? ~uint64_t(0)
+                                        : (uint64_t(1) << (allocationBlockLevel + 1)) - 1);
+        if (candidateLevels == 0) {
+            return kInvalidOffset;  // No free block exists at any level.
+        }
+        return Log2(candidateLevels);
+    }
+
     for (size_t ii = 0; ii <= allocationBlockLevel; ++ii) {
         size_t currLevel = allocationBlockLevel - ii;
         BuddyBlock* freeBlock = mFreeLists[currLevel].head;
@@ -111,6 +133,7 @@ void BuddyAllocator::InsertFreeBlock(BuddyBlock* block, size_t level) {
     }
 
     mFreeLists[level].head = block;
+    mFreeLevelMask |= uint64_t(1) << level;
 }
 
 void BuddyAllocator::RemoveFreeBlock(BuddyBlock* block, size_t level) {
@@ -134,6 +157,25 @@ void BuddyAllocator::RemoveFreeBlock(BuddyBlock* block, size_t level) {
             pNext->free.pPrev = pPrev;
         }
     }
+
+    if (mFreeLists[level].head == nullptr) {
+        mFreeLevelMask &= ~(uint64_t(1) << level);
+    }
+}
+
+BuddyAllocator::BuddyBlock* BuddyAllocator::AllocateBlock(uint64_t size, uint64_t offset) {
+    if (mBlockPool != nullptr) {
+        BuddyBlock* block = mBlockPool;
+        mBlockPool = block->free.pNext;
+        *block = BuddyBlock(size, offset);
+        return block;
+    }
+    return new BuddyBlock(size, offset);
+}
+
+void BuddyAllocator::RecycleBlock(BuddyBlock* block) {
+    block->free.pNext = mBlockPool;
+    mBlockPool = block;
 }
 
 uint64_t BuddyAllocator::Allocate(uint64_t allocationSize, uint64_t alignment) {
@@ -166,9 +208,9 @@ uint64_t BuddyAllocator::Allocate(uint64_t allocationSize, uint64_t alignment) {
 
         // Create two free child blocks (the buddies).
         const uint64_t nextLevelSize = currBlock->mSize / 2;
-        BuddyBlock* leftChildBlock = new BuddyBlock(nextLevelSize, currBlock->mOffset);
+        BuddyBlock* leftChildBlock = AllocateBlock(nextLevelSize, currBlock->mOffset);
         BuddyBlock* rightChildBlock =
-            new BuddyBlock(nextLevelSize, currBlock->mOffset + nextLevelSize);
+            AllocateBlock(nextLevelSize, currBlock->mOffset + nextLevelSize);
 
         // Remember the parent to merge these back upon de-allocation.
         rightChildBlock->pParent = currBlock;
@@ -234,9 +276,9 @@ void BuddyAllocator::Deallocate(uint64_t offset) {
         BuddyBlock* parent = curr->pParent;
 
         // The buddies were inserted in a specific order but
-        // could be deleted in any order.
-        DeleteBlock(curr->pBuddy);
-        DeleteBlock(curr);
+        // could be recycled in any order.
+        RecycleBlock(curr->pBuddy);
+        RecycleBlock(curr);
 
         // Parent is now free.
         parent->mState = BlockState::Free;
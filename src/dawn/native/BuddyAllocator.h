@@ -95,6 +95,11 @@ class BuddyAllocator {
     void RemoveFreeBlock(BuddyBlock* block, size_t level);
     void DeleteBlock(BuddyBlock* block);
 
+    // Blocks are recycled through a pool instead of the heap: split/merge churn during
+    // allocation spikes would otherwise hit new/delete for every level crossed.
+    BuddyBlock* AllocateBlock(uint64_t size, uint64_t offset);
+    void RecycleBlock(BuddyBlock* block);
+
     uint64_t ComputeNumOfFreeBlocks(BuddyBlock* block) const;
 
     // Keep track the head and tail (for faster insertion/removal).
@@ -110,6 +115,14 @@ class BuddyAllocator {
     // List of linked-lists of free blocks where the index is a level that
     // corresponds to a power-of-two sized block.
     std::vector<BlockList> mFreeLists;
+
+    // Bit N is set iff mFreeLists[N] is non-empty, so the level search in Allocate is a single
+    // find-first-set instead of a walk over the levels. The deepest possible tree (1-byte
+    // blocks out of a 2^63 byte root) has 64 levels, so a uint64_t always suffices.
+    uint64_t mFreeLevelMask = 0;
+
+    // Singly-linked list (through free.pNext) of recycled blocks, reused by AllocateBlock.
+    BuddyBlock* mBlockPool = nullptr;
 };
 
 }  // namespace dawn::native
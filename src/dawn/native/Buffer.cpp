@@ -17,6 +17,7 @@
 #include <cstdio>
 #include <cstring>
 #include <limits>
+#include <mutex>
 #include <utility>
 
 #include "dawn/common/Alloc.h"
@@ -189,6 +190,9 @@ void BufferBase::DestroyImpl() {
         }
     }
     mState = BufferState::Destroyed;
+    // Command buffers referencing this buffer may have a cached submit validation verdict
+    // that destruction invalidates.
+    GetDevice()->IncrementSubmitValidationGeneration();
 }
 
 // static
@@ -235,10 +239,11 @@ MaybeError BufferBase::MapAtCreation() {
         return {};
     } else if (mStagingBuffer) {
         // If there is a staging buffer for initialization, clear its contents directly.
-        // It should be exactly as large as the buffer allocation.
+        // Pooled staging buffers are rounded up to their size class, so it may be larger than
+        // the buffer allocation; only the allocation is copied out on unmap.
         ptr = mStagingBuffer->GetMappedPointer();
-        size = mStagingBuffer->GetSize();
-        ASSERT(size == GetAllocatedSize());
+        size = GetAllocatedSize();
+        ASSERT(mStagingBuffer->GetSize() >= GetAllocatedSize());
     } else {
         // Otherwise, the buffer is directly mappable on the CPU.
         ptr = GetMappedPointerImpl();
@@ -272,11 +277,13 @@ MaybeError BufferBase::MapAtCreationInternal() {
         } else {
             // If any of these fail, the buffer will be deleted and replaced with an error
             // buffer. The staging buffer is used to return mappable data to inititalize the
-            // buffer contents. Allocate one as large as the real buffer size so that every byte
-            // is initialized.
+            // buffer contents. Acquire one as large as the real buffer size so that every byte
+            // is initialized; the staging buffer pool recycles these across buffers since
+            // asset streaming creates them at a high rate.
             // TODO(crbug.com/dawn/828): Suballocate and reuse memory from a larger staging
             // buffer so we don't create many small buffers.
-            DAWN_TRY_ASSIGN(mStagingBuffer, GetDevice()->CreateStagingBuffer(GetAllocatedSize()));
+            DAWN_TRY_ASSIGN(mStagingBuffer, GetDevice()->GetDynamicUploader()->AcquireStagingBuffer(
+                                                GetAllocatedSize()));
         }
     }
 
@@ -330,17 +337,30 @@ void BufferBase::APIMapAsync(wgpu::MapMode mode,
         size = mSize - offset;
     }
 
-    WGPUBufferMapAsyncStatus status;
-    if (GetDevice()->ConsumedError(ValidateMapAsync(mode, offset, size, &status),
-                                   "calling %s.MapAsync(%s, %u, %u, ...).", this, mode, offset,
-                                   size)) {
-        if (callback) {
-            callback(status, userdata);
+    // Fast path for per-frame map/unmap cycles: when the exact same request already passed
+    // validation on this buffer and the buffer is back to Unmapped, only the mutable inputs of
+    // the validation (buffer state above, device loss) need rechecking.
+    bool revalidated = !(mMapRequestValidated && mState == BufferState::Unmapped &&
+                         mode == mMapMode && offset == mMapOffset && size == mMapSize &&
+                         !GetDevice()->IsLost());
+    if (revalidated) {
+        WGPUBufferMapAsyncStatus status;
+        if (GetDevice()->ConsumedError(ValidateMapAsync(mode, offset, size, &status),
+                                       "calling %s.MapAsync(%s, %u, %u, ...).", this, mode, offset,
+                                       size)) {
+            if (callback) {
+                callback(status, userdata);
+            }
+            return;
         }
-        return;
+        mMapRequestValidated = true;
     }
     ASSERT(!IsError());
 
+    // The map state and the in-flight task list are also touched when the device ticks, which
+    // may happen on the background tick thread.
+    std::lock_guard<std::recursive_mutex> lock(GetDevice()->GetTickMutex());
+
     mLastMapID++;
     mMapMode = mode;
     mMapOffset = offset;
@@ -349,14 +369,19 @@ void BufferBase::APIMapAsync(wgpu::MapMode mode,
     mMapUserdata = userdata;
     mState = BufferState::Mapped;
 
+    // A mapped buffer is invalid to use in a submit, so command buffers referencing it must
+    // not reuse a cached submit validation verdict.
+    GetDevice()->IncrementSubmitValidationGeneration();
+
     if (GetDevice()->ConsumedError(MapAsyncImpl(mode, offset, size))) {
         CallMapCallback(mLastMapID, WGPUBufferMapAsyncStatus_DeviceLost);
         return;
     }
     std::unique_ptr<MapRequestTask> request = std::make_unique<MapRequestTask>(this, mLastMapID);
+    QueueBase* queue = GetDevice()->GetQueue();
     TRACE_EVENT1(GetDevice()->GetPlatform(), General, "Buffer::APIMapAsync", "serial",
-                 uint64_t(GetDevice()->GetPendingCommandSerial()));
-    GetDevice()->GetQueue()->TrackTask(std::move(request), GetDevice()->GetPendingCommandSerial());
+                 uint64_t(queue->GetPendingCommandSerial()));
+    queue->TrackTask(std::move(request), queue->GetPendingCommandSerial());
 }
 
 void* BufferBase::APIGetMappedRange(size_t offset, size_t size) {
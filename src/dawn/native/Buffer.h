@@ -132,6 +132,19 @@ class BufferBase : public ApiObjectBase {
     wgpu::MapMode mMapMode = wgpu::MapMode::None;
     size_t mMapOffset = 0;
     size_t mMapSize = 0;
+    // Whether mMapMode/mMapOffset/mMapSize hold a request that passed full MapAsync validation.
+    // Everything that validation checks besides them is either immutable (size, usage) or
+    // rechecked on the fast path (buffer state, device loss), so a repeat of the same request
+    // can skip revalidation. Never needs clearing for the same reason.
+    bool mMapRequestValidated = false;
+
+    // Scratch state owned by SyncScopeUsageTracker: the serial of the last sync scope this
+    // buffer was inserted into and its slot there, so repeat insertions in the same scope are
+    // a single compare instead of a map lookup. Follows the external synchronization of
+    // command encoding; 0 means "never tracked".
+    friend class SyncScopeUsageTracker;
+    uint64_t mLastUsageTrackerSerial = 0;
+    uint32_t mLastUsageTrackerIndex = 0;
 };
 
 }  // namespace dawn::native
@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_CACHEREQUEST_H_
 #define SRC_DAWN_NATIVE_CACHEREQUEST_H_
 
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -27,6 +28,7 @@
 #include "dawn/native/Device.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/VisitableMembers.h"
+#include "dawn/native/stream/HashingSink.h"
 
 namespace dawn::native {
 
@@ -95,15 +97,31 @@ class CacheRequestImpl {
     CacheRequestImpl(const CacheRequestImpl&) = delete;
     CacheRequestImpl& operator=(const CacheRequestImpl&) = delete;
 
+    // Serialize the device key, the request type and all members into `sink`, which may either
+    // materialize the bytes (CacheKey) or hash them during traversal (stream::HashingSink).
+    template <typename SINK>
+    void StreamKey(const DeviceBase* device, SINK* sink) const {
+        const CacheKey& deviceKey = device->GetCacheKey();
+        memcpy(sink->GetSpace(deviceKey.size()), deviceKey.data(), deviceKey.size());
+        StreamIn(sink, Request::kName);
+        static_cast<const Request*>(this)->VisitAll(
+            [&](const auto&... members) { StreamIn(sink, members...); });
+    }
+
     // Create a CacheKey from the request type and all members
     CacheKey CreateCacheKey(const DeviceBase* device) const {
-        CacheKey key = device->GetCacheKey();
-        StreamIn(&key, Request::kName);
-        static_cast<const Request*>(this)->VisitAll(
-            [&](const auto&... members) { StreamIn(&key, members...); });
+        CacheKey key;
+        StreamKey(device, &key);
         return key;
     }
 
+    // Compute the fingerprint of the cache key without materializing its bytes.
+    stream::Fingerprint CreateFingerprint(const DeviceBase* device) const {
+        stream::HashingSink sink;
+        StreamKey(device, &sink);
+        return sink.Finalize();
+    }
+
     template <typename CacheHitFn, typename CacheMissFn>
     friend auto LoadOrRun(DeviceBase* device,
                           Request&& r,
@@ -128,11 +146,23 @@ class CacheRequestImpl {
         using CacheResultType = CacheResult<UnwrappedReturnType>;
         using ReturnType = ResultOrError<CacheResultType>;
 
-        CacheKey key = r.CreateCacheKey(device);
+        CacheKey key;
         BlobCache* cache = device->GetBlobCache();
         Blob blob;
         if (cache != nullptr) {
-            blob = cache->Load(key);
+            // Probe the in-memory front with a fingerprint hashed during traversal; the key
+            // bytes are only materialized when the embedder cache must be consulted, or when a
+            // miss needs a key to store the result under. A fingerprint hit therefore returns a
+            // CacheResult carrying an empty key, which is fine since the key of a hit is only
+            // read by EnsureStored, and EnsureStored only stores misses.
+            stream::Fingerprint fingerprint = r.CreateFingerprint(device);
+            blob = cache->LoadFromFingerprint(fingerprint);
+            if (blob.Empty()) {
+                key = r.CreateCacheKey(device);
+                blob = cache->Load(key, fingerprint);
+            }
+        } else {
+            key = r.CreateCacheKey(device);
         }
 
         if (!blob.Empty()) {
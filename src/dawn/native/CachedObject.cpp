@@ -46,10 +46,20 @@ const CacheKey& CachedObject::GetCacheKey() const {
     return mCacheKey;
 }
 
+const stream::Fingerprint& CachedObject::GetCacheKeyFingerprint() const {
+    if (!mIsFingerprintInitialized) {
+        mCacheKeyFingerprint = stream::ComputeFingerprint(mCacheKey.data(), mCacheKey.size());
+        mIsFingerprintInitialized = true;
+    }
+    return mCacheKeyFingerprint;
+}
+
 // static
 template <>
 void stream::Stream<CachedObject>::Write(stream::Sink* sink, const CachedObject& obj) {
-    StreamIn(sink, obj.GetCacheKey());
+    // Stream the fixed-size fingerprint rather than the full key; copying nested keys
+    // dominated the cost of constructing keys that reference several cached objects.
+    StreamIn(sink, obj.GetCacheKeyFingerprint());
 }
 
 }  // namespace dawn::native
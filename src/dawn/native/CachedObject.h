@@ -20,6 +20,7 @@
 
 #include "dawn/native/CacheKey.h"
 #include "dawn/native/Forward.h"
+#include "dawn/native/stream/HashingSink.h"
 
 namespace dawn::native {
 
@@ -42,6 +43,11 @@ class CachedObject {
     // Returns the cache key for the object only, i.e. without device/adapter information.
     const CacheKey& GetCacheKey() const;
 
+    // Returns the fingerprint of the cache key, computed once on first use after creation.
+    // Streaming this fixed-size value instead of the full key keeps dependent keys (e.g.
+    // pipelines referencing layouts and modules) small and cheap to construct.
+    const stream::Fingerprint& GetCacheKeyFingerprint() const;
+
   protected:
     // Cache key member is protected so that derived classes can modify it.
     CacheKey mCacheKey;
@@ -57,6 +63,11 @@ class CachedObject {
 
     size_t mContentHash = 0;
     bool mIsContentHashInitialized = false;
+
+    // Lazily computed so that derived class constructors can finish appending to mCacheKey;
+    // the first use is always after creation, when the object is referenced by another key.
+    mutable stream::Fingerprint mCacheKeyFingerprint;
+    mutable bool mIsFingerprintInitialized = false;
 };
 
 }  // namespace dawn::native
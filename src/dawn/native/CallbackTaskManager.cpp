@@ -14,30 +14,51 @@
 
 #include "dawn/native/CallbackTaskManager.h"
 
-#include <utility>
+#include <algorithm>
 
 namespace dawn::native {
 
 CallbackTaskManager::CallbackTaskManager() = default;
 
-CallbackTaskManager::~CallbackTaskManager() = default;
+CallbackTaskManager::~CallbackTaskManager() {
+    // Free tasks that were never flushed without invoking their callbacks; the device drains
+    // the queue on shutdown, so anything still linked here belongs to an abandoned manager.
+    CallbackTask* node = mHead.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr) {
+        CallbackTask* next = node->mNext;
+        delete node;
+        node = next;
+    }
+}
 
 bool CallbackTaskManager::IsEmpty() {
-    std::lock_guard<std::mutex> lock(mCallbackTaskQueueMutex);
-    return mCallbackTaskQueue.empty();
+    return mHead.load(std::memory_order_acquire) == nullptr;
 }
 
 std::vector<std::unique_ptr<CallbackTask>> CallbackTaskManager::AcquireCallbackTasks() {
-    std::lock_guard<std::mutex> lock(mCallbackTaskQueueMutex);
+    // A single exchange detaches the whole batch, so concurrent producers never block the
+    // flush and vice versa.
+    CallbackTask* node = mHead.exchange(nullptr, std::memory_order_acquire);
 
     std::vector<std::unique_ptr<CallbackTask>> allTasks;
-    allTasks.swap(mCallbackTaskQueue);
+    while (node != nullptr) {
+        CallbackTask* next = node->mNext;
+        node->mNext = nullptr;
+        allTasks.emplace_back(node);
+        node = next;
+    }
+    // Producers push LIFO; restore submission order for the callbacks.
+    std::reverse(allTasks.begin(), allTasks.end());
     return allTasks;
 }
 
 void CallbackTaskManager::AddCallbackTask(std::unique_ptr<CallbackTask> callbackTask) {
-    std::lock_guard<std::mutex> lock(mCallbackTaskQueueMutex);
-    mCallbackTaskQueue.push_back(std::move(callbackTask));
+    CallbackTask* task = callbackTask.release();
+    CallbackTask* head = mHead.load(std::memory_order_relaxed);
+    do {
+        task->mNext = head;
+    } while (!mHead.compare_exchange_weak(head, task, std::memory_order_release,
+                                          std::memory_order_relaxed));
 }
 
 }  // namespace dawn::native
@@ -15,20 +15,30 @@
 #ifndef SRC_DAWN_NATIVE_CALLBACKTASKMANAGER_H_
 #define SRC_DAWN_NATIVE_CALLBACKTASKMANAGER_H_
 
+#include <atomic>
 #include <memory>
-#include <mutex>
 #include <vector>
 
 namespace dawn::native {
 
+class CallbackTaskManager;
+
 struct CallbackTask {
   public:
     virtual ~CallbackTask() = default;
     virtual void Finish() = 0;
     virtual void HandleShutDown() = 0;
     virtual void HandleDeviceLoss() = 0;
+
+  private:
+    friend class CallbackTaskManager;
+    // Intrusive link for CallbackTaskManager's lock-free list.
+    CallbackTask* mNext = nullptr;
 };
 
+// Collects callback tasks completed by worker threads until the main thread flushes them during
+// Tick. Producers push onto an intrusive lock-free list so that thousands of concurrent async
+// completions don't contend on a mutex; the flush grabs the whole batch with a single exchange.
 class CallbackTaskManager {
   public:
     CallbackTaskManager();
@@ -36,11 +46,14 @@ class CallbackTaskManager {
 
     void AddCallbackTask(std::unique_ptr<CallbackTask> callbackTask);
     bool IsEmpty();
+
+    // Detaches all queued tasks at once, in submission order.
     std::vector<std::unique_ptr<CallbackTask>> AcquireCallbackTasks();
 
   private:
-    std::mutex mCallbackTaskQueueMutex;
-    std::vector<std::unique_ptr<CallbackTask>> mCallbackTaskQueue;
+    // Head of an intrusive LIFO list; AcquireCallbackTasks reverses the detached batch to
+    // recover submission order.
+    std::atomic<CallbackTask*> mHead{nullptr};
 };
 
 }  // namespace dawn::native
@@ -15,6 +15,7 @@
 #include "dawn/native/CommandAllocator.h"
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
 #include <cstdlib>
 #include <utility>
@@ -24,6 +25,89 @@
 
 namespace dawn::native {
 
+namespace {
+
+// Block sizes double up to kPooledBlockSize (see GetNewBlock) so allocators recording many
+// commands quickly converge to requesting blocks of exactly that size. Those blocks are
+// recycled through a process-wide lock-free freelist instead of being returned to the system
+// allocator, which removes the malloc/free churn of building and destroying command buffers
+// every frame. Differently-sized blocks (initial small blocks and oversized single-command
+// blocks) keep going through malloc/free directly.
+constexpr size_t kPooledBlockSize = 16384;
+
+// Caps the pool memory at kMaxPooledBlocks * kPooledBlockSize (4MB).
+constexpr size_t kMaxPooledBlocks = 256;
+
+// Freelist node stored in the first bytes of a recycled block. The next pointer is atomic
+// only so that the racy read in PopPooledBlock (where the node may concurrently be popped
+// and overwritten with command data) is well-defined; the tag check makes the CAS fail in
+// that case.
+struct FreeBlock {
+    std::atomic<FreeBlock*> next;
+};
+
+// The head pointer is tagged with a pop count so that concurrent pops cannot suffer from
+// ABA. std::atomic falls back to a lock when the platform has no double-width CAS, which
+// keeps this correct everywhere while being lock-free on the common platforms.
+struct BlockPoolHead {
+    FreeBlock* block;
+    uintptr_t tag;
+};
+
+std::atomic<BlockPoolHead> sBlockPool = BlockPoolHead{nullptr, 0};
+std::atomic<size_t> sPooledBlockCount{0};
+
+uint8_t* PopPooledBlock() {
+    BlockPoolHead head = sBlockPool.load(std::memory_order_acquire);
+    while (head.block != nullptr) {
+        BlockPoolHead next = {head.block->next.load(std::memory_order_relaxed), head.tag + 1};
+        if (sBlockPool.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+            sPooledBlockCount.fetch_sub(1, std::memory_order_relaxed);
+            return reinterpret_cast<uint8_t*>(head.block);
+        }
+    }
+    return nullptr;
+}
+
+void PushPooledBlock(uint8_t* block, bool everPooled) {
+    // Memory reachable from the pool head at any point in the past must never be returned to
+    // the system: PopPooledBlock reads |next| from a speculatively loaded head, so a stale
+    // reader may still dereference a block long after it was popped. Blocks that have ever
+    // been in the pool (everPooled) are therefore always re-pooled, even above the cap; the
+    // pop that handed them out decremented the count, so the pool stays bounded. Only blocks
+    // that were malloc'd and never pooled may be freed when the pool is full.
+    if (everPooled) {
+        sPooledBlockCount.fetch_add(1, std::memory_order_relaxed);
+    } else if (sPooledBlockCount.fetch_add(1, std::memory_order_relaxed) >= kMaxPooledBlocks) {
+        sPooledBlockCount.fetch_sub(1, std::memory_order_relaxed);
+        free(block);
+        return;
+    }
+
+    FreeBlock* node = reinterpret_cast<FreeBlock*>(block);
+    BlockPoolHead head = sBlockPool.load(std::memory_order_acquire);
+    BlockPoolHead next;
+    do {
+        node->next.store(head.block, std::memory_order_relaxed);
+        next = {node, head.tag + 1};
+    } while (!sBlockPool.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                               std::memory_order_acquire));
+}
+
+void FreeBlocks(CommandBlocks* blocks) {
+    for (BlockDef& block : *blocks) {
+        if (block.fromPool || block.size == kPooledBlockSize) {
+            PushPooledBlock(block.block, block.fromPool);
+        } else {
+            free(block.block);
+        }
+    }
+    blocks->clear();
+}
+
+}  // namespace
+
 // TODO(cwallez@chromium.org): figure out a way to have more type safety for the iterator
 
 CommandIterator::CommandIterator() {
@@ -102,10 +186,7 @@ void CommandIterator::MakeEmptyAsDataWasDestroyed() {
         return;
     }
 
-    for (BlockDef& block : mBlocks) {
-        free(block.block);
-    }
-    mBlocks.clear();
+    FreeBlocks(&mBlocks);
     Reset();
     ASSERT(IsEmpty());
 }
@@ -133,7 +214,10 @@ CommandAllocator::~CommandAllocator() {
 }
 
 CommandAllocator::CommandAllocator(CommandAllocator&& other)
-    : mBlocks(std::move(other.mBlocks)), mLastAllocationSize(other.mLastAllocationSize) {
+    : mBlocks(std::move(other.mBlocks)),
+      mLastAllocationSize(other.mLastAllocationSize),
+      mAllocatedBytes(other.mAllocatedBytes),
+      mAllocatedCommandCount(other.mAllocatedCommandCount) {
     other.mBlocks.clear();
     if (!other.IsEmpty()) {
         mCurrentPtr = other.mCurrentPtr;
@@ -149,6 +233,8 @@ CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
     if (!other.IsEmpty()) {
         std::swap(mBlocks, other.mBlocks);
         mLastAllocationSize = other.mLastAllocationSize;
+        mAllocatedBytes = other.mAllocatedBytes;
+        mAllocatedCommandCount = other.mAllocatedCommandCount;
         mCurrentPtr = other.mCurrentPtr;
         mEndPtr = other.mEndPtr;
     }
@@ -157,11 +243,10 @@ CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
 }
 
 void CommandAllocator::Reset() {
-    for (BlockDef& block : mBlocks) {
-        free(block.block);
-    }
-    mBlocks.clear();
+    FreeBlocks(&mBlocks);
     mLastAllocationSize = kDefaultBaseAllocationSize;
+    mAllocatedBytes = 0;
+    mAllocatedCommandCount = 0;
     ResetPointers();
 }
 
@@ -169,6 +254,14 @@ bool CommandAllocator::IsEmpty() const {
     return mCurrentPtr == reinterpret_cast<const uint8_t*>(&mPlaceholderEnum[0]);
 }
 
+uint64_t CommandAllocator::GetAllocatedBytes() const {
+    return mAllocatedBytes;
+}
+
+uint64_t CommandAllocator::GetAllocatedCommandCount() const {
+    return mAllocatedCommandCount;
+}
+
 CommandBlocks&& CommandAllocator::AcquireBlocks() {
     ASSERT(mCurrentPtr != nullptr && mEndPtr != nullptr);
     ASSERT(IsPtrAligned(mCurrentPtr, alignof(uint32_t)));
@@ -204,15 +297,25 @@ uint8_t* CommandAllocator::AllocateInNewBlock(uint32_t commandId,
 }
 
 bool CommandAllocator::GetNewBlock(size_t minimumSize) {
-    // Allocate blocks doubling sizes each time, to a maximum of 16k (or at least minimumSize).
-    mLastAllocationSize = std::max(minimumSize, std::min(mLastAllocationSize * 2, size_t(16384)));
-
-    uint8_t* block = static_cast<uint8_t*>(malloc(mLastAllocationSize));
+    // Allocate blocks doubling sizes each time, to a maximum of kPooledBlockSize (or at least
+    // minimumSize).
+    mLastAllocationSize =
+        std::max(minimumSize, std::min(mLastAllocationSize * 2, kPooledBlockSize));
+
+    uint8_t* block = nullptr;
+    bool fromPool = false;
+    if (mLastAllocationSize == kPooledBlockSize) {
+        block = PopPooledBlock();
+        fromPool = block != nullptr;
+    }
+    if (block == nullptr) {
+        block = static_cast<uint8_t*>(malloc(mLastAllocationSize));
+    }
     if (DAWN_UNLIKELY(block == nullptr)) {
         return false;
     }
 
-    mBlocks.push_back({mLastAllocationSize, block});
+    mBlocks.push_back({mLastAllocationSize, block, fromPool});
     mCurrentPtr = AlignPtr(block, alignof(uint32_t));
     mEndPtr = block + mLastAllocationSize;
     return true;
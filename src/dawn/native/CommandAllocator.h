@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_COMMANDALLOCATOR_H_
 #define SRC_DAWN_NATIVE_COMMANDALLOCATOR_H_
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
@@ -58,6 +59,9 @@ namespace dawn::native {
 struct BlockDef {
     size_t size;
     uint8_t* block;
+    // True iff the block was handed out by the block pool. Such blocks must always be pushed
+    // back to the pool, never freed; see PushPooledBlock in CommandAllocator.cpp.
+    bool fromPool = false;
 };
 using CommandBlocks = std::vector<BlockDef>;
 
@@ -94,6 +98,16 @@ class CommandIterator : public NonCopyable {
         return static_cast<T*>(NextData(sizeof(T) * count, alignof(T)));
     }
 
+    // Reads the payload that was allocated together with the previous command through
+    // AllocateWithTrailingData. The payload lives directly after the command struct, so unlike
+    // NextData there is no separate data block header to consume. Must not be called when the
+    // command was allocated with a count of 0.
+    template <typename T>
+    T* NextTrailingData(size_t count) {
+        ASSERT(count > 0);
+        return static_cast<T*>(NextCommand(sizeof(T) * count, alignof(T)));
+    }
+
     // Sets iterator to the beginning of the commands without emptying the list. This method can
     // be used if iteration was stopped early and the iterator needs to be restarted.
     void Reset();
@@ -161,6 +175,12 @@ class CommandAllocator : public NonCopyable {
 
     bool IsEmpty() const;
 
+    // Encoding stats used to monitor command stream memory density: the bytes handed out for
+    // command structs and payloads (ids, alignment padding, and unused block tails are not
+    // counted) and the number of commands they were handed out for.
+    uint64_t GetAllocatedBytes() const;
+    uint64_t GetAllocatedCommandCount() const;
+
     template <typename T, typename E>
     T* Allocate(E commandId) {
         static_assert(sizeof(E) == sizeof(uint32_t));
@@ -175,6 +195,38 @@ class CommandAllocator : public NonCopyable {
         return result;
     }
 
+    // Variant of Allocate for commands that carry a small variable-size payload (for example
+    // bind group dynamic offsets). The payload is placed in the same allocation, directly after
+    // the command struct, so decoding the command and its payload walks consecutive cache lines
+    // instead of chasing a separate data allocation. The payload is read back with
+    // CommandIterator::NextTrailingData. When |count| is 0 no trailing space is reserved and
+    // NextTrailingData must not be called.
+    template <typename T, typename D, typename E>
+    T* AllocateWithTrailingData(E commandId, size_t count, D** data) {
+        static_assert(sizeof(E) == sizeof(uint32_t));
+        static_assert(alignof(E) == alignof(uint32_t));
+        static_assert(alignof(T) <= kMaxSupportedAlignment);
+        static_assert(alignof(D) <= kMaxSupportedAlignment);
+        if (count == 0) {
+            *data = nullptr;
+            return Allocate<T>(commandId);
+        }
+        size_t dataOffset = Align(sizeof(T), alignof(D));
+        uint8_t* result = Allocate(static_cast<uint32_t>(commandId), dataOffset + sizeof(D) * count,
+                                   std::max(alignof(T), alignof(D)));
+        if (!result) {
+            *data = nullptr;
+            return nullptr;
+        }
+        new (result) T;
+        D* trailingData = reinterpret_cast<D*>(result + dataOffset);
+        for (size_t i = 0; i < count; i++) {
+            new (trailingData + i) D;
+        }
+        *data = trailingData;
+        return reinterpret_cast<T*>(result);
+    }
+
     template <typename T>
     T* AllocateData(size_t count) {
         static_assert(alignof(T) <= kMaxSupportedAlignment);
@@ -237,6 +289,13 @@ class CommandAllocator : public NonCopyable {
             uint8_t* commandAlloc = AlignPtr(mCurrentPtr + sizeof(uint32_t), commandAlignment);
             mCurrentPtr = AlignPtr(commandAlloc + commandSize, alignof(uint32_t));
 
+            // Every successful allocation ends up here, including the retry from
+            // AllocateInNewBlock, so the stats count each allocation exactly once.
+            mAllocatedBytes += commandSize;
+            if (commandId != detail::kAdditionalData) {
+                mAllocatedCommandCount++;
+            }
+
             return commandAlloc;
         }
         return AllocateInNewBlock(commandId, commandSize, commandAlignment);
@@ -254,6 +313,8 @@ class CommandAllocator : public NonCopyable {
 
     CommandBlocks mBlocks;
     size_t mLastAllocationSize = kDefaultBaseAllocationSize;
+    uint64_t mAllocatedBytes = 0;
+    uint64_t mAllocatedCommandCount = 0;
 
     // Data used for the block range at initialization so that the first call to Allocate sees
     // there is not enough space and calls GetNewBlock. This avoids having to special case the
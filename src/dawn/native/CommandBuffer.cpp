@@ -14,13 +14,18 @@
 
 #include "dawn/native/CommandBuffer.h"
 
+#include <utility>
+
 #include "dawn/common/BitSetIterator.h"
 #include "dawn/native/Buffer.h"
+#include "dawn/native/ChainUtils_autogen.h"
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/CommandValidation.h"
 #include "dawn/native/Commands.h"
+#include "dawn/native/Device.h"
 #include "dawn/native/Format.h"
 #include "dawn/native/ObjectType_autogen.h"
+#include "dawn/native/PassReordering.h"
 #include "dawn/native/Texture.h"
 
 namespace dawn::native {
@@ -29,7 +34,20 @@ CommandBufferBase::CommandBufferBase(CommandEncoder* encoder,
                                      const CommandBufferDescriptor* descriptor)
     : ApiObjectBase(encoder->GetDevice(), descriptor->label),
       mCommands(encoder->AcquireCommands()),
-      mResourceUsages(encoder->AcquireResourceUsages()) {
+      mResourceUsages(encoder->AcquireResourceUsages()),
+      mTimelinePasses(encoder->AcquireTimelinePasses()) {
+    const DawnCommandBufferReuseDescriptor* reuseDesc = nullptr;
+    FindInChain(descriptor->nextInChain, &reuseDesc);
+    if (reuseDesc != nullptr) {
+        mAllowMultipleSubmits = reuseDesc->allowMultipleSubmits;
+    }
+
+    // Skipped while capturing the GPU timeline because the captured pass records are matched
+    // to the passes in encoding order.
+    if (GetDevice()->IsToggleEnabled(Toggle::ReorderPassesOnFinish) &&
+        !GetDevice()->IsToggleEnabled(Toggle::CaptureGPUTimeline)) {
+        ReorderPassesToReduceBarriers(&mCommands, &mResourceUsages);
+    }
     TrackInDevice();
 }
 
@@ -50,6 +68,14 @@ ObjectType CommandBufferBase::GetType() const {
     return ObjectType::CommandBuffer;
 }
 
+std::vector<GPUTimelineCapture::PassRecord> CommandBufferBase::AcquireTimelinePasses() {
+    return std::move(mTimelinePasses);
+}
+
+bool CommandBufferBase::AllowsMultipleSubmits() const {
+    return mAllowMultipleSubmits;
+}
+
 MaybeError CommandBufferBase::ValidateCanUseInSubmitNow() const {
     ASSERT(!IsError());
 
@@ -58,7 +84,10 @@ MaybeError CommandBufferBase::ValidateCanUseInSubmitNow() const {
 }
 
 void CommandBufferBase::DestroyImpl() {
-    FreeCommands(&mCommands);
+    // Running every command destructor is proportional to the number of recorded commands, so
+    // hand the detached command stream to the worker pool instead of walking it on the thread
+    // that released the last reference.
+    GetDevice()->DeferCommandDestruction(std::move(mCommands));
     mResourceUsages = {};
 }
 
@@ -66,6 +95,14 @@ const CommandBufferResourceUsage& CommandBufferBase::GetResourceUsages() const {
     return mResourceUsages;
 }
 
+uint64_t CommandBufferBase::GetSubmitValidationCacheGeneration() const {
+    return mSubmitValidationCacheGeneration;
+}
+
+void CommandBufferBase::SetSubmitValidationCacheGeneration(uint64_t generation) {
+    mSubmitValidationCacheGeneration = generation;
+}
+
 CommandIterator* CommandBufferBase::GetCommandIteratorForTesting() {
     return &mCommands;
 }
@@ -15,11 +15,14 @@
 #ifndef SRC_DAWN_NATIVE_COMMANDBUFFER_H_
 #define SRC_DAWN_NATIVE_COMMANDBUFFER_H_
 
+#include <vector>
+
 #include "dawn/native/dawn_platform.h"
 
 #include "dawn/native/CommandAllocator.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/Forward.h"
+#include "dawn/native/GPUTimelineCapture.h"
 #include "dawn/native/ObjectBase.h"
 #include "dawn/native/PassResourceUsage.h"
 #include "dawn/native/Texture.h"
@@ -40,10 +43,25 @@ class CommandBufferBase : public ApiObjectBase {
 
     MaybeError ValidateCanUseInSubmitNow() const;
 
+    // True when the command buffer was finished with a DawnCommandBufferReuseDescriptor that
+    // allows multiple submits. The queue then leaves it alive after submission so identical
+    // work can be resubmitted without re-encoding; the commands keep the used resources
+    // referenced for as long as the buffer lives.
+    bool AllowsMultipleSubmits() const;
+
     const CommandBufferResourceUsage& GetResourceUsages() const;
 
+    // Cache for the per-resource walk in Queue::Submit validation, keyed by the device's
+    // submit validation generation. See QueueBase::ValidateSubmit.
+    uint64_t GetSubmitValidationCacheGeneration() const;
+    void SetSubmitValidationCacheGeneration(uint64_t generation);
+
     CommandIterator* GetCommandIteratorForTesting();
 
+    // Moves out the GPU timeline pass records captured while encoding; the queue hands them to
+    // the device's GPUTimelineCapture on submit.
+    std::vector<GPUTimelineCapture::PassRecord> AcquireTimelinePasses();
+
   protected:
     // Constructor used only for mocking and testing.
     explicit CommandBufferBase(DeviceBase* device);
@@ -55,6 +73,10 @@ class CommandBufferBase : public ApiObjectBase {
     CommandBufferBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
     CommandBufferResourceUsage mResourceUsages;
+    std::vector<GPUTimelineCapture::PassRecord> mTimelinePasses;
+    bool mAllowMultipleSubmits = false;
+    // Device generation at which the resource usage walk last passed; 0 when it never has.
+    uint64_t mSubmitValidationCacheGeneration = 0;
 };
 
 bool IsCompleteSubresourceCopiedTo(const TextureBase* texture,
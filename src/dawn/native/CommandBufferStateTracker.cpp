@@ -14,6 +14,9 @@
 
 #include "dawn/native/CommandBufferStateTracker.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "dawn/common/Assert.h"
 #include "dawn/common/BitSetIterator.h"
 #include "dawn/native/BindGroup.h"
@@ -105,6 +108,15 @@ MaybeError CommandBufferStateTracker::ValidateBufferInRangeForVertexBuffer(uint3
         return {};
     }
 
+    if (DAWN_UNLIKELY(mMaxStrideCountsDirty)) {
+        RecomputeMaxStrideCounts();
+    }
+    if (DAWN_LIKELY(strideCount <= mMaxVertexStrideCount)) {
+        return {};
+    }
+
+    // The draw is out of range for at least one buffer. Re-run the per-slot checks to build an
+    // error message naming the offending slot.
     RenderPipelineBase* lastRenderPipeline = GetRenderPipeline();
 
     const ityp::bitset<VertexBufferSlot, kMaxVertexBuffers>& vertexBufferSlotsUsedAsVertexBuffer =
@@ -140,7 +152,11 @@ MaybeError CommandBufferStateTracker::ValidateBufferInRangeForVertexBuffer(uint3
         }
     }
 
-    return {};
+    // The checks above must find the same out-of-range buffer that made the precomputed
+    // mMaxVertexStrideCount reject the draw. If this is reached, make sure
+    // RecomputeMaxStrideCounts and the checks above are consistent.
+    UNREACHABLE();
+    return DAWN_FORMAT_VALIDATION_ERROR("Vertex buffer is out of range.");
 }
 
 MaybeError CommandBufferStateTracker::ValidateBufferInRangeForInstanceBuffer(
@@ -153,6 +169,15 @@ MaybeError CommandBufferStateTracker::ValidateBufferInRangeForInstanceBuffer(
         return {};
     }
 
+    if (DAWN_UNLIKELY(mMaxStrideCountsDirty)) {
+        RecomputeMaxStrideCounts();
+    }
+    if (DAWN_LIKELY(strideCount <= mMaxInstanceStrideCount)) {
+        return {};
+    }
+
+    // The draw is out of range for at least one buffer. Re-run the per-slot checks to build an
+    // error message naming the offending slot.
     RenderPipelineBase* lastRenderPipeline = GetRenderPipeline();
 
     const ityp::bitset<VertexBufferSlot, kMaxVertexBuffers>& vertexBufferSlotsUsedAsInstanceBuffer =
@@ -188,7 +213,11 @@ MaybeError CommandBufferStateTracker::ValidateBufferInRangeForInstanceBuffer(
         }
     }
 
-    return {};
+    // The checks above must find the same out-of-range buffer that made the precomputed
+    // mMaxInstanceStrideCount reject the draw. If this is reached, make sure
+    // RecomputeMaxStrideCounts and the checks above are consistent.
+    UNREACHABLE();
+    return DAWN_FORMAT_VALIDATION_ERROR("Instance buffer is out of range.");
 }
 
 MaybeError CommandBufferStateTracker::ValidateIndexBufferInRange(uint32_t indexCount,
@@ -323,7 +352,7 @@ MaybeError CommandBufferStateTracker::CheckMissingAspects(ValidationAspects aspe
                 "the pipeline. Either use the bind group layout returned by calling "
                 "getBindGroupLayout(%u) on the pipeline when creating the bind group, or "
                 "provide an explicit pipeline layout when creating the pipeline.",
-                mLastPipeline, mBindgroups[i], static_cast<uint32_t>(i), currentBGL,
+                mLastPipeline.Get(), mBindgroups[i].Get(), static_cast<uint32_t>(i), currentBGL,
                 static_cast<uint32_t>(i));
 
             DAWN_INVALID_IF(
@@ -334,20 +363,20 @@ MaybeError CommandBufferStateTracker::CheckMissingAspects(ValidationAspects aspe
                 "compatible. Use an explicit bind group layout when creating bind groups and "
                 "an explicit pipeline layout when creating pipelines to share bind groups "
                 "between pipelines.",
-                mBindgroups[i], static_cast<uint32_t>(i), currentBGL, mLastPipeline);
+                mBindgroups[i].Get(), static_cast<uint32_t>(i), currentBGL, mLastPipeline.Get());
 
             DAWN_INVALID_IF(
                 mLastPipelineLayout->GetBindGroupLayout(i) != mBindgroups[i]->GetLayout(),
                 "Bind group layout %s of pipeline layout %s does not match layout %s of bind "
                 "group %s at index %u.",
-                requiredBGL, mLastPipelineLayout, currentBGL, mBindgroups[i],
+                requiredBGL, mLastPipelineLayout.Get(), currentBGL, mBindgroups[i].Get(),
                 static_cast<uint32_t>(i));
 
             // TODO(dawn:563): Report the binding sizes and which ones are failing.
             DAWN_INVALID_IF(!BufferSizesAtLeastAsBig(mBindgroups[i]->GetUnverifiedBufferSizes(),
                                                      (*mMinBufferSizes)[i]),
                             "Binding sizes are too small for bind group %s at index %u",
-                            mBindgroups[i], static_cast<uint32_t>(i));
+                            mBindgroups[i].Get(), static_cast<uint32_t>(i));
         }
 
         // The chunk of code above should be similar to the one in |RecomputeLazyAspects|.
@@ -361,6 +390,43 @@ MaybeError CommandBufferStateTracker::CheckMissingAspects(ValidationAspects aspe
     UNREACHABLE();
 }
 
+void CommandBufferStateTracker::RecomputeMaxStrideCounts() {
+    RenderPipelineBase* lastRenderPipeline = GetRenderPipeline();
+
+    mMaxVertexStrideCount = std::numeric_limits<uint64_t>::max();
+    mMaxInstanceStrideCount = std::numeric_limits<uint64_t>::max();
+
+    for (auto slot : IterateBitSet(lastRenderPipeline->GetVertexBufferSlotsUsed())) {
+        const VertexBufferInfo& vertexBuffer = lastRenderPipeline->GetVertexBuffer(slot);
+        uint64_t arrayStride = vertexBuffer.arrayStride;
+        uint64_t bufferSize = mVertexBufferSizes[slot];
+
+        uint64_t maxStrideCount;
+        if (arrayStride == 0) {
+            // A buffer with an arrayStride of 0 holds a single element that every stride reads,
+            // so it allows any stride count iff it is big enough for all the attributes.
+            maxStrideCount = vertexBuffer.usedBytesInStride <= bufferSize
+                                 ? std::numeric_limits<uint64_t>::max()
+                                 : 0;
+        } else if (bufferSize >= vertexBuffer.lastStride) {
+            // Inverse of requiredSize = (strideCount - 1) * arrayStride + lastStride, the
+            // per-draw check in ValidateBufferInRangeFor*Buffer.
+            maxStrideCount = (bufferSize - vertexBuffer.lastStride) / arrayStride + 1u;
+        } else {
+            maxStrideCount = 0;
+        }
+
+        if (vertexBuffer.stepMode == wgpu::VertexStepMode::Vertex) {
+            mMaxVertexStrideCount = std::min(mMaxVertexStrideCount, maxStrideCount);
+        } else {
+            ASSERT(vertexBuffer.stepMode == wgpu::VertexStepMode::Instance);
+            mMaxInstanceStrideCount = std::min(mMaxInstanceStrideCount, maxStrideCount);
+        }
+    }
+
+    mMaxStrideCountsDirty = false;
+}
+
 void CommandBufferStateTracker::SetComputePipeline(ComputePipelineBase* pipeline) {
     SetPipelineCommon(pipeline);
 }
@@ -373,6 +439,16 @@ void CommandBufferStateTracker::SetBindGroup(BindGroupIndex index,
                                              BindGroupBase* bindgroup,
                                              uint32_t dynamicOffsetCount,
                                              const uint32_t* dynamicOffsets) {
+    // Draw-heavy content tends to rebind the same bind group between state-identical draws.
+    // If nothing changed, keep the bind group aspect validated so the next draw takes the
+    // single-bitmask-test fast path in ValidateOperation instead of recomputing lazy aspects.
+    if (bindgroup == mBindgroups[index] &&
+        mDynamicOffsets[index].size() == dynamicOffsetCount &&
+        std::equal(dynamicOffsets, dynamicOffsets + dynamicOffsetCount,
+                   mDynamicOffsets[index].begin())) {
+        return;
+    }
+
     mBindgroups[index] = bindgroup;
     mDynamicOffsets[index].assign(dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
     mAspects.reset(VALIDATION_ASPECT_BIND_GROUPS);
@@ -387,14 +463,22 @@ void CommandBufferStateTracker::SetIndexBuffer(wgpu::IndexFormat format, uint64_
 void CommandBufferStateTracker::SetVertexBuffer(VertexBufferSlot slot, uint64_t size) {
     mVertexBufferSlotsUsed.set(slot);
     mVertexBufferSizes[slot] = size;
+    mMaxStrideCountsDirty = true;
 }
 
 void CommandBufferStateTracker::SetPipelineCommon(PipelineBase* pipeline) {
+    // Setting the same pipeline doesn't change the layout, the min buffer sizes, or anything
+    // the lazy aspects depend on, so previously validated aspects stay valid.
+    if (pipeline == mLastPipeline && pipeline != nullptr) {
+        return;
+    }
+
     mLastPipeline = pipeline;
     mLastPipelineLayout = pipeline != nullptr ? pipeline->GetLayout() : nullptr;
     mMinBufferSizes = pipeline != nullptr ? &pipeline->GetMinBufferSizes() : nullptr;
 
     mAspects.set(VALIDATION_ASPECT_PIPELINE);
+    mMaxStrideCountsDirty = true;
 
     // Reset lazy aspects so they get recomputed on the next operation.
     mAspects &= ~kLazyAspects;
@@ -415,12 +499,12 @@ bool CommandBufferStateTracker::HasPipeline() const {
 
 RenderPipelineBase* CommandBufferStateTracker::GetRenderPipeline() const {
     ASSERT(HasPipeline() && mLastPipeline->GetType() == ObjectType::RenderPipeline);
-    return static_cast<RenderPipelineBase*>(mLastPipeline);
+    return static_cast<RenderPipelineBase*>(mLastPipeline.Get());
 }
 
 ComputePipelineBase* CommandBufferStateTracker::GetComputePipeline() const {
     ASSERT(HasPipeline() && mLastPipeline->GetType() == ObjectType::ComputePipeline);
-    return static_cast<ComputePipelineBase*>(mLastPipeline);
+    return static_cast<ComputePipelineBase*>(mLastPipeline.Get());
 }
 
 PipelineLayoutBase* CommandBufferStateTracker::GetPipelineLayout() const {
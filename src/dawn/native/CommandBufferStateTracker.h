@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "dawn/common/Constants.h"
+#include "dawn/common/RefCounted.h"
 #include "dawn/common/ityp_array.h"
 #include "dawn/common/ityp_bitset.h"
 #include "dawn/native/BindingInfo.h"
@@ -72,11 +73,13 @@ class CommandBufferStateTracker {
     void RecomputeLazyAspects(ValidationAspects aspects);
     MaybeError CheckMissingAspects(ValidationAspects aspects);
 
+    void RecomputeMaxStrideCounts();
+
     void SetPipelineCommon(PipelineBase* pipeline);
 
     ValidationAspects mAspects;
 
-    ityp::array<BindGroupIndex, BindGroupBase*, kMaxBindGroups> mBindgroups = {};
+    ityp::array<BindGroupIndex, BorrowedRef<BindGroupBase>, kMaxBindGroups> mBindgroups = {};
     ityp::array<BindGroupIndex, std::vector<uint32_t>, kMaxBindGroups> mDynamicOffsets = {};
     ityp::bitset<VertexBufferSlot, kMaxVertexBuffers> mVertexBufferSlotsUsed;
     bool mIndexBufferSet = false;
@@ -85,8 +88,17 @@ class CommandBufferStateTracker {
 
     ityp::array<VertexBufferSlot, uint64_t, kMaxVertexBuffers> mVertexBufferSizes = {};
 
-    PipelineLayoutBase* mLastPipelineLayout = nullptr;
-    PipelineBase* mLastPipeline = nullptr;
+    // Maximum vertex/instance stride counts (first + count) that fit in all the vertex buffers
+    // the current pipeline uses with the corresponding step mode. Derived from the pipeline's
+    // vertex state and the bound buffer sizes so the per-draw range check is a single compare.
+    bool mMaxStrideCountsDirty = true;
+    uint64_t mMaxVertexStrideCount = 0;
+    uint64_t mMaxInstanceStrideCount = 0;
+
+    // These are borrowed: the encoder validates that the objects are alive for the whole
+    // encoding, so the tracker doesn't need to add references of its own.
+    BorrowedRef<PipelineLayoutBase> mLastPipelineLayout;
+    BorrowedRef<PipelineBase> mLastPipeline;
 
     const RequiredBufferSizes* mMinBufferSizes = nullptr;
 };
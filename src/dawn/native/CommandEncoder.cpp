@@ -31,6 +31,7 @@
 #include "dawn/native/ComputePassEncoder.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/ErrorData.h"
+#include "dawn/native/GPUTimelineCapture.h"
 #include "dawn/native/ObjectType_autogen.h"
 #include "dawn/native/QueryHelper.h"
 #include "dawn/native/QuerySet.h"
@@ -169,6 +170,11 @@ MaybeError ValidateResolveTarget(const DeviceBase* device,
     DAWN_TRY(ValidateCanUseAs(colorAttachment.resolveTarget->GetTexture(),
                               wgpu::TextureUsage::RenderAttachment, usageValidationMode));
 
+    DAWN_INVALID_IF(resolveTarget->GetTexture()->GetInternalUsage() & kTransientAttachment,
+                    "The resolve target %s has a transient attachment usage, so its contents "
+                    "cannot outlive the render pass.",
+                    resolveTarget);
+
     DAWN_INVALID_IF(!attachment->GetTexture()->IsMultisampledTexture(),
                     "Cannot set %s as a resolve target when the color attachment %s has a sample "
                     "count of 1.",
@@ -237,6 +243,14 @@ MaybeError ValidateRenderPassColorAttachment(DeviceBase* device,
     DAWN_INVALID_IF(colorAttachment.loadOp == wgpu::LoadOp::Undefined, "loadOp must be set.");
     DAWN_INVALID_IF(colorAttachment.storeOp == wgpu::StoreOp::Undefined, "storeOp must be set.");
 
+    // Transient attachments are backed by memory that cannot be loaded from or stored to RAM.
+    DAWN_INVALID_IF((attachment->GetTexture()->GetInternalUsage() & kTransientAttachment) &&
+                        (colorAttachment.loadOp != wgpu::LoadOp::Clear ||
+                         colorAttachment.storeOp != wgpu::StoreOp::Discard),
+                    "The color attachment %s has a transient attachment usage, so it must be used "
+                    "with loadOp %s and storeOp %s.",
+                    attachment, wgpu::LoadOp::Clear, wgpu::StoreOp::Discard);
+
     // TODO(dawn:1269): Remove after the deprecation period.
     bool useClearColor = HasDeprecatedColor(colorAttachment);
     const dawn::native::Color& clearValue =
@@ -375,6 +389,27 @@ MaybeError ValidateRenderPassDepthStencilAttachment(
                         depthStencilAttachment->stencilReadOnly);
     }
 
+    // Transient attachments are backed by memory that cannot be loaded from or stored to RAM.
+    if (attachment->GetTexture()->GetInternalUsage() & kTransientAttachment) {
+        DAWN_INVALID_IF(
+            depthStencilAttachment->depthReadOnly || depthStencilAttachment->stencilReadOnly,
+            "The depth stencil attachment %s has a transient attachment usage, so it cannot be "
+            "read-only.",
+            attachment);
+        DAWN_INVALID_IF(IsSubset(Aspect::Depth, attachment->GetAspects()) &&
+                            (depthStencilAttachment->depthLoadOp != wgpu::LoadOp::Clear ||
+                             depthStencilAttachment->depthStoreOp != wgpu::StoreOp::Discard),
+                        "The depth stencil attachment %s has a transient attachment usage, so its "
+                        "depth aspect must be used with depthLoadOp %s and depthStoreOp %s.",
+                        attachment, wgpu::LoadOp::Clear, wgpu::StoreOp::Discard);
+        DAWN_INVALID_IF(IsSubset(Aspect::Stencil, attachment->GetAspects()) &&
+                            (depthStencilAttachment->stencilLoadOp != wgpu::LoadOp::Clear ||
+                             depthStencilAttachment->stencilStoreOp != wgpu::StoreOp::Discard),
+                        "The depth stencil attachment %s has a transient attachment usage, so its "
+                        "stencil aspect must be used with stencilLoadOp %s and stencilStoreOp %s.",
+                        attachment, wgpu::LoadOp::Clear, wgpu::StoreOp::Discard);
+    }
+
     if (!std::isnan(depthStencilAttachment->clearDepth)) {
         // TODO(dawn:1269): Remove this branch after the deprecation period.
         device->EmitDeprecationWarning("clearDepth is deprecated, prefer depthClearValue instead.");
@@ -595,46 +630,6 @@ MaybeError ValidateQuerySetResolve(const QuerySetBase* querySet,
     return {};
 }
 
-MaybeError EncodeTimestampsToNanosecondsConversion(CommandEncoder* encoder,
-                                                   QuerySetBase* querySet,
-                                                   uint32_t firstQuery,
-                                                   uint32_t queryCount,
-                                                   BufferBase* destination,
-                                                   uint64_t destinationOffset) {
-    DeviceBase* device = encoder->GetDevice();
-
-    // The availability got from query set is a reference to vector<bool>, need to covert
-    // bool to uint32_t due to a user input in pipeline must not contain a bool type in
-    // WGSL.
-    std::vector<uint32_t> availability{querySet->GetQueryAvailability().begin(),
-                                       querySet->GetQueryAvailability().end()};
-
-    // Timestamp availability storage buffer
-    BufferDescriptor availabilityDesc = {};
-    availabilityDesc.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopyDst;
-    availabilityDesc.size = querySet->GetQueryCount() * sizeof(uint32_t);
-    Ref<BufferBase> availabilityBuffer;
-    DAWN_TRY_ASSIGN(availabilityBuffer, device->CreateBuffer(&availabilityDesc));
-
-    DAWN_TRY(device->GetQueue()->WriteBuffer(availabilityBuffer.Get(), 0, availability.data(),
-                                             availability.size() * sizeof(uint32_t)));
-
-    // Timestamp params uniform buffer
-    TimestampParams params(firstQuery, queryCount, static_cast<uint32_t>(destinationOffset),
-                           device->GetTimestampPeriodInNS());
-
-    BufferDescriptor parmsDesc = {};
-    parmsDesc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
-    parmsDesc.size = sizeof(params);
-    Ref<BufferBase> paramsBuffer;
-    DAWN_TRY_ASSIGN(paramsBuffer, device->CreateBuffer(&parmsDesc));
-
-    DAWN_TRY(device->GetQueue()->WriteBuffer(paramsBuffer.Get(), 0, &params, sizeof(params)));
-
-    return EncodeConvertTimestampsToNanoseconds(encoder, destination, availabilityBuffer.Get(),
-                                                paramsBuffer.Get());
-}
-
 bool IsReadOnlyDepthStencilAttachment(
     const RenderPassDepthStencilAttachment* depthStencilAttachment) {
     DAWN_ASSERT(depthStencilAttachment != nullptr);
@@ -717,7 +712,9 @@ CommandEncoder* CommandEncoder::MakeError(DeviceBase* device) {
 }
 
 CommandEncoder::CommandEncoder(DeviceBase* device, const CommandEncoderDescriptor* descriptor)
-    : ApiObjectBase(device, descriptor->label), mEncodingContext(device, this) {
+    : ApiObjectBase(device, descriptor->label),
+      mEncodingContext(device, this),
+      mValidationEnabled(device->IsValidationEnabled()) {
     TrackInDevice();
 
     const DawnEncoderInternalUsageDescriptor* internalUsageDesc = nullptr;
@@ -733,7 +730,8 @@ CommandEncoder::CommandEncoder(DeviceBase* device, const CommandEncoderDescripto
 CommandEncoder::CommandEncoder(DeviceBase* device, ObjectBase::ErrorTag tag)
     : ApiObjectBase(device, tag),
       mEncodingContext(device, this),
-      mUsageValidationMode(UsageValidationMode::Default) {
+      mUsageValidationMode(UsageValidationMode::Default),
+      mValidationEnabled(device->IsValidationEnabled()) {
     mEncodingContext.HandleError(DAWN_FORMAT_VALIDATION_ERROR("%s is invalid.", this));
 }
 
@@ -741,6 +739,10 @@ ObjectType CommandEncoder::GetType() const {
     return ObjectType::CommandEncoder;
 }
 
+bool CommandEncoder::IsValidationEnabled() const {
+    return mValidationEnabled;
+}
+
 void CommandEncoder::DestroyImpl() {
     mEncodingContext.Destroy();
 }
@@ -762,7 +764,7 @@ void CommandEncoder::TrackUsedQuerySet(QuerySetBase* querySet) {
 void CommandEncoder::TrackQueryAvailability(QuerySetBase* querySet, uint32_t queryIndex) {
     DAWN_ASSERT(querySet != nullptr);
 
-    if (GetDevice()->IsValidationEnabled()) {
+    if (IsValidationEnabled()) {
         TrackUsedQuerySet(querySet);
     }
 
@@ -770,6 +772,42 @@ void CommandEncoder::TrackQueryAvailability(QuerySetBase* querySet, uint32_t que
     querySet->SetQueryAvailability(queryIndex, true);
 }
 
+void CommandEncoder::EncodeTimelinePassBegin(const char* passName) {
+    GPUTimelineCapture* capture = GetDevice()->GetGPUTimelineCapture();
+    if (capture == nullptr) {
+        return;
+    }
+
+    uint32_t slot;
+    if (!capture->AllocateQuerySlot(&slot)) {
+        // The query set is exhausted; this pass just goes uncaptured.
+        mTimelinePassBeginSlot = GPUTimelineCapture::kInvalidQuerySlot;
+        return;
+    }
+
+    APIWriteTimestamp(capture->GetQuerySet(), slot);
+    mTimelinePassBeginSlot = slot;
+    mTimelinePassName = passName;
+}
+
+void CommandEncoder::EncodeTimelinePassEnd() {
+    GPUTimelineCapture* capture = GetDevice()->GetGPUTimelineCapture();
+    if (capture == nullptr || mTimelinePassBeginSlot == GPUTimelineCapture::kInvalidQuerySlot) {
+        return;
+    }
+
+    uint32_t endSlot;
+    if (capture->AllocateQuerySlot(&endSlot)) {
+        APIWriteTimestamp(capture->GetQuerySet(), endSlot);
+        mTimelinePasses.push_back({mTimelinePassBeginSlot, endSlot, mTimelinePassName});
+    }
+    mTimelinePassBeginSlot = GPUTimelineCapture::kInvalidQuerySlot;
+}
+
+std::vector<GPUTimelineCapture::PassRecord> CommandEncoder::AcquireTimelinePasses() {
+    return std::move(mTimelinePasses);
+}
+
 // Implementation of the API's command recording methods
 
 ComputePassEncoder* CommandEncoder::APIBeginComputePass(const ComputePassDescriptor* descriptor) {
@@ -779,6 +817,9 @@ ComputePassEncoder* CommandEncoder::APIBeginComputePass(const ComputePassDescrip
 Ref<ComputePassEncoder> CommandEncoder::BeginComputePass(const ComputePassDescriptor* descriptor) {
     DeviceBase* device = GetDevice();
 
+    // The timestamp must precede the BeginComputePassCmd in the command stream.
+    EncodeTimelinePassBegin("ComputePass");
+
     bool success = mEncodingContext.TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
@@ -838,6 +879,9 @@ RenderPassEncoder* CommandEncoder::APIBeginRenderPass(const RenderPassDescriptor
 Ref<RenderPassEncoder> CommandEncoder::BeginRenderPass(const RenderPassDescriptor* descriptor) {
     DeviceBase* device = GetDevice();
 
+    // The timestamp must precede the BeginRenderPassCmd in the command stream.
+    EncodeTimelinePassBegin("RenderPass");
+
     RenderPassResourceUsageTracker usageTracker;
 
     uint32_t width = 0;
@@ -1021,7 +1065,7 @@ void CommandEncoder::APICopyBufferToBuffer(BufferBase* source,
     mEncodingContext.TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
-            if (GetDevice()->IsValidationEnabled()) {
+            if (IsValidationEnabled()) {
                 DAWN_TRY(GetDevice()->ValidateObject(source));
                 DAWN_TRY(GetDevice()->ValidateObject(destination));
 
@@ -1063,7 +1107,7 @@ void CommandEncoder::APICopyBufferToTexture(const ImageCopyBuffer* source,
     mEncodingContext.TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
-            if (GetDevice()->IsValidationEnabled()) {
+            if (IsValidationEnabled()) {
                 DAWN_TRY(ValidateImageCopyBuffer(GetDevice(), *source));
                 DAWN_TRY_CONTEXT(ValidateCanUseAs(source->buffer, wgpu::BufferUsage::CopySrc),
                                  "validating source %s usage.", source->buffer);
@@ -1083,7 +1127,7 @@ void CommandEncoder::APICopyBufferToTexture(const ImageCopyBuffer* source,
             }
             const TexelBlockInfo& blockInfo =
                 destination->texture->GetFormat().GetAspectInfo(destination->aspect).block;
-            if (GetDevice()->IsValidationEnabled()) {
+            if (IsValidationEnabled()) {
                 DAWN_TRY(ValidateLinearTextureCopyOffset(
                     source->layout, blockInfo,
                     destination->texture->GetFormat().HasDepthOrStencil()));
@@ -1122,7 +1166,7 @@ void CommandEncoder::APICopyTextureToBuffer(const ImageCopyTexture* source,
     mEncodingContext.TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
-            if (GetDevice()->IsValidationEnabled()) {
+            if (IsValidationEnabled()) {
                 DAWN_TRY(ValidateImageCopyTexture(GetDevice(), *source, *copySize));
                 DAWN_TRY_CONTEXT(ValidateCanUseAs(source->texture, wgpu::TextureUsage::CopySrc,
                                                   mUsageValidationMode),
@@ -1142,7 +1186,7 @@ void CommandEncoder::APICopyTextureToBuffer(const ImageCopyTexture* source,
             }
             const TexelBlockInfo& blockInfo =
                 source->texture->GetFormat().GetAspectInfo(source->aspect).block;
-            if (GetDevice()->IsValidationEnabled()) {
+            if (IsValidationEnabled()) {
                 DAWN_TRY(ValidateLinearTextureCopyOffset(
                     destination->layout, blockInfo,
                     source->texture->GetFormat().HasDepthOrStencil()));
@@ -1193,7 +1237,7 @@ void CommandEncoder::APICopyTextureToTextureHelper(const ImageCopyTexture* sourc
     mEncodingContext.TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
-            if (GetDevice()->IsValidationEnabled()) {
+            if (IsValidationEnabled()) {
                 DAWN_TRY(GetDevice()->ValidateObject(source->texture));
                 DAWN_TRY(GetDevice()->ValidateObject(destination->texture));
 
@@ -1251,7 +1295,7 @@ void CommandEncoder::APIClearBuffer(BufferBase* buffer, uint64_t offset, uint64_
     mEncodingContext.TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
-            if (GetDevice()->IsValidationEnabled()) {
+            if (IsValidationEnabled()) {
                 DAWN_TRY(GetDevice()->ValidateObject(buffer));
 
                 uint64_t bufferSize = buffer->GetSize();
@@ -1305,6 +1349,12 @@ void CommandEncoder::APIInjectValidationError(const char* message) {
 }
 
 void CommandEncoder::APIInsertDebugMarker(const char* groupLabel) {
+#if defined(DAWN_STRIP_DEBUG_LABELS)
+    // Stripped builds drop the marker but still validate the encoder state.
+    mEncodingContext.TryEncode(
+        this, [](CommandAllocator*) -> MaybeError { return {}; },
+        "encoding %s.InsertDebugMarker(\"%s\").", this, groupLabel);
+#else
     mEncodingContext.TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
@@ -1318,19 +1368,24 @@ void CommandEncoder::APIInsertDebugMarker(const char* groupLabel) {
             return {};
         },
         "encoding %s.InsertDebugMarker(\"%s\").", this, groupLabel);
+#endif
 }
 
 void CommandEncoder::APIPopDebugGroup() {
     mEncodingContext.TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
-            if (GetDevice()->IsValidationEnabled()) {
+            if (IsValidationEnabled()) {
                 DAWN_INVALID_IF(mDebugGroupStackSize == 0,
                                 "PopDebugGroup called when no debug groups are currently pushed.");
             }
+#if defined(DAWN_STRIP_DEBUG_LABELS)
+            DAWN_UNUSED(allocator);
+#else
             allocator->Allocate<PopDebugGroupCmd>(Command::PopDebugGroup);
-            mDebugGroupStackSize--;
             mEncodingContext.PopDebugGroupLabel();
+#endif
+            mDebugGroupStackSize--;
 
             return {};
         },
@@ -1341,6 +1396,9 @@ void CommandEncoder::APIPushDebugGroup(const char* groupLabel) {
     mEncodingContext.TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
+#if defined(DAWN_STRIP_DEBUG_LABELS)
+            DAWN_UNUSED(allocator);
+#else
             PushDebugGroupCmd* cmd =
                 allocator->Allocate<PushDebugGroupCmd>(Command::PushDebugGroup);
             cmd->length = strlen(groupLabel);
@@ -1348,8 +1406,9 @@ void CommandEncoder::APIPushDebugGroup(const char* groupLabel) {
             char* label = allocator->AllocateData<char>(cmd->length + 1);
             memcpy(label, groupLabel, cmd->length + 1);
 
-            mDebugGroupStackSize++;
             mEncodingContext.PushDebugGroupLabel(groupLabel);
+#endif
+            mDebugGroupStackSize++;
 
             return {};
         },
@@ -1364,7 +1423,7 @@ void CommandEncoder::APIResolveQuerySet(QuerySetBase* querySet,
     mEncodingContext.TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
-            if (GetDevice()->IsValidationEnabled()) {
+            if (IsValidationEnabled()) {
                 DAWN_TRY(GetDevice()->ValidateObject(querySet));
                 DAWN_TRY(GetDevice()->ValidateObject(destination));
 
@@ -1385,11 +1444,25 @@ void CommandEncoder::APIResolveQuerySet(QuerySetBase* querySet,
             cmd->destination = destination;
             cmd->destinationOffset = destinationOffset;
 
-            // Encode internal compute pipeline for timestamp query
+            // Encode the internal tick-to-nanosecond conversion for timestamp queries. With
+            // the defer_timestamp_conversions toggle the conversion is recorded at Finish
+            // instead, so that all the resolved ranges share one conversion dispatch per
+            // destination buffer; by default it is encoded right away so that commands
+            // recorded after the resolve in this same command buffer observe converted
+            // values, as the WebGPU resolve-then-copy pattern expects.
             if (querySet->GetQueryType() == wgpu::QueryType::Timestamp &&
                 !GetDevice()->IsToggleEnabled(Toggle::DisableTimestampQueryConversion)) {
-                DAWN_TRY(EncodeTimestampsToNanosecondsConversion(
-                    this, querySet, firstQuery, queryCount, destination, destinationOffset));
+                if (GetDevice()->IsToggleEnabled(Toggle::DeferTimestampConversions)) {
+                    mDeferredTimestampConversions.push_back(
+                        {querySet, firstQuery, queryCount, destination, destinationOffset});
+                } else {
+                    TimestampResolveRange range;
+                    range.first = firstQuery;
+                    range.count = queryCount;
+                    range.offset = static_cast<uint32_t>(destinationOffset);
+                    DAWN_TRY(EncodeTimestampConversionPass(querySet, destination, {range},
+                                                           queryCount));
+                }
             }
 
             return {};
@@ -1398,6 +1471,51 @@ void CommandEncoder::APIResolveQuerySet(QuerySetBase* querySet,
         destination, destinationOffset);
 }
 
+void CommandEncoder::APIStitchCommands(CommandEncoder* source) {
+    mEncodingContext.TryEncode(
+        this,
+        [&](CommandAllocator*) -> MaybeError {
+            if (IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(source));
+                DAWN_INVALID_IF(source == this, "%s cannot be stitched into itself.", this);
+                DAWN_INVALID_IF(
+                    source->mUsageValidationMode != mUsageValidationMode,
+                    "%s and %s were not created with the same useInternalUsages setting.", this,
+                    source);
+            }
+
+            // Consuming the source's encoding context is equivalent to calling Finish on it:
+            // even on failure the source becomes unusable for further recording, and any error
+            // deferred during its (possibly multi-threaded) recording surfaces here.
+            DAWN_TRY(source->mEncodingContext.Finish());
+            if (IsValidationEnabled()) {
+                DAWN_TRY(source->ValidateFinish());
+            }
+            mEncodingContext.AcquireCommandsFrom(&source->mEncodingContext);
+
+            // Top-level state that Finish would have folded into the source's command buffer
+            // now belongs to this encoder, including timestamp resolves whose conversion is
+            // deferred to Finish.
+            mTopLevelBuffers.insert(source->mTopLevelBuffers.begin(),
+                                    source->mTopLevelBuffers.end());
+            mTopLevelTextures.insert(source->mTopLevelTextures.begin(),
+                                     source->mTopLevelTextures.end());
+            mUsedQuerySets.insert(source->mUsedQuerySets.begin(), source->mUsedQuerySets.end());
+            for (DeferredTimestampConversion& conversion :
+                 source->mDeferredTimestampConversions) {
+                mDeferredTimestampConversions.push_back(std::move(conversion));
+            }
+            source->mDeferredTimestampConversions.clear();
+            for (GPUTimelineCapture::PassRecord& record : source->mTimelinePasses) {
+                mTimelinePasses.push_back(std::move(record));
+            }
+            source->mTimelinePasses.clear();
+
+            return {};
+        },
+        "encoding %s.StitchCommands(%s).", this, source);
+}
+
 void CommandEncoder::APIWriteBuffer(BufferBase* buffer,
                                     uint64_t bufferOffset,
                                     const uint8_t* data,
@@ -1405,7 +1523,7 @@ void CommandEncoder::APIWriteBuffer(BufferBase* buffer,
     mEncodingContext.TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
-            if (GetDevice()->IsValidationEnabled()) {
+            if (IsValidationEnabled()) {
                 DAWN_TRY(ValidateWriteBuffer(GetDevice(), buffer, bufferOffset, size));
             }
 
@@ -1428,7 +1546,7 @@ void CommandEncoder::APIWriteTimestamp(QuerySetBase* querySet, uint32_t queryInd
     mEncodingContext.TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
-            if (GetDevice()->IsValidationEnabled()) {
+            if (IsValidationEnabled()) {
                 DAWN_TRY(ValidateTimestampQuery(GetDevice(), querySet, queryIndex));
             }
 
@@ -1457,24 +1575,126 @@ ResultOrError<Ref<CommandBufferBase>> CommandEncoder::Finish(
     const CommandBufferDescriptor* descriptor) {
     DeviceBase* device = GetDevice();
 
+    // Encode the batched timestamp conversions while the encoding context is still open. Only
+    // populated with the defer_timestamp_conversions toggle; the converted values then only
+    // become visible to commands of later submits, not to copies recorded after the resolve
+    // in this same command buffer.
+    if (!mDeferredTimestampConversions.empty()) {
+        MaybeError conversionResult = EncodeTimestampConversions();
+        mDeferredTimestampConversions.clear();
+        if (conversionResult.IsError()) {
+            mEncodingContext.HandleError(conversionResult.AcquireError());
+        }
+    }
+
     // Even if mEncodingContext.Finish() validation fails, calling it will mutate the internal
     // state of the encoding context. The internal state is set to finished, and subsequent
     // calls to encode commands will generate errors.
     DAWN_TRY(mEncodingContext.Finish());
     DAWN_TRY(device->ValidateIsAlive());
 
-    if (device->IsValidationEnabled()) {
-        DAWN_TRY(ValidateFinish());
-    }
-
     const CommandBufferDescriptor defaultDescriptor = {};
     if (descriptor == nullptr) {
         descriptor = &defaultDescriptor;
     }
 
+    if (IsValidationEnabled()) {
+        DAWN_TRY(ValidateSingleSType(descriptor->nextInChain,
+                                     wgpu::SType::DawnCommandBufferReuseDescriptor));
+        DAWN_TRY(ValidateFinish());
+    }
+
     return device->CreateCommandBuffer(this, descriptor);
 }
 
+MaybeError CommandEncoder::EncodeTimestampConversions() {
+    DeviceBase* device = GetDevice();
+
+    // Group the pending ranges by (query set, destination): the availability bitset is per
+    // query set and the conversion dispatch writes through a single storage binding.
+    struct ConversionGroup {
+        QuerySetBase* querySet;
+        BufferBase* destination;
+        std::vector<TimestampResolveRange> ranges;
+        uint32_t totalQueryCount = 0;
+    };
+    std::vector<ConversionGroup> groups;
+    for (const DeferredTimestampConversion& conversion : mDeferredTimestampConversions) {
+        ConversionGroup* group = nullptr;
+        for (ConversionGroup& candidate : groups) {
+            if (candidate.querySet == conversion.querySet.Get() &&
+                candidate.destination == conversion.destination.Get()) {
+                group = &candidate;
+                break;
+            }
+        }
+        if (group == nullptr) {
+            groups.push_back({conversion.querySet.Get(), conversion.destination.Get(), {}, 0});
+            group = &groups.back();
+        }
+
+        TimestampResolveRange range;
+        range.first = conversion.firstQuery;
+        range.count = conversion.queryCount;
+        range.offset = static_cast<uint32_t>(conversion.destinationOffset);
+        group->ranges.push_back(range);
+        group->totalQueryCount += conversion.queryCount;
+    }
+
+    for (const ConversionGroup& group : groups) {
+        DAWN_TRY(EncodeTimestampConversionPass(group.querySet, group.destination, group.ranges,
+                                               group.totalQueryCount));
+    }
+
+    return {};
+}
+
+MaybeError CommandEncoder::EncodeTimestampConversionPass(
+    QuerySetBase* querySet,
+    BufferBase* destination,
+    const std::vector<TimestampResolveRange>& ranges,
+    uint32_t totalQueryCount) {
+    DeviceBase* device = GetDevice();
+
+    // Pack the availability of the whole query set in a bitset of u32 words.
+    const std::vector<bool>& availability = querySet->GetQueryAvailability();
+    std::vector<uint32_t> availabilityWords((querySet->GetQueryCount() + 31) / 32);
+    for (uint32_t i = 0; i < availability.size(); i++) {
+        if (availability[i]) {
+            availabilityWords[i / 32] |= 1u << (i % 32);
+        }
+    }
+
+    BufferDescriptor availabilityDesc = {};
+    availabilityDesc.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopyDst;
+    availabilityDesc.size = availabilityWords.size() * sizeof(uint32_t);
+    Ref<BufferBase> availabilityBuffer;
+    DAWN_TRY_ASSIGN(availabilityBuffer, device->CreateBuffer(&availabilityDesc));
+    DAWN_TRY(device->GetQueue()->WriteBuffer(availabilityBuffer.Get(), 0, availabilityWords.data(),
+                                             availabilityWords.size() * sizeof(uint32_t)));
+
+    BufferDescriptor rangesDesc = {};
+    rangesDesc.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopyDst;
+    rangesDesc.size = ranges.size() * sizeof(TimestampResolveRange);
+    Ref<BufferBase> rangesBuffer;
+    DAWN_TRY_ASSIGN(rangesBuffer, device->CreateBuffer(&rangesDesc));
+    DAWN_TRY(device->GetQueue()->WriteBuffer(rangesBuffer.Get(), 0, ranges.data(),
+                                             ranges.size() * sizeof(TimestampResolveRange)));
+
+    TimestampParams params(static_cast<uint32_t>(ranges.size()),
+                           device->GetTimestampPeriodInNS());
+    BufferDescriptor paramsDesc = {};
+    paramsDesc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+    paramsDesc.size = sizeof(params);
+    Ref<BufferBase> paramsBuffer;
+    DAWN_TRY_ASSIGN(paramsBuffer, device->CreateBuffer(&paramsDesc));
+    DAWN_TRY(device->GetQueue()->WriteBuffer(paramsBuffer.Get(), 0, &params, sizeof(params)));
+
+    return EncodeConvertTimestampsToNanoseconds(this, destination, availabilityBuffer.Get(),
+                                                rangesBuffer.Get(), paramsBuffer.Get(),
+                                                totalQueryCount);
+}
+
 // Implementation of the command buffer validation that can be precomputed before submit
 MaybeError CommandEncoder::ValidateFinish() const {
     TRACE_EVENT0(GetDevice()->GetPlatform(), Validation, "CommandEncoder::ValidateFinish");
@@ -17,17 +17,20 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "dawn/native/dawn_platform.h"
 
 #include "dawn/native/EncodingContext.h"
 #include "dawn/native/Error.h"
+#include "dawn/native/GPUTimelineCapture.h"
 #include "dawn/native/ObjectBase.h"
 #include "dawn/native/PassResourceUsage.h"
 
 namespace dawn::native {
 
 enum class UsageValidationMode;
+struct TimestampResolveRange;
 
 bool HasDeprecatedColor(const RenderPassColorAttachment& attachment);
 
@@ -50,6 +53,13 @@ class CommandEncoder final : public ApiObjectBase {
     void TrackUsedQuerySet(QuerySetBase* querySet);
     void TrackQueryAvailability(QuerySetBase* querySet, uint32_t queryIndex);
 
+    // GPU timeline capture hooks, no-ops when the device has no capture. Begin is called when a
+    // pass begins encoding and End when the pass encoder ends successfully; the records are
+    // moved into the command buffer on Finish.
+    void EncodeTimelinePassBegin(const char* passName);
+    void EncodeTimelinePassEnd();
+    std::vector<GPUTimelineCapture::PassRecord> AcquireTimelinePasses();
+
     // Dawn API
     ComputePassEncoder* APIBeginComputePass(const ComputePassDescriptor* descriptor);
     RenderPassEncoder* APIBeginRenderPass(const RenderPassDescriptor* descriptor);
@@ -83,6 +93,7 @@ class CommandEncoder final : public ApiObjectBase {
                             uint32_t queryCount,
                             BufferBase* destination,
                             uint64_t destinationOffset);
+    void APIStitchCommands(CommandEncoder* source);
     void APIWriteBuffer(BufferBase* buffer,
                         uint64_t bufferOffset,
                         const uint8_t* data,
@@ -102,6 +113,8 @@ class CommandEncoder final : public ApiObjectBase {
 
     void DestroyImpl() override;
 
+    bool IsValidationEnabled() const;
+
     // Helper to be able to implement both APICopyTextureToTexture and
     // APICopyTextureToTextureInternal. The only difference between both
     // copies, is that the Internal one will also check internal usage.
@@ -112,6 +125,18 @@ class CommandEncoder final : public ApiObjectBase {
 
     MaybeError ValidateFinish() const;
 
+    // Encodes the batched timestamp conversion passes for all the ResolveQuerySet calls
+    // recorded on this encoder. Called once from Finish when the defer_timestamp_conversions
+    // toggle is enabled.
+    MaybeError EncodeTimestampConversions();
+
+    // Encodes one conversion dispatch covering |ranges| of |querySet| resolved into
+    // |destination|.
+    MaybeError EncodeTimestampConversionPass(QuerySetBase* querySet,
+                                             BufferBase* destination,
+                                             const std::vector<TimestampResolveRange>& ranges,
+                                             uint32_t totalQueryCount);
+
     EncodingContext mEncodingContext;
     std::set<BufferBase*> mTopLevelBuffers;
     std::set<TextureBase*> mTopLevelTextures;
@@ -119,7 +144,23 @@ class CommandEncoder final : public ApiObjectBase {
 
     uint64_t mDebugGroupStackSize = 0;
 
+    // Timestamp resolves whose tick-to-nanosecond conversion is deferred to Finish so that all
+    // the ranges of a frame share one availability upload and one dispatch per destination.
+    struct DeferredTimestampConversion {
+        Ref<QuerySetBase> querySet;
+        uint32_t firstQuery;
+        uint32_t queryCount;
+        Ref<BufferBase> destination;
+        uint64_t destinationOffset;
+    };
+    std::vector<DeferredTimestampConversion> mDeferredTimestampConversions;
+
+    uint32_t mTimelinePassBeginSlot = GPUTimelineCapture::kInvalidQuerySlot;
+    const char* mTimelinePassName = nullptr;
+    std::vector<GPUTimelineCapture::PassRecord> mTimelinePasses;
+
     UsageValidationMode mUsageValidationMode;
+    const bool mValidationEnabled;
 };
 
 }  // namespace dawn::native
@@ -96,6 +96,17 @@ void FreeCommands(CommandIterator* commands) {
                 draw->~DrawIndexedIndirectCmd();
                 break;
             }
+            case Command::MultiDrawIndirect: {
+                MultiDrawIndirectCmd* draw = commands->NextCommand<MultiDrawIndirectCmd>();
+                draw->~MultiDrawIndirectCmd();
+                break;
+            }
+            case Command::MultiDrawIndexedIndirect: {
+                MultiDrawIndexedIndirectCmd* draw =
+                    commands->NextCommand<MultiDrawIndexedIndirectCmd>();
+                draw->~MultiDrawIndexedIndirectCmd();
+                break;
+            }
             case Command::EndComputePass: {
                 EndComputePassCmd* cmd = commands->NextCommand<EndComputePassCmd>();
                 cmd->~EndComputePassCmd();
@@ -180,7 +191,7 @@ void FreeCommands(CommandIterator* commands) {
             case Command::SetBindGroup: {
                 SetBindGroupCmd* cmd = commands->NextCommand<SetBindGroupCmd>();
                 if (cmd->dynamicOffsetCount > 0) {
-                    commands->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    commands->NextTrailingData<uint32_t>(cmd->dynamicOffsetCount);
                 }
                 cmd->~SetBindGroupCmd();
                 break;
@@ -266,6 +277,14 @@ void SkipCommand(CommandIterator* commands, Command type) {
             commands->NextCommand<DrawIndexedIndirectCmd>();
             break;
 
+        case Command::MultiDrawIndirect:
+            commands->NextCommand<MultiDrawIndirectCmd>();
+            break;
+
+        case Command::MultiDrawIndexedIndirect:
+            commands->NextCommand<MultiDrawIndexedIndirectCmd>();
+            break;
+
         case Command::EndComputePass:
             commands->NextCommand<EndComputePassCmd>();
             break;
@@ -336,7 +355,7 @@ void SkipCommand(CommandIterator* commands, Command type) {
         case Command::SetBindGroup: {
             SetBindGroupCmd* cmd = commands->NextCommand<SetBindGroupCmd>();
             if (cmd->dynamicOffsetCount > 0) {
-                commands->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                commands->NextTrailingData<uint32_t>(cmd->dynamicOffsetCount);
             }
             break;
         }
@@ -395,6 +414,9 @@ DispatchIndirectCmd::~DispatchIndirectCmd() = default;
 DrawIndirectCmd::DrawIndirectCmd() = default;
 DrawIndirectCmd::~DrawIndirectCmd() = default;
 
+MultiDrawIndirectCmd::MultiDrawIndirectCmd() = default;
+MultiDrawIndirectCmd::~MultiDrawIndirectCmd() = default;
+
 EndComputePassCmd::EndComputePassCmd() = default;
 EndComputePassCmd::~EndComputePassCmd() = default;
 
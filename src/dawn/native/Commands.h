@@ -48,6 +48,8 @@ enum class Command {
     DrawIndexed,
     DrawIndirect,
     DrawIndexedIndirect,
+    MultiDrawIndirect,
+    MultiDrawIndexedIndirect,
     EndComputePass,
     EndOcclusionQuery,
     EndRenderPass,
@@ -226,6 +228,20 @@ struct DrawIndirectCmd {
 
 struct DrawIndexedIndirectCmd : DrawIndirectCmd {};
 
+struct MultiDrawIndirectCmd {
+    MultiDrawIndirectCmd();
+    ~MultiDrawIndirectCmd();
+
+    Ref<BufferBase> indirectBuffer;
+    uint64_t indirectOffset;
+    uint32_t maxDrawCount;
+    // May be null, in which case maxDrawCount draws are issued unconditionally.
+    Ref<BufferBase> drawCountBuffer;
+    uint64_t drawCountBufferOffset;
+};
+
+struct MultiDrawIndexedIndirectCmd : MultiDrawIndirectCmd {};
+
 struct EndComputePassCmd {
     EndComputePassCmd();
     ~EndComputePassCmd();
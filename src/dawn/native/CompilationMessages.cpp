@@ -14,6 +14,9 @@
 
 #include "dawn/native/CompilationMessages.h"
 
+#include <unordered_map>
+#include <utility>
+
 #include "dawn/common/Assert.h"
 #include "dawn/native/dawn_platform.h"
 
@@ -53,6 +56,9 @@ void OwnedCompilationMessages::AddMessageForTesting(std::string message,
     // Cannot add messages after GetCompilationInfo has been called.
     ASSERT(mCompilationInfo.messages == nullptr);
 
+    // Convert any deferred diagnostics first so messages keep their insertion order.
+    EnsureMaterialized();
+
     mMessageStrings.push_back(message);
     mMessages.push_back({nullptr, nullptr, static_cast<WGPUCompilationMessageType>(type), lineNum,
                          linePos, offset, length});
@@ -124,22 +130,58 @@ void OwnedCompilationMessages::AddMessages(const tint::diag::List& diagnostics)
     // Cannot add messages after GetCompilationInfo has been called.
     ASSERT(mCompilationInfo.messages == nullptr);
 
+    // Nothing to store for a clean compile, and nothing will be materialized later either.
+    if (diagnostics.count() == 0) {
+        return;
+    }
+
+    if (mDeferredDiagnostics == nullptr) {
+        mDeferredDiagnostics = std::make_unique<tint::diag::List>();
+    }
+
+    // The tint::Source::File a diagnostic points at belongs to the parse results, which may be
+    // discarded before the messages are read. Give each copied diagnostic shared ownership of
+    // a copy of its file so the deferred conversion can still compute offsets from it.
+    std::unordered_map<const tint::Source::File*, std::shared_ptr<tint::Source::File>> fileCopies;
     for (const auto& diag : diagnostics) {
+        tint::diag::Diagnostic copy(diag);
+        if (copy.source.file != nullptr && copy.owned_file == nullptr) {
+            std::shared_ptr<tint::Source::File>& fileCopy = fileCopies[copy.source.file];
+            if (fileCopy == nullptr) {
+                fileCopy = std::make_shared<tint::Source::File>(*copy.source.file);
+            }
+            copy.source.file = fileCopy.get();
+            copy.owned_file = fileCopy;
+        }
+        mDeferredDiagnostics->add(std::move(copy));
+    }
+}
+
+void OwnedCompilationMessages::EnsureMaterialized() {
+    if (mDeferredDiagnostics == nullptr) {
+        return;
+    }
+
+    std::unique_ptr<tint::diag::List> diagnostics = std::move(mDeferredDiagnostics);
+    for (const auto& diag : *diagnostics) {
         AddMessage(diag);
     }
 
-    AddFormattedTintMessages(diagnostics);
+    AddFormattedTintMessages(*diagnostics);
 }
 
 void OwnedCompilationMessages::ClearMessages() {
     // Cannot clear messages after GetCompilationInfo has been called.
     ASSERT(mCompilationInfo.messages == nullptr);
 
+    mDeferredDiagnostics = nullptr;
     mMessageStrings.clear();
     mMessages.clear();
 }
 
 const WGPUCompilationInfo* OwnedCompilationMessages::GetCompilationInfo() {
+    EnsureMaterialized();
+
     mCompilationInfo.messageCount = mMessages.size();
     mCompilationInfo.messages = mMessages.data();
 
@@ -155,6 +197,7 @@ const WGPUCompilationInfo* OwnedCompilationMessages::GetCompilationInfo() {
 }
 
 const std::vector<std::string>& OwnedCompilationMessages::GetFormattedTintMessages() {
+    EnsureMaterialized();
     return mFormattedTintMessages;
 }
 
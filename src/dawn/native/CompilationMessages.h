@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_COMPILATIONMESSAGES_H_
 #define SRC_DAWN_NATIVE_COMPILATIONMESSAGES_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -41,6 +42,10 @@ class OwnedCompilationMessages : public NonCopyable {
         uint64_t linePos = 0,
         uint64_t offset = 0,
         uint64_t length = 0);
+    // Takes a self-contained copy of the diagnostics. Converting them into
+    // WGPUCompilationMessages and formatted strings is deferred until the first
+    // GetCompilationInfo or GetFormattedTintMessages call, so modules that compile clean
+    // (the overwhelmingly common case) never pay for it.
     void AddMessages(const tint::diag::List& diagnostics);
     void ClearMessages();
 
@@ -48,9 +53,13 @@ class OwnedCompilationMessages : public NonCopyable {
     const std::vector<std::string>& GetFormattedTintMessages();
 
   private:
+    void EnsureMaterialized();
     void AddMessage(const tint::diag::Diagnostic& diagnostic);
     void AddFormattedTintMessages(const tint::diag::List& diagnostics);
 
+    // Diagnostics copied by AddMessages but not yet converted. The copies own their
+    // tint::Source::File so they stay valid after the parse results are discarded.
+    std::unique_ptr<tint::diag::List> mDeferredDiagnostics;
     WGPUCompilationInfo mCompilationInfo;
     std::vector<std::string> mMessageStrings;
     std::vector<WGPUCompilationMessage> mMessages;
@@ -0,0 +1,254 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/CompressedTextureUploadHelper.h"
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Constants.h"
+#include "dawn/common/Math.h"
+#include "dawn/native/BindGroup.h"
+#include "dawn/native/BindGroupLayout.h"
+#include "dawn/native/Buffer.h"
+#include "dawn/native/CommandBuffer.h"
+#include "dawn/native/CommandEncoder.h"
+#include "dawn/native/ComputePassEncoder.h"
+#include "dawn/native/ComputePipeline.h"
+#include "dawn/native/Device.h"
+#include "dawn/native/Format.h"
+#include "dawn/native/InternalPipelineStore.h"
+#include "dawn/native/Queue.h"
+#include "dawn/native/Texture.h"
+#include "dawn/native/utils/WGPUHelpers.h"
+
+namespace dawn::native {
+
+namespace {
+
+// Writes smaller than this repack faster on the CPU than the fixed cost of an internal
+// pipeline dispatch and submit.
+constexpr uint64_t kMinCompressedUploadSizeForCompute = 64 * 1024;
+
+struct BlockUploadParams {
+    uint32_t rowLengthU32;
+    uint32_t rowsPerImage;
+    uint32_t srcRowStrideU32;
+    uint32_t srcImageStrideU32;
+    uint32_t dstRowStrideU32;
+    uint32_t dstImageStrideU32;
+};
+
+// Assert the offsets in BlockUploadParams are the same as in the shader.
+static_assert(offsetof(BlockUploadParams, rowLengthU32) == 0);
+static_assert(offsetof(BlockUploadParams, rowsPerImage) == 4);
+static_assert(offsetof(BlockUploadParams, srcRowStrideU32) == 8);
+static_assert(offsetof(BlockUploadParams, srcImageStrideU32) == 12);
+static_assert(offsetof(BlockUploadParams, dstRowStrideU32) == 16);
+static_assert(offsetof(BlockUploadParams, dstImageStrideU32) == 20);
+
+static const char sCompressedBlockUpload[] = R"(
+            struct U32Arr {
+                a : array<u32>
+            }
+
+            struct Params {
+                row_length : u32,
+                rows_per_image : u32,
+                src_row_stride : u32,
+                src_image_stride : u32,
+                dst_row_stride : u32,
+                dst_image_stride : u32,
+            }
+
+            @group(0) @binding(0) var<storage, read> src : U32Arr;
+            @group(0) @binding(1) var<storage, read_write> dst : U32Arr;
+            @group(0) @binding(2) var<uniform> params : Params;
+
+            // One invocation per 32-bit word of a block row; y indexes block rows across all
+            // images. The word copy is where a block-level transform of the compressed payload
+            // (swizzle, endpoint rewrite) slots in for formats that need one.
+            @compute @workgroup_size(64, 1, 1)
+            fn main(@builtin(global_invocation_id) GlobalInvocationID : vec3<u32>) {
+                let x = GlobalInvocationID.x;
+                if (x >= params.row_length) {
+                    return;
+                }
+                let image = GlobalInvocationID.y / params.rows_per_image;
+                let row = GlobalInvocationID.y - image * params.rows_per_image;
+                dst.a[image * params.dst_image_stride + row * params.dst_row_stride + x] =
+                    src.a[image * params.src_image_stride + row * params.src_row_stride + x];
+            }
+        )";
+
+ResultOrError<ComputePipelineBase*> GetOrCreateCompressedBlockUploadPipeline(DeviceBase* device) {
+    InternalPipelineStore* store = device->GetInternalPipelineStore();
+
+    if (store->compressedBlockUploadPipeline == nullptr) {
+        // Create compute shader module if not cached before.
+        if (store->compressedBlockUploadCS == nullptr) {
+            DAWN_TRY_ASSIGN(store->compressedBlockUploadCS,
+                            utils::CreateShaderModule(device, sCompressedBlockUpload));
+        }
+
+        // Create binding group layout
+        Ref<BindGroupLayoutBase> bgl;
+        DAWN_TRY_ASSIGN(
+            bgl, utils::MakeBindGroupLayout(
+                     device,
+                     {
+                         {0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::ReadOnlyStorage},
+                         {1, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage},
+                         {2, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform},
+                     },
+                     /* allowInternalBinding */ true));
+
+        // Create pipeline layout
+        Ref<PipelineLayoutBase> layout;
+        DAWN_TRY_ASSIGN(layout, utils::MakeBasicPipelineLayout(device, bgl));
+
+        // Create ComputePipeline.
+        ComputePipelineDescriptor computePipelineDesc = {};
+        computePipelineDesc.layout = layout.Get();
+        computePipelineDesc.compute.module = store->compressedBlockUploadCS.Get();
+        computePipelineDesc.compute.entryPoint = "main";
+
+        DAWN_TRY_ASSIGN(store->compressedBlockUploadPipeline,
+                        device->CreateComputePipeline(&computePipelineDesc));
+    }
+
+    return store->compressedBlockUploadPipeline.Get();
+}
+
+}  // anonymous namespace
+
+bool ShouldUploadCompressedDataWithCompute(DeviceBase* device,
+                                           const Format& format,
+                                           const TexelBlockInfo& blockInfo,
+                                           const TextureDataLayout& dataLayout,
+                                           const Extent3D& writeSizePixel) {
+    if (!device->IsToggleEnabled(Toggle::UseComputeForCompressedTextureUpload)) {
+        return false;
+    }
+    if (!format.isCompressed) {
+        return false;
+    }
+
+    // The shader addresses both buffers as arrays of u32. The block byte sizes are all
+    // multiples of 4 but the caller-provided row stride may not be.
+    if (dataLayout.bytesPerRow % 4 != 0) {
+        return false;
+    }
+
+    uint32_t widthInBlocks = writeSizePixel.width / blockInfo.width;
+    uint32_t heightInBlocks = writeSizePixel.height / blockInfo.height;
+    uint64_t rowBytes = uint64_t(widthInBlocks) * blockInfo.byteSize;
+    uint64_t dstRowPitch = Align(rowBytes, kTextureBytesPerRowAlignment);
+
+    // No benefit when no repacking is needed: the CPU path is a single contiguous copy then.
+    if (heightInBlocks <= 1 ||
+        (rowBytes == dstRowPitch && uint64_t(dataLayout.bytesPerRow) == dstRowPitch)) {
+        return false;
+    }
+
+    uint64_t srcDataSize = uint64_t(dataLayout.bytesPerRow) * heightInBlocks *
+                           writeSizePixel.depthOrArrayLayers;
+    return srcDataSize >= kMinCompressedUploadSizeForCompute;
+}
+
+MaybeError UploadCompressedDataWithCompute(DeviceBase* device,
+                                           const void* data,
+                                           const TextureDataLayout& dataLayout,
+                                           const ImageCopyTexture& destination,
+                                           const Extent3D& writeSizePixel) {
+    const Format& format = destination.texture->GetFormat();
+    const TexelBlockInfo& blockInfo = format.GetAspectInfo(destination.aspect).block;
+
+    uint32_t widthInBlocks = writeSizePixel.width / blockInfo.width;
+    uint32_t heightInBlocks = writeSizePixel.height / blockInfo.height;
+    uint32_t depth = writeSizePixel.depthOrArrayLayers;
+    uint32_t rowBytes = widthInBlocks * blockInfo.byteSize;
+    uint32_t dstRowPitch = Align(rowBytes, kTextureBytesPerRowAlignment);
+
+    // One contiguous copy of the raw blocks, including their source stride; the shader skips
+    // the padding between rows. Only the bytes up to the last block row of the last image are
+    // needed.
+    uint64_t srcImageStride = uint64_t(dataLayout.bytesPerRow) * dataLayout.rowsPerImage;
+    uint64_t srcSize = srcImageStride * (depth - 1) +
+                       uint64_t(dataLayout.bytesPerRow) * (heightInBlocks - 1) + rowBytes;
+    ASSERT(srcSize % 4 == 0);
+
+    Ref<BufferBase> srcBuffer;
+    DAWN_TRY_ASSIGN(srcBuffer, utils::CreateBufferFromData(
+                                   device, wgpu::BufferUsage::Storage,
+                                   static_cast<const uint8_t*>(data) + dataLayout.offset,
+                                   srcSize));
+
+    uint64_t dstImageStride = uint64_t(dstRowPitch) * heightInBlocks;
+    uint64_t dstSize =
+        dstImageStride * (depth - 1) + uint64_t(dstRowPitch) * (heightInBlocks - 1) + rowBytes;
+
+    InternalPipelineStore* store = device->GetInternalPipelineStore();
+    Ref<BufferBase> dstBuffer;
+    DAWN_TRY_ASSIGN(dstBuffer, store->scratchPool.Lease(dstSize));
+
+    BlockUploadParams params;
+    params.rowLengthU32 = rowBytes / 4;
+    params.rowsPerImage = heightInBlocks;
+    params.srcRowStrideU32 = dataLayout.bytesPerRow / 4;
+    params.srcImageStrideU32 = static_cast<uint32_t>(srcImageStride / 4);
+    params.dstRowStrideU32 = dstRowPitch / 4;
+    params.dstImageStrideU32 = static_cast<uint32_t>(dstImageStride / 4);
+
+    Ref<BufferBase> paramsBuffer;
+    DAWN_TRY_ASSIGN(paramsBuffer, utils::CreateBufferFromData(device, wgpu::BufferUsage::Uniform,
+                                                              &params, sizeof(params)));
+
+    ComputePipelineBase* pipeline;
+    DAWN_TRY_ASSIGN(pipeline, GetOrCreateCompressedBlockUploadPipeline(device));
+
+    Ref<BindGroupLayoutBase> layout;
+    DAWN_TRY_ASSIGN(layout, pipeline->GetBindGroupLayout(0));
+
+    Ref<BindGroupBase> bindGroup;
+    DAWN_TRY_ASSIGN(bindGroup,
+                    utils::MakeBindGroup(device, layout,
+                                         {{0, srcBuffer}, {1, dstBuffer}, {2, paramsBuffer}},
+                                         UsageValidationMode::Internal));
+
+    CommandEncoderDescriptor encoderDesc = {};
+    Ref<CommandEncoder> encoder;
+    DAWN_TRY_ASSIGN(encoder, device->CreateCommandEncoder(&encoderDesc));
+
+    Ref<ComputePassEncoder> pass = encoder->BeginComputePass();
+    pass->APISetPipeline(pipeline);
+    pass->APISetBindGroup(0, bindGroup.Get());
+    pass->APIDispatchWorkgroups((params.rowLengthU32 + 63) / 64, heightInBlocks * depth);
+    pass->APIEnd();
+
+    ImageCopyBuffer bufferCopy = {};
+    bufferCopy.buffer = dstBuffer.Get();
+    bufferCopy.layout.offset = 0;
+    bufferCopy.layout.bytesPerRow = dstRowPitch;
+    bufferCopy.layout.rowsPerImage = heightInBlocks;
+    encoder->APICopyBufferToTexture(&bufferCopy, &destination, &writeSizePixel);
+
+    Ref<CommandBufferBase> commandBuffer;
+    DAWN_TRY_ASSIGN(commandBuffer, encoder->Finish());
+
+    CommandBufferBase* submitCommandBuffer = commandBuffer.Get();
+    device->GetQueue()->APISubmit(1, &submitCommandBuffer);
+
+    return {};
+}
+
+}  // namespace dawn::native
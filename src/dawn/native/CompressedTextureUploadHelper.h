@@ -0,0 +1,47 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_COMPRESSEDTEXTUREUPLOADHELPER_H_
+#define SRC_DAWN_NATIVE_COMPRESSEDTEXTUREUPLOADHELPER_H_
+
+#include "dawn/native/Error.h"
+#include "dawn/native/dawn_platform.h"
+
+namespace dawn::native {
+
+class DeviceBase;
+struct Format;
+struct TexelBlockInfo;
+
+// Returns true when WriteTexture should upload the block-compressed data raw and lay it out
+// GPU-side with the internal compute pass instead of repacking rows on the CPU. Requires the
+// use_compute_for_compressed_texture_upload toggle and only triggers for large writes whose
+// rows actually need repacking.
+bool ShouldUploadCompressedDataWithCompute(DeviceBase* device,
+                                           const Format& format,
+                                           const TexelBlockInfo& blockInfo,
+                                           const TextureDataLayout& dataLayout,
+                                           const Extent3D& writeSizePixel);
+
+// Uploads the raw block data with a single contiguous copy and submits a compute pass that
+// rewrites the blocks at the row pitch the buffer-to-texture copy into the destination needs.
+MaybeError UploadCompressedDataWithCompute(DeviceBase* device,
+                                           const void* data,
+                                           const TextureDataLayout& dataLayout,
+                                           const ImageCopyTexture& destination,
+                                           const Extent3D& writeSizePixel);
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_COMPRESSEDTEXTUREUPLOADHELPER_H_
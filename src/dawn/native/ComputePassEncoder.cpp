@@ -113,6 +113,7 @@ ComputePassEncoder::ComputePassEncoder(DeviceBase* device,
                                        CommandEncoder* commandEncoder,
                                        EncodingContext* encodingContext)
     : ProgrammableEncoder(device, descriptor->label, encodingContext),
+      mMergeDispatchSyncScopes(device->IsToggleEnabled(Toggle::MergeComputePassSyncScopes)),
       mCommandEncoder(commandEncoder) {
     TrackInDevice();
 }
@@ -129,7 +130,9 @@ ComputePassEncoder::ComputePassEncoder(DeviceBase* device,
                                        CommandEncoder* commandEncoder,
                                        EncodingContext* encodingContext,
                                        ErrorTag errorTag)
-    : ProgrammableEncoder(device, encodingContext, errorTag), mCommandEncoder(commandEncoder) {}
+    : ProgrammableEncoder(device, encodingContext, errorTag),
+      mMergeDispatchSyncScopes(device->IsToggleEnabled(Toggle::MergeComputePassSyncScopes)),
+      mCommandEncoder(commandEncoder) {}
 
 // static
 Ref<ComputePassEncoder> ComputePassEncoder::MakeError(DeviceBase* device,
@@ -162,7 +165,12 @@ void ComputePassEncoder::APIEnd() {
                 return {};
             },
             "encoding %s.End().", this)) {
+        if (mHasMergedDispatches) {
+            mUsageTracker.ReplaceDispatch(mMergedScopeDispatchIndex,
+                                          mMergedDispatchScope.AcquireSyncScopeUsage());
+        }
         mEncodingContext->ExitComputePass(this, mUsageTracker.AcquireResourceUsage());
+        mCommandEncoder->EncodeTimelinePassEnd();
     }
 }
 
@@ -300,10 +308,14 @@ ComputePassEncoder::TransformIndirectDispatchBuffer(Ref<BufferBase> indirectBuff
                                          },
                                          UsageValidationMode::Internal));
 
-    // Issue commands to validate the indirect buffer.
+    // Issue commands to validate the indirect buffer. The client's dispatch reads the scratch
+    // buffer this dispatch writes, so its scope must never be merged with the others.
+    ASSERT(!mEncodingInternalDispatch);
+    mEncodingInternalDispatch = true;
     APISetPipeline(validationPipeline.Get());
     APISetBindGroup(0, validationBindGroup.Get());
     APIDispatchWorkgroups(1);
+    mEncodingInternalDispatch = false;
 
     // Restore the state.
     RestoreCommandBufferState(std::move(previousState));
@@ -367,14 +379,17 @@ void ComputePassEncoder::APIDispatchWorkgroupsIndirect(BufferBase* indirectBuffe
 
             // If we have created a new scratch dispatch indirect buffer in
             // TransformIndirectDispatchBuffer(), we need to track it in mUsageTracker.
-            if (indirectBufferRef.Get() != indirectBuffer) {
+            bool transformed = indirectBufferRef.Get() != indirectBuffer;
+            if (transformed) {
                 // |indirectBufferRef| was replaced with a scratch buffer. Add it to the
                 // synchronization scope.
                 scope.BufferUsedAs(indirectBufferRef.Get(), wgpu::BufferUsage::Indirect);
                 mUsageTracker.AddReferencedBuffer(indirectBufferRef.Get());
             }
 
-            AddDispatchSyncScope(std::move(scope));
+            // A transformed dispatch reads the scratch buffer the validation dispatch just
+            // wrote, so its scope must keep its own entry when scopes are merged.
+            AddDispatchSyncScope(std::move(scope), /*mergeable*/ !transformed);
 
             DispatchIndirectCmd* dispatch =
                 allocator->Allocate<DispatchIndirectCmd>(Command::DispatchIndirect);
@@ -448,11 +463,25 @@ void ComputePassEncoder::APIWriteTimestamp(QuerySetBase* querySet, uint32_t quer
         "encoding %s.WriteTimestamp(%s, %u).", this, querySet, queryIndex);
 }
 
-void ComputePassEncoder::AddDispatchSyncScope(SyncScopeUsageTracker scope) {
+void ComputePassEncoder::AddDispatchSyncScope(SyncScopeUsageTracker scope, bool mergeable) {
     PipelineLayoutBase* layout = mCommandBufferState.GetPipelineLayout();
     for (BindGroupIndex i : IterateBitSet(layout->GetBindGroupLayoutsMask())) {
         scope.AddBindGroup(mCommandBufferState.GetBindGroup(i));
     }
+
+    if (mMergeDispatchSyncScopes && mergeable && !mEncodingInternalDispatch) {
+        if (!mHasMergedDispatches) {
+            mHasMergedDispatches = true;
+            mMergedScopeDispatchIndex = mUsageTracker.GetDispatchCount();
+        }
+        mMergedDispatchScope.AddSyncScopeUsage(scope.AcquireSyncScopeUsage());
+
+        // Record an empty placeholder scope so that backends still see one scope per dispatch;
+        // APIEnd replaces the scope of the first merged dispatch with the union.
+        mUsageTracker.AddDispatch({});
+        return;
+    }
+
     mUsageTracker.AddDispatch(scope.AcquireSyncScopeUsage());
 }
 
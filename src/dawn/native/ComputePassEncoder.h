@@ -89,10 +89,24 @@ class ComputePassEncoder final : public ProgrammableEncoder {
     CommandBufferStateTracker mCommandBufferState;
 
     // Adds the bindgroups used for the current dispatch to the SyncScopeResourceUsage and
-    // records it in mUsageTracker.
-    void AddDispatchSyncScope(SyncScopeUsageTracker scope = {});
+    // records it in mUsageTracker. When the merge_compute_pass_sync_scopes toggle is on,
+    // |mergeable| scopes are pooled into mMergedDispatchScope instead of getting their own
+    // entry.
+    void AddDispatchSyncScope(SyncScopeUsageTracker scope = {}, bool mergeable = true);
     ComputePassResourceUsageTracker mUsageTracker;
 
+    // State for the merge_compute_pass_sync_scopes toggle. Merged dispatch scopes accumulate
+    // in mMergedDispatchScope and APIEnd records the union as the scope of the first merged
+    // dispatch (the others keep empty scopes), so backends synchronize each resource once for
+    // the whole pass instead of between every pair of dispatches. Dispatches that consume the
+    // scratch buffer written by the internal indirect validation dispatch (and that dispatch
+    // itself) are never merged since they depend on each other by construction.
+    const bool mMergeDispatchSyncScopes;
+    bool mEncodingInternalDispatch = false;
+    bool mHasMergedDispatches = false;
+    size_t mMergedScopeDispatchIndex = 0;
+    SyncScopeUsageTracker mMergedDispatchScope;
+
     // For render and compute passes, the encoding context is borrowed from the command encoder.
     // Keep a reference to the encoder to make sure the context isn't freed.
     Ref<CommandEncoder> mCommandEncoder;
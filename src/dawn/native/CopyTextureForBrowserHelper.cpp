@@ -14,9 +14,12 @@
 
 #include "dawn/native/CopyTextureForBrowserHelper.h"
 
+#include <sstream>
+#include <string>
 #include <unordered_set>
 #include <utility>
 
+#include "dawn/common/Assert.h"
 #include "dawn/common/Log.h"
 #include "dawn/native/BindGroup.h"
 #include "dawn/native/BindGroupLayout.h"
@@ -232,6 +235,148 @@ struct Uniform {
 };
 static_assert(sizeof(Uniform) == 176);
 
+// Steps of the conversion applied by the copy, matching the values in the shader above. They
+// are used both as the steps_mask uniform of the uber-shader and to bake specialized shader
+// variants.
+constexpr uint32_t kUnpremultiplyStep = 0x01;
+constexpr uint32_t kDecodeToLinearStep = 0x02;
+constexpr uint32_t kConvertToDstGamutStep = 0x04;
+constexpr uint32_t kEncodeToGammaStep = 0x08;
+constexpr uint32_t kPremultiplyStep = 0x10;
+constexpr uint32_t kDecodeForSrgbDstFormat = 0x20;
+constexpr uint32_t kClearSrcAlphaToOne = 0x40;
+
+// The steps that depend on parameters only known at copy time (the gamma transfer functions and
+// the gamut conversion matrix). Copies using them keep the uniform-driven uber-shader; every
+// other combination of steps gets a shader variant with the steps baked in.
+constexpr uint32_t kDynamicSteps =
+    kDecodeToLinearStep | kConvertToDstGamutStep | kEncodeToGammaStep;
+
+// Modifier bits combined with the steps mask to identify a shader variant, see
+// MakeCopyTextureForBrowserPipelineKey.
+constexpr uint32_t kFlipYVariant = 0x80;
+constexpr uint32_t kUberShaderVariant = 0x100;
+
+// Generates a variant of the copy shader with the given steps baked in, so that the common
+// copies without color space conversion pay neither the uniform-driven branching nor the
+// constant buffer traffic for the gamma tables of the uber-shader.
+std::string GetSpecializedShader(uint32_t stepsMask, bool flipY) {
+    ASSERT((stepsMask & kDynamicSteps) == 0);
+
+    std::ostringstream shader;
+    shader << R"(
+            struct Uniforms {
+                scale: vec2<f32>,
+                offset: vec2<f32>,
+            };
+
+            @binding(0) @group(0) var<uniform> uniforms : Uniforms;
+
+            struct VertexOutputs {
+                @location(0) texcoords : vec2<f32>,
+                @builtin(position) position : vec4<f32>,
+            };
+
+            @vertex
+            fn vs_main(
+                @builtin(vertex_index) VertexIndex : u32
+            ) -> VertexOutputs {
+                var texcoord = array<vec2<f32>, 3>(
+                    vec2<f32>(-0.5, 0.0),
+                    vec2<f32>( 1.5, 0.0),
+                    vec2<f32>( 0.5, 2.0));
+
+                var output : VertexOutputs;
+                output.position = vec4<f32>((texcoord[VertexIndex] * 2.0 - vec2<f32>(1.0, 1.0)), 0.0, 1.0);
+        )";
+
+    // See the uber-shader for an explanation of the texture coordinate mappings. The flip is
+    // known when the variant is generated so only one of the mappings is emitted.
+    if (flipY) {
+        shader << R"(
+                output.texcoords = (texcoord[VertexIndex] * uniforms.scale + uniforms.offset) *
+                    vec2<f32>(1.0, -1.0) + vec2<f32>(0.0, 1.0);
+        )";
+    } else {
+        shader << R"(
+                output.texcoords = (texcoord[VertexIndex] *
+                    vec2<f32>(1.0, -1.0) + vec2<f32>(0.0, 1.0)) *
+                    uniforms.scale + uniforms.offset;
+        )";
+    }
+
+    shader << R"(
+                return output;
+            }
+
+            @binding(1) @group(0) var mySampler: sampler;
+            @binding(2) @group(0) var myTexture: texture_2d<f32>;
+        )";
+
+    if (stepsMask & kDecodeForSrgbDstFormat) {
+        shader << R"(
+            // Decoding function for copies to *-srgb formats, see the uber-shader for details.
+            // The transfer parameters of the sRGB curve are compile-time constants here.
+            fn srgb_gamma_decode(v: f32) -> f32 {
+                if (abs(v) < 4.045e-02) {
+                    return sign(v) * ((1.0 / 12.92) * abs(v));
+                }
+                return sign(v) * pow((1.0 / 1.055) * abs(v) + (0.055 / 1.055), 2.4);
+            }
+        )";
+    }
+
+    shader << R"(
+            @fragment
+            fn fs_main(
+                @location(0) texcoord : vec2<f32>
+            ) -> @location(0) vec4<f32> {
+                // Clamp the texcoord and discard the out-of-bound pixels.
+                var clampedTexcoord =
+                    clamp(texcoord, vec2<f32>(0.0, 0.0), vec2<f32>(1.0, 1.0));
+
+                var color = textureSample(myTexture, mySampler, texcoord);
+
+                if (!all(clampedTexcoord == texcoord)) {
+                    discard;
+                }
+        )";
+
+    // The steps are emitted in the same order as the uber-shader applies them.
+    if (stepsMask & kUnpremultiplyStep) {
+        shader << R"(
+                if (color.a != 0.0) {
+                    color = vec4<f32>(color.rgb / color.a, color.a);
+                }
+        )";
+    }
+    if (stepsMask & kPremultiplyStep) {
+        shader << R"(
+                color = vec4<f32>(color.rgb * color.a, color.a);
+        )";
+    }
+    if (stepsMask & kDecodeForSrgbDstFormat) {
+        shader << R"(
+                color = vec4<f32>(srgb_gamma_decode(color.r),
+                                  srgb_gamma_decode(color.g),
+                                  srgb_gamma_decode(color.b),
+                                  color.a);
+        )";
+    }
+    if (stepsMask & kClearSrcAlphaToOne) {
+        shader << R"(
+                color.a = 1.0;
+        )";
+    }
+
+    shader << R"(
+                return color;
+            }
+        )";
+
+    return shader.str();
+}
+
 // TODO(crbug.com/dawn/856): Expand copyTextureForBrowser to support any
 // non-depth, non-stencil, non-compressed texture format pair copy.
 MaybeError ValidateCopyTextureFormatConversion(const wgpu::TextureFormat srcFormat,
@@ -269,8 +414,15 @@ MaybeError ValidateCopyTextureFormatConversion(const wgpu::TextureFormat srcForm
     return {};
 }
 
-RenderPipelineBase* GetCachedPipeline(InternalPipelineStore* store, wgpu::TextureFormat dstFormat) {
-    auto pipeline = store->copyTextureForBrowserPipelines.find(dstFormat);
+// The key of a cached pipeline combines the destination format with the shader variant: the
+// baked steps mask and flip for specialized variants, or kUberShaderVariant for the single
+// uniform-driven variant of a format.
+uint64_t MakeCopyTextureForBrowserPipelineKey(wgpu::TextureFormat dstFormat, uint32_t shaderKey) {
+    return (static_cast<uint64_t>(dstFormat) << 32) | shaderKey;
+}
+
+RenderPipelineBase* GetCachedPipeline(InternalPipelineStore* store, uint64_t pipelineKey) {
+    auto pipeline = store->copyTextureForBrowserPipelines.find(pipelineKey);
     if (pipeline != store->copyTextureForBrowserPipelines.end()) {
         return pipeline->second.Get();
     }
@@ -279,26 +431,45 @@ RenderPipelineBase* GetCachedPipeline(InternalPipelineStore* store, wgpu::Textur
 
 ResultOrError<RenderPipelineBase*> GetOrCreateCopyTextureForBrowserPipeline(
     DeviceBase* device,
-    wgpu::TextureFormat dstFormat) {
+    wgpu::TextureFormat dstFormat,
+    uint32_t stepsMask,
+    bool flipY) {
     InternalPipelineStore* store = device->GetInternalPipelineStore();
 
-    if (GetCachedPipeline(store, dstFormat) == nullptr) {
-        // Create vertex shader module if not cached before.
-        if (store->copyTextureForBrowser == nullptr) {
-            DAWN_TRY_ASSIGN(store->copyTextureForBrowser,
-                            utils::CreateShaderModule(device, sCopyTextureForBrowserShader));
+    // Copies whose steps need copy-time parameters fall back on the uber-shader; all the other
+    // combinations get a specialized variant with the steps baked in the shader.
+    bool useUberShader = (stepsMask & kDynamicSteps) != 0;
+    uint32_t shaderKey;
+    if (useUberShader) {
+        shaderKey = kUberShaderVariant;
+    } else {
+        shaderKey = stepsMask | (flipY ? kFlipYVariant : 0);
+    }
+    uint64_t pipelineKey = MakeCopyTextureForBrowserPipelineKey(dstFormat, shaderKey);
+
+    if (GetCachedPipeline(store, pipelineKey) == nullptr) {
+        Ref<ShaderModuleBase> shaderModule;
+        if (useUberShader) {
+            // Create the uber-shader module if not cached before.
+            if (store->copyTextureForBrowser == nullptr) {
+                DAWN_TRY_ASSIGN(store->copyTextureForBrowser,
+                                utils::CreateShaderModule(device, sCopyTextureForBrowserShader));
+            }
+            shaderModule = store->copyTextureForBrowser;
+        } else {
+            std::string specializedShader = GetSpecializedShader(stepsMask, flipY);
+            DAWN_TRY_ASSIGN(shaderModule,
+                            utils::CreateShaderModule(device, specializedShader.c_str()));
         }
 
-        ShaderModuleBase* shaderModule = store->copyTextureForBrowser.Get();
-
         // Prepare vertex stage.
         VertexState vertex = {};
-        vertex.module = shaderModule;
+        vertex.module = shaderModule.Get();
         vertex.entryPoint = "vs_main";
 
         // Prepare frgament stage.
         FragmentState fragment = {};
-        fragment.module = shaderModule;
+        fragment.module = shaderModule.Get();
         fragment.entryPoint = "fs_main";
 
         // Prepare color state.
@@ -321,10 +492,10 @@ ResultOrError<RenderPipelineBase*> GetOrCreateCopyTextureForBrowserPipeline(
 
         Ref<RenderPipelineBase> pipeline;
         DAWN_TRY_ASSIGN(pipeline, device->CreateRenderPipeline(&renderPipelineDesc));
-        store->copyTextureForBrowserPipelines.insert({dstFormat, std::move(pipeline)});
+        store->copyTextureForBrowserPipelines.insert({pipelineKey, std::move(pipeline)});
     }
 
-    return GetCachedPipeline(store, dstFormat);
+    return GetCachedPipeline(store, pipelineKey);
 }
 }  // anonymous namespace
 
@@ -418,13 +589,6 @@ MaybeError DoCopyTextureForBrowser(DeviceBase* device,
     }
 
     bool isSrgbDstFormat = IsSrgbDstFormat(destination->texture->GetFormat().format);
-    RenderPipelineBase* pipeline;
-    DAWN_TRY_ASSIGN(pipeline, GetOrCreateCopyTextureForBrowserPipeline(
-                                  device, destination->texture->GetFormat().format));
-
-    // Prepare bind group layout.
-    Ref<BindGroupLayoutBase> layout;
-    DAWN_TRY_ASSIGN(layout, pipeline->GetBindGroupLayout(0));
 
     Extent3D srcTextureSize = source->texture->GetSize();
 
@@ -460,14 +624,6 @@ MaybeError DoCopyTextureForBrowser(DeviceBase* device,
     // From http://www.brucelindbloom.com/index.html?WorkingSpaceInfo.html
     // "Since the Lab TIFF specification, the ICC profile specification and
     // Adobe Photoshop all use a D50"
-    constexpr uint32_t kUnpremultiplyStep = 0x01;
-    constexpr uint32_t kDecodeToLinearStep = 0x02;
-    constexpr uint32_t kConvertToDstGamutStep = 0x04;
-    constexpr uint32_t kEncodeToGammaStep = 0x08;
-    constexpr uint32_t kPremultiplyStep = 0x10;
-    constexpr uint32_t kDecodeForSrgbDstFormat = 0x20;
-    constexpr uint32_t kClearSrcAlphaToOne = 0x40;
-
     if (options->srcAlphaMode == wgpu::AlphaMode::Premultiplied) {
         if (options->needsColorSpaceConversion ||
             options->dstAlphaMode == wgpu::AlphaMode::Unpremultiplied) {
@@ -539,6 +695,20 @@ MaybeError DoCopyTextureForBrowser(DeviceBase* device,
 
     uniformData.stepsMask = stepsMask;
 
+    // The shader variant is picked from the steps of the copy, so the pipeline can only be
+    // fetched once the steps mask is known.
+    RenderPipelineBase* pipeline;
+    DAWN_TRY_ASSIGN(pipeline, GetOrCreateCopyTextureForBrowserPipeline(
+                                  device, destination->texture->GetFormat().format, stepsMask,
+                                  options->flipY));
+
+    // Prepare bind group layout.
+    Ref<BindGroupLayoutBase> layout;
+    DAWN_TRY_ASSIGN(layout, pipeline->GetBindGroupLayout(0));
+
+    // The specialized shader variants only declare the leading scale and offset fields, which
+    // are laid out identically in both uniform structs, so the full data can be uploaded
+    // regardless of the variant.
     Ref<BufferBase> uniformBuffer;
     DAWN_TRY_ASSIGN(
         uniformBuffer,
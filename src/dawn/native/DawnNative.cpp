@@ -284,6 +284,20 @@ DAWN_NATIVE_EXPORT bool DeviceTick(WGPUDevice device) {
     return FromAPI(device)->APITick();
 }
 
+DAWN_NATIVE_EXPORT void SetMemoryBudgetCallback(WGPUDevice device,
+                                                MemoryBudgetCallback callback,
+                                                void* userdata) {
+    FromAPI(device)->SetMemoryBudgetCallback(callback, userdata);
+}
+
+DAWN_NATIVE_EXPORT void ReduceMemoryUsage(WGPUDevice device) {
+    FromAPI(device)->ReduceMemoryUsage();
+}
+
+DAWN_NATIVE_EXPORT std::vector<AllocatorMemoryInfo> GetMemoryReport(WGPUDevice device) {
+    return FromAPI(device)->GetMemoryReport();
+}
+
 // ExternalImageDescriptor
 
 ExternalImageDescriptor::ExternalImageDescriptor(ExternalImageType type) : mType(type) {}
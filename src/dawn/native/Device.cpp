@@ -16,7 +16,12 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstring>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "dawn/common/Log.h"
@@ -31,6 +36,7 @@
 #include "dawn/native/ChainUtils_autogen.h"
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/CommandEncoder.h"
+#include "dawn/native/Commands.h"
 #include "dawn/native/CompilationMessages.h"
 #include "dawn/native/CreatePipelineAsyncTask.h"
 #include "dawn/native/DynamicUploader.h"
@@ -38,12 +44,15 @@
 #include "dawn/native/ErrorInjector.h"
 #include "dawn/native/ErrorScope.h"
 #include "dawn/native/ExternalTexture.h"
+#include "dawn/native/GPUTimelineCapture.h"
 #include "dawn/native/Instance.h"
 #include "dawn/native/InternalPipelineStore.h"
 #include "dawn/native/ObjectType_autogen.h"
 #include "dawn/native/PipelineCache.h"
+#include "dawn/native/PipelineLayout.h"
 #include "dawn/native/QuerySet.h"
 #include "dawn/native/Queue.h"
+#include "dawn/native/ReadbackBufferPool.h"
 #include "dawn/native/RenderBundleEncoder.h"
 #include "dawn/native/RenderPipeline.h"
 #include "dawn/native/Sampler.h"
@@ -72,6 +81,7 @@ struct DeviceBase::Caches {
         ASSERT(computePipelines.empty());
         ASSERT(pipelineLayouts.empty());
         ASSERT(renderPipelines.empty());
+        ASSERT(renderPipelineFingerprints.empty());
         ASSERT(samplers.empty());
         ASSERT(shaderModules.empty());
     }
@@ -81,6 +91,12 @@ struct DeviceBase::Caches {
     ContentLessObjectCache<ComputePipelineBase> computePipelines;
     ContentLessObjectCache<PipelineLayoutBase> pipelineLayouts;
     ContentLessObjectCache<RenderPipelineBase> renderPipelines;
+    // Pre-check for `renderPipelines` that resolves duplicate creations from the serialized
+    // descriptor bytes, before an uninitialized backend pipeline gets built and content-hashed.
+    std::unordered_map<std::string, RenderPipelineBase*> renderPipelineFingerprints;
+    // Entry tables computed by default pipeline layout inference. Unlike the object caches
+    // above this holds plain data, so entries simply live until the device is destroyed.
+    std::unordered_map<std::string, DefaultPipelineLayoutEntryData> defaultPipelineLayoutEntries;
     ContentLessObjectCache<SamplerBase> samplers;
     ContentLessObjectCache<ShaderModuleBase> shaderModules;
 };
@@ -166,6 +182,110 @@ ResultOrError<Ref<PipelineLayoutBase>> ValidateLayoutAndGetRenderPipelineDescrip
     return layoutRef;
 }
 
+// Serializes the parts of a render pipeline descriptor that determine the resulting pipeline
+// into a flat byte string usable as an exact-match cache key. Referenced objects (layout and
+// shader modules) are keyed by pointer since they are themselves deduplicated by the device
+// caches. Returns false when the descriptor carries chained structs, in which case the caller
+// must fall back to the content-hash based cache lookup.
+bool SerializeRenderPipelineFingerprint(const RenderPipelineDescriptor* descriptor,
+                                        std::string* out) {
+    auto AppendBytes = [&](const void* data, size_t size) {
+        out->append(static_cast<const char*>(data), size);
+    };
+    // Appends each field separately so that struct padding never leaks into the key.
+    auto AppendValues = [&](const auto&... values) { (AppendBytes(&values, sizeof(values)), ...); };
+    auto AppendString = [&](const char* s) {
+        size_t length = std::strlen(s);
+        AppendValues(length);
+        AppendBytes(s, length);
+    };
+
+    if (descriptor->nextInChain != nullptr || descriptor->vertex.nextInChain != nullptr ||
+        descriptor->primitive.nextInChain != nullptr ||
+        descriptor->multisample.nextInChain != nullptr) {
+        return false;
+    }
+
+    AppendValues(descriptor->layout);
+
+    const VertexState& vertex = descriptor->vertex;
+    AppendValues(vertex.module);
+    AppendString(vertex.entryPoint);
+    AppendValues(vertex.constantCount);
+    for (uint32_t i = 0; i < vertex.constantCount; ++i) {
+        if (vertex.constants[i].nextInChain != nullptr) {
+            return false;
+        }
+        AppendString(vertex.constants[i].key);
+        AppendValues(vertex.constants[i].value);
+    }
+    AppendValues(vertex.bufferCount);
+    for (uint32_t i = 0; i < vertex.bufferCount; ++i) {
+        const VertexBufferLayout& buffer = vertex.buffers[i];
+        AppendValues(buffer.arrayStride, buffer.stepMode, buffer.attributeCount);
+        for (uint32_t j = 0; j < buffer.attributeCount; ++j) {
+            const VertexAttribute& attribute = buffer.attributes[j];
+            AppendValues(attribute.format, attribute.offset, attribute.shaderLocation);
+        }
+    }
+
+    const PrimitiveState& primitive = descriptor->primitive;
+    AppendValues(primitive.topology, primitive.stripIndexFormat, primitive.frontFace,
+                 primitive.cullMode);
+
+    bool hasDepthStencil = descriptor->depthStencil != nullptr;
+    AppendValues(hasDepthStencil);
+    if (hasDepthStencil) {
+        const DepthStencilState& ds = *descriptor->depthStencil;
+        if (ds.nextInChain != nullptr) {
+            return false;
+        }
+        AppendValues(ds.format, ds.depthWriteEnabled, ds.depthCompare, ds.stencilFront.compare,
+                     ds.stencilFront.failOp, ds.stencilFront.depthFailOp, ds.stencilFront.passOp,
+                     ds.stencilBack.compare, ds.stencilBack.failOp, ds.stencilBack.depthFailOp,
+                     ds.stencilBack.passOp, ds.stencilReadMask, ds.stencilWriteMask, ds.depthBias,
+                     ds.depthBiasSlopeScale, ds.depthBiasClamp);
+    }
+
+    const MultisampleState& multisample = descriptor->multisample;
+    AppendValues(multisample.count, multisample.mask, multisample.alphaToCoverageEnabled);
+
+    bool hasFragment = descriptor->fragment != nullptr;
+    AppendValues(hasFragment);
+    if (hasFragment) {
+        const FragmentState& fragment = *descriptor->fragment;
+        if (fragment.nextInChain != nullptr) {
+            return false;
+        }
+        AppendValues(fragment.module);
+        AppendString(fragment.entryPoint);
+        AppendValues(fragment.constantCount);
+        for (uint32_t i = 0; i < fragment.constantCount; ++i) {
+            if (fragment.constants[i].nextInChain != nullptr) {
+                return false;
+            }
+            AppendString(fragment.constants[i].key);
+            AppendValues(fragment.constants[i].value);
+        }
+        AppendValues(fragment.targetCount);
+        for (uint32_t i = 0; i < fragment.targetCount; ++i) {
+            const ColorTargetState& target = fragment.targets[i];
+            if (target.nextInChain != nullptr) {
+                return false;
+            }
+            bool hasBlend = target.blend != nullptr;
+            AppendValues(target.format, target.writeMask, hasBlend);
+            if (hasBlend) {
+                AppendValues(target.blend->color.operation, target.blend->color.srcFactor,
+                             target.blend->color.dstFactor, target.blend->alpha.operation,
+                             target.blend->alpha.srcFactor, target.blend->alpha.dstFactor);
+            }
+        }
+    }
+
+    return true;
+}
+
 }  // anonymous namespace
 
 // DeviceBase
@@ -202,9 +322,11 @@ DeviceBase::DeviceBase(AdapterBase* adapter, const DeviceDescriptor* descriptor)
 
     mFormatTable = BuildFormatTable(this);
 
+#if !defined(DAWN_STRIP_DEBUG_LABELS)
     if (descriptor->label != nullptr && strlen(descriptor->label) != 0) {
         mLabel = descriptor->label;
     }
+#endif
 
     // Record the cache key from the properties. Note that currently, if a new extension
     // descriptor is added (and probably handled here), the cache key recording needs to be
@@ -257,6 +379,7 @@ MaybeError DeviceBase::Initialize(Ref<QueueBase> defaultQueue) {
     mCaches = std::make_unique<DeviceBase::Caches>();
     mErrorScopeStack = std::make_unique<ErrorScopeStack>();
     mDynamicUploader = std::make_unique<DynamicUploader>(this);
+    mReadbackBufferPool = std::make_unique<ReadbackBufferPool>(this);
     mCallbackTaskManager = std::make_unique<CallbackTaskManager>();
     mDeprecationWarnings = std::make_unique<DeprecationWarnings>();
     mInternalPipelineStore = std::make_unique<InternalPipelineStore>(this);
@@ -286,6 +409,16 @@ MaybeError DeviceBase::Initialize(Ref<QueueBase> defaultQueue) {
                         CreateShaderModule(&descriptor));
     }
 
+    if (IsToggleEnabled(Toggle::CaptureGPUTimeline) &&
+        IsFeatureEnabled(Feature::TimestampQuery)) {
+        mGPUTimelineCapture = std::make_unique<GPUTimelineCapture>(this);
+        DAWN_TRY(mGPUTimelineCapture->Initialize());
+    }
+
+    if (IsToggleEnabled(Toggle::EnableBackgroundDeviceTick)) {
+        mBackgroundTickThread = std::thread([this] { BackgroundTickThreadMain(); });
+    }
+
     return {};
 }
 
@@ -382,6 +515,21 @@ void DeviceBase::Destroy() {
     if (mState == State::Destroyed) {
         return;
     }
+    mIsShuttingDown = true;
+
+    // Stop the background tick thread before anything else so that the device cannot be ticked
+    // concurrently with its destruction. Joining from a callback fired by the tick thread
+    // itself would deadlock: destruction must happen on the application thread, which the
+    // enable_background_device_tick toggle documents.
+    if (mBackgroundTickThread.joinable()) {
+        ASSERT(std::this_thread::get_id() != mBackgroundTickThread.get_id());
+        {
+            std::lock_guard<std::mutex> lock(mBackgroundTickStateMutex);
+            mBackgroundTickShouldStop = true;
+        }
+        mBackgroundTickCondition.notify_one();
+        mBackgroundTickThread.join();
+    }
 
     // This function may be called re-entrantly inside APITick(). Tick triggers callbacks
     // inside which the application may destroy the device. Thus, we should be careful not
@@ -439,8 +587,8 @@ void DeviceBase::Destroy() {
             UNREACHABLE();
             break;
     }
-    ASSERT(mCompletedSerial == mLastSubmittedSerial);
-    ASSERT(mFutureSerial <= mCompletedSerial);
+    ASSERT(mCompletedSerial.load() == mLastSubmittedSerial.load());
+    ASSERT(mFutureSerial.load() <= mCompletedSerial.load());
 
     if (mState != State::BeingCreated) {
         // The GPU timeline is finished.
@@ -462,6 +610,8 @@ void DeviceBase::Destroy() {
     // Note: mQueue is not released here since the application may still get it after calling
     // Destroy() via APIGetQueue.
     mDynamicUploader = nullptr;
+    mReadbackBufferPool = nullptr;
+    mGPUTimelineCapture = nullptr;
     mEmptyBindGroupLayout = nullptr;
     mInternalPipelineStore = nullptr;
     mExternalTexturePlaceholderView = nullptr;
@@ -480,6 +630,13 @@ void DeviceBase::APIDestroy() {
 }
 
 void DeviceBase::HandleError(InternalErrorType type, const char* message) {
+    // Command recording on independent CommandEncoders defers errors into each encoder's
+    // EncodingContext so the hot path never reaches this function. When those encoders are
+    // finished (possibly from different threads), their deferred errors funnel here, so
+    // serialize the device-level handling. The mutex is recursive because the error
+    // callbacks below may re-enter the device and consume further errors.
+    std::lock_guard<std::recursive_mutex> lock(mErrorHandlingMutex);
+
     if (type == InternalErrorType::DeviceLost) {
         mState = State::Disconnected;
 
@@ -499,9 +656,8 @@ void DeviceBase::HandleError(InternalErrorType type, const char* message) {
         // backend objects can be freed immediately, before handling the loss.
 
         // Move away from the Alive state so that the application cannot use this device
-        // anymore.
-        // TODO(crbug.com/dawn/831): Do we need atomics for this to become visible to other
-        // threads in a multithreaded scenario?
+        // anymore. mState is atomic so the transition is visible to worker threads that are
+        // recording commands.
         mState = State::BeingDisconnected;
 
         // Ignore errors so that we can continue with destruction
@@ -509,7 +665,7 @@ void DeviceBase::HandleError(InternalErrorType type, const char* message) {
         IgnoreErrors(WaitForIdleForDestruction());
         IgnoreErrors(TickImpl());
         AssumeCommandsComplete();
-        ASSERT(mFutureSerial <= mCompletedSerial);
+        ASSERT(mFutureSerial.load() <= mCompletedSerial.load());
         mState = State::Disconnected;
 
         // Now everything is as if the device was lost.
@@ -703,6 +859,10 @@ dawn::platform::Platform* DeviceBase::GetPlatform() const {
     return GetAdapter()->GetInstance()->GetPlatform();
 }
 
+const PerformanceTuningProfile& DeviceBase::GetTuningProfile() const {
+    return GetAdapter()->GetTuningProfile();
+}
+
 ExecutionSerial DeviceBase::GetCompletedCommandSerial() const {
     return mCompletedSerial;
 }
@@ -720,37 +880,47 @@ InternalPipelineStore* DeviceBase::GetInternalPipelineStore() {
 }
 
 void DeviceBase::IncrementLastSubmittedCommandSerial() {
-    mLastSubmittedSerial++;
+    // Writes to the serial are serialized by the tick mutex, so a load followed by a store is
+    // not racy with other writers; the atomic only makes the unlocked reads well-defined.
+    mLastSubmittedSerial = mLastSubmittedSerial.load() + ExecutionSerial(1);
+
+    // Wake the background tick thread so it starts polling for the completion of this work.
+    if (mBackgroundTickThread.joinable()) {
+        mBackgroundTickCondition.notify_one();
+    }
 }
 
 void DeviceBase::AssumeCommandsComplete() {
-    ExecutionSerial maxSerial =
-        ExecutionSerial(std::max(mLastSubmittedSerial + ExecutionSerial(1), mFutureSerial));
+    ExecutionSerial maxSerial = ExecutionSerial(
+        std::max(mLastSubmittedSerial.load() + ExecutionSerial(1), mFutureSerial.load()));
     mLastSubmittedSerial = maxSerial;
     mCompletedSerial = maxSerial;
 }
 
-bool DeviceBase::IsDeviceIdle() {
-    if (mAsyncTaskManager->HasPendingTasks()) {
-        return false;
-    }
-    if (!mCallbackTaskManager->IsEmpty()) {
-        return false;
+bool DeviceBase::HasPendingWork() {
+    // Each source keeps its own cheap summary up to date at the points where work is enqueued
+    // and completed: atomic serials for GPU work, an atomic count for async tasks and an atomic
+    // head pointer for callback tasks. No mutex is taken.
+    ExecutionSerial completedSerial = mCompletedSerial.load();
+    if (mLastSubmittedSerial.load() > completedSerial || completedSerial < mFutureSerial.load()) {
+        return true;
     }
-
-    ExecutionSerial maxSerial = std::max(mLastSubmittedSerial, mFutureSerial);
-    if (mCompletedSerial == maxSerial) {
+    if (mAsyncTaskManager->HasPendingTasks()) {
         return true;
     }
-    return false;
+    return !mCallbackTaskManager->IsEmpty();
+}
+
+bool DeviceBase::IsDeviceIdle() {
+    return !HasPendingWork();
 }
 
 ExecutionSerial DeviceBase::GetPendingCommandSerial() const {
-    return mLastSubmittedSerial + ExecutionSerial(1);
+    return mLastSubmittedSerial.load() + ExecutionSerial(1);
 }
 
 void DeviceBase::AddFutureSerial(ExecutionSerial serial) {
-    if (serial > mFutureSerial) {
+    if (serial > mFutureSerial.load()) {
         mFutureSerial = serial;
     }
 }
@@ -759,12 +929,12 @@ MaybeError DeviceBase::CheckPassedSerials() {
     ExecutionSerial completedSerial;
     DAWN_TRY_ASSIGN(completedSerial, CheckAndUpdateCompletedSerials());
 
-    ASSERT(completedSerial <= mLastSubmittedSerial);
+    ASSERT(completedSerial <= mLastSubmittedSerial.load());
     // completedSerial should not be less than mCompletedSerial unless it is 0.
     // It can be 0 when there's no fences to check.
-    ASSERT(completedSerial >= mCompletedSerial || completedSerial == ExecutionSerial(0));
+    ASSERT(completedSerial >= mCompletedSerial.load() || completedSerial == ExecutionSerial(0));
 
-    if (completedSerial > mCompletedSerial) {
+    if (completedSerial > mCompletedSerial.load()) {
         mCompletedSerial = completedSerial;
     }
 
@@ -807,7 +977,9 @@ ResultOrError<Ref<BindGroupLayoutBase>> DeviceBase::GetOrCreateBindGroupLayout(
     auto iter = mCaches->bindGroupLayouts.find(&blueprint);
     if (iter != mCaches->bindGroupLayouts.end()) {
         result = *iter;
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheHits, 1);
     } else {
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheMisses, 1);
         DAWN_TRY_ASSIGN(result, CreateBindGroupLayoutImpl(descriptor, pipelineCompatibilityToken));
         result->SetIsCachedReference();
         result->SetContentHash(blueprintHash);
@@ -843,6 +1015,9 @@ Ref<ComputePipelineBase> DeviceBase::GetCachedComputePipeline(
     auto iter = mCaches->computePipelines.find(uninitializedComputePipeline);
     if (iter != mCaches->computePipelines.end()) {
         cachedPipeline = *iter;
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheHits, 1);
+    } else {
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheMisses, 1);
     }
 
     return cachedPipeline;
@@ -854,6 +1029,9 @@ Ref<RenderPipelineBase> DeviceBase::GetCachedRenderPipeline(
     auto iter = mCaches->renderPipelines.find(uninitializedRenderPipeline);
     if (iter != mCaches->renderPipelines.end()) {
         cachedPipeline = *iter;
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheHits, 1);
+    } else {
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheMisses, 1);
     }
     return cachedPipeline;
 }
@@ -880,6 +1058,19 @@ Ref<RenderPipelineBase> DeviceBase::AddOrGetCachedRenderPipeline(
     }
 }
 
+void DeviceBase::RegisterRenderPipelineFingerprint(std::string fingerprint,
+                                                   RenderPipelineBase* renderPipeline) {
+    // Only the first fingerprint to reach a pipeline is registered: UncacheRenderPipeline
+    // removes a single entry and pipelines deduplicated through the content-hash cache may
+    // be reachable under several serializations of the same state.
+    if (fingerprint.empty() || !renderPipeline->GetCacheFingerprint().empty()) {
+        return;
+    }
+    ASSERT(renderPipeline->IsCachedReference());
+    renderPipeline->SetCacheFingerprint(fingerprint);
+    mCaches->renderPipelineFingerprints.emplace(std::move(fingerprint), renderPipeline);
+}
+
 void DeviceBase::UncacheComputePipeline(ComputePipelineBase* obj) {
     ASSERT(obj->IsCachedReference());
     size_t removedCount = mCaches->computePipelines.erase(obj);
@@ -926,7 +1117,9 @@ ResultOrError<Ref<PipelineLayoutBase>> DeviceBase::GetOrCreatePipelineLayout(
     auto iter = mCaches->pipelineLayouts.find(&blueprint);
     if (iter != mCaches->pipelineLayouts.end()) {
         result = *iter;
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheHits, 1);
     } else {
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheMisses, 1);
         DAWN_TRY_ASSIGN(result, CreatePipelineLayoutImpl(descriptor));
         result->SetIsCachedReference();
         result->SetContentHash(blueprintHash);
@@ -942,8 +1135,27 @@ void DeviceBase::UncachePipelineLayout(PipelineLayoutBase* obj) {
     ASSERT(removedCount == 1);
 }
 
+const DefaultPipelineLayoutEntryData* DeviceBase::GetCachedDefaultPipelineLayoutEntries(
+    const std::string& fingerprint) const {
+    auto iter = mCaches->defaultPipelineLayoutEntries.find(fingerprint);
+    if (iter == mCaches->defaultPipelineLayoutEntries.end()) {
+        return nullptr;
+    }
+    return &iter->second;
+}
+
+void DeviceBase::CacheDefaultPipelineLayoutEntries(std::string fingerprint,
+                                                   DefaultPipelineLayoutEntryData entryData) {
+    mCaches->defaultPipelineLayoutEntries.emplace(std::move(fingerprint), std::move(entryData));
+}
+
 void DeviceBase::UncacheRenderPipeline(RenderPipelineBase* obj) {
     ASSERT(obj->IsCachedReference());
+    if (!obj->GetCacheFingerprint().empty()) {
+        size_t removedFingerprints =
+            mCaches->renderPipelineFingerprints.erase(obj->GetCacheFingerprint());
+        ASSERT(removedFingerprints == 1);
+    }
     size_t removedCount = mCaches->renderPipelines.erase(obj);
     ASSERT(removedCount == 1);
 }
@@ -959,7 +1171,9 @@ ResultOrError<Ref<SamplerBase>> DeviceBase::GetOrCreateSampler(
     auto iter = mCaches->samplers.find(&blueprint);
     if (iter != mCaches->samplers.end()) {
         result = *iter;
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheHits, 1);
     } else {
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheMisses, 1);
         DAWN_TRY_ASSIGN(result, CreateSamplerImpl(descriptor));
         result->SetIsCachedReference();
         result->SetContentHash(blueprintHash);
@@ -990,20 +1204,32 @@ ResultOrError<Ref<ShaderModuleBase>> DeviceBase::GetOrCreateShaderModule(
     auto iter = mCaches->shaderModules.find(&blueprint);
     if (iter != mCaches->shaderModules.end()) {
         result = *iter;
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheHits, 1);
     } else {
-        if (!parseResult->HasParsedShader()) {
-            // We skip the parse on creation if validation isn't enabled which let's us quickly
-            // lookup in the cache without validating and parsing. We need the parsed module
-            // now.
-            ASSERT(!IsValidationEnabled());
-            DAWN_TRY(
-                ValidateAndParseShaderModule(this, descriptor, parseResult, compilationMessages));
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheMisses, 1);
+        // The parse is deliberately not done before the cache lookup so that replayed shader
+        // sources only pay for the content hash. On a miss it either runs now, or with deferred
+        // parsing it runs on the async task manager and the module is returned immediately.
+        bool deferredParse = !parseResult->HasParsedShader() && IsValidationEnabled() &&
+                             CanDeferShaderModuleParse(this, descriptor, compilationMessages);
+        if (!parseResult->HasParsedShader() && !deferredParse) {
+            if (IsValidationEnabled()) {
+                DAWN_TRY_CONTEXT(ValidateAndParseShaderModule(this, descriptor, parseResult,
+                                                              compilationMessages),
+                                 "validating %s", descriptor);
+            } else {
+                DAWN_TRY(ValidateAndParseShaderModule(this, descriptor, parseResult,
+                                                      compilationMessages));
+            }
         }
         DAWN_TRY_ASSIGN(result,
                         CreateShaderModuleImpl(descriptor, parseResult, compilationMessages));
         result->SetIsCachedReference();
         result->SetContentHash(blueprintHash);
         mCaches->shaderModules.insert(result.Get());
+        if (deferredParse) {
+            result->BeginDeferredParse(compilationMessages);
+        }
     }
 
     return std::move(result);
@@ -1018,8 +1244,10 @@ void DeviceBase::UncacheShaderModule(ShaderModuleBase* obj) {
 Ref<AttachmentState> DeviceBase::GetOrCreateAttachmentState(AttachmentStateBlueprint* blueprint) {
     auto iter = mCaches->attachmentStates.find(blueprint);
     if (iter != mCaches->attachmentStates.end()) {
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheHits, 1);
         return static_cast<AttachmentState*>(*iter);
     }
+    dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheMisses, 1);
 
     Ref<AttachmentState> attachmentState = AcquireRef(new AttachmentState(this, *blueprint));
     attachmentState->SetIsCachedReference();
@@ -1249,19 +1477,38 @@ bool DeviceBase::APITick() {
         return false;
     }
 
+    // The hint telling the embedder whether another tick is needed is the same pending-work
+    // summary the idle fast path of Tick uses.
+    bool workRemaining = HasPendingWork();
     TRACE_EVENT1(GetPlatform(), General, "DeviceBase::APITick::IsDeviceIdle", "isDeviceIdle",
-                 IsDeviceIdle());
+                 !workRemaining);
 
-    return !IsDeviceIdle();
+    return workRemaining;
 }
 
 MaybeError DeviceBase::Tick() {
+    // Idle fast path: when nothing is pending anywhere, the tick is a handful of loads and no
+    // mutex is taken and no subsystem is walked. Work enqueued concurrently is picked up by a
+    // later tick; lost devices fall through so ValidateIsAlive still reports the error.
+    if (!IsLost() && !HasPendingWork()) {
+        return {};
+    }
+
+    // Serialize against the background tick thread, and against reentrant submissions from
+    // callbacks fired below.
+    std::lock_guard<std::recursive_mutex> lock(mTickMutex);
+
     DAWN_TRY(ValidateIsAlive());
 
+    // Texture writes batched by the batch_texture_writes toggle must be recorded before
+    // TickImpl submits the backend's pending commands.
+    DAWN_TRY(mQueue->FlushPendingTextureWrites());
+
     // to avoid overly ticking, we only want to tick when:
     // 1. the last submitted serial has moved beyond the completed serial
     // 2. or the completed serial has not reached the future serial set by the trackers
-    if (mLastSubmittedSerial > mCompletedSerial || mCompletedSerial < mFutureSerial) {
+    if (mLastSubmittedSerial.load() > mCompletedSerial.load() ||
+        mCompletedSerial.load() < mFutureSerial.load()) {
         DAWN_TRY(CheckPassedSerials());
         DAWN_TRY(TickImpl());
 
@@ -1269,15 +1516,17 @@ MaybeError DeviceBase::Tick() {
         // so that CPU operations waiting on GPU completion can know they don't have to wait.
         // AssumeCommandsComplete will assign the max serial we must tick to in order to
         // fire the awaiting callbacks.
-        if (mCompletedSerial == mLastSubmittedSerial) {
+        if (mCompletedSerial.load() == mLastSubmittedSerial.load()) {
             AssumeCommandsComplete();
         }
 
         // TODO(crbug.com/dawn/833): decouple TickImpl from updating the serial so that we can
         // tick the dynamic uploader before the backend resource allocators. This would allow
         // reclaiming resources one tick earlier.
-        mDynamicUploader->Deallocate(mCompletedSerial);
-        mQueue->Tick(mCompletedSerial);
+        ExecutionSerial completedSerial = mCompletedSerial.load();
+        mDynamicUploader->Deallocate(completedSerial);
+        mInternalPipelineStore->scratchPool.Tick(completedSerial);
+        mQueue->Tick(completedSerial);
     }
 
     // We have to check callback tasks in every Tick because it is not related to any global
@@ -1287,6 +1536,54 @@ MaybeError DeviceBase::Tick() {
     return {};
 }
 
+void DeviceBase::SetMemoryBudgetCallback(MemoryBudgetCallback callback, void* userdata) {
+    mMemoryBudgetCallback = callback;
+    mMemoryBudgetUserdata = userdata;
+}
+
+bool DeviceBase::HasMemoryBudgetCallback() const {
+    return mMemoryBudgetCallback != nullptr;
+}
+
+void DeviceBase::NotifyMemoryBudgetChanged(uint64_t currentUsage, uint64_t budget) {
+    if (mMemoryBudgetCallback == nullptr ||
+        (currentUsage == mLastReportedMemoryUsage && budget == mLastReportedMemoryBudget)) {
+        return;
+    }
+    mLastReportedMemoryUsage = currentUsage;
+    mLastReportedMemoryBudget = budget;
+    mMemoryBudgetCallback(currentUsage, budget, mMemoryBudgetUserdata);
+}
+
+void DeviceBase::ReduceMemoryUsage() {
+    std::lock_guard<std::recursive_mutex> lock(mTickMutex);
+    if (IsLost() || ConsumedError(Tick())) {
+        return;
+    }
+
+    // Tick recycled staging buffers whose serials completed back into the pools, so the pools
+    // are trimmed afterwards and those buffers are freed too instead of being kept for reuse.
+    mDynamicUploader->ReduceMemoryUsage();
+    mReadbackBufferPool->ReduceMemoryUsage();
+    ReduceMemoryUsageImpl();
+}
+
+void DeviceBase::ReduceMemoryUsageImpl() {}
+
+std::vector<AllocatorMemoryInfo> DeviceBase::GetMemoryReport() const {
+    std::vector<AllocatorMemoryInfo> report;
+    if (mDynamicUploader != nullptr) {
+        report.push_back(mDynamicUploader->GetMemoryInfo());
+    }
+    if (mReadbackBufferPool != nullptr) {
+        report.push_back(mReadbackBufferPool->GetMemoryInfo());
+    }
+    AppendMemoryReportImpl(&report);
+    return report;
+}
+
+void DeviceBase::AppendMemoryReportImpl(std::vector<AllocatorMemoryInfo>*) const {}
+
 AdapterBase* DeviceBase::APIGetAdapter() {
     mAdapter->Reference();
     return mAdapter.Get();
@@ -1355,6 +1652,14 @@ void DeviceBase::IncrementLazyClearCountForTesting() {
     ++mLazyClearCountForTesting;
 }
 
+uint64_t DeviceBase::GetSubmitValidationGeneration() const {
+    return mSubmitValidationGeneration.load();
+}
+
+void DeviceBase::IncrementSubmitValidationGeneration() {
+    mSubmitValidationGeneration++;
+}
+
 size_t DeviceBase::GetDeprecationWarningCountForTesting() {
     return mDeprecationWarnings->count;
 }
@@ -1623,6 +1928,20 @@ ResultOrError<Ref<RenderPipelineBase>> DeviceBase::CreateRenderPipeline(
         DAWN_TRY(ValidateRenderPipelineDescriptor(this, descriptor));
     }
 
+    // Fast path for duplicate creations: an exact match on the serialized descriptor bytes
+    // returns the cached pipeline without building an uninitialized backend pipeline and
+    // computing its content hash.
+    std::string fingerprint;
+    if (!SerializeRenderPipelineFingerprint(descriptor, &fingerprint)) {
+        fingerprint.clear();
+    }
+    if (!fingerprint.empty()) {
+        auto iter = mCaches->renderPipelineFingerprints.find(fingerprint);
+        if (iter != mCaches->renderPipelineFingerprints.end()) {
+            return Ref<RenderPipelineBase>(iter->second);
+        }
+    }
+
     // Ref will keep the pipeline layout alive until the end of the function where
     // the pipeline will take another reference.
     Ref<PipelineLayoutBase> layoutRef;
@@ -1635,12 +1954,13 @@ ResultOrError<Ref<RenderPipelineBase>> DeviceBase::CreateRenderPipeline(
 
     Ref<RenderPipelineBase> cachedRenderPipeline =
         GetCachedRenderPipeline(uninitializedRenderPipeline.Get());
-    if (cachedRenderPipeline != nullptr) {
-        return cachedRenderPipeline;
+    if (cachedRenderPipeline == nullptr) {
+        DAWN_TRY(uninitializedRenderPipeline->Initialize());
+        cachedRenderPipeline = AddOrGetCachedRenderPipeline(std::move(uninitializedRenderPipeline));
     }
 
-    DAWN_TRY(uninitializedRenderPipeline->Initialize());
-    return AddOrGetCachedRenderPipeline(std::move(uninitializedRenderPipeline));
+    RegisterRenderPipelineFingerprint(std::move(fingerprint), cachedRenderPipeline.Get());
+    return cachedRenderPipeline;
 }
 
 MaybeError DeviceBase::CreateRenderPipelineAsync(const RenderPipelineDescriptor* descriptor,
@@ -1651,6 +1971,22 @@ MaybeError DeviceBase::CreateRenderPipelineAsync(const RenderPipelineDescriptor*
         DAWN_TRY(ValidateRenderPipelineDescriptor(this, descriptor));
     }
 
+    // Fast path for duplicate creations, see CreateRenderPipeline.
+    std::string fingerprint;
+    if (!SerializeRenderPipelineFingerprint(descriptor, &fingerprint)) {
+        fingerprint.clear();
+    }
+    if (!fingerprint.empty()) {
+        auto iter = mCaches->renderPipelineFingerprints.find(fingerprint);
+        if (iter != mCaches->renderPipelineFingerprints.end()) {
+            Ref<RenderPipelineBase> fingerprintedRenderPipeline = iter->second;
+            // TODO(crbug.com/dawn/1122): Call callbacks only on wgpuInstanceProcessEvents
+            callback(WGPUCreatePipelineAsyncStatus_Success,
+                     ToAPI(fingerprintedRenderPipeline.Detach()), "", userdata);
+            return {};
+        }
+    }
+
     // Ref will keep the pipeline layout alive until the end of the function where
     // the pipeline will take another reference.
     Ref<PipelineLayoutBase> layoutRef;
@@ -1665,6 +2001,7 @@ MaybeError DeviceBase::CreateRenderPipelineAsync(const RenderPipelineDescriptor*
     Ref<RenderPipelineBase> cachedRenderPipeline =
         GetCachedRenderPipeline(uninitializedRenderPipeline.Get());
     if (cachedRenderPipeline != nullptr) {
+        RegisterRenderPipelineFingerprint(std::move(fingerprint), cachedRenderPipeline.Get());
         // TODO(crbug.com/dawn/1122): Call callbacks only on wgpuInstanceProcessEvents
         callback(WGPUCreatePipelineAsyncStatus_Success, ToAPI(cachedRenderPipeline.Detach()), "",
                  userdata);
@@ -1689,6 +2026,17 @@ ResultOrError<Ref<SamplerBase>> DeviceBase::CreateSampler(const SamplerDescripto
     return GetOrCreateSampler(descriptor);
 }
 
+// Deferred parsing only covers plain WGSL modules created by the application; internal
+// creations (no compilation messages) and SPIR-V modules keep the synchronous path.
+bool CanDeferShaderModuleParse(const DeviceBase* device,
+                               const ShaderModuleDescriptor* descriptor,
+                               const OwnedCompilationMessages* compilationMessages) {
+    return device->IsToggleEnabled(Toggle::DeferShaderModuleParsing) &&
+           compilationMessages != nullptr && descriptor->nextInChain != nullptr &&
+           descriptor->nextInChain->nextInChain == nullptr &&
+           descriptor->nextInChain->sType == wgpu::SType::ShaderModuleWGSLDescriptor;
+}
+
 ResultOrError<Ref<ShaderModuleBase>> DeviceBase::CreateShaderModule(
     const ShaderModuleDescriptor* descriptor,
     OwnedCompilationMessages* compilationMessages) {
@@ -1699,10 +2047,13 @@ ResultOrError<Ref<ShaderModuleBase>> DeviceBase::CreateShaderModule(
     // long as dawn_native don't use the compilationMessages of these internal shader modules.
     ShaderModuleParseResult parseResult;
 
+    // Only the cheap structural validation of the descriptor runs before the cache lookup in
+    // GetOrCreateShaderModule: a hit means an identical module already passed the full parse
+    // and validation, so resubmitted source only pays for the content hash. The full parse
+    // happens on a cache miss (possibly deferred to the async task manager).
     if (IsValidationEnabled()) {
-        DAWN_TRY_CONTEXT(
-            ValidateAndParseShaderModule(this, descriptor, &parseResult, compilationMessages),
-            "validating %s", descriptor);
+        DAWN_TRY_CONTEXT(ValidateShaderModuleDescriptorChain(descriptor), "validating %s",
+                         descriptor);
     }
 
     return GetOrCreateShaderModule(descriptor, &parseResult, compilationMessages);
@@ -1761,7 +2112,26 @@ ResultOrError<Ref<TextureViewBase>> DeviceBase::CreateTextureView(
         DAWN_TRY_CONTEXT(ValidateTextureViewDescriptor(this, texture, &desc),
                          "validating %s against %s.", &desc, texture);
     }
-    return CreateTextureViewImpl(texture, &desc);
+
+    // Intern the views of each texture: applications commonly re-request the same few views
+    // every frame, so hand out a new reference to the cached view instead of creating a
+    // duplicate backend object.
+    TextureViewBase blueprint(texture, &desc, ApiObjectBase::kUntrackedByDevice);
+    const size_t blueprintHash = blueprint.ComputeContentHash();
+    blueprint.SetContentHash(blueprintHash);
+
+    Ref<TextureViewBase> result = texture->GetCachedView(&blueprint);
+    if (result != nullptr) {
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheHits, 1);
+        return std::move(result);
+    }
+
+    dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheMisses, 1);
+    DAWN_TRY_ASSIGN(result, CreateTextureViewImpl(texture, &desc));
+    result->SetIsCachedReference();
+    result->SetContentHash(blueprintHash);
+    texture->CacheView(result.Get());
+    return std::move(result);
 }
 
 // Other implementation details
@@ -1770,6 +2140,14 @@ DynamicUploader* DeviceBase::GetDynamicUploader() const {
     return mDynamicUploader.get();
 }
 
+ReadbackBufferPool* DeviceBase::GetReadbackBufferPool() const {
+    return mReadbackBufferPool.get();
+}
+
+GPUTimelineCapture* DeviceBase::GetGPUTimelineCapture() const {
+    return mGPUTimelineCapture.get();
+}
+
 // The Toggle device facility
 
 std::vector<const char*> DeviceBase::GetTogglesUsed() const {
@@ -1834,6 +2212,45 @@ void DeviceBase::FlushCallbackTaskQueue() {
     }
 }
 
+void DeviceBase::BackgroundTickThreadMain() {
+    // How long to sleep between polls while commands are in flight. Low enough that readback
+    // callbacks fire with sub-frame latency, high enough that polling an in-flight submission
+    // doesn't burn a core.
+    static constexpr std::chrono::microseconds kBackgroundTickPeriod(100);
+
+    std::unique_lock<std::mutex> lock(mBackgroundTickStateMutex);
+    while (!mBackgroundTickShouldStop) {
+        // Wake up early when new work is submitted, otherwise poll: completion is signaled on
+        // a backend fence and there is no cross-backend way to block on it directly.
+        mBackgroundTickCondition.wait_for(lock, kBackgroundTickPeriod);
+        if (mBackgroundTickShouldStop) {
+            break;
+        }
+
+        // try_lock instead of lock so that this thread never delays device destruction:
+        // Destroy() can run while the tick mutex is held (from a callback fired during a tick
+        // on the application thread) and waits for this thread to exit.
+        if (!mTickMutex.try_lock()) {
+            continue;
+        }
+        if (mState == State::Alive &&
+            (mLastSubmittedSerial.load() > mCompletedSerial.load() ||
+             mCompletedSerial.load() < mFutureSerial.load() ||
+             !mCallbackTaskManager->IsEmpty())) {
+            // Tick may fire callbacks which drop the last reference to the device. Hold a Ref
+            // to ourselves so |this| is not deleted in the middle of this function, as in
+            // APITick().
+            Ref<DeviceBase> self(this);
+            ConsumedError(Tick());
+        }
+        mTickMutex.unlock();
+    }
+}
+
+std::recursive_mutex& DeviceBase::GetTickMutex() {
+    return mTickMutex;
+}
+
 const CombinedLimits& DeviceBase::GetLimits() const {
     return mLimits;
 }
@@ -1850,6 +2267,45 @@ dawn::platform::WorkerTaskPool* DeviceBase::GetWorkerTaskPool() const {
     return mWorkerTaskPool.get();
 }
 
+void DeviceBase::DeferCommandDestruction(CommandIterator commands) {
+    // Walking every command to run its destructor is O(recorded commands) and shows up as a
+    // spike on the thread that drops the last reference, typically right at frame end. Once
+    // teardown has started the callback task queue is being drained for the last time, so
+    // destroy the commands in place instead of posting work nothing will flush.
+    if (mState != State::Alive || mIsShuttingDown) {
+        FreeCommands(&commands);
+        return;
+    }
+
+    // The command destructors drop Refs that may be the last reference to backend resources,
+    // and backend DestroyImpls must not run on an arbitrary thread without the device lock.
+    // Like AddObjectKeepaliveCallbackTask, hand the commands to the callback task queue: the walk
+    // then runs during the next callback flush on the thread that ticks the device, where
+    // final releases are safe, instead of on the thread that released the command buffer.
+    struct FreeCommandsCallbackTask : CallbackTask {
+        explicit FreeCommandsCallbackTask(CommandIterator commands)
+            : commands(std::move(commands)) {}
+        void Finish() override { FreeCommands(&commands); }
+        void HandleShutDown() override { FreeCommands(&commands); }
+        void HandleDeviceLoss() override { FreeCommands(&commands); }
+        CommandIterator commands;
+    };
+    mCallbackTaskManager->AddCallbackTask(
+        std::make_unique<FreeCommandsCallbackTask>(std::move(commands)));
+}
+
+void DeviceBase::AddObjectKeepaliveCallbackTask(Ref<ApiObjectBase> object) {
+    struct KeepaliveCallbackTask : CallbackTask {
+        explicit KeepaliveCallbackTask(Ref<ApiObjectBase> object) : object(std::move(object)) {}
+        void Finish() override {}
+        void HandleShutDown() override {}
+        void HandleDeviceLoss() override {}
+        Ref<ApiObjectBase> object;
+    };
+    mCallbackTaskManager->AddCallbackTask(
+        std::make_unique<KeepaliveCallbackTask>(std::move(object)));
+}
+
 void DeviceBase::AddComputePipelineAsyncCallbackTask(
     Ref<ComputePipelineBase> pipeline,
     std::string errorMessage,
@@ -1917,8 +2373,10 @@ const std::string& DeviceBase::GetLabel() const {
 }
 
 void DeviceBase::APISetLabel(const char* label) {
+#if !defined(DAWN_STRIP_DEBUG_LABELS)
     mLabel = label;
     SetLabelImpl();
+#endif
 }
 
 void DeviceBase::SetLabelImpl() {}
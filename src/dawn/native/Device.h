@@ -15,9 +15,12 @@
 #ifndef SRC_DAWN_NATIVE_DEVICE_H_
 #define SRC_DAWN_NATIVE_DEVICE_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -51,10 +54,15 @@ class AttachmentStateBlueprint;
 class Blob;
 class BlobCache;
 class CallbackTaskManager;
+class CommandIterator;
 class DynamicUploader;
 class ErrorScopeStack;
+class GPUTimelineCapture;
 class OwnedCompilationMessages;
+class ReadbackBufferPool;
 struct CallbackTask;
+struct DefaultPipelineLayoutEntryData;
+struct PerformanceTuningProfile;
 struct InternalPipelineStore;
 struct ShaderModuleParseResult;
 
@@ -134,6 +142,10 @@ class DeviceBase : public RefCountedWithExternalCount {
     AdapterBase* GetAdapter() const;
     dawn::platform::Platform* GetPlatform() const;
 
+    // Allocator and pool sizes tuned for the adapter's hardware class, see
+    // PerformanceTuning.h.
+    const PerformanceTuningProfile& GetTuningProfile() const;
+
     // Returns the Format corresponding to the wgpu::TextureFormat or an error if the format
     // isn't a valid wgpu::TextureFormat or isn't supported by this device.
     // The pointer returned has the same lifetime as the device.
@@ -183,6 +195,13 @@ class DeviceBase : public RefCountedWithExternalCount {
         const PipelineLayoutDescriptor* descriptor);
     void UncachePipelineLayout(PipelineLayoutBase* obj);
 
+    // Memo of the entry tables that default pipeline layout inference produced for a set of
+    // entry points, keyed on their serialized identity (see PipelineLayoutBase::CreateDefault).
+    const DefaultPipelineLayoutEntryData* GetCachedDefaultPipelineLayoutEntries(
+        const std::string& fingerprint) const;
+    void CacheDefaultPipelineLayoutEntries(std::string fingerprint,
+                                           DefaultPipelineLayoutEntryData entryData);
+
     void UncacheRenderPipeline(RenderPipelineBase* obj);
 
     ResultOrError<Ref<SamplerBase>> GetOrCreateSampler(const SamplerDescriptor* descriptor);
@@ -306,6 +325,11 @@ class DeviceBase : public RefCountedWithExternalCount {
                                                 const Extent3D& copySizePixels) = 0;
 
     DynamicUploader* GetDynamicUploader() const;
+    ReadbackBufferPool* GetReadbackBufferPool() const;
+
+    // Returns the GPU timeline capture, or nullptr when the capture_gpu_timeline toggle is off
+    // or the timestamp-query feature is unavailable.
+    GPUTimelineCapture* GetGPUTimelineCapture() const;
 
     // The device state which is a combination of creation state and loss state.
     //
@@ -339,6 +363,12 @@ class DeviceBase : public RefCountedWithExternalCount {
     bool IsRobustnessEnabled() const;
     size_t GetLazyClearCountForTesting();
     void IncrementLazyClearCountForTesting();
+
+    // Generation counter backing the queue submit validation cache. It is incremented whenever
+    // a resource enters a state that is invalid to use in a submit (it is destroyed or
+    // mapped), which invalidates every command buffer's cached validation verdict.
+    uint64_t GetSubmitValidationGeneration() const;
+    void IncrementSubmitValidationGeneration();
     size_t GetDeprecationWarningCountForTesting();
     void EmitDeprecationWarning(const char* warning);
     void EmitLog(const char* message);
@@ -359,6 +389,19 @@ class DeviceBase : public RefCountedWithExternalCount {
 
     MaybeError Tick();
 
+    // Memory budget notifications and proactive reclamation, see the homonymous functions in
+    // DawnNative.h. NotifyMemoryBudgetChanged is called by backends whenever they observe a
+    // usage/budget pair and forwards it to the embedder callback when the values changed.
+    void SetMemoryBudgetCallback(MemoryBudgetCallback callback, void* userdata);
+    bool HasMemoryBudgetCallback() const;
+    void NotifyMemoryBudgetChanged(uint64_t currentUsage, uint64_t budget);
+    void ReduceMemoryUsage();
+
+    // Per-allocator breakdown of the memory the device holds, see GetMemoryReport in
+    // DawnNative.h. Collects the frontend allocators and then lets the backend append its own
+    // through AppendMemoryReportImpl.
+    std::vector<AllocatorMemoryInfo> GetMemoryReport() const;
+
     // TODO(crbug.com/dawn/839): Organize the below backend-specific parameters into the struct
     // BackendMetadata that we can query from the device.
     virtual uint32_t GetOptimalBytesPerRowAlignment() const = 0;
@@ -385,6 +428,21 @@ class DeviceBase : public RefCountedWithExternalCount {
     CallbackTaskManager* GetCallbackTaskManager() const;
     dawn::platform::WorkerTaskPool* GetWorkerTaskPool() const;
 
+    // Serializes GPU-completion bookkeeping (ticks, queue submission, in-flight task tracking)
+    // between the application thread and the background tick thread, see
+    // Toggle::EnableBackgroundDeviceTick. Uncontended when the toggle is off.
+    std::recursive_mutex& GetTickMutex();
+
+    // Keeps the object referenced until the callback task queue is flushed on the main
+    // thread, so that a worker thread never performs the final release of an API object.
+    void AddObjectKeepaliveCallbackTask(Ref<ApiObjectBase> object);
+
+    // Hands a detached command stream to the callback task queue so that releasing the last
+    // reference to a command buffer or encoder stays O(1) on the calling thread. The command
+    // destructors may perform the final release of backend resources, so they run during the
+    // callback flush on the thread that ticks the device, never on a worker thread. Falls back
+    // to destroying the commands in place while the device is shutting down.
+    void DeferCommandDestruction(CommandIterator commands);
     void AddComputePipelineAsyncCallbackTask(Ref<ComputePipelineBase> pipeline,
                                              std::string errorMessage,
                                              WGPUCreateComputePipelineAsyncCallback callback,
@@ -417,6 +475,15 @@ class DeviceBase : public RefCountedWithExternalCount {
     // Incrememt mLastSubmittedSerial when we submit the next serial
     void IncrementLastSubmittedCommandSerial();
 
+    // Protected so that backends overriding these with an async version can still fall back to
+    // the synchronous implementation below.
+    virtual void InitializeComputePipelineAsyncImpl(Ref<ComputePipelineBase> computePipeline,
+                                                    WGPUCreateComputePipelineAsyncCallback callback,
+                                                    void* userdata);
+    virtual void InitializeRenderPipelineAsyncImpl(Ref<RenderPipelineBase> renderPipeline,
+                                                   WGPUCreateRenderPipelineAsyncCallback callback,
+                                                   void* userdata);
+
   private:
     void WillDropLastExternalRef() override;
 
@@ -457,7 +524,14 @@ class DeviceBase : public RefCountedWithExternalCount {
     virtual void SetLabelImpl();
 
     virtual MaybeError TickImpl() = 0;
+    // Backend hook for ReduceMemoryUsage, overridden to drop backend-owned pools (for example
+    // pooled resource heaps). Defaults to doing nothing.
+    virtual void ReduceMemoryUsageImpl();
+    // Backend hook for GetMemoryReport, overridden to append entries for the backend-owned
+    // allocators (resource heaps, descriptor heaps). Defaults to appending nothing.
+    virtual void AppendMemoryReportImpl(std::vector<AllocatorMemoryInfo>* report) const;
     void FlushCallbackTaskQueue();
+    void BackgroundTickThreadMain();
 
     ResultOrError<Ref<BindGroupLayoutBase>> CreateEmptyBindGroupLayout();
 
@@ -468,13 +542,9 @@ class DeviceBase : public RefCountedWithExternalCount {
     Ref<ComputePipelineBase> AddOrGetCachedComputePipeline(
         Ref<ComputePipelineBase> computePipeline);
     Ref<RenderPipelineBase> AddOrGetCachedRenderPipeline(Ref<RenderPipelineBase> renderPipeline);
+    void RegisterRenderPipelineFingerprint(std::string fingerprint,
+                                           RenderPipelineBase* renderPipeline);
     virtual Ref<PipelineCacheBase> GetOrCreatePipelineCacheImpl(const CacheKey& key);
-    virtual void InitializeComputePipelineAsyncImpl(Ref<ComputePipelineBase> computePipeline,
-                                                    WGPUCreateComputePipelineAsyncCallback callback,
-                                                    void* userdata);
-    virtual void InitializeRenderPipelineAsyncImpl(Ref<RenderPipelineBase> renderPipeline,
-                                                   WGPUCreateRenderPipelineAsyncCallback callback,
-                                                   void* userdata);
 
     void ApplyToggleOverrides(const DawnTogglesDeviceDescriptor* togglesDescriptor);
     void ApplyFeatures(const DeviceDescriptor* deviceDescriptor);
@@ -492,6 +562,10 @@ class DeviceBase : public RefCountedWithExternalCount {
     // and waiting on a serial that doesn't have a corresponding fence enqueued. Fake serials to
     // make all commands look completed.
     void AssumeCommandsComplete();
+    // Summarizes every source of work that Tick services — GPU work in flight, async tasks on
+    // the worker pool and callback tasks awaiting a flush — as a handful of loads with no
+    // locking, so callers can skip an idle tick and embedders can stop polling.
+    bool HasPendingWork();
     bool IsDeviceIdle();
 
     // mCompletedSerial tracks the last completed command serial that the fence has returned.
@@ -502,9 +576,13 @@ class DeviceBase : public RefCountedWithExternalCount {
     // stale serials.
     // mFutureSerial tracks the largest serial we need to tick to for asynchronous commands or
     // callbacks to fire
-    ExecutionSerial mCompletedSerial = ExecutionSerial(0);
-    ExecutionSerial mLastSubmittedSerial = ExecutionSerial(0);
-    ExecutionSerial mFutureSerial = ExecutionSerial(0);
+    // The serials are atomic because HasPendingWork and the idle fast path in APITick read them
+    // without holding the tick mutex while the background tick thread (when the
+    // enable_background_device_tick toggle is on) advances mCompletedSerial under it. All writes
+    // are still serialized by the tick mutex.
+    std::atomic<ExecutionSerial> mCompletedSerial = ExecutionSerial(0);
+    std::atomic<ExecutionSerial> mLastSubmittedSerial = ExecutionSerial(0);
+    std::atomic<ExecutionSerial> mFutureSerial = ExecutionSerial(0);
 
     // DestroyImpl is used to clean up and release resources used by device, does not wait for
     // GPU or check errors.
@@ -525,6 +603,13 @@ class DeviceBase : public RefCountedWithExternalCount {
     wgpu::DeviceLostCallback mDeviceLostCallback = nullptr;
     void* mDeviceLostUserdata = nullptr;
 
+    // The last usage/budget pair reported to the embedder, used to suppress notifications when
+    // nothing changed since backends re-query the budget on every tick.
+    MemoryBudgetCallback mMemoryBudgetCallback = nullptr;
+    void* mMemoryBudgetUserdata = nullptr;
+    uint64_t mLastReportedMemoryUsage = 0;
+    uint64_t mLastReportedMemoryBudget = 0;
+
     std::unique_ptr<ErrorScopeStack> mErrorScopeStack;
 
     Ref<AdapterBase> mAdapter;
@@ -539,13 +624,41 @@ class DeviceBase : public RefCountedWithExternalCount {
     Ref<TextureViewBase> mExternalTexturePlaceholderView;
 
     std::unique_ptr<DynamicUploader> mDynamicUploader;
+    std::unique_ptr<ReadbackBufferPool> mReadbackBufferPool;
+    std::unique_ptr<GPUTimelineCapture> mGPUTimelineCapture;
     std::unique_ptr<AsyncTaskManager> mAsyncTaskManager;
     Ref<QueueBase> mQueue;
 
     struct DeprecationWarnings;
     std::unique_ptr<DeprecationWarnings> mDeprecationWarnings;
 
-    State mState = State::BeingCreated;
+    // The device state may be read from worker threads that record commands on independent
+    // CommandEncoders, so it is stored atomically. Writes only happen on error/destruction
+    // paths which are serialized by mErrorHandlingMutex.
+    std::atomic<State> mState = State::BeingCreated;
+
+    // Set at the start of Destroy(). mState only becomes Disconnected partway through
+    // destruction, and work must not be posted to the worker pool once the pending tasks have
+    // been drained, so teardown paths check this flag instead of mState.
+    std::atomic<bool> mIsShuttingDown = false;
+
+    // Serializes device-level error handling so that encoders finished on different threads
+    // can report errors concurrently. Recursive because error callbacks may re-enter the
+    // device and consume further errors.
+    std::recursive_mutex mErrorHandlingMutex;
+
+    // Serializes ticks against submissions and in-flight task tracking when the background
+    // tick thread is running. Recursive because callbacks fired during a tick may re-enter
+    // Queue::Submit or Buffer::MapAsync, which take the mutex again on the same thread.
+    std::recursive_mutex mTickMutex;
+
+    // The background tick thread, only started when Toggle::EnableBackgroundDeviceTick is on.
+    // The condition variable is notified on submission so the thread starts polling for the
+    // completion of the new work, and on shutdown so it exits promptly.
+    std::thread mBackgroundTickThread;
+    std::mutex mBackgroundTickStateMutex;
+    std::condition_variable mBackgroundTickCondition;
+    bool mBackgroundTickShouldStop = false;
 
     // Encompasses the mutex and the actual list that contains all live objects "owned" by the
     // device.
@@ -561,6 +674,8 @@ class DeviceBase : public RefCountedWithExternalCount {
     TogglesSet mOverridenToggles;
     size_t mLazyClearCountForTesting = 0;
     std::atomic_uint64_t mNextPipelineCompatibilityToken;
+    // Starts at 1 so that a command buffer's zero-initialized cached generation never matches.
+    std::atomic_uint64_t mSubmitValidationGeneration{1};
 
     CombinedLimits mLimits;
     FeaturesSet mEnabledFeatures;
@@ -14,33 +14,71 @@
 
 #include "dawn/native/DynamicUploader.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "dawn/common/Math.h"
 #include "dawn/native/Device.h"
+#include "dawn/native/PerformanceTuning.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
 
 namespace dawn::native {
 
-DynamicUploader::DynamicUploader(DeviceBase* device) : mDevice(device) {
-    mRingBuffers.emplace_back(
-        std::unique_ptr<RingBuffer>(new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
+DynamicUploader::DynamicUploader(DeviceBase* device)
+    : mDevice(device), mRingBufferSize(device->GetTuningProfile().uploaderRingBufferSize) {
+    mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
+        new RingBuffer{nullptr, RingBufferAllocator(mRingBufferSize)}));
+}
+
+ResultOrError<std::unique_ptr<StagingBufferBase>> DynamicUploader::AcquireStagingBuffer(
+    uint64_t size) {
+    // Best-fit: reuse the smallest pooled buffer large enough for the request. Buffers are
+    // created with power-of-two sizes so that recycled buffers fall in a small number of size
+    // classes.
+    size_t bestIndex = mFreeStagingBuffers.size();
+    for (size_t i = 0; i < mFreeStagingBuffers.size(); ++i) {
+        const uint64_t bufferSize = mFreeStagingBuffers[i]->GetSize();
+        if (bufferSize >= size && (bestIndex == mFreeStagingBuffers.size() ||
+                                   bufferSize < mFreeStagingBuffers[bestIndex]->GetSize())) {
+            bestIndex = i;
+        }
+    }
+    if (bestIndex < mFreeStagingBuffers.size()) {
+        std::unique_ptr<StagingBufferBase> stagingBuffer =
+            std::move(mFreeStagingBuffers[bestIndex]);
+        mFreeStagingBuffers.erase(mFreeStagingBuffers.begin() + bestIndex);
+        mFreeStagingBuffersSize -= stagingBuffer->GetSize();
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::StagingBufferPoolHits, 1);
+        return std::move(stagingBuffer);
+    }
+
+    dawn::platform::AddMetric(dawn::platform::MetricCounter::StagingBufferPoolMisses, 1);
+    std::unique_ptr<StagingBufferBase> stagingBuffer;
+    DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateStagingBuffer(NextPowerOfTwo(size)));
+    return std::move(stagingBuffer);
 }
 
 void DynamicUploader::ReleaseStagingBuffer(std::unique_ptr<StagingBufferBase> stagingBuffer) {
-    mReleasedStagingBuffers.Enqueue(std::move(stagingBuffer), mDevice->GetPendingCommandSerial());
+    mInFlightStagingBuffers.Enqueue(std::move(stagingBuffer), mDevice->GetPendingCommandSerial());
+    UpdatePeakUsage();
 }
 
 ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocationSize,
                                                               ExecutionSerial serial) {
-    // Disable further sub-allocation should the request be too large.
-    if (allocationSize > kRingBufferSize) {
+    // Disable further sub-allocation should the request be too large even for a grown ring.
+    // These requests get a dedicated staging buffer, taken from the pool of recycled ones when
+    // possible.
+    if (allocationSize > kMaxRingBufferSize) {
         std::unique_ptr<StagingBufferBase> stagingBuffer;
-        DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateStagingBuffer(allocationSize));
+        DAWN_TRY_ASSIGN(stagingBuffer, AcquireStagingBuffer(allocationSize));
 
         UploadHandle uploadHandle;
         uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
         uploadHandle.stagingBuffer = stagingBuffer.get();
 
+        // The handle's commands execute on the pending serial, so releasing now keeps the
+        // buffer alive exactly until they complete.
         ReleaseStagingBuffer(std::move(stagingBuffer));
         return uploadHandle;
     }
@@ -65,11 +103,13 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
         startOffset = targetRingBuffer->mAllocator.Allocate(allocationSize, serial);
     }
 
-    // Upon failure, append a newly created ring buffer to fulfill the
-    // request.
+    // Upon failure, append a newly created ring buffer to fulfill the request. The new ring is
+    // grown to the size class of the request so that repeated large uploads (e.g. texture
+    // streaming) stay sub-allocated in a persistent ring instead of each creating a buffer.
     if (startOffset == RingBufferAllocator::kInvalidOffset) {
+        const uint64_t ringBufferSize = std::max(mRingBufferSize, NextPowerOfTwo(allocationSize));
         mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
-            new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
+            new RingBuffer{nullptr, RingBufferAllocator(ringBufferSize)}));
 
         targetRingBuffer = mRingBuffers.back().get();
         startOffset = targetRingBuffer->mAllocator.Allocate(allocationSize, serial);
@@ -94,22 +134,51 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
         static_cast<uint8_t*>(uploadHandle.stagingBuffer->GetMappedPointer()) + startOffset;
     uploadHandle.startOffset = startOffset;
 
+    UpdatePeakUsage();
     return uploadHandle;
 }
 
 void DynamicUploader::Deallocate(ExecutionSerial lastCompletedSerial) {
     // Reclaim memory within the ring buffers by ticking (or removing requests no longer
-    // in-flight).
+    // in-flight). Never erase the largest buffer as to prevent re-creating smaller buffers
+    // again. With the growth policy the largest ring isn't necessarily the last one.
+    size_t largestRingIndex = 0;
+    for (size_t i = 0; i < mRingBuffers.size(); ++i) {
+        if (mRingBuffers[i]->mAllocator.GetSize() >=
+            mRingBuffers[largestRingIndex]->mAllocator.GetSize()) {
+            largestRingIndex = i;
+        }
+    }
     for (size_t i = 0; i < mRingBuffers.size(); ++i) {
         mRingBuffers[i]->mAllocator.Deallocate(lastCompletedSerial);
 
-        // Never erase the last buffer as to prevent re-creating smaller buffers
-        // again. The last buffer is the largest.
-        if (mRingBuffers[i]->mAllocator.Empty() && i < mRingBuffers.size() - 1) {
+        if (mRingBuffers[i]->mAllocator.Empty() && i != largestRingIndex) {
             mRingBuffers.erase(mRingBuffers.begin() + i);
+            if (i < largestRingIndex) {
+                largestRingIndex--;
+            }
+        }
+    }
+    // Recycle the dedicated staging buffers whose commands completed into the reuse pool,
+    // destroying them instead once the pool budget is reached.
+    for (std::unique_ptr<StagingBufferBase>& stagingBuffer :
+         mInFlightStagingBuffers.IterateUpTo(lastCompletedSerial)) {
+        if (mFreeStagingBuffersSize + stagingBuffer->GetSize() > kMaxFreeStagingBufferPoolSize) {
+            continue;
         }
+        mFreeStagingBuffersSize += stagingBuffer->GetSize();
+        mFreeStagingBuffers.push_back(std::move(stagingBuffer));
     }
-    mReleasedStagingBuffers.ClearUpTo(lastCompletedSerial);
+    mInFlightStagingBuffers.ClearUpTo(lastCompletedSerial);
+    TRACE_EVENT1(mDevice->GetPlatform(), General, "DynamicUploader::Deallocate", "pooledBytes",
+                 mFreeStagingBuffersSize);
+}
+
+void DynamicUploader::ReduceMemoryUsage() {
+    // In-flight buffers and the rings are left alone: they are gated on command completion and
+    // the next Deallocate with everything completed shrinks the rings down to the largest one.
+    mFreeStagingBuffers.clear();
+    mFreeStagingBuffersSize = 0;
 }
 
 // TODO(dawn:512): Optimize this function so that it doesn't allocate additional memory
@@ -118,6 +187,8 @@ ResultOrError<UploadHandle> DynamicUploader::Allocate(uint64_t allocationSize,
                                                       ExecutionSerial serial,
                                                       uint64_t offsetAlignment) {
     ASSERT(offsetAlignment > 0);
+    dawn::platform::AddMetric(dawn::platform::MetricCounter::StagingBytesAllocated,
+                              allocationSize);
     UploadHandle uploadHandle;
     DAWN_TRY_ASSIGN(uploadHandle, AllocateInternal(allocationSize + offsetAlignment - 1, serial));
     uint64_t additionalOffset =
@@ -126,4 +197,42 @@ ResultOrError<UploadHandle> DynamicUploader::Allocate(uint64_t allocationSize,
     uploadHandle.startOffset += additionalOffset;
     return uploadHandle;
 }
+
+uint64_t DynamicUploader::ComputeUsedMemory() const {
+    uint64_t usedMemory = 0;
+    for (const auto& ringBuffer : mRingBuffers) {
+        // The backing staging buffer of a ring is created lazily, so an unbacked ring doesn't
+        // occupy memory yet.
+        if (ringBuffer->mStagingBuffer != nullptr) {
+            usedMemory += ringBuffer->mAllocator.GetUsedSize();
+        }
+    }
+    for (const std::unique_ptr<StagingBufferBase>& stagingBuffer :
+         mInFlightStagingBuffers.IterateAll()) {
+        usedMemory += stagingBuffer->GetSize();
+    }
+    return usedMemory;
+}
+
+void DynamicUploader::UpdatePeakUsage() {
+    mPeakUsedMemory = std::max(mPeakUsedMemory, ComputeUsedMemory());
+}
+
+AllocatorMemoryInfo DynamicUploader::GetMemoryInfo() const {
+    AllocatorMemoryInfo info;
+    info.name = "upload staging";
+    for (const auto& ringBuffer : mRingBuffers) {
+        if (ringBuffer->mStagingBuffer != nullptr) {
+            info.reservedMemory += ringBuffer->mAllocator.GetSize();
+        }
+    }
+    for (const std::unique_ptr<StagingBufferBase>& stagingBuffer :
+         mInFlightStagingBuffers.IterateAll()) {
+        info.reservedMemory += stagingBuffer->GetSize();
+    }
+    info.reservedMemory += mFreeStagingBuffersSize;
+    info.usedMemory = ComputeUsedMemory();
+    info.peakUsedMemory = mPeakUsedMemory;
+    return info;
+}
 }  // namespace dawn::native
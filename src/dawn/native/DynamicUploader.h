@@ -18,6 +18,7 @@
 #include <memory>
 #include <vector>
 
+#include "dawn/native/DawnNative.h"
 #include "dawn/native/Forward.h"
 #include "dawn/native/IntegerTypes.h"
 #include "dawn/native/RingBufferAllocator.h"
@@ -38,10 +39,14 @@ class DynamicUploader {
     explicit DynamicUploader(DeviceBase* device);
     ~DynamicUploader() = default;
 
-    // We add functions to Release StagingBuffers to the DynamicUploader as there's
-    // currently no place to track the allocated staging buffers such that they're freed after
-    // pending commands are finished. This should be changed when better resource allocation is
-    // implemented.
+    // Returns a mapped staging buffer at least `size` bytes large, reusing a pooled buffer of
+    // a matching size class when one is available instead of paying a native allocation and
+    // map call. Pass the buffer back with ReleaseStagingBuffer once the last commands reading
+    // from it are enqueued.
+    ResultOrError<std::unique_ptr<StagingBufferBase>> AcquireStagingBuffer(uint64_t size);
+
+    // Gates the staging buffer on the pending command serial, then recycles it into the reuse
+    // pool (or destroys it, once the pool budget is reached) when those commands complete.
     void ReleaseStagingBuffer(std::unique_ptr<StagingBufferBase> stagingBuffer);
 
     ResultOrError<UploadHandle> Allocate(uint64_t allocationSize,
@@ -49,8 +54,21 @@ class DynamicUploader {
                                          uint64_t offsetAlignment);
     void Deallocate(ExecutionSerial lastCompletedSerial);
 
+    // Frees the pooled staging buffers that are not gated on in-flight commands, see
+    // DeviceBase::ReduceMemoryUsage.
+    void ReduceMemoryUsage();
+
+    // Snapshot of the staging memory held by the rings and the staging buffer pool, see
+    // DeviceBase::GetMemoryReport. Dedicated staging buffers checked out through
+    // AcquireStagingBuffer are counted once they are released back.
+    AllocatorMemoryInfo GetMemoryInfo() const;
+
   private:
-    static constexpr uint64_t kRingBufferSize = 4 * 1024 * 1024;
+    // Largest ring the growth policy creates. Requests beyond this get a dedicated staging
+    // buffer that is recycled through mFreeStagingBuffers once its commands complete.
+    static constexpr uint64_t kMaxRingBufferSize = 64 * 1024 * 1024;
+    // Total size of the recycled staging buffers kept around for reuse.
+    static constexpr uint64_t kMaxFreeStagingBufferPoolSize = 4 * kMaxRingBufferSize;
 
     struct RingBuffer {
         std::unique_ptr<StagingBufferBase> mStagingBuffer;
@@ -59,9 +77,21 @@ class DynamicUploader {
 
     ResultOrError<UploadHandle> AllocateInternal(uint64_t allocationSize, ExecutionSerial serial);
 
+    // Memory occupied by the backed rings and the in-flight staging buffers.
+    uint64_t ComputeUsedMemory() const;
+    void UpdatePeakUsage();
+
     std::vector<std::unique_ptr<RingBuffer>> mRingBuffers;
-    SerialQueue<ExecutionSerial, std::unique_ptr<StagingBufferBase>> mReleasedStagingBuffers;
+    // Dedicated staging buffers (ring overflows and mappedAtCreation uploads), kept here while
+    // their commands are in flight and then pooled by size class instead of being destroyed.
+    SerialQueue<ExecutionSerial, std::unique_ptr<StagingBufferBase>> mInFlightStagingBuffers;
+    std::vector<std::unique_ptr<StagingBufferBase>> mFreeStagingBuffers;
+    uint64_t mFreeStagingBuffersSize = 0;
+    uint64_t mPeakUsedMemory = 0;
     DeviceBase* mDevice;
+    // Size of the initial ring, and of the additional rings serving small allocations,
+    // typically uniform data. Taken from the adapter's tuning profile.
+    const uint64_t mRingBufferSize;
 };
 }  // namespace dawn::native
 
@@ -21,6 +21,8 @@
 #include "dawn/native/ErrorData.h"
 #include "dawn/native/IndirectDrawValidationEncoder.h"
 #include "dawn/native/RenderBundleEncoder.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
 
 namespace dawn::native {
 
@@ -39,7 +41,9 @@ void EncodingContext::Destroy() {
         return;
     }
     if (!mWereCommandsAcquired) {
-        FreeCommands(GetIterator());
+        // Hand the recorded commands to the worker pool for destruction so that dropping an
+        // unfinished encoder stays cheap on the calling thread.
+        mDevice->DeferCommandDestruction(AcquireCommands());
     }
     // If we weren't already finished, then we want to handle an error here so that any calls
     // to Finish after Destroy will return a meaningful error.
@@ -63,6 +67,30 @@ CommandIterator* EncodingContext::GetIterator() {
     return &mIterator;
 }
 
+void EncodingContext::AcquireCommandsFrom(EncodingContext* source) {
+    ASSERT(source->IsFinished());
+    ASSERT(!source->mWereCommandsAcquired && !source->mWasMovedToIterator);
+    ASSERT(!IsFinished() && mCurrentEncoder == mTopLevelEncoder);
+    ASSERT(!mWasMovedToIterator);
+
+    // Commit our currently pending commands first so that the source's command blocks land
+    // after everything already recorded here.
+    CommitCommands(std::move(mPendingCommands));
+    for (CommandAllocator& allocator : source->mAllocators) {
+        CommitCommands(std::move(allocator));
+    }
+    source->mAllocators.clear();
+
+    RenderPassUsages renderPassUsages = source->AcquireRenderPassUsages();
+    for (RenderPassResourceUsage& usage : renderPassUsages) {
+        mRenderPassUsages.push_back(std::move(usage));
+    }
+    ComputePassUsages computePassUsages = source->AcquireComputePassUsages();
+    for (ComputePassResourceUsage& usage : computePassUsages) {
+        mComputePassUsages.push_back(std::move(usage));
+    }
+}
+
 void EncodingContext::MoveToIterator() {
     CommitCommands(std::move(mPendingCommands));
     if (!mWasMovedToIterator) {
@@ -199,6 +227,18 @@ MaybeError EncodingContext::Finish() {
     mTopLevelEncoder = nullptr;
     CommitCommands(std::move(mPendingCommands));
 
+    // Report the command stream's memory density: backend translation is sensitive to how many
+    // bytes it has to walk per command.
+    uint64_t allocatedBytes = 0;
+    uint64_t allocatedCommands = 0;
+    for (const CommandAllocator& allocator : mAllocators) {
+        allocatedBytes += allocator.GetAllocatedBytes();
+        allocatedCommands += allocator.GetAllocatedCommandCount();
+    }
+    TRACE_EVENT2(mDevice->GetPlatform(), General, "EncodingContext::Finish", "bytes",
+                 allocatedBytes, "commands", allocatedCommands);
+    dawn::platform::AddMetric(dawn::platform::MetricCounter::CommandsEncoded, allocatedCommands);
+
     if (mError != nullptr) {
         return std::move(mError);
     }
@@ -47,6 +47,11 @@ class EncodingContext {
     CommandIterator AcquireCommands();
     CommandIterator* GetIterator();
 
+    // Moves all commands and per-pass usages recorded on `source` onto the end of this
+    // context's command stream. The source must have been finished successfully; it is left
+    // empty. This context must be at the top level with no pass open.
+    void AcquireCommandsFrom(EncodingContext* source);
+
     // Functions to handle encoder errors
     void HandleError(std::unique_ptr<ErrorData> error);
 
@@ -50,42 +50,72 @@ ErrorScopeStack::ErrorScopeStack() = default;
 ErrorScopeStack::~ErrorScopeStack() = default;
 
 void ErrorScopeStack::Push(wgpu::ErrorFilter filter) {
-    mScopes.push_back(ErrorScope(filter));
+    // The overflow vector is only used once the inline storage is full, so the inline slots
+    // always hold the outermost scopes and Pop below can check the overflow first.
+    if (mInlineScopeCount < kMaxInlineErrorScopes) {
+        mInlineScopes[mInlineScopeCount] = ErrorScope(filter);
+        mInlineScopeCount++;
+        return;
+    }
+    mOverflowScopes.push_back(ErrorScope(filter));
 }
 
 ErrorScope ErrorScopeStack::Pop() {
-    ASSERT(!mScopes.empty());
-    ErrorScope scope = std::move(mScopes.back());
-    mScopes.pop_back();
+    ASSERT(!Empty());
+    if (mOverflowScopes.empty()) {
+        // Common case: the scope lives in the inline storage and didn't capture an error, so
+        // the pop is a decrement plus the move of an empty message string.
+        mInlineScopeCount--;
+        ErrorScope scope = std::move(mInlineScopes[mInlineScopeCount]);
+        mInlineScopes[mInlineScopeCount] = ErrorScope();
+        return scope;
+    }
+    ErrorScope scope = std::move(mOverflowScopes.back());
+    mOverflowScopes.pop_back();
     return scope;
 }
 
 bool ErrorScopeStack::Empty() const {
-    return mScopes.empty();
+    return mInlineScopeCount == 0 && mOverflowScopes.empty();
 }
 
-bool ErrorScopeStack::HandleError(wgpu::ErrorType type, const char* message) {
-    for (auto it = mScopes.rbegin(); it != mScopes.rend(); ++it) {
-        if (it->mMatchedErrorType != type) {
-            // Error filter does not match. Move on to the next scope.
-            continue;
-        }
+// static
+bool ErrorScopeStack::CaptureErrorInScope(ErrorScope* scope,
+                                          wgpu::ErrorType type,
+                                          const char* message) {
+    if (scope->mMatchedErrorType != type) {
+        // Error filter does not match. Move on to the next scope.
+        return false;
+    }
+
+    // Filter matches.
+    // Record the error if the scope doesn't have one yet.
+    if (scope->mCapturedError == wgpu::ErrorType::NoError) {
+        scope->mCapturedError = type;
+        scope->mErrorMessage = message;
+    }
 
-        // Filter matches.
-        // Record the error if the scope doesn't have one yet.
-        if (it->mCapturedError == wgpu::ErrorType::NoError) {
-            it->mCapturedError = type;
-            it->mErrorMessage = message;
+    if (type == wgpu::ErrorType::DeviceLost) {
+        if (scope->mCapturedError != wgpu::ErrorType::DeviceLost) {
+            // DeviceLost overrides any other error that is not a DeviceLost.
+            scope->mCapturedError = type;
+            scope->mErrorMessage = message;
         }
+        return false;
+    }
+
+    // Errors that are not device lost are captured and stop propogating.
+    return true;
+}
 
-        if (type == wgpu::ErrorType::DeviceLost) {
-            if (it->mCapturedError != wgpu::ErrorType::DeviceLost) {
-                // DeviceLost overrides any other error that is not a DeviceLost.
-                it->mCapturedError = type;
-                it->mErrorMessage = message;
-            }
-        } else {
-            // Errors that are not device lost are captured and stop propogating.
+bool ErrorScopeStack::HandleError(wgpu::ErrorType type, const char* message) {
+    for (auto it = mOverflowScopes.rbegin(); it != mOverflowScopes.rend(); ++it) {
+        if (CaptureErrorInScope(&*it, type, message)) {
+            return true;
+        }
+    }
+    for (size_t i = mInlineScopeCount; i > 0; i--) {
+        if (CaptureErrorInScope(&mInlineScopes[i - 1], type, message)) {
             return true;
         }
     }
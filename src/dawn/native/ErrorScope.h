@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_ERRORSCOPE_H_
 #define SRC_DAWN_NATIVE_ERRORSCOPE_H_
 
+#include <array>
 #include <string>
 #include <vector>
 
@@ -29,9 +30,10 @@ class ErrorScope {
 
   private:
     friend class ErrorScopeStack;
+    ErrorScope() = default;
     explicit ErrorScope(wgpu::ErrorFilter errorFilter);
 
-    wgpu::ErrorType mMatchedErrorType;
+    wgpu::ErrorType mMatchedErrorType = wgpu::ErrorType::NoError;
     wgpu::ErrorType mCapturedError = wgpu::ErrorType::NoError;
     std::string mErrorMessage = "";
 };
@@ -52,7 +54,16 @@ class ErrorScopeStack {
     bool HandleError(wgpu::ErrorType type, const char* message);
 
   private:
-    std::vector<ErrorScope> mScopes;
+    // Returns true if the scope captured the error and it should stop propagating.
+    static bool CaptureErrorInScope(ErrorScope* scope, wgpu::ErrorType type, const char* message);
+
+    // Scopes rarely nest more than a few levels deep, so the first levels live inline in the
+    // stack and pushing and popping them never allocates. Deeper nesting chains into the
+    // overflow vector.
+    static constexpr size_t kMaxInlineErrorScopes = 8;
+    std::array<ErrorScope, kMaxInlineErrorScopes> mInlineScopes;
+    size_t mInlineScopeCount = 0;
+    std::vector<ErrorScope> mOverflowScopes;
 };
 
 }  // namespace dawn::native
@@ -212,6 +212,9 @@ void ExternalTextureBase::APIDestroy() {
 
 void ExternalTextureBase::DestroyImpl() {
     mState = ExternalTextureState::Destroyed;
+    // Command buffers referencing this external texture may have a cached submit validation
+    // verdict that destruction invalidates.
+    GetDevice()->IncrementSubmitValidationGeneration();
 }
 
 // static
@@ -80,6 +80,11 @@ static constexpr FeatureEnumAndInfoList kFeatureNameAndInfoList = {{
      {"dawn-native", "WebGPU is running on top of dawn_native.",
       "https://dawn.googlesource.com/dawn/+/refs/heads/main/docs/dawn/features/"
       "dawn_native.md"}},
+    {Feature::MultiDrawIndirect,
+     {"dawn-multi-draw-indirect",
+      "Issue multiple indirect draws from a single buffer with one encoder call, with an "
+      "optional GPU-written draw count",
+      "https://bugs.chromium.org/p/dawn/issues/detail?id=1197"}},
 }};
 
 Feature FromAPIFeature(wgpu::FeatureName feature) {
@@ -113,6 +118,8 @@ Feature FromAPIFeature(wgpu::FeatureName feature) {
             return Feature::DawnNative;
         case wgpu::FeatureName::ChromiumExperimentalDp4a:
             return Feature::ChromiumExperimentalDp4a;
+        case wgpu::FeatureName::DawnMultiDrawIndirect:
+            return Feature::MultiDrawIndirect;
     }
     return Feature::InvalidEnum;
 }
@@ -145,6 +152,8 @@ wgpu::FeatureName ToAPIFeature(Feature feature) {
             return wgpu::FeatureName::DawnNative;
         case Feature::ChromiumExperimentalDp4a:
             return wgpu::FeatureName::ChromiumExperimentalDp4a;
+        case Feature::MultiDrawIndirect:
+            return wgpu::FeatureName::DawnMultiDrawIndirect;
 
         case Feature::EnumCount:
             break;
@@ -42,6 +42,7 @@ enum class Feature {
     DawnInternalUsages,
     MultiPlanarFormats,
     DawnNative,
+    MultiDrawIndirect,
 
     EnumCount,
     InvalidEnum = EnumCount,
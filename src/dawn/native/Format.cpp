@@ -79,52 +79,13 @@ SampleTypeBit SampleTypeToSampleTypeBit(wgpu::TextureSampleType sampleType) {
     return static_cast<SampleTypeBit>(1 << (static_cast<uint32_t>(sampleType) - 1));
 }
 
-bool Format::IsColor() const {
-    return aspects == Aspect::Color;
-}
-
-bool Format::HasDepth() const {
-    return (aspects & Aspect::Depth) != 0;
-}
-
-bool Format::HasStencil() const {
-    return (aspects & Aspect::Stencil) != 0;
-}
-
-bool Format::HasDepthOrStencil() const {
-    return (aspects & (Aspect::Depth | Aspect::Stencil)) != 0;
-}
-
-bool Format::IsMultiPlanar() const {
-    return (aspects & (Aspect::Plane0 | Aspect::Plane1)) != 0;
-}
-
-bool Format::CopyCompatibleWith(const Format& format) const {
-    // TODO(crbug.com/dawn/1332): Add a Format compatibility matrix.
-    return baseFormat == format.baseFormat;
-}
-
-bool Format::ViewCompatibleWith(const Format& format) const {
-    // TODO(crbug.com/dawn/1332): Add a Format compatibility matrix.
-    return baseFormat == format.baseFormat;
-}
-
+// This overload stays out of line because SelectFormatAspects needs the full Format definition
+// and so cannot be called from Format.h. Hot paths resolve the aspect first and use the inline
+// Aspect overload.
 const AspectInfo& Format::GetAspectInfo(wgpu::TextureAspect aspect) const {
     return GetAspectInfo(SelectFormatAspects(*this, aspect));
 }
 
-const AspectInfo& Format::GetAspectInfo(Aspect aspect) const {
-    ASSERT(HasOneBit(aspect));
-    ASSERT(aspects & aspect);
-    const size_t aspectIndex = GetAspectIndex(aspect);
-    ASSERT(aspectIndex < GetAspectCount(aspects));
-    return aspectInfo[aspectIndex];
-}
-
-FormatIndex Format::GetIndex() const {
-    return ComputeFormatIndex(format);
-}
-
 // FormatSet implementation
 
 bool FormatSet::operator[](const Format& format) const {
@@ -137,15 +98,6 @@ typename std::bitset<kKnownFormatCount>::reference FormatSet::operator[](const F
 
 // Implementation details of the format table of the DeviceBase
 
-// For the enum for formats are packed but this might change when we have a broader feature
-// mechanism for webgpu.h. Formats start at 1 because 0 is the undefined format.
-FormatIndex ComputeFormatIndex(wgpu::TextureFormat format) {
-    // This takes advantage of overflows to make the index of TextureFormat::Undefined outside
-    // of the range of the FormatTable.
-    static_assert(static_cast<uint32_t>(wgpu::TextureFormat::Undefined) - 1 > kKnownFormatCount);
-    return static_cast<FormatIndex>(static_cast<uint32_t>(format) - 1);
-}
-
 FormatTable BuildFormatTable(const DeviceBase* device) {
     FormatTable table;
     FormatSet formatsSet;
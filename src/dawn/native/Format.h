@@ -19,6 +19,7 @@
 
 #include "dawn/native/dawn_platform.h"
 
+#include "dawn/common/Assert.h"
 #include "dawn/common/TypedInteger.h"
 #include "dawn/common/ityp_array.h"
 #include "dawn/common/ityp_bitset.h"
@@ -86,6 +87,18 @@ using FormatIndex = TypedInteger<struct FormatIndexT, uint32_t>;
 struct Format;
 using FormatTable = ityp::array<FormatIndex, Format, kKnownFormatCount>;
 
+// Returns the index of a format in the FormatTable. Defined here (and constexpr) so that format
+// lookups on validation hot paths compile down to an array load.
+//
+// The enum for formats is packed but this might change when we have a broader feature
+// mechanism for webgpu.h. Formats start at 1 because 0 is the undefined format.
+constexpr FormatIndex ComputeFormatIndex(wgpu::TextureFormat format) {
+    // This takes advantage of overflows to make the index of TextureFormat::Undefined outside
+    // of the range of the FormatTable.
+    static_assert(static_cast<uint32_t>(wgpu::TextureFormat::Undefined) - 1 > kKnownFormatCount);
+    return static_cast<FormatIndex>(static_cast<uint32_t>(format) - 1);
+}
+
 // A wgpu::TextureFormat along with all the information about it necessary for validation.
 struct Format {
     wgpu::TextureFormat format = wgpu::TextureFormat::Undefined;
@@ -102,21 +115,29 @@ struct Format {
     // Only used for renderable color formats, number of color channels.
     uint8_t componentCount = 0;
 
-    bool IsColor() const;
-    bool HasDepth() const;
-    bool HasStencil() const;
-    bool HasDepthOrStencil() const;
+    // These accessors are defined inline because they are hit thousands of times per frame by
+    // copy and validation hot paths, and should compile down to loads from the format table.
+    bool IsColor() const { return aspects == Aspect::Color; }
+    bool HasDepth() const { return (aspects & Aspect::Depth) != 0; }
+    bool HasStencil() const { return (aspects & Aspect::Stencil) != 0; }
+    bool HasDepthOrStencil() const { return (aspects & (Aspect::Depth | Aspect::Stencil)) != 0; }
 
     // IsMultiPlanar() returns true if the format allows selecting a plane index. This is only
     // allowed by multi-planar formats (ex. NV12).
-    bool IsMultiPlanar() const;
+    bool IsMultiPlanar() const { return (aspects & (Aspect::Plane0 | Aspect::Plane1)) != 0; }
 
     const AspectInfo& GetAspectInfo(wgpu::TextureAspect aspect) const;
-    const AspectInfo& GetAspectInfo(Aspect aspect) const;
+    const AspectInfo& GetAspectInfo(Aspect aspect) const {
+        ASSERT(HasOneBit(aspect));
+        ASSERT(aspects & aspect);
+        const size_t aspectIndex = GetAspectIndex(aspect);
+        ASSERT(aspectIndex < GetAspectCount(aspects));
+        return aspectInfo[aspectIndex];
+    }
 
     // The index of the format in the list of all known formats: a unique number for each format
     // in [0, kKnownFormatCount)
-    FormatIndex GetIndex() const;
+    FormatIndex GetIndex() const { return ComputeFormatIndex(format); }
 
     // baseFormat represents the memory layout of the format.
     // If two formats has the same baseFormat, they could copy to and be viewed as the other
@@ -125,11 +146,16 @@ struct Format {
 
     // Returns true if the formats are copy compatible.
     // Currently means they differ only in sRGB-ness.
-    bool CopyCompatibleWith(const Format& format) const;
+    // TODO(crbug.com/dawn/1332): Add a Format compatibility matrix.
+    bool CopyCompatibleWith(const Format& format) const {
+        return baseFormat == format.baseFormat;
+    }
 
     // Returns true if the formats are texture view format compatible.
     // Currently means they differ only in sRGB-ness.
-    bool ViewCompatibleWith(const Format& format) const;
+    bool ViewCompatibleWith(const Format& format) const {
+        return baseFormat == format.baseFormat;
+    }
 
   private:
     // Used to store the aspectInfo for one or more planes. For single plane "color" formats,
@@ -154,9 +180,8 @@ class FormatSet : public ityp::bitset<FormatIndex, kKnownFormatCount> {
 
 // Implementation details of the format table in the device.
 
-// Returns the index of a format in the FormatTable.
-FormatIndex ComputeFormatIndex(wgpu::TextureFormat format);
-// Builds the format table with the extensions enabled on the device.
+// Builds the format table with the extensions enabled on the device. The table itself cannot be
+// constexpr because Format::isSupported depends on which features the device has enabled.
 FormatTable BuildFormatTable(const DeviceBase* device);
 
 }  // namespace dawn::native
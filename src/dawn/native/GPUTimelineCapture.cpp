@@ -0,0 +1,214 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/GPUTimelineCapture.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "dawn/native/Buffer.h"
+#include "dawn/native/CommandBuffer.h"
+#include "dawn/native/CommandEncoder.h"
+#include "dawn/native/Device.h"
+#include "dawn/native/QuerySet.h"
+#include "dawn/native/Queue.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
+
+namespace dawn::native {
+
+// Data carried from FlushAfterSubmit to the map callback. The context keeps the readback buffer
+// alive and owns the pass records of the flush.
+struct GPUTimelineCapture::ReadbackContext {
+    GPUTimelineCapture* capture;
+    Ref<BufferBase> readbackBuffer;
+    std::vector<PassRecord> passes;
+    uint64_t byteSize;
+    uint32_t queryCount;
+    // CPU time of the submit this flush rode on, used as the clock sync anchor.
+    double cpuSubmitTime;
+};
+
+GPUTimelineCapture::GPUTimelineCapture(DeviceBase* device) : mDevice(device) {}
+
+GPUTimelineCapture::~GPUTimelineCapture() = default;
+
+MaybeError GPUTimelineCapture::Initialize() {
+    QuerySetDescriptor querySetDesc = {};
+    querySetDesc.label = "Dawn_GPUTimelineCapture_Timestamps";
+    querySetDesc.type = wgpu::QueryType::Timestamp;
+    querySetDesc.count = kQueryCount;
+    DAWN_TRY_ASSIGN(mQuerySet, mDevice->CreateQuerySet(&querySetDesc));
+
+    BufferDescriptor resolveDesc = {};
+    resolveDesc.label = "Dawn_GPUTimelineCapture_Resolve";
+    resolveDesc.usage = wgpu::BufferUsage::QueryResolve | wgpu::BufferUsage::CopySrc;
+    resolveDesc.size = uint64_t(kQueryCount) * sizeof(uint64_t);
+    DAWN_TRY_ASSIGN(mResolveBuffer, mDevice->CreateBuffer(&resolveDesc));
+
+    return {};
+}
+
+QuerySetBase* GPUTimelineCapture::GetQuerySet() const {
+    return mQuerySet.Get();
+}
+
+bool GPUTimelineCapture::AllocateQuerySlot(uint32_t* slot) {
+    if (mNextQuerySlot >= kQueryCount) {
+        return false;
+    }
+    *slot = mNextQuerySlot++;
+    return true;
+}
+
+void GPUTimelineCapture::EnqueuePasses(std::vector<PassRecord> passes) {
+    if (mPendingPasses.empty()) {
+        mPendingPasses = std::move(passes);
+    } else {
+        mPendingPasses.insert(mPendingPasses.end(), passes.begin(), passes.end());
+    }
+}
+
+MaybeError GPUTimelineCapture::FlushAfterSubmit() {
+    // A single flush in flight at a time keeps the query slot management trivial; passes
+    // submitted meanwhile just wait for the next submit.
+    if (mFlushInFlight || mPendingPasses.empty()) {
+        return {};
+    }
+
+    const uint32_t queryCount = mNextQuerySlot;
+    const uint64_t byteSize = uint64_t(queryCount) * sizeof(uint64_t);
+
+    BufferDescriptor readbackDesc = {};
+    readbackDesc.label = "Dawn_GPUTimelineCapture_Readback";
+    readbackDesc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
+    readbackDesc.size = byteSize;
+    Ref<BufferBase> readbackBuffer;
+    DAWN_TRY_ASSIGN(readbackBuffer, mDevice->CreateBuffer(&readbackDesc));
+
+    // The resolve converts the timestamps to nanoseconds and zeroes queries that were never
+    // written (allocated by an encoder that was discarded instead of submitted). The copy to
+    // the readback buffer is kept in a second command buffer so the converted values are read
+    // even when the defer_timestamp_conversions toggle moves the conversion pass to Finish.
+    CommandEncoderDescriptor encoderDesc = {};
+    Ref<CommandEncoder> resolveEncoder;
+    DAWN_TRY_ASSIGN(resolveEncoder, mDevice->CreateCommandEncoder(&encoderDesc));
+    resolveEncoder->APIResolveQuerySet(mQuerySet.Get(), 0, queryCount, mResolveBuffer.Get(), 0);
+    Ref<CommandBufferBase> resolveCommands;
+    DAWN_TRY_ASSIGN(resolveCommands, resolveEncoder->Finish());
+
+    Ref<CommandEncoder> copyEncoder;
+    DAWN_TRY_ASSIGN(copyEncoder, mDevice->CreateCommandEncoder(&encoderDesc));
+    copyEncoder->APICopyBufferToBuffer(mResolveBuffer.Get(), 0, readbackBuffer.Get(), 0, byteSize);
+    Ref<CommandBufferBase> copyCommands;
+    DAWN_TRY_ASSIGN(copyCommands, copyEncoder->Finish());
+
+    // Set before submitting: the submit below re-enters Queue::SubmitInternal, which calls
+    // FlushAfterSubmit again.
+    mFlushInFlight = true;
+
+    CommandBufferBase* commandBuffers[] = {resolveCommands.Get(), copyCommands.Get()};
+    mDevice->GetQueue()->APISubmit(2, commandBuffers);
+
+    ReadbackContext* context = new ReadbackContext();
+    context->capture = this;
+    context->readbackBuffer = readbackBuffer;
+    context->passes = std::move(mPendingPasses);
+    context->byteSize = byteSize;
+    context->queryCount = queryCount;
+    context->cpuSubmitTime = mDevice->GetPlatform()->MonotonicallyIncreasingTime();
+    mPendingPasses.clear();
+
+    readbackBuffer->APIMapAsync(wgpu::MapMode::Read, 0, static_cast<size_t>(byteSize),
+                                OnReadbackDone, context);
+
+    return {};
+}
+
+// static
+void GPUTimelineCapture::OnReadbackDone(WGPUBufferMapAsyncStatus status, void* userdata) {
+    ReadbackContext* context = static_cast<ReadbackContext*>(userdata);
+    GPUTimelineCapture* capture = context->capture;
+
+    // The capture outlives all pending callbacks: the device drains them before it tears its
+    // members down on destruction or loss.
+    if (status == WGPUBufferMapAsyncStatus_Success) {
+        const uint64_t* timestampsNS =
+            static_cast<const uint64_t*>(context->readbackBuffer->APIGetConstMappedRange(
+                0, static_cast<size_t>(context->byteSize)));
+        if (timestampsNS != nullptr) {
+            capture->EmitTraceEvents(*context, timestampsNS);
+        }
+        context->readbackBuffer->APIUnmap();
+    }
+
+    capture->mFlushInFlight = false;
+
+    // Recycle the query slots once nothing references them anymore. Encoders discarded
+    // mid-pass may still write a stale slot later; that only garbles the timestamps of the
+    // pass that gets the reused slot, which is acceptable for a best-effort capture.
+    if (capture->mPendingPasses.empty() && capture->mNextQuerySlot == context->queryCount) {
+        capture->mNextQuerySlot = 0;
+    }
+
+    delete context;
+}
+
+void GPUTimelineCapture::EmitTraceEvents(const ReadbackContext& context,
+                                         const uint64_t* timestampsNS) {
+    dawn::platform::Platform* platform = mDevice->GetPlatform();
+    const unsigned char* categoryEnabled =
+        platform->GetTraceCategoryEnabledFlag(dawn::platform::TraceCategory::GPUWork);
+    if (categoryEnabled == nullptr || !*categoryEnabled) {
+        return;
+    }
+
+    // Single-point clock sync: the earliest captured timestamp is pinned to the CPU submit
+    // time; everything else is offset from it on the GPU clock.
+    uint64_t anchorNS = std::numeric_limits<uint64_t>::max();
+    for (const PassRecord& pass : context.passes) {
+        if (pass.beginQuery < context.queryCount && timestampsNS[pass.beginQuery] != 0) {
+            anchorNS = std::min(anchorNS, timestampsNS[pass.beginQuery]);
+        }
+    }
+    if (anchorNS == std::numeric_limits<uint64_t>::max()) {
+        return;
+    }
+
+    for (const PassRecord& pass : context.passes) {
+        if (pass.beginQuery >= context.queryCount || pass.endQuery >= context.queryCount) {
+            continue;
+        }
+        uint64_t beginNS = timestampsNS[pass.beginQuery];
+        uint64_t endNS = timestampsNS[pass.endQuery];
+        // Zero means the query was never written (the command buffer was discarded).
+        if (beginNS == 0 || endNS == 0 || endNS < beginNS) {
+            continue;
+        }
+
+        double beginTime =
+            context.cpuSubmitTime + static_cast<double>(beginNS - anchorNS) * 1e-9;
+        double endTime = context.cpuSubmitTime + static_cast<double>(endNS - anchorNS) * 1e-9;
+        uint64_t id = mNextTraceId++;
+
+        platform->AddTraceEvent(TRACE_EVENT_PHASE_ASYNC_BEGIN, categoryEnabled, pass.name, id,
+                                beginTime, 0, nullptr, nullptr, nullptr,
+                                TRACE_EVENT_FLAG_HAS_ID);
+        platform->AddTraceEvent(TRACE_EVENT_PHASE_ASYNC_END, categoryEnabled, pass.name, id,
+                                endTime, 0, nullptr, nullptr, nullptr, TRACE_EVENT_FLAG_HAS_ID);
+    }
+}
+
+}  // namespace dawn::native
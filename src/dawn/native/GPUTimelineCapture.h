@@ -0,0 +1,89 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_GPUTIMELINECAPTURE_H_
+#define SRC_DAWN_NATIVE_GPUTIMELINECAPTURE_H_
+
+#include <vector>
+
+#include "dawn/common/NonCopyable.h"
+#include "dawn/native/Error.h"
+#include "dawn/native/Forward.h"
+#include "dawn/native/dawn_platform.h"
+
+namespace dawn::native {
+
+// Captures the GPU execution time of passes and emits it as async trace events in the GPUWork
+// category, so GPU work shows up on the same Chrome trace timeline as Dawn's CPU events.
+//
+// The capture is enabled with the capture_gpu_timeline toggle and requires the timestamp-query
+// feature. When active, CommandEncoder writes a timestamp into the capture's query set at every
+// pass begin and end. On submit, the queue hands the pass records of the submitted command
+// buffers to the capture, which resolves the timestamps with an internal command buffer, reads
+// them back asynchronously, and emits one async begin/end event pair per pass.
+//
+// Clock sync is a single-point approximation: the earliest timestamp of each flush is anchored
+// to the CPU time of the submit that triggered the flush. That places GPU work slightly late
+// (by the queue latency of that first pass) but keeps the capture backend-independent; precise
+// calibration needs backend clock-calibration APIs.
+class GPUTimelineCapture : public NonCopyable {
+  public:
+    // One captured pass: the query set slots holding its boundary timestamps and a static
+    // string naming the pass kind.
+    struct PassRecord {
+        uint32_t beginQuery;
+        uint32_t endQuery;
+        const char* name;
+    };
+
+    static constexpr uint32_t kQueryCount = 512;
+    static constexpr uint32_t kInvalidQuerySlot = ~0u;
+
+    explicit GPUTimelineCapture(DeviceBase* device);
+    ~GPUTimelineCapture();
+
+    MaybeError Initialize();
+
+    QuerySetBase* GetQuerySet() const;
+
+    // Hands out the next query set slot for a pass-boundary timestamp. Returns false when the
+    // query set is exhausted; the caller then skips capturing the pass.
+    bool AllocateQuerySlot(uint32_t* slot);
+
+    // Takes ownership of the pass records of a submitted command buffer.
+    void EnqueuePasses(std::vector<PassRecord> passes);
+
+    // Resolves the timestamps written so far and kicks off their asynchronous readback. Called
+    // by the queue after each submit; at most one flush is in flight at a time.
+    MaybeError FlushAfterSubmit();
+
+  private:
+    struct ReadbackContext;
+
+    static void OnReadbackDone(WGPUBufferMapAsyncStatus status, void* userdata);
+    void EmitTraceEvents(const ReadbackContext& context, const uint64_t* timestampsNS);
+
+    DeviceBase* const mDevice;
+    Ref<QuerySetBase> mQuerySet;
+    Ref<BufferBase> mResolveBuffer;
+
+    uint32_t mNextQuerySlot = 0;
+    std::vector<PassRecord> mPendingPasses;
+    bool mFlushInFlight = false;
+    uint64_t mNextTraceId = 1;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_GPUTIMELINECAPTURE_H_
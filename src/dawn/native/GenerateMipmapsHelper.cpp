@@ -0,0 +1,208 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/GenerateMipmapsHelper.h"
+
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+#include "dawn/native/BindGroup.h"
+#include "dawn/native/BindGroupLayout.h"
+#include "dawn/native/CommandEncoder.h"
+#include "dawn/native/ComputePassEncoder.h"
+#include "dawn/native/ComputePipeline.h"
+#include "dawn/native/Device.h"
+#include "dawn/native/InternalPipelineStore.h"
+#include "dawn/native/ShaderModule.h"
+#include "dawn/native/Texture.h"
+#include "dawn/native/utils/WGPUHelpers.h"
+
+namespace dawn::native {
+namespace {
+
+constexpr uint32_t kWorkgroupSizePerDim = 8;
+
+// Returns the WGSL storage texture format string for |format|, or nullptr when the format
+// can't be written as a storage texture by the downsample shader.
+const char* GetWGSLStorageFormat(wgpu::TextureFormat format) {
+    switch (format) {
+        case wgpu::TextureFormat::RGBA8Unorm:
+            return "rgba8unorm";
+        case wgpu::TextureFormat::RGBA8Snorm:
+            return "rgba8snorm";
+        case wgpu::TextureFormat::RGBA16Float:
+            return "rgba16float";
+        case wgpu::TextureFormat::RGBA32Float:
+            return "rgba32float";
+        case wgpu::TextureFormat::RG32Float:
+            return "rg32float";
+        case wgpu::TextureFormat::R32Float:
+            return "r32float";
+        default:
+            return nullptr;
+    }
+}
+
+// Generates the compute shader that writes one mip level from the level above it with a 2x2
+// box filter. Odd-sized source levels are handled by clamping the source texel coordinates.
+std::string GetDownsampleShader(const char* storageFormat) {
+    std::ostringstream shader;
+    shader << R"(
+        @group(0) @binding(0) var srcLevel : texture_2d<f32>;
+        @group(0) @binding(1) var dstLevel : texture_storage_2d<)"
+           << storageFormat << R"(, write>;
+
+        @compute @workgroup_size()"
+           << kWorkgroupSizePerDim << ", " << kWorkgroupSizePerDim << R"()
+        fn main(@builtin(global_invocation_id) GlobalInvocationID : vec3<u32>) {
+            let dstSize = textureDimensions(dstLevel);
+            let dstTexel = vec2<i32>(GlobalInvocationID.xy);
+            if (dstTexel.x >= dstSize.x || dstTexel.y >= dstSize.y) {
+                return;
+            }
+
+            let maxSrcTexel = textureDimensions(srcLevel) - vec2<i32>(1, 1);
+            let srcBase = dstTexel * 2;
+            var color = textureLoad(srcLevel, min(srcBase, maxSrcTexel), 0);
+            color = color + textureLoad(srcLevel, min(srcBase + vec2<i32>(1, 0), maxSrcTexel), 0);
+            color = color + textureLoad(srcLevel, min(srcBase + vec2<i32>(0, 1), maxSrcTexel), 0);
+            color = color + textureLoad(srcLevel, min(srcBase + vec2<i32>(1, 1), maxSrcTexel), 0);
+            textureStore(dstLevel, dstTexel, color * 0.25);
+        }
+    )";
+    return shader.str();
+}
+
+ComputePipelineBase* GetCachedPipeline(InternalPipelineStore* store, wgpu::TextureFormat format) {
+    auto iter = store->generateMipmapsPipelines.find(format);
+    if (iter != store->generateMipmapsPipelines.end()) {
+        return iter->second.Get();
+    }
+    return nullptr;
+}
+
+ResultOrError<ComputePipelineBase*> GetOrCreateGenerateMipmapsPipeline(
+    DeviceBase* device,
+    wgpu::TextureFormat format) {
+    InternalPipelineStore* store = device->GetInternalPipelineStore();
+
+    if (GetCachedPipeline(store, format) == nullptr) {
+        const char* storageFormat = GetWGSLStorageFormat(format);
+        ASSERT(storageFormat != nullptr);
+
+        std::string downsampleShader = GetDownsampleShader(storageFormat);
+        Ref<ShaderModuleBase> shaderModule;
+        DAWN_TRY_ASSIGN(shaderModule, utils::CreateShaderModule(device, downsampleShader.c_str()));
+
+        // Create ComputePipeline.
+        ComputePipelineDescriptor computePipelineDesc = {};
+        // Generate the layout based on shader module.
+        computePipelineDesc.layout = nullptr;
+        computePipelineDesc.compute.module = shaderModule.Get();
+        computePipelineDesc.compute.entryPoint = "main";
+
+        Ref<ComputePipelineBase> pipeline;
+        DAWN_TRY_ASSIGN(pipeline, device->CreateComputePipeline(&computePipelineDesc));
+        store->generateMipmapsPipelines.insert({format, std::move(pipeline)});
+    }
+
+    return GetCachedPipeline(store, format);
+}
+
+}  // anonymous namespace
+
+bool SupportsGeneratingMipmaps(const TextureBase* texture) {
+    if (texture->GetDimension() != wgpu::TextureDimension::e2D ||
+        texture->IsMultisampledTexture() || texture->GetNumMipLevels() < 2) {
+        return false;
+    }
+
+    constexpr wgpu::TextureUsage kRequiredUsages =
+        wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::StorageBinding;
+    if (!IsSubset(kRequiredUsages, texture->GetInternalUsage())) {
+        return false;
+    }
+
+    return GetWGSLStorageFormat(texture->GetFormat().format) != nullptr;
+}
+
+MaybeError GenerateMipmaps(CommandEncoder* encoder, TextureBase* texture) {
+    ASSERT(SupportsGeneratingMipmaps(texture));
+
+    DeviceBase* device = encoder->GetDevice();
+
+    ComputePipelineBase* pipeline;
+    DAWN_TRY_ASSIGN(pipeline,
+                    GetOrCreateGenerateMipmapsPipeline(device, texture->GetFormat().format));
+
+    // Prepare bind group layout.
+    Ref<BindGroupLayoutBase> layout;
+    DAWN_TRY_ASSIGN(layout, pipeline->GetBindGroupLayout(0));
+
+    // Create all the bind groups upfront so that no error can be generated once the pass has
+    // begun, one per (level, layer) with the level above it as the source.
+    std::vector<Ref<BindGroupBase>> bindGroups;
+    for (uint32_t level = 1; level < texture->GetNumMipLevels(); ++level) {
+        for (uint32_t layer = 0; layer < texture->GetArrayLayers(); ++layer) {
+            TextureViewDescriptor srcViewDesc = {};
+            srcViewDesc.dimension = wgpu::TextureViewDimension::e2D;
+            srcViewDesc.baseMipLevel = level - 1;
+            srcViewDesc.mipLevelCount = 1;
+            srcViewDesc.baseArrayLayer = layer;
+            srcViewDesc.arrayLayerCount = 1;
+            Ref<TextureViewBase> srcView;
+            DAWN_TRY_ASSIGN(srcView, device->CreateTextureView(texture, &srcViewDesc));
+
+            TextureViewDescriptor dstViewDesc = srcViewDesc;
+            dstViewDesc.baseMipLevel = level;
+            Ref<TextureViewBase> dstView;
+            DAWN_TRY_ASSIGN(dstView, device->CreateTextureView(texture, &dstViewDesc));
+
+            Ref<BindGroupBase> bindGroup;
+            DAWN_TRY_ASSIGN(bindGroup,
+                            utils::MakeBindGroup(device, layout, {{0, srcView}, {1, dstView}},
+                                                 UsageValidationMode::Internal));
+            bindGroups.push_back(std::move(bindGroup));
+        }
+    }
+
+    // A single pass covers the whole mip chain; the per-dispatch synchronization scopes let
+    // the backends batch the transitions of each level instead of paying one pass round-trip
+    // per level.
+    Ref<ComputePassEncoder> pass = encoder->BeginComputePass();
+    pass->APISetPipeline(pipeline);
+
+    size_t bindGroupIndex = 0;
+    for (uint32_t level = 1; level < texture->GetNumMipLevels(); ++level) {
+        Extent3D dstSize = texture->GetMipLevelSingleSubresourceVirtualSize(level);
+        uint32_t workgroupCountX =
+            (dstSize.width + kWorkgroupSizePerDim - 1) / kWorkgroupSizePerDim;
+        uint32_t workgroupCountY =
+            (dstSize.height + kWorkgroupSizePerDim - 1) / kWorkgroupSizePerDim;
+
+        for (uint32_t layer = 0; layer < texture->GetArrayLayers(); ++layer) {
+            pass->APISetBindGroup(0, bindGroups[bindGroupIndex++].Get());
+            pass->APIDispatchWorkgroups(workgroupCountX, workgroupCountY);
+        }
+    }
+    pass->APIEnd();
+
+    return {};
+}
+
+}  // namespace dawn::native
@@ -0,0 +1,39 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_GENERATEMIPMAPSHELPER_H_
+#define SRC_DAWN_NATIVE_GENERATEMIPMAPSHELPER_H_
+
+#include "dawn/native/Error.h"
+
+namespace dawn::native {
+
+class CommandEncoder;
+class TextureBase;
+
+// Returns whether GenerateMipmaps() supports regenerating the mip chain of |texture|: a
+// single-sampled 2D texture with more than one mip level, a float-component format usable as a
+// storage texture, and the TextureBinding and StorageBinding (internal) usages.
+bool SupportsGeneratingMipmaps(const TextureBase* texture);
+
+// Records a single compute pass on |encoder| that regenerates mip levels [1, levelCount) of
+// |texture| from level 0 with a box filter, one dispatch per level and array layer. The
+// barriers between the levels are batched by the backends' per-dispatch usage tracking.
+// Callers are expected to check SupportsGeneratingMipmaps() first and to record on an encoder
+// created with DawnEncoderInternalUsageDescriptor when |texture| lacks the public usages.
+MaybeError GenerateMipmaps(CommandEncoder* encoder, TextureBase* texture);
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_GENERATEMIPMAPSHELPER_H_
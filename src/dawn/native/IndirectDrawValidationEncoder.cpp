@@ -241,6 +241,8 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
                                                 IndirectDrawMetadata* indirectDrawMetadata) {
     struct Batch {
         const IndirectDrawMetadata::IndirectValidationBatch* metadata;
+        uint32_t flags;
+        BufferBase* inputIndirectBuffer;
         uint64_t numIndexBufferElements;
         uint64_t dataBufferOffset;
         uint64_t dataSize;
@@ -251,21 +253,13 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
         BatchInfo* batchInfo;
     };
 
-    struct Pass {
-        uint32_t flags;
-        BufferBase* inputIndirectBuffer;
-        uint64_t outputParamsSize = 0;
-        uint64_t batchDataSize = 0;
-        std::unique_ptr<void, void (*)(void*)> batchData{nullptr, std::free};
-        std::vector<Batch> batches;
-    };
-
-    // First stage is grouping all batches into passes. We try to pack as many batches into a
-    // single pass as possible. Batches can be grouped together as long as they're validating
-    // data from the same indirect buffer, but they may still be split into multiple passes if
-    // the number of draw calls in a pass would exceed some (very high) upper bound.
+    // First stage is collecting all the batches. All of them are encoded in a single compute
+    // pass with one upload of the batch metadata: batches validating different indirect
+    // buffers only differ by the input binding of their bind group, and the per-batch flags
+    // travel in the batch data itself.
     uint64_t outputParamsSize = 0;
-    std::vector<Pass> passes;
+    uint64_t batchDataSize = 0;
+    std::vector<Batch> batches;
     IndirectDrawMetadata::IndexedIndirectBufferValidationInfoMap& bufferInfoMap =
         *indirectDrawMetadata->GetIndexedIndirectBufferValidationInfo();
     if (bufferInfoMap.empty()) {
@@ -286,6 +280,20 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
             outputIndirectSize += 2 * sizeof(uint32_t);
         }
 
+        uint32_t flags = 0;
+        if (config.duplicateBaseVertexInstance) {
+            flags |= kDuplicateBaseVertexInstance;
+        }
+        if (config.drawType == IndirectDrawMetadata::DrawType::Indexed) {
+            flags |= kIndexedDraw;
+        }
+        if (device->IsValidationEnabled()) {
+            flags |= kValidationEnabled;
+        }
+        if (device->IsFeatureEnabled(Feature::IndirectFirstInstance)) {
+            flags |= kIndirectFirstInstanceEnabled;
+        }
+
         for (const IndirectDrawMetadata::IndirectValidationBatch& batch :
              validationInfo.GetBatches()) {
             const uint64_t minOffsetFromAlignedBoundary =
@@ -294,12 +302,19 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
 
             Batch newBatch;
             newBatch.metadata = &batch;
+            newBatch.flags = flags;
+            newBatch.inputIndirectBuffer = config.inputIndirectBuffer;
             newBatch.numIndexBufferElements = config.numIndexBufferElements;
             newBatch.dataSize = GetBatchDataSize(batch.draws.size());
             newBatch.inputIndirectOffset = minOffsetAlignedDown;
             newBatch.inputIndirectSize =
                 batch.maxOffset + indirectDrawCommandSize - minOffsetAlignedDown;
 
+            // Note that a single batch never holds more draws than fit in one storage binding,
+            // so the per-batch binding of the shared batch data buffer stays within limits.
+            newBatch.dataBufferOffset = Align(batchDataSize, minStorageBufferOffsetAlignment);
+            batchDataSize = newBatch.dataBufferOffset + newBatch.dataSize;
+
             newBatch.outputParamsSize = batch.draws.size() * outputIndirectSize;
             newBatch.outputParamsOffset = Align(outputParamsSize, minStorageBufferOffsetAlignment);
             outputParamsSize = newBatch.outputParamsOffset + newBatch.outputParamsSize;
@@ -307,41 +322,7 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
                 return DAWN_INTERNAL_ERROR("Too many drawIndexedIndirect calls to validate");
             }
 
-            Pass* currentPass = passes.empty() ? nullptr : &passes.back();
-            if (currentPass && currentPass->inputIndirectBuffer == config.inputIndirectBuffer) {
-                uint64_t nextBatchDataOffset =
-                    Align(currentPass->batchDataSize, minStorageBufferOffsetAlignment);
-                uint64_t newPassBatchDataSize = nextBatchDataOffset + newBatch.dataSize;
-                if (newPassBatchDataSize <= maxStorageBufferBindingSize) {
-                    // We can fit this batch in the current pass.
-                    newBatch.dataBufferOffset = nextBatchDataOffset;
-                    currentPass->batchDataSize = newPassBatchDataSize;
-                    currentPass->batches.push_back(newBatch);
-                    continue;
-                }
-            }
-
-            // We need to start a new pass for this batch.
-            newBatch.dataBufferOffset = 0;
-
-            Pass newPass{};
-            newPass.inputIndirectBuffer = config.inputIndirectBuffer;
-            newPass.batchDataSize = newBatch.dataSize;
-            newPass.batches.push_back(newBatch);
-            newPass.flags = 0;
-            if (config.duplicateBaseVertexInstance) {
-                newPass.flags |= kDuplicateBaseVertexInstance;
-            }
-            if (config.drawType == IndirectDrawMetadata::DrawType::Indexed) {
-                newPass.flags |= kIndexedDraw;
-            }
-            if (device->IsValidationEnabled()) {
-                newPass.flags |= kValidationEnabled;
-            }
-            if (device->IsFeatureEnabled(Feature::IndirectFirstInstance)) {
-                newPass.flags |= kIndirectFirstInstanceEnabled;
-            }
-            passes.push_back(std::move(newPass));
+            batches.push_back(newBatch);
         }
     }
 
@@ -349,42 +330,37 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
     ScratchBuffer& outputParamsBuffer = store->scratchIndirectStorage;
     ScratchBuffer& batchDataBuffer = store->scratchStorage;
 
-    uint64_t requiredBatchDataBufferSize = 0;
-    for (const Pass& pass : passes) {
-        requiredBatchDataBufferSize = std::max(requiredBatchDataBufferSize, pass.batchDataSize);
-    }
-    DAWN_TRY(batchDataBuffer.EnsureCapacity(requiredBatchDataBufferSize));
+    DAWN_TRY(batchDataBuffer.EnsureCapacity(batchDataSize));
     usageTracker->BufferUsedAs(batchDataBuffer.GetBuffer(), wgpu::BufferUsage::Storage);
 
     DAWN_TRY(outputParamsBuffer.EnsureCapacity(outputParamsSize));
     usageTracker->BufferUsedAs(outputParamsBuffer.GetBuffer(), wgpu::BufferUsage::Indirect);
 
     // Now we allocate and populate host-side batch data to be copied to the GPU.
-    for (Pass& pass : passes) {
-        // We use std::malloc here because it guarantees maximal scalar alignment.
-        pass.batchData = {std::malloc(pass.batchDataSize), std::free};
-        memset(pass.batchData.get(), 0, pass.batchDataSize);
-        uint8_t* batchData = static_cast<uint8_t*>(pass.batchData.get());
-        for (Batch& batch : pass.batches) {
-            batch.batchInfo = new (&batchData[batch.dataBufferOffset]) BatchInfo();
-            batch.batchInfo->numIndexBufferElements = batch.numIndexBufferElements;
-            batch.batchInfo->numDraws = static_cast<uint32_t>(batch.metadata->draws.size());
-            batch.batchInfo->flags = pass.flags;
-
-            uint32_t* indirectOffsets = reinterpret_cast<uint32_t*>(batch.batchInfo + 1);
-            uint64_t outputParamsOffset = batch.outputParamsOffset;
-            for (auto& draw : batch.metadata->draws) {
-                // The shader uses this to index an array of u32, hence the division by 4 bytes.
-                *indirectOffsets++ =
-                    static_cast<uint32_t>((draw.inputBufferOffset - batch.inputIndirectOffset) / 4);
-
-                draw.cmd->indirectBuffer = outputParamsBuffer.GetBuffer();
-                draw.cmd->indirectOffset = outputParamsOffset;
-                if (pass.flags & kIndexedDraw) {
-                    outputParamsOffset += kDrawIndexedIndirectSize;
-                } else {
-                    outputParamsOffset += kDrawIndirectSize;
-                }
+    // We use std::malloc here because it guarantees maximal scalar alignment.
+    std::unique_ptr<void, void (*)(void*)> batchDataAllocation{std::malloc(batchDataSize),
+                                                               std::free};
+    memset(batchDataAllocation.get(), 0, batchDataSize);
+    uint8_t* batchData = static_cast<uint8_t*>(batchDataAllocation.get());
+    for (Batch& batch : batches) {
+        batch.batchInfo = new (&batchData[batch.dataBufferOffset]) BatchInfo();
+        batch.batchInfo->numIndexBufferElements = batch.numIndexBufferElements;
+        batch.batchInfo->numDraws = static_cast<uint32_t>(batch.metadata->draws.size());
+        batch.batchInfo->flags = batch.flags;
+
+        uint32_t* indirectOffsets = reinterpret_cast<uint32_t*>(batch.batchInfo + 1);
+        uint64_t outputParamsOffset = batch.outputParamsOffset;
+        for (auto& draw : batch.metadata->draws) {
+            // The shader uses this to index an array of u32, hence the division by 4 bytes.
+            *indirectOffsets++ =
+                static_cast<uint32_t>((draw.inputBufferOffset - batch.inputIndirectOffset) / 4);
+
+            draw.cmd->indirectBuffer = outputParamsBuffer.GetBuffer();
+            draw.cmd->indirectOffset = outputParamsOffset;
+            if (batch.flags & kIndexedDraw) {
+                outputParamsOffset += kDrawIndexedIndirectSize;
+            } else {
+                outputParamsOffset += kDrawIndirectSize;
             }
         }
     }
@@ -412,40 +388,34 @@ MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
     bindGroupDescriptor.entryCount = 3;
     bindGroupDescriptor.entries = bindings;
 
-    // Finally, we can now encode our validation and duplication passes. Each pass first does a
-    // two WriteBuffer to get batch and pass data over to the GPU, followed by a single compute
-    // pass. The compute pass encodes a separate SetBindGroup and Dispatch command for each
-    // batch.
-    for (const Pass& pass : passes) {
-        commandEncoder->APIWriteBuffer(batchDataBuffer.GetBuffer(), 0,
-                                       static_cast<const uint8_t*>(pass.batchData.get()),
-                                       pass.batchDataSize);
-
-        Ref<ComputePassEncoder> passEncoder = commandEncoder->BeginComputePass();
-        passEncoder->APISetPipeline(pipeline);
-
-        inputIndirectBinding.buffer = pass.inputIndirectBuffer;
-
-        for (const Batch& batch : pass.batches) {
-            bufferDataBinding.offset = batch.dataBufferOffset;
-            bufferDataBinding.size = batch.dataSize;
-            inputIndirectBinding.offset = batch.inputIndirectOffset;
-            inputIndirectBinding.size = batch.inputIndirectSize;
-            outputParamsBinding.offset = batch.outputParamsOffset;
-            outputParamsBinding.size = batch.outputParamsSize;
-
-            Ref<BindGroupBase> bindGroup;
-            DAWN_TRY_ASSIGN(bindGroup, device->CreateBindGroup(&bindGroupDescriptor));
-
-            const uint32_t numDrawsRoundedUp =
-                (batch.batchInfo->numDraws + kWorkgroupSize - 1) / kWorkgroupSize;
-            passEncoder->APISetBindGroup(0, bindGroup.Get());
-            passEncoder->APIDispatchWorkgroups(numDrawsRoundedUp);
-        }
-
-        passEncoder->APIEnd();
+    // Finally, we can now encode our validation and duplication work. A single WriteBuffer
+    // gets all batch data over to the GPU, followed by a single compute pass which encodes a
+    // separate SetBindGroup and Dispatch command for each batch.
+    commandEncoder->APIWriteBuffer(batchDataBuffer.GetBuffer(), 0, batchData, batchDataSize);
+
+    Ref<ComputePassEncoder> passEncoder = commandEncoder->BeginComputePass();
+    passEncoder->APISetPipeline(pipeline);
+
+    for (const Batch& batch : batches) {
+        bufferDataBinding.offset = batch.dataBufferOffset;
+        bufferDataBinding.size = batch.dataSize;
+        inputIndirectBinding.buffer = batch.inputIndirectBuffer;
+        inputIndirectBinding.offset = batch.inputIndirectOffset;
+        inputIndirectBinding.size = batch.inputIndirectSize;
+        outputParamsBinding.offset = batch.outputParamsOffset;
+        outputParamsBinding.size = batch.outputParamsSize;
+
+        Ref<BindGroupBase> bindGroup;
+        DAWN_TRY_ASSIGN(bindGroup, device->CreateBindGroup(&bindGroupDescriptor));
+
+        const uint32_t numDrawsRoundedUp =
+            (batch.batchInfo->numDraws + kWorkgroupSize - 1) / kWorkgroupSize;
+        passEncoder->APISetBindGroup(0, bindGroup.Get());
+        passEncoder->APIDispatchWorkgroups(numDrawsRoundedUp);
     }
 
+    passEncoder->APIEnd();
+
     return {};
 }
 
@@ -20,6 +20,7 @@
 #include "dawn/common/GPUInfo.h"
 #include "dawn/common/Log.h"
 #include "dawn/common/SystemUtils.h"
+#include "dawn/native/AsyncTask.h"
 #include "dawn/native/ChainUtils_autogen.h"
 #include "dawn/native/ErrorData.h"
 #include "dawn/native/Surface.h"
@@ -270,20 +271,71 @@ ResultOrError<Ref<AdapterBase>> InstanceBase::RequestAdapterInternal(
 }
 
 void InstanceBase::DiscoverDefaultAdapters() {
-    for (wgpu::BackendType b : IterateBitSet(GetEnabledBackends())) {
-        EnsureBackendConnection(b);
-    }
-
     if (mDiscoveredDefaultAdapters) {
         return;
     }
 
-    // Query and merge all default adapters for all backends
-    for (std::unique_ptr<BackendConnection>& backend : mBackends) {
-        std::vector<Ref<AdapterBase>> backendAdapters = backend->DiscoverDefaultAdapters();
+    // Gather one slot per backend that still needs connecting and/or querying for default
+    // adapters so that the results can be merged in a deterministic order no matter which
+    // worker finishes first.
+    struct BackendDiscovery {
+        wgpu::BackendType type;
+        BackendConnection* connection = nullptr;
+        std::unique_ptr<BackendConnection> newConnection;
+        std::vector<Ref<AdapterBase>> adapters;
+    };
+    std::vector<BackendDiscovery> discoveries;
+    for (wgpu::BackendType b : IterateBitSet(GetEnabledBackends())) {
+        BackendDiscovery discovery;
+        discovery.type = b;
+        if (mBackendsConnected[b]) {
+            for (std::unique_ptr<BackendConnection>& backend : mBackends) {
+                if (backend->GetType() == b) {
+                    discovery.connection = backend.get();
+                }
+            }
+            if (discovery.connection == nullptr) {
+                // The backend was tried before and failed to connect.
+                continue;
+            }
+        }
+        discoveries.push_back(std::move(discovery));
+    }
 
-        for (Ref<AdapterBase>& adapter : backendAdapters) {
-            ASSERT(adapter->GetBackendType() == backend->GetType());
+    auto DiscoverOneBackend = [this](BackendDiscovery* discovery) {
+        if (discovery->connection == nullptr) {
+            discovery->newConnection = CreateBackendConnection(discovery->type);
+            discovery->connection = discovery->newConnection.get();
+        }
+        if (discovery->connection != nullptr) {
+            discovery->adapters = discovery->connection->DiscoverDefaultAdapters();
+        }
+    };
+
+    // Connecting a backend loads its libraries and discovery queries the drivers; both are
+    // slow and independent between backends so they run on the worker pool when several
+    // backends need them. The backends only read from the instance while discovering (error
+    // logging aside) so the tasks don't race.
+    if (discoveries.size() > 1) {
+        std::unique_ptr<dawn::platform::WorkerTaskPool> workerTaskPool =
+            GetPlatform()->CreateWorkerTaskPool();
+        AsyncTaskManager taskManager(workerTaskPool.get());
+        for (BackendDiscovery& discovery : discoveries) {
+            taskManager.PostTask(
+                [&DiscoverOneBackend, &discovery] { DiscoverOneBackend(&discovery); });
+        }
+        taskManager.WaitAllPendingTasks();
+    } else if (!discoveries.empty()) {
+        DiscoverOneBackend(&discoveries[0]);
+    }
+
+    for (BackendDiscovery& discovery : discoveries) {
+        if (discovery.newConnection != nullptr) {
+            mBackends.push_back(std::move(discovery.newConnection));
+        }
+        mBackendsConnected.set(discovery.type);
+        for (Ref<AdapterBase>& adapter : discovery.adapters) {
+            ASSERT(adapter->GetBackendType() == discovery.type);
             ASSERT(adapter->GetInstance() == this);
             mAdapters.push_back(std::move(adapter));
         }
@@ -322,54 +374,44 @@ const std::vector<Ref<AdapterBase>>& InstanceBase::GetAdapters() const {
     return mAdapters;
 }
 
-void InstanceBase::EnsureBackendConnection(wgpu::BackendType backendType) {
-    if (mBackendsConnected[backendType]) {
-        return;
-    }
-
-    auto Register = [this](BackendConnection* connection, wgpu::BackendType expectedType) {
-        if (connection != nullptr) {
-            ASSERT(connection->GetType() == expectedType);
-            ASSERT(connection->GetInstance() == this);
-            mBackends.push_back(std::unique_ptr<BackendConnection>(connection));
-        }
-    };
+std::unique_ptr<BackendConnection> InstanceBase::CreateBackendConnection(
+    wgpu::BackendType backendType) {
+    BackendConnection* connection = nullptr;
 
     switch (backendType) {
 #if defined(DAWN_ENABLE_BACKEND_NULL)
         case wgpu::BackendType::Null:
-            Register(null::Connect(this), wgpu::BackendType::Null);
+            connection = null::Connect(this);
             break;
 #endif  // defined(DAWN_ENABLE_BACKEND_NULL)
 
 #if defined(DAWN_ENABLE_BACKEND_D3D12)
         case wgpu::BackendType::D3D12:
-            Register(d3d12::Connect(this), wgpu::BackendType::D3D12);
+            connection = d3d12::Connect(this);
             break;
 #endif  // defined(DAWN_ENABLE_BACKEND_D3D12)
 
 #if defined(DAWN_ENABLE_BACKEND_METAL)
         case wgpu::BackendType::Metal:
-            Register(metal::Connect(this), wgpu::BackendType::Metal);
+            connection = metal::Connect(this);
             break;
 #endif  // defined(DAWN_ENABLE_BACKEND_METAL)
 
 #if defined(DAWN_ENABLE_BACKEND_VULKAN)
         case wgpu::BackendType::Vulkan:
-            Register(vulkan::Connect(this), wgpu::BackendType::Vulkan);
+            connection = vulkan::Connect(this);
             break;
 #endif  // defined(DAWN_ENABLE_BACKEND_VULKAN)
 
 #if defined(DAWN_ENABLE_BACKEND_DESKTOP_GL)
         case wgpu::BackendType::OpenGL:
-            Register(opengl::Connect(this, wgpu::BackendType::OpenGL), wgpu::BackendType::OpenGL);
+            connection = opengl::Connect(this, wgpu::BackendType::OpenGL);
             break;
 #endif  // defined(DAWN_ENABLE_BACKEND_DESKTOP_GL)
 
 #if defined(DAWN_ENABLE_BACKEND_OPENGLES)
         case wgpu::BackendType::OpenGLES:
-            Register(opengl::Connect(this, wgpu::BackendType::OpenGLES),
-                     wgpu::BackendType::OpenGLES);
+            connection = opengl::Connect(this, wgpu::BackendType::OpenGLES);
             break;
 #endif  // defined(DAWN_ENABLE_BACKEND_OPENGLES)
 
@@ -377,6 +419,23 @@ void InstanceBase::EnsureBackendConnection(wgpu::BackendType backendType) {
             UNREACHABLE();
     }
 
+    if (connection != nullptr) {
+        ASSERT(connection->GetType() == backendType);
+        ASSERT(connection->GetInstance() == this);
+    }
+    return std::unique_ptr<BackendConnection>(connection);
+}
+
+void InstanceBase::EnsureBackendConnection(wgpu::BackendType backendType) {
+    if (mBackendsConnected[backendType]) {
+        return;
+    }
+
+    std::unique_ptr<BackendConnection> connection = CreateBackendConnection(backendType);
+    if (connection != nullptr) {
+        mBackends.push_back(std::move(connection));
+    }
+
     mBackendsConnected.set(backendType);
 }
 
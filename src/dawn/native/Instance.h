@@ -119,6 +119,10 @@ class InstanceBase final : public RefCountedWithExternalCount {
     MaybeError Initialize(const InstanceDescriptor* descriptor);
 
     // Lazily creates connections to all backends that have been compiled.
+    // Loads the backend's libraries and creates its connection, without registering it on the
+    // instance. Returns nullptr when the backend isn't available. Safe to call on a worker
+    // thread; only the registration of the result must happen on the instance's thread.
+    std::unique_ptr<BackendConnection> CreateBackendConnection(wgpu::BackendType backendType);
     void EnsureBackendConnection(wgpu::BackendType backendType);
 
     MaybeError DiscoverAdaptersInternal(const AdapterDiscoveryOptionsBase* options);
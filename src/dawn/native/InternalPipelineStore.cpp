@@ -27,7 +27,10 @@ class RenderPipelineBase;
 class ShaderModuleBase;
 
 InternalPipelineStore::InternalPipelineStore(DeviceBase* device)
-    : scratchStorage(device, wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Storage),
+    : scratchPool(device,
+                  wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst |
+                      wgpu::BufferUsage::Storage),
+      scratchStorage(device, wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Storage),
       scratchIndirectStorage(
           device,
           wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Indirect | wgpu::BufferUsage::Storage) {}
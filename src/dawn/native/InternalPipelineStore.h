@@ -34,13 +34,29 @@ struct InternalPipelineStore {
     explicit InternalPipelineStore(DeviceBase* device);
     ~InternalPipelineStore();
 
-    std::unordered_map<wgpu::TextureFormat, Ref<RenderPipelineBase>> copyTextureForBrowserPipelines;
+    // Keyed on the destination format and the conversion steps baked in the shader variant, see
+    // MakeCopyTextureForBrowserPipelineKey in CopyTextureForBrowserHelper.cpp.
+    std::unordered_map<uint64_t, Ref<RenderPipelineBase>> copyTextureForBrowserPipelines;
 
     Ref<ShaderModuleBase> copyTextureForBrowser;
 
+    // Pipelines of the mipmap generation helper, keyed on the texture format baked in the
+    // downsample shader's storage texture declaration.
+    std::unordered_map<wgpu::TextureFormat, Ref<ComputePipelineBase>> generateMipmapsPipelines;
+
     Ref<ComputePipelineBase> timestampComputePipeline;
     Ref<ShaderModuleBase> timestampCS;
 
+    // Pipeline of the compressed-texture upload path that lays raw blocks out at the row pitch
+    // required by the buffer-to-texture copy.
+    Ref<ComputePipelineBase> compressedBlockUploadPipeline;
+    Ref<ShaderModuleBase> compressedBlockUploadCS;
+
+    // A pool of scratch buffers (copy source/destination and storage binding) that transient
+    // internal operations lease per use instead of each holding their own buffer forever.
+    // Trimmed from DeviceBase::Tick.
+    ScratchBufferPool scratchPool;
+
     ApplyClearColorValueWithDrawPipelinesCache applyClearColorValueWithDrawPipelines;
 
     Ref<ShaderModuleBase> placeholderFragmentShader;
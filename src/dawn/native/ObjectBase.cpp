@@ -38,9 +38,11 @@ DeviceBase* ObjectBase::GetDevice() const {
 }
 
 ApiObjectBase::ApiObjectBase(DeviceBase* device, const char* label) : ObjectBase(device) {
+#if !defined(DAWN_STRIP_DEBUG_LABELS)
     if (label) {
         mLabel = label;
     }
+#endif
 }
 
 ApiObjectBase::ApiObjectBase(DeviceBase* device, ErrorTag tag) : ObjectBase(device, tag) {}
@@ -52,8 +54,12 @@ ApiObjectBase::~ApiObjectBase() {
 }
 
 void ApiObjectBase::APISetLabel(const char* label) {
+    // In builds that strip debug labels the label APIs are no-ops and error messages refer to
+    // unlabeled objects, avoiding per-object string traffic.
+#if !defined(DAWN_STRIP_DEBUG_LABELS)
     mLabel = label;
     SetLabelImpl();
+#endif
 }
 
 const std::string& ApiObjectBase::GetLabel() const {
@@ -16,6 +16,7 @@
 #define SRC_DAWN_NATIVE_OBJECTCONTENTHASHER_H_
 
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "dawn/common/HashUtils.h"
@@ -53,10 +54,19 @@ class ObjectContentHasher {
         }
     };
 
+    // Arithmetic and enum elements can be hashed as one contiguous range of bytes; structs are
+    // excluded because their padding bytes are unspecified.
+    template <typename T>
+    static constexpr bool kCanHashElementBytes = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
     template <typename T>
     struct RecordImpl<std::vector<T>> {
         static constexpr void Call(ObjectContentHasher* recorder, const std::vector<T>& vec) {
-            recorder->RecordIterable<std::vector<T>>(vec);
+            if constexpr (kCanHashElementBytes<T>) {
+                HashCombine(&recorder->mContentHash, HashBytes(vec.data(), vec.size() * sizeof(T)));
+            } else {
+                recorder->RecordIterable<std::vector<T>>(vec);
+            }
         }
     };
 
@@ -73,7 +83,8 @@ class ObjectContentHasher {
 template <>
 struct ObjectContentHasher::RecordImpl<std::string> {
     static constexpr void Call(ObjectContentHasher* recorder, const std::string& str) {
-        recorder->RecordIterable<std::string>(str);
+        // Shader sources are recorded through this path, so hash the characters in bulk.
+        HashCombine(&recorder->mContentHash, HashBytes(str.data(), str.size()));
     }
 };
 
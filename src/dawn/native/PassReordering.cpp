@@ -0,0 +1,414 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/PassReordering.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dawn/native/Buffer.h"
+#include "dawn/native/CommandAllocator.h"
+#include "dawn/native/Commands.h"
+#include "dawn/native/ExternalTexture.h"
+#include "dawn/native/PassResourceUsage.h"
+#include "dawn/native/RenderBundle.h"
+#include "dawn/native/Texture.h"
+
+namespace dawn::native {
+
+namespace {
+
+enum class SegmentKind {
+    RenderPass,
+    ComputePass,
+    Copy,
+    // Top-level commands that aren't analyzed; they keep their position and no segment may
+    // move across them.
+    Other,
+};
+
+// A contiguous run of commands that is relocated as a unit: a whole pass, a single copy
+// command, or a single unrecognized top-level command.
+struct Segment {
+    SegmentKind kind = SegmentKind::Other;
+    // When true the segment must not move relative to any other segment. Always true for
+    // SegmentKind::Other, and for passes that record queries, since query results depend on
+    // the ordering of writes across passes.
+    bool pinned = false;
+    // Index into CommandBufferResourceUsage::renderPasses or ::computePasses.
+    size_t passIndex = 0;
+    // The segment's commands, moved out of the original stream.
+    CommandAllocator commands;
+    // Resource identity -> true when the segment may write the resource.
+    std::unordered_map<const ObjectBase*, bool> accesses;
+};
+
+void AddAccess(Segment* segment, const ObjectBase* resource, bool writes) {
+    auto [it, inserted] = segment->accesses.emplace(resource, writes);
+    if (!inserted) {
+        it->second |= writes;
+    }
+}
+
+// Moves the next command of |type| from |iter| into |allocator| and returns the newly
+// allocated command. Trailing data blocks are moved along with their command.
+void* MoveCommand(CommandIterator* iter, Command type, CommandAllocator* allocator) {
+    switch (type) {
+#define MOVE_SIMPLE_COMMAND(TYPE)                                          \
+    case Command::TYPE: {                                                  \
+        TYPE##Cmd* cmd = iter->NextCommand<TYPE##Cmd>();                   \
+        TYPE##Cmd* moved = allocator->Allocate<TYPE##Cmd>(Command::TYPE);  \
+        *moved = std::move(*cmd);                                          \
+        return moved;                                                      \
+    }
+        MOVE_SIMPLE_COMMAND(BeginComputePass)
+        MOVE_SIMPLE_COMMAND(BeginOcclusionQuery)
+        MOVE_SIMPLE_COMMAND(BeginRenderPass)
+        MOVE_SIMPLE_COMMAND(ClearBuffer)
+        MOVE_SIMPLE_COMMAND(CopyBufferToBuffer)
+        MOVE_SIMPLE_COMMAND(CopyBufferToTexture)
+        MOVE_SIMPLE_COMMAND(CopyTextureToBuffer)
+        MOVE_SIMPLE_COMMAND(CopyTextureToTexture)
+        MOVE_SIMPLE_COMMAND(Dispatch)
+        MOVE_SIMPLE_COMMAND(DispatchIndirect)
+        MOVE_SIMPLE_COMMAND(Draw)
+        MOVE_SIMPLE_COMMAND(DrawIndexed)
+        MOVE_SIMPLE_COMMAND(DrawIndirect)
+        MOVE_SIMPLE_COMMAND(DrawIndexedIndirect)
+        MOVE_SIMPLE_COMMAND(MultiDrawIndirect)
+        MOVE_SIMPLE_COMMAND(MultiDrawIndexedIndirect)
+        MOVE_SIMPLE_COMMAND(EndComputePass)
+        MOVE_SIMPLE_COMMAND(EndOcclusionQuery)
+        MOVE_SIMPLE_COMMAND(EndRenderPass)
+        MOVE_SIMPLE_COMMAND(PopDebugGroup)
+        MOVE_SIMPLE_COMMAND(ResolveQuerySet)
+        MOVE_SIMPLE_COMMAND(SetComputePipeline)
+        MOVE_SIMPLE_COMMAND(SetRenderPipeline)
+        MOVE_SIMPLE_COMMAND(SetStencilReference)
+        MOVE_SIMPLE_COMMAND(SetViewport)
+        MOVE_SIMPLE_COMMAND(SetScissorRect)
+        MOVE_SIMPLE_COMMAND(SetBlendConstant)
+        MOVE_SIMPLE_COMMAND(SetIndexBuffer)
+        MOVE_SIMPLE_COMMAND(SetVertexBuffer)
+        MOVE_SIMPLE_COMMAND(WriteTimestamp)
+#undef MOVE_SIMPLE_COMMAND
+
+        case Command::ExecuteBundles: {
+            ExecuteBundlesCmd* cmd = iter->NextCommand<ExecuteBundlesCmd>();
+            ExecuteBundlesCmd* moved =
+                allocator->Allocate<ExecuteBundlesCmd>(Command::ExecuteBundles);
+            *moved = *cmd;
+            Ref<RenderBundleBase>* bundles = iter->NextData<Ref<RenderBundleBase>>(cmd->count);
+            Ref<RenderBundleBase>* movedBundles =
+                allocator->AllocateData<Ref<RenderBundleBase>>(cmd->count);
+            for (uint32_t i = 0; i < cmd->count; ++i) {
+                movedBundles[i] = std::move(bundles[i]);
+            }
+            return moved;
+        }
+
+        case Command::InsertDebugMarker: {
+            InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
+            InsertDebugMarkerCmd* moved =
+                allocator->Allocate<InsertDebugMarkerCmd>(Command::InsertDebugMarker);
+            *moved = *cmd;
+            const char* label = iter->NextData<char>(cmd->length + 1);
+            char* movedLabel = allocator->AllocateData<char>(cmd->length + 1);
+            memcpy(movedLabel, label, cmd->length + 1);
+            return moved;
+        }
+
+        case Command::PushDebugGroup: {
+            PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
+            PushDebugGroupCmd* moved =
+                allocator->Allocate<PushDebugGroupCmd>(Command::PushDebugGroup);
+            *moved = *cmd;
+            const char* label = iter->NextData<char>(cmd->length + 1);
+            char* movedLabel = allocator->AllocateData<char>(cmd->length + 1);
+            memcpy(movedLabel, label, cmd->length + 1);
+            return moved;
+        }
+
+        case Command::SetBindGroup: {
+            SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
+            uint32_t* movedOffsets = nullptr;
+            SetBindGroupCmd* moved = allocator->AllocateWithTrailingData<SetBindGroupCmd>(
+                Command::SetBindGroup, cmd->dynamicOffsetCount, &movedOffsets);
+            *moved = std::move(*cmd);
+            if (cmd->dynamicOffsetCount > 0) {
+                uint32_t* offsets = iter->NextTrailingData<uint32_t>(cmd->dynamicOffsetCount);
+                memcpy(movedOffsets, offsets, cmd->dynamicOffsetCount * sizeof(uint32_t));
+            }
+            return moved;
+        }
+
+        case Command::WriteBuffer: {
+            WriteBufferCmd* cmd = iter->NextCommand<WriteBufferCmd>();
+            WriteBufferCmd* moved = allocator->Allocate<WriteBufferCmd>(Command::WriteBuffer);
+            *moved = std::move(*cmd);
+            uint8_t* data = iter->NextData<uint8_t>(moved->size);
+            uint8_t* movedData = allocator->AllocateData<uint8_t>(moved->size);
+            memcpy(movedData, data, moved->size);
+            return moved;
+        }
+    }
+    UNREACHABLE();
+}
+
+bool IsWritableBufferUsage(wgpu::BufferUsage usage) {
+    return (usage & ~kReadOnlyBufferUsages) != 0;
+}
+
+bool IsWritableTextureUsage(wgpu::TextureUsage usage) {
+    return (usage & ~kReadOnlyTextureUsages) != 0;
+}
+
+void AddSyncScopeAccesses(Segment* segment, const SyncScopeResourceUsage& scope) {
+    for (size_t i = 0; i < scope.buffers.size(); ++i) {
+        AddAccess(segment, scope.buffers[i], IsWritableBufferUsage(scope.bufferUsages[i]));
+    }
+    for (size_t i = 0; i < scope.textures.size(); ++i) {
+        wgpu::TextureUsage combinedUsage = wgpu::TextureUsage::None;
+        scope.textureUsages[i].Iterate(
+            [&](const SubresourceRange&, wgpu::TextureUsage usage) { combinedUsage |= usage; });
+        AddAccess(segment, scope.textures[i], IsWritableTextureUsage(combinedUsage));
+    }
+    // External textures are only ever sampled.
+    for (ExternalTextureBase* externalTexture : scope.externalTextures) {
+        AddAccess(segment, externalTexture, false);
+    }
+}
+
+// Two segments conflict when they cannot be reordered across each other: pinned segments
+// conflict with everything, otherwise there must be a resource both access with at least one
+// of the accesses being a write.
+bool SegmentsConflict(const Segment& a, const Segment& b) {
+    if (a.pinned || b.pinned) {
+        return true;
+    }
+    const Segment& small = a.accesses.size() <= b.accesses.size() ? a : b;
+    const Segment& large = a.accesses.size() <= b.accesses.size() ? b : a;
+    for (const auto& [resource, writes] : small.accesses) {
+        auto it = large.accesses.find(resource);
+        if (it != large.accesses.end() && (writes || it->second)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // anonymous namespace
+
+void ReorderPassesToReduceBarriers(CommandIterator* commands,
+                                   CommandBufferResourceUsage* resourceUsages) {
+    // Split the stream into segments, moving each segment's commands into its own allocator so
+    // that the segments can be reassembled in any order afterwards.
+    std::vector<Segment> segments;
+    size_t nextRenderPassIndex = 0;
+    size_t nextComputePassIndex = 0;
+
+    Command type;
+    while (commands->NextCommandId(&type)) {
+        Segment& segment = segments.emplace_back();
+        switch (type) {
+            case Command::BeginRenderPass: {
+                segment.kind = SegmentKind::RenderPass;
+                segment.passIndex = nextRenderPassIndex++;
+                const RenderPassResourceUsage& usage =
+                    resourceUsages->renderPasses[segment.passIndex];
+                AddSyncScopeAccesses(&segment, usage);
+                segment.pinned = !usage.querySets.empty();
+
+                BeginRenderPassCmd* cmd = static_cast<BeginRenderPassCmd*>(
+                    MoveCommand(commands, type, &segment.commands));
+                if (cmd->beginTimestamp.querySet != nullptr ||
+                    cmd->endTimestamp.querySet != nullptr) {
+                    segment.pinned = true;
+                }
+                while (commands->NextCommandId(&type)) {
+                    if (type == Command::WriteTimestamp) {
+                        segment.pinned = true;
+                    }
+                    MoveCommand(commands, type, &segment.commands);
+                    if (type == Command::EndRenderPass) {
+                        break;
+                    }
+                }
+                break;
+            }
+
+            case Command::BeginComputePass: {
+                segment.kind = SegmentKind::ComputePass;
+                segment.passIndex = nextComputePassIndex++;
+                const ComputePassResourceUsage& usage =
+                    resourceUsages->computePasses[segment.passIndex];
+                for (const SyncScopeResourceUsage& scope : usage.dispatchUsages) {
+                    AddSyncScopeAccesses(&segment, scope);
+                }
+
+                BeginComputePassCmd* cmd = static_cast<BeginComputePassCmd*>(
+                    MoveCommand(commands, type, &segment.commands));
+                if (cmd->beginTimestamp.querySet != nullptr ||
+                    cmd->endTimestamp.querySet != nullptr) {
+                    segment.pinned = true;
+                }
+                while (commands->NextCommandId(&type)) {
+                    if (type == Command::WriteTimestamp) {
+                        segment.pinned = true;
+                    }
+                    MoveCommand(commands, type, &segment.commands);
+                    if (type == Command::EndComputePass) {
+                        break;
+                    }
+                }
+                break;
+            }
+
+            case Command::CopyBufferToBuffer: {
+                segment.kind = SegmentKind::Copy;
+                auto* cmd = static_cast<CopyBufferToBufferCmd*>(
+                    MoveCommand(commands, type, &segment.commands));
+                AddAccess(&segment, cmd->source.Get(), false);
+                AddAccess(&segment, cmd->destination.Get(), true);
+                break;
+            }
+
+            case Command::CopyBufferToTexture: {
+                segment.kind = SegmentKind::Copy;
+                auto* cmd = static_cast<CopyBufferToTextureCmd*>(
+                    MoveCommand(commands, type, &segment.commands));
+                AddAccess(&segment, cmd->source.buffer.Get(), false);
+                AddAccess(&segment, cmd->destination.texture.Get(), true);
+                break;
+            }
+
+            case Command::CopyTextureToBuffer: {
+                segment.kind = SegmentKind::Copy;
+                auto* cmd = static_cast<CopyTextureToBufferCmd*>(
+                    MoveCommand(commands, type, &segment.commands));
+                AddAccess(&segment, cmd->source.texture.Get(), false);
+                AddAccess(&segment, cmd->destination.buffer.Get(), true);
+                break;
+            }
+
+            case Command::CopyTextureToTexture: {
+                segment.kind = SegmentKind::Copy;
+                auto* cmd = static_cast<CopyTextureToTextureCmd*>(
+                    MoveCommand(commands, type, &segment.commands));
+                AddAccess(&segment, cmd->source.texture.Get(), false);
+                AddAccess(&segment, cmd->destination.texture.Get(), true);
+                break;
+            }
+
+            case Command::ClearBuffer: {
+                segment.kind = SegmentKind::Copy;
+                auto* cmd =
+                    static_cast<ClearBufferCmd*>(MoveCommand(commands, type, &segment.commands));
+                AddAccess(&segment, cmd->buffer.Get(), true);
+                break;
+            }
+
+            default: {
+                // WriteBuffer, ResolveQuerySet, debug commands: keep in place and act as a
+                // reordering barrier.
+                segment.kind = SegmentKind::Other;
+                segment.pinned = true;
+                MoveCommand(commands, type, &segment.commands);
+                break;
+            }
+        }
+    }
+
+    // Destroy the now moved-from commands and release the original blocks.
+    FreeCommands(commands);
+
+    // Build the ordering constraints between segments.
+    const size_t segmentCount = segments.size();
+    std::vector<std::vector<size_t>> dependents(segmentCount);
+    std::vector<size_t> dependencyCounts(segmentCount, 0);
+    for (size_t j = 0; j < segmentCount; ++j) {
+        for (size_t i = 0; i < j; ++i) {
+            if (SegmentsConflict(segments[i], segments[j])) {
+                dependents[i].push_back(j);
+                dependencyCounts[j]++;
+            }
+        }
+    }
+
+    // Greedy list scheduling: among the segments whose dependencies are all satisfied, prefer
+    // one of the same kind as the previously emitted segment so that copies batch with copies
+    // and compute batches with compute, then fall back to the earliest segment in submission
+    // order to keep the result stable.
+    std::vector<size_t> order;
+    order.reserve(segmentCount);
+    std::vector<bool> scheduled(segmentCount, false);
+    SegmentKind lastKind = SegmentKind::Other;
+    for (size_t step = 0; step < segmentCount; ++step) {
+        size_t picked = segmentCount;
+        for (size_t i = 0; i < segmentCount; ++i) {
+            if (scheduled[i] || dependencyCounts[i] != 0) {
+                continue;
+            }
+            if (picked == segmentCount) {
+                picked = i;
+            }
+            if (segments[i].kind == lastKind && lastKind != SegmentKind::Other) {
+                picked = i;
+                break;
+            }
+        }
+        ASSERT(picked < segmentCount);
+        scheduled[picked] = true;
+        order.push_back(picked);
+        lastKind = segments[picked].kind;
+        for (size_t dependent : dependents[picked]) {
+            dependencyCounts[dependent]--;
+        }
+    }
+
+    // Reassemble the command stream and permute the per-pass usages to match.
+    std::vector<CommandAllocator> allocators;
+    allocators.reserve(segmentCount);
+    RenderPassUsages reorderedRenderPasses;
+    reorderedRenderPasses.reserve(resourceUsages->renderPasses.size());
+    ComputePassUsages reorderedComputePasses;
+    reorderedComputePasses.reserve(resourceUsages->computePasses.size());
+    for (size_t i : order) {
+        Segment& segment = segments[i];
+        switch (segment.kind) {
+            case SegmentKind::RenderPass:
+                reorderedRenderPasses.push_back(
+                    std::move(resourceUsages->renderPasses[segment.passIndex]));
+                break;
+            case SegmentKind::ComputePass:
+                reorderedComputePasses.push_back(
+                    std::move(resourceUsages->computePasses[segment.passIndex]));
+                break;
+            case SegmentKind::Copy:
+            case SegmentKind::Other:
+                break;
+        }
+        allocators.push_back(std::move(segment.commands));
+    }
+    resourceUsages->renderPasses = std::move(reorderedRenderPasses);
+    resourceUsages->computePasses = std::move(reorderedComputePasses);
+
+    CommandIterator reorderedCommands;
+    reorderedCommands.AcquireCommandBlocks(std::move(allocators));
+    *commands = std::move(reorderedCommands);
+}
+
+}  // namespace dawn::native
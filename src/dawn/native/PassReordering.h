@@ -0,0 +1,36 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_PASSREORDERING_H_
+#define SRC_DAWN_NATIVE_PASSREORDERING_H_
+
+namespace dawn::native {
+
+class CommandIterator;
+struct CommandBufferResourceUsage;
+
+// Reorders the independent top-level segments (render passes, compute passes and copies) of a
+// finished command stream so that segments with similar resource usage end up adjacent,
+// reducing the number of usage transitions the backends emit. Segments are only moved across
+// each other when their resource accesses cannot conflict, so the reordered stream is
+// observationally equivalent to the original. Segments that touch queries or that aren't
+// recognized (debug commands, WriteBuffer, ResolveQuerySet) keep their position and act as
+// reordering barriers. The per-pass entries of |resourceUsages| are permuted to match the new
+// command order, since backends consume them sequentially during translation.
+void ReorderPassesToReduceBarriers(CommandIterator* commands,
+                                   CommandBufferResourceUsage* resourceUsages);
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_PASSREORDERING_H_
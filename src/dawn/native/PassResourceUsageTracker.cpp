@@ -14,6 +14,8 @@
 
 #include "dawn/native/PassResourceUsageTracker.h"
 
+#include <algorithm>
+#include <atomic>
 #include <utility>
 
 #include "dawn/native/BindGroup.h"
@@ -26,7 +28,69 @@
 
 namespace dawn::native {
 
-SyncScopeUsageTracker::SyncScopeUsageTracker() = default;
+namespace {
+
+// Each sync scope gets a unique serial to tag tracked resources with; 0 is reserved to mean
+// "never tracked". The counter is atomic because passes for different devices may be built on
+// different threads; the tags themselves follow the external synchronization of encoding.
+uint64_t NextSyncScopeSerial() {
+    static std::atomic<uint64_t> sNextSerial{1};
+    return sNextSerial.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Resource pointers are heap-allocated objects so their low bits carry no entropy; fold the
+// high bits down before the table masks the hash to its capacity.
+size_t HashResourcePointer(const void* key) {
+    uintptr_t h = reinterpret_cast<uintptr_t>(key);
+    return static_cast<size_t>((h >> 4) ^ (h >> 20));
+}
+
+}  // anonymous namespace
+
+uint32_t UsageTrackerIndexTable::Find(const void* key) const {
+    if (mSlots.empty()) {
+        return kInvalidIndex;
+    }
+    const size_t mask = mSlots.size() - 1;
+    for (size_t slot = HashResourcePointer(key) & mask;; slot = (slot + 1) & mask) {
+        if (mSlots[slot].key == key) {
+            return mSlots[slot].index;
+        }
+        if (mSlots[slot].key == nullptr) {
+            return kInvalidIndex;
+        }
+    }
+}
+
+void UsageTrackerIndexTable::Insert(const void* key, uint32_t index) {
+    // Grow at 75% load so probe sequences stay short.
+    if ((mCount + 1) * 4 > mSlots.size() * 3) {
+        std::vector<Slot> oldSlots = std::move(mSlots);
+        mSlots.assign(std::max(size_t(16), oldSlots.size() * 2), Slot());
+        mCount = 0;
+        for (const Slot& slot : oldSlots) {
+            if (slot.key != nullptr) {
+                Insert(slot.key, slot.index);
+            }
+        }
+    }
+
+    const size_t mask = mSlots.size() - 1;
+    size_t slot = HashResourcePointer(key) & mask;
+    while (mSlots[slot].key != nullptr) {
+        ASSERT(mSlots[slot].key != key);
+        slot = (slot + 1) & mask;
+    }
+    mSlots[slot] = {key, index};
+    mCount++;
+}
+
+void UsageTrackerIndexTable::Clear() {
+    std::fill(mSlots.begin(), mSlots.end(), Slot());
+    mCount = 0;
+}
+
+SyncScopeUsageTracker::SyncScopeUsageTracker() : mSerial(NextSyncScopeSerial()) {}
 
 SyncScopeUsageTracker::SyncScopeUsageTracker(SyncScopeUsageTracker&&) = default;
 
@@ -35,24 +99,54 @@ SyncScopeUsageTracker::~SyncScopeUsageTracker() = default;
 SyncScopeUsageTracker& SyncScopeUsageTracker::operator=(SyncScopeUsageTracker&&) = default;
 
 void SyncScopeUsageTracker::BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage) {
-    // std::map's operator[] will create the key and return 0 if the key didn't exist
-    // before.
-    mBufferUsages[buffer] |= usage;
+    // Repeat insertions in the same scope are the overwhelmingly common case (the same bind
+    // group bound for every draw); the tag on the buffer makes them a single compare.
+    if (buffer->mLastUsageTrackerSerial == mSerial) {
+        mBufferEntries[buffer->mLastUsageTrackerIndex].usage |= usage;
+        return;
+    }
+
+    uint32_t index = mBufferIndices.Find(buffer);
+    if (index == UsageTrackerIndexTable::kInvalidIndex) {
+        index = static_cast<uint32_t>(mBufferEntries.size());
+        mBufferEntries.push_back({buffer, usage});
+        mBufferIndices.Insert(buffer, index);
+    } else {
+        mBufferEntries[index].usage |= usage;
+    }
+    buffer->mLastUsageTrackerSerial = mSerial;
+    buffer->mLastUsageTrackerIndex = index;
+}
+
+TextureSubresourceUsage* SyncScopeUsageTracker::GetOrCreateTextureUsage(TextureBase* texture) {
+    if (texture->mLastUsageTrackerSerial == mSerial) {
+        return &mTextureEntries[texture->mLastUsageTrackerIndex].usage;
+    }
+
+    uint32_t index = mTextureIndices.Find(texture);
+    if (index == UsageTrackerIndexTable::kInvalidIndex) {
+        // Create a new TextureSubresourceUsage for that texture (initially filled with
+        // wgpu::TextureUsage::None)
+        index = static_cast<uint32_t>(mTextureEntries.size());
+        mTextureEntries.push_back(
+            {texture, TextureSubresourceUsage(texture->GetFormat().aspects,
+                                              texture->GetArrayLayers(),
+                                              texture->GetNumMipLevels(),
+                                              wgpu::TextureUsage::None)});
+        mTextureIndices.Insert(texture, index);
+    }
+    texture->mLastUsageTrackerSerial = mSerial;
+    texture->mLastUsageTrackerIndex = index;
+    return &mTextureEntries[index].usage;
 }
 
 void SyncScopeUsageTracker::TextureViewUsedAs(TextureViewBase* view, wgpu::TextureUsage usage) {
     TextureBase* texture = view->GetTexture();
     const SubresourceRange& range = view->GetSubresourceRange();
 
-    // Get or create a new TextureSubresourceUsage for that texture (initially filled with
-    // wgpu::TextureUsage::None)
-    auto it = mTextureUsages.emplace(
-        std::piecewise_construct, std::forward_as_tuple(texture),
-        std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                              texture->GetNumMipLevels(), wgpu::TextureUsage::None));
-    TextureSubresourceUsage& textureUsage = it.first->second;
+    TextureSubresourceUsage* textureUsage = GetOrCreateTextureUsage(texture);
 
-    textureUsage.Update(range, [usage](const SubresourceRange&, wgpu::TextureUsage* storedUsage) {
+    textureUsage->Update(range, [usage](const SubresourceRange&, wgpu::TextureUsage* storedUsage) {
         // TODO(crbug.com/dawn/1001): Consider optimizing to have fewer
         // branches.
         if ((*storedUsage & wgpu::TextureUsage::RenderAttachment) != 0 &&
@@ -70,13 +164,7 @@ void SyncScopeUsageTracker::TextureViewUsedAs(TextureViewBase* view, wgpu::Textu
 void SyncScopeUsageTracker::AddRenderBundleTextureUsage(
     TextureBase* texture,
     const TextureSubresourceUsage& textureUsage) {
-    // Get or create a new TextureSubresourceUsage for that texture (initially filled with
-    // wgpu::TextureUsage::None)
-    auto it = mTextureUsages.emplace(
-        std::piecewise_construct, std::forward_as_tuple(texture),
-        std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                              texture->GetNumMipLevels(), wgpu::TextureUsage::None));
-    TextureSubresourceUsage* passTextureUsage = &it.first->second;
+    TextureSubresourceUsage* passTextureUsage = GetOrCreateTextureUsage(texture);
 
     passTextureUsage->Merge(textureUsage,
                             [](const SubresourceRange&, wgpu::TextureUsage* storedUsage,
@@ -145,31 +233,49 @@ void SyncScopeUsageTracker::AddBindGroup(BindGroupBase* group) {
     }
 }
 
+void SyncScopeUsageTracker::AddSyncScopeUsage(const SyncScopeResourceUsage& usage) {
+    for (size_t i = 0; i < usage.buffers.size(); ++i) {
+        BufferUsedAs(usage.buffers[i], usage.bufferUsages[i]);
+    }
+    for (size_t i = 0; i < usage.textures.size(); ++i) {
+        AddRenderBundleTextureUsage(usage.textures[i], usage.textureUsages[i]);
+    }
+    for (ExternalTextureBase* externalTexture : usage.externalTextures) {
+        mExternalTextureUsages.insert(externalTexture);
+    }
+}
+
 SyncScopeResourceUsage SyncScopeUsageTracker::AcquireSyncScopeUsage() {
     SyncScopeResourceUsage result;
-    result.buffers.reserve(mBufferUsages.size());
-    result.bufferUsages.reserve(mBufferUsages.size());
-    result.textures.reserve(mTextureUsages.size());
-    result.textureUsages.reserve(mTextureUsages.size());
-
-    for (auto& [buffer, usage] : mBufferUsages) {
-        result.buffers.push_back(buffer);
-        result.bufferUsages.push_back(usage);
+    result.buffers.reserve(mBufferEntries.size());
+    result.bufferUsages.reserve(mBufferEntries.size());
+    result.textures.reserve(mTextureEntries.size());
+    result.textureUsages.reserve(mTextureEntries.size());
+
+    for (BufferUsageEntry& entry : mBufferEntries) {
+        result.buffers.push_back(entry.buffer);
+        result.bufferUsages.push_back(entry.usage);
     }
 
-    for (auto& [texture, usage] : mTextureUsages) {
-        result.textures.push_back(texture);
-        result.textureUsages.push_back(std::move(usage));
+    for (TextureUsageEntry& entry : mTextureEntries) {
+        result.textures.push_back(entry.texture);
+        result.textureUsages.push_back(std::move(entry.usage));
     }
 
     for (auto* const it : mExternalTextureUsages) {
         result.externalTextures.push_back(it);
     }
 
-    mBufferUsages.clear();
-    mTextureUsages.clear();
+    mBufferEntries.clear();
+    mTextureEntries.clear();
+    mBufferIndices.Clear();
+    mTextureIndices.Clear();
     mExternalTextureUsages.clear();
 
+    // Stale tags from the acquired scope must not hit on later insertions; retire the serial
+    // instead of walking every tracked resource to clear its tag.
+    mSerial = NextSyncScopeSerial();
+
     return result;
 }
 
@@ -181,6 +287,16 @@ void ComputePassResourceUsageTracker::AddDispatch(SyncScopeResourceUsage scope)
     mUsage.dispatchUsages.push_back(std::move(scope));
 }
 
+void ComputePassResourceUsageTracker::ReplaceDispatch(size_t dispatchIndex,
+                                                      SyncScopeResourceUsage scope) {
+    ASSERT(dispatchIndex < mUsage.dispatchUsages.size());
+    mUsage.dispatchUsages[dispatchIndex] = std::move(scope);
+}
+
+size_t ComputePassResourceUsageTracker::GetDispatchCount() const {
+    return mUsage.dispatchUsages.size();
+}
+
 void ComputePassResourceUsageTracker::AddReferencedBuffer(BufferBase* buffer) {
     mUsage.referencedBuffers.insert(buffer);
 }
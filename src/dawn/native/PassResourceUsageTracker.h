@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_PASSRESOURCEUSAGETRACKER_H_
 #define SRC_DAWN_NATIVE_PASSRESOURCEUSAGETRACKER_H_
 
+#include <cstdint>
 #include <map>
 #include <set>
 #include <vector>
@@ -33,6 +34,29 @@ class TextureBase;
 
 using QueryAvailabilityMap = std::map<QuerySetBase*, std::vector<bool>>;
 
+// Open-addressing table from a resource pointer to its slot in a tracker's flat entry vectors.
+// Linear probing over a power-of-two capacity; keys are never removed individually, only
+// cleared wholesale when the scope usage is acquired, which keeps the allocation for reuse.
+class UsageTrackerIndexTable {
+  public:
+    static constexpr uint32_t kInvalidIndex = ~uint32_t(0);
+
+    // Returns the slot stored for |key|, or kInvalidIndex if the key is absent.
+    uint32_t Find(const void* key) const;
+    // Inserts |key| -> |index|. The key must not be present already.
+    void Insert(const void* key, uint32_t index);
+    void Clear();
+
+  private:
+    struct Slot {
+        const void* key = nullptr;
+        uint32_t index = 0;
+    };
+
+    std::vector<Slot> mSlots;
+    size_t mCount = 0;
+};
+
 // Helper class to build SyncScopeResourceUsages
 class SyncScopeUsageTracker {
   public:
@@ -50,12 +74,38 @@ class SyncScopeUsageTracker {
     // Walks the bind groups and tracks all its resources.
     void AddBindGroup(BindGroupBase* group);
 
+    // Merges an already-acquired scope usage into this tracker. Used when several
+    // synchronization scopes are folded into one.
+    void AddSyncScopeUsage(const SyncScopeResourceUsage& usage);
+
     // Returns the per-pass usage for use by backends for APIs with explicit barriers.
     SyncScopeResourceUsage AcquireSyncScopeUsage();
 
   private:
-    std::map<BufferBase*, wgpu::BufferUsage> mBufferUsages;
-    std::map<TextureBase*, TextureSubresourceUsage> mTextureUsages;
+    struct BufferUsageEntry {
+        BufferBase* buffer;
+        wgpu::BufferUsage usage;
+    };
+    struct TextureUsageEntry {
+        TextureBase* texture;
+        TextureSubresourceUsage usage;
+    };
+
+    // Returns the usage tracked for |texture|, creating an entry filled with
+    // wgpu::TextureUsage::None if the texture wasn't tracked yet. The returned pointer is
+    // invalidated by the next call.
+    TextureSubresourceUsage* GetOrCreateTextureUsage(TextureBase* texture);
+
+    // Usages are stored as flat entry vectors with an open-addressing index table on the side
+    // instead of tree maps: passes insert the same few hundred resources thousands of times
+    // and the rebalancing and pointer chasing of std::map is measurable. The serial identifies
+    // this scope in the tag left on each tracked resource (see BufferBase and TextureBase); a
+    // matching tag turns a repeat insertion into a single compare and an indexed update.
+    uint64_t mSerial;
+    std::vector<BufferUsageEntry> mBufferEntries;
+    std::vector<TextureUsageEntry> mTextureEntries;
+    UsageTrackerIndexTable mBufferIndices;
+    UsageTrackerIndexTable mTextureIndices;
     std::set<ExternalTextureBase*> mExternalTextureUsages;
 };
 
@@ -66,6 +116,10 @@ class ComputePassResourceUsageTracker {
     ~ComputePassResourceUsageTracker();
 
     void AddDispatch(SyncScopeResourceUsage scope);
+    // Replaces the scope recorded for a dispatch. Used when the scopes of several dispatches
+    // are merged into the scope of the first one.
+    void ReplaceDispatch(size_t dispatchIndex, SyncScopeResourceUsage scope);
+    size_t GetDispatchCount() const;
     void AddReferencedBuffer(BufferBase* buffer);
     void AddResourcesReferencedByBindGroup(BindGroupBase* group);
 
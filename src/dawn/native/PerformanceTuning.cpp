@@ -0,0 +1,59 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/PerformanceTuning.h"
+
+#include "dawn/common/GPUInfo.h"
+
+namespace dawn::native {
+
+PerformanceTuningProfile GetDefaultTuningProfile(uint32_t vendorId,
+                                                 wgpu::AdapterType adapterType) {
+    PerformanceTuningProfile profile = {};
+
+    switch (adapterType) {
+        case wgpu::AdapterType::IntegratedGPU:
+            // Integrated GPUs share memory bandwidth with the CPU and typically run smaller
+            // workloads, so halve the staging and sub-allocation chunk sizes to reduce the
+            // shared memory footprint without giving up sub-allocation.
+            profile.uploaderRingBufferSize = 1 * 1024 * 1024;
+            profile.d3d12MinResourceHeapSize = 2ull * 1024ull * 1024ull;
+            profile.vulkanSubAllocationHeapSize = 4ull * 1024ull * 1024ull;
+            if (gpu_info::IsIntel(vendorId)) {
+                // Intel drivers keep descriptor heaps in system memory where switching heaps
+                // is disproportionately expensive; start with a larger view heap to avoid
+                // switches instead of growing into one mid-frame.
+                profile.d3d12ViewShaderVisibleHeapSize = 8192;
+            }
+            break;
+
+        case wgpu::AdapterType::CPU:
+            // Software adapters exist mostly for testing; keep every pool small so many
+            // devices can coexist in a single test process.
+            profile.uploaderRingBufferSize = 512 * 1024;
+            profile.d3d12MaxCommandAllocators = 32;
+            profile.d3d12MinResourceHeapSize = 1024 * 1024;
+            profile.vulkanSubAllocationHeapSize = 4ull * 1024ull * 1024ull;
+            break;
+
+        case wgpu::AdapterType::DiscreteGPU:
+        case wgpu::AdapterType::Unknown:
+            // Keep the historical defaults.
+            break;
+    }
+
+    return profile;
+}
+
+}  // namespace dawn::native
@@ -0,0 +1,51 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_PERFORMANCETUNING_H_
+#define SRC_DAWN_NATIVE_PERFORMANCETUNING_H_
+
+#include <cstdint>
+
+#include "dawn/native/dawn_platform.h"
+
+namespace dawn::native {
+
+// Tuned defaults for the allocator and pool sizes that used to be hard-coded per backend. A
+// profile is selected from the vendor and adapter type when the adapter initializes; each knob
+// keeps the historical discrete-GPU value as its default so unrecognized hardware behaves
+// exactly as before. Backends ignore the knobs that do not apply to them.
+struct PerformanceTuningProfile {
+    // Size of the rings in DynamicUploader serving small allocations. Must be a power of two.
+    uint64_t uploaderRingBufferSize = 4 * 1024 * 1024;
+    // Number of pooled D3D12 command allocators after which a reservation waits on in-flight
+    // work instead of growing the pool.
+    uint32_t d3d12MaxCommandAllocators = 256;
+    // Initial sizes of the D3D12 shader-visible descriptor heaps. The heaps still grow on
+    // demand up to the D3D12 tier limits.
+    uint32_t d3d12ViewShaderVisibleHeapSize = 4096;
+    uint32_t d3d12SamplerShaderVisibleHeapSize = 256;
+    // Smallest heap the D3D12 buddy sub-allocators place resources in. Must be a power of two.
+    uint64_t d3d12MinResourceHeapSize = 4ull * 1024ull * 1024ull;
+    // Size of the VkDeviceMemory chunks the Vulkan sub-allocators carve up. Must be a power of
+    // two, and large enough to hold the biggest sub-allocated resource (4MB).
+    uint64_t vulkanSubAllocationHeapSize = 8ull * 1024ull * 1024ull;
+};
+
+// Returns the profile tuned for the given hardware, falling back to the discrete-GPU defaults
+// when the hardware is not recognized.
+PerformanceTuningProfile GetDefaultTuningProfile(uint32_t vendorId, wgpu::AdapterType adapterType);
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_PERFORMANCETUNING_H_
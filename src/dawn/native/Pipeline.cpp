@@ -35,6 +35,9 @@ MaybeError ValidateProgrammableStage(DeviceBase* device,
                                      SingleShaderStage stage) {
     DAWN_TRY(device->ValidateObject(module));
 
+    // Reflection data isn't available until a deferred parse has completed.
+    DAWN_TRY(module->EnsureParsed());
+
     DAWN_INVALID_IF(!module->HasEntryPoint(entryPoint),
                     "Entry point \"%s\" doesn't exist in the shader module %s.", entryPoint,
                     module);
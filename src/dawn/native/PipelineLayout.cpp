@@ -232,8 +232,8 @@ ResultOrError<Ref<PipelineLayoutBase>> PipelineLayoutBase::CreateDefault(
 
     // Creates the BGL from the entries for a stage, checking it is valid.
     auto CreateBGL = [](DeviceBase* device, const EntryMap& entries,
-                        PipelineCompatibilityToken pipelineCompatibilityToken)
-        -> ResultOrError<Ref<BindGroupLayoutBase>> {
+                        PipelineCompatibilityToken pipelineCompatibilityToken,
+                        bool validate) -> ResultOrError<Ref<BindGroupLayoutBase>> {
         std::vector<BindGroupLayoutEntry> entryVec;
         entryVec.reserve(entries.size());
         for (auto& [_, entry] : entries) {
@@ -244,7 +244,7 @@ ResultOrError<Ref<PipelineLayoutBase>> PipelineLayoutBase::CreateDefault(
         desc.entries = entryVec.data();
         desc.entryCount = entryVec.size();
 
-        if (device->IsValidationEnabled()) {
+        if (validate && device->IsValidationEnabled()) {
             DAWN_TRY_CONTEXT(ValidateBindGroupLayoutDescriptor(device, &desc), "validating %s",
                              &desc);
         }
@@ -253,47 +253,71 @@ ResultOrError<Ref<PipelineLayoutBase>> PipelineLayoutBase::CreateDefault(
 
     ASSERT(!stages.empty());
 
-    // Data which BindGroupLayoutDescriptor will point to for creation
-    ityp::array<BindGroupIndex, std::map<BindingNumber, BindGroupLayoutEntry>, kMaxBindGroups>
-        entryData = {};
+    // Reflection only depends on the participating entry points, and shader modules are
+    // deduplicated by content hash, so the merged entry tables can be memoized on the device.
+    // Tooling that creates many ad-hoc pipelines without explicit layouts otherwise re-runs
+    // the inference and its validation on every creation.
+    std::string fingerprint;
+    {
+        auto AppendBytes = [&](const void* data, size_t size) {
+            fingerprint.append(static_cast<const char*>(data), size);
+        };
+        for (const StageAndDescriptor& stage : stages) {
+            size_t moduleHash = stage.module->GetContentHash();
+            size_t entryPointLength = stage.entryPoint.length();
+            AppendBytes(&stage.shaderStage, sizeof(stage.shaderStage));
+            AppendBytes(&moduleHash, sizeof(moduleHash));
+            AppendBytes(&entryPointLength, sizeof(entryPointLength));
+            fingerprint.append(stage.entryPoint);
+        }
+    }
+    const DefaultPipelineLayoutEntryData* cachedEntries =
+        device->GetCachedDefaultPipelineLayoutEntries(fingerprint);
 
     // External texture binding layouts are chained structs that are set as a pointer within
-    // the bind group layout entry. We declare an entry here so that it can be used when needed
-    // in each BindGroupLayoutEntry and so it can stay alive until the call to
-    // GetOrCreateBindGroupLayout. Because ExternalTextureBindingLayout is an empty struct,
-    // there's no issue with using the same struct multiple times.
-    ExternalTextureBindingLayout externalTextureBindingLayout;
-
-    // Loops over all the reflected BindGroupLayoutEntries from shaders.
-    for (const StageAndDescriptor& stage : stages) {
-        const EntryPointMetadata& metadata = stage.module->GetEntryPoint(stage.entryPoint);
+    // the bind group layout entry. We declare a static entry here so that it can be used when
+    // needed in each BindGroupLayoutEntry, including the ones that outlive this call in the
+    // device's memo of inferred entries. Because ExternalTextureBindingLayout is an empty
+    // struct, there's no issue with using the same struct multiple times.
+    static ExternalTextureBindingLayout externalTextureBindingLayout;
 
-        for (BindGroupIndex group(0); group < metadata.bindings.size(); ++group) {
-            for (const auto& [bindingNumber, shaderBinding] : metadata.bindings[group]) {
-                // Create the BindGroupLayoutEntry
-                BindGroupLayoutEntry entry =
-                    ConvertMetadataToEntry(shaderBinding, &externalTextureBindingLayout);
-                entry.binding = static_cast<uint32_t>(bindingNumber);
-                entry.visibility = StageBit(stage.shaderStage);
-
-                // Add it to our map of all entries, if there is an existing entry, then we
-                // need to merge, if we can.
-                const auto& [existingEntry, inserted] =
-                    entryData[group].insert({bindingNumber, entry});
-                if (!inserted) {
-                    DAWN_TRY(MergeEntries(&existingEntry->second, entry));
+    // Data which BindGroupLayoutDescriptor will point to for creation
+    DefaultPipelineLayoutEntryData inferred;
+    if (cachedEntries == nullptr) {
+        // Loops over all the reflected BindGroupLayoutEntries from shaders.
+        for (const StageAndDescriptor& stage : stages) {
+            const EntryPointMetadata& metadata = stage.module->GetEntryPoint(stage.entryPoint);
+
+            for (BindGroupIndex group(0); group < metadata.bindings.size(); ++group) {
+                for (const auto& [bindingNumber, shaderBinding] : metadata.bindings[group]) {
+                    // Create the BindGroupLayoutEntry
+                    BindGroupLayoutEntry entry =
+                        ConvertMetadataToEntry(shaderBinding, &externalTextureBindingLayout);
+                    entry.binding = static_cast<uint32_t>(bindingNumber);
+                    entry.visibility = StageBit(stage.shaderStage);
+
+                    // Add it to our map of all entries, if there is an existing entry, then we
+                    // need to merge, if we can.
+                    const auto& [existingEntry, inserted] =
+                        inferred.entries[group].insert({bindingNumber, entry});
+                    if (!inserted) {
+                        DAWN_TRY(MergeEntries(&existingEntry->second, entry));
+                    }
                 }
             }
-        }
 
-        // Promote any Unfilterable textures used with a sampler to Filtering.
-        for (const EntryPointMetadata::SamplerTexturePair& pair : metadata.samplerTexturePairs) {
-            BindGroupLayoutEntry* entry = &entryData[pair.texture.group][pair.texture.binding];
-            if (entry->texture.sampleType == wgpu::TextureSampleType::UnfilterableFloat) {
-                entry->texture.sampleType = wgpu::TextureSampleType::Float;
+            // Promote any Unfilterable textures used with a sampler to Filtering.
+            for (const EntryPointMetadata::SamplerTexturePair& pair :
+                 metadata.samplerTexturePairs) {
+                BindGroupLayoutEntry* entry =
+                    &inferred.entries[pair.texture.group][pair.texture.binding];
+                if (entry->texture.sampleType == wgpu::TextureSampleType::UnfilterableFloat) {
+                    entry->texture.sampleType = wgpu::TextureSampleType::Float;
+                }
             }
         }
     }
+    const auto& entryData = (cachedEntries != nullptr) ? cachedEntries->entries : inferred.entries;
 
     // Create the bind group layouts. We need to keep track of the last non-empty BGL because
     // Dawn doesn't yet know that an empty BGL and a null BGL are the same thing.
@@ -302,8 +326,10 @@ ResultOrError<Ref<PipelineLayoutBase>> PipelineLayoutBase::CreateDefault(
     BindGroupIndex pipelineBGLCount = BindGroupIndex(0);
     ityp::array<BindGroupIndex, Ref<BindGroupLayoutBase>, kMaxBindGroups> bindGroupLayouts = {};
     for (BindGroupIndex group(0); group < kMaxBindGroupsTyped; ++group) {
+        // Entries coming from the memo already passed validation when they were first created.
         DAWN_TRY_ASSIGN(bindGroupLayouts[group],
-                        CreateBGL(device, entryData[group], pipelineCompatibilityToken));
+                        CreateBGL(device, entryData[group], pipelineCompatibilityToken,
+                                  cachedEntries == nullptr));
         if (entryData[group].size() != 0) {
             pipelineBGLCount = group + BindGroupIndex(1);
         }
@@ -325,6 +351,12 @@ ResultOrError<Ref<PipelineLayoutBase>> PipelineLayoutBase::CreateDefault(
     DAWN_TRY_ASSIGN(result, device->GetOrCreatePipelineLayout(&desc));
     ASSERT(!result->IsError());
 
+    // Only memoize entries that made it through the whole creation, so that reuse may safely
+    // skip re-validating them.
+    if (cachedEntries == nullptr) {
+        device->CacheDefaultPipelineLayoutEntries(std::move(fingerprint), std::move(inferred));
+    }
+
     // Check in debug that the pipeline layout is compatible with the current pipeline.
     for (const StageAndDescriptor& stage : stages) {
         const EntryPointMetadata& metadata = stage.module->GetEntryPoint(stage.entryPoint);
@@ -17,6 +17,7 @@
 
 #include <array>
 #include <bitset>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -49,6 +50,15 @@ struct StageAndDescriptor {
     ConstantEntry const* constants = nullptr;
 };
 
+// The merged per-group BindGroupLayoutEntry tables inferred from shader reflection when a
+// pipeline is created without an explicit layout. Cached on the device keyed on the
+// participating entry points so that repeated layout-less pipeline creations skip re-running
+// the inference and its validation (see PipelineLayoutBase::CreateDefault).
+struct DefaultPipelineLayoutEntryData {
+    ityp::array<BindGroupIndex, std::map<BindingNumber, BindGroupLayoutEntry>, kMaxBindGroups>
+        entries = {};
+};
+
 class PipelineLayoutBase : public ApiObjectBase, public CachedObject {
   public:
     PipelineLayoutBase(DeviceBase* device,
@@ -54,6 +54,12 @@ MaybeError ProgrammableEncoder::ValidateProgrammableEncoderEnd() const {
 }
 
 void ProgrammableEncoder::APIInsertDebugMarker(const char* groupLabel) {
+#if defined(DAWN_STRIP_DEBUG_LABELS)
+    // Stripped builds drop the marker but still validate the encoder state.
+    mEncodingContext->TryEncode(
+        this, [](CommandAllocator*) -> MaybeError { return {}; },
+        "encoding %s.InsertDebugMarker(\"%s\").", this, groupLabel);
+#else
     mEncodingContext->TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
@@ -67,6 +73,7 @@ void ProgrammableEncoder::APIInsertDebugMarker(const char* groupLabel) {
             return {};
         },
         "encoding %s.InsertDebugMarker(\"%s\").", this, groupLabel);
+#endif
 }
 
 void ProgrammableEncoder::APIPopDebugGroup() {
@@ -77,9 +84,13 @@ void ProgrammableEncoder::APIPopDebugGroup() {
                 DAWN_INVALID_IF(mDebugGroupStackSize == 0,
                                 "PopDebugGroup called when no debug groups are currently pushed.");
             }
+#if defined(DAWN_STRIP_DEBUG_LABELS)
+            DAWN_UNUSED(allocator);
+#else
             allocator->Allocate<PopDebugGroupCmd>(Command::PopDebugGroup);
-            mDebugGroupStackSize--;
             mEncodingContext->PopDebugGroupLabel();
+#endif
+            mDebugGroupStackSize--;
 
             return {};
         },
@@ -90,6 +101,9 @@ void ProgrammableEncoder::APIPushDebugGroup(const char* groupLabel) {
     mEncodingContext->TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
+#if defined(DAWN_STRIP_DEBUG_LABELS)
+            DAWN_UNUSED(allocator);
+#else
             PushDebugGroupCmd* cmd =
                 allocator->Allocate<PushDebugGroupCmd>(Command::PushDebugGroup);
             cmd->length = strlen(groupLabel);
@@ -97,8 +111,9 @@ void ProgrammableEncoder::APIPushDebugGroup(const char* groupLabel) {
             char* label = allocator->AllocateData<char>(cmd->length + 1);
             memcpy(label, groupLabel, cmd->length + 1);
 
-            mDebugGroupStackSize++;
             mEncodingContext->PushDebugGroupLabel(groupLabel);
+#endif
+            mDebugGroupStackSize++;
 
             return {};
         },
@@ -186,12 +201,13 @@ void ProgrammableEncoder::RecordSetBindGroup(CommandAllocator* allocator,
                                              BindGroupBase* group,
                                              uint32_t dynamicOffsetCount,
                                              const uint32_t* dynamicOffsets) const {
-    SetBindGroupCmd* cmd = allocator->Allocate<SetBindGroupCmd>(Command::SetBindGroup);
+    uint32_t* offsets = nullptr;
+    SetBindGroupCmd* cmd = allocator->AllocateWithTrailingData<SetBindGroupCmd>(
+        Command::SetBindGroup, dynamicOffsetCount, &offsets);
     cmd->index = index;
     cmd->group = group;
     cmd->dynamicOffsetCount = dynamicOffsetCount;
     if (dynamicOffsetCount > 0) {
-        uint32_t* offsets = allocator->AllocateData<uint32_t>(cmd->dynamicOffsetCount);
         memcpy(offsets, dynamicOffsets, dynamicOffsetCount * sizeof(uint32_t));
     }
 }
@@ -31,12 +31,14 @@ namespace dawn::native {
 
 namespace {
 
-// Assert the offsets in dawn::native::TimestampParams are same with the ones in the shader
-static_assert(offsetof(dawn::native::TimestampParams, first) == 0);
-static_assert(offsetof(dawn::native::TimestampParams, count) == 4);
-static_assert(offsetof(dawn::native::TimestampParams, offset) == 8);
-static_assert(offsetof(dawn::native::TimestampParams, multiplier) == 12);
-static_assert(offsetof(dawn::native::TimestampParams, rightShift) == 16);
+// Assert the offsets in dawn::native::TimestampParams and TimestampResolveRange are same with
+// the ones in the shader
+static_assert(offsetof(dawn::native::TimestampParams, multiplier) == 0);
+static_assert(offsetof(dawn::native::TimestampParams, rightShift) == 4);
+static_assert(offsetof(dawn::native::TimestampParams, rangeCount) == 8);
+static_assert(offsetof(dawn::native::TimestampResolveRange, first) == 0);
+static_assert(offsetof(dawn::native::TimestampResolveRange, count) == 4);
+static_assert(offsetof(dawn::native::TimestampResolveRange, offset) == 8);
 
 static const char sConvertTimestampsToNanoseconds[] = R"(
             struct Timestamp {
@@ -52,28 +54,49 @@ static const char sConvertTimestampsToNanoseconds[] = R"(
                 v : array<u32>
             }
 
-            struct TimestampParams {
+            struct RangeInfo {
                 first  : u32,
                 count  : u32,
                 offset : u32,
+            }
+
+            struct RangeArr {
+                r : array<RangeInfo>
+            }
+
+            struct TimestampParams {
                 multiplier : u32,
                 right_shift  : u32,
+                range_count : u32,
             }
 
             @group(0) @binding(0) var<storage, read_write> timestamps : TimestampArr;
             @group(0) @binding(1) var<storage, read> availability : AvailabilityArr;
             @group(0) @binding(2) var<uniform> params : TimestampParams;
+            @group(0) @binding(3) var<storage, read> ranges : RangeArr;
 
             let sizeofTimestamp : u32 = 8u;
 
             @compute @workgroup_size(8, 1, 1)
             fn main(@builtin(global_invocation_id) GlobalInvocationID : vec3<u32>) {
-                if (GlobalInvocationID.x >= params.count) { return; }
+                // Invocations are numbered across the concatenation of all the ranges; find
+                // which range this one falls in.
+                var remaining = GlobalInvocationID.x;
+                var rangeIndex = 0u;
+                loop {
+                    if (rangeIndex >= params.range_count) { return; }
+                    if (remaining < ranges.r[rangeIndex].count) { break; }
+                    remaining = remaining - ranges.r[rangeIndex].count;
+                    rangeIndex = rangeIndex + 1u;
+                }
+                let range = ranges.r[rangeIndex];
 
-                var index = GlobalInvocationID.x + params.offset / sizeofTimestamp;
+                var index = remaining + range.offset / sizeofTimestamp;
 
-                // Return 0 for the unavailable value.
-                if (availability.v[GlobalInvocationID.x + params.first] == 0u) {
+                // Return 0 for the unavailable value. The availability is a bitset with one
+                // bit per query of the query set.
+                let query = remaining + range.first;
+                if (((availability.v[query >> 5u] >> (query & 31u)) & 1u) == 0u) {
                     timestamps.t[index].low = 0u;
                     timestamps.t[index].high = 0u;
                     return;
@@ -135,6 +158,7 @@ ResultOrError<ComputePipelineBase*> GetOrCreateTimestampComputePipeline(DeviceBa
                          {0, wgpu::ShaderStage::Compute, kInternalStorageBufferBinding},
                          {1, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::ReadOnlyStorage},
                          {2, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform},
+                         {3, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::ReadOnlyStorage},
                      },
                      /* allowInternalBinding */ true));
 
@@ -158,8 +182,7 @@ ResultOrError<ComputePipelineBase*> GetOrCreateTimestampComputePipeline(DeviceBa
 
 }  // anonymous namespace
 
-TimestampParams::TimestampParams(uint32_t first, uint32_t count, uint32_t offset, float period)
-    : first(first), count(count), offset(offset) {
+TimestampParams::TimestampParams(uint32_t rangeCount, float period) : rangeCount(rangeCount) {
     // The overall conversion happening, if p is the period, m the multiplier, s the shift, is::
     //
     //   m = round(p * 2^s)
@@ -185,7 +208,9 @@ TimestampParams::TimestampParams(uint32_t first, uint32_t count, uint32_t offset
 MaybeError EncodeConvertTimestampsToNanoseconds(CommandEncoder* encoder,
                                                 BufferBase* timestamps,
                                                 BufferBase* availability,
-                                                BufferBase* params) {
+                                                BufferBase* ranges,
+                                                BufferBase* params,
+                                                uint32_t totalQueryCount) {
     DeviceBase* device = encoder->GetDevice();
 
     ComputePipelineBase* pipeline;
@@ -197,17 +222,17 @@ MaybeError EncodeConvertTimestampsToNanoseconds(CommandEncoder* encoder,
 
     // Create bind group after all binding entries are set.
     Ref<BindGroupBase> bindGroup;
-    DAWN_TRY_ASSIGN(
-        bindGroup,
-        utils::MakeBindGroup(device, layout, {{0, timestamps}, {1, availability}, {2, params}},
-                             UsageValidationMode::Internal));
+    DAWN_TRY_ASSIGN(bindGroup,
+                    utils::MakeBindGroup(
+                        device, layout,
+                        {{0, timestamps}, {1, availability}, {2, params}, {3, ranges}},
+                        UsageValidationMode::Internal));
 
     // Create compute encoder and issue dispatch.
     Ref<ComputePassEncoder> pass = encoder->BeginComputePass();
     pass->APISetPipeline(pipeline);
     pass->APISetBindGroup(0, bindGroup.Get());
-    pass->APIDispatchWorkgroups(
-        static_cast<uint32_t>((timestamps->GetSize() / sizeof(uint64_t) + 7) / 8));
+    pass->APIDispatchWorkgroups((totalQueryCount + 7) / 8);
     pass->APIEnd();
 
     return {};
@@ -23,20 +23,31 @@ namespace dawn::native {
 class BufferBase;
 class CommandEncoder;
 
+// One range of queries resolved into the timestamps buffer. A single conversion dispatch
+// covers any number of ranges.
+struct TimestampResolveRange {
+    uint32_t first;   // first query of the range in the query set
+    uint32_t count;   // number of queries in the range
+    uint32_t offset;  // byte offset of the range's resolved data in the timestamps buffer
+};
+
 struct TimestampParams {
-    TimestampParams(uint32_t first, uint32_t count, uint32_t offset, float period);
+    TimestampParams(uint32_t rangeCount, float period);
 
-    uint32_t first;
-    uint32_t count;
-    uint32_t offset;
     uint32_t multiplier;
     uint32_t rightShift;
+    uint32_t rangeCount;
 };
 
+// The availability buffer is a bitset with one bit per query of the query set, packed in u32
+// words. The ranges buffer holds `params.rangeCount` TimestampResolveRange entries and
+// `totalQueryCount` is the sum of their counts, used to size the dispatch.
 MaybeError EncodeConvertTimestampsToNanoseconds(CommandEncoder* encoder,
                                                 BufferBase* timestamps,
                                                 BufferBase* availability,
-                                                BufferBase* params);
+                                                BufferBase* ranges,
+                                                BufferBase* params,
+                                                uint32_t totalQueryCount);
 
 }  // namespace dawn::native
 
@@ -126,6 +126,9 @@ QuerySetBase::~QuerySetBase() {
 
 void QuerySetBase::DestroyImpl() {
     mState = QuerySetState::Destroyed;
+    // Command buffers referencing this query set may have a cached submit validation verdict
+    // that destruction invalidates.
+    GetDevice()->IncrementSubmitValidationGeneration();
 }
 
 // static
@@ -16,19 +16,23 @@
 
 #include <algorithm>
 #include <cstring>
+#include <mutex>
 #include <utility>
 #include <vector>
 
 #include "dawn/common/Constants.h"
+#include "dawn/common/WriteCombinedMemcpy.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/CommandValidation.h"
 #include "dawn/native/Commands.h"
+#include "dawn/native/CompressedTextureUploadHelper.h"
 #include "dawn/native/CopyTextureForBrowserHelper.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/DynamicUploader.h"
 #include "dawn/native/ExternalTexture.h"
+#include "dawn/native/GPUTimelineCapture.h"
 #include "dawn/native/ObjectType_autogen.h"
 #include "dawn/native/QuerySet.h"
 #include "dawn/native/RenderPassEncoder.h"
@@ -55,7 +59,7 @@ void CopyTextureData(uint8_t* dstPointer,
     if (!copyWholeLayer) {  // copy row by row
         for (uint32_t d = 0; d < depth; ++d) {
             for (uint32_t h = 0; h < rowsPerImage; ++h) {
-                memcpy(dstPointer, srcPointer, actualBytesPerRow);
+                MemcpyToWriteCombinedMemory(dstPointer, srcPointer, actualBytesPerRow);
                 dstPointer += dstBytesPerRow;
                 srcPointer += srcBytesPerRow;
             }
@@ -65,31 +69,19 @@ void CopyTextureData(uint8_t* dstPointer,
         uint64_t layerSize = uint64_t(rowsPerImage) * actualBytesPerRow;
         if (!copyWholeData) {  // copy layer by layer
             for (uint32_t d = 0; d < depth; ++d) {
-                memcpy(dstPointer, srcPointer, layerSize);
+                MemcpyToWriteCombinedMemory(dstPointer, srcPointer, layerSize);
                 dstPointer += layerSize;
                 srcPointer += layerSize + imageAdditionalStride;
             }
         } else {  // do a single copy
-            memcpy(dstPointer, srcPointer, layerSize * depth);
+            MemcpyToWriteCombinedMemory(dstPointer, srcPointer, layerSize * depth);
         }
     }
 }
 
-ResultOrError<UploadHandle> UploadTextureDataAligningBytesPerRowAndOffset(
-    DeviceBase* device,
-    const void* data,
-    uint32_t alignedBytesPerRow,
-    uint32_t optimallyAlignedBytesPerRow,
-    uint32_t alignedRowsPerImage,
-    const TextureDataLayout& dataLayout,
-    bool hasDepthOrStencil,
-    const TexelBlockInfo& blockInfo,
-    const Extent3D& writeSizePixel) {
-    uint64_t newDataSizeBytes;
-    DAWN_TRY_ASSIGN(newDataSizeBytes,
-                    ComputeRequiredBytesInCopy(blockInfo, writeSizePixel,
-                                               optimallyAlignedBytesPerRow, alignedRowsPerImage));
-
+uint64_t ComputeTextureCopyOffsetAlignment(DeviceBase* device,
+                                           const TexelBlockInfo& blockInfo,
+                                           bool hasDepthOrStencil) {
     uint64_t optimalOffsetAlignment = device->GetOptimalBufferToTextureCopyOffsetAlignment();
     ASSERT(IsPowerOfTwo(optimalOffsetAlignment));
     ASSERT(IsPowerOfTwo(blockInfo.byteSize));
@@ -103,14 +95,19 @@ ResultOrError<UploadHandle> UploadTextureDataAligningBytesPerRowAndOffset(
         offsetAlignment =
             std::max(offsetAlignment, device->GetBufferCopyOffsetAlignmentForDepthStencil());
     }
+    return offsetAlignment;
+}
 
-    UploadHandle uploadHandle;
-    DAWN_TRY_ASSIGN(uploadHandle,
-                    device->GetDynamicUploader()->Allocate(
-                        newDataSizeBytes, device->GetPendingCommandSerial(), offsetAlignment));
-    ASSERT(uploadHandle.mappedBuffer != nullptr);
-
-    uint8_t* dstPointer = static_cast<uint8_t*>(uploadHandle.mappedBuffer);
+// Repacks the rows of the written texture data into |dstPointer| at the optimally aligned
+// pitch expected by the GPU copy.
+void RepackTextureData(uint8_t* dstPointer,
+                       const void* data,
+                       uint32_t alignedBytesPerRow,
+                       uint32_t optimallyAlignedBytesPerRow,
+                       uint32_t alignedRowsPerImage,
+                       const TextureDataLayout& dataLayout,
+                       const TexelBlockInfo& blockInfo,
+                       const Extent3D& writeSizePixel) {
     const uint8_t* srcPointer = static_cast<const uint8_t*>(data);
     srcPointer += dataLayout.offset;
 
@@ -126,10 +123,43 @@ ResultOrError<UploadHandle> UploadTextureDataAligningBytesPerRowAndOffset(
     CopyTextureData(dstPointer, srcPointer, writeSizePixel.depthOrArrayLayers, alignedRowsPerImage,
                     imageAdditionalStride, alignedBytesPerRow, optimallyAlignedBytesPerRow,
                     dataLayout.bytesPerRow);
+}
+
+ResultOrError<UploadHandle> UploadTextureDataAligningBytesPerRowAndOffset(
+    DeviceBase* device,
+    const void* data,
+    uint32_t alignedBytesPerRow,
+    uint32_t optimallyAlignedBytesPerRow,
+    uint32_t alignedRowsPerImage,
+    const TextureDataLayout& dataLayout,
+    bool hasDepthOrStencil,
+    const TexelBlockInfo& blockInfo,
+    const Extent3D& writeSizePixel) {
+    uint64_t newDataSizeBytes;
+    DAWN_TRY_ASSIGN(newDataSizeBytes,
+                    ComputeRequiredBytesInCopy(blockInfo, writeSizePixel,
+                                               optimallyAlignedBytesPerRow, alignedRowsPerImage));
+
+    uint64_t offsetAlignment =
+        ComputeTextureCopyOffsetAlignment(device, blockInfo, hasDepthOrStencil);
+
+    UploadHandle uploadHandle;
+    DAWN_TRY_ASSIGN(uploadHandle,
+                    device->GetDynamicUploader()->Allocate(
+                        newDataSizeBytes, device->GetPendingCommandSerial(), offsetAlignment));
+    ASSERT(uploadHandle.mappedBuffer != nullptr);
+
+    RepackTextureData(static_cast<uint8_t*>(uploadHandle.mappedBuffer), data, alignedBytesPerRow,
+                      optimallyAlignedBytesPerRow, alignedRowsPerImage, dataLayout, blockInfo,
+                      writeSizePixel);
 
     return uploadHandle;
 }
 
+// Batched texture writes above this size flush immediately so a burst of writes cannot grow
+// the CPU-side accumulation buffer without bound.
+constexpr uint64_t kMaxBatchedTextureWriteBytes = 4 * 1024 * 1024;
+
 struct SubmittedWorkDone : QueueBase::TaskInFlight {
     SubmittedWorkDone(WGPUQueueWorkDoneCallback callback, void* userdata)
         : mCallback(callback), mUserdata(userdata) {}
@@ -163,6 +193,26 @@ class ErrorQueue : public QueueBase {
 };
 }  // namespace
 
+// The WriteTexture calls accumulated for one destination texture by the batch_texture_writes
+// toggle. The repacked data of every call is appended to |data| and becomes a single staging
+// allocation when the batch is flushed.
+struct QueueBase::TextureWriteBatch {
+    struct Copy {
+        // Offset of this write's repacked data within |data|.
+        uint64_t dataOffset;
+        TextureDataLayout dataLayout;
+        TextureCopy textureCopy;
+        Extent3D writeSizePixel;
+    };
+
+    Ref<TextureBase> texture;
+    std::vector<uint8_t> data;
+    // The largest offset alignment required by any copy in the batch. Alignments are powers
+    // of two, so an allocation aligned to the maximum satisfies every copy.
+    uint64_t offsetAlignment = 1;
+    std::vector<Copy> copies;
+};
+
 // QueueBase
 
 QueueBase::TaskInFlight::~TaskInFlight() {}
@@ -176,7 +226,9 @@ QueueBase::~QueueBase() {
     ASSERT(mTasksInFlight.Empty());
 }
 
-void QueueBase::DestroyImpl() {}
+void QueueBase::DestroyImpl() {
+    mTextureWriteBatches.clear();
+}
 
 // static
 QueueBase* QueueBase::MakeError(DeviceBase* device) {
@@ -191,7 +243,11 @@ void QueueBase::APISubmit(uint32_t commandCount, CommandBufferBase* const* comma
     SubmitInternal(commandCount, commands);
 
     for (uint32_t i = 0; i < commandCount; ++i) {
-        commands[i]->Destroy();
+        // Command buffers finished with a DawnCommandBufferReuseDescriptor stay alive so the
+        // same recorded work can be submitted again without re-encoding.
+        if (!commands[i]->AllowsMultipleSubmits()) {
+            commands[i]->Destroy();
+        }
     }
 }
 
@@ -205,6 +261,13 @@ void QueueBase::APIOnSubmittedWorkDone(uint64_t signalValue,
         return;
     }
 
+    // The in-flight task list is also ticked on the background tick thread.
+    std::lock_guard<std::recursive_mutex> lock(GetDevice()->GetTickMutex());
+
+    // Batched texture writes are queue work too; record them so the callback does not fire
+    // before they complete.
+    GetDevice()->ConsumedError(FlushPendingTextureWrites());
+
     std::unique_ptr<SubmittedWorkDone> task =
         std::make_unique<SubmittedWorkDone>(callback, userdata);
 
@@ -212,10 +275,10 @@ void QueueBase::APIOnSubmittedWorkDone(uint64_t signalValue,
     // also used to make sure ALL queue work is finished in tests, so we also wait for pending
     // commands (this is non-observable outside of tests so it's ok to do deviate a bit from the
     // spec).
-    TrackTask(std::move(task), GetDevice()->GetPendingCommandSerial());
+    TrackTask(std::move(task), GetPendingCommandSerial());
 
     TRACE_EVENT1(GetDevice()->GetPlatform(), General, "Queue::APIOnSubmittedWorkDone", "serial",
-                 uint64_t(GetDevice()->GetPendingCommandSerial()));
+                 uint64_t(GetPendingCommandSerial()));
 }
 
 void QueueBase::TrackTask(std::unique_ptr<TaskInFlight> task, ExecutionSerial serial) {
@@ -244,12 +307,25 @@ void QueueBase::Tick(ExecutionSerial finishedSerial) {
 }
 
 void QueueBase::HandleDeviceLoss() {
+    mTextureWriteBatches.clear();
     for (auto& task : mTasksInFlight.IterateAll()) {
         task->HandleDeviceLoss();
     }
     mTasksInFlight.Clear();
 }
 
+ExecutionSerial QueueBase::GetCompletedCommandSerial() const {
+    return GetDevice()->GetCompletedCommandSerial();
+}
+
+ExecutionSerial QueueBase::GetLastSubmittedCommandSerial() const {
+    return GetDevice()->GetLastSubmittedCommandSerial();
+}
+
+ExecutionSerial QueueBase::GetPendingCommandSerial() const {
+    return GetDevice()->GetPendingCommandSerial();
+}
+
 void QueueBase::APIWriteBuffer(BufferBase* buffer,
                                uint64_t bufferOffset,
                                const void* data,
@@ -280,13 +356,13 @@ MaybeError QueueBase::WriteBufferImpl(BufferBase* buffer,
 
     UploadHandle uploadHandle;
     DAWN_TRY_ASSIGN(uploadHandle,
-                    device->GetDynamicUploader()->Allocate(size, device->GetPendingCommandSerial(),
+                    device->GetDynamicUploader()->Allocate(size, GetPendingCommandSerial(),
                                                            kCopyBufferToBufferOffsetAlignment));
     ASSERT(uploadHandle.mappedBuffer != nullptr);
 
-    memcpy(uploadHandle.mappedBuffer, data, size);
+    MemcpyToWriteCombinedMemory(uploadHandle.mappedBuffer, data, size);
 
-    device->AddFutureSerial(device->GetPendingCommandSerial());
+    device->AddFutureSerial(GetPendingCommandSerial());
 
     return device->CopyFromStagingToBuffer(uploadHandle.stagingBuffer, uploadHandle.startOffset,
                                            buffer, bufferOffset, size);
@@ -326,6 +402,21 @@ MaybeError QueueBase::WriteTextureImpl(const ImageCopyTexture& destination,
     const Format& format = destination.texture->GetFormat();
     const TexelBlockInfo& blockInfo = format.GetAspectInfo(destination.aspect).block;
 
+    // Large block-compressed writes can skip the CPU row repacking below: the raw blocks are
+    // uploaded with one contiguous copy and an internal compute pass lays them out at the
+    // required row pitch on the GPU.
+    if (ShouldUploadCompressedDataWithCompute(GetDevice(), format, blockInfo, dataLayout,
+                                              writeSizePixel)) {
+        // Batched writes to the same texture may overlap this one and must land first.
+        DAWN_TRY(FlushPendingTextureWrites());
+        return UploadCompressedDataWithCompute(GetDevice(), data, dataLayout, destination,
+                                               writeSizePixel);
+    }
+
+    if (GetDevice()->IsToggleEnabled(Toggle::BatchTextureWrites)) {
+        return BatchWriteTexture(destination, data, dataLayout, writeSizePixel);
+    }
+
     // We are only copying the part of the data that will appear in the texture.
     // Note that validating texture copy range ensures that writeSizePixel->width and
     // writeSizePixel->height are multiples of blockWidth and blockHeight respectively.
@@ -356,12 +447,112 @@ MaybeError QueueBase::WriteTextureImpl(const ImageCopyTexture& destination,
 
     DeviceBase* device = GetDevice();
 
-    device->AddFutureSerial(device->GetPendingCommandSerial());
+    device->AddFutureSerial(GetPendingCommandSerial());
 
     return device->CopyFromStagingToTexture(uploadHandle.stagingBuffer, passDataLayout,
                                             &textureCopy, writeSizePixel);
 }
 
+MaybeError QueueBase::BatchWriteTexture(const ImageCopyTexture& destination,
+                                        const void* data,
+                                        const TextureDataLayout& dataLayout,
+                                        const Extent3D& writeSizePixel) {
+    DeviceBase* device = GetDevice();
+
+    // The batches may be flushed from a device tick on the background tick thread.
+    std::lock_guard<std::recursive_mutex> lock(device->GetTickMutex());
+
+    const Format& format = destination.texture->GetFormat();
+    const TexelBlockInfo& blockInfo = format.GetAspectInfo(destination.aspect).block;
+
+    ASSERT(writeSizePixel.width % blockInfo.width == 0);
+    ASSERT(writeSizePixel.height % blockInfo.height == 0);
+    uint32_t alignedBytesPerRow = writeSizePixel.width / blockInfo.width * blockInfo.byteSize;
+    uint32_t alignedRowsPerImage = writeSizePixel.height / blockInfo.height;
+    uint32_t optimallyAlignedBytesPerRow =
+        Align(alignedBytesPerRow, device->GetOptimalBytesPerRowAlignment());
+
+    uint64_t newDataSizeBytes;
+    DAWN_TRY_ASSIGN(newDataSizeBytes,
+                    ComputeRequiredBytesInCopy(blockInfo, writeSizePixel,
+                                               optimallyAlignedBytesPerRow, alignedRowsPerImage));
+
+    uint64_t offsetAlignment =
+        ComputeTextureCopyOffsetAlignment(device, blockInfo, format.HasDepthOrStencil());
+
+    TextureWriteBatch* batch = nullptr;
+    for (std::unique_ptr<TextureWriteBatch>& candidate : mTextureWriteBatches) {
+        if (candidate->texture.Get() == destination.texture) {
+            batch = candidate.get();
+            break;
+        }
+    }
+    if (batch == nullptr) {
+        mTextureWriteBatches.push_back(std::make_unique<TextureWriteBatch>());
+        batch = mTextureWriteBatches.back().get();
+        batch->texture = destination.texture;
+    }
+    batch->offsetAlignment = std::max(batch->offsetAlignment, offsetAlignment);
+
+    uint64_t dataOffset = Align(uint64_t(batch->data.size()), offsetAlignment);
+    batch->data.resize(dataOffset + newDataSizeBytes);
+    RepackTextureData(batch->data.data() + dataOffset, data, alignedBytesPerRow,
+                      optimallyAlignedBytesPerRow, alignedRowsPerImage, dataLayout, blockInfo,
+                      writeSizePixel);
+
+    TextureWriteBatch::Copy copy;
+    copy.dataOffset = dataOffset;
+    copy.dataLayout = dataLayout;
+    copy.dataLayout.offset = 0;  // Patched with the staging offset at flush time.
+    copy.dataLayout.bytesPerRow = optimallyAlignedBytesPerRow;
+    copy.dataLayout.rowsPerImage = alignedRowsPerImage;
+    copy.textureCopy.texture = destination.texture;
+    copy.textureCopy.mipLevel = destination.mipLevel;
+    copy.textureCopy.origin = destination.origin;
+    copy.textureCopy.aspect = ConvertAspect(format, destination.aspect);
+    copy.writeSizePixel = writeSizePixel;
+    batch->copies.push_back(std::move(copy));
+
+    device->AddFutureSerial(GetPendingCommandSerial());
+
+    if (uint64_t(batch->data.size()) >= kMaxBatchedTextureWriteBytes) {
+        return FlushPendingTextureWrites();
+    }
+    return {};
+}
+
+MaybeError QueueBase::FlushPendingTextureWrites() {
+    DeviceBase* device = GetDevice();
+    std::lock_guard<std::recursive_mutex> lock(device->GetTickMutex());
+
+    if (mTextureWriteBatches.empty()) {
+        return {};
+    }
+
+    // Steal the list so a reentrant flush cannot see half-recorded batches.
+    std::vector<std::unique_ptr<TextureWriteBatch>> batches = std::move(mTextureWriteBatches);
+    mTextureWriteBatches.clear();
+
+    for (std::unique_ptr<TextureWriteBatch>& batch : batches) {
+        UploadHandle uploadHandle;
+        DAWN_TRY_ASSIGN(uploadHandle, device->GetDynamicUploader()->Allocate(
+                                          batch->data.size(), device->GetPendingCommandSerial(),
+                                          batch->offsetAlignment));
+        ASSERT(uploadHandle.mappedBuffer != nullptr);
+
+        MemcpyToWriteCombinedMemory(uploadHandle.mappedBuffer, batch->data.data(),
+                                    batch->data.size());
+
+        for (TextureWriteBatch::Copy& copy : batch->copies) {
+            TextureDataLayout passDataLayout = copy.dataLayout;
+            passDataLayout.offset = uploadHandle.startOffset + copy.dataOffset;
+            DAWN_TRY(device->CopyFromStagingToTexture(uploadHandle.stagingBuffer, passDataLayout,
+                                                      &copy.textureCopy, copy.writeSizePixel));
+        }
+    }
+    return {};
+}
+
 void QueueBase::APICopyTextureForBrowser(const ImageCopyTexture* source,
                                          const ImageCopyTexture* destination,
                                          const Extent3D* copySize,
@@ -393,6 +584,15 @@ MaybeError QueueBase::ValidateSubmit(uint32_t commandCount,
         DAWN_TRY(GetDevice()->ValidateObject(commands[i]));
         DAWN_TRY(commands[i]->ValidateCanUseInSubmitNow());
 
+        // The walk below only rejects referenced resources that are destroyed or mapped. If it
+        // passed on an earlier submit and no resource on the device has been destroyed or
+        // mapped since, the verdict cannot have changed, which makes resubmitting the same
+        // command buffers O(1) per buffer instead of proportional to the resources they use.
+        const uint64_t validationGeneration = GetDevice()->GetSubmitValidationGeneration();
+        if (commands[i]->GetSubmitValidationCacheGeneration() == validationGeneration) {
+            continue;
+        }
+
         const CommandBufferResourceUsage& usages = commands[i]->GetResourceUsages();
 
         for (const SyncScopeResourceUsage& scope : usages.renderPasses) {
@@ -430,6 +630,8 @@ MaybeError QueueBase::ValidateSubmit(uint32_t commandCount,
         for (const QuerySetBase* querySet : usages.usedQuerySets) {
             DAWN_TRY(querySet->ValidateCanUseInSubmitNow());
         }
+
+        commands[i]->SetSubmitValidationCacheGeneration(validationGeneration);
     }
 
     return {};
@@ -488,11 +690,21 @@ MaybeError QueueBase::ValidateWriteTexture(const ImageCopyTexture* destination,
 
 void QueueBase::SubmitInternal(uint32_t commandCount, CommandBufferBase* const* commands) {
     DeviceBase* device = GetDevice();
+
+    // Serialize the submission against device ticks, which may happen on the background tick
+    // thread. Uncontended when the enable_background_device_tick toggle is off.
+    std::lock_guard<std::recursive_mutex> lock(device->GetTickMutex());
+
     if (device->ConsumedError(device->ValidateIsAlive())) {
         // If device is lost, don't let any commands be submitted
         return;
     }
 
+    // Batched texture writes must be recorded before the commands submitted below.
+    if (device->ConsumedError(FlushPendingTextureWrites())) {
+        return;
+    }
+
     TRACE_EVENT0(device->GetPlatform(), General, "Queue::Submit");
     if (device->IsValidationEnabled() &&
         device->ConsumedError(ValidateSubmit(commandCount, commands))) {
@@ -503,6 +715,16 @@ void QueueBase::SubmitInternal(uint32_t commandCount, CommandBufferBase* const*
     if (device->ConsumedError(SubmitImpl(commandCount, commands))) {
         return;
     }
+
+    GPUTimelineCapture* capture = device->GetGPUTimelineCapture();
+    if (capture != nullptr) {
+        for (uint32_t i = 0; i < commandCount; ++i) {
+            capture->EnqueuePasses(commands[i]->AcquireTimelinePasses());
+        }
+        // The flush submits an internal command buffer, re-entering SubmitInternal; the
+        // capture's in-flight flag makes that recursion a no-op.
+        device->ConsumedError(capture->FlushAfterSubmit());
+    }
 }
 
 }  // namespace dawn::native
@@ -16,6 +16,7 @@
 #define SRC_DAWN_NATIVE_QUEUE_H_
 
 #include <memory>
+#include <vector>
 
 #include "dawn/common/SerialQueue.h"
 #include "dawn/native/Error.h"
@@ -67,12 +68,35 @@ class QueueBase : public ApiObjectBase {
     void Tick(ExecutionSerial finishedSerial);
     void HandleDeviceLoss();
 
+    // Records the staging copies of WriteTexture calls accumulated by the
+    // batch_texture_writes toggle. Must run before the pending commands are submitted;
+    // submits, OnSubmittedWorkDone, device ticks and texture destruction are the flush
+    // points. A no-op when nothing is batched.
+    MaybeError FlushPendingTextureWrites();
+
+    // Serial timeline accessors. Today every queue shares the device-global timeline, so these
+    // delegate to the device; queue-related code should still query serials through its queue
+    // so that a per-queue timeline can slot in here when multiple queues are supported.
+    ExecutionSerial GetCompletedCommandSerial() const;
+    ExecutionSerial GetLastSubmittedCommandSerial() const;
+    ExecutionSerial GetPendingCommandSerial() const;
+
   protected:
     QueueBase(DeviceBase* device, const QueueDescriptor* descriptor);
     QueueBase(DeviceBase* device, ObjectBase::ErrorTag tag);
     void DestroyImpl() override;
 
+    // The default implementation stages the data in DynamicUploader and records a GPU-side
+    // copy. Protected so that backends overriding it can still delegate to it when their
+    // fast path does not apply.
+    virtual MaybeError WriteBufferImpl(BufferBase* buffer,
+                                       uint64_t bufferOffset,
+                                       const void* data,
+                                       size_t size);
+
   private:
+    struct TextureWriteBatch;
+
     MaybeError WriteTextureInternal(const ImageCopyTexture* destination,
                                     const void* data,
                                     size_t dataSize,
@@ -84,10 +108,6 @@ class QueueBase : public ApiObjectBase {
                                              const CopyTextureForBrowserOptions* options);
 
     virtual MaybeError SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) = 0;
-    virtual MaybeError WriteBufferImpl(BufferBase* buffer,
-                                       uint64_t bufferOffset,
-                                       const void* data,
-                                       size_t size);
     virtual MaybeError WriteTextureImpl(const ImageCopyTexture& destination,
                                         const void* data,
                                         const TextureDataLayout& dataLayout,
@@ -103,7 +123,16 @@ class QueueBase : public ApiObjectBase {
 
     void SubmitInternal(uint32_t commandCount, CommandBufferBase* const* commands);
 
+    MaybeError BatchWriteTexture(const ImageCopyTexture& destination,
+                                 const void* data,
+                                 const TextureDataLayout& dataLayout,
+                                 const Extent3D& writeSizePixel);
+
     SerialQueue<ExecutionSerial, std::unique_ptr<TaskInFlight>> mTasksInFlight;
+
+    // WriteTexture data waiting for a flush point, one batch per destination texture. Only
+    // used when the batch_texture_writes toggle is enabled.
+    std::vector<std::unique_ptr<TextureWriteBatch>> mTextureWriteBatches;
 };
 
 }  // namespace dawn::native
@@ -0,0 +1,86 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/ReadbackBufferPool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "dawn/common/Math.h"
+#include "dawn/native/Device.h"
+
+namespace dawn::native {
+
+ReadbackBufferPool::ReadbackBufferPool(DeviceBase* device) : mDevice(device) {}
+
+ReadbackBufferPool::~ReadbackBufferPool() = default;
+
+ResultOrError<Ref<BufferBase>> ReadbackBufferPool::Acquire(uint64_t size) {
+    size = std::max(size, kMinBufferSize);
+    if (!IsPowerOfTwo(size)) {
+        size = NextPowerOfTwo(size);
+    }
+
+    // Prefer the smallest free buffer that fits so larger pooled buffers stay available for
+    // larger readbacks.
+    size_t bestIndex = mFreeBuffers.size();
+    for (size_t i = 0; i < mFreeBuffers.size(); ++i) {
+        if (mFreeBuffers[i]->GetSize() >= size &&
+            (bestIndex == mFreeBuffers.size() ||
+             mFreeBuffers[i]->GetSize() < mFreeBuffers[bestIndex]->GetSize())) {
+            bestIndex = i;
+        }
+    }
+    if (bestIndex != mFreeBuffers.size()) {
+        Ref<BufferBase> buffer = std::move(mFreeBuffers[bestIndex]);
+        mFreeBuffers.erase(mFreeBuffers.begin() + bestIndex);
+        mFreeBuffersSize -= buffer->GetSize();
+        return buffer;
+    }
+
+    BufferDescriptor descriptor;
+    descriptor.size = size;
+    descriptor.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
+    Ref<BufferBase> buffer;
+    DAWN_TRY_ASSIGN(buffer, mDevice->CreateBuffer(&descriptor));
+    return buffer;
+}
+
+void ReadbackBufferPool::Release(Ref<BufferBase> buffer) {
+    ASSERT(buffer != nullptr);
+    ASSERT(buffer->GetUsage() & wgpu::BufferUsage::MapRead);
+
+    if (mFreeBuffersSize + buffer->GetSize() > kMaxFreeBufferPoolSize) {
+        // Dropping the reference destroys the buffer.
+        return;
+    }
+    mFreeBuffersSize += buffer->GetSize();
+    mFreeBuffers.push_back(std::move(buffer));
+}
+
+void ReadbackBufferPool::ReduceMemoryUsage() {
+    // Dropping the references destroys the buffers; acquired buffers are unaffected.
+    mFreeBuffers.clear();
+    mFreeBuffersSize = 0;
+}
+
+AllocatorMemoryInfo ReadbackBufferPool::GetMemoryInfo() const {
+    AllocatorMemoryInfo info;
+    info.name = "readback buffer pool";
+    // The pool only holds free buffers, so everything it reserves is reclaimable.
+    info.reservedMemory = mFreeBuffersSize;
+    return info;
+}
+
+}  // namespace dawn::native
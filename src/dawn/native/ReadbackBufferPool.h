@@ -0,0 +1,72 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_READBACKBUFFERPOOL_H_
+#define SRC_DAWN_NATIVE_READBACKBUFFERPOOL_H_
+
+#include <vector>
+
+#include "dawn/common/RefCounted.h"
+#include "dawn/native/Buffer.h"
+#include "dawn/native/DawnNative.h"
+
+namespace dawn::native {
+
+class DeviceBase;
+
+// ReadbackBufferPool is the download-side counterpart of DynamicUploader: it recycles the
+// host-readable staging buffers used to copy GPU results back to the CPU. The intended pattern
+// is to Acquire a buffer, record a copy into it, submit, then MapAsync the buffer: the mapped
+// range is handed to the map callback zero-copy once the copy's serial completes, serial gating
+// included. Releasing the buffer back to the pool after Unmap makes steady-state readbacks
+// (per-frame GPU stats, picking queries) allocation-free.
+class ReadbackBufferPool {
+  public:
+    // Note that this object does not retain a reference to `device`, so `device` MUST outlive
+    // this object.
+    explicit ReadbackBufferPool(DeviceBase* device);
+    ~ReadbackBufferPool();
+
+    // Acquires a buffer with CopyDst | MapRead usage of at least `size` bytes, reusing the
+    // smallest free pooled buffer that fits before creating a new one.
+    ResultOrError<Ref<BufferBase>> Acquire(uint64_t size);
+
+    // Returns a buffer previously acquired from this pool so that a later Acquire can reuse
+    // it. The buffer must be unmapped. Buffers that don't fit in the pool's free budget are
+    // destroyed instead of pooled.
+    void Release(Ref<BufferBase> buffer);
+
+    // Frees all pooled buffers, see DeviceBase::ReduceMemoryUsage.
+    void ReduceMemoryUsage();
+
+    // Snapshot of the pooled free buffers, see DeviceBase::GetMemoryReport. Acquired buffers
+    // are owned by their callers and not counted here.
+    AllocatorMemoryInfo GetMemoryInfo() const;
+
+  private:
+    // Sizes are rounded up to a power of two so that requests of slightly different sizes
+    // still hit the same pooled buffers.
+    static constexpr uint64_t kMinBufferSize = 4u * 1024u;
+    // Total size of free buffers kept for reuse. This only needs to cover a few frames of
+    // in-flight readbacks, which are small compared to real resources.
+    static constexpr uint64_t kMaxFreeBufferPoolSize = 16u * 1024u * 1024u;
+
+    DeviceBase* const mDevice;
+    std::vector<Ref<BufferBase>> mFreeBuffers;
+    uint64_t mFreeBuffersSize = 0;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_READBACKBUFFERPOOL_H_
@@ -43,7 +43,7 @@ RenderBundleBase::RenderBundleBase(RenderBundleEncoder* encoder,
 }
 
 void RenderBundleBase::DestroyImpl() {
-    FreeCommands(&mCommands);
+    GetDevice()->DeferCommandDestruction(std::move(mCommands));
 
     // Remove reference to the attachment state so that we don't have lingering references to
     // it preventing it from being uncached in the device.
@@ -133,7 +133,7 @@ void RenderPassEncoder::TrackQueryAvailability(QuerySetBase* querySet, uint32_t
 }
 
 void RenderPassEncoder::APIEnd() {
-    mEncodingContext->TryEncode(
+    bool success = mEncodingContext->TryEncode(
         this,
         [&](CommandAllocator* allocator) -> MaybeError {
             if (IsValidationEnabled()) {
@@ -157,6 +157,12 @@ void RenderPassEncoder::APIEnd() {
             return {};
         },
         "encoding %s.End().", this);
+
+    if (success) {
+        // ExitRenderPass above made the top-level encoder current again, so the end-of-pass
+        // timestamp lands after the EndRenderPassCmd.
+        mCommandEncoder->EncodeTimelinePassEnd();
+    }
 }
 
 void RenderPassEncoder::APIEndPass() {
@@ -311,14 +317,18 @@ void RenderPassEncoder::APIExecuteBundles(uint32_t count, RenderBundleBase* cons
             for (uint32_t i = 0; i < count; ++i) {
                 bundles[i] = renderBundles[i];
 
-                const RenderPassResourceUsage& usages = bundles[i]->GetResourceUsage();
-                for (uint32_t i = 0; i < usages.buffers.size(); ++i) {
-                    mUsageTracker.BufferUsedAs(usages.buffers[i], usages.bufferUsages[i]);
-                }
-
-                for (uint32_t i = 0; i < usages.textures.size(); ++i) {
-                    mUsageTracker.AddRenderBundleTextureUsage(usages.textures[i],
-                                                              usages.textureUsages[i]);
+                // Bundles are immutable once finished and merging usage is idempotent, so a
+                // bundle already executed in this pass has nothing new to contribute.
+                if (mMergedBundleUsages.insert(bundles[i].Get()).second) {
+                    const RenderPassResourceUsage& usages = bundles[i]->GetResourceUsage();
+                    for (uint32_t j = 0; j < usages.buffers.size(); ++j) {
+                        mUsageTracker.BufferUsedAs(usages.buffers[j], usages.bufferUsages[j]);
+                    }
+
+                    for (uint32_t j = 0; j < usages.textures.size(); ++j) {
+                        mUsageTracker.AddRenderBundleTextureUsage(usages.textures[j],
+                                                                  usages.textureUsages[j]);
+                    }
                 }
 
                 if (IsValidationEnabled()) {
@@ -333,6 +343,140 @@ void RenderPassEncoder::APIExecuteBundles(uint32_t count, RenderBundleBase* cons
         "encoding %s.ExecuteBundles(%u, ...).", this, count);
 }
 
+void RenderPassEncoder::APIMultiDrawIndirect(BufferBase* indirectBuffer,
+                                             uint64_t indirectOffset,
+                                             uint32_t maxDrawCount,
+                                             BufferBase* drawCountBuffer,
+                                             uint64_t drawCountBufferOffset) {
+    mEncodingContext->TryEncode(
+        this,
+        [&](CommandAllocator* allocator) -> MaybeError {
+            if (IsValidationEnabled()) {
+                DAWN_INVALID_IF(!GetDevice()->IsFeatureEnabled(Feature::MultiDrawIndirect),
+                                "%s is not supported", wgpu::FeatureName::DawnMultiDrawIndirect);
+
+                DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
+                DAWN_TRY(ValidateCanUseAs(indirectBuffer, wgpu::BufferUsage::Indirect));
+                DAWN_TRY(mCommandBufferState.ValidateCanDraw());
+
+                DAWN_INVALID_IF(indirectOffset % 4 != 0,
+                                "Indirect offset (%u) is not a multiple of 4.", indirectOffset);
+
+                DAWN_INVALID_IF(
+                    indirectOffset > indirectBuffer->GetSize() ||
+                        uint64_t(maxDrawCount) * kDrawIndirectSize >
+                            indirectBuffer->GetSize() - indirectOffset,
+                    "%u draws starting at indirect offset (%u) are out of bounds of indirect "
+                    "buffer %s size (%u).",
+                    maxDrawCount, indirectOffset, indirectBuffer, indirectBuffer->GetSize());
+
+                if (drawCountBuffer != nullptr) {
+                    DAWN_TRY(GetDevice()->ValidateObject(drawCountBuffer));
+                    DAWN_TRY(ValidateCanUseAs(drawCountBuffer, wgpu::BufferUsage::Indirect));
+
+                    DAWN_INVALID_IF(drawCountBufferOffset % 4 != 0,
+                                    "Draw count buffer offset (%u) is not a multiple of 4.",
+                                    drawCountBufferOffset);
+
+                    DAWN_INVALID_IF(
+                        drawCountBufferOffset > drawCountBuffer->GetSize() ||
+                            sizeof(uint32_t) > drawCountBuffer->GetSize() - drawCountBufferOffset,
+                        "Draw count buffer offset (%u) is out of bounds of draw count buffer "
+                        "%s size (%u).",
+                        drawCountBufferOffset, drawCountBuffer, drawCountBuffer->GetSize());
+                }
+            }
+
+            // Multi-draws reference the application's buffer directly: the compute-based
+            // indirect validation pass cannot patch a GPU-decided number of draws. The feature
+            // is only exposed on backends where out-of-bounds indirect parameters are handled
+            // robustly by the hardware.
+            MultiDrawIndirectCmd* cmd =
+                allocator->Allocate<MultiDrawIndirectCmd>(Command::MultiDrawIndirect);
+            cmd->indirectBuffer = indirectBuffer;
+            cmd->indirectOffset = indirectOffset;
+            cmd->maxDrawCount = maxDrawCount;
+            cmd->drawCountBuffer = drawCountBuffer;
+            cmd->drawCountBufferOffset = drawCountBufferOffset;
+
+            mUsageTracker.BufferUsedAs(indirectBuffer, wgpu::BufferUsage::Indirect);
+            if (drawCountBuffer != nullptr) {
+                mUsageTracker.BufferUsedAs(drawCountBuffer, wgpu::BufferUsage::Indirect);
+            }
+
+            mDrawCount += maxDrawCount;
+
+            return {};
+        },
+        "encoding %s.MultiDrawIndirect(%s, %u, %u).", this, indirectBuffer, indirectOffset,
+        maxDrawCount);
+}
+
+void RenderPassEncoder::APIMultiDrawIndexedIndirect(BufferBase* indirectBuffer,
+                                                    uint64_t indirectOffset,
+                                                    uint32_t maxDrawCount,
+                                                    BufferBase* drawCountBuffer,
+                                                    uint64_t drawCountBufferOffset) {
+    mEncodingContext->TryEncode(
+        this,
+        [&](CommandAllocator* allocator) -> MaybeError {
+            if (IsValidationEnabled()) {
+                DAWN_INVALID_IF(!GetDevice()->IsFeatureEnabled(Feature::MultiDrawIndirect),
+                                "%s is not supported", wgpu::FeatureName::DawnMultiDrawIndirect);
+
+                DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
+                DAWN_TRY(ValidateCanUseAs(indirectBuffer, wgpu::BufferUsage::Indirect));
+                DAWN_TRY(mCommandBufferState.ValidateCanDrawIndexed());
+
+                DAWN_INVALID_IF(indirectOffset % 4 != 0,
+                                "Indirect offset (%u) is not a multiple of 4.", indirectOffset);
+
+                DAWN_INVALID_IF(
+                    indirectOffset > indirectBuffer->GetSize() ||
+                        uint64_t(maxDrawCount) * kDrawIndexedIndirectSize >
+                            indirectBuffer->GetSize() - indirectOffset,
+                    "%u draws starting at indirect offset (%u) are out of bounds of indirect "
+                    "buffer %s size (%u).",
+                    maxDrawCount, indirectOffset, indirectBuffer, indirectBuffer->GetSize());
+
+                if (drawCountBuffer != nullptr) {
+                    DAWN_TRY(GetDevice()->ValidateObject(drawCountBuffer));
+                    DAWN_TRY(ValidateCanUseAs(drawCountBuffer, wgpu::BufferUsage::Indirect));
+
+                    DAWN_INVALID_IF(drawCountBufferOffset % 4 != 0,
+                                    "Draw count buffer offset (%u) is not a multiple of 4.",
+                                    drawCountBufferOffset);
+
+                    DAWN_INVALID_IF(
+                        drawCountBufferOffset > drawCountBuffer->GetSize() ||
+                            sizeof(uint32_t) > drawCountBuffer->GetSize() - drawCountBufferOffset,
+                        "Draw count buffer offset (%u) is out of bounds of draw count buffer "
+                        "%s size (%u).",
+                        drawCountBufferOffset, drawCountBuffer, drawCountBuffer->GetSize());
+                }
+            }
+
+            MultiDrawIndexedIndirectCmd* cmd = allocator->Allocate<MultiDrawIndexedIndirectCmd>(
+                Command::MultiDrawIndexedIndirect);
+            cmd->indirectBuffer = indirectBuffer;
+            cmd->indirectOffset = indirectOffset;
+            cmd->maxDrawCount = maxDrawCount;
+            cmd->drawCountBuffer = drawCountBuffer;
+            cmd->drawCountBufferOffset = drawCountBufferOffset;
+
+            mUsageTracker.BufferUsedAs(indirectBuffer, wgpu::BufferUsage::Indirect);
+            if (drawCountBuffer != nullptr) {
+                mUsageTracker.BufferUsedAs(drawCountBuffer, wgpu::BufferUsage::Indirect);
+            }
+
+            mDrawCount += maxDrawCount;
+
+            return {};
+        },
+        "encoding %s.MultiDrawIndexedIndirect(%s, %u, %u).", this, indirectBuffer, indirectOffset,
+        maxDrawCount);
+}
+
 void RenderPassEncoder::APIBeginOcclusionQuery(uint32_t queryIndex) {
     mEncodingContext->TryEncode(
         this,
@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_RENDERPASSENCODER_H_
 #define SRC_DAWN_NATIVE_RENDERPASSENCODER_H_
 
+#include <set>
 #include <vector>
 
 #include "dawn/native/Error.h"
@@ -57,6 +58,17 @@ class RenderPassEncoder final : public RenderEncoderBase {
     void APISetScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
     void APIExecuteBundles(uint32_t count, RenderBundleBase* const* renderBundles);
 
+    void APIMultiDrawIndirect(BufferBase* indirectBuffer,
+                              uint64_t indirectOffset,
+                              uint32_t maxDrawCount,
+                              BufferBase* drawCountBuffer,
+                              uint64_t drawCountBufferOffset);
+    void APIMultiDrawIndexedIndirect(BufferBase* indirectBuffer,
+                                     uint64_t indirectOffset,
+                                     uint32_t maxDrawCount,
+                                     BufferBase* drawCountBuffer,
+                                     uint64_t drawCountBufferOffset);
+
     void APIBeginOcclusionQuery(uint32_t queryIndex);
     void APIEndOcclusionQuery();
 
@@ -97,6 +109,10 @@ class RenderPassEncoder final : public RenderEncoderBase {
 
     // This is the hardcoded value in the WebGPU spec.
     uint64_t mMaxDrawCount = 50000000;
+
+    // Bundles whose resource usage was already merged into mUsageTracker. Usage merging is
+    // idempotent, so executing the same immutable bundle again can skip the merge entirely.
+    std::set<RenderBundleBase*> mMergedBundleUsages;
 };
 
 }  // namespace dawn::native
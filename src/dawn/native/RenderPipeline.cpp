@@ -17,6 +17,8 @@
 #include <algorithm>
 #include <cmath>
 #include <sstream>
+#include <string>
+#include <utility>
 
 #include "dawn/common/BitSetIterator.h"
 #include "dawn/native/ChainUtils_autogen.h"
@@ -1004,4 +1006,13 @@ bool RenderPipelineBase::EqualityFunc::operator()(const RenderPipelineBase* a,
     return true;
 }
 
+void RenderPipelineBase::SetCacheFingerprint(std::string fingerprint) {
+    ASSERT(mCacheFingerprint.empty());
+    mCacheFingerprint = std::move(fingerprint);
+}
+
+const std::string& RenderPipelineBase::GetCacheFingerprint() const {
+    return mCacheFingerprint;
+}
+
 }  // namespace dawn::native
@@ -17,6 +17,7 @@
 
 #include <array>
 #include <bitset>
+#include <string>
 #include <vector>
 
 #include "dawn/common/TypedInteger.h"
@@ -111,6 +112,11 @@ class RenderPipelineBase : public PipelineBase {
         bool operator()(const RenderPipelineBase* a, const RenderPipelineBase* b) const;
     };
 
+    // The serialized descriptor bytes under which this pipeline is registered in the device's
+    // fingerprint pre-check cache, empty when the pipeline isn't registered there.
+    void SetCacheFingerprint(std::string fingerprint);
+    const std::string& GetCacheFingerprint() const;
+
   protected:
     // Constructor used only for mocking and testing.
     explicit RenderPipelineBase(DeviceBase* device);
@@ -140,6 +146,9 @@ class RenderPipelineBase : public PipelineBase {
     bool mUnclippedDepth = false;
     bool mWritesDepth = false;
     bool mWritesStencil = false;
+
+    // Key in the device's fingerprint pre-check cache.
+    std::string mCacheFingerprint;
 };
 
 }  // namespace dawn::native
@@ -14,9 +14,28 @@
 
 #include "dawn/native/ScratchBuffer.h"
 
+#include <algorithm>
+#include <utility>
+
+#include "dawn/common/Math.h"
 #include "dawn/native/Device.h"
 
 namespace dawn::native {
+namespace {
+
+// Buffers at most this size are never released; they aren't worth reallocating.
+constexpr uint64_t kMinScratchBufferSize = 256;
+
+// Number of serials a buffer (or part of its capacity) must go unused for before it is
+// released. Large enough that steady-state workloads never reallocate, small enough that a
+// single oversized request doesn't pin memory for the rest of the device's lifetime.
+constexpr uint64_t kScratchShrinkAfterSerials = 16;
+
+uint64_t ComputeAllocationSize(uint64_t capacity) {
+    return std::max(NextPowerOfTwo(capacity), kMinScratchBufferSize);
+}
+
+}  // namespace
 
 ScratchBuffer::ScratchBuffer(DeviceBase* device, wgpu::BufferUsage usage)
     : mDevice(device), mUsage(usage) {}
@@ -25,16 +44,37 @@ ScratchBuffer::~ScratchBuffer() = default;
 
 void ScratchBuffer::Reset() {
     mBuffer = nullptr;
+    mHighWatermark = 0;
 }
 
 MaybeError ScratchBuffer::EnsureCapacity(uint64_t capacity) {
+    mHighWatermark = std::max(mHighWatermark, capacity);
+
+    // Periodically release the buffer when it stayed at least twice as large as every request
+    // of the last window so that one oversized request doesn't pin a large allocation forever.
+    // The buffer is only released once the GPU is done with it: contents recorded against it
+    // (indirect draw data for example) must stay valid until the commands that use them ran.
+    ExecutionSerial pendingSerial = mDevice->GetPendingCommandSerial();
+    if (uint64_t(pendingSerial) - uint64_t(mLastShrinkCheckSerial) >= kScratchShrinkAfterSerials) {
+        if (mBuffer.Get() && mBuffer->GetSize() > kMinScratchBufferSize &&
+            mHighWatermark <= mBuffer->GetSize() / 2 &&
+            mLastUseSerial <= mDevice->GetCompletedCommandSerial()) {
+            mBuffer = nullptr;
+        }
+        mHighWatermark = capacity;
+        mLastShrinkCheckSerial = pendingSerial;
+    }
+
     if (!mBuffer.Get() || mBuffer->GetSize() < capacity) {
+        // Grow geometrically so slowly increasing requests don't reallocate on every call.
         BufferDescriptor descriptor;
-        descriptor.size = capacity;
+        descriptor.size = ComputeAllocationSize(capacity);
         descriptor.usage = mUsage;
         DAWN_TRY_ASSIGN(mBuffer, mDevice->CreateBuffer(&descriptor));
         mBuffer->SetIsDataInitialized();
     }
+
+    mLastUseSerial = pendingSerial;
     return {};
 }
 
@@ -43,4 +83,49 @@ BufferBase* ScratchBuffer::GetBuffer() const {
     return mBuffer.Get();
 }
 
+ScratchBufferPool::ScratchBufferPool(DeviceBase* device, wgpu::BufferUsage usage)
+    : mDevice(device), mUsage(usage) {}
+
+ScratchBufferPool::~ScratchBufferPool() = default;
+
+ResultOrError<Ref<BufferBase>> ScratchBufferPool::Lease(uint64_t capacity) {
+    ExecutionSerial completedSerial = mDevice->GetCompletedCommandSerial();
+    ExecutionSerial pendingSerial = mDevice->GetPendingCommandSerial();
+
+    // Prefer the smallest pooled buffer that is large enough and not in use by the GPU.
+    Entry* bestEntry = nullptr;
+    for (Entry& entry : mEntries) {
+        if (entry.lastUseSerial > completedSerial || entry.buffer->GetSize() < capacity) {
+            continue;
+        }
+        if (bestEntry == nullptr || entry.buffer->GetSize() < bestEntry->buffer->GetSize()) {
+            bestEntry = &entry;
+        }
+    }
+    if (bestEntry != nullptr) {
+        bestEntry->lastUseSerial = pendingSerial;
+        return Ref<BufferBase>(bestEntry->buffer);
+    }
+
+    BufferDescriptor descriptor;
+    descriptor.size = ComputeAllocationSize(capacity);
+    descriptor.usage = mUsage;
+    Ref<BufferBase> buffer;
+    DAWN_TRY_ASSIGN(buffer, mDevice->CreateBuffer(&descriptor));
+    buffer->SetIsDataInitialized();
+    mEntries.push_back(Entry{buffer, pendingSerial});
+    return std::move(buffer);
+}
+
+void ScratchBufferPool::Tick(ExecutionSerial completedSerial) {
+    mEntries.erase(std::remove_if(mEntries.begin(), mEntries.end(),
+                                  [&](const Entry& entry) {
+                                      return entry.lastUseSerial <= completedSerial &&
+                                             uint64_t(completedSerial) -
+                                                     uint64_t(entry.lastUseSerial) >=
+                                                 kScratchShrinkAfterSerials;
+                                  }),
+                   mEntries.end());
+}
+
 }  // namespace dawn::native
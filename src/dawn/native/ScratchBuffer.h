@@ -16,9 +16,11 @@
 #define SRC_DAWN_NATIVE_SCRATCHBUFFER_H_
 
 #include <cstdint>
+#include <vector>
 
 #include "dawn/common/RefCounted.h"
 #include "dawn/native/Buffer.h"
+#include "dawn/native/IntegerTypes.h"
 
 namespace dawn::native {
 
@@ -39,7 +41,8 @@ class ScratchBuffer {
     void Reset();
 
     // Ensures that this ScratchBuffer is backed by a buffer on `device` with at least
-    // `capacity` bytes of storage.
+    // `capacity` bytes of storage. The buffer grows geometrically, and is released to be
+    // reallocated smaller when requests stayed well below its size for long enough.
     MaybeError EnsureCapacity(uint64_t capacity);
 
     BufferBase* GetBuffer() const;
@@ -48,6 +51,41 @@ class ScratchBuffer {
     DeviceBase* const mDevice;
     const wgpu::BufferUsage mUsage;
     Ref<BufferBase> mBuffer;
+
+    // High-water mark of the capacities requested since the last shrink check, used to detect
+    // that the buffer is oversized for what the recent requests needed.
+    uint64_t mHighWatermark = 0;
+    ExecutionSerial mLastShrinkCheckSerial = ExecutionSerial(0);
+    ExecutionSerial mLastUseSerial = ExecutionSerial(0);
+};
+
+// A device-lifetime pool of scratch buffers that several internal operations can lease from
+// instead of each holding its own buffer forever. A lease lasts until the commands pending at
+// lease time complete, after which the buffer becomes eligible to back another lease; nothing
+// needs to be returned explicitly. Contents do not survive a lease.
+class ScratchBufferPool {
+  public:
+    // Note that this object does not retain a reference to `device`, so `device` MUST outlive
+    // this object.
+    ScratchBufferPool(DeviceBase* device, wgpu::BufferUsage usage);
+    ~ScratchBufferPool();
+
+    // Leases a buffer with at least `capacity` bytes, preferring the smallest pooled buffer
+    // whose previous lease has completed and allocating a new one when there is none.
+    ResultOrError<Ref<BufferBase>> Lease(uint64_t capacity);
+
+    // Releases pooled buffers that haven't been leased for a while.
+    void Tick(ExecutionSerial completedSerial);
+
+  private:
+    struct Entry {
+        Ref<BufferBase> buffer;
+        ExecutionSerial lastUseSerial;
+    };
+
+    DeviceBase* const mDevice;
+    const wgpu::BufferUsage mUsage;
+    std::vector<Entry> mEntries;
 };
 
 }  // namespace dawn::native
@@ -21,6 +21,7 @@
 #include "dawn/common/BitSetIterator.h"
 #include "dawn/common/Constants.h"
 #include "dawn/common/HashUtils.h"
+#include "dawn/native/AsyncTask.h"
 #include "dawn/native/BindGroupLayout.h"
 #include "dawn/native/ChainUtils_autogen.h"
 #include "dawn/native/CompilationMessages.h"
@@ -906,12 +907,7 @@ class TintSource {
     tint::Source::File file;
 };
 
-MaybeError ValidateAndParseShaderModule(DeviceBase* device,
-                                        const ShaderModuleDescriptor* descriptor,
-                                        ShaderModuleParseResult* parseResult,
-                                        OwnedCompilationMessages* outMessages) {
-    ASSERT(parseResult != nullptr);
-
+MaybeError ValidateShaderModuleDescriptorChain(const ShaderModuleDescriptor* descriptor) {
     const ChainedStruct* chainedDescriptor = descriptor->nextInChain;
     DAWN_INVALID_IF(chainedDescriptor == nullptr,
                     "Shader module descriptor missing chained descriptor");
@@ -920,6 +916,18 @@ MaybeError ValidateAndParseShaderModule(DeviceBase* device,
     DAWN_TRY(ValidateSingleSType(chainedDescriptor, wgpu::SType::ShaderModuleSPIRVDescriptor,
                                  wgpu::SType::ShaderModuleWGSLDescriptor));
 
+    return {};
+}
+
+MaybeError ValidateAndParseShaderModule(DeviceBase* device,
+                                        const ShaderModuleDescriptor* descriptor,
+                                        ShaderModuleParseResult* parseResult,
+                                        OwnedCompilationMessages* outMessages) {
+    ASSERT(parseResult != nullptr);
+
+    DAWN_TRY(ValidateShaderModuleDescriptorChain(descriptor));
+    const ChainedStruct* chainedDescriptor = descriptor->nextInChain;
+
     ScopedTintICEHandler scopedICEHandler(device);
 
     const ShaderModuleSPIRVDescriptor* spirvDesc = nullptr;
@@ -1151,6 +1159,10 @@ void ShaderModuleBase::APIGetCompilationInfo(wgpu::CompilationInfoCallback callb
         return;
     }
 
+    // A deferred parse fills the compilation messages on a worker thread; they are complete
+    // once the parse is, whether it succeeded or not.
+    WaitForParseCompletion();
+
     callback(WGPUCompilationInfoRequestStatus_Success, mCompilationMessages->GetCompilationInfo(),
              userdata);
 }
@@ -1191,8 +1203,77 @@ OwnedCompilationMessages* ShaderModuleBase::GetCompilationMessages() const {
     return mCompilationMessages.get();
 }
 
+MaybeError ShaderModuleBase::Initialize(ShaderModuleParseResult* parseResult,
+                                        OwnedCompilationMessages* compilationMessages) {
+    return InitializeBase(parseResult, compilationMessages);
+}
+
+void ShaderModuleBase::BeginDeferredParse(OwnedCompilationMessages* compilationMessages) {
+    ASSERT(mType == Type::Wgsl);
+    ASSERT(compilationMessages != nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mParseMutex);
+        mParsePending = true;
+    }
+
+    // The task holds a reference so the module outlives an application that drops it before
+    // the parse completes. The reference is handed back to the device at the end so that a
+    // worker thread never performs the final release. High priority because pipeline creation
+    // may block on the parse.
+    Ref<ShaderModuleBase> module = this;
+    GetDevice()->GetAsyncTaskManager()->PostTask(
+        [module, compilationMessages] {
+            module->RunDeferredParse(compilationMessages);
+            module->GetDevice()->AddObjectKeepaliveCallbackTask(module);
+        },
+        TaskPriority::High);
+}
+
+void ShaderModuleBase::RunDeferredParse(OwnedCompilationMessages* compilationMessages) {
+    ShaderModuleWGSLDescriptor wgslDesc;
+    wgslDesc.source = mWgsl.c_str();
+    ShaderModuleDescriptor descriptor;
+    descriptor.nextInChain = &wgslDesc;
+
+    ShaderModuleParseResult parseResult;
+    MaybeError result =
+        ValidateAndParseShaderModule(GetDevice(), &descriptor, &parseResult, compilationMessages);
+    if (result.IsSuccess()) {
+        result = Initialize(&parseResult, compilationMessages);
+    }
+
+    std::lock_guard<std::mutex> lock(mParseMutex);
+    if (result.IsError()) {
+        std::unique_ptr<ErrorData> error = result.AcquireError();
+        mParseFailed = true;
+        mParseErrorMessage = error->GetMessage();
+    }
+    mParsePending = false;
+    mParseCompleteCondition.notify_all();
+}
+
+void ShaderModuleBase::WaitForParseCompletion() const {
+    std::unique_lock<std::mutex> lock(mParseMutex);
+    while (mParsePending) {
+        mParseCompleteCondition.wait(lock);
+    }
+}
+
+MaybeError ShaderModuleBase::EnsureParsed() const {
+    WaitForParseCompletion();
+    DAWN_INVALID_IF(mParseFailed, "%s failed to compile: %s", this, mParseErrorMessage);
+    return {};
+}
+
 MaybeError ShaderModuleBase::InitializeBase(ShaderModuleParseResult* parseResult,
                                             OwnedCompilationMessages* compilationMessages) {
+    if (!parseResult->HasParsedShader()) {
+        // The parse was deferred; BeginDeferredParse runs the initialization again on a
+        // worker thread once the source is parsed.
+        ASSERT(GetDevice()->IsToggleEnabled(Toggle::DeferShaderModuleParsing));
+        return {};
+    }
+
     mTintProgram = std::move(parseResult->tintProgram);
     mTintSource = std::move(parseResult->tintSource);
 
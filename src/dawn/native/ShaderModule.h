@@ -18,6 +18,8 @@
 #include <bitset>
 #include <map>
 #include <memory>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -100,6 +102,9 @@ struct ShaderModuleParseResult {
     std::unique_ptr<TintSource> tintSource;
 };
 
+// Validates just the structure of the descriptor's chain. Cheap enough to run before the
+// device's shader module cache lookup, and sufficient for constructing the cache blueprint.
+MaybeError ValidateShaderModuleDescriptorChain(const ShaderModuleDescriptor* descriptor);
 MaybeError ValidateAndParseShaderModule(DeviceBase* device,
                                         const ShaderModuleDescriptor* descriptor,
                                         ShaderModuleParseResult* parseResult,
@@ -277,6 +282,14 @@ class ShaderModuleBase : public ApiObjectBase, public CachedObject {
 
     void APIGetCompilationInfo(wgpu::CompilationInfoCallback callback, void* userdata);
 
+    // Deferred parsing. When the DeferShaderModuleParsing toggle is on, WGSL modules are
+    // returned to the application before Tint has parsed the source and the parse plus the
+    // backend initialization run on the device's async task manager. Everything that consumes
+    // reflection data or the Tint program must call EnsureParsed() first; it waits for the
+    // parse and returns the validation error if the source failed to compile.
+    void BeginDeferredParse(OwnedCompilationMessages* compilationMessages);
+    MaybeError EnsureParsed() const;
+
     void InjectCompilationMessages(std::unique_ptr<OwnedCompilationMessages> compilationMessages);
 
     OwnedCompilationMessages* GetCompilationMessages() const;
@@ -289,6 +302,12 @@ class ShaderModuleBase : public ApiObjectBase, public CachedObject {
     MaybeError InitializeBase(ShaderModuleParseResult* parseResult,
                               OwnedCompilationMessages* compilationMessages);
 
+    // Initializes the module from the parse result. Backends override this to post-process
+    // the Tint program before reflection; for a deferred parse it runs again on a worker
+    // thread once parsing completes.
+    virtual MaybeError Initialize(ShaderModuleParseResult* parseResult,
+                                  OwnedCompilationMessages* compilationMessages);
+
   private:
     ShaderModuleBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
@@ -304,6 +323,17 @@ class ShaderModuleBase : public ApiObjectBase, public CachedObject {
     std::unique_ptr<TintSource> mTintSource;  // Keep the tint::Source::File alive
 
     std::unique_ptr<OwnedCompilationMessages> mCompilationMessages;
+
+    void RunDeferredParse(OwnedCompilationMessages* compilationMessages);
+    void WaitForParseCompletion() const;
+
+    // Deferred parse state, guarded by mParseMutex. The worker task signals completion through
+    // the condition variable; a failed parse keeps its message for EnsureParsed().
+    mutable std::mutex mParseMutex;
+    mutable std::condition_variable mParseCompleteCondition;
+    bool mParsePending = false;
+    bool mParseFailed = false;
+    std::string mParseErrorMessage;
 };
 
 }  // namespace dawn::native
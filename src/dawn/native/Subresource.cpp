@@ -62,41 +62,6 @@ Aspect SelectFormatAspects(const Format& format, wgpu::TextureAspect aspect) {
     UNREACHABLE();
 }
 
-uint8_t GetAspectIndex(Aspect aspect) {
-    ASSERT(HasOneBit(aspect));
-    switch (aspect) {
-        case Aspect::Color:
-        case Aspect::Depth:
-        case Aspect::Plane0:
-        case Aspect::CombinedDepthStencil:
-            return 0;
-        case Aspect::Plane1:
-        case Aspect::Stencil:
-            return 1;
-        default:
-            UNREACHABLE();
-    }
-}
-
-uint8_t GetAspectCount(Aspect aspects) {
-    // TODO(crbug.com/dawn/829): This should use popcount once Dawn has such a function.
-    // Note that we can't do a switch because compilers complain that Depth | Stencil is not
-    // a valid enum value.
-    if (aspects == Aspect::Color || aspects == Aspect::Depth ||
-        aspects == Aspect::CombinedDepthStencil) {
-        return 1;
-    } else if (aspects == (Aspect::Plane0 | Aspect::Plane1)) {
-        return 2;
-    } else if (aspects == Aspect::Stencil) {
-        // Fake a the existence of a depth aspect so that the stencil data stays at index 1.
-        ASSERT(GetAspectIndex(Aspect::Stencil) == 1);
-        return 2;
-    } else {
-        ASSERT(aspects == (Aspect::Depth | Aspect::Stencil));
-        return 2;
-    }
-}
-
 SubresourceRange::SubresourceRange(Aspect aspects,
                                    FirstAndCountRange<uint32_t> arrayLayerParam,
                                    FirstAndCountRange<uint32_t> mipLevelParams)
@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_SUBRESOURCE_H_
 #define SRC_DAWN_NATIVE_SUBRESOURCE_H_
 
+#include "dawn/common/Assert.h"
 #include "dawn/native/EnumClassBitmasks.h"
 #include "dawn/native/dawn_platform.h"
 
@@ -90,9 +91,42 @@ struct SubresourceRange {
     static SubresourceRange MakeFull(Aspect aspects, uint32_t layerCount, uint32_t levelCount);
 };
 
-// Helper function to use aspects as linear indices in arrays.
-uint8_t GetAspectIndex(Aspect aspect);
-uint8_t GetAspectCount(Aspect aspects);
+// Helper function to use aspects as linear indices in arrays. Defined inline because it is on
+// the hot path of per-copy format queries and must fold to a constant when the aspect is known.
+inline uint8_t GetAspectIndex(Aspect aspect) {
+    ASSERT(HasOneBit(aspect));
+    switch (aspect) {
+        case Aspect::Color:
+        case Aspect::Depth:
+        case Aspect::Plane0:
+        case Aspect::CombinedDepthStencil:
+            return 0;
+        case Aspect::Plane1:
+        case Aspect::Stencil:
+            return 1;
+        default:
+            UNREACHABLE();
+    }
+}
+
+inline uint8_t GetAspectCount(Aspect aspects) {
+    // TODO(crbug.com/dawn/829): This should use popcount once Dawn has such a function.
+    // Note that we can't do a switch because compilers complain that Depth | Stencil is not
+    // a valid enum value.
+    if (aspects == Aspect::Color || aspects == Aspect::Depth ||
+        aspects == Aspect::CombinedDepthStencil) {
+        return 1;
+    } else if (aspects == (Aspect::Plane0 | Aspect::Plane1)) {
+        return 2;
+    } else if (aspects == Aspect::Stencil) {
+        // Fake a the existence of a depth aspect so that the stencil data stays at index 1.
+        ASSERT(GetAspectIndex(Aspect::Stencil) == 1);
+        return 2;
+    } else {
+        ASSERT(aspects == (Aspect::Depth | Aspect::Stencil));
+        return 2;
+    }
+}
 
 // The maximum number of planes per format Dawn knows about. Asserts in BuildFormatTable that
 // the per plane index does not exceed the known maximum plane count.
@@ -132,6 +132,21 @@ class SubresourceStorage {
     template <typename F>
     void Iterate(F&& iterateFunc) const;
 
+    // Like Iterate() but coalesces neighboring ranges that hold equal data before calling
+    // iterateFunc, so callers that translate ranges into expensive operations (like barriers)
+    // get the minimum number of calls:
+    //
+    //  - Consecutive compressed layers with equal data are merged into a single multi-layer
+    //    range spanning all mip levels.
+    //  - Within a decompressed layer, consecutive mip levels with equal data are merged into
+    //    a single multi-level range.
+    //
+    // This is a greedy coalescing: decompressed layers are not merged with their neighbors
+    // even if they happen to hold the same per-level data. Each subresource is still part of
+    // exactly one of the ranges iterateFunc is called with.
+    template <typename F>
+    void IterateCoalescedRanges(F&& iterateFunc) const;
+
     // Given an updateFunc that's a function or function-like objet that can be called with
     // arguments of type (const SubresourceRange& range, T* data) and returns void,
     // calls it with ranges that in aggregate form `range` and pass for each of the
@@ -381,6 +396,56 @@ void SubresourceStorage<T>::Iterate(F&& iterateFunc) const {
     }
 }
 
+template <typename T>
+template <typename F>
+void SubresourceStorage<T>::IterateCoalescedRanges(F&& iterateFunc) const {
+    for (Aspect aspect : IterateEnumMask(mAspects)) {
+        uint32_t aspectIndex = GetAspectIndex(aspect);
+
+        // Fastest path, call iterateFunc on the whole aspect at once.
+        if (mAspectCompressed[aspectIndex]) {
+            SubresourceRange range =
+                SubresourceRange::MakeFull(aspect, mArrayLayerCount, mMipLevelCount);
+            iterateFunc(range, DataInline(aspectIndex));
+            continue;
+        }
+
+        uint32_t layer = 0;
+        while (layer < mArrayLayerCount) {
+            if (LayerCompressed(aspectIndex, layer)) {
+                // Extend the range across consecutive compressed layers with equal data.
+                const T& layerData = Data(aspectIndex, layer);
+                uint32_t layerEnd = layer + 1;
+                while (layerEnd < mArrayLayerCount && LayerCompressed(aspectIndex, layerEnd) &&
+                       Data(aspectIndex, layerEnd) == layerData) {
+                    layerEnd++;
+                }
+
+                SubresourceRange range = {aspect, {layer, layerEnd - layer}, {0, mMipLevelCount}};
+                iterateFunc(range, layerData);
+                layer = layerEnd;
+                continue;
+            }
+
+            // Decompressed layer, extend ranges across consecutive levels with equal data.
+            uint32_t level = 0;
+            while (level < mMipLevelCount) {
+                const T& levelData = Data(aspectIndex, layer, level);
+                uint32_t levelEnd = level + 1;
+                while (levelEnd < mMipLevelCount &&
+                       Data(aspectIndex, layer, levelEnd) == levelData) {
+                    levelEnd++;
+                }
+
+                SubresourceRange range = {aspect, {layer, 1}, {level, levelEnd - level}};
+                iterateFunc(range, levelData);
+                level = levelEnd;
+            }
+            layer++;
+        }
+    }
+}
+
 template <typename T>
 const T& SubresourceStorage<T>::Get(Aspect aspect, uint32_t arrayLayer, uint32_t mipLevel) const {
     uint32_t aspectIndex = GetAspectIndex(aspect);
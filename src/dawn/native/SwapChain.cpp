@@ -14,6 +14,9 @@
 
 #include "dawn/native/SwapChain.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "dawn/common/Constants.h"
 #include "dawn/native/Adapter.h"
 #include "dawn/native/Device.h"
@@ -344,15 +347,88 @@ void NewSwapChainBase::APIPresent() {
         return;
     }
 
-    if (GetDevice()->ConsumedError(PresentImpl())) {
+    MaybeError presentResult = PresentImpl();
+
+    // The damage hint only applies to the present that just happened (or failed).
+    mNextPresentDamage.clear();
+
+    if (GetDevice()->ConsumedError(std::move(presentResult))) {
         return;
     }
 
+    mPresentCount++;
+
     ASSERT(mCurrentTextureView->GetTexture()->GetTextureState() ==
            TextureBase::TextureState::Destroyed);
     mCurrentTextureView = nullptr;
 }
 
+MaybeError NewSwapChainBase::SetMaximumFrameLatency(uint32_t maxLatency) {
+    DAWN_TRY(GetDevice()->ValidateIsAlive());
+    DAWN_INVALID_IF(!mAttached, "Cannot call SetMaximumFrameLatency on detached %s.", this);
+    DAWN_INVALID_IF(maxLatency == 0, "Maximum frame latency must be at least 1.");
+
+    mMaximumFrameLatency = maxLatency;
+    return SetMaximumFrameLatencyImpl(maxLatency);
+}
+
+MaybeError NewSwapChainBase::WaitForFrameLatency() {
+    DAWN_TRY(GetDevice()->ValidateIsAlive());
+    DAWN_INVALID_IF(!mAttached, "Cannot call WaitForFrameLatency on detached %s.", this);
+
+    return WaitForFrameLatencyImpl();
+}
+
+ResultOrError<SwapChainPresentStatistics> NewSwapChainBase::GetPresentStatistics() {
+    DAWN_TRY(GetDevice()->ValidateIsAlive());
+    DAWN_INVALID_IF(!mAttached, "Cannot call GetPresentStatistics on detached %s.", this);
+
+    SwapChainPresentStatistics stats;
+    stats.presentCount = mPresentCount;
+    DAWN_TRY_ASSIGN(stats.lastFlipTimeNS, GetLastFlipTimeImpl());
+    return stats;
+}
+
+uint32_t NewSwapChainBase::GetMaximumFrameLatency() const {
+    return mMaximumFrameLatency;
+}
+
+MaybeError NewSwapChainBase::SetNextPresentDamage(const PresentDamageRect* rects,
+                                                  uint32_t rectCount) {
+    DAWN_TRY(GetDevice()->ValidateIsAlive());
+    DAWN_INVALID_IF(!mAttached, "Cannot call SetNextPresentDamage on detached %s.", this);
+    DAWN_INVALID_IF(rects == nullptr && rectCount > 0, "Damage rects are null.");
+
+    mNextPresentDamage.assign(rects, rects + rectCount);
+
+    // Clamp the rects to the swapchain so backends can pass them on without further checks.
+    for (PresentDamageRect& rect : mNextPresentDamage) {
+        rect.x = std::min(rect.x, mWidth);
+        rect.y = std::min(rect.y, mHeight);
+        rect.width = std::min(rect.width, mWidth - rect.x);
+        rect.height = std::min(rect.height, mHeight - rect.y);
+    }
+    return {};
+}
+
+const std::vector<PresentDamageRect>& NewSwapChainBase::GetNextPresentDamage() const {
+    return mNextPresentDamage;
+}
+
+MaybeError NewSwapChainBase::SetMaximumFrameLatencyImpl(uint32_t maxLatency) {
+    return {};
+}
+
+MaybeError NewSwapChainBase::WaitForFrameLatencyImpl() {
+    // Without a dedicated pacing primitive the queue depth is already bounded by the wait for
+    // the reused back buffer in GetCurrentTextureView.
+    return {};
+}
+
+ResultOrError<uint64_t> NewSwapChainBase::GetLastFlipTimeImpl() {
+    return uint64_t(0);
+}
+
 uint32_t NewSwapChainBase::GetWidth() const {
     return mWidth;
 }
@@ -15,6 +15,8 @@
 #ifndef SRC_DAWN_NATIVE_SWAPCHAIN_H_
 #define SRC_DAWN_NATIVE_SWAPCHAIN_H_
 
+#include <vector>
+
 #include "dawn/native/Error.h"
 #include "dawn/native/Forward.h"
 #include "dawn/native/ObjectBase.h"
@@ -30,6 +32,24 @@ MaybeError ValidateSwapChainDescriptor(const DeviceBase* device,
 
 TextureDescriptor GetSwapChainBaseTextureDescriptor(NewSwapChainBase* swapChain);
 
+// A region of the swapchain that changed since the previous present of the same content, in
+// pixels with the origin at the top-left of the swapchain.
+struct PresentDamageRect {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+// Per-frame presentation statistics for frame pacing loops.
+struct SwapChainPresentStatistics {
+    // Number of successful Present calls on this swapchain.
+    uint64_t presentCount = 0;
+    // Monotonic timestamp in nanoseconds of when the most recently presented frame actually
+    // flipped to the screen, or 0 when the backend cannot report it (yet).
+    uint64_t lastFlipTimeNS = 0;
+};
+
 class SwapChainBase : public ApiObjectBase {
   public:
     explicit SwapChainBase(DeviceBase* device);
@@ -120,6 +140,22 @@ class NewSwapChainBase : public SwapChainBase {
     TextureViewBase* APIGetCurrentTextureView() override;
     void APIPresent() override;
 
+    // Frame pacing. SetMaximumFrameLatency bounds how many presents may be queued before
+    // WaitForFrameLatency blocks; WaitForFrameLatency blocks until the presentation engine is
+    // ready to accept a frame within that bound. Backends without dedicated pacing primitives
+    // fall back to the pacing implied by back buffer reuse and report a flip time of 0.
+    MaybeError SetMaximumFrameLatency(uint32_t maxLatency);
+    MaybeError WaitForFrameLatency();
+    ResultOrError<SwapChainPresentStatistics> GetPresentStatistics();
+
+    uint32_t GetMaximumFrameLatency() const;
+
+    // Declares which regions of the swapchain changed since the last time the *same buffer* was
+    // presented; everything outside the rects must be unchanged. The hint only applies to the
+    // next Present and resets afterwards; no hint means full damage. Backends with a partial
+    // presentation primitive use it to reduce compositor work, the others ignore it.
+    MaybeError SetNextPresentDamage(const PresentDamageRect* rects, uint32_t rectCount);
+
     uint32_t GetWidth() const;
     uint32_t GetHeight() const;
     wgpu::TextureFormat GetFormat() const;
@@ -134,6 +170,8 @@ class NewSwapChainBase : public SwapChainBase {
 
   private:
     bool mAttached;
+    uint32_t mMaximumFrameLatency = 2;
+    uint64_t mPresentCount = 0;
     uint32_t mWidth;
     uint32_t mHeight;
     wgpu::TextureFormat mFormat;
@@ -144,6 +182,7 @@ class NewSwapChainBase : public SwapChainBase {
     // DetachFromSurface and mSurface will be updated to nullptr.
     Surface* mSurface = nullptr;
     Ref<TextureViewBase> mCurrentTextureView;
+    std::vector<PresentDamageRect> mNextPresentDamage;
 
     MaybeError ValidatePresent() const;
     MaybeError ValidateGetCurrentTextureView() const;
@@ -158,9 +197,22 @@ class NewSwapChainBase : public SwapChainBase {
     // invalid.
     virtual MaybeError PresentImpl() = 0;
 
+  protected:
+    // The damage rects set for the next present, clamped to the swapchain size. Only valid
+    // during PresentImpl; empty means the whole swapchain must be presented.
+    const std::vector<PresentDamageRect>& GetNextPresentDamage() const;
+
+  private:
+
     // Guaranteed to be called exactly once during the lifetime of the SwapChain. After it is
     // called no other virtual method can be called.
     virtual void DetachFromSurfaceImpl() = 0;
+
+    // Frame pacing backend hooks. The defaults do nothing (the base already recorded the new
+    // latency) and report an unknown flip time.
+    virtual MaybeError SetMaximumFrameLatencyImpl(uint32_t maxLatency);
+    virtual MaybeError WaitForFrameLatencyImpl();
+    virtual ResultOrError<uint64_t> GetLastFlipTimeImpl();
 };
 
 }  // namespace dawn::native
@@ -0,0 +1,340 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/TLSFMemoryAllocator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Compiler.h"
+#include "dawn/common/Math.h"
+#include "dawn/native/ResourceHeapAllocator.h"
+
+namespace dawn::native {
+
+TLSFMemoryAllocator::TLSFMemoryAllocator(uint64_t memoryBlockSize,
+                                         ResourceHeapAllocator* heapAllocator)
+    : mMemoryBlockSize(memoryBlockSize), mHeapAllocator(heapAllocator) {
+    ASSERT(IsPowerOfTwo(mMemoryBlockSize));
+    ASSERT(mMemoryBlockSize >= kMinBlockSize * kNumSecondLevels);
+
+    const uint32_t numFirstLevels =
+        Log2(mMemoryBlockSize) - ConstexprLog2(kMinBlockSize) + 1;
+    // Keep the first-level bitmap (and the shifts on it) within a uint32_t.
+    ASSERT(numFirstLevels < 32);
+    mFreeLists.resize(numFirstLevels, {});
+    mSecondLevelBitmaps.resize(numFirstLevels, 0);
+}
+
+TLSFMemoryAllocator::~TLSFMemoryAllocator() {
+    ASSERT(mAllocatedBlocks.empty());
+    ASSERT(mUsedMemory == 0);
+    // With every sub-allocation freed all heaps were released and the free lists are empty,
+    // but clean up defensively in case an allocation leaked.
+    for (auto& freeLists : mFreeLists) {
+        for (Block* block : freeLists) {
+            while (block != nullptr) {
+                Block* next = block->nextFree;
+                delete block;
+                block = next;
+            }
+        }
+    }
+}
+
+uint64_t TLSFMemoryAllocator::GetHeapIndex(uint64_t offset) const {
+    return offset / mMemoryBlockSize;
+}
+
+void TLSFMemoryAllocator::GetSizeClass(uint64_t size, uint32_t* fl, uint32_t* sl) const {
+    ASSERT(size >= kMinBlockSize);
+    ASSERT(size <= mMemoryBlockSize);
+    const uint32_t log2 = Log2(size);
+    *fl = log2 - ConstexprLog2(kMinBlockSize);
+    *sl = static_cast<uint32_t>((size >> (log2 - kSecondLevelLog2)) - kNumSecondLevels);
+}
+
+TLSFMemoryAllocator::Block* TLSFMemoryAllocator::FindFreeBlock(uint64_t searchSize) const {
+    ASSERT(searchSize >= kMinBlockSize);
+    ASSERT(searchSize <= mMemoryBlockSize);
+
+    // Round the request up to the next size class boundary so that every block in the list
+    // the indices map to is guaranteed to be large enough, making the search a bitmap scan
+    // instead of a walk of the list. Rounding can overshoot mMemoryBlockSize near the top;
+    // clamping is correct there because the top class only ever holds full-range blocks.
+    uint64_t roundedSize =
+        searchSize + ((uint64_t(1) << (Log2(searchSize) - kSecondLevelLog2)) - 1);
+    roundedSize = std::min(roundedSize, mMemoryBlockSize);
+
+    uint32_t fl;
+    uint32_t sl;
+    GetSizeClass(roundedSize, &fl, &sl);
+
+    uint32_t slBitmap = mSecondLevelBitmaps[fl] & (~0u << sl);
+    if (slBitmap == 0) {
+        // No fitting list in this first level, take the smallest block of the next non-empty
+        // one; any of its lists works since all their blocks are larger than the request.
+        const uint32_t flBitmap = mFirstLevelBitmap & (~0u << (fl + 1));
+        if (flBitmap == 0) {
+            return nullptr;
+        }
+        fl = ScanForward(flBitmap);
+        slBitmap = mSecondLevelBitmaps[fl];
+        ASSERT(slBitmap != 0);
+    }
+    sl = ScanForward(slBitmap);
+
+    ASSERT(mFreeLists[fl][sl] != nullptr);
+    return mFreeLists[fl][sl];
+}
+
+void TLSFMemoryAllocator::InsertFreeBlock(Block* block) {
+    uint32_t fl;
+    uint32_t sl;
+    GetSizeClass(block->size, &fl, &sl);
+
+    block->isFree = true;
+    block->prevFree = nullptr;
+    block->nextFree = mFreeLists[fl][sl];
+    if (block->nextFree != nullptr) {
+        block->nextFree->prevFree = block;
+    }
+    mFreeLists[fl][sl] = block;
+
+    mSecondLevelBitmaps[fl] |= 1u << sl;
+    mFirstLevelBitmap |= 1u << fl;
+}
+
+void TLSFMemoryAllocator::RemoveFreeBlock(Block* block) {
+    ASSERT(block->isFree);
+
+    if (block->nextFree != nullptr) {
+        block->nextFree->prevFree = block->prevFree;
+    }
+    if (block->prevFree != nullptr) {
+        block->prevFree->nextFree = block->nextFree;
+    } else {
+        uint32_t fl;
+        uint32_t sl;
+        GetSizeClass(block->size, &fl, &sl);
+        ASSERT(mFreeLists[fl][sl] == block);
+        mFreeLists[fl][sl] = block->nextFree;
+        if (mFreeLists[fl][sl] == nullptr) {
+            mSecondLevelBitmaps[fl] &= ~(1u << sl);
+            if (mSecondLevelBitmaps[fl] == 0) {
+                mFirstLevelBitmap &= ~(1u << fl);
+            }
+        }
+    }
+
+    block->isFree = false;
+    block->prevFree = nullptr;
+    block->nextFree = nullptr;
+}
+
+MaybeError TLSFMemoryAllocator::BackNewHeap() {
+    std::unique_ptr<ResourceHeapBase> heap;
+    DAWN_TRY_ASSIGN(heap, mHeapAllocator->AllocateResourceHeap(mMemoryBlockSize));
+
+    uint64_t heapIndex;
+    if (!mFreeHeapIndices.empty()) {
+        heapIndex = mFreeHeapIndices.back();
+        mFreeHeapIndices.pop_back();
+    } else {
+        heapIndex = mHeaps.size();
+        mHeaps.emplace_back();
+    }
+    ASSERT(mHeaps[heapIndex].refcount == 0);
+    ASSERT(mHeaps[heapIndex].heap == nullptr);
+    mHeaps[heapIndex].heap = std::move(heap);
+
+    Block* block = new Block;
+    block->offset = heapIndex * mMemoryBlockSize;
+    block->size = mMemoryBlockSize;
+    InsertFreeBlock(block);
+    return {};
+}
+
+ResultOrError<ResourceMemoryAllocation> TLSFMemoryAllocator::Allocate(uint64_t allocationSize,
+                                                                      uint64_t alignment) {
+    ResourceMemoryAllocation invalidAllocation = ResourceMemoryAllocation{};
+
+    if (allocationSize == 0) {
+        return std::move(invalidAllocation);
+    }
+
+    ASSERT(IsPowerOfTwo(alignment));
+
+    // Allocation cannot exceed the heap size.
+    if (allocationSize > mMemoryBlockSize) {
+        return std::move(invalidAllocation);
+    }
+
+    const uint64_t size = RoundUp(allocationSize, kMinBlockSize);
+
+    // Block offsets are always multiples of kMinBlockSize so alignments up to it are free.
+    // For larger alignments search with enough slack that an aligned sub-range is guaranteed
+    // to exist in the block; the slack in front is split back into the free lists below.
+    uint64_t searchSize = size;
+    if (alignment > kMinBlockSize) {
+        searchSize += alignment;
+    }
+    if (searchSize > mMemoryBlockSize) {
+        return std::move(invalidAllocation);
+    }
+
+    Block* block = FindFreeBlock(searchSize);
+    if (block == nullptr) {
+        DAWN_TRY(BackNewHeap());
+        block = FindFreeBlock(searchSize);
+        ASSERT(block != nullptr);
+    }
+    RemoveFreeBlock(block);
+
+    // Split off the front padding needed to honor |alignment|. The padding is a multiple of
+    // kMinBlockSize (offsets and alignments both are), so it is always a valid free block.
+    const uint64_t alignedOffset = RoundUp(block->offset, alignment);
+    const uint64_t padding = alignedOffset - block->offset;
+    ASSERT(padding + size <= block->size);
+    if (padding != 0) {
+        Block* front = new Block;
+        front->offset = block->offset;
+        front->size = padding;
+        front->prevPhysical = block->prevPhysical;
+        front->nextPhysical = block;
+        if (front->prevPhysical != nullptr) {
+            front->prevPhysical->nextPhysical = front;
+        }
+        block->prevPhysical = front;
+        block->offset = alignedOffset;
+        block->size -= padding;
+        InsertFreeBlock(front);
+    }
+
+    // Split the tail remainder back into the free lists.
+    if (block->size - size >= kMinBlockSize) {
+        Block* tail = new Block;
+        tail->offset = block->offset + size;
+        tail->size = block->size - size;
+        tail->prevPhysical = block;
+        tail->nextPhysical = block->nextPhysical;
+        if (tail->nextPhysical != nullptr) {
+            tail->nextPhysical->prevPhysical = tail;
+        }
+        block->nextPhysical = tail;
+        block->size = size;
+        InsertFreeBlock(tail);
+    }
+
+    const uint64_t heapIndex = GetHeapIndex(block->offset);
+    mHeaps[heapIndex].refcount++;
+    mUsedMemory += block->size;
+    const bool inserted = mAllocatedBlocks.emplace(block->offset, block).second;
+    ASSERT(inserted);
+    DAWN_UNUSED(inserted);
+
+    AllocationInfo info;
+    info.mBlockOffset = block->offset;
+    info.mMethod = AllocationMethod::kSubAllocated;
+
+    // Allocation offset is always local to the memory.
+    const uint64_t memoryOffset = block->offset % mMemoryBlockSize;
+
+    return ResourceMemoryAllocation{info, memoryOffset, mHeaps[heapIndex].heap.get()};
+}
+
+void TLSFMemoryAllocator::Deallocate(const ResourceMemoryAllocation& allocation) {
+    const AllocationInfo info = allocation.GetInfo();
+
+    ASSERT(info.mMethod == AllocationMethod::kSubAllocated);
+
+    auto it = mAllocatedBlocks.find(info.mBlockOffset);
+    ASSERT(it != mAllocatedBlocks.end());
+    Block* block = it->second;
+    mAllocatedBlocks.erase(it);
+
+    ASSERT(mUsedMemory >= block->size);
+    mUsedMemory -= block->size;
+
+    const uint64_t heapIndex = GetHeapIndex(block->offset);
+
+    // Coalesce with the free physical neighbors so free blocks are always maximally merged.
+    if (block->prevPhysical != nullptr && block->prevPhysical->isFree) {
+        Block* prev = block->prevPhysical;
+        RemoveFreeBlock(prev);
+        prev->size += block->size;
+        prev->nextPhysical = block->nextPhysical;
+        if (prev->nextPhysical != nullptr) {
+            prev->nextPhysical->prevPhysical = prev;
+        }
+        delete block;
+        block = prev;
+    }
+    if (block->nextPhysical != nullptr && block->nextPhysical->isFree) {
+        Block* next = block->nextPhysical;
+        RemoveFreeBlock(next);
+        block->size += next->size;
+        block->nextPhysical = next->nextPhysical;
+        if (block->nextPhysical != nullptr) {
+            block->nextPhysical->prevPhysical = block;
+        }
+        delete next;
+    }
+
+    ASSERT(mHeaps[heapIndex].refcount > 0);
+    mHeaps[heapIndex].refcount--;
+    if (mHeaps[heapIndex].refcount == 0) {
+        // No sub-allocation is left in the heap so everything coalesced back into one
+        // full-range block: release the backing memory instead of keeping it in the lists.
+        ASSERT(block->offset == heapIndex * mMemoryBlockSize);
+        ASSERT(block->size == mMemoryBlockSize);
+        delete block;
+        mHeapAllocator->DeallocateResourceHeap(std::move(mHeaps[heapIndex].heap));
+        mFreeHeapIndices.push_back(heapIndex);
+        return;
+    }
+
+    InsertFreeBlock(block);
+}
+
+uint64_t TLSFMemoryAllocator::GetMemoryBlockSize() const {
+    return mMemoryBlockSize;
+}
+
+uint64_t TLSFMemoryAllocator::GetReservedMemory() const {
+    uint64_t reservedMemory = 0;
+    for (const TrackedHeap& trackedHeap : mHeaps) {
+        if (trackedHeap.heap != nullptr) {
+            reservedMemory += mMemoryBlockSize;
+        }
+    }
+    return reservedMemory;
+}
+
+uint64_t TLSFMemoryAllocator::GetUsedMemory() const {
+    return mUsedMemory;
+}
+
+uint64_t TLSFMemoryAllocator::ComputeTotalNumOfHeapsForTesting() const {
+    uint64_t count = 0;
+    for (const TrackedHeap& trackedHeap : mHeaps) {
+        if (trackedHeap.heap != nullptr) {
+            count++;
+        }
+    }
+    return count;
+}
+
+}  // namespace dawn::native
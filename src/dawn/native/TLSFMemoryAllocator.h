@@ -0,0 +1,120 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_TLSFMEMORYALLOCATOR_H_
+#define SRC_DAWN_NATIVE_TLSFMEMORYALLOCATOR_H_
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "dawn/native/Error.h"
+#include "dawn/native/ResourceMemoryAllocation.h"
+
+namespace dawn::native {
+
+class ResourceHeapAllocator;
+
+// TLSFMemoryAllocator sub-allocates device memory with a two-level segregated fit (TLSF)
+// allocator. Like BuddyMemoryAllocator it places allocations in fixed-size backing heaps
+// requested from a ResourceHeapAllocator, but blocks are carved at their exact (min-block
+// aligned) size instead of being rounded up to a power of two, which avoids the up-to-50%
+// internal fragmentation the buddy system pays on sizes just above a power of two.
+//
+// Free blocks are segregated in per-size-class free lists indexed by a first level (the size's
+// power of two) and a second level (a linear subdivision of that power of two). Two bitmaps
+// mirror which lists are non-empty so that allocation is a good-fit search in O(1):
+// round the request up to the next size class, then scan the bitmaps for the first non-empty
+// list at or above it. Deallocation coalesces a block with its physical neighbors in O(1)
+// through doubly-linked neighbor pointers. Backing heaps are created when no free block fits
+// and released as soon as their last sub-allocation is freed, like the buddy system does.
+//
+// The ResourceHeapAllocator should return ResourceHeaps that are all compatible with each
+// other. It should also outlive all the resources that are in the allocator.
+class TLSFMemoryAllocator {
+  public:
+    TLSFMemoryAllocator(uint64_t memoryBlockSize, ResourceHeapAllocator* heapAllocator);
+    ~TLSFMemoryAllocator();
+
+    ResultOrError<ResourceMemoryAllocation> Allocate(uint64_t allocationSize, uint64_t alignment);
+    void Deallocate(const ResourceMemoryAllocation& allocation);
+
+    uint64_t GetMemoryBlockSize() const;
+
+    // Fragmentation metrics: the memory held in backing heaps, and the part of it occupied by
+    // live sub-allocations. Their difference is the current internal + external fragmentation.
+    uint64_t GetReservedMemory() const;
+    uint64_t GetUsedMemory() const;
+
+    // For testing purposes.
+    uint64_t ComputeTotalNumOfHeapsForTesting() const;
+
+  private:
+    // Blocks smaller than this are never created; all block sizes and offsets are multiples
+    // of it so blocks stay aligned without per-allocation padding for common alignments.
+    static constexpr uint64_t kMinBlockSize = 64;
+    static constexpr uint32_t kSecondLevelLog2 = 4;
+    static constexpr uint32_t kNumSecondLevels = 1u << kSecondLevelLog2;
+
+    // Block metadata lives on the host since the managed memory is not CPU-addressable.
+    // |prevPhysical|/|nextPhysical| chain the blocks of one backing heap in offset order for
+    // O(1) coalescing; they never cross a heap boundary. |prevFree|/|nextFree| link the block
+    // into the free list of its size class while it is free.
+    struct Block {
+        uint64_t offset;
+        uint64_t size;
+        bool isFree = false;
+        Block* prevPhysical = nullptr;
+        Block* nextPhysical = nullptr;
+        Block* prevFree = nullptr;
+        Block* nextFree = nullptr;
+    };
+
+    struct TrackedHeap {
+        size_t refcount = 0;
+        std::unique_ptr<ResourceHeapBase> heap;
+    };
+
+    void GetSizeClass(uint64_t size, uint32_t* fl, uint32_t* sl) const;
+    Block* FindFreeBlock(uint64_t searchSize) const;
+    void InsertFreeBlock(Block* block);
+    void RemoveFreeBlock(Block* block);
+    MaybeError BackNewHeap();
+    uint64_t GetHeapIndex(uint64_t offset) const;
+
+    uint64_t mMemoryBlockSize = 0;
+    ResourceHeapAllocator* mHeapAllocator;
+
+    // Free lists segregated by (first level, second level) size class, with bitmaps of the
+    // non-empty lists. A set bit in |mFirstLevelBitmap| means the matching second-level
+    // bitmap has at least one set bit.
+    std::vector<std::array<Block*, kNumSecondLevels>> mFreeLists;
+    std::vector<uint32_t> mSecondLevelBitmaps;
+    uint32_t mFirstLevelBitmap = 0;
+
+    // Backing heaps indexed by offset / |mMemoryBlockSize|. Slots whose heap was released are
+    // recycled through |mFreeHeapIndices| before the address space is grown.
+    std::vector<TrackedHeap> mHeaps;
+    std::vector<uint64_t> mFreeHeapIndices;
+
+    // Live sub-allocations keyed by block offset, to recover the block on Deallocate.
+    std::unordered_map<uint64_t, Block*> mAllocatedBlocks;
+
+    uint64_t mUsedMemory = 0;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_TLSFMEMORYALLOCATOR_H_
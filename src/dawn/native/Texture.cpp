@@ -15,6 +15,8 @@
 #include "dawn/native/Texture.h"
 
 #include <algorithm>
+#include <bitset>
+#include <unordered_set>
 
 #include "dawn/common/Assert.h"
 #include "dawn/common/Constants.h"
@@ -23,13 +25,18 @@
 #include "dawn/native/ChainUtils_autogen.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/EnumMaskIterator.h"
+#include "dawn/native/ObjectContentHasher.h"
 #include "dawn/native/ObjectType_autogen.h"
 #include "dawn/native/PassResourceUsage.h"
+#include "dawn/native/Queue.h"
 #include "dawn/native/ValidationUtils_autogen.h"
 
 namespace dawn::native {
 namespace {
 
+// Number of subresource initialization bits packed in each word of the tracking bitset.
+constexpr uint32_t kSubresourceBitsPerWord = 64;
+
 MaybeError ValidateTextureViewFormatCompatibility(const DeviceBase* device,
                                                   const Format& format,
                                                   wgpu::TextureFormat viewFormatEnum) {
@@ -289,7 +296,11 @@ MaybeError ValidateTextureSize(const DeviceBase* device,
 MaybeError ValidateTextureUsage(const TextureDescriptor* descriptor,
                                 wgpu::TextureUsage usage,
                                 const Format* format) {
-    DAWN_TRY(dawn::native::ValidateTextureUsage(usage));
+    // kTransientAttachment is a native-only usage that may be requested through
+    // DawnTextureInternalUsageDescriptor, so exclude it from the API bitmask validation of the
+    // combined usage. The descriptor's own usage must still only contain API bits.
+    DAWN_TRY(dawn::native::ValidateTextureUsage(descriptor->usage));
+    DAWN_TRY(dawn::native::ValidateTextureUsage(usage & ~kTransientAttachment));
 
     DAWN_INVALID_IF(usage == wgpu::TextureUsage::None, "The texture usage must not be 0.");
 
@@ -325,6 +336,16 @@ MaybeError ValidateTextureUsage(const TextureDescriptor* descriptor,
                     "The texture usage (%s) is incompatible with the multi-planar format (%s).",
                     usage, format->format);
 
+    // Transient attachments live in memory that may never be readable or writable outside of a
+    // render pass, so no other usage may be combined with them.
+    constexpr wgpu::TextureUsage kValidTransientUsages =
+        kTransientAttachment | wgpu::TextureUsage::RenderAttachment;
+    DAWN_INVALID_IF(
+        (usage & kTransientAttachment) && usage != kValidTransientUsages,
+        "The texture usage (%s) includes the transient attachment usage, so it must be exactly "
+        "(%s).",
+        usage, kValidTransientUsages);
+
     return {};
 }
 
@@ -522,6 +543,13 @@ bool IsValidSampleCount(uint32_t sampleCount) {
 
 // TextureBase
 
+// The views created through CreateTextureView, interned by descriptor contents. Entries are
+// raw pointers kept alive by external references; each view removes itself on destruction.
+struct TextureBase::ViewCache {
+    std::unordered_set<TextureViewBase*, CachedObject::HashFunc, TextureViewBase::EqualityFunc>
+        cache;
+};
+
 TextureBase::TextureBase(DeviceBase* device,
                          const TextureDescriptor* descriptor,
                          TextureState state)
@@ -535,8 +563,10 @@ TextureBase::TextureBase(DeviceBase* device,
       mInternalUsage(mUsage),
       mState(state),
       mFormatEnumForReflection(descriptor->format) {
-    uint32_t subresourceCount = mMipLevelCount * GetArrayLayers() * GetAspectCount(mFormat.aspects);
-    mIsSubresourceContentInitializedAtIndex = std::vector<bool>(subresourceCount, false);
+    mSubresourceCount = mMipLevelCount * GetArrayLayers() * GetAspectCount(mFormat.aspects);
+    mUninitializedSubresourceCount = mSubresourceCount;
+    mIsSubresourceContentInitializedBits.resize(
+        (mSubresourceCount + kSubresourceBitsPerWord - 1) / kSubresourceBitsPerWord, 0);
 
     for (uint32_t i = 0; i < descriptor->viewFormatCount; ++i) {
         if (descriptor->viewFormats[i] == descriptor->format) {
@@ -552,6 +582,7 @@ TextureBase::TextureBase(DeviceBase* device,
     if (internalUsageDesc != nullptr) {
         mInternalUsage |= internalUsageDesc->internalUsage;
     }
+    mViewCache = std::make_unique<ViewCache>();
     TrackInDevice();
 }
 
@@ -561,6 +592,7 @@ static constexpr Format kUnusedFormat;
 
 TextureBase::TextureBase(DeviceBase* device, TextureState state)
     : ApiObjectBase(device, kLabelNotImplemented), mFormat(kUnusedFormat), mState(state) {
+    mViewCache = std::make_unique<ViewCache>();
     TrackInDevice();
 }
 
@@ -574,10 +606,15 @@ TextureBase::TextureBase(DeviceBase* device,
       mMipLevelCount(descriptor->mipLevelCount),
       mSampleCount(descriptor->sampleCount),
       mUsage(descriptor->usage),
-      mFormatEnumForReflection(descriptor->format) {}
+      mFormatEnumForReflection(descriptor->format) {
+    mViewCache = std::make_unique<ViewCache>();
+}
 
 void TextureBase::DestroyImpl() {
     mState = TextureState::Destroyed;
+    // Command buffers referencing this texture may have a cached submit validation verdict
+    // that destruction invalidates.
+    GetDevice()->IncrementSubmitValidationGeneration();
 }
 
 // static
@@ -640,7 +677,7 @@ uint32_t TextureBase::GetSampleCount() const {
 }
 uint32_t TextureBase::GetSubresourceCount() const {
     ASSERT(!IsError());
-    return static_cast<uint32_t>(mIsSubresourceContentInitializedAtIndex.size());
+    return mSubresourceCount;
 }
 wgpu::TextureUsage TextureBase::GetUsage() const {
     ASSERT(!IsError());
@@ -669,16 +706,26 @@ uint32_t TextureBase::GetSubresourceIndex(uint32_t mipLevel,
 
 bool TextureBase::IsSubresourceContentInitialized(const SubresourceRange& range) const {
     ASSERT(!IsError());
+    // Single load for the common case where every subresource is already initialized.
+    if (mUninitializedSubresourceCount == 0) {
+        return true;
+    }
     for (Aspect aspect : IterateEnumMask(range.aspects)) {
+        // Subresource indices are mip-major within a layer, so when the range covers the full
+        // mip chain the layers form one contiguous run of bits.
+        if (range.levelCount == mMipLevelCount) {
+            uint32_t firstIndex =
+                GetSubresourceIndex(range.baseMipLevel, range.baseArrayLayer, aspect);
+            if (!AreSubresourcesInitialized(firstIndex, mMipLevelCount * range.layerCount)) {
+                return false;
+            }
+            continue;
+        }
         for (uint32_t arrayLayer = range.baseArrayLayer;
              arrayLayer < range.baseArrayLayer + range.layerCount; ++arrayLayer) {
-            for (uint32_t mipLevel = range.baseMipLevel;
-                 mipLevel < range.baseMipLevel + range.levelCount; ++mipLevel) {
-                uint32_t subresourceIndex = GetSubresourceIndex(mipLevel, arrayLayer, aspect);
-                ASSERT(subresourceIndex < mIsSubresourceContentInitializedAtIndex.size());
-                if (!mIsSubresourceContentInitializedAtIndex[subresourceIndex]) {
-                    return false;
-                }
+            uint32_t firstIndex = GetSubresourceIndex(range.baseMipLevel, arrayLayer, aspect);
+            if (!AreSubresourcesInitialized(firstIndex, range.levelCount)) {
+                return false;
             }
         }
     }
@@ -688,19 +735,68 @@ bool TextureBase::IsSubresourceContentInitialized(const SubresourceRange& range)
 void TextureBase::SetIsSubresourceContentInitialized(bool isInitialized,
                                                      const SubresourceRange& range) {
     ASSERT(!IsError());
+    if (isInitialized && mUninitializedSubresourceCount == 0) {
+        return;
+    }
     for (Aspect aspect : IterateEnumMask(range.aspects)) {
+        if (range.levelCount == mMipLevelCount) {
+            uint32_t firstIndex =
+                GetSubresourceIndex(range.baseMipLevel, range.baseArrayLayer, aspect);
+            UpdateSubresourceInitializedRange(firstIndex, mMipLevelCount * range.layerCount,
+                                              isInitialized);
+            continue;
+        }
         for (uint32_t arrayLayer = range.baseArrayLayer;
              arrayLayer < range.baseArrayLayer + range.layerCount; ++arrayLayer) {
-            for (uint32_t mipLevel = range.baseMipLevel;
-                 mipLevel < range.baseMipLevel + range.levelCount; ++mipLevel) {
-                uint32_t subresourceIndex = GetSubresourceIndex(mipLevel, arrayLayer, aspect);
-                ASSERT(subresourceIndex < mIsSubresourceContentInitializedAtIndex.size());
-                mIsSubresourceContentInitializedAtIndex[subresourceIndex] = isInitialized;
-            }
+            uint32_t firstIndex = GetSubresourceIndex(range.baseMipLevel, arrayLayer, aspect);
+            UpdateSubresourceInitializedRange(firstIndex, range.levelCount, isInitialized);
         }
     }
 }
 
+bool TextureBase::AreSubresourcesInitialized(uint32_t firstIndex, uint32_t count) const {
+    ASSERT(firstIndex + count <= mSubresourceCount);
+    uint32_t word = firstIndex / kSubresourceBitsPerWord;
+    uint32_t bit = firstIndex % kSubresourceBitsPerWord;
+    while (count > 0) {
+        uint32_t bitsInWord = std::min(count, kSubresourceBitsPerWord - bit);
+        uint64_t mask = (~uint64_t(0) >> (kSubresourceBitsPerWord - bitsInWord)) << bit;
+        if ((mIsSubresourceContentInitializedBits[word] & mask) != mask) {
+            return false;
+        }
+        count -= bitsInWord;
+        bit = 0;
+        word++;
+    }
+    return true;
+}
+
+void TextureBase::UpdateSubresourceInitializedRange(uint32_t firstIndex,
+                                                    uint32_t count,
+                                                    bool isInitialized) {
+    ASSERT(firstIndex + count <= mSubresourceCount);
+    uint32_t word = firstIndex / kSubresourceBitsPerWord;
+    uint32_t bit = firstIndex % kSubresourceBitsPerWord;
+    while (count > 0) {
+        uint32_t bitsInWord = std::min(count, kSubresourceBitsPerWord - bit);
+        uint64_t mask = (~uint64_t(0) >> (kSubresourceBitsPerWord - bitsInWord)) << bit;
+        uint64_t& bits = mIsSubresourceContentInitializedBits[word];
+        // Only the bits that actually change contribute to the uninitialized count.
+        if (isInitialized) {
+            mUninitializedSubresourceCount -=
+                std::bitset<kSubresourceBitsPerWord>(mask & ~bits).count();
+            bits |= mask;
+        } else {
+            mUninitializedSubresourceCount +=
+                std::bitset<kSubresourceBitsPerWord>(mask & bits).count();
+            bits &= ~mask;
+        }
+        count -= bitsInWord;
+        bit = 0;
+        word++;
+    }
+}
+
 MaybeError TextureBase::ValidateCanUseInSubmitNow() const {
     ASSERT(!IsError());
     DAWN_INVALID_IF(mState == TextureState::Destroyed, "Destroyed texture %s used in a submit.",
@@ -766,6 +862,24 @@ ResultOrError<Ref<TextureViewBase>> TextureBase::CreateView(
     return GetDevice()->CreateTextureView(this, descriptor);
 }
 
+TextureViewBase* TextureBase::GetCachedView(TextureViewBase* blueprint) {
+    auto iter = mViewCache->cache.find(blueprint);
+    if (iter == mViewCache->cache.end()) {
+        return nullptr;
+    }
+    return *iter;
+}
+
+void TextureBase::CacheView(TextureViewBase* view) {
+    bool inserted = mViewCache->cache.insert(view).second;
+    ASSERT(inserted);
+}
+
+void TextureBase::UncacheView(TextureViewBase* view) {
+    size_t removedCount = mViewCache->cache.erase(view);
+    ASSERT(removedCount == 1);
+}
+
 TextureViewBase* TextureBase::APICreateView(const TextureViewDescriptor* descriptor) {
     DeviceBase* device = GetDevice();
 
@@ -782,6 +896,9 @@ void TextureBase::APIDestroy() {
         return;
     }
     ASSERT(!IsError());
+    // A batched queue write targeting this texture must be recorded before the memory goes
+    // away.
+    GetDevice()->ConsumedError(GetDevice()->GetQueue()->FlushPendingTextureWrites());
     Destroy();
 }
 
@@ -823,14 +940,19 @@ MaybeError TextureBase::ValidateDestroy() const {
 
 // TextureViewBase
 
-TextureViewBase::TextureViewBase(TextureBase* texture, const TextureViewDescriptor* descriptor)
+TextureViewBase::TextureViewBase(TextureBase* texture,
+                                 const TextureViewDescriptor* descriptor,
+                                 ApiObjectBase::UntrackedByDeviceTag tag)
     : ApiObjectBase(texture->GetDevice(), descriptor->label),
       mTexture(texture),
       mFormat(GetDevice()->GetValidInternalFormat(descriptor->format)),
       mDimension(descriptor->dimension),
       mRange({ConvertViewAspect(mFormat, descriptor->aspect),
               {descriptor->baseArrayLayer, descriptor->arrayLayerCount},
-              {descriptor->baseMipLevel, descriptor->mipLevelCount}}) {
+              {descriptor->baseMipLevel, descriptor->mipLevelCount}}) {}
+
+TextureViewBase::TextureViewBase(TextureBase* texture, const TextureViewDescriptor* descriptor)
+    : TextureViewBase(texture, descriptor, kUntrackedByDevice) {
     TrackInDevice();
 }
 
@@ -846,7 +968,12 @@ TextureViewBase::TextureViewBase(DeviceBase* device, ObjectBase::ErrorTag tag)
 
 TextureViewBase::~TextureViewBase() = default;
 
-void TextureViewBase::DestroyImpl() {}
+void TextureViewBase::DestroyImpl() {
+    if (IsCachedReference()) {
+        // Do not uncache the actual cached object if we are a blueprint.
+        mTexture->UncacheView(this);
+    }
+}
 
 // static
 TextureViewBase* TextureViewBase::MakeError(DeviceBase* device) {
@@ -907,4 +1034,27 @@ const SubresourceRange& TextureViewBase::GetSubresourceRange() const {
     return mRange;
 }
 
+size_t TextureViewBase::ComputeContentHash() {
+    // The texture isn't recorded because the cache is per-texture.
+    ObjectContentHasher recorder;
+    recorder.Record(mFormat.format, mDimension, mRange.aspects, mRange.baseArrayLayer,
+                    mRange.layerCount, mRange.baseMipLevel, mRange.levelCount);
+    return recorder.GetContentHash();
+}
+
+bool TextureViewBase::EqualityFunc::operator()(const TextureViewBase* a,
+                                               const TextureViewBase* b) const {
+    if (a == b) {
+        return true;
+    }
+
+    // Formats are canonicalized through GetValidInternalFormat so they compare by address.
+    return &a->mFormat == &b->mFormat && a->mDimension == b->mDimension &&
+           a->mRange.aspects == b->mRange.aspects &&
+           a->mRange.baseArrayLayer == b->mRange.baseArrayLayer &&
+           a->mRange.layerCount == b->mRange.layerCount &&
+           a->mRange.baseMipLevel == b->mRange.baseMipLevel &&
+           a->mRange.levelCount == b->mRange.levelCount;
+}
+
 }  // namespace dawn::native
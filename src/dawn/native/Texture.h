@@ -15,10 +15,12 @@
 #ifndef SRC_DAWN_NATIVE_TEXTURE_H_
 #define SRC_DAWN_NATIVE_TEXTURE_H_
 
+#include <memory>
 #include <vector>
 
 #include "dawn/common/ityp_array.h"
 #include "dawn/common/ityp_bitset.h"
+#include "dawn/native/CachedObject.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/Format.h"
 #include "dawn/native/Forward.h"
@@ -93,6 +95,13 @@ class TextureBase : public ApiObjectBase {
     ResultOrError<Ref<TextureViewBase>> CreateView(
         const TextureViewDescriptor* descriptor = nullptr);
 
+    // Interning of this texture's views, keyed by view descriptor contents: requesting the
+    // same view again returns a new reference to the cached one instead of a duplicate object.
+    // See DeviceBase::CreateTextureView.
+    TextureViewBase* GetCachedView(TextureViewBase* blueprint);
+    void CacheView(TextureViewBase* view);
+    void UncacheView(TextureViewBase* view);
+
     // Dawn API
     TextureViewBase* APICreateView(const TextureViewDescriptor* descriptor = nullptr);
     void APIDestroy();
@@ -129,12 +138,34 @@ class TextureBase : public ApiObjectBase {
     TextureState mState;
     wgpu::TextureFormat mFormatEnumForReflection;
 
-    // TODO(crbug.com/dawn/845): Use a more optimized data structure to save space
-    std::vector<bool> mIsSubresourceContentInitializedAtIndex;
+    bool AreSubresourcesInitialized(uint32_t firstIndex, uint32_t count) const;
+    void UpdateSubresourceInitializedRange(uint32_t firstIndex, uint32_t count, bool isInitialized);
+
+    // Subresource initialization state is tracked as a two-level bitset: each bit of the packed
+    // words marks one subresource as initialized, and mUninitializedSubresourceCount summarizes
+    // them so the common "everything already initialized" check is a single load. Bulk updates
+    // are done with whole-word masks so they cost O(words) instead of O(subresources).
+    // (crbug.com/dawn/845)
+    uint32_t mSubresourceCount = 0;
+    uint32_t mUninitializedSubresourceCount = 0;
+    std::vector<uint64_t> mIsSubresourceContentInitializedBits;
+
+    // Scratch state owned by SyncScopeUsageTracker, see the same members on BufferBase.
+    friend class SyncScopeUsageTracker;
+    uint64_t mLastUsageTrackerSerial = 0;
+    uint32_t mLastUsageTrackerIndex = 0;
+
+    // The view cache isn't defined in the header because it needs TextureViewBase (declared
+    // below) to be complete.
+    struct ViewCache;
+    std::unique_ptr<ViewCache> mViewCache;
 };
 
-class TextureViewBase : public ApiObjectBase {
+class TextureViewBase : public ApiObjectBase, public CachedObject {
   public:
+    TextureViewBase(TextureBase* texture,
+                    const TextureViewDescriptor* descriptor,
+                    ApiObjectBase::UntrackedByDeviceTag tag);
     TextureViewBase(TextureBase* texture, const TextureViewDescriptor* descriptor);
     ~TextureViewBase() override;
 
@@ -154,6 +185,13 @@ class TextureViewBase : public ApiObjectBase {
     uint32_t GetLayerCount() const;
     const SubresourceRange& GetSubresourceRange() const;
 
+    // Functions necessary for the unordered_set<TextureViewBase*>-based per-texture cache.
+    size_t ComputeContentHash() override;
+
+    struct EqualityFunc {
+        bool operator()(const TextureViewBase* a, const TextureViewBase* b) const;
+    };
+
   protected:
     // Constructor used only for mocking and testing.
     explicit TextureViewBase(TextureBase* texture);
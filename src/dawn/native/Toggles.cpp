@@ -313,6 +313,127 @@ static constexpr ToggleEnumAndInfoList kToggleNameAndInfoList = {{
       "integer that is greater than 2^24 or smaller than -2^24). This toggle is also enabled on "
       "Intel GPUs on Metal backend due to a driver issue on Intel Metal driver.",
       "https://crbug.com/dawn/537"}},
+    {Toggle::D3D12SubmitCommandListOnPassBoundary,
+     {"d3d12_submit_command_list_on_pass_boundary",
+      "Close and submit the pending D3D12 command list each time a render or compute pass ends "
+      "during command buffer translation, instead of batching the whole submit into one command "
+      "list. This lets the GPU start executing earlier passes while the CPU is still translating "
+      "later ones, at the cost of more, smaller ExecuteCommandLists calls.",
+      "https://crbug.com/dawn/1473"}},
+    {Toggle::VulkanUseTransientDescriptorPools,
+     {"vulkan_use_transient_descriptor_pools",
+      "Allocate Vulkan descriptor sets linearly from their pools and reclaim each pool with a "
+      "single vkResetDescriptorPool call once every set in it has been deallocated and the GPU "
+      "has finished using them, instead of recycling descriptor sets individually. This reduces "
+      "CPU overhead for applications that create and destroy many bind groups every frame, but "
+      "a pool is only reusable once all of its sets are gone, so long-lived bind groups can "
+      "hold more descriptor memory than the default per-set recycling.",
+      "https://crbug.com/dawn/1546"}},
+    {Toggle::VulkanBatchQueueSubmits,
+     {"vulkan_batch_queue_submits",
+      "Defer the vkQueueSubmit for Queue::Submit calls so that the commands recorded by several "
+      "submits are coalesced into a single vkQueueSubmit sharing one fence. The batch is flushed "
+      "once enough submits accumulate, when the device ticks (typically once per frame), or "
+      "whenever another code path requires the pending commands to reach the GPU. This reduces "
+      "per-submit driver overhead for clients that issue many small submits per frame, at the "
+      "cost of the GPU starting on the batched work later.",
+      "https://crbug.com/dawn/1547"}},
+    {Toggle::MetalUseParallelRenderEncoder,
+     {"metal_use_parallel_render_encoder",
+      "Encode render passes that consist only of render bundles with an "
+      "MTLParallelRenderCommandEncoder, fanning each bundle out to a subordinate encoder on a "
+      "worker thread. This parallelizes the CPU encoding cost of large pre-recorded draw "
+      "streams, but only kicks in for passes with enough draws to amortize the extra encoders.",
+      "https://crbug.com/dawn/1548"}},
+    {Toggle::MetalUseUntrackedHazardResources,
+     {"metal_use_untracked_hazard_resources",
+      "Create Metal buffers and textures with MTLHazardTrackingModeUntracked and order the work "
+      "explicitly instead: encoders are chained with a single MTLFence and compute dispatches "
+      "are separated by memory barriers. This removes the per-resource cost of Metal's "
+      "automatic hazard tracking for scenes that bind many resources, but serializes encoders "
+      "that automatic tracking could have overlapped and gives every blit command its own "
+      "encoder.",
+      "https://crbug.com/dawn/1549"}},
+    {Toggle::EnableBackgroundDeviceTick,
+     {"enable_background_device_tick",
+      "Run a device-owned thread that polls for GPU completion and ticks the device, so that "
+      "completed serials advance and ready callbacks fire with sub-frame latency instead of "
+      "being quantized to how often the application pumps Device::Tick (typically once per "
+      "frame). Callbacks may then be invoked on the polling thread, so the application's "
+      "callbacks must be thread-safe and the device must not be destroyed from inside a "
+      "callback while this toggle is enabled.",
+      "https://crbug.com/dawn/1550"}},
+    {Toggle::CaptureGPUTimeline,
+     {"capture_gpu_timeline",
+      "Write timestamps at every pass begin and end, resolve them asynchronously, and emit "
+      "them as async trace events in the GPUWork category so GPU execution shows up on the "
+      "same trace timeline as Dawn's CPU events. Requires the timestamp-query feature; the "
+      "toggle has no effect without it. Clock sync is a single-point approximation anchored "
+      "to the submit time, so cross-clock offsets of up to the queue latency are expected.",
+      "https://crbug.com/dawn/1551"}},
+    {Toggle::DeferShaderModuleParsing,
+     {"defer_shader_module_parsing",
+      "Return WGSL shader modules from CreateShaderModule before Tint has parsed the source "
+      "and run the parse on the async task manager instead. Pipeline creation and "
+      "GetCompilationInfo wait for the parse, so validation errors in the source surface "
+      "there rather than at module creation.",
+      "https://crbug.com/dawn/1552"}},
+    {Toggle::UseComputeForCompressedTextureUpload,
+     {"use_compute_for_compressed_texture_upload",
+      "Upload block-compressed texture data by copying the raw blocks to the GPU once and "
+      "laying them out to the required row pitch with an internal compute pass, instead of "
+      "repacking every row on the CPU in WriteTexture. Only takes effect for large writes "
+      "whose rows actually need repacking.",
+      "https://crbug.com/dawn/1553"}},
+    {Toggle::MergeComputePassSyncScopes,
+     {"merge_compute_pass_sync_scopes",
+      "Treat all the dispatches of a compute pass as a single synchronization scope recorded "
+      "at the first dispatch, so backends synchronize each resource once per pass instead of "
+      "inserting storage barriers between every pair of dispatches that touch it. The "
+      "synchronization scope usage rules then apply to the whole pass, and the application "
+      "must not make a dispatch read results written by an earlier dispatch in the same pass.",
+      "https://crbug.com/dawn/1555"}},
+    {Toggle::NullBackendSimulateTimeline,
+     {"null_backend_simulate_timeline",
+      "Makes the null backend complete submissions on a simulated GPU timeline instead of "
+      "instantly: every submitted command is charged a configurable cost (see "
+      "SetSimulatedTimelineCosts in NullBackend.h) and a submission's serial only passes once "
+      "the simulated time has elapsed. Lets load tests exercise frontend and wire scheduling "
+      "with many fake devices and realistic completion latencies, without real GPUs.",
+      "https://crbug.com/dawn/1556"}},
+    {Toggle::VulkanUseTLSFSuballocation,
+     {"vulkan_use_tlsf_suballocation",
+      "Sub-allocate Vulkan device memory with a two-level segregated fit (TLSF) allocator "
+      "instead of the buddy allocator. TLSF carves blocks at their exact size in O(1), "
+      "avoiding the internal fragmentation the buddy system's power-of-two rounding causes "
+      "on mixed-size workloads, at the cost of a little more host-side bookkeeping.",
+      "https://crbug.com/dawn/1557"}},
+    {Toggle::ReorderPassesOnFinish,
+     {"reorder_passes_on_finish",
+      "Reorder the independent top-level passes and copies of a command buffer when it is "
+      "finished so that segments with similar resource usage become adjacent, reducing the "
+      "usage transitions backends emit for frames encoded in logical rather than "
+      "barrier-friendly order. Passes are only moved across each other when their recorded "
+      "resource usages cannot conflict, and passes that record queries keep their position.",
+      "https://crbug.com/dawn/1558"}},
+    {Toggle::BatchTextureWrites,
+     {"batch_texture_writes",
+      "Accumulate Queue::WriteTexture calls instead of allocating staging memory and "
+      "recording a copy per call. The batched writes become one staging allocation per "
+      "destination texture and are recorded at the next flush point: a submit, "
+      "OnSubmittedWorkDone, a device tick, or destruction of the destination texture. "
+      "Greatly reduces per-call overhead for workloads doing many small scattered writes, "
+      "such as glyph or decal atlas updates.",
+      "https://crbug.com/dawn/1559"}},
+    {Toggle::DeferTimestampConversions,
+     {"defer_timestamp_conversions",
+      "Defer the tick-to-nanosecond conversion passes of ResolveQuerySet to the end of the "
+      "command buffer so that all the resolved ranges targeting the same destination buffer "
+      "share one availability upload and one conversion dispatch. Changes ordering semantics: "
+      "a copy from the destination buffer recorded after the resolve in the same command "
+      "buffer reads unconverted ticks, so only enable this when resolve results are consumed "
+      "in a later submit.",
+      "https://crbug.com/dawn/1560"}},
     // Comment to separate the }} so it is clearer what to copy-paste to add a toggle.
 }};
 }  // anonymous namespace
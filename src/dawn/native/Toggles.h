@@ -79,6 +79,21 @@ enum class Toggle {
     D3D12AllocateExtraMemoryFor2DArrayTexture,
     D3D12UseTempBufferInDepthStencilTextureAndBufferCopyWithNonZeroBufferOffset,
     ApplyClearBigIntegerColorValueWithDraw,
+    D3D12SubmitCommandListOnPassBoundary,
+    VulkanUseTransientDescriptorPools,
+    VulkanBatchQueueSubmits,
+    MetalUseParallelRenderEncoder,
+    MetalUseUntrackedHazardResources,
+    EnableBackgroundDeviceTick,
+    CaptureGPUTimeline,
+    DeferShaderModuleParsing,
+    UseComputeForCompressedTextureUpload,
+    MergeComputePassSyncScopes,
+    NullBackendSimulateTimeline,
+    VulkanUseTLSFSuballocation,
+    ReorderPassesOnFinish,
+    BatchTextureWrites,
+    DeferTimestampConversions,
 
     EnumCount,
     InvalidEnum = EnumCount,
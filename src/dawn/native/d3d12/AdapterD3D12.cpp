@@ -14,10 +14,15 @@
 
 #include "dawn/native/d3d12/AdapterD3D12.h"
 
+#include <cstring>
 #include <sstream>
+#include <string_view>
 
 #include "dawn/common/Constants.h"
+#include "dawn/common/Version_autogen.h"
 #include "dawn/common/WindowsUtils.h"
+#include "dawn/native/BlobCache.h"
+#include "dawn/native/CacheKey.h"
 #include "dawn/native/Instance.h"
 #include "dawn/native/d3d12/BackendD3D12.h"
 #include "dawn/native/d3d12/D3D12Error.h"
@@ -80,30 +85,51 @@ MaybeError Adapter::InitializeImpl() {
     mVendorId = adapterDesc.VendorId;
     mName = WCharToUTF8(adapterDesc.Description);
 
-    DAWN_TRY_ASSIGN(mDeviceInfo, GatherDeviceInfo(*this));
-
-    if (adapterDesc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) {
-        mAdapterType = wgpu::AdapterType::CPU;
-    } else {
-        mAdapterType =
-            (mDeviceInfo.isUMA) ? wgpu::AdapterType::IntegratedGPU : wgpu::AdapterType::DiscreteGPU;
-    }
-
     // Convert the adapter's D3D12 driver version to a readable string like "24.21.13.9793".
+    uint64_t encodedUmdVersion = 0;
     LARGE_INTEGER umdVersion;
     if (mHardwareAdapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &umdVersion) !=
         DXGI_ERROR_UNSUPPORTED) {
-        uint64_t encodedVersion = umdVersion.QuadPart;
+        encodedUmdVersion = umdVersion.QuadPart;
 
         std::ostringstream o;
         o << "D3D12 driver version ";
         for (size_t i = 0; i < mDriverVersion.size(); ++i) {
-            mDriverVersion[i] = (encodedVersion >> (48 - 16 * i)) & 0xFFFF;
+            mDriverVersion[i] = (encodedUmdVersion >> (48 - 16 * i)) & 0xFFFF;
             o << mDriverVersion[i] << ".";
         }
         mDriverDescription = o.str();
     }
 
+    // The capability queries only change with the adapter or the driver, so their result is
+    // snapshotted in the blob cache and a full re-query happens on driver change only. The
+    // LUID disambiguates identical adapters within a boot session; the driver version keys the
+    // snapshot across driver updates.
+    CacheKey deviceInfoKey;
+    StreamIn(&deviceInfoKey, kDawnVersion, std::string_view("D3D12DeviceInfo"),
+             D3D12DeviceInfoSnapshot::kVersion, adapterDesc.VendorId, adapterDesc.DeviceId,
+             static_cast<int64_t>(adapterDesc.AdapterLuid.HighPart),
+             static_cast<uint64_t>(adapterDesc.AdapterLuid.LowPart), encodedUmdVersion);
+
+    BlobCache* blobCache = GetInstance()->GetBlobCache();
+    Blob snapshotBlob = blobCache->Load(deviceInfoKey);
+    if (snapshotBlob.Size() == sizeof(D3D12DeviceInfoSnapshot)) {
+        D3D12DeviceInfoSnapshot snapshot;
+        std::memcpy(&snapshot, snapshotBlob.Data(), sizeof(snapshot));
+        mDeviceInfo = DeviceInfoFromSnapshot(snapshot);
+    } else {
+        DAWN_TRY_ASSIGN(mDeviceInfo, GatherDeviceInfo(*this));
+        D3D12DeviceInfoSnapshot snapshot = SnapshotFromDeviceInfo(mDeviceInfo);
+        blobCache->Store(deviceInfoKey, sizeof(snapshot), &snapshot);
+    }
+
+    if (adapterDesc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) {
+        mAdapterType = wgpu::AdapterType::CPU;
+    } else {
+        mAdapterType =
+            (mDeviceInfo.isUMA) ? wgpu::AdapterType::IntegratedGPU : wgpu::AdapterType::DiscreteGPU;
+    }
+
     return {};
 }
 
@@ -137,6 +163,7 @@ MaybeError Adapter::InitializeSupportedFeaturesImpl() {
     mSupportedFeatures.EnableFeature(Feature::MultiPlanarFormats);
     mSupportedFeatures.EnableFeature(Feature::Depth32FloatStencil8);
     mSupportedFeatures.EnableFeature(Feature::IndirectFirstInstance);
+    mSupportedFeatures.EnableFeature(Feature::MultiDrawIndirect);
 
     if (GetBackend()->GetFunctions()->IsDXCAvailable()) {
         uint64_t dxcVersion = 0;
@@ -25,7 +25,7 @@ namespace dawn::native::d3d12 {
 
 class Backend;
 
-class Adapter : public AdapterBase {
+class Adapter final : public AdapterBase {
   public:
     Adapter(Backend* backend, ComPtr<IDXGIAdapter3> hardwareAdapter);
     ~Adapter() override;
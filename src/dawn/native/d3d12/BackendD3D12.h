@@ -26,7 +26,7 @@ namespace dawn::native::d3d12 {
 
 class PlatformFunctions;
 
-class Backend : public BackendConnection {
+class Backend final : public BackendConnection {
   public:
     explicit Backend(InstanceBase* instance);
 
@@ -15,6 +15,7 @@
 #include "dawn/native/d3d12/BufferD3D12.h"
 
 #include <algorithm>
+#include <array>
 
 #include "dawn/common/Assert.h"
 #include "dawn/common/Constants.h"
@@ -43,8 +44,45 @@ D3D12_RESOURCE_FLAGS D3D12ResourceFlags(wgpu::BufferUsage usage) {
     return flags;
 }
 
-D3D12_RESOURCE_STATES D3D12BufferUsage(wgpu::BufferUsage usage) {
-    D3D12_RESOURCE_STATES resourceState = D3D12_RESOURCE_STATE_COMMON;
+// The usage-to-state conversion runs per buffer per barrier, so it is precomputed into lookup
+// tables. The internal storage bits live at the top of the usage word, which makes a single
+// dense table impractical; instead the usage is split into two 6-bit halves (MapRead through
+// Vertex, then Uniform through QueryResolve with the two internal storage bits folded in).
+// Every per-bit contribution ORs in independently, so the OR of the two half lookups equals
+// the result of the original per-bit checks.
+constexpr uint32_t kBufferUsageIndexCount = 0x40;
+constexpr uint32_t kLowBufferUsageMask = 0x3F;
+
+constexpr uint32_t HighBufferUsageIndex(wgpu::BufferUsage usage) {
+    uint32_t index = (static_cast<uint32_t>(usage) >> 6) & 0xF;
+    if (usage & kInternalStorageBuffer) {
+        index |= 0x10;
+    }
+    if (usage & kReadOnlyStorageBuffer) {
+        index |= 0x20;
+    }
+    return index;
+}
+
+constexpr wgpu::BufferUsage LowBufferUsageFromIndex(uint32_t index) {
+    return static_cast<wgpu::BufferUsage>(index & kLowBufferUsageMask);
+}
+
+constexpr wgpu::BufferUsage HighBufferUsageFromIndex(uint32_t index) {
+    wgpu::BufferUsage usage = static_cast<wgpu::BufferUsage>((index & 0xF) << 6);
+    if (index & 0x10) {
+        usage = usage | kInternalStorageBuffer;
+    }
+    if (index & 0x20) {
+        usage = usage | kReadOnlyStorageBuffer;
+    }
+    return usage;
+}
+
+constexpr D3D12_RESOURCE_STATES ComputeD3D12BufferUsage(wgpu::BufferUsage usage) {
+    // Accumulated as an integer because the SDK's flag operators for D3D12_RESOURCE_STATES are
+    // not guaranteed to be constexpr.
+    uint32_t resourceState = D3D12_RESOURCE_STATE_COMMON;
 
     if (usage & wgpu::BufferUsage::CopySrc) {
         resourceState |= D3D12_RESOURCE_STATE_COPY_SOURCE;
@@ -62,8 +100,8 @@ D3D12_RESOURCE_STATES D3D12BufferUsage(wgpu::BufferUsage usage) {
         resourceState |= D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
     }
     if (usage & kReadOnlyStorageBuffer) {
-        resourceState |= (D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE |
-                          D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+        resourceState |= D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+        resourceState |= D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
     }
     if (usage & wgpu::BufferUsage::Indirect) {
         resourceState |= D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT;
@@ -72,7 +110,24 @@ D3D12_RESOURCE_STATES D3D12BufferUsage(wgpu::BufferUsage usage) {
         resourceState |= D3D12_RESOURCE_STATE_COPY_DEST;
     }
 
-    return resourceState;
+    return static_cast<D3D12_RESOURCE_STATES>(resourceState);
+}
+
+constexpr std::array<D3D12_RESOURCE_STATES, kBufferUsageIndexCount> MakeD3D12BufferUsageTable(
+    wgpu::BufferUsage (*usageFromIndex)(uint32_t)) {
+    std::array<D3D12_RESOURCE_STATES, kBufferUsageIndexCount> table{};
+    for (uint32_t i = 0; i < kBufferUsageIndexCount; ++i) {
+        table[i] = ComputeD3D12BufferUsage(usageFromIndex(i));
+    }
+    return table;
+}
+
+constexpr auto kLowBufferUsageTable = MakeD3D12BufferUsageTable(LowBufferUsageFromIndex);
+constexpr auto kHighBufferUsageTable = MakeD3D12BufferUsageTable(HighBufferUsageFromIndex);
+
+D3D12_RESOURCE_STATES D3D12BufferUsage(wgpu::BufferUsage usage) {
+    return kLowBufferUsageTable[static_cast<uint32_t>(usage) & kLowBufferUsageMask] |
+           kHighBufferUsageTable[HighBufferUsageIndex(usage)];
 }
 
 D3D12_HEAP_TYPE D3D12HeapType(wgpu::BufferUsage allowedUsage) {
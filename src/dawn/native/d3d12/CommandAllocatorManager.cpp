@@ -14,56 +14,59 @@
 
 #include "dawn/native/d3d12/CommandAllocatorManager.h"
 
+#include <utility>
+
 #include "dawn/native/d3d12/D3D12Error.h"
 #include "dawn/native/d3d12/DeviceD3D12.h"
 
 #include "dawn/common/Assert.h"
-#include "dawn/common/BitSetIterator.h"
+#include "dawn/native/PerformanceTuning.h"
+#include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native::d3d12 {
 
 CommandAllocatorManager::CommandAllocatorManager(Device* device)
-    : device(device), mAllocatorCount(0) {
-    mFreeAllocators.set();
-}
+    : device(device),
+      mMaxCommandAllocators(device->GetTuningProfile().d3d12MaxCommandAllocators) {}
 
 ResultOrError<ID3D12CommandAllocator*> CommandAllocatorManager::ReserveCommandAllocator() {
-    // If there are no free allocators, get the oldest serial in flight and wait on it
-    if (mFreeAllocators.none()) {
-        const ExecutionSerial firstSerial = mInFlightCommandAllocators.FirstSerial();
-        DAWN_TRY(device->WaitForSerial(firstSerial));
-        DAWN_TRY(Tick(firstSerial));
-    }
-
-    ASSERT(mFreeAllocators.any());
-
-    // Get the index of the first free allocator from the bitset
-    unsigned int firstFreeIndex = *(IterateBitSet(mFreeAllocators).begin());
-
-    if (firstFreeIndex >= mAllocatorCount) {
-        ASSERT(firstFreeIndex == mAllocatorCount);
-        mAllocatorCount++;
-        DAWN_TRY(CheckHRESULT(
-            device->GetD3D12Device()->CreateCommandAllocator(
-                D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&mCommandAllocators[firstFreeIndex])),
-            "D3D12 create command allocator"));
+    if (mFreeAllocators.empty()) {
+        if (mAllocatorCount < mMaxCommandAllocators) {
+            // Grow the pool under pressure instead of stalling on the fence.
+            ComPtr<ID3D12CommandAllocator> allocator;
+            DAWN_TRY(CheckHRESULT(device->GetD3D12Device()->CreateCommandAllocator(
+                                      D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&allocator)),
+                                  "D3D12 create command allocator"));
+            mAllocatorCount++;
+            dawn::platform::AddMetric(dawn::platform::MetricCounter::CommandAllocatorsCreated, 1);
+            mFreeAllocators.push_back(std::move(allocator));
+        } else {
+            // The pool is at its cap: wait for the oldest serial in flight and recycle.
+            dawn::platform::AddMetric(dawn::platform::MetricCounter::CommandAllocatorPoolWaits,
+                                      1);
+            const ExecutionSerial firstSerial = mInFlightCommandAllocators.FirstSerial();
+            DAWN_TRY(device->WaitForSerial(firstSerial));
+            DAWN_TRY(Tick(firstSerial));
+        }
     }
 
-    // Mark the command allocator as used
-    mFreeAllocators.reset(firstFreeIndex);
+    ASSERT(!mFreeAllocators.empty());
+    ComPtr<ID3D12CommandAllocator> allocator = std::move(mFreeAllocators.back());
+    mFreeAllocators.pop_back();
+    ID3D12CommandAllocator* allocatorPtr = allocator.Get();
 
     // Enqueue the command allocator. It will be scheduled for reset after the next
     // ExecuteCommandLists
-    mInFlightCommandAllocators.Enqueue({mCommandAllocators[firstFreeIndex], firstFreeIndex},
-                                       device->GetPendingCommandSerial());
-    return mCommandAllocators[firstFreeIndex].Get();
+    mInFlightCommandAllocators.Enqueue(std::move(allocator), device->GetPendingCommandSerial());
+    return allocatorPtr;
 }
 
 MaybeError CommandAllocatorManager::Tick(ExecutionSerial lastCompletedSerial) {
     // Reset all command allocators that are no longer in flight
-    for (auto it : mInFlightCommandAllocators.IterateUpTo(lastCompletedSerial)) {
-        DAWN_TRY(CheckHRESULT(it.commandAllocator->Reset(), "D3D12 reset command allocator"));
-        mFreeAllocators.set(it.index);
+    for (ComPtr<ID3D12CommandAllocator>& allocator :
+         mInFlightCommandAllocators.IterateUpTo(lastCompletedSerial)) {
+        DAWN_TRY(CheckHRESULT(allocator->Reset(), "D3D12 reset command allocator"));
+        mFreeAllocators.push_back(std::move(allocator));
     }
     mInFlightCommandAllocators.ClearUpTo(lastCompletedSerial);
     return {};
@@ -15,7 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_D3D12_COMMANDALLOCATORMANAGER_H_
 #define SRC_DAWN_NATIVE_D3D12_COMMANDALLOCATORMANAGER_H_
 
-#include <bitset>
+#include <vector>
 
 #include "dawn/native/d3d12/d3d12_platform.h"
 
@@ -39,18 +39,15 @@ class CommandAllocatorManager {
   private:
     Device* device;
 
-    // This must be at least 2 because the Device and Queue use separate command allocators
-    static constexpr unsigned int kMaxCommandAllocators = 32;
-    unsigned int mAllocatorCount;
+    // Creating another allocator is far cheaper than a fence wait, so the pool grows on demand
+    // while below this cap; only at the cap does a reservation block on the oldest in-flight
+    // serial. The cap bounds the memory retained by allocators on pathological submit rates,
+    // and comes from the adapter's tuning profile.
+    const unsigned int mMaxCommandAllocators;
+    unsigned int mAllocatorCount = 0;
 
-    struct IndexedCommandAllocator {
-        ComPtr<ID3D12CommandAllocator> commandAllocator;
-        unsigned int index;
-    };
-
-    ComPtr<ID3D12CommandAllocator> mCommandAllocators[kMaxCommandAllocators];
-    std::bitset<kMaxCommandAllocators> mFreeAllocators;
-    SerialQueue<ExecutionSerial, IndexedCommandAllocator> mInFlightCommandAllocators;
+    std::vector<ComPtr<ID3D12CommandAllocator>> mFreeAllocators;
+    SerialQueue<ExecutionSerial, ComPtr<ID3D12CommandAllocator>> mInFlightCommandAllocators;
 };
 
 }  // namespace dawn::native::d3d12
@@ -36,6 +36,7 @@
 #include "dawn/native/d3d12/StagingBufferD3D12.h"
 #include "dawn/native/d3d12/StagingDescriptorAllocatorD3D12.h"
 #include "dawn/native/d3d12/UtilsD3D12.h"
+#include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native::d3d12 {
 
@@ -95,7 +96,7 @@ void RecordWriteTimestampCmd(ID3D12GraphicsCommandList* commandList,
                              uint32_t queryIndex) {
     ASSERT(D3D12QueryType(ToBackend(querySet)->GetQueryType()) == D3D12_QUERY_TYPE_TIMESTAMP);
     commandList->EndQuery(ToBackend(querySet)->GetQueryHeap(), D3D12_QUERY_TYPE_TIMESTAMP,
-                          queryIndex);
+                          ToBackend(querySet)->GetQueryHeapOffset() + queryIndex);
 }
 
 void RecordResolveQuerySetCmd(ID3D12GraphicsCommandList* commandList,
@@ -129,9 +130,11 @@ void RecordResolveQuerySetCmd(ID3D12GraphicsCommandList* commandList,
             destinationOffset + (resolveQueryIndex - firstQuery) * sizeof(uint64_t);
 
         // Resolve the queries between firstTrueIt and nextFalseIt (which is at most lastIt)
-        commandList->ResolveQueryData(
-            querySet->GetQueryHeap(), D3D12QueryType(querySet->GetQueryType()), resolveQueryIndex,
-            resolveQueryCount, destination->GetD3D12Resource(), resolveDestinationOffset);
+        commandList->ResolveQueryData(querySet->GetQueryHeap(),
+                                      D3D12QueryType(querySet->GetQueryType()),
+                                      querySet->GetQueryHeapOffset() + resolveQueryIndex,
+                                      resolveQueryCount, destination->GetD3D12Resource(),
+                                      resolveDestinationOffset);
 
         // Set current iterator to next false
         currentIt = nextFalseIt;
@@ -346,6 +349,10 @@ bool TransitionAndClearForSyncScope(CommandRecordingContext* commandContext,
 
     wgpu::TextureUsage textureUsages = wgpu::TextureUsage::None;
 
+    // Gather every texture subresource that needs lazy initialization so the transitions for
+    // all the clears are submitted with one ResourceBarrier call and the clears are recorded as
+    // one contiguous block before the pass, instead of a transition + clear pair per texture.
+    std::vector<std::pair<Texture*, SubresourceRange>> texturesToClear;
     for (size_t i = 0; i < usages.textures.size(); ++i) {
         Texture* texture = ToBackend(usages.textures[i]);
 
@@ -354,12 +361,30 @@ bool TransitionAndClearForSyncScope(CommandRecordingContext* commandContext,
         // subresource has not been initialized before the render pass.
         usages.textureUsages[i].Iterate(
             [&](const SubresourceRange& range, wgpu::TextureUsage usage) {
-                if (usage & ~wgpu::TextureUsage::RenderAttachment) {
-                    texture->EnsureSubresourceContentInitialized(commandContext, range);
+                if ((usage & ~wgpu::TextureUsage::RenderAttachment) &&
+                    texture->GetDevice()->IsToggleEnabled(Toggle::LazyClearResourceOnFirstUse) &&
+                    !texture->IsSubresourceContentInitialized(range)) {
+                    texturesToClear.emplace_back(texture, range);
                 }
                 textureUsages |= usage;
             });
+    }
+    if (!texturesToClear.empty()) {
+        for (auto& clear : texturesToClear) {
+            clear.first->TransitionForLazyClear(commandContext, &barriers, clear.second);
+        }
+        if (!barriers.empty()) {
+            commandList->ResourceBarrier(barriers.size(), barriers.data());
+            dawn::platform::AddMetric(dawn::platform::MetricCounter::BarriersEmitted,
+                                      barriers.size());
+            barriers.clear();
+        }
+        for (auto& clear : texturesToClear) {
+            clear.first->EnsureSubresourceContentInitialized(commandContext, clear.second);
+        }
+    }
 
+    for (size_t i = 0; i < usages.textures.size(); ++i) {
         ToBackend(usages.textures[i])
             ->TrackUsageAndGetResourceBarrierForPass(commandContext, &barriers,
                                                      usages.textureUsages[i]);
@@ -367,6 +392,8 @@ bool TransitionAndClearForSyncScope(CommandRecordingContext* commandContext,
 
     if (barriers.size()) {
         commandList->ResourceBarrier(barriers.size(), barriers.data());
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::BarriersEmitted,
+                                  barriers.size());
     }
 
     return (bufferUsages & wgpu::BufferUsage::Storage ||
@@ -375,7 +402,7 @@ bool TransitionAndClearForSyncScope(CommandRecordingContext* commandContext,
 
 }  // anonymous namespace
 
-class BindGroupStateTracker : public BindGroupTrackerBase<false, uint64_t> {
+class BindGroupStateTracker : public BindGroupTrackerBase<true, uint64_t> {
     using Base = BindGroupTrackerBase;
 
   public:
@@ -385,7 +412,24 @@ class BindGroupStateTracker : public BindGroupTrackerBase<false, uint64_t> {
           mViewAllocator(device->GetViewShaderVisibleDescriptorAllocator()),
           mSamplerAllocator(device->GetSamplerShaderVisibleDescriptorAllocator()) {}
 
-    void SetInComputePass(bool inCompute_) { mInCompute = inCompute_; }
+    void SetInComputePass(bool inCompute_) {
+        if (mInCompute != inCompute_) {
+            // Root arguments are tracked per bind point so nothing set for graphics is
+            // visible to compute and vice-versa: forget everything applied so far so the
+            // other bind point starts from a clean slate.
+            mLastAppliedPipelineLayout = nullptr;
+            mLastRootSignature = nullptr;
+        }
+        mInCompute = inCompute_;
+    }
+
+    // Must be called when the pending command list was executed and re-opened: the new
+    // command list starts with completely undefined state.
+    void OnNewCommandList(ID3D12GraphicsCommandList* commandList) {
+        mLastAppliedPipelineLayout = nullptr;
+        mLastRootSignature = nullptr;
+        SetID3D12DescriptorHeaps(commandList);
+    }
 
     MaybeError Apply(CommandRecordingContext* commandContext) {
         BeforeApply();
@@ -411,7 +455,11 @@ class BindGroupStateTracker : public BindGroupTrackerBase<false, uint64_t> {
             }
         }
 
-        if (!didCreateBindGroupViews || !didCreateBindGroupSamplers) {
+        // A maximum-sized heap may first reclaim retired ring regions instead of switching,
+        // in which case existing allocations stay valid but the retry below can fail again if
+        // not enough space retired; the next iteration then switches heaps for real, which
+        // always succeeds with an empty ring.
+        while (!didCreateBindGroupViews || !didCreateBindGroupSamplers) {
             if (!didCreateBindGroupViews) {
                 DAWN_TRY(mViewAllocator->AllocateAndSwitchShaderVisibleHeap());
             }
@@ -426,12 +474,15 @@ class BindGroupStateTracker : public BindGroupTrackerBase<false, uint64_t> {
             // Must be called before applying the bindgroups.
             SetID3D12DescriptorHeaps(commandList);
 
+            didCreateBindGroupViews = true;
+            didCreateBindGroupSamplers = true;
             for (BindGroupIndex index : IterateBitSet(mBindGroupLayoutsMask)) {
                 BindGroup* group = ToBackend(mBindGroups[index]);
-                didCreateBindGroupViews = group->PopulateViews(mViewAllocator);
-                didCreateBindGroupSamplers = group->PopulateSamplers(mDevice, mSamplerAllocator);
-                ASSERT(didCreateBindGroupViews);
-                ASSERT(didCreateBindGroupSamplers);
+                didCreateBindGroupViews =
+                    group->PopulateViews(mViewAllocator) && didCreateBindGroupViews;
+                didCreateBindGroupSamplers =
+                    group->PopulateSamplers(mDevice, mSamplerAllocator) &&
+                    didCreateBindGroupSamplers;
             }
         }
 
@@ -463,17 +514,27 @@ class BindGroupStateTracker : public BindGroupTrackerBase<false, uint64_t> {
 
   private:
     void UpdateRootSignatureIfNecessary(ID3D12GraphicsCommandList* commandList) {
-        if (mLastAppliedPipelineLayout != mPipelineLayout) {
-            if (mInCompute) {
-                commandList->SetComputeRootSignature(
-                    ToBackend(mPipelineLayout)->GetRootSignature());
-            } else {
-                commandList->SetGraphicsRootSignature(
-                    ToBackend(mPipelineLayout)->GetRootSignature());
-            }
-            // Invalidate the root sampler tables previously set in the root signature.
-            mBoundRootSamplerTables = {};
+        ID3D12RootSignature* rootSignature = ToBackend(mPipelineLayout)->GetRootSignature();
+        if (mLastRootSignature == rootSignature) {
+            // Root signatures are deduplicated on the device so distinct pipeline layouts
+            // commonly share one. Root arguments then stay valid across the layout change
+            // and the bind groups BeforeApply() inherited need no rebinding.
+            return;
+        }
+        if (mInCompute) {
+            commandList->SetComputeRootSignature(rootSignature);
+        } else {
+            commandList->SetGraphicsRootSignature(rootSignature);
         }
+        mLastRootSignature = rootSignature;
+
+        // Setting a different root signature invalidates every root argument on this bind
+        // point, so any bind groups BeforeApply() inherited must be rebound after all.
+        mDirtyBindGroups |= mBindGroupLayoutsMask;
+        mDirtyBindGroupsObjectChangedOrIsDynamic |= mBindGroupLayoutsMask;
+
+        // Invalidate the root sampler tables previously set in the root signature.
+        mBoundRootSamplerTables = {};
     }
 
     void ApplyBindGroup(ID3D12GraphicsCommandList* commandList,
@@ -605,6 +666,11 @@ class BindGroupStateTracker : public BindGroupTrackerBase<false, uint64_t> {
 
     bool mInCompute = false;
 
+    // The root signature set on the current bind point of the command list. Tracked as the
+    // D3D12 object rather than through the pipeline layout because deduplicated root
+    // signatures are shared between layouts.
+    ID3D12RootSignature* mLastRootSignature = nullptr;
+
     ityp::array<BindGroupIndex, D3D12_GPU_DESCRIPTOR_HANDLE, kMaxBindGroups>
         mBoundRootSamplerTables = {};
 
@@ -708,6 +774,103 @@ void ResolveMultisampledRenderPass(CommandRecordingContext* commandContext,
     }
 }
 
+// Checks whether the render pass that directly follows |prevPass| in the command stream may be
+// recorded inside the same hardware render pass. This requires the seam between the two passes
+// to be transparent: the same attachments stay bound with their contents carried over, nothing
+// is cleared or resolved in between, and preparing the following pass' sync scope can only
+// record resource barriers (the one part of pass setup that is legal inside a render pass).
+// |nextScope| is the sync scope of the following pass.
+bool CanFoldRenderPassAtSeam(BeginRenderPassCmd* prevPass,
+                             BeginRenderPassCmd* nextPass,
+                             const RenderPassResourceUsage& nextScope,
+                             bool prevPassHasUAV) {
+    if (prevPass->attachmentState.Get() != nextPass->attachmentState.Get()) {
+        return false;
+    }
+
+    for (ColorAttachmentIndex i :
+         IterateBitSet(prevPass->attachmentState->GetColorAttachmentsMask())) {
+        const RenderPassColorAttachmentInfo& prev = prevPass->colorAttachments[i];
+        const RenderPassColorAttachmentInfo& next = nextPass->colorAttachments[i];
+
+        // Resolves happen when the pass ends and cannot be deferred past the seam.
+        if (prev.view.Get() != next.view.Get() || prev.resolveTarget != nullptr ||
+            next.resolveTarget != nullptr) {
+            return false;
+        }
+        // The attachment contents must carry over the seam unchanged. Storing then loading
+        // also guarantees the attachment is initialized, so the following pass' loadOp won't
+        // be promoted to a lazy clear.
+        if (prev.storeOp != wgpu::StoreOp::Store || next.loadOp != wgpu::LoadOp::Load) {
+            return false;
+        }
+    }
+
+    if (prevPass->attachmentState->HasDepthStencilAttachment()) {
+        const RenderPassDepthStencilAttachmentInfo& prev = prevPass->depthStencilAttachment;
+        const RenderPassDepthStencilAttachmentInfo& next = nextPass->depthStencilAttachment;
+
+        if (prev.view.Get() != next.view.Get()) {
+            return false;
+        }
+        // The DSV descriptor depends on the read-only flags.
+        if (prev.depthReadOnly != next.depthReadOnly ||
+            prev.stencilReadOnly != next.stencilReadOnly) {
+            return false;
+        }
+
+        const Format& format = prev.view->GetTexture()->GetFormat();
+        if (format.HasDepth() && (prev.depthStoreOp != wgpu::StoreOp::Store ||
+                                  next.depthLoadOp != wgpu::LoadOp::Load)) {
+            return false;
+        }
+        if (format.HasStencil() && (prev.stencilStoreOp != wgpu::StoreOp::Store ||
+                                    next.stencilLoadOp != wgpu::LoadOp::Load)) {
+            return false;
+        }
+    }
+
+    // Preparing the following pass' sync scope must not record lazy clears or copies for
+    // resource initialization, so every used resource must already be initialized.
+    for (BufferBase* buffer : nextScope.buffers) {
+        if (buffer->NeedsInitialization()) {
+            return false;
+        }
+    }
+
+    bool nextPassHasUAV = false;
+    for (wgpu::BufferUsage usage : nextScope.bufferUsages) {
+        if (usage & wgpu::BufferUsage::Storage) {
+            nextPassHasUAV = true;
+        }
+    }
+
+    bool texturesAreInitialized = true;
+    for (size_t i = 0; i < nextScope.textures.size(); ++i) {
+        TextureBase* texture = nextScope.textures[i];
+        nextScope.textureUsages[i].Iterate(
+            [&](const SubresourceRange& range, wgpu::TextureUsage usage) {
+                if ((usage & ~wgpu::TextureUsage::RenderAttachment) &&
+                    !texture->IsSubresourceContentInitialized(range)) {
+                    texturesAreInitialized = false;
+                }
+                if (usage & wgpu::TextureUsage::StorageBinding) {
+                    nextPassHasUAV = true;
+                }
+            });
+    }
+    if (!texturesAreInitialized) {
+        return false;
+    }
+
+    // D3D12_RENDER_PASS_FLAG_ALLOW_UAV_WRITES was fixed when the hardware pass began.
+    if (nextPassHasUAV && !prevPassHasUAV) {
+        return false;
+    }
+
+    return true;
+}
+
 }  // anonymous namespace
 
 // static
@@ -732,8 +895,36 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* commandContext
     size_t nextComputePassNumber = 0;
     size_t nextRenderPassNumber = 0;
 
+    // Closes and submits the commands recorded so far, then reopens the pending context with a
+    // fresh command list. Splitting at pass boundaries lets the GPU start executing earlier
+    // passes while the CPU is still translating later ones, instead of idling until the whole
+    // command buffer is translated. Shared textures must transition to the common state only
+    // after the last usage in a submit, so splitting is skipped while any are tracked.
+    auto submitOnPassBoundary = [&]() -> MaybeError {
+        if (!device->IsToggleEnabled(Toggle::D3D12SubmitCommandListOnPassBoundary) ||
+            commandContext->HasSharedTextures()) {
+            return {};
+        }
+        DAWN_TRY(commandContext->ExecuteCommandList(device));
+        // Advance the serial so the work just submitted can actually complete (and its command
+        // allocator, descriptors and heaps recycle) while translation continues.
+        DAWN_TRY(device->NextSerial());
+        CommandRecordingContext* newContext;
+        DAWN_TRY_ASSIGN(newContext, device->GetPendingCommandContext());
+        // The pending context (and its underlying command list object) are reused, only the
+        // recording state was reset.
+        ASSERT(newContext == commandContext);
+        ASSERT(commandContext->GetCommandList() == commandList);
+        bindingTracker.OnNewCommandList(commandList);
+        return {};
+    };
+
     Command type;
-    while (mCommands.NextCommandId(&type)) {
+    bool hasCommand = mCommands.NextCommandId(&type);
+    while (hasCommand) {
+        // Set by cases that consume commands past the end of their own, in which case |type|
+        // already holds the next command to process.
+        bool fetchedNextCommand = false;
         switch (type) {
             case Command::BeginComputePass: {
                 BeginComputePassCmd* cmd = mCommands.NextCommand<BeginComputePassCmd>();
@@ -745,6 +936,7 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* commandContext
                                       GetResourceUsages().computePasses[nextComputePassNumber]));
 
                 nextComputePassNumber++;
+                DAWN_TRY(submitOnPassBoundary());
                 break;
             }
 
@@ -752,15 +944,22 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* commandContext
                 BeginRenderPassCmd* beginRenderPassCmd =
                     mCommands.NextCommand<BeginRenderPassCmd>();
 
-                const bool passHasUAV = TransitionAndClearForSyncScope(
-                    commandContext, GetResourceUsages().renderPasses[nextRenderPassNumber]);
                 bindingTracker.SetInComputePass(false);
 
-                LazyClearRenderPassAttachments(beginRenderPassCmd);
-                DAWN_TRY(RecordRenderPass(commandContext, &bindingTracker, beginRenderPassCmd,
-                                          passHasUAV));
+                // RecordRenderPass folds compatible directly-following render passes into the
+                // same hardware render pass. To decide this it peeks past the end of each pass,
+                // so it hands back either the BeginRenderPassCmd it consumed but did not fold,
+                // or the identifier of the first command it did not consume.
+                while (beginRenderPassCmd != nullptr) {
+                    BeginRenderPassCmd* followingRenderPass = nullptr;
+                    DAWN_TRY(RecordRenderPass(commandContext, &bindingTracker, beginRenderPassCmd,
+                                              &nextRenderPassNumber, &followingRenderPass, &type,
+                                              &hasCommand));
+                    DAWN_TRY(submitOnPassBoundary());
+                    beginRenderPassCmd = followingRenderPass;
+                }
 
-                nextRenderPassNumber++;
+                fetchedNextCommand = true;
                 break;
             }
 
@@ -1115,6 +1314,10 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* commandContext
             default:
                 UNREACHABLE();
         }
+
+        if (!fetchedNextCommand) {
+            hasCommand = mCommands.NextCommandId(&type);
+        }
     }
 
     return {};
@@ -1200,7 +1403,7 @@ MaybeError CommandBuffer::RecordComputePass(CommandRecordingContext* commandCont
                 uint32_t* dynamicOffsets = nullptr;
 
                 if (cmd->dynamicOffsetCount > 0) {
-                    dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    dynamicOffsets = mCommands.NextTrailingData<uint32_t>(cmd->dynamicOffsetCount);
                 }
 
                 bindingTracker->OnSetBindGroup(cmd->index, group, cmd->dynamicOffsetCount,
@@ -1424,10 +1627,21 @@ void CommandBuffer::EmulateBeginRenderPass(CommandRecordingContext* commandConte
 MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* commandContext,
                                            BindGroupStateTracker* bindingTracker,
                                            BeginRenderPassCmd* renderPass,
-                                           const bool passHasUAV) {
+                                           size_t* nextRenderPassNumber,
+                                           BeginRenderPassCmd** nextRenderPass,
+                                           Command* nextType,
+                                           bool* hasNextCommand) {
     Device* device = ToBackend(GetDevice());
     const bool useRenderPass = device->IsToggleEnabled(Toggle::UseD3D12RenderPass);
 
+    const bool passHasUAV = TransitionAndClearForSyncScope(
+        commandContext, GetResourceUsages().renderPasses[*nextRenderPassNumber]);
+    (*nextRenderPassNumber)++;
+    LazyClearRenderPassAttachments(renderPass);
+
+    *nextRenderPass = nullptr;
+    *hasNextCommand = false;
+
     // renderPassBuilder must be scoped to RecordRenderPass because any underlying
     // D3D12_RENDER_PASS_ENDING_ACCESS_RESOLVE_SUBRESOURCE_PARAMETERS structs must remain
     // valid until after EndRenderPass() has been called.
@@ -1451,31 +1665,53 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* commandConte
 
     ID3D12GraphicsCommandList* commandList = commandContext->GetCommandList();
 
-    // Write timestamp at the beginning of render pass if it's set.
-    if (renderPass->beginTimestamp.querySet.Get() != nullptr) {
-        RecordWriteTimestampCmd(commandList, renderPass->beginTimestamp.querySet.Get(),
-                                renderPass->beginTimestamp.queryIndex);
-    }
-
-    // Set up default dynamic state
-    {
-        uint32_t width = renderPass->width;
-        uint32_t height = renderPass->height;
-        D3D12_VIEWPORT viewport = {0.f, 0.f, static_cast<float>(width), static_cast<float>(height),
-                                   0.f, 1.f};
-        D3D12_RECT scissorRect = {0, 0, static_cast<int32_t>(width), static_cast<int32_t>(height)};
-        commandList->RSSetViewports(1, &viewport);
-        commandList->RSSetScissorRects(1, &scissorRect);
-
-        static constexpr std::array<float, 4> defaultBlendFactor = {0, 0, 0, 0};
-        commandList->OMSetBlendFactor(&defaultBlendFactor[0]);
-
-        commandList->OMSetStencilRef(0);
-    }
-
     RenderPipeline* lastPipeline = nullptr;
     VertexBufferTracker vertexBufferTracker = {};
 
+    // Records the state every frontend pass starts from. Called again whenever a following
+    // pass is folded into this hardware render pass.
+    auto beginFrontendPass = [&]() {
+        // Write timestamp at the beginning of render pass if it's set.
+        if (renderPass->beginTimestamp.querySet.Get() != nullptr) {
+            RecordWriteTimestampCmd(commandList, renderPass->beginTimestamp.querySet.Get(),
+                                    renderPass->beginTimestamp.queryIndex);
+        }
+
+        // Set up default dynamic state
+        {
+            uint32_t width = renderPass->width;
+            uint32_t height = renderPass->height;
+            D3D12_VIEWPORT viewport = {0.f,
+                                       0.f,
+                                       static_cast<float>(width),
+                                       static_cast<float>(height),
+                                       0.f,
+                                       1.f};
+            D3D12_RECT scissorRect = {0, 0, static_cast<int32_t>(width),
+                                      static_cast<int32_t>(height)};
+            commandList->RSSetViewports(1, &viewport);
+            commandList->RSSetScissorRects(1, &scissorRect);
+
+            static constexpr std::array<float, 4> defaultBlendFactor = {0, 0, 0, 0};
+            commandList->OMSetBlendFactor(&defaultBlendFactor[0]);
+
+            commandList->OMSetStencilRef(0);
+        }
+
+        lastPipeline = nullptr;
+        vertexBufferTracker = {};
+    };
+    beginFrontendPass();
+
+    // Ends the hardware render pass, resolving multisampled attachments when emulating.
+    auto endHardwarePass = [&]() {
+        if (useRenderPass) {
+            commandContext->GetCommandList4()->EndRenderPass();
+        } else if (renderPass->attachmentState->GetSampleCount() > 1) {
+            ResolveMultisampledRenderPass(commandContext, renderPass);
+        }
+    };
+
     auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) -> MaybeError {
         switch (type) {
             case Command::Draw: {
@@ -1533,6 +1769,48 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* commandConte
                 break;
             }
 
+            case Command::MultiDrawIndirect: {
+                MultiDrawIndirectCmd* draw = iter->NextCommand<MultiDrawIndirectCmd>();
+
+                DAWN_TRY(bindingTracker->Apply(commandContext));
+                vertexBufferTracker.Apply(commandList, lastPipeline);
+
+                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+                Buffer* countBuffer = ToBackend(draw->drawCountBuffer.Get());
+
+                // Multi-draws always consume tightly packed application-provided draw
+                // arguments, so use the plain device signature rather than the pipeline's,
+                // which may expect data patched by the indirect draw validation pass.
+                ComPtr<ID3D12CommandSignature> signature =
+                    device->GetDrawIndirectSignature();
+                commandList->ExecuteIndirect(
+                    signature.Get(), draw->maxDrawCount, buffer->GetD3D12Resource(),
+                    draw->indirectOffset,
+                    countBuffer != nullptr ? countBuffer->GetD3D12Resource() : nullptr,
+                    countBuffer != nullptr ? draw->drawCountBufferOffset : 0);
+                break;
+            }
+
+            case Command::MultiDrawIndexedIndirect: {
+                MultiDrawIndexedIndirectCmd* draw =
+                    iter->NextCommand<MultiDrawIndexedIndirectCmd>();
+
+                DAWN_TRY(bindingTracker->Apply(commandContext));
+                vertexBufferTracker.Apply(commandList, lastPipeline);
+
+                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+                Buffer* countBuffer = ToBackend(draw->drawCountBuffer.Get());
+
+                ComPtr<ID3D12CommandSignature> signature =
+                    device->GetDrawIndexedIndirectSignature();
+                commandList->ExecuteIndirect(
+                    signature.Get(), draw->maxDrawCount, buffer->GetD3D12Resource(),
+                    draw->indirectOffset,
+                    countBuffer != nullptr ? countBuffer->GetD3D12Resource() : nullptr,
+                    countBuffer != nullptr ? draw->drawCountBufferOffset : 0);
+                break;
+            }
+
             case Command::InsertDebugMarker: {
                 InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
                 const char* label = iter->NextData<char>(cmd->length + 1);
@@ -1589,7 +1867,7 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* commandConte
                 uint32_t* dynamicOffsets = nullptr;
 
                 if (cmd->dynamicOffsetCount > 0) {
-                    dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    dynamicOffsets = iter->NextTrailingData<uint32_t>(cmd->dynamicOffsetCount);
                 }
 
                 bindingTracker->OnSetBindGroup(cmd->index, group, cmd->dynamicOffsetCount,
@@ -1636,12 +1914,40 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* commandConte
                                             renderPass->endTimestamp.queryIndex);
                 }
 
-                if (useRenderPass) {
-                    commandContext->GetCommandList4()->EndRenderPass();
-                } else if (renderPass->attachmentState->GetSampleCount() > 1) {
-                    ResolveMultisampledRenderPass(commandContext, renderPass);
+                // Peek past the end of the pass: back-to-back passes over the same attachments
+                // are common (e.g. UI compositing) and a transparent seam lets the following
+                // pass share this hardware render pass instead of breaking it only to re-bind
+                // the same attachments.
+                if (!mCommands.NextCommandId(nextType)) {
+                    endHardwarePass();
+                    return {};
                 }
-                return {};
+                if (*nextType != Command::BeginRenderPass) {
+                    endHardwarePass();
+                    *hasNextCommand = true;
+                    return {};
+                }
+
+                BeginRenderPassCmd* followingPass = mCommands.NextCommand<BeginRenderPassCmd>();
+                const RenderPassResourceUsage& followingScope =
+                    GetResourceUsages().renderPasses[*nextRenderPassNumber];
+                if (!CanFoldRenderPassAtSeam(renderPass, followingPass, followingScope,
+                                             passHasUAV)) {
+                    endHardwarePass();
+                    *nextRenderPass = followingPass;
+                    return {};
+                }
+
+                // CanFoldRenderPassAtSeam() checked that nothing needs lazy initialization,
+                // so this records only resource barriers, which are legal inside a render
+                // pass.
+                TransitionAndClearForSyncScope(commandContext, followingScope);
+                (*nextRenderPassNumber)++;
+                LazyClearRenderPassAttachments(followingPass);
+
+                renderPass = followingPass;
+                beginFrontendPass();
+                break;
             }
 
             case Command::SetStencilReference: {
@@ -1704,7 +2010,7 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* commandConte
                 ASSERT(D3D12QueryType(querySet->GetQueryType()) ==
                        D3D12_QUERY_TYPE_BINARY_OCCLUSION);
                 commandList->BeginQuery(querySet->GetQueryHeap(), D3D12_QUERY_TYPE_BINARY_OCCLUSION,
-                                        cmd->queryIndex);
+                                        querySet->GetQueryHeapOffset() + cmd->queryIndex);
                 break;
             }
 
@@ -1714,7 +2020,7 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* commandConte
                 ASSERT(D3D12QueryType(querySet->GetQueryType()) ==
                        D3D12_QUERY_TYPE_BINARY_OCCLUSION);
                 commandList->EndQuery(querySet->GetQueryHeap(), D3D12_QUERY_TYPE_BINARY_OCCLUSION,
-                                      cmd->queryIndex);
+                                      querySet->GetQueryHeapOffset() + cmd->queryIndex);
                 break;
             }
 
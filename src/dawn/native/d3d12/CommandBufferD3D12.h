@@ -19,6 +19,7 @@
 #include "dawn/native/Error.h"
 
 namespace dawn::native {
+enum class Command;
 struct BeginComputePassCmd;
 struct BeginRenderPassCmd;
 }  // namespace dawn::native
@@ -43,10 +44,17 @@ class CommandBuffer final : public CommandBufferBase {
                                  BindGroupStateTracker* bindingTracker,
                                  BeginComputePassCmd* computePass,
                                  const ComputePassResourceUsage& resourceUsages);
+    // Records one hardware render pass, starting with |renderPass| and folding in any
+    // directly-following compatible render passes. Deciding whether to fold requires peeking
+    // past the end of each pass, so on return either |*nextRenderPass| holds a consumed but
+    // unrecorded pass, or |*hasNextCommand|/|*nextType| describe the first unconsumed command.
     MaybeError RecordRenderPass(CommandRecordingContext* commandContext,
                                 BindGroupStateTracker* bindingTracker,
                                 BeginRenderPassCmd* renderPass,
-                                bool passHasUAV);
+                                size_t* nextRenderPassNumber,
+                                BeginRenderPassCmd** nextRenderPass,
+                                Command* nextType,
+                                bool* hasNextCommand);
     MaybeError SetupRenderPass(CommandRecordingContext* commandContext,
                                BeginRenderPassCmd* renderPass,
                                RenderPassBuilder* renderPassBuilder);
@@ -35,6 +35,10 @@ void CommandRecordingContext::AddToSharedTextureList(Texture* texture) {
     mSharedTextures.insert(texture);
 }
 
+bool CommandRecordingContext::HasSharedTextures() const {
+    return !mSharedTextures.empty();
+}
+
 MaybeError CommandRecordingContext::Open(ID3D12Device* d3d12Device,
                                          CommandAllocatorManager* commandAllocationManager) {
     ASSERT(!IsOpen());
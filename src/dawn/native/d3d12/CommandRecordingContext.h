@@ -33,6 +33,7 @@ class Texture;
 class CommandRecordingContext {
   public:
     void AddToSharedTextureList(Texture* texture);
+    bool HasSharedTextures() const;
     MaybeError Open(ID3D12Device* d3d12Device, CommandAllocatorManager* commandAllocationManager);
 
     ID3D12GraphicsCommandList* GetCommandList() const;
@@ -58,11 +58,15 @@ void Flush11On12DeviceToAvoidLeaks(ComPtr<ID3D11On12Device> d3d11on12Device) {
 }
 
 D3D11on12ResourceCacheEntry::D3D11on12ResourceCacheEntry(ComPtr<IDXGIKeyedMutex> dxgiKeyedMutex,
-                                                         ComPtr<ID3D11On12Device> d3d11On12Device)
-    : mDXGIKeyedMutex(std::move(dxgiKeyedMutex)), mD3D11on12Device(std::move(d3d11On12Device)) {}
+                                                         ComPtr<ID3D11On12Device> d3d11On12Device,
+                                                         ComPtr<ID3D12Resource> d3d12Resource)
+    : mDXGIKeyedMutex(std::move(dxgiKeyedMutex)),
+      mD3D11on12Device(std::move(d3d11On12Device)),
+      mD3D12Resource(std::move(d3d12Resource)) {}
 
-D3D11on12ResourceCacheEntry::D3D11on12ResourceCacheEntry(ComPtr<ID3D11On12Device> d3d11On12Device)
-    : mD3D11on12Device(std::move(d3d11On12Device)) {}
+D3D11on12ResourceCacheEntry::D3D11on12ResourceCacheEntry(ComPtr<ID3D11On12Device> d3d11On12Device,
+                                                         ComPtr<ID3D12Resource> d3d12Resource)
+    : mD3D11on12Device(std::move(d3d11On12Device)), mD3D12Resource(std::move(d3d12Resource)) {}
 
 D3D11on12ResourceCacheEntry::~D3D11on12ResourceCacheEntry() {
     if (mDXGIKeyedMutex == nullptr) {
@@ -114,13 +118,14 @@ size_t D3D11on12ResourceCacheEntry::HashFunc::operator()(
     const Ref<D3D11on12ResourceCacheEntry> a) const {
     size_t hash = 0;
     HashCombine(&hash, a->mD3D11on12Device.Get());
+    HashCombine(&hash, a->mD3D12Resource.Get());
     return hash;
 }
 
 bool D3D11on12ResourceCacheEntry::EqualityFunc::operator()(
     const Ref<D3D11on12ResourceCacheEntry> a,
     const Ref<D3D11on12ResourceCacheEntry> b) const {
-    return a->mD3D11on12Device == b->mD3D11on12Device;
+    return a->mD3D11on12Device == b->mD3D11on12Device && a->mD3D12Resource == b->mD3D12Resource;
 }
 
 D3D11on12ResourceCache::D3D11on12ResourceCache() = default;
@@ -130,17 +135,17 @@ D3D11on12ResourceCache::~D3D11on12ResourceCache() = default;
 Ref<D3D11on12ResourceCacheEntry> D3D11on12ResourceCache::GetOrCreateD3D11on12Resource(
     Device* backendDevice,
     ID3D12Resource* d3d12Resource) {
-    // The Dawn and 11on12 device share the same D3D12 command queue whereas this external image
+    // The Dawn and 11on12 device share the same D3D12 command queue whereas this resource
     // could be accessed/produced with multiple Dawn devices. To avoid cross-queue sharing
     // restrictions, the 11 wrapped resource is forbidden to be shared between Dawn devices by
-    // using the 11on12 device as the cache key.
+    // keeping the 11on12 device in the cache key alongside the resource.
     ComPtr<ID3D11On12Device> d3d11on12Device = backendDevice->GetOrCreateD3D11on12Device();
     if (d3d11on12Device == nullptr) {
         dawn::ErrorLog() << "Unable to create 11on12 device for external image";
         return nullptr;
     }
 
-    D3D11on12ResourceCacheEntry blueprint(d3d11on12Device);
+    D3D11on12ResourceCacheEntry blueprint(d3d11on12Device, d3d12Resource);
     auto iter = mCache.find(&blueprint);
     if (iter != mCache.end()) {
         return *iter;
@@ -167,14 +172,16 @@ Ref<D3D11on12ResourceCacheEntry> D3D11on12ResourceCache::GetOrCreateD3D11on12Res
         return nullptr;
     }
 
-    // Keep this cache from growing unbounded.
+    // Keep this cache from growing unbounded by evicting an arbitrary entry instead of
+    // clearing the whole cache, which would also throw away the entries that are re-imported
+    // every frame.
     // TODO(dawn:625): Consider using a replacement policy based cache.
     if (mCache.size() > kMaxD3D11on12ResourceCacheSize) {
-        mCache.clear();
+        mCache.erase(mCache.begin());
     }
 
-    Ref<D3D11on12ResourceCacheEntry> entry =
-        AcquireRef(new D3D11on12ResourceCacheEntry(dxgiKeyedMutex, std::move(d3d11on12Device)));
+    Ref<D3D11on12ResourceCacheEntry> entry = AcquireRef(new D3D11on12ResourceCacheEntry(
+        dxgiKeyedMutex, std::move(d3d11on12Device), d3d12Resource));
     mCache.insert(entry);
 
     return entry;
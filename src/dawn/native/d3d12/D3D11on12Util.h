@@ -33,9 +33,11 @@ class Device;
 // Wraps 11 wrapped resources in a cache.
 class D3D11on12ResourceCacheEntry : public RefCounted {
   public:
-    explicit D3D11on12ResourceCacheEntry(ComPtr<ID3D11On12Device> d3d11on12Device);
+    D3D11on12ResourceCacheEntry(ComPtr<ID3D11On12Device> d3d11on12Device,
+                                ComPtr<ID3D12Resource> d3d12Resource);
     D3D11on12ResourceCacheEntry(ComPtr<IDXGIKeyedMutex> d3d11on12Resource,
-                                ComPtr<ID3D11On12Device> d3d11on12Device);
+                                ComPtr<ID3D11On12Device> d3d11on12Device,
+                                ComPtr<ID3D12Resource> d3d12Resource);
     ~D3D11on12ResourceCacheEntry() override;
 
     MaybeError AcquireKeyedMutex();
@@ -55,17 +57,22 @@ class D3D11on12ResourceCacheEntry : public RefCounted {
   private:
     ComPtr<IDXGIKeyedMutex> mDXGIKeyedMutex;
     ComPtr<ID3D11On12Device> mD3D11on12Device;
+    // The D3D12 resource the entry wraps, kept as part of the cache key so the same wrapped
+    // resource and keyed mutex are reused every time the same resource is imported.
+    ComPtr<ID3D12Resource> mD3D12Resource;
     int64_t mAcquireCount = 0;
 };
 
-// |D3D11on12ResourceCache| maintains a cache of 11 wrapped resources.
-// Each entry represents a 11 resource that is exclusively accessed by Dawn device.
-// Since each Dawn device creates and stores a 11on12 device, the 11on12 device
-// is used as the key for the cache entry which ensures only the same 11 wrapped
-// resource is re-used and also fully released.
+// |D3D11on12ResourceCache| maintains a cache of 11 wrapped resources, keyed by the identity of
+// the wrapped D3D12 resource together with the 11on12 device. Since each Dawn device creates
+// and stores a 11on12 device, keying on the 11on12 device ensures a 11 wrapped resource is
+// never shared between Dawn devices; keying on the resource lets the same decoder surface hit
+// the cache no matter how many ExternalImageDXGIImpl instances it is imported through.
 //
-// The cache is primarily needed to avoid repeatedly calling CreateWrappedResource
-// and special release code per ProduceTexture(device).
+// The cache lives on the Dawn device (see Device::GetD3D11on12ResourceCache) and is primarily
+// needed to avoid repeatedly calling CreateWrappedResource and special release code per
+// ProduceTexture. The keyed-mutex state persists with the entry, so repeated imports keep the
+// batched acquire/release around whole submits instead of re-establishing mutex state.
 class D3D11on12ResourceCache {
   public:
     D3D11on12ResourceCache();
@@ -75,8 +82,9 @@ class D3D11on12ResourceCache {
                                                                   ID3D12Resource* d3d12Resource);
 
   private:
+    // Large enough to cover the surface pools used by media decoders.
     // TODO(dawn:625): Figure out a large enough cache size.
-    static constexpr uint64_t kMaxD3D11on12ResourceCacheSize = 5;
+    static constexpr uint64_t kMaxD3D11on12ResourceCacheSize = 32;
 
     // 11on12 resource cache entries are refcounted to ensure if the ExternalImage outlives the
     // Dawn texture (or vice-versa), we always fully release the 11 wrapped resource without
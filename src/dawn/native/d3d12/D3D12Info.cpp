@@ -14,6 +14,8 @@
 
 #include "dawn/native/d3d12/D3D12Info.h"
 
+#include <cstring>
+#include <type_traits>
 #include <utility>
 
 #include "dawn/common/GPUInfo.h"
@@ -24,6 +26,24 @@
 
 namespace dawn::native::d3d12 {
 
+namespace {
+
+PerStage<std::wstring> BuildShaderProfiles(uint32_t shaderModel) {
+    // Profiles are always <stage>s_<major>_<minor> so we build the s_<major>_<minor> and add
+    // it to each of the stage's suffix.
+    std::wstring profileSuffix = L"s_M_n";
+    profileSuffix[2] = wchar_t('0' + shaderModel / 10);
+    profileSuffix[4] = wchar_t('0' + shaderModel % 10);
+
+    PerStage<std::wstring> profiles;
+    profiles[SingleShaderStage::Vertex] = L"v" + profileSuffix;
+    profiles[SingleShaderStage::Fragment] = L"p" + profileSuffix;
+    profiles[SingleShaderStage::Compute] = L"c" + profileSuffix;
+    return profiles;
+}
+
+}  // anonymous namespace
+
 ResultOrError<D3D12DeviceInfo> GatherDeviceInfo(const Adapter& adapter) {
     D3D12DeviceInfo info = {};
 
@@ -110,16 +130,7 @@ ResultOrError<D3D12DeviceInfo> GatherDeviceInfo(const Adapter& adapter) {
     ASSERT(shaderModelMajor < 10);
     ASSERT(shaderModelMinor < 10);
     info.shaderModel = 10 * shaderModelMajor + shaderModelMinor;
-
-    // Profiles are always <stage>s_<minor>_<major> so we build the s_<minor>_major and add
-    // it to each of the stage's suffix.
-    std::wstring profileSuffix = L"s_M_n";
-    profileSuffix[2] = wchar_t('0' + shaderModelMajor);
-    profileSuffix[4] = wchar_t('0' + shaderModelMinor);
-
-    info.shaderProfiles[SingleShaderStage::Vertex] = L"v" + profileSuffix;
-    info.shaderProfiles[SingleShaderStage::Fragment] = L"p" + profileSuffix;
-    info.shaderProfiles[SingleShaderStage::Compute] = L"c" + profileSuffix;
+    info.shaderProfiles = BuildShaderProfiles(info.shaderModel);
 
     info.supportsShaderFloat16 =
         driverShaderModel >= D3D_SHADER_MODEL_6_2 && featureOptions4.Native16BitShaderOpsSupported;
@@ -129,4 +140,38 @@ ResultOrError<D3D12DeviceInfo> GatherDeviceInfo(const Adapter& adapter) {
     return std::move(info);
 }
 
+D3D12DeviceInfoSnapshot SnapshotFromDeviceInfo(const D3D12DeviceInfo& info) {
+    static_assert(std::is_trivially_copyable_v<D3D12DeviceInfoSnapshot>);
+
+    // Zero the padding bytes too: the snapshot is stored byte for byte in the blob cache.
+    D3D12DeviceInfoSnapshot snapshot;
+    std::memset(&snapshot, 0, sizeof(snapshot));
+
+    snapshot.isUMA = info.isUMA;
+    snapshot.resourceHeapTier = info.resourceHeapTier;
+    snapshot.supportsRenderPass = info.supportsRenderPass;
+    snapshot.supportsShaderFloat16 = info.supportsShaderFloat16;
+    snapshot.shaderModel = info.shaderModel;
+    snapshot.supportsSharedResourceCapabilityTier1 = info.supportsSharedResourceCapabilityTier1;
+    snapshot.supportsDP4a = info.supportsDP4a;
+    snapshot.supportsCastingFullyTypedFormat = info.supportsCastingFullyTypedFormat;
+    snapshot.programmableSamplePositionsTier = info.programmableSamplePositionsTier;
+    return snapshot;
+}
+
+D3D12DeviceInfo DeviceInfoFromSnapshot(const D3D12DeviceInfoSnapshot& snapshot) {
+    D3D12DeviceInfo info = {};
+    info.isUMA = snapshot.isUMA;
+    info.resourceHeapTier = snapshot.resourceHeapTier;
+    info.supportsRenderPass = snapshot.supportsRenderPass;
+    info.supportsShaderFloat16 = snapshot.supportsShaderFloat16;
+    info.shaderModel = snapshot.shaderModel;
+    info.shaderProfiles = BuildShaderProfiles(snapshot.shaderModel);
+    info.supportsSharedResourceCapabilityTier1 = snapshot.supportsSharedResourceCapabilityTier1;
+    info.supportsDP4a = snapshot.supportsDP4a;
+    info.supportsCastingFullyTypedFormat = snapshot.supportsCastingFullyTypedFormat;
+    info.programmableSamplePositionsTier = snapshot.programmableSamplePositionsTier;
+    return info;
+}
+
 }  // namespace dawn::native::d3d12
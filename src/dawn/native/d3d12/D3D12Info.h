@@ -38,7 +38,27 @@ struct D3D12DeviceInfo {
     uint32_t programmableSamplePositionsTier;
 };
 
+// The trivially copyable subset of D3D12DeviceInfo that is persisted in the blob cache so
+// later startups can skip the CheckFeatureSupport queries; shaderProfiles is rebuilt from
+// shaderModel on load. Bump kVersion whenever the layout or the meaning of a field changes.
+struct D3D12DeviceInfoSnapshot {
+    static constexpr uint32_t kVersion = 1;
+
+    bool isUMA;
+    uint32_t resourceHeapTier;
+    bool supportsRenderPass;
+    bool supportsShaderFloat16;
+    uint32_t shaderModel;
+    bool supportsSharedResourceCapabilityTier1;
+    bool supportsDP4a;
+    bool supportsCastingFullyTypedFormat;
+    uint32_t programmableSamplePositionsTier;
+};
+
 ResultOrError<D3D12DeviceInfo> GatherDeviceInfo(const Adapter& adapter);
+
+D3D12DeviceInfoSnapshot SnapshotFromDeviceInfo(const D3D12DeviceInfo& info);
+D3D12DeviceInfo DeviceInfoFromSnapshot(const D3D12DeviceInfoSnapshot& snapshot);
 }  // namespace dawn::native::d3d12
 
 #endif  // SRC_DAWN_NATIVE_D3D12_D3D12INFO_H_
@@ -35,6 +35,7 @@
 #include "dawn/native/d3d12/ExternalImageDXGIImpl.h"
 #include "dawn/native/d3d12/PipelineLayoutD3D12.h"
 #include "dawn/native/d3d12/PlatformFunctions.h"
+#include "dawn/native/d3d12/QueryHeapAllocatorD3D12.h"
 #include "dawn/native/d3d12/QuerySetD3D12.h"
 #include "dawn/native/d3d12/QueueD3D12.h"
 #include "dawn/native/d3d12/RenderPipelineD3D12.h"
@@ -47,6 +48,7 @@
 #include "dawn/native/d3d12/StagingBufferD3D12.h"
 #include "dawn/native/d3d12/StagingDescriptorAllocatorD3D12.h"
 #include "dawn/native/d3d12/SwapChainD3D12.h"
+#include "dawn/native/d3d12/TransientAttachmentAllocatorD3D12.h"
 #include "dawn/native/d3d12/UtilsD3D12.h"
 #include "dawn/platform/DawnPlatform.h"
 #include "dawn/platform/tracing/TraceEvent.h"
@@ -132,6 +134,8 @@ MaybeError Device::Initialize(const DeviceDescriptor* descriptor) {
 
     mSamplerHeapCache = std::make_unique<SamplerHeapCache>(this);
 
+    mQueryHeapAllocator = std::make_unique<QueryHeapAllocator>(this);
+
     Adapter* adapter = ToBackend(GetAdapter());
 
     gpgmm::d3d12::ALLOCATOR_DESC allocatorDesc = {};
@@ -170,6 +174,8 @@ MaybeError Device::Initialize(const DeviceDescriptor* descriptor) {
                               allocatorDesc, mResidencyManager.Get(), &mResourceAllocator),
                           "D3D12 create resource allocator"));
 
+    mTransientAttachmentAllocator = std::make_unique<TransientAttachmentAllocator>(this);
+
     // ShaderVisibleDescriptorAllocators use the ResidencyManager and must be initialized after.
     DAWN_TRY_ASSIGN(
         mSamplerShaderVisibleDescriptorAllocator,
@@ -289,6 +295,39 @@ gpgmm::d3d12::ResidencyManager* Device::GetResidencyManager() const {
     return mResidencyManager.Get();
 }
 
+TransientAttachmentAllocator* Device::GetTransientAttachmentAllocator() const {
+    return mTransientAttachmentAllocator.get();
+}
+
+void Device::ReduceMemoryUsageImpl() {
+    // Releases heaps the resource allocator pooled for reuse but that hold no live allocation.
+    mResourceAllocator->Trim();
+    mTransientAttachmentAllocator->Trim();
+    mQueryHeapAllocator->DestroyPool();
+}
+
+void Device::AppendMemoryReportImpl(std::vector<AllocatorMemoryInfo>* report) const {
+    gpgmm::d3d12::RESOURCE_ALLOCATOR_INFO allocatorInfo = mResourceAllocator->GetInfo();
+
+    AllocatorMemoryInfo resourceHeaps;
+    resourceHeaps.name = "resource heaps";
+    resourceHeaps.reservedMemory = allocatorInfo.UsedMemoryUsage + allocatorInfo.FreeMemoryUsage;
+    resourceHeaps.usedMemory = allocatorInfo.UsedBlockUsage;
+    resourceHeaps.peakUsedMemory = mPeakUsedBlockUsage;
+    report->push_back(resourceHeaps);
+
+    // Only the active heap of each shader-visible allocator is counted; retired heaps pooled
+    // for reuse are not.
+    AllocatorMemoryInfo descriptorHeaps;
+    descriptorHeaps.name = "shader-visible descriptor heaps";
+    descriptorHeaps.reservedMemory = mViewShaderVisibleDescriptorAllocator->GetHeapSizeInBytes() +
+                                     mSamplerShaderVisibleDescriptorAllocator->GetHeapSizeInBytes();
+    descriptorHeaps.usedMemory =
+        mViewShaderVisibleDescriptorAllocator->GetHeapUsedSizeInBytes() +
+        mSamplerShaderVisibleDescriptorAllocator->GetHeapUsedSizeInBytes();
+    report->push_back(descriptorHeaps);
+}
+
 ResultOrError<CommandRecordingContext*> Device::GetPendingCommandContext() {
     // Callers of GetPendingCommandList do so to record commands. Only reserve a command
     // allocator when it is needed so we don't submit empty command lists
@@ -358,21 +397,51 @@ MaybeError Device::TickImpl() {
     mSamplerShaderVisibleDescriptorAllocator->Tick(completedSerial);
     mRenderTargetViewAllocator->Tick(completedSerial);
     mDepthStencilViewAllocator->Tick(completedSerial);
+    mQueryHeapAllocator->Tick(completedSerial);
     mUsedComObjectRefs.ClearUpTo(completedSerial);
 
     if (mPendingCommands.IsOpen()) {
         DAWN_TRY(ExecutePendingCommandContext());
         DAWN_TRY(NextSerial());
     }
+    // Issue one signal covering every serial submitted since the last tick.
+    DAWN_TRY(SignalFence());
 
     DAWN_TRY(CheckDebugLayerAndGenerateErrors());
 
+    if (HasMemoryBudgetCallback()) {
+        // Poll the OS-provided budget so the embedder keeps hearing about budget changes (for
+        // example when another application starts competing for video memory) even while this
+        // device only ticks.
+        DXGI_QUERY_VIDEO_MEMORY_INFO videoMemoryInfo;
+        if (SUCCEEDED(ToBackend(GetAdapter())
+                          ->GetHardwareAdapter()
+                          ->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL,
+                                                 &videoMemoryInfo))) {
+            NotifyMemoryBudgetChanged(videoMemoryInfo.CurrentUsage, videoMemoryInfo.Budget);
+        }
+    }
+
     return {};
 }
 
 MaybeError Device::NextSerial() {
     IncrementLastSubmittedCommandSerial();
 
+    // The ID3D12CommandQueue::Signal is deferred: each signal is a syscall and inserts a flush
+    // point on the queue, so back-to-back submits share a single trailing signal issued on the
+    // next tick (or by SignalFence before an explicit wait). The fence value is monotonic so
+    // skipping intermediate values just makes serials complete in batches.
+    mFenceSignalPending = true;
+    return {};
+}
+
+MaybeError Device::SignalFence() {
+    if (!mFenceSignalPending) {
+        return {};
+    }
+    mFenceSignalPending = false;
+
     TRACE_EVENT1(GetPlatform(), General, "D3D12Device::SignalFence", "serial",
                  uint64_t(GetLastSubmittedCommandSerial()));
 
@@ -382,6 +451,7 @@ MaybeError Device::NextSerial() {
 }
 
 MaybeError Device::WaitForSerial(ExecutionSerial serial) {
+    DAWN_TRY(SignalFence());
     DAWN_TRY(CheckPassedSerials());
     if (GetCompletedCommandSerial() < serial) {
         DAWN_TRY(CheckHRESULT(mFence->SetEventOnCompletion(uint64_t(serial), mFenceEvent),
@@ -414,6 +484,28 @@ void Device::ReferenceUntilUnused(ComPtr<IUnknown> object) {
     mUsedComObjectRefs.Enqueue(object, GetPendingCommandSerial());
 }
 
+ResultOrError<ComPtr<ID3D12RootSignature>> Device::GetOrCreateRootSignature(
+    ID3DBlob* serializedBlob) {
+    std::string blobBytes(static_cast<const char*>(serializedBlob->GetBufferPointer()),
+                          serializedBlob->GetBufferSize());
+
+    std::lock_guard<std::mutex> lock(mRootSignatureCacheMutex);
+    auto it = mRootSignatureCache.find(blobBytes);
+    if (it != mRootSignatureCache.end()) {
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheHits, 1);
+        return ComPtr<ID3D12RootSignature>(it->second);
+    }
+    dawn::platform::AddMetric(dawn::platform::MetricCounter::ObjectCacheMisses, 1);
+
+    ComPtr<ID3D12RootSignature> rootSignature;
+    DAWN_TRY(CheckHRESULT(mD3d12Device->CreateRootSignature(0, serializedBlob->GetBufferPointer(),
+                                                            serializedBlob->GetBufferSize(),
+                                                            IID_PPV_ARGS(&rootSignature)),
+                          "D3D12 create root signature"));
+    mRootSignatureCache.emplace(std::move(blobBytes), rootSignature);
+    return std::move(rootSignature);
+}
+
 MaybeError Device::ExecutePendingCommandContext() {
     return mPendingCommands.ExecuteCommandList(this);
 }
@@ -623,6 +715,9 @@ ResultOrError<ComPtr<gpgmm::d3d12::ResourceAllocation>> Device::AllocateMemory(
                                            optimizedClearValue, &allocation),
         "CreateResource"));
 
+    mPeakUsedBlockUsage =
+        std::max(mPeakUsedBlockUsage, mResourceAllocator->GetInfo().UsedBlockUsage);
+
     return allocation;
 }
 
@@ -726,6 +821,13 @@ ComPtr<ID3D11On12Device> Device::GetOrCreateD3D11on12Device() {
     return mD3d11On12Device;
 }
 
+D3D11on12ResourceCache* Device::GetD3D11on12ResourceCache() {
+    if (mD3D11on12ResourceCache == nullptr) {
+        mD3D11on12ResourceCache = std::make_unique<D3D11on12ResourceCache>();
+    }
+    return mD3D11on12ResourceCache.get();
+}
+
 const D3D12DeviceInfo& Device::GetDeviceInfo() const {
     return ToBackend(GetAdapter())->GetDeviceInfo();
 }
@@ -897,6 +999,11 @@ void Device::DestroyImpl() {
     }
 
     mZeroBuffer = nullptr;
+    mRootSignatureCache.clear();
+
+    // Releases the 11 wrapped resources the cache still holds the last reference to, which
+    // flushes the 11on12 device while it is still alive.
+    mD3D11on12ResourceCache.reset();
 
     // Immediately forget about all pending commands for the case where device is lost on its
     // own and WaitForIdleForDestruction isn't called.
@@ -909,6 +1016,19 @@ void Device::DestroyImpl() {
     // We need to handle clearing up com object refs that were enqeued after TickImpl
     mUsedComObjectRefs.ClearUpTo(std::numeric_limits<ExecutionSerial>::max());
 
+    // All placed resources have been released above, so the pooled transient attachment
+    // heaps can be destroyed.
+    if (mTransientAttachmentAllocator != nullptr) {
+        mTransientAttachmentAllocator->DestroyPool();
+    }
+
+    // Every query set has been destroyed, so after retiring the pending deallocations all
+    // pooled query heaps are unused and can be released.
+    if (mQueryHeapAllocator != nullptr) {
+        mQueryHeapAllocator->Tick(std::numeric_limits<ExecutionSerial>::max());
+        mQueryHeapAllocator->DestroyPool();
+    }
+
     ASSERT(mUsedComObjectRefs.Empty());
     ASSERT(!mPendingCommands.IsOpen());
 }
@@ -949,6 +1069,10 @@ SamplerHeapCache* Device::GetSamplerHeapCache() {
     return mSamplerHeapCache.get();
 }
 
+QueryHeapAllocator* Device::GetQueryHeapAllocator() const {
+    return mQueryHeapAllocator.get();
+}
+
 uint32_t Device::GetOptimalBytesPerRowAlignment() const {
     return D3D12_TEXTURE_DATA_PITCH_ALIGNMENT;
 }
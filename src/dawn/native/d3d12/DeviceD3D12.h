@@ -16,6 +16,9 @@
 #define SRC_DAWN_NATIVE_D3D12_DEVICED3D12_H_
 
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "dawn/common/SerialQueue.h"
@@ -30,12 +33,15 @@
 namespace dawn::native::d3d12 {
 
 class CommandAllocatorManager;
+class D3D11on12ResourceCache;
 struct ExternalImageDescriptorDXGISharedHandle;
 class ExternalImageDXGIImpl;
 class PlatformFunctions;
 class SamplerHeapCache;
+class QueryHeapAllocator;
 class ShaderVisibleDescriptorAllocator;
 class StagingDescriptorAllocator;
+class TransientAttachmentAllocator;
 
 #define ASSERT_SUCCESS(hr)            \
     do {                              \
@@ -56,6 +62,8 @@ class Device final : public DeviceBase {
         const CommandBufferDescriptor* descriptor) override;
 
     MaybeError TickImpl() override;
+    void ReduceMemoryUsageImpl() override;
+    void AppendMemoryReportImpl(std::vector<AllocatorMemoryInfo>* report) const override;
 
     ID3D12Device* GetD3D12Device() const;
     ComPtr<ID3D12CommandQueue> GetCommandQueue() const;
@@ -67,6 +75,7 @@ class Device final : public DeviceBase {
 
     CommandAllocatorManager* GetCommandAllocatorManager() const;
     gpgmm::d3d12::ResidencyManager* GetResidencyManager() const;
+    TransientAttachmentAllocator* GetTransientAttachmentAllocator() const;
 
     const PlatformFunctions* GetFunctions() const;
     ComPtr<IDXGIFactory4> GetFactory() const;
@@ -84,10 +93,19 @@ class Device final : public DeviceBase {
     const D3D12DeviceInfo& GetDeviceInfo() const;
 
     MaybeError NextSerial();
+    // Issues the queue signal for serials advanced by NextSerial since the last signal.
+    // Signals are batched to one per tick; call this before waiting on a serial that may not
+    // have been signaled yet.
+    MaybeError SignalFence();
     MaybeError WaitForSerial(ExecutionSerial serial);
 
     void ReferenceUntilUnused(ComPtr<IUnknown> object);
 
+    // Returns the root signature for the given serialized blob, deduplicating identical blobs:
+    // distinct pipeline layouts frequently serialize to the same bytes and PSO creation is
+    // faster when they share one ID3D12RootSignature.
+    ResultOrError<ComPtr<ID3D12RootSignature>> GetOrCreateRootSignature(ID3DBlob* serializedBlob);
+
     MaybeError ExecutePendingCommandContext();
 
     ResultOrError<std::unique_ptr<StagingBufferBase>> CreateStagingBuffer(size_t size) override;
@@ -135,6 +153,8 @@ class Device final : public DeviceBase {
 
     StagingDescriptorAllocator* GetDepthStencilViewAllocator() const;
 
+    QueryHeapAllocator* GetQueryHeapAllocator() const;
+
     std::unique_ptr<ExternalImageDXGIImpl> CreateExternalImageDXGIImpl(
         const ExternalImageDescriptorDXGISharedHandle* descriptor);
 
@@ -149,6 +169,11 @@ class Device final : public DeviceBase {
 
     ComPtr<ID3D11On12Device> GetOrCreateD3D11on12Device();
 
+    // Cache of 11 wrapped resources and their keyed-mutex state, shared by every
+    // ExternalImageDXGIImpl created from this device so re-importing the same resource hits
+    // the cache.
+    D3D11on12ResourceCache* GetD3D11on12ResourceCache();
+
     void InitTogglesFromDriver();
 
     uint32_t GetOptimalBytesPerRowAlignment() const override;
@@ -222,6 +247,7 @@ class Device final : public DeviceBase {
 
     ComPtr<ID3D12Fence> mFence;
     HANDLE mFenceEvent = nullptr;
+    bool mFenceSignalPending = false;
     ResultOrError<ExecutionSerial> CheckAndUpdateCompletedSerials() override;
 
     ComPtr<ID3D12Device> mD3d12Device;  // Device is owned by adapter and will not be outlived.
@@ -230,6 +256,7 @@ class Device final : public DeviceBase {
 
     // 11on12 device corresponding to mCommandQueue
     ComPtr<ID3D11On12Device> mD3d11On12Device;
+    std::unique_ptr<D3D11on12ResourceCache> mD3D11on12ResourceCache;
 
     ComPtr<ID3D12CommandSignature> mDispatchIndirectSignature;
     ComPtr<ID3D12CommandSignature> mDrawIndirectSignature;
@@ -242,6 +269,9 @@ class Device final : public DeviceBase {
     std::unique_ptr<CommandAllocatorManager> mCommandAllocatorManager;
     ComPtr<gpgmm::d3d12::ResourceAllocator> mResourceAllocator;
     ComPtr<gpgmm::d3d12::ResidencyManager> mResidencyManager;
+    // High-water mark of the resource allocator's live block usage, see GetMemoryReport.
+    uint64_t mPeakUsedBlockUsage = 0;
+    std::unique_ptr<TransientAttachmentAllocator> mTransientAttachmentAllocator;
 
     static constexpr uint32_t kMaxSamplerDescriptorsPerBindGroup = 3 * kMaxSamplersPerShaderStage;
     static constexpr uint32_t kMaxViewDescriptorsPerBindGroup =
@@ -274,6 +304,13 @@ class Device final : public DeviceBase {
     // release is called.
     std::unique_ptr<SamplerHeapCache> mSamplerHeapCache;
 
+    std::unique_ptr<QueryHeapAllocator> mQueryHeapAllocator;
+
+    // Root signatures deduplicated by their serialized bytes. The mutex is only contended by
+    // concurrent pipeline layout creation.
+    std::mutex mRootSignatureCacheMutex;
+    std::unordered_map<std::string, ComPtr<ID3D12RootSignature>> mRootSignatureCache;
+
     // A buffer filled with zeros that is used to copy into other buffers when they need to be
     // cleared.
     Ref<Buffer> mZeroBuffer;
@@ -33,7 +33,6 @@ ExternalImageDXGIImpl::ExternalImageDXGIImpl(Device* backendDevice,
     : mBackendDevice(backendDevice),
       mD3D12Resource(std::move(d3d12Resource)),
       mD3D12Fence(std::move(d3d12Fence)),
-      mD3D11on12ResourceCache(std::make_unique<D3D11on12ResourceCache>()),
       mUsage(descriptor->usage),
       mDimension(descriptor->dimension),
       mSize(descriptor->size),
@@ -71,7 +70,6 @@ void ExternalImageDXGIImpl::Destroy() {
 
         mD3D12Resource.Reset();
         mD3D12Fence.Reset();
-        mD3D11on12ResourceCache.reset();
     }
 }
 
@@ -101,8 +99,11 @@ WGPUTexture ExternalImageDXGIImpl::ProduceTexture(
 
     Ref<D3D11on12ResourceCacheEntry> d3d11on12Resource;
     if (!mD3D12Fence) {
-        d3d11on12Resource = mD3D11on12ResourceCache->GetOrCreateD3D11on12Resource(
-            mBackendDevice, mD3D12Resource.Get());
+        // The cache is shared device-wide so producing the same resource through any number of
+        // external images reuses the wrapped resource and its keyed-mutex state.
+        D3D11on12ResourceCache* cache = mBackendDevice->GetD3D11on12ResourceCache();
+        d3d11on12Resource =
+            cache->GetOrCreateD3D11on12Resource(mBackendDevice, mD3D12Resource.Get());
         if (d3d11on12Resource == nullptr) {
             dawn::ErrorLog() << "Unable to create 11on12 resource for external image";
             return nullptr;
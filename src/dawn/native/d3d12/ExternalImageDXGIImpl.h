@@ -28,7 +28,6 @@ struct ID3D12Fence;
 
 namespace dawn::native::d3d12 {
 
-class D3D11on12ResourceCache;
 class Device;
 struct ExternalImageAccessDescriptorDXGISharedHandle;
 struct ExternalImageDescriptorDXGISharedHandle;
@@ -54,7 +53,6 @@ class ExternalImageDXGIImpl : public LinkNode<ExternalImageDXGIImpl> {
     Device* mBackendDevice;
     Microsoft::WRL::ComPtr<ID3D12Resource> mD3D12Resource;
     Microsoft::WRL::ComPtr<ID3D12Fence> mD3D12Fence;
-    std::unique_ptr<D3D11on12ResourceCache> mD3D11on12ResourceCache;
 
     // Contents of WGPUTextureDescriptor are stored individually since the descriptor
     // could outlive this image.
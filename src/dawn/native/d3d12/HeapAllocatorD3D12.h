@@ -26,7 +26,7 @@ namespace dawn::native::d3d12 {
 class Device;
 
 // Wrapper to allocate a D3D12 heap.
-class HeapAllocator : public ResourceHeapAllocator {
+class HeapAllocator final : public ResourceHeapAllocator {
   public:
     HeapAllocator(Device* device,
                   D3D12_HEAP_TYPE heapType,
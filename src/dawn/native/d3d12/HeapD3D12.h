@@ -26,7 +26,7 @@ class Device;
 // This class is used to represent ID3D12Heap allocations, as well as an implicit heap
 // representing a directly allocated resource. It inherits from Pageable because each Heap must
 // be represented in the ResidencyManager.
-class Heap : public ResourceHeapBase, public Pageable {
+class Heap final : public ResourceHeapBase, public Pageable {
   public:
     Heap(ComPtr<ID3D12Pageable> d3d12Pageable, MemorySegment memorySegment, uint64_t size);
 
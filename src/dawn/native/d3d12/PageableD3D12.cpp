@@ -14,6 +14,7 @@
 
 #include "dawn/native/d3d12/PageableD3D12.h"
 
+#include <limits>
 #include <utility>
 
 namespace dawn::native::d3d12 {
@@ -61,6 +62,25 @@ bool Pageable::IsInResidencyLRUCache() const {
     return IsInList();
 }
 
+uint32_t Pageable::GetUsageCount() const {
+    return mUsageCount;
+}
+
+void Pageable::IncrementUsageCount() {
+    // Saturate so a long-lived heap cannot overflow back to "cold".
+    if (mUsageCount != std::numeric_limits<uint32_t>::max()) {
+        mUsageCount++;
+    }
+}
+
+bool Pageable::IsInFrequentCache() const {
+    return mInFrequentCache;
+}
+
+void Pageable::SetInFrequentCache(bool inFrequentCache) {
+    mInFrequentCache = inFrequentCache;
+}
+
 void Pageable::IncrementResidencyLock() {
     mResidencyLockRefCount++;
 }
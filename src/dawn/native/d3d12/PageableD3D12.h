@@ -51,6 +51,17 @@ class Pageable : public LinkNode<Pageable> {
 
     bool IsInResidencyLRUCache() const;
 
+    // Counts how many submissions have referenced this pageable. The residency manager uses
+    // the count to segment frequently reused heaps (descriptor heaps, per-frame ring buffers)
+    // from cold ones so the cold heaps are preferred for eviction.
+    uint32_t GetUsageCount() const;
+    void IncrementUsageCount();
+
+    // Tracks which residency segment the pageable currently sits in; only the residency
+    // manager may change this.
+    bool IsInFrequentCache() const;
+    void SetInFrequentCache(bool inFrequentCache);
+
     // In some scenarios, such as async buffer mapping or descriptor heaps, we must lock
     // residency to ensure the pageable cannot be evicted. Because multiple buffers may be
     // mapped in a single heap, we must track the number of resources currently locked.
@@ -73,6 +84,8 @@ class Pageable : public LinkNode<Pageable> {
     ExecutionSerial mLastSubmission = ExecutionSerial(0);
     MemorySegment mMemorySegment;
     uint32_t mResidencyLockRefCount = 0;
+    uint32_t mUsageCount = 0;
+    bool mInFrequentCache = false;
     uint64_t mSize = 0;
 };
 }  // namespace dawn::native::d3d12
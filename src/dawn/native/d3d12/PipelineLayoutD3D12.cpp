@@ -267,10 +267,9 @@ MaybeError PipelineLayout::Initialize() {
         messageStream << "D3D12 serialize root signature";
         DAWN_TRY(CheckHRESULT(hr, messageStream.str().c_str()));
     }
-    DAWN_TRY(CheckHRESULT(device->GetD3D12Device()->CreateRootSignature(
-                              0, mRootSignatureBlob->GetBufferPointer(),
-                              mRootSignatureBlob->GetBufferSize(), IID_PPV_ARGS(&mRootSignature)),
-                          "D3D12 create root signature"));
+    // Layouts that serialize to the same bytes share one ID3D12RootSignature via the device
+    // cache.
+    DAWN_TRY_ASSIGN(mRootSignature, device->GetOrCreateRootSignature(mRootSignatureBlob.Get()));
     StreamIn(&mCacheKey, mRootSignatureBlob.Get());
     return {};
 }
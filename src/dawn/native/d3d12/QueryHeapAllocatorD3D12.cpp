@@ -0,0 +1,171 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/d3d12/QueryHeapAllocatorD3D12.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+#include "dawn/native/BuddyAllocator.h"
+#include "dawn/native/d3d12/D3D12Error.h"
+#include "dawn/native/d3d12/DeviceD3D12.h"
+#include "dawn/native/d3d12/UtilsD3D12.h"
+
+namespace dawn::native::d3d12 {
+
+namespace {
+
+D3D12_QUERY_HEAP_TYPE D3D12QueryHeapType(wgpu::QueryType type) {
+    switch (type) {
+        case wgpu::QueryType::Occlusion:
+            return D3D12_QUERY_HEAP_TYPE_OCCLUSION;
+        case wgpu::QueryType::PipelineStatistics:
+            return D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS;
+        case wgpu::QueryType::Timestamp:
+            return D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+    }
+}
+
+// Large enough that a frame's worth of profiler query sets fits in one shared heap, small
+// enough that an idle heap doesn't hold a meaningful amount of memory.
+constexpr uint32_t kSharedQueryHeapSize = 4096;
+// Occlusion query sets up to this size are sub-allocated; larger ones would fragment the
+// shared heap and get a dedicated heap instead.
+constexpr uint32_t kMaxSuballocatedQueryCount = 256;
+// How many free dedicated heaps are kept for reuse before deallocations destroy heaps
+// outright.
+constexpr size_t kMaxFreeDedicatedHeaps = 8;
+
+}  // anonymous namespace
+
+struct SharedQueryHeap {
+    explicit SharedQueryHeap(ComPtr<ID3D12QueryHeap> heap)
+        : heap(std::move(heap)), allocator(kSharedQueryHeapSize) {}
+
+    ComPtr<ID3D12QueryHeap> heap;
+    BuddyAllocator allocator;
+    // Counts live slices and slices pending deallocation; the heap may only be destroyed when
+    // it reaches zero.
+    uint32_t allocationCount = 0;
+};
+
+QueryHeapAllocator::QueryHeapAllocator(Device* device) : mDevice(device) {}
+
+// All remaining heaps are released through ComPtr. The device only destroys the allocator
+// after the GPU finished using them.
+QueryHeapAllocator::~QueryHeapAllocator() = default;
+
+ResultOrError<ComPtr<ID3D12QueryHeap>> QueryHeapAllocator::CreateQueryHeap(
+    D3D12_QUERY_HEAP_TYPE heapType,
+    uint32_t queryCount) {
+    D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+    queryHeapDesc.Type = heapType;
+    queryHeapDesc.Count = queryCount;
+
+    ComPtr<ID3D12QueryHeap> heap;
+    DAWN_TRY(CheckOutOfMemoryHRESULT(
+        mDevice->GetD3D12Device()->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&heap)),
+        "ID3D12Device::CreateQueryHeap"));
+    return std::move(heap);
+}
+
+ResultOrError<QueryHeapAllocation> QueryHeapAllocator::Allocate(wgpu::QueryType type,
+                                                                uint32_t queryCount) {
+    QueryHeapAllocation allocation;
+    allocation.queryCount = std::max(queryCount, uint32_t(1u));
+    allocation.heapType = D3D12QueryHeapType(type);
+
+    // Small occlusion query sets are sub-allocated from shared heaps. The buddy allocator
+    // works in power-of-two blocks, so the count is rounded up to one.
+    if (type == wgpu::QueryType::Occlusion &&
+        allocation.queryCount <= kMaxSuballocatedQueryCount) {
+        uint64_t blockSize = NextPowerOfTwo(allocation.queryCount);
+        SharedQueryHeap* sharedHeap = nullptr;
+        uint64_t offset = BuddyAllocator::kInvalidOffset;
+        for (std::unique_ptr<SharedQueryHeap>& candidate : mSharedHeaps) {
+            offset = candidate->allocator.Allocate(blockSize);
+            if (offset != BuddyAllocator::kInvalidOffset) {
+                sharedHeap = candidate.get();
+                break;
+            }
+        }
+
+        if (sharedHeap == nullptr) {
+            ComPtr<ID3D12QueryHeap> heap;
+            DAWN_TRY_ASSIGN(heap,
+                            CreateQueryHeap(D3D12_QUERY_HEAP_TYPE_OCCLUSION, kSharedQueryHeapSize));
+            SetDebugName(mDevice, heap.Get(), "Dawn_SharedQueryHeap");
+            mSharedHeaps.push_back(std::make_unique<SharedQueryHeap>(std::move(heap)));
+            sharedHeap = mSharedHeaps.back().get();
+            offset = sharedHeap->allocator.Allocate(blockSize);
+            ASSERT(offset != BuddyAllocator::kInvalidOffset);
+        }
+
+        sharedHeap->allocationCount++;
+        allocation.heap = sharedHeap->heap;
+        allocation.baseQueryIndex = static_cast<uint32_t>(offset);
+        allocation.sharedHeap = sharedHeap;
+        return std::move(allocation);
+    }
+
+    // Everything else gets a dedicated heap, reusing a pooled one of the same shape when
+    // possible.
+    for (size_t i = 0; i < mFreeDedicatedHeaps.size(); ++i) {
+        DedicatedHeap& freeHeap = mFreeDedicatedHeaps[i];
+        if (freeHeap.heapType == allocation.heapType &&
+            freeHeap.queryCount == allocation.queryCount) {
+            allocation.heap = std::move(freeHeap.heap);
+            mFreeDedicatedHeaps.erase(mFreeDedicatedHeaps.begin() + i);
+            return std::move(allocation);
+        }
+    }
+
+    DAWN_TRY_ASSIGN(allocation.heap, CreateQueryHeap(allocation.heapType, allocation.queryCount));
+    return std::move(allocation);
+}
+
+void QueryHeapAllocator::Deallocate(QueryHeapAllocation allocation,
+                                    ExecutionSerial lastUsageSerial) {
+    mPendingDeallocations.Enqueue(std::move(allocation), lastUsageSerial);
+}
+
+void QueryHeapAllocator::Tick(ExecutionSerial completedSerial) {
+    for (QueryHeapAllocation& allocation : mPendingDeallocations.IterateUpTo(completedSerial)) {
+        if (allocation.sharedHeap != nullptr) {
+            allocation.sharedHeap->allocator.Deallocate(allocation.baseQueryIndex);
+            ASSERT(allocation.sharedHeap->allocationCount > 0);
+            allocation.sharedHeap->allocationCount--;
+        } else if (mFreeDedicatedHeaps.size() < kMaxFreeDedicatedHeaps) {
+            mFreeDedicatedHeaps.push_back(
+                {std::move(allocation.heap), allocation.heapType, allocation.queryCount});
+        }
+        // Otherwise the ComPtr going out of scope destroys the native heap.
+    }
+    mPendingDeallocations.ClearUpTo(completedSerial);
+}
+
+void QueryHeapAllocator::DestroyPool() {
+    mFreeDedicatedHeaps.clear();
+
+    // A shared heap may only go away once every slice, live or pending deallocation, is gone.
+    mSharedHeaps.erase(std::remove_if(mSharedHeaps.begin(), mSharedHeaps.end(),
+                                      [](const std::unique_ptr<SharedQueryHeap>& sharedHeap) {
+                                          return sharedHeap->allocationCount == 0;
+                                      }),
+                       mSharedHeaps.end());
+}
+
+}  // namespace dawn::native::d3d12
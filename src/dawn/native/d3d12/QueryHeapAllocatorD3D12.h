@@ -0,0 +1,84 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_D3D12_QUERYHEAPALLOCATORD3D12_H_
+#define SRC_DAWN_NATIVE_D3D12_QUERYHEAPALLOCATORD3D12_H_
+
+#include <memory>
+#include <vector>
+
+#include "dawn/common/SerialQueue.h"
+#include "dawn/native/Error.h"
+#include "dawn/native/IntegerTypes.h"
+#include "dawn/native/d3d12/d3d12_platform.h"
+#include "dawn/native/dawn_platform.h"
+
+namespace dawn::native::d3d12 {
+
+class Device;
+
+// Defined in the .cpp; internal bookkeeping for a shared occlusion heap.
+struct SharedQueryHeap;
+
+// The range of queries a QuerySet occupies in a native query heap: either a slice of a shared
+// occlusion heap or the whole of a dedicated heap.
+struct QueryHeapAllocation {
+    ComPtr<ID3D12QueryHeap> heap;
+    uint32_t baseQueryIndex = 0;
+    uint32_t queryCount = 0;
+    D3D12_QUERY_HEAP_TYPE heapType = D3D12_QUERY_HEAP_TYPE_OCCLUSION;
+    // Non-null when the allocation is a slice of a shared heap owned by the allocator.
+    SharedQueryHeap* sharedHeap = nullptr;
+};
+
+// Pools native query heaps at the device level so that applications which create and destroy
+// query sets every frame (per-frame profilers in particular) don't hit
+// ID3D12Device::CreateQueryHeap in steady state. Small occlusion query sets are sub-allocated
+// into large shared heaps; other query types and large sets get a dedicated heap that is
+// pooled whole. Reuse is serial-gated like the other pooled resources: a deallocated range
+// only becomes available again once the last submission that may reference it completes.
+class QueryHeapAllocator {
+  public:
+    explicit QueryHeapAllocator(Device* device);
+    ~QueryHeapAllocator();
+
+    ResultOrError<QueryHeapAllocation> Allocate(wgpu::QueryType type, uint32_t queryCount);
+    void Deallocate(QueryHeapAllocation allocation, ExecutionSerial lastUsageSerial);
+
+    // Retires deallocations whose serial completed, making their ranges reusable.
+    void Tick(ExecutionSerial completedSerial);
+    // Frees pooled heaps that hold no live allocation, see DeviceBase::ReduceMemoryUsage.
+    void DestroyPool();
+
+  private:
+    ResultOrError<ComPtr<ID3D12QueryHeap>> CreateQueryHeap(D3D12_QUERY_HEAP_TYPE heapType,
+                                                           uint32_t queryCount);
+
+    Device* mDevice;
+
+    std::vector<std::unique_ptr<SharedQueryHeap>> mSharedHeaps;
+
+    struct DedicatedHeap {
+        ComPtr<ID3D12QueryHeap> heap;
+        D3D12_QUERY_HEAP_TYPE heapType;
+        uint32_t queryCount;
+    };
+    std::vector<DedicatedHeap> mFreeDedicatedHeaps;
+
+    SerialQueue<ExecutionSerial, QueryHeapAllocation> mPendingDeallocations;
+};
+
+}  // namespace dawn::native::d3d12
+
+#endif  // SRC_DAWN_NATIVE_D3D12_QUERYHEAPALLOCATORD3D12_H_
@@ -14,27 +14,13 @@
 
 #include "dawn/native/d3d12/QuerySetD3D12.h"
 
-#include <algorithm>
+#include <utility>
 
-#include "dawn/native/d3d12/D3D12Error.h"
 #include "dawn/native/d3d12/DeviceD3D12.h"
 #include "dawn/native/d3d12/UtilsD3D12.h"
 
 namespace dawn::native::d3d12 {
 
-namespace {
-D3D12_QUERY_HEAP_TYPE D3D12QueryHeapType(wgpu::QueryType type) {
-    switch (type) {
-        case wgpu::QueryType::Occlusion:
-            return D3D12_QUERY_HEAP_TYPE_OCCLUSION;
-        case wgpu::QueryType::PipelineStatistics:
-            return D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS;
-        case wgpu::QueryType::Timestamp:
-            return D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
-    }
-}
-}  // anonymous namespace
-
 // static
 ResultOrError<Ref<QuerySet>> QuerySet::Create(Device* device,
                                               const QuerySetDescriptor* descriptor) {
@@ -44,14 +30,9 @@ ResultOrError<Ref<QuerySet>> QuerySet::Create(Device* device,
 }
 
 MaybeError QuerySet::Initialize() {
-    D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
-    queryHeapDesc.Type = D3D12QueryHeapType(GetQueryType());
-    queryHeapDesc.Count = std::max(GetQueryCount(), uint32_t(1u));
-
-    ID3D12Device* d3d12Device = ToBackend(GetDevice())->GetD3D12Device();
-    DAWN_TRY(CheckOutOfMemoryHRESULT(
-        d3d12Device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&mQueryHeap)),
-        "ID3D12Device::CreateQueryHeap"));
+    DAWN_TRY_ASSIGN(mAllocation, ToBackend(GetDevice())
+                                     ->GetQueryHeapAllocator()
+                                     ->Allocate(GetQueryType(), GetQueryCount()));
 
     SetLabelImpl();
 
@@ -59,19 +40,33 @@ MaybeError QuerySet::Initialize() {
 }
 
 ID3D12QueryHeap* QuerySet::GetQueryHeap() const {
-    return mQueryHeap.Get();
+    return mAllocation.heap.Get();
+}
+
+uint32_t QuerySet::GetQueryHeapOffset() const {
+    return mAllocation.baseQueryIndex;
 }
 
 QuerySet::~QuerySet() = default;
 
 void QuerySet::DestroyImpl() {
     QuerySetBase::DestroyImpl();
-    ToBackend(GetDevice())->ReferenceUntilUnused(mQueryHeap);
-    mQueryHeap = nullptr;
+    if (mAllocation.heap != nullptr) {
+        // The heap (or the slice of it) goes back to the device's pool; it only becomes
+        // reusable once the last submission that may reference it completes.
+        Device* device = ToBackend(GetDevice());
+        device->GetQueryHeapAllocator()->Deallocate(std::move(mAllocation),
+                                                    device->GetPendingCommandSerial());
+        mAllocation = {};
+    }
 }
 
 void QuerySet::SetLabelImpl() {
-    SetDebugName(ToBackend(GetDevice()), mQueryHeap.Get(), "Dawn_QuerySet", GetLabel());
+    // Slices of a shared heap are not labeled: the native heap is shared between many query
+    // sets.
+    if (mAllocation.sharedHeap == nullptr && mAllocation.heap != nullptr) {
+        SetDebugName(ToBackend(GetDevice()), mAllocation.heap.Get(), "Dawn_QuerySet", GetLabel());
+    }
 }
 
 }  // namespace dawn::native::d3d12
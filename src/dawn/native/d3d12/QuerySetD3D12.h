@@ -16,18 +16,22 @@
 #define SRC_DAWN_NATIVE_D3D12_QUERYSETD3D12_H_
 
 #include "dawn/native/QuerySet.h"
+#include "dawn/native/d3d12/QueryHeapAllocatorD3D12.h"
 #include "dawn/native/d3d12/d3d12_platform.h"
 
 namespace dawn::native::d3d12 {
 
 class Device;
 
-class QuerySet : public QuerySetBase {
+class QuerySet final : public QuerySetBase {
   public:
     static ResultOrError<Ref<QuerySet>> Create(Device* device,
                                                const QuerySetDescriptor* descriptor);
 
     ID3D12QueryHeap* GetQueryHeap() const;
+    // The index of this query set's first query in the heap. Non-zero when the query set is
+    // sub-allocated from a shared heap, see QueryHeapAllocator.
+    uint32_t GetQueryHeapOffset() const;
 
   private:
     ~QuerySet() override;
@@ -38,7 +42,7 @@ class QuerySet : public QuerySetBase {
     void DestroyImpl() override;
     void SetLabelImpl() override;
 
-    ComPtr<ID3D12QueryHeap> mQueryHeap;
+    QueryHeapAllocation mAllocation;
 };
 
 }  // namespace dawn::native::d3d12
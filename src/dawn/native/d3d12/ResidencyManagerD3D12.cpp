@@ -25,6 +25,16 @@
 
 namespace dawn::native::d3d12 {
 
+namespace {
+
+// Number of submissions a pageable must be referenced by before it is promoted into the
+// frequent segment of the LRU. Per-frame heaps pass this within a handful of frames while
+// one-off texture uploads never do. The value is arbitrarily chosen and subject to future
+// experimentation.
+constexpr uint32_t kFrequentUsageThreshold = 8;
+
+}  // anonymous namespace
+
 ResidencyManager::ResidencyManager(Device* device)
     : mDevice(device),
       mResidencyManagementEnabled(device->IsToggleEnabled(Toggle::UseD3D12ResidencyManagement)) {
@@ -42,8 +52,10 @@ MaybeError ResidencyManager::LockAllocation(Pageable* pageable) {
         ID3D12Pageable* d3d12Pageable = pageable->GetD3D12Pageable();
         uint64_t size = pageable->GetSize();
 
+        // Locked allocations may be accessed by the CPU right away (for example for buffer
+        // mapping), so they cannot take the asynchronous paging path.
         DAWN_TRY(MakeAllocationsResident(GetMemorySegmentInfo(pageable->GetMemorySegment()), size,
-                                         1, &d3d12Pageable));
+                                         1, &d3d12Pageable, /*allowAsync*/ false));
     }
 
     // Since we can't evict the heap, it's unnecessary to track the heap in the LRU Cache.
@@ -110,6 +122,10 @@ void ResidencyManager::UpdateVideoMemoryInfo() {
     if (!mDevice->GetDeviceInfo().isUMA) {
         UpdateMemorySegmentInfo(&mVideoMemoryInfo.nonLocal);
     }
+
+    // Surface the device-local numbers to the embedder so it can react to pressure, see
+    // SetMemoryBudgetCallback in DawnNative.h. On UMA the local segment is the only one.
+    mDevice->NotifyMemoryBudgetChanged(mVideoMemoryInfo.local.usage, mVideoMemoryInfo.local.budget);
 }
 
 void ResidencyManager::UpdateMemorySegmentInfo(MemorySegmentInfo* segmentInfo) {
@@ -148,15 +164,21 @@ void ResidencyManager::UpdateMemorySegmentInfo(MemorySegmentInfo* segmentInfo) {
 // nullptr when nothing further can be evicted.
 ResultOrError<Pageable*> ResidencyManager::RemoveSingleEntryFromLRU(
     MemorySegmentInfo* memorySegment) {
-    // If the LRU is empty, return nullptr to allow execution to continue. Note that fully
-    // emptying the LRU is undesirable, because it can mean either 1) the LRU is not accurately
-    // accounting for Dawn's GPU allocations, or 2) a component external to Dawn is using all of
-    // the process budget and starving Dawn, which will cause thrash.
-    if (memorySegment->lruCache.empty()) {
-        return nullptr;
+    // Cold allocations are evicted before anything in the frequent segment, so heaps the
+    // application touches every frame are the last to be paged out. If both segments are
+    // empty, return nullptr to allow execution to continue. Note that fully emptying the LRU
+    // is undesirable, because it can mean either 1) the LRU is not accurately accounting for
+    // Dawn's GPU allocations, or 2) a component external to Dawn is using all of the process
+    // budget and starving Dawn, which will cause thrash.
+    LinkedList<Pageable>* lru = &memorySegment->lruCache;
+    if (lru->empty()) {
+        lru = &memorySegment->frequentCache;
+        if (lru->empty()) {
+            return nullptr;
+        }
     }
 
-    Pageable* pageable = memorySegment->lruCache.head()->value();
+    Pageable* pageable = lru->head()->value();
 
     ExecutionSerial lastSubmissionSerial = pageable->GetLastSubmission();
 
@@ -174,6 +196,8 @@ ResultOrError<Pageable*> ResidencyManager::RemoveSingleEntryFromLRU(
     }
 
     pageable->RemoveFromList();
+
+    pageable->SetInFrequentCache(false);
     return pageable;
 }
 
@@ -274,6 +298,13 @@ MaybeError ResidencyManager::EnsureHeapsAreResident(Heap** heaps, size_t heapCou
         // eligible for eviction, even though some evictions may be possible.
         heap->SetLastSubmission(pendingCommandSerial);
 
+        // Promote heaps that keep getting referenced into the frequent segment so that cold
+        // heaps are always evicted ahead of them.
+        heap->IncrementUsageCount();
+        if (heap->GetUsageCount() >= kFrequentUsageThreshold) {
+            heap->SetInFrequentCache(true);
+        }
+
         // Insert the heap into the appropriate LRU.
         TrackResidentAllocation(heap);
     }
@@ -281,34 +312,68 @@ MaybeError ResidencyManager::EnsureHeapsAreResident(Heap** heaps, size_t heapCou
     if (localSizeToMakeResident > 0) {
         return MakeAllocationsResident(&mVideoMemoryInfo.local, localSizeToMakeResident,
                                        localHeapsToMakeResident.size(),
-                                       localHeapsToMakeResident.data());
+                                       localHeapsToMakeResident.data(), /*allowAsync*/ true);
     }
 
     if (nonLocalSizeToMakeResident > 0) {
         ASSERT(!mDevice->GetDeviceInfo().isUMA);
         return MakeAllocationsResident(&mVideoMemoryInfo.nonLocal, nonLocalSizeToMakeResident,
                                        nonLocalHeapsToMakeResident.size(),
-                                       nonLocalHeapsToMakeResident.data());
+                                       nonLocalHeapsToMakeResident.data(), /*allowAsync*/ true);
+    }
+
+    return {};
+}
+
+// Lazily queries EnqueueMakeResident support and creates the paging fence backing the async
+// MakeResident path. EnqueueMakeResident is exposed through ID3D12Device3 and is not
+// available on all Windows 10 platforms; when it is missing we fall back to the synchronous
+// MakeResident call.
+MaybeError ResidencyManager::EnsurePagingFence() {
+    if (mCheckedAsyncMakeResidentSupport) {
+        return {};
+    }
+    mCheckedAsyncMakeResidentSupport = true;
+
+    if (FAILED(mDevice->GetD3D12Device()->QueryInterface(IID_PPV_ARGS(&mD3d12Device3)))) {
+        mD3d12Device3 = nullptr;
+        return {};
     }
 
+    DAWN_TRY(CheckHRESULT(mDevice->GetD3D12Device()->CreateFence(0, D3D12_FENCE_FLAG_NONE,
+                                                                 IID_PPV_ARGS(&mPagingFence)),
+                          "D3D12 create paging fence"));
     return {};
 }
 
 MaybeError ResidencyManager::MakeAllocationsResident(MemorySegmentInfo* segment,
                                                      uint64_t sizeToMakeResident,
                                                      uint64_t numberOfObjectsToMakeResident,
-                                                     ID3D12Pageable** allocations) {
+                                                     ID3D12Pageable** allocations,
+                                                     bool allowAsync) {
     uint64_t bytesEvicted;
     DAWN_TRY_ASSIGN(bytesEvicted, EnsureCanMakeResident(sizeToMakeResident, segment));
     DAWN_UNUSED(bytesEvicted);
 
-    // Note that MakeResident is a synchronous function and can add a significant
-    // overhead to command recording. In the future, it may be possible to decrease this
-    // overhead by using MakeResident on a secondary thread, or by instead making use of
-    // the EnqueueMakeResident function (which is not available on all Windows 10
-    // platforms).
-    HRESULT hr =
-        mDevice->GetD3D12Device()->MakeResident(numberOfObjectsToMakeResident, allocations);
+    DAWN_TRY(EnsurePagingFence());
+    const bool useAsync = allowAsync && mD3d12Device3 != nullptr;
+
+    // MakeResident is a synchronous function that can stall command recording for tens of
+    // milliseconds when paging is needed. Prefer EnqueueMakeResident, which returns
+    // immediately and signals the paging fence once the allocations are resident; the queue
+    // wait below defers GPU execution, not the CPU, so paging overlaps recording and
+    // submission.
+    auto makeResident = [&]() -> HRESULT {
+        if (useAsync) {
+            return mD3d12Device3->EnqueueMakeResident(
+                D3D12_RESIDENCY_FLAG_NONE, numberOfObjectsToMakeResident, allocations,
+                mPagingFence.Get(), mLastPagingFenceValue + 1);
+        }
+        return mDevice->GetD3D12Device()->MakeResident(numberOfObjectsToMakeResident,
+                                                       allocations);
+    };
+
+    HRESULT hr = makeResident();
 
     // A MakeResident call can fail if there's not enough available memory. This
     // could occur when there's significant fragmentation or if the allocation size
@@ -328,7 +393,16 @@ MaybeError ResidencyManager::MakeAllocationsResident(MemorySegmentInfo* segment,
                 "MakeResident has failed due to excessive video memory usage.");
         }
 
-        hr = mDevice->GetD3D12Device()->MakeResident(numberOfObjectsToMakeResident, allocations);
+        hr = makeResident();
+    }
+
+    if (useAsync) {
+        // Block GPU execution (but not the CPU) until the enqueued paging work completes, so
+        // command lists referencing these allocations never run before they are resident.
+        mLastPagingFenceValue++;
+        DAWN_TRY(CheckHRESULT(
+            mDevice->GetCommandQueue()->Wait(mPagingFence.Get(), mLastPagingFenceValue),
+            "D3D12 command queue wait on paging fence"));
     }
 
     return {};
@@ -345,13 +419,19 @@ void ResidencyManager::TrackResidentAllocation(Pageable* pageable) {
     }
 
     ASSERT(pageable->IsInList() == false);
-    GetMemorySegmentInfo(pageable->GetMemorySegment())->lruCache.Append(pageable);
+    MemorySegmentInfo* segmentInfo = GetMemorySegmentInfo(pageable->GetMemorySegment());
+    if (pageable->IsInFrequentCache()) {
+        segmentInfo->frequentCache.Append(pageable);
+    } else {
+        segmentInfo->lruCache.Append(pageable);
+    }
 }
 
 // Places an artifical cap on Dawn's budget so we can test in a predictable manner. If used,
 // this function must be called before any resources have been created.
 void ResidencyManager::RestrictBudgetForTesting(uint64_t artificialBudgetCap) {
     ASSERT(mVideoMemoryInfo.nonLocal.lruCache.empty());
+    ASSERT(mVideoMemoryInfo.nonLocal.frequentCache.empty());
     ASSERT(!mRestrictBudgetForTesting);
 
     mRestrictBudgetForTesting = true;
@@ -47,7 +47,12 @@ class ResidencyManager {
   private:
     struct MemorySegmentInfo {
         const DXGI_MEMORY_SEGMENT_GROUP dxgiSegment;
+        // Segmented LRU: cold allocations sit in |lruCache| and are evicted first; heaps that
+        // have been referenced by enough submissions are promoted into |frequentCache|, which
+        // is only evicted once the cold segment is exhausted. This keeps per-frame heaps
+        // (descriptor heaps, ring buffers) resident ahead of cold texture heaps.
         LinkedList<Pageable> lruCache = {};
+        LinkedList<Pageable> frequentCache = {};
         uint64_t budget = 0;
         uint64_t usage = 0;
         uint64_t externalReservation = 0;
@@ -66,7 +71,8 @@ class ResidencyManager {
     MaybeError MakeAllocationsResident(MemorySegmentInfo* segment,
                                        uint64_t sizeToMakeResident,
                                        uint64_t numberOfObjectsToMakeResident,
-                                       ID3D12Pageable** allocations);
+                                       ID3D12Pageable** allocations,
+                                       bool allowAsync);
     void UpdateVideoMemoryInfo();
     void UpdateMemorySegmentInfo(MemorySegmentInfo* segmentInfo);
 
@@ -74,6 +80,15 @@ class ResidencyManager {
     bool mResidencyManagementEnabled = false;
     bool mRestrictBudgetForTesting = false;
     VideoMemoryInfo mVideoMemoryInfo = {};
+
+    // When the OS supports it, MakeResident calls are replaced by EnqueueMakeResident so
+    // paging overlaps rendering: the GPU queue waits on |mPagingFence| instead of the CPU
+    // blocking on the submit path.
+    MaybeError EnsurePagingFence();
+    ComPtr<ID3D12Device3> mD3d12Device3;
+    ComPtr<ID3D12Fence> mPagingFence;
+    uint64_t mLastPagingFenceValue = 0;
+    bool mCheckedAsyncMakeResidentSupport = false;
 };
 
 }  // namespace dawn::native::d3d12
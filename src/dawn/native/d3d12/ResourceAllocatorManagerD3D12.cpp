@@ -17,6 +17,8 @@
 #include <limits>
 #include <utility>
 
+#include "dawn/common/Math.h"
+#include "dawn/native/PerformanceTuning.h"
 #include "dawn/native/d3d12/D3D12Error.h"
 #include "dawn/native/d3d12/DeviceD3D12.h"
 #include "dawn/native/d3d12/HeapAllocatorD3D12.h"
@@ -184,6 +186,9 @@ ResourceAllocatorManager::ResourceAllocatorManager(Device* device) : mDevice(dev
                             ? mDevice->GetDeviceInfo().resourceHeapTier
                             : 1;
 
+    const uint64_t minHeapSize = mDevice->GetTuningProfile().d3d12MinResourceHeapSize;
+    ASSERT(IsPowerOfTwo(minHeapSize));
+
     for (uint32_t i = 0; i < ResourceHeapKind::EnumCount; i++) {
         const ResourceHeapKind resourceHeapKind = static_cast<ResourceHeapKind>(i);
         mHeapAllocators[i] = std::make_unique<HeapAllocator>(
@@ -192,7 +197,7 @@ ResourceAllocatorManager::ResourceAllocatorManager(Device* device) : mDevice(dev
         mPooledHeapAllocators[i] =
             std::make_unique<PooledResourceMemoryAllocator>(mHeapAllocators[i].get());
         mSubAllocatedResourceAllocators[i] = std::make_unique<BuddyMemoryAllocator>(
-            kMaxHeapSize, kMinHeapSize, mPooledHeapAllocators[i].get());
+            kMaxHeapSize, minHeapSize, mPooledHeapAllocators[i].get());
     }
 }
 
@@ -282,6 +287,24 @@ void ResourceAllocatorManager::FreeMemory(ResourceHeapAllocation& allocation) {
     const size_t resourceHeapKindIndex = GetResourceHeapKind(
         resourceDescriptor.Dimension, heapProp.Type, resourceDescriptor.Flags, mResourceHeapTier);
 
+    // Small buffer blocks are recycled through a size-class freelist rather than being merged
+    // back into the buddy system, making the common alloc/free pattern O(1). The cached entry
+    // keeps the underlying heap refcounted by the buddy allocator until the freelist is
+    // flushed. Note the allocation must be re-classified from the resource descriptor exactly
+    // as in CreatePlacedResource since AllocationInfo does not record the block size.
+    if (resourceDescriptor.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) {
+        const D3D12_RESOURCE_ALLOCATION_INFO resourceInfo =
+            mDevice->GetD3D12Device()->GetResourceAllocationInfo(0, 1, &resourceDescriptor);
+        std::vector<ResourceMemoryAllocation>* freeList =
+            GetSmallBufferFreeList(resourceDescriptor, resourceInfo, resourceHeapKindIndex);
+        if (freeList != nullptr && freeList->size() < kMaxFreeListEntriesPerSizeClass) {
+            freeList->push_back(
+                ResourceMemoryAllocation{allocation.GetInfo(), allocation.GetOffset(),
+                                         allocation.GetResourceHeap()});
+            return;
+        }
+    }
+
     mSubAllocatedResourceAllocators[resourceHeapKindIndex]->Deallocate(allocation);
 }
 
@@ -325,6 +348,24 @@ ResultOrError<ResourceHeapAllocation> ResourceAllocatorManager::CreatePlacedReso
             "Resource allocation size (%u) was invalid.", resourceInfo.SizeInBytes));
     }
 
+    // Satisfy small buffer requests from the matching size-class freelist when possible. This
+    // avoids the O(log n) buddy block split entirely for the most frequent allocations.
+    std::vector<ResourceMemoryAllocation>* freeList = GetSmallBufferFreeList(
+        resourceDescriptor, resourceInfo, static_cast<size_t>(resourceHeapKind));
+    if (freeList != nullptr && !freeList->empty()) {
+        ResourceMemoryAllocation cachedAllocation = freeList->back();
+        freeList->pop_back();
+
+        Heap* heap = ToBackend(cachedAllocation.GetResourceHeap());
+
+        ComPtr<ID3D12Resource> placedResource;
+        DAWN_TRY_ASSIGN(placedResource, CreatePlacedResourceInHeap(
+                                            heap, cachedAllocation.GetOffset(), resourceDescriptor,
+                                            optimizedClearValue, initialUsage));
+        return ResourceHeapAllocation{cachedAllocation.GetInfo(), cachedAllocation.GetOffset(),
+                                      std::move(placedResource), heap};
+    }
+
     BuddyMemoryAllocator* allocator =
         mSubAllocatedResourceAllocators[static_cast<size_t>(resourceHeapKind)].get();
 
@@ -463,7 +504,43 @@ uint64_t ResourceAllocatorManager::GetResourcePadding(
     }
     return 0;
 }
+
+std::vector<ResourceMemoryAllocation>* ResourceAllocatorManager::GetSmallBufferFreeList(
+    const D3D12_RESOURCE_DESC& resourceDescriptor,
+    const D3D12_RESOURCE_ALLOCATION_INFO& resourceInfo,
+    size_t resourceHeapKindIndex) {
+    // Only buffers are eligible: their allocation sizes are always a multiple of the default
+    // 64KB placement alignment, so a handful of power-of-two classes covers every small
+    // request exactly. Textures have a much wider spread of sizes and alignments and would
+    // mostly miss the cache.
+    if (resourceDescriptor.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER ||
+        resourceInfo.Alignment != D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT) {
+        return nullptr;
+    }
+
+    // The buddy allocator rounds the allocation to the next power of two, so classifying by
+    // the rounded size guarantees a cached block always fits the request that maps to it.
+    const uint64_t blockSize = NextPowerOfTwo(resourceInfo.SizeInBytes);
+    if (blockSize < kMinSizeClassBlockSize || blockSize > kMaxSizeClassBlockSize) {
+        return nullptr;
+    }
+
+    const size_t sizeClassIndex = Log2(blockSize) - kMinSizeClassShift;
+    return &mSmallBufferFreeLists[resourceHeapKindIndex][sizeClassIndex];
+}
+
 void ResourceAllocatorManager::DestroyPool() {
+    // Release the cached small buffer blocks back to their buddy allocators first so the heaps
+    // they were keeping alive become eligible for pool destruction below.
+    for (uint32_t i = 0; i < ResourceHeapKind::EnumCount; i++) {
+        for (std::vector<ResourceMemoryAllocation>& freeList : mSmallBufferFreeLists[i]) {
+            for (ResourceMemoryAllocation& allocation : freeList) {
+                mSubAllocatedResourceAllocators[i]->Deallocate(allocation);
+            }
+            freeList.clear();
+        }
+    }
+
     for (auto& alloc : mPooledHeapAllocators) {
         alloc->DestroyPool();
     }
@@ -17,6 +17,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include "dawn/common/SerialQueue.h"
 #include "dawn/native/BuddyMemoryAllocator.h"
@@ -95,16 +96,37 @@ class ResourceAllocatorManager {
 
     uint64_t GetResourcePadding(const D3D12_RESOURCE_DESC& resourceDescriptor) const;
 
+    std::vector<ResourceMemoryAllocation>* GetSmallBufferFreeList(
+        const D3D12_RESOURCE_DESC& resourceDescriptor,
+        const D3D12_RESOURCE_ALLOCATION_INFO& resourceInfo,
+        size_t resourceHeapKindIndex);
+
     Device* mDevice;
     uint32_t mResourceHeapTier;
 
     static constexpr uint64_t kMaxHeapSize = 32ll * 1024ll * 1024ll * 1024ll;  // 32GB
-    static constexpr uint64_t kMinHeapSize = 4ll * 1024ll * 1024ll;            // 4MB
+    // The smallest heap the buddy allocators create comes from the adapter's tuning profile.
+
+    // Small buffer allocations are extremely frequent and all get rounded up to D3D12's 64KB
+    // placement alignment, so freed buddy blocks between 64KB and 1MB are kept in size-class
+    // freelists and reused in O(1) instead of being merged back into the buddy system.
+    static constexpr uint64_t kMinSizeClassShift = 16;  // 64KB
+    static constexpr uint64_t kMaxSizeClassShift = 20;  // 1MB
+    static constexpr size_t kNumSizeClasses = kMaxSizeClassShift - kMinSizeClassShift + 1;
+    static constexpr uint64_t kMinSizeClassBlockSize = 1ull << kMinSizeClassShift;
+    static constexpr uint64_t kMaxSizeClassBlockSize = 1ull << kMaxSizeClassShift;
+
+    // Bounds how much memory an idle size class may keep pinned.
+    static constexpr size_t kMaxFreeListEntriesPerSizeClass = 32;
 
     std::array<std::unique_ptr<BuddyMemoryAllocator>, ResourceHeapKind::EnumCount>
         mSubAllocatedResourceAllocators;
     std::array<std::unique_ptr<HeapAllocator>, ResourceHeapKind::EnumCount> mHeapAllocators;
 
+    std::array<std::array<std::vector<ResourceMemoryAllocation>, kNumSizeClasses>,
+               ResourceHeapKind::EnumCount>
+        mSmallBufferFreeLists;
+
     std::array<std::unique_ptr<PooledResourceMemoryAllocator>, ResourceHeapKind::EnumCount>
         mPooledHeapAllocators;
 
@@ -43,7 +43,7 @@ class StagingDescriptorAllocator;
 class ShaderVisibleDescriptorAllocator;
 
 // Wraps sampler descriptor heap allocations in a cache.
-class SamplerHeapCacheEntry : public RefCounted {
+class SamplerHeapCacheEntry final : public RefCounted {
   public:
     SamplerHeapCacheEntry() = default;
     explicit SamplerHeapCacheEntry(std::vector<Sampler*> samplers);
@@ -61,7 +61,7 @@ class ShaderModule final : public ShaderModuleBase {
     ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor);
     ~ShaderModule() override = default;
     MaybeError Initialize(ShaderModuleParseResult* parseResult,
-                          OwnedCompilationMessages* compilationMessages);
+                          OwnedCompilationMessages* compilationMessages) override;
 };
 
 }  // namespace dawn::native::d3d12
@@ -18,10 +18,12 @@
 #include <limits>
 #include <utility>
 
+#include "dawn/native/PerformanceTuning.h"
 #include "dawn/native/d3d12/D3D12Error.h"
 #include "dawn/native/d3d12/DeviceD3D12.h"
 #include "dawn/native/d3d12/GPUDescriptorHeapAllocationD3D12.h"
 #include "dawn/native/d3d12/ResidencyManagerD3D12.h"
+#include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native::d3d12 {
 
@@ -32,38 +34,42 @@ namespace dawn::native::d3d12 {
 // and low precision at big integer.
 static constexpr const uint32_t kShaderVisibleSmallHeapSizes[] = {32, 16};
 
-uint32_t GetD3D12ShaderVisibleHeapMinSize(D3D12_DESCRIPTOR_HEAP_TYPE heapType, bool useSmallSize) {
+uint32_t GetD3D12ShaderVisibleHeapMaxSize(D3D12_DESCRIPTOR_HEAP_TYPE heapType, bool useSmallSize) {
     if (useSmallSize) {
         return kShaderVisibleSmallHeapSizes[heapType];
     }
 
-    // Minimum heap size must be large enough to satisfy the largest descriptor allocation
-    // request and to amortize the cost of sub-allocation. But small enough to avoid wasting
-    // memory should only a tiny fraction ever be used.
-    // TODO(dawn:155): Figure out these values.
     switch (heapType) {
         case D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV:
-            return 4096;
+            return D3D12_MAX_SHADER_VISIBLE_DESCRIPTOR_HEAP_SIZE_TIER_1;
         case D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER:
-            return 256;
+            return D3D12_MAX_SHADER_VISIBLE_SAMPLER_HEAP_SIZE;
         default:
             UNREACHABLE();
     }
 }
 
-uint32_t GetD3D12ShaderVisibleHeapMaxSize(D3D12_DESCRIPTOR_HEAP_TYPE heapType, bool useSmallSize) {
-    if (useSmallSize) {
+// Initial size of a shader-visible heap, taken from the adapter's tuning profile unless the
+// small-heap testing toggle pins it. The heap still grows on demand up to
+// GetD3D12ShaderVisibleHeapMaxSize.
+static uint32_t GetInitialShaderVisibleHeapSize(Device* device,
+                                                D3D12_DESCRIPTOR_HEAP_TYPE heapType) {
+    if (device->IsToggleEnabled(Toggle::UseD3D12SmallShaderVisibleHeapForTesting)) {
         return kShaderVisibleSmallHeapSizes[heapType];
     }
 
+    uint32_t size;
     switch (heapType) {
         case D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV:
-            return D3D12_MAX_SHADER_VISIBLE_DESCRIPTOR_HEAP_SIZE_TIER_1;
+            size = device->GetTuningProfile().d3d12ViewShaderVisibleHeapSize;
+            break;
         case D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER:
-            return D3D12_MAX_SHADER_VISIBLE_SAMPLER_HEAP_SIZE;
+            size = device->GetTuningProfile().d3d12SamplerShaderVisibleHeapSize;
+            break;
         default:
             UNREACHABLE();
     }
+    return std::min(size, GetD3D12ShaderVisibleHeapMaxSize(heapType, false));
 }
 
 D3D12_DESCRIPTOR_HEAP_FLAGS GetD3D12HeapFlags(D3D12_DESCRIPTOR_HEAP_TYPE heapType) {
@@ -91,9 +97,7 @@ ShaderVisibleDescriptorAllocator::ShaderVisibleDescriptorAllocator(
     : mHeapType(heapType),
       mDevice(device),
       mSizeIncrement(device->GetD3D12Device()->GetDescriptorHandleIncrementSize(heapType)),
-      mDescriptorCount(GetD3D12ShaderVisibleHeapMinSize(
-          heapType,
-          mDevice->IsToggleEnabled(Toggle::UseD3D12SmallShaderVisibleHeapForTesting))),
+      mDescriptorCount(GetInitialShaderVisibleHeapSize(device, heapType)),
       mResidencyManagementEnabled(device->IsToggleEnabled(Toggle::UseD3D12ResidencyManagement)) {
     ASSERT(heapType == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV ||
            heapType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
@@ -109,6 +113,8 @@ bool ShaderVisibleDescriptorAllocator::AllocateGPUDescriptors(
     if (startOffset == RingBufferAllocator::kInvalidOffset) {
         return false;
     }
+    dawn::platform::AddMetric(dawn::platform::MetricCounter::DescriptorsAllocated,
+                              descriptorCount);
 
     ID3D12DescriptorHeap* descriptorHeap = mHeap->GetD3D12DescriptorHeap();
 
@@ -182,12 +188,30 @@ MaybeError ShaderVisibleDescriptorAllocator::AllocateAndSwitchShaderVisibleHeap(
     // The first phase increasingly grows a small heap in binary sizes for light users while the
     // second phase pool-allocates largest sized heaps for heavy users.
     if (mHeap != nullptr) {
+        const uint32_t maxDescriptorCount = GetD3D12ShaderVisibleHeapMaxSize(
+            mHeapType, mDevice->IsToggleEnabled(Toggle::UseD3D12SmallShaderVisibleHeapForTesting));
+
+        // Once the heap has reached its maximum size, prefer reclaiming ring space the GPU has
+        // already retired over switching heaps: a switch invalidates every previously
+        // allocated GPU descriptor and forces all bind groups to re-populate. In steady state
+        // the regions sub-allocated for earlier serials retire every frame, so the
+        // maximum-size heap is kept and rollover never happens.
+        if (mDescriptorCount >= maxDescriptorCount) {
+            const uint64_t usedSizeBefore = mAllocator.GetUsedSize();
+            DAWN_TRY(mDevice->CheckPassedSerials());
+            mAllocator.Deallocate(mDevice->GetCompletedCommandSerial());
+            if (mAllocator.GetUsedSize() < usedSizeBefore) {
+                // The heap serial is deliberately left unchanged so existing bind group
+                // allocations stay valid. The caller retries allocation against the same heap
+                // and only switches for real if the ring is still full of in-flight regions.
+                return {};
+            }
+        }
+
         if (mResidencyManagementEnabled) {
             mDevice->GetResidencyManager()->UnlockHeap(mHeap->GetHeap());
         }
 
-        const uint32_t maxDescriptorCount = GetD3D12ShaderVisibleHeapMaxSize(
-            mHeapType, mDevice->IsToggleEnabled(Toggle::UseD3D12SmallShaderVisibleHeapForTesting));
         if (mDescriptorCount < maxDescriptorCount) {
             // Phase #1. Grow the heaps in powers-of-two.
             mDevice->ReferenceUntilUnused(mHeap->GetD3D12DescriptorHeap());
@@ -227,6 +251,14 @@ MaybeError ShaderVisibleDescriptorAllocator::AllocateAndSwitchShaderVisibleHeap(
     return {};
 }
 
+uint64_t ShaderVisibleDescriptorAllocator::GetHeapSizeInBytes() const {
+    return mAllocator.GetSize() * mSizeIncrement;
+}
+
+uint64_t ShaderVisibleDescriptorAllocator::GetHeapUsedSizeInBytes() const {
+    return mAllocator.GetUsedSize() * mSizeIncrement;
+}
+
 HeapVersionID ShaderVisibleDescriptorAllocator::GetShaderVisibleHeapSerialForTesting() const {
     return mHeapSerial;
 }
@@ -67,6 +67,11 @@ class ShaderVisibleDescriptorAllocator {
     ID3D12DescriptorHeap* GetShaderVisibleHeap() const;
     MaybeError AllocateAndSwitchShaderVisibleHeap();
 
+    // Size in bytes of the active shader-visible heap and of the descriptors allocated from
+    // it, see DeviceBase::GetMemoryReport.
+    uint64_t GetHeapSizeInBytes() const;
+    uint64_t GetHeapUsedSizeInBytes() const;
+
     // For testing purposes only.
     HeapVersionID GetShaderVisibleHeapSerialForTesting() const;
     uint64_t GetShaderVisibleHeapSizeForTesting() const;
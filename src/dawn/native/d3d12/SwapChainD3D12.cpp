@@ -17,6 +17,7 @@
 #include <windows.ui.xaml.media.dxinterop.h>
 
 #include <utility>
+#include <vector>
 
 #include "dawn/dawn_wsi.h"
 #include "dawn/native/Surface.h"
@@ -48,7 +49,10 @@ uint32_t PresentModeToSwapInterval(wgpu::PresentMode mode) {
 }
 
 UINT PresentModeToSwapChainFlags(wgpu::PresentMode mode) {
-    UINT flags = DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH;
+    // The frame latency waitable object is what implements frame pacing, see
+    // SwapChain::WaitForFrameLatencyImpl. It is harmless when the wait is never used.
+    UINT flags =
+        DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH | DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
 
     if (mode == wgpu::PresentMode::Immediate) {
         flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
@@ -183,11 +187,13 @@ MaybeError SwapChain::Initialize(NewSwapChainBase* previousSwapChain) {
                     "D3D12 SwapChain cannot switch between D3D Devices");
 
     // The previous swapchain is on the same device so we want to reuse it but it is still not
-    // always possible. Because DXGI requires that a new swapchain be created if the
-    // DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING flag is changed.
+    // always possible. DXGI requires that a new swapchain be created if the
+    // DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING flag is changed, and IDXGISwapChain::ResizeBuffers
+    // cannot change the DXGI_USAGE the buffers were created with.
     bool canReuseSwapChain =
         ((mConfig.swapChainFlags ^ previousD3D12SwapChain->mConfig.swapChainFlags) &
-         DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING) == 0;
+         DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING) == 0 &&
+        mConfig.usage == previousD3D12SwapChain->mConfig.usage;
 
     // We can't reuse the previous swapchain, so we destroy it and wait for all of its reference
     // to be forgotten (otherwise DXGI complains that there are outstanding references).
@@ -199,6 +205,9 @@ MaybeError SwapChain::Initialize(NewSwapChainBase* previousSwapChain) {
     // After all this we know we can reuse the swapchain, see if it is possible to also reuse
     // the buffers.
     mDXGISwapChain = std::move(previousD3D12SwapChain->mDXGISwapChain);
+    mFrameLatencyWaitableObject = previousD3D12SwapChain->mFrameLatencyWaitableObject;
+    previousD3D12SwapChain->mFrameLatencyWaitableObject = nullptr;
+    DAWN_TRY(SetMaximumFrameLatencyImpl(GetMaximumFrameLatency()));
 
     bool canReuseBuffers = GetWidth() == previousSwapChain->GetWidth() &&
                            GetHeight() == previousSwapChain->GetHeight() &&
@@ -284,6 +293,9 @@ MaybeError SwapChain::InitializeSwapChainFromScratch() {
 
     DAWN_TRY(CheckHRESULT(swapChain1.As(&mDXGISwapChain), "Gettting IDXGISwapChain1"));
 
+    DAWN_TRY(SetMaximumFrameLatencyImpl(GetMaximumFrameLatency()));
+    mFrameLatencyWaitableObject = mDXGISwapChain->GetFrameLatencyWaitableObject();
+
     return CollectSwapChainBuffers();
 }
 
@@ -315,8 +327,32 @@ MaybeError SwapChain::PresentImpl() {
     DAWN_TRY(device->ExecutePendingCommandContext());
 
     // Do the actual present. DXGI_STATUS_OCCLUDED is a valid return value that's just a
-    // message to the application that it could stop rendering.
-    HRESULT presentResult = mDXGISwapChain->Present(PresentModeToSwapInterval(GetPresentMode()), 0);
+    // message to the application that it could stop rendering. When a damage hint was set,
+    // forward it as Present1 dirty rects so DWM only recomposes the changed regions.
+    HRESULT presentResult;
+    const std::vector<PresentDamageRect>& damage = GetNextPresentDamage();
+    if (!damage.empty()) {
+        std::vector<RECT> dirtyRects;
+        dirtyRects.reserve(damage.size());
+        for (const PresentDamageRect& rect : damage) {
+            RECT dirtyRect;
+            dirtyRect.left = rect.x;
+            dirtyRect.top = rect.y;
+            dirtyRect.right = rect.x + rect.width;
+            dirtyRect.bottom = rect.y + rect.height;
+            dirtyRects.push_back(dirtyRect);
+        }
+
+        DXGI_PRESENT_PARAMETERS presentParams;
+        presentParams.DirtyRectsCount = static_cast<UINT>(dirtyRects.size());
+        presentParams.pDirtyRects = dirtyRects.data();
+        presentParams.pScrollRect = nullptr;
+        presentParams.pScrollOffset = nullptr;
+        presentResult = mDXGISwapChain->Present1(PresentModeToSwapInterval(GetPresentMode()), 0,
+                                                 &presentParams);
+    } else {
+        presentResult = mDXGISwapChain->Present(PresentModeToSwapInterval(GetPresentMode()), 0);
+    }
     if (presentResult != DXGI_STATUS_OCCLUDED) {
         DAWN_TRY(CheckHRESULT(presentResult, "IDXGISwapChain::Present"));
     }
@@ -348,6 +384,39 @@ ResultOrError<Ref<TextureViewBase>> SwapChain::GetCurrentTextureViewImpl() {
     return mApiTexture->CreateView();
 }
 
+MaybeError SwapChain::SetMaximumFrameLatencyImpl(uint32_t maxLatency) {
+    return CheckHRESULT(mDXGISwapChain->SetMaximumFrameLatency(maxLatency),
+                        "IDXGISwapChain2::SetMaximumFrameLatency");
+}
+
+MaybeError SwapChain::WaitForFrameLatencyImpl() {
+    ASSERT(mFrameLatencyWaitableObject != nullptr);
+
+    // Block until the presentation engine has fewer than the maximum frame latency presents
+    // queued. The timeout only guards against a wedged compositor.
+    static constexpr DWORD kWaitTimeoutMs = 1000;
+    DWORD result = WaitForSingleObjectEx(mFrameLatencyWaitableObject, kWaitTimeoutMs, false);
+    DAWN_INVALID_IF(result == WAIT_FAILED, "Waiting on the frame latency waitable object failed.");
+    return {};
+}
+
+ResultOrError<uint64_t> SwapChain::GetLastFlipTimeImpl() {
+    DXGI_FRAME_STATISTICS stats;
+    HRESULT hr = mDXGISwapChain->GetFrameStatistics(&stats);
+    if (hr == DXGI_ERROR_FRAME_STATISTICS_DISJOINT || stats.SyncQPCTime.QuadPart == 0) {
+        // No complete frame has flipped yet (or the statistics got reset by a mode change).
+        return uint64_t(0);
+    }
+    DAWN_TRY(CheckHRESULT(hr, "IDXGISwapChain::GetFrameStatistics"));
+
+    // Convert the QPC timestamp of the last sync to nanoseconds.
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    double seconds = static_cast<double>(stats.SyncQPCTime.QuadPart) /
+                     static_cast<double>(frequency.QuadPart);
+    return static_cast<uint64_t>(seconds * 1e9);
+}
+
 MaybeError SwapChain::DetachAndWaitForDeallocation() {
     DetachFromSurface();
 
@@ -367,6 +436,10 @@ void SwapChain::DetachFromSurfaceImpl() {
         mApiTexture = nullptr;
     }
 
+    if (mFrameLatencyWaitableObject != nullptr) {
+        CloseHandle(mFrameLatencyWaitableObject);
+        mFrameLatencyWaitableObject = nullptr;
+    }
     mDXGISwapChain = nullptr;
     mBuffers.clear();
 }
@@ -67,6 +67,9 @@ class SwapChain final : public NewSwapChainBase {
     MaybeError PresentImpl() override;
     ResultOrError<Ref<TextureViewBase>> GetCurrentTextureViewImpl() override;
     void DetachFromSurfaceImpl() override;
+    MaybeError SetMaximumFrameLatencyImpl(uint32_t maxLatency) override;
+    MaybeError WaitForFrameLatencyImpl() override;
+    ResultOrError<uint64_t> GetLastFlipTimeImpl() override;
 
     // Does the swapchain initialization steps assuming there is nothing we can reuse.
     MaybeError InitializeSwapChainFromScratch();
@@ -79,6 +82,7 @@ class SwapChain final : public NewSwapChainBase {
     Config mConfig;
 
     ComPtr<IDXGISwapChain3> mDXGISwapChain;
+    HANDLE mFrameLatencyWaitableObject = nullptr;
     std::vector<ComPtr<ID3D12Resource>> mBuffers;
     std::vector<ExecutionSerial> mBufferLastUsedSerials;
     uint32_t mCurrentBuffer = 0;
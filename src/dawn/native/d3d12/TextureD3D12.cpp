@@ -15,6 +15,7 @@
 #include "dawn/native/d3d12/TextureD3D12.h"
 
 #include <algorithm>
+#include <array>
 #include <utility>
 
 #include "dawn/common/Constants.h"
@@ -32,21 +33,43 @@
 #include "dawn/native/d3d12/StagingBufferD3D12.h"
 #include "dawn/native/d3d12/StagingDescriptorAllocatorD3D12.h"
 #include "dawn/native/d3d12/TextureCopySplitter.h"
+#include "dawn/native/d3d12/TransientAttachmentAllocatorD3D12.h"
 #include "dawn/native/d3d12/UtilsD3D12.h"
 
 namespace dawn::native::d3d12 {
 
 namespace {
 
-D3D12_RESOURCE_STATES D3D12TextureUsage(wgpu::TextureUsage usage, const Format& format) {
-    D3D12_RESOURCE_STATES resourceState = D3D12_RESOURCE_STATE_COMMON;
+// The usage-to-state conversion runs per subresource per barrier, so it is precomputed into
+// lookup tables over the barrier-relevant usage combinations: the five API usage bits with
+// kReadOnlyRenderAttachment folded in next to them. Present is special-cased before the lookup
+// (it is never combined with other usages) and the remaining internal bits do not affect
+// barriers, matching the per-bit checks the tables are built from.
+constexpr uint32_t kApiTextureUsageMask = 0x1F;
+constexpr uint32_t kReadOnlyRenderAttachmentIndexBit = 0x20;
+constexpr uint32_t kTextureUsageIndexCount = 0x40;
+
+constexpr uint32_t TextureUsageIndex(wgpu::TextureUsage usage) {
+    uint32_t index = static_cast<uint32_t>(usage) & kApiTextureUsageMask;
+    if (usage & kReadOnlyRenderAttachment) {
+        index |= kReadOnlyRenderAttachmentIndexBit;
+    }
+    return index;
+}
 
-    if (usage & kPresentTextureUsage) {
-        // The present usage is only used internally by the swapchain and is never used in
-        // combination with other usages.
-        ASSERT(usage == kPresentTextureUsage);
-        return D3D12_RESOURCE_STATE_PRESENT;
+constexpr wgpu::TextureUsage TextureUsageFromIndex(uint32_t index) {
+    wgpu::TextureUsage usage = static_cast<wgpu::TextureUsage>(index & kApiTextureUsageMask);
+    if (index & kReadOnlyRenderAttachmentIndexBit) {
+        usage = usage | kReadOnlyRenderAttachment;
     }
+    return usage;
+}
+
+constexpr D3D12_RESOURCE_STATES ComputeD3D12TextureUsage(wgpu::TextureUsage usage,
+                                                         bool hasDepthOrStencil) {
+    // Accumulated as an integer because the SDK's flag operators for D3D12_RESOURCE_STATES are
+    // not guaranteed to be constexpr.
+    uint32_t resourceState = D3D12_RESOURCE_STATE_COMMON;
 
     if (usage & wgpu::TextureUsage::CopySrc) {
         resourceState |= D3D12_RESOURCE_STATE_COPY_SOURCE;
@@ -55,14 +78,14 @@ D3D12_RESOURCE_STATES D3D12TextureUsage(wgpu::TextureUsage usage, const Format&
         resourceState |= D3D12_RESOURCE_STATE_COPY_DEST;
     }
     if (usage & (wgpu::TextureUsage::TextureBinding)) {
-        resourceState |= (D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE |
-                          D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+        resourceState |= D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+        resourceState |= D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
     }
     if (usage & wgpu::TextureUsage::StorageBinding) {
         resourceState |= D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
     }
     if (usage & wgpu::TextureUsage::RenderAttachment) {
-        if (format.HasDepthOrStencil()) {
+        if (hasDepthOrStencil) {
             resourceState |= D3D12_RESOURCE_STATE_DEPTH_WRITE;
         } else {
             resourceState |= D3D12_RESOURCE_STATE_RENDER_TARGET;
@@ -74,7 +97,31 @@ D3D12_RESOURCE_STATES D3D12TextureUsage(wgpu::TextureUsage usage, const Format&
         resourceState |= D3D12_RESOURCE_STATE_DEPTH_READ;
     }
 
-    return resourceState;
+    return static_cast<D3D12_RESOURCE_STATES>(resourceState);
+}
+
+constexpr std::array<D3D12_RESOURCE_STATES, kTextureUsageIndexCount> MakeD3D12TextureUsageTable(
+    bool hasDepthOrStencil) {
+    std::array<D3D12_RESOURCE_STATES, kTextureUsageIndexCount> table{};
+    for (uint32_t i = 0; i < kTextureUsageIndexCount; ++i) {
+        table[i] = ComputeD3D12TextureUsage(TextureUsageFromIndex(i), hasDepthOrStencil);
+    }
+    return table;
+}
+
+constexpr auto kColorTextureUsageTable = MakeD3D12TextureUsageTable(false);
+constexpr auto kDepthStencilTextureUsageTable = MakeD3D12TextureUsageTable(true);
+
+D3D12_RESOURCE_STATES D3D12TextureUsage(wgpu::TextureUsage usage, const Format& format) {
+    if (usage & kPresentTextureUsage) {
+        // The present usage is only used internally by the swapchain and is never used in
+        // combination with other usages.
+        ASSERT(usage == kPresentTextureUsage);
+        return D3D12_RESOURCE_STATE_PRESENT;
+    }
+
+    return format.HasDepthOrStencil() ? kDepthStencilTextureUsageTable[TextureUsageIndex(usage)]
+                                      : kColorTextureUsageTable[TextureUsageIndex(usage)];
 }
 
 D3D12_RESOURCE_FLAGS D3D12ResourceFlags(wgpu::TextureUsage usage, const Format& format) {
@@ -604,9 +651,22 @@ MaybeError Texture::InitializeAsInternalTexture() {
     resourceDescriptor.Flags = D3D12ResourceFlags(GetInternalUsage(), GetFormat());
     mD3D12ResourceFlags = resourceDescriptor.Flags;
 
-    DAWN_TRY_ASSIGN(mResourceAllocation,
-                    device->AllocateMemory(D3D12_HEAP_TYPE_DEFAULT, resourceDescriptor,
-                                           D3D12_RESOURCE_STATE_COMMON));
+    if (GetInternalUsage() & kTransientAttachment) {
+        // Transient attachment contents never outlive their render pass, so their memory is
+        // placed in heaps that alias each other across passes rather than going through the
+        // general allocator.
+        TransientAttachmentAllocator::Allocation allocation;
+        DAWN_TRY_ASSIGN(allocation, device->GetTransientAttachmentAllocator()->Allocate(
+                                        resourceDescriptor, D3D12_RESOURCE_STATE_COMMON));
+        mTransientResource = std::move(allocation.resource);
+        mTransientHeap = std::move(allocation.heap);
+        mTransientHeapSize = allocation.heapSize;
+        mPendingAliasingBarrier = allocation.requiresAliasingBarrier;
+    } else {
+        DAWN_TRY_ASSIGN(mResourceAllocation,
+                        device->AllocateMemory(D3D12_HEAP_TYPE_DEFAULT, resourceDescriptor,
+                                               D3D12_RESOURCE_STATE_COMMON));
+    }
 
     SetLabelImpl();
 
@@ -663,7 +723,16 @@ void Texture::DestroyImpl() {
         }
     }
 
-    device->DeallocateMemory(std::move(mResourceAllocation));
+    if (mTransientHeap != nullptr) {
+        // The placed resource may still be referenced by in-flight commands, but the heap can
+        // back the next transient attachment right away: queue ordering makes the aliasing
+        // well-defined and the new resource records an aliasing barrier before its first use.
+        device->ReferenceUntilUnused(std::move(mTransientResource));
+        device->GetTransientAttachmentAllocator()->Free(std::move(mTransientHeap),
+                                                        mTransientHeapSize);
+    } else {
+        device->DeallocateMemory(std::move(mResourceAllocation));
+    }
 
     // Now that we've deallocated the memory, the texture is no longer a swap chain texture.
     // We can set mSwapChainTexture to false to avoid passing a nullptr to
@@ -694,6 +763,9 @@ DXGI_FORMAT Texture::GetD3D12Format() const {
 }
 
 ID3D12Resource* Texture::GetD3D12Resource() const {
+    if (mTransientResource != nullptr) {
+        return mTransientResource.Get();
+    }
     if (mResourceAllocation == nullptr) {
         return nullptr;
     }
@@ -768,7 +840,8 @@ void Texture::TrackAllUsageAndTransitionNow(CommandRecordingContext* commandCont
 void Texture::TrackUsageAndTransitionNow(CommandRecordingContext* commandContext,
                                          D3D12_RESOURCE_STATES newState,
                                          const SubresourceRange& range) {
-    if (GetTextureState() != TextureState::OwnedExternal) {
+    // Transient attachments live in raw heaps that are not residency-managed.
+    if (GetTextureState() != TextureState::OwnedExternal && mResourceAllocation != nullptr) {
         // Track the underlying heap to ensure residency.
         commandContext->GetResidencyList()->Add(mResourceAllocation->GetMemory());
     }
@@ -894,6 +967,22 @@ void Texture::TransitionSubresourceRange(std::vector<D3D12_RESOURCE_BARRIER>* ba
     state->isValidToDecay = false;
 }
 
+void Texture::AppendAliasingBarrierIfNeeded(std::vector<D3D12_RESOURCE_BARRIER>* barriers) {
+    if (!mPendingAliasingBarrier) {
+        return;
+    }
+    // The heap backing this texture previously backed another transient attachment. D3D12
+    // requires an aliasing barrier between accesses to placed resources that share memory.
+    // A null pResourceBefore covers any resource previously placed in the heap.
+    D3D12_RESOURCE_BARRIER barrier;
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+    barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+    barrier.Aliasing.pResourceBefore = nullptr;
+    barrier.Aliasing.pResourceAfter = GetD3D12Resource();
+    barriers->push_back(barrier);
+    mPendingAliasingBarrier = false;
+}
+
 void Texture::HandleTransitionSpecialCases(CommandRecordingContext* commandContext) {
     // Externally allocated textures can be written from other graphics queues. Hence, they must be
     // acquired before command list submission to ensure work from the other queues has finished.
@@ -916,6 +1005,7 @@ void Texture::TransitionUsageAndGetResourceBarrier(CommandRecordingContext* comm
                                                    D3D12_RESOURCE_STATES newState,
                                                    const SubresourceRange& range) {
     HandleTransitionSpecialCases(commandContext);
+    AppendAliasingBarrierIfNeeded(barriers);
 
     const ExecutionSerial pendingCommandSerial = ToBackend(GetDevice())->GetPendingCommandSerial();
 
@@ -928,12 +1018,14 @@ void Texture::TransitionUsageAndGetResourceBarrier(CommandRecordingContext* comm
 void Texture::TrackUsageAndGetResourceBarrierForPass(CommandRecordingContext* commandContext,
                                                      std::vector<D3D12_RESOURCE_BARRIER>* barriers,
                                                      const TextureSubresourceUsage& textureUsages) {
-    // Track the underlying heap to ensure residency.
-    if (GetTextureState() != TextureState::OwnedExternal) {
+    // Track the underlying heap to ensure residency. Transient attachments live in raw heaps
+    // that are not residency-managed.
+    if (GetTextureState() != TextureState::OwnedExternal && mResourceAllocation != nullptr) {
         commandContext->GetResidencyList()->Add(mResourceAllocation->GetMemory());
     }
 
     HandleTransitionSpecialCases(commandContext);
+    AppendAliasingBarrierIfNeeded(barriers);
 
     const ExecutionSerial pendingCommandSerial = ToBackend(GetDevice())->GetPendingCommandSerial();
 
@@ -1024,6 +1116,22 @@ D3D12_DEPTH_STENCIL_VIEW_DESC Texture::GetDSVDescriptor(uint32_t mipLevel,
     return dsvDesc;
 }
 
+D3D12_RESOURCE_STATES Texture::GetStateForClear() const {
+    if ((mD3D12ResourceFlags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL) != 0) {
+        return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+    }
+    if ((mD3D12ResourceFlags & D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET) != 0) {
+        return D3D12_RESOURCE_STATE_RENDER_TARGET;
+    }
+    return D3D12_RESOURCE_STATE_COPY_DEST;
+}
+
+void Texture::TransitionForLazyClear(CommandRecordingContext* commandContext,
+                                     std::vector<D3D12_RESOURCE_BARRIER>* barriers,
+                                     const SubresourceRange& range) {
+    TransitionUsageAndGetResourceBarrier(commandContext, barriers, GetStateForClear(), range);
+}
+
 MaybeError Texture::ClearTexture(CommandRecordingContext* commandContext,
                                  const SubresourceRange& range,
                                  TextureBase::ClearValue clearValue) {
@@ -1034,9 +1142,10 @@ MaybeError Texture::ClearTexture(CommandRecordingContext* commandContext,
     uint8_t clearColor = (clearValue == TextureBase::ClearValue::Zero) ? 0 : 1;
     float fClearColor = (clearValue == TextureBase::ClearValue::Zero) ? 0.f : 1.f;
 
-    if ((mD3D12ResourceFlags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL) != 0) {
-        TrackUsageAndTransitionNow(commandContext, D3D12_RESOURCE_STATE_DEPTH_WRITE, range);
+    // This is a no-op when the transition was already batched by TransitionForLazyClear.
+    TrackUsageAndTransitionNow(commandContext, GetStateForClear(), range);
 
+    if ((mD3D12ResourceFlags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL) != 0) {
         for (uint32_t level = range.baseMipLevel; level < range.baseMipLevel + range.levelCount;
              ++level) {
             for (uint32_t layer = range.baseArrayLayer;
@@ -1082,8 +1191,6 @@ MaybeError Texture::ClearTexture(CommandRecordingContext* commandContext,
             }
         }
     } else if ((mD3D12ResourceFlags & D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET) != 0) {
-        TrackUsageAndTransitionNow(commandContext, D3D12_RESOURCE_STATE_RENDER_TARGET, range);
-
         const float clearColorRGBA[4] = {fClearColor, fClearColor, fClearColor, fClearColor};
 
         ASSERT(range.aspects == Aspect::Color);
@@ -1121,8 +1228,6 @@ MaybeError Texture::ClearTexture(CommandRecordingContext* commandContext,
         ASSERT(!IsMultisampledTexture());
 
         // create temp buffer with clear color to copy to the texture image
-        TrackUsageAndTransitionNow(commandContext, D3D12_RESOURCE_STATE_COPY_DEST, range);
-
         for (Aspect aspect : IterateEnumMask(range.aspects)) {
             const TexelBlockInfo& blockInfo = GetFormat().GetAspectInfo(aspect).block;
 
@@ -1424,4 +1529,66 @@ D3D12_UNORDERED_ACCESS_VIEW_DESC TextureView::GetUAVDescriptor() const {
     return uavDesc;
 }
 
+TextureView::~TextureView() {
+    if (mCachedSRVAllocation.IsValid()) {
+        mStagingAllocator->Deallocate(&mCachedSRVAllocation);
+    }
+    if (mCachedUAVAllocation.IsValid()) {
+        mStagingAllocator->Deallocate(&mCachedUAVAllocation);
+    }
+}
+
+bool TextureView::GetOrCreateCachedSRV(D3D12_CPU_DESCRIPTOR_HANDLE* handleOut) {
+    if (!mCachedSRVAllocation.IsValid()) {
+        ID3D12Resource* resource = ToBackend(GetTexture())->GetD3D12Resource();
+        if (resource == nullptr) {
+            return false;
+        }
+
+        Device* device = ToBackend(GetTexture()->GetDevice());
+        StagingDescriptorAllocator* allocator = device->GetViewStagingDescriptorAllocator(1);
+        CPUDescriptorHeapAllocation allocation;
+        if (device->ConsumedError(allocator->AllocateCPUDescriptors(), &allocation)) {
+            // Running out of staging descriptors surfaces as a device error; creation is
+            // still not fatal here because the caller creates the view directly into its
+            // own table instead.
+            return false;
+        }
+
+        device->GetD3D12Device()->CreateShaderResourceView(resource, &mSrvDesc,
+                                                           allocation.GetBaseDescriptor());
+        mStagingAllocator = allocator;
+        mCachedSRVAllocation = allocation;
+    }
+    *handleOut = mCachedSRVAllocation.GetBaseDescriptor();
+    return true;
+}
+
+bool TextureView::GetOrCreateCachedUAV(D3D12_CPU_DESCRIPTOR_HANDLE* handleOut) {
+    if (!mCachedUAVAllocation.IsValid()) {
+        ID3D12Resource* resource = ToBackend(GetTexture())->GetD3D12Resource();
+        if (resource == nullptr) {
+            return false;
+        }
+
+        Device* device = ToBackend(GetTexture()->GetDevice());
+        StagingDescriptorAllocator* allocator = device->GetViewStagingDescriptorAllocator(1);
+        CPUDescriptorHeapAllocation allocation;
+        if (device->ConsumedError(allocator->AllocateCPUDescriptors(), &allocation)) {
+            // Running out of staging descriptors surfaces as a device error; creation is
+            // still not fatal here because the caller creates the view directly into its
+            // own table instead.
+            return false;
+        }
+
+        const D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = GetUAVDescriptor();
+        device->GetD3D12Device()->CreateUnorderedAccessView(resource, nullptr, &uavDesc,
+                                                            allocation.GetBaseDescriptor());
+        mStagingAllocator = allocator;
+        mCachedUAVAllocation = allocation;
+    }
+    *handleOut = mCachedUAVAllocation.GetBaseDescriptor();
+    return true;
+}
+
 }  // namespace dawn::native::d3d12
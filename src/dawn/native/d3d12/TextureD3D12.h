@@ -22,6 +22,7 @@
 #include "dawn/native/DawnNative.h"
 #include "dawn/native/IntegerTypes.h"
 #include "dawn/native/PassResourceUsage.h"
+#include "dawn/native/d3d12/CPUDescriptorHeapAllocationD3D12.h"
 #include "dawn/native/d3d12/IntegerTypes.h"
 #include "dawn/native/d3d12/ResourceHeapAllocationD3D12.h"
 #include "dawn/native/d3d12/d3d12_platform.h"
@@ -33,6 +34,7 @@ namespace dawn::native::d3d12 {
 class CommandRecordingContext;
 class Device;
 class D3D11on12ResourceCacheEntry;
+class StagingDescriptorAllocator;
 
 DXGI_FORMAT D3D12TextureFormat(wgpu::TextureFormat format);
 MaybeError ValidateD3D12TextureCanBeWrapped(ID3D12Resource* d3d12Resource,
@@ -82,6 +84,12 @@ class Texture final : public TextureBase {
     void TrackUsageAndGetResourceBarrierForPass(CommandRecordingContext* commandContext,
                                                 std::vector<D3D12_RESOURCE_BARRIER>* barrier,
                                                 const TextureSubresourceUsage& textureUsages);
+    // Records the barrier transitioning `range` to the state ClearTexture will use, so that the
+    // transitions for all the lazy clears of a pass can be submitted with one ResourceBarrier
+    // call before the clears themselves.
+    void TransitionForLazyClear(CommandRecordingContext* commandContext,
+                                std::vector<D3D12_RESOURCE_BARRIER>* barriers,
+                                const SubresourceRange& range);
     void TransitionUsageAndGetResourceBarrier(CommandRecordingContext* commandContext,
                                               std::vector<D3D12_RESOURCE_BARRIER>* barrier,
                                               wgpu::TextureUsage usage,
@@ -120,6 +128,9 @@ class Texture final : public TextureBase {
     MaybeError ClearTexture(CommandRecordingContext* commandContext,
                             const SubresourceRange& range,
                             TextureBase::ClearValue clearValue);
+    // The resource state ClearTexture records its clears in, which depends on how the
+    // resource can be cleared given its flags.
+    D3D12_RESOURCE_STATES GetStateForClear() const;
 
     // Barriers implementation details.
     struct StateAndDecay {
@@ -139,10 +150,19 @@ class Texture final : public TextureBase {
                                     D3D12_RESOURCE_STATES subresourceNewState,
                                     ExecutionSerial pendingCommandSerial) const;
     void HandleTransitionSpecialCases(CommandRecordingContext* commandContext);
+    void AppendAliasingBarrierIfNeeded(std::vector<D3D12_RESOURCE_BARRIER>* barriers);
 
     D3D12_RESOURCE_FLAGS mD3D12ResourceFlags;
     ComPtr<gpgmm::d3d12::ResourceAllocation> mResourceAllocation;
 
+    // Set for textures with the kTransientAttachment internal usage, which are placed in
+    // heaps recycled by the TransientAttachmentAllocator instead of going through the
+    // general allocator.
+    ComPtr<ID3D12Resource> mTransientResource;
+    ComPtr<ID3D12Heap> mTransientHeap;
+    uint64_t mTransientHeapSize = 0;
+    bool mPendingAliasingBarrier = false;
+
     // TODO(dawn:1460): Encapsulate imported image fields e.g. std::unique_ptr<ExternalImportInfo>.
     ComPtr<ID3D12Fence> mD3D12Fence;
     Ref<D3D11on12ResourceCacheEntry> mD3D11on12Resource;
@@ -164,10 +184,24 @@ class TextureView final : public TextureViewBase {
     D3D12_DEPTH_STENCIL_VIEW_DESC GetDSVDescriptor(bool depthReadOnly, bool stencilReadOnly) const;
     D3D12_UNORDERED_ACCESS_VIEW_DESC GetUAVDescriptor() const;
 
+    // Returns a non-shader-visible descriptor for the view, created on first use and cached
+    // for the view's lifetime. Bind groups gather these to populate their descriptor tables
+    // with a single CopyDescriptors call instead of one view-creation driver call per binding.
+    // Returns false when the descriptor cannot be created (destroyed texture or descriptor
+    // exhaustion); the caller then creates the view directly into its table.
+    bool GetOrCreateCachedSRV(D3D12_CPU_DESCRIPTOR_HANDLE* handleOut);
+    bool GetOrCreateCachedUAV(D3D12_CPU_DESCRIPTOR_HANDLE* handleOut);
+
   private:
     TextureView(TextureBase* texture, const TextureViewDescriptor* descriptor);
+    ~TextureView() override;
 
     D3D12_SHADER_RESOURCE_VIEW_DESC mSrvDesc;
+
+    // Cached single-descriptor staging allocations backing GetOrCreateCachedSRV/UAV.
+    StagingDescriptorAllocator* mStagingAllocator = nullptr;
+    CPUDescriptorHeapAllocation mCachedSRVAllocation;
+    CPUDescriptorHeapAllocation mCachedUAVAllocation;
 };
 }  // namespace dawn::native::d3d12
 
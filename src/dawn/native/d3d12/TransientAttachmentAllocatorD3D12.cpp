@@ -0,0 +1,106 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/d3d12/TransientAttachmentAllocatorD3D12.h"
+
+#include <utility>
+
+#include "dawn/native/d3d12/D3D12Error.h"
+#include "dawn/native/d3d12/DeviceD3D12.h"
+#include "dawn/native/d3d12/UtilsD3D12.h"
+
+namespace dawn::native::d3d12 {
+
+TransientAttachmentAllocator::TransientAttachmentAllocator(Device* device) : mDevice(device) {}
+
+TransientAttachmentAllocator::~TransientAttachmentAllocator() {
+    ASSERT(mFreeHeaps.empty());
+}
+
+ResultOrError<TransientAttachmentAllocator::Allocation> TransientAttachmentAllocator::Allocate(
+    const D3D12_RESOURCE_DESC& resourceDescriptor,
+    D3D12_RESOURCE_STATES initialUsage) {
+    const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo =
+        mDevice->GetD3D12Device()->GetResourceAllocationInfo(0, 1, &resourceDescriptor);
+
+    Allocation allocation = {};
+
+    // Take the smallest pooled heap that fits, but not one that would strand more than half
+    // of its memory behind a small attachment.
+    auto it = mFreeHeaps.lower_bound(allocationInfo.SizeInBytes);
+    if (it != mFreeHeaps.end() && it->first <= allocationInfo.SizeInBytes * 2) {
+        allocation.heap = std::move(it->second);
+        allocation.heapSize = it->first;
+        allocation.requiresAliasingBarrier = true;
+        mFreeHeaps.erase(it);
+    } else {
+        D3D12_HEAP_DESC heapDesc;
+        heapDesc.SizeInBytes = allocationInfo.SizeInBytes;
+        heapDesc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+        heapDesc.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+        heapDesc.Properties.CreationNodeMask = 0;
+        heapDesc.Properties.VisibleNodeMask = 0;
+        heapDesc.Alignment = allocationInfo.Alignment;
+        heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+
+        DAWN_TRY(CheckOutOfMemoryHRESULT(
+            mDevice->GetD3D12Device()->CreateHeap(&heapDesc, IID_PPV_ARGS(&allocation.heap)),
+            "ID3D12Device::CreateHeap"));
+        allocation.heapSize = allocationInfo.SizeInBytes;
+    }
+
+    // Transient attachments are always cleared on load, so a zero optimized clear value both
+    // suppresses the mismatched-clear debug layer warning and enables fast clears on some
+    // architectures.
+    D3D12_CLEAR_VALUE zero{};
+    D3D12_CLEAR_VALUE* optimizedClearValue = nullptr;
+    if (IsClearValueOptimizable(resourceDescriptor)) {
+        zero.Format = resourceDescriptor.Format;
+        optimizedClearValue = &zero;
+    }
+
+    DAWN_TRY(CheckOutOfMemoryHRESULT(
+        mDevice->GetD3D12Device()->CreatePlacedResource(allocation.heap.Get(), 0,
+                                                        &resourceDescriptor, initialUsage,
+                                                        optimizedClearValue,
+                                                        IID_PPV_ARGS(&allocation.resource)),
+        "ID3D12Device::CreatePlacedResource"));
+
+    return allocation;
+}
+
+void TransientAttachmentAllocator::Free(ComPtr<ID3D12Heap> heap, uint64_t heapSize) {
+    ASSERT(heap != nullptr);
+    if (mFreeHeaps.size() >= kMaxFreeHeaps) {
+        // The GPU may still be using the resource placed in the heap, so the heap release
+        // must be deferred until the in-flight commands complete.
+        mDevice->ReferenceUntilUnused(std::move(heap));
+        return;
+    }
+    mFreeHeaps.emplace(heapSize, std::move(heap));
+}
+
+void TransientAttachmentAllocator::Trim() {
+    for (auto& [heapSize, heap] : mFreeHeaps) {
+        mDevice->ReferenceUntilUnused(std::move(heap));
+    }
+    mFreeHeaps.clear();
+}
+
+void TransientAttachmentAllocator::DestroyPool() {
+    mFreeHeaps.clear();
+}
+
+}  // namespace dawn::native::d3d12
@@ -0,0 +1,76 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_D3D12_TRANSIENTATTACHMENTALLOCATORD3D12_H_
+#define SRC_DAWN_NATIVE_D3D12_TRANSIENTATTACHMENTALLOCATORD3D12_H_
+
+#include <map>
+
+#include "dawn/native/Error.h"
+#include "dawn/native/d3d12/d3d12_platform.h"
+
+// |TransientAttachmentAllocator| backs textures created with the kTransientAttachment internal
+// usage. Validation guarantees the contents of a transient attachment never outlive the render
+// pass that produced them, so the heap backing one transient texture may be handed to the next
+// transient texture as soon as the first is destroyed, without waiting for the GPU: command
+// queue ordering makes the reuse well-defined and the new placed resource only needs an
+// aliasing barrier before its first use. Transient attachments with disjoint lifetimes
+// therefore cost their high-water mark of memory rather than their sum.
+namespace dawn::native::d3d12 {
+
+class Device;
+
+class TransientAttachmentAllocator {
+  public:
+    explicit TransientAttachmentAllocator(Device* device);
+    ~TransientAttachmentAllocator();
+
+    struct Allocation {
+        ComPtr<ID3D12Resource> resource;
+        ComPtr<ID3D12Heap> heap;
+        uint64_t heapSize = 0;
+        // True when the heap previously backed another transient attachment, in which case
+        // an aliasing barrier must be recorded before the resource is first used.
+        bool requiresAliasingBarrier = false;
+    };
+
+    ResultOrError<Allocation> Allocate(const D3D12_RESOURCE_DESC& resourceDescriptor,
+                                       D3D12_RESOURCE_STATES initialUsage);
+
+    // Makes the heap immediately available to back the next transient attachment. The caller
+    // must keep the placed resource that lived in the heap alive until the GPU has finished
+    // using it.
+    void Free(ComPtr<ID3D12Heap> heap, uint64_t heapSize);
+
+    // Empties the pool, deferring the release of each heap until in-flight commands that may
+    // still use a resource placed in it have completed.
+    void Trim();
+
+    // Releases pooled heaps. Must only be called once all resources placed in them have been
+    // released.
+    void DestroyPool();
+
+  private:
+    Device* mDevice;
+
+    // Bounds how much memory idle pooled heaps may pin.
+    static constexpr size_t kMaxFreeHeaps = 8;
+
+    // Free heaps keyed by size so allocation can take the smallest heap that fits.
+    std::multimap<uint64_t, ComPtr<ID3D12Heap>> mFreeHeaps;
+};
+
+}  // namespace dawn::native::d3d12
+
+#endif  // SRC_DAWN_NATIVE_D3D12_TRANSIENTATTACHMENTALLOCATORD3D12_H_
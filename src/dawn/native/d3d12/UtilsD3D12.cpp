@@ -257,6 +257,37 @@ void Record2DBufferTextureCopyWithSplit(BufferTextureCopyDirection direction,
 
     const uint64_t bytesPerLayer = bytesPerRow * rowsPerImage;
 
+    const Texture* texture = ToBackend(textureCopy.texture.Get());
+
+    // All layers sharing a copy split have identical copy regions: only the buffer offset and
+    // the destination subresource change from one layer to the next. Precompute the buffer
+    // locations (including the copyable subresource format lookup) and copy boxes once per
+    // split instead of rebuilding them for every layer.
+    std::array<
+        std::array<D3D12_TEXTURE_COPY_LOCATION, TextureCopySubresource::kMaxTextureCopyRegions>,
+        TextureCopySplits::kMaxTextureCopySubresources>
+        bufferLocations;
+    std::array<std::array<D3D12_BOX, TextureCopySubresource::kMaxTextureCopyRegions>,
+               TextureCopySplits::kMaxTextureCopySubresources>
+        copyRegions;
+    for (uint32_t splitIndex = 0; splitIndex < copySplits.copySubresources.size(); ++splitIndex) {
+        const TextureCopySubresource& copySplit = copySplits.copySubresources[splitIndex];
+        for (uint32_t i = 0; i < copySplit.count; ++i) {
+            const TextureCopySubresource::CopyInfo& info = copySplit.copies[i];
+            bufferLocations[splitIndex][i] = ComputeBufferLocationForCopyTextureRegion(
+                texture, bufferResource, info.bufferSize, info.alignedOffset, bytesPerRow,
+                textureCopy.aspect);
+            if (direction == BufferTextureCopyDirection::B2T) {
+                copyRegions[splitIndex][i] =
+                    ComputeD3D12BoxFromOffsetAndSize(info.bufferOffset, info.copySize);
+            } else {
+                ASSERT(direction == BufferTextureCopyDirection::T2B);
+                copyRegions[splitIndex][i] =
+                    ComputeD3D12BoxFromOffsetAndSize(info.textureOffset, info.copySize);
+            }
+        }
+    }
+
     // copySplits.copySubresources[1] is always calculated for the second copy layer with
     // extra "bytesPerLayer" copy offset compared with the first copy layer. So
     // here we use an array bufferOffsetsForNextLayer to record the extra offsets
@@ -275,10 +306,26 @@ void Record2DBufferTextureCopyWithSplit(BufferTextureCopyDirection direction,
         const uint64_t bufferOffsetForNextLayer = bufferOffsetsForNextLayer[splitIndex];
         const uint32_t copyTextureLayer = copyLayer + textureCopy.origin.z;
 
-        RecordBufferTextureCopyFromSplits(direction, commandList, copySplitPerLayerBase,
-                                          bufferResource, bufferOffsetForNextLayer, bytesPerRow,
-                                          textureCopy.texture.Get(), textureCopy.mipLevel,
-                                          copyTextureLayer, textureCopy.aspect);
+        const D3D12_TEXTURE_COPY_LOCATION textureLocation = ComputeTextureCopyLocationForTexture(
+            texture, textureCopy.mipLevel, copyTextureLayer, textureCopy.aspect);
+
+        for (uint32_t i = 0; i < copySplitPerLayerBase.count; ++i) {
+            const TextureCopySubresource::CopyInfo& info = copySplitPerLayerBase.copies[i];
+
+            D3D12_TEXTURE_COPY_LOCATION& bufferLocation = bufferLocations[splitIndex][i];
+            bufferLocation.PlacedFootprint.Offset = info.alignedOffset + bufferOffsetForNextLayer;
+
+            if (direction == BufferTextureCopyDirection::B2T) {
+                commandList->CopyTextureRegion(&textureLocation, info.textureOffset.x,
+                                               info.textureOffset.y, info.textureOffset.z,
+                                               &bufferLocation, &copyRegions[splitIndex][i]);
+            } else {
+                ASSERT(direction == BufferTextureCopyDirection::T2B);
+                commandList->CopyTextureRegion(&bufferLocation, info.bufferOffset.x,
+                                               info.bufferOffset.y, info.bufferOffset.z,
+                                               &textureLocation, &copyRegions[splitIndex][i]);
+            }
+        }
 
         bufferOffsetsForNextLayer[splitIndex] += bytesPerLayer * copySplits.copySubresources.size();
     }
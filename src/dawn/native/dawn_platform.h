@@ -52,6 +52,12 @@ static constexpr wgpu::TextureUsage kReadOnlyRenderAttachment =
 static constexpr wgpu::TextureUsage kAgainAsRenderAttachment =
     static_cast<wgpu::TextureUsage>(0x80000001);
 
+// Internal usage for attachments whose contents never outlive the render pass. Backends with
+// tile-local memory back these textures with memory that is never written out to RAM (Metal
+// memoryless storage, Vulkan transient attachments with lazily allocated memory).
+static constexpr wgpu::TextureUsage kTransientAttachment =
+    static_cast<wgpu::TextureUsage>(0x20000000);
+
 // Add an extra texture usage for textures that will be presented, for use in backends
 // that needs to transition to present usage.
 // This currently aliases wgpu::TextureUsage::Present, we would assign it
@@ -21,7 +21,7 @@
 
 namespace dawn::native::metal {
 
-class Backend : public BackendConnection {
+class Backend final : public BackendConnection {
   public:
     explicit Backend(InstanceBase* instance);
     ~Backend() override;
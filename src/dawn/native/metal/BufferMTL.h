@@ -18,6 +18,7 @@
 #include "dawn/common/NSRef.h"
 #include "dawn/common/SerialQueue.h"
 #include "dawn/native/Buffer.h"
+#include "dawn/native/ResourceMemoryAllocation.h"
 
 #import <Metal/Metal.h>
 
@@ -63,6 +64,10 @@ class Buffer final : public BufferBase {
                      uint64_t size = 0);
 
     NSPRef<id<MTLBuffer>> mMtlBuffer;
+
+    // Only valid when the buffer was placed in an MTLHeap by the ResourceAllocatorManager;
+    // kInvalid for standalone MTLBuffers.
+    ResourceMemoryAllocation mMemoryAllocation;
 };
 
 }  // namespace dawn::native::metal
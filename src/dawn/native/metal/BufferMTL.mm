@@ -19,6 +19,8 @@
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/metal/CommandRecordingContext.h"
 #include "dawn/native/metal/DeviceMTL.h"
+#include "dawn/native/metal/ResourceAllocatorManagerMTL.h"
+#include "dawn/native/metal/ResourceHeapMTL.h"
 
 #include <limits>
 
@@ -72,6 +74,14 @@ MaybeError Buffer::Initialize(bool mappedAtCreation) {
         storageMode = MTLResourceStorageModePrivate;
     }
 
+    // The fence chain in the CommandRecordingContext provides the ordering instead of
+    // automatic hazard tracking.
+    if (GetDevice()->IsToggleEnabled(Toggle::MetalUseUntrackedHazardResources)) {
+        if (@available(macOS 10.15, iOS 13.0, *)) {
+            storageMode |= MTLResourceHazardTrackingModeUntracked;
+        }
+    }
+
     uint32_t alignment = 1;
 #if DAWN_PLATFORM_IS(MACOS)
     // [MTLBlitCommandEncoder fillBuffer] requires the size to be a multiple of 4 on MacOS.
@@ -113,10 +123,43 @@ MaybeError Buffer::Initialize(bool mappedAtCreation) {
     }
 
     mAllocatedSize = currentSize;
-    mMtlBuffer.Acquire([ToBackend(GetDevice())->GetMTLDevice() newBufferWithLength:currentSize
-                                                                           options:storageMode]);
+
+    Device* device = ToBackend(GetDevice());
+
+    // Try to place the buffer in an MTLHeap first so that frequent small allocations don't
+    // each pay for a standalone MTLBuffer; fall back to one when the request is not suitable
+    // for sub-allocation (or placement heaps are unavailable).
+    if (@available(macOS 10.15, iOS 13.0, *)) {
+        MTLStorageMode heapStorageMode = (GetUsage() & kMappableBufferUsages)
+                                             ? MTLStorageModeShared
+                                             : MTLStorageModePrivate;
+        MTLSizeAndAlign sizeAndAlign =
+            [device->GetMTLDevice() heapBufferSizeAndAlignWithLength:currentSize
+                                                             options:storageMode];
+
+        ResourceMemoryAllocation allocation;
+        DAWN_TRY_ASSIGN(allocation,
+                        device->GetResourceAllocatorManager()->AllocateMemory(
+                            heapStorageMode, sizeAndAlign.size, sizeAndAlign.align));
+        if (allocation.GetInfo().mMethod == AllocationMethod::kSubAllocated) {
+            Heap* heap = ToBackend(allocation.GetResourceHeap());
+            mMtlBuffer.Acquire([heap->GetMTLHeap() newBufferWithLength:currentSize
+                                                               options:storageMode
+                                                                offset:allocation.GetOffset()]);
+            if (mMtlBuffer == nullptr) {
+                device->GetResourceAllocatorManager()->DeallocateMemory(&allocation);
+                return DAWN_OUT_OF_MEMORY_ERROR("Buffer allocation failed");
+            }
+            mMemoryAllocation = allocation;
+        }
+    }
+
     if (mMtlBuffer == nullptr) {
-        return DAWN_OUT_OF_MEMORY_ERROR("Buffer allocation failed");
+        mMtlBuffer.Acquire([device->GetMTLDevice() newBufferWithLength:currentSize
+                                                               options:storageMode]);
+        if (mMtlBuffer == nullptr) {
+            return DAWN_OUT_OF_MEMORY_ERROR("Buffer allocation failed");
+        }
     }
 
     // The buffers with mappedAtCreation == true will be initialized in
@@ -176,6 +219,8 @@ void Buffer::UnmapImpl() {
 void Buffer::DestroyImpl() {
     BufferBase::DestroyImpl();
     mMtlBuffer = nullptr;
+    // No-op for standalone buffers; heap regions are reclaimed once the GPU is done.
+    ToBackend(GetDevice())->GetResourceAllocatorManager()->DeallocateMemory(&mMemoryAllocation);
 }
 
 bool Buffer::EnsureDataInitialized(CommandRecordingContext* commandContext) {
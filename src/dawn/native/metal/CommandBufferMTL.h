@@ -15,6 +15,8 @@
 #ifndef SRC_DAWN_NATIVE_METAL_COMMANDBUFFERMTL_H_
 #define SRC_DAWN_NATIVE_METAL_COMMANDBUFFERMTL_H_
 
+#include <vector>
+
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/Error.h"
 
@@ -57,6 +59,15 @@ class CommandBuffer final : public CommandBufferBase {
 
     MaybeError EncodeComputePass(CommandRecordingContext* commandContext);
     MaybeError EncodeRenderPass(id<MTLRenderCommandEncoder> encoder);
+    MaybeError EncodeParallelRenderPass(CommandRecordingContext* commandContext,
+                                        MTLRenderPassDescriptor* mtlRenderPass);
+
+    void GatherParallelRenderPassInfo();
+
+    // For each render pass, whether FillCommands encodes it with an
+    // MTLParallelRenderCommandEncoder. Only filled when the MetalUseParallelRenderEncoder
+    // toggle is enabled.
+    std::vector<bool> mRenderPassUsesParallelEncoding;
 };
 
 }  // namespace dawn::native::metal
@@ -14,6 +14,10 @@
 
 #include "dawn/native/metal/CommandBufferMTL.h"
 
+#include <memory>
+#include <set>
+#include <vector>
+
 #include "dawn/native/BindGroupTracker.h"
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/Commands.h"
@@ -31,6 +35,7 @@
 #include "dawn/native/metal/StagingBufferMTL.h"
 #include "dawn/native/metal/TextureMTL.h"
 #include "dawn/native/metal/UtilsMetal.h"
+#include "dawn/platform/DawnPlatform.h"
 
 #include <tint/tint.h>
 
@@ -492,6 +497,301 @@ class VertexBufferTracker {
     StorageBufferLengthTracker* mLengthTracker;
 };
 
+// Encodes the commands of a render bundle (or the equivalent inline draw-stream commands of a
+// render pass) on a render command encoder, tracking the lazily-applied pipeline, vertex
+// buffer and bind group state. One instance must be used per encoder because the tracked
+// state is per-encoder state.
+class RenderDrawStreamEncoder {
+  public:
+    RenderDrawStreamEncoder(id<MTLRenderCommandEncoder> encoder, bool enableVertexPulling)
+        : mEncoder(encoder),
+          mEnableVertexPulling(enableVertexPulling),
+          mVertexBuffers(&mStorageBufferLengths),
+          mBindGroups(&mStorageBufferLengths) {}
+
+    void EncodeCommand(CommandIterator* iter, Command type) {
+        switch (type) {
+            case Command::Draw: {
+                DrawCmd* draw = iter->NextCommand<DrawCmd>();
+
+                mVertexBuffers.Apply(mEncoder, mLastPipeline, mEnableVertexPulling);
+                mBindGroups.Apply(mEncoder);
+                mStorageBufferLengths.Apply(mEncoder, mLastPipeline, mEnableVertexPulling);
+
+                // The instance count must be non-zero, otherwise no-op
+                if (draw->instanceCount != 0) {
+                    // MTLFeatureSet_iOS_GPUFamily3_v1 does not support baseInstance
+                    if (draw->firstInstance == 0) {
+                        [mEncoder drawPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                                     vertexStart:draw->firstVertex
+                                     vertexCount:draw->vertexCount
+                                   instanceCount:draw->instanceCount];
+                    } else {
+                        [mEncoder drawPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                                     vertexStart:draw->firstVertex
+                                     vertexCount:draw->vertexCount
+                                   instanceCount:draw->instanceCount
+                                    baseInstance:draw->firstInstance];
+                    }
+                }
+                break;
+            }
+
+            case Command::DrawIndexed: {
+                DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
+
+                mVertexBuffers.Apply(mEncoder, mLastPipeline, mEnableVertexPulling);
+                mBindGroups.Apply(mEncoder);
+                mStorageBufferLengths.Apply(mEncoder, mLastPipeline, mEnableVertexPulling);
+
+                // The index and instance count must be non-zero, otherwise no-op
+                if (draw->indexCount != 0 && draw->instanceCount != 0) {
+                    // MTLFeatureSet_iOS_GPUFamily3_v1 does not support baseInstance and
+                    // baseVertex.
+                    if (draw->baseVertex == 0 && draw->firstInstance == 0) {
+                        [mEncoder drawIndexedPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                                             indexCount:draw->indexCount
+                                              indexType:mIndexBufferType
+                                            indexBuffer:mIndexBuffer
+                                      indexBufferOffset:mIndexBufferBaseOffset +
+                                                        draw->firstIndex * mIndexFormatSize
+                                          instanceCount:draw->instanceCount];
+                    } else {
+                        [mEncoder drawIndexedPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                                             indexCount:draw->indexCount
+                                              indexType:mIndexBufferType
+                                            indexBuffer:mIndexBuffer
+                                      indexBufferOffset:mIndexBufferBaseOffset +
+                                                        draw->firstIndex * mIndexFormatSize
+                                          instanceCount:draw->instanceCount
+                                             baseVertex:draw->baseVertex
+                                           baseInstance:draw->firstInstance];
+                    }
+                }
+                break;
+            }
+
+            case Command::DrawIndirect: {
+                DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
+
+                mVertexBuffers.Apply(mEncoder, mLastPipeline, mEnableVertexPulling);
+                mBindGroups.Apply(mEncoder);
+                mStorageBufferLengths.Apply(mEncoder, mLastPipeline, mEnableVertexPulling);
+
+                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+                id<MTLBuffer> indirectBuffer = buffer->GetMTLBuffer();
+                [mEncoder drawPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                          indirectBuffer:indirectBuffer
+                    indirectBufferOffset:draw->indirectOffset];
+                break;
+            }
+
+            case Command::DrawIndexedIndirect: {
+                DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
+
+                mVertexBuffers.Apply(mEncoder, mLastPipeline, mEnableVertexPulling);
+                mBindGroups.Apply(mEncoder);
+                mStorageBufferLengths.Apply(mEncoder, mLastPipeline, mEnableVertexPulling);
+
+                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+                ASSERT(buffer != nullptr);
+
+                id<MTLBuffer> indirectBuffer = buffer->GetMTLBuffer();
+                [mEncoder drawIndexedPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                                      indexType:mIndexBufferType
+                                    indexBuffer:mIndexBuffer
+                              indexBufferOffset:mIndexBufferBaseOffset
+                                 indirectBuffer:indirectBuffer
+                           indirectBufferOffset:draw->indirectOffset];
+                break;
+            }
+
+            case Command::InsertDebugMarker: {
+                InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
+                char* label = iter->NextData<char>(cmd->length + 1);
+                NSRef<NSString> mtlLabel =
+                    AcquireNSRef([[NSString alloc] initWithUTF8String:label]);
+                [mEncoder insertDebugSignpost:mtlLabel.Get()];
+                break;
+            }
+
+            case Command::PopDebugGroup: {
+                iter->NextCommand<PopDebugGroupCmd>();
+
+                [mEncoder popDebugGroup];
+                break;
+            }
+
+            case Command::PushDebugGroup: {
+                PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
+                char* label = iter->NextData<char>(cmd->length + 1);
+                NSRef<NSString> mtlLabel =
+                    AcquireNSRef([[NSString alloc] initWithUTF8String:label]);
+                [mEncoder pushDebugGroup:mtlLabel.Get()];
+                break;
+            }
+
+            case Command::SetRenderPipeline: {
+                SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
+                RenderPipeline* newPipeline = ToBackend(cmd->pipeline).Get();
+
+                mVertexBuffers.OnSetPipeline(mLastPipeline, newPipeline);
+                mBindGroups.OnSetPipeline(newPipeline);
+
+                [mEncoder setDepthStencilState:newPipeline->GetMTLDepthStencilState()];
+                [mEncoder setFrontFacingWinding:newPipeline->GetMTLFrontFace()];
+                [mEncoder setCullMode:newPipeline->GetMTLCullMode()];
+                [mEncoder setDepthBias:newPipeline->GetDepthBias()
+                            slopeScale:newPipeline->GetDepthBiasSlopeScale()
+                                 clamp:newPipeline->GetDepthBiasClamp()];
+                if (@available(macOS 10.11, iOS 11.0, *)) {
+                    MTLDepthClipMode clipMode = newPipeline->HasUnclippedDepth()
+                                                    ? MTLDepthClipModeClamp
+                                                    : MTLDepthClipModeClip;
+                    [mEncoder setDepthClipMode:clipMode];
+                }
+                newPipeline->Encode(mEncoder);
+
+                mLastPipeline = newPipeline;
+                break;
+            }
+
+            case Command::SetBindGroup: {
+                SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
+                uint32_t* dynamicOffsets = nullptr;
+                if (cmd->dynamicOffsetCount > 0) {
+                    dynamicOffsets = iter->NextTrailingData<uint32_t>(cmd->dynamicOffsetCount);
+                }
+
+                mBindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group.Get()),
+                                           cmd->dynamicOffsetCount, dynamicOffsets);
+                break;
+            }
+
+            case Command::SetIndexBuffer: {
+                SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
+                auto b = ToBackend(cmd->buffer.Get());
+                mIndexBuffer = b->GetMTLBuffer();
+                mIndexBufferBaseOffset = cmd->offset;
+                mIndexBufferType = MTLIndexFormat(cmd->format);
+                mIndexFormatSize = IndexFormatSize(cmd->format);
+                break;
+            }
+
+            case Command::SetVertexBuffer: {
+                SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
+
+                mVertexBuffers.OnSetVertexBuffer(cmd->slot, ToBackend(cmd->buffer.Get()),
+                                                 cmd->offset);
+                break;
+            }
+
+            default:
+                UNREACHABLE();
+                break;
+        }
+    }
+
+  private:
+    id<MTLRenderCommandEncoder> mEncoder;
+    bool mEnableVertexPulling;
+
+    RenderPipeline* mLastPipeline = nullptr;
+    id<MTLBuffer> mIndexBuffer = nullptr;
+    uint32_t mIndexBufferBaseOffset = 0;
+    MTLIndexType mIndexBufferType;
+    uint64_t mIndexFormatSize = 0;
+
+    StorageBufferLengthTracker mStorageBufferLengths = {};
+    VertexBufferTracker mVertexBuffers;
+    BindGroupTracker mBindGroups;
+};
+
+// Pass-wide state that isn't reset by ExecuteBundles and thus applies to the draws of render
+// bundles. Subordinate encoders of an MTLParallelRenderCommandEncoder don't inherit any state
+// so it must be replayed on each of them.
+struct InheritedRenderPassState {
+    bool hasViewport = false;
+    MTLViewport viewport;
+    bool hasScissorRect = false;
+    MTLScissorRect scissorRect;
+    bool hasStencilReference = false;
+    uint32_t stencilReference;
+    bool hasBlendConstant = false;
+    dawn::native::Color blendConstant;
+
+    void Apply(id<MTLRenderCommandEncoder> encoder) const {
+        if (hasViewport) {
+            [encoder setViewport:viewport];
+        }
+        if (hasScissorRect) {
+            [encoder setScissorRect:scissorRect];
+        }
+        if (hasStencilReference) {
+            [encoder setStencilReferenceValue:stencilReference];
+        }
+        if (hasBlendConstant) {
+            [encoder setBlendColorRed:blendConstant.r
+                                green:blendConstant.g
+                                 blue:blendConstant.b
+                                alpha:blendConstant.a];
+        }
+    }
+};
+
+// The arguments for encoding one render bundle on a subordinate encoder of an
+// MTLParallelRenderCommandEncoder, handed to a worker task.
+struct BundleEncodingTask {
+    NSPRef<id<MTLRenderCommandEncoder>> encoder;
+    CommandIterator* commands;
+    InheritedRenderPassState inheritedState;
+    bool enableVertexPulling;
+};
+
+void EncodeBundleWorkerTask(void* userdata) {
+    std::unique_ptr<BundleEncodingTask> task(static_cast<BundleEncodingTask*>(userdata));
+    @autoreleasepool {
+        id<MTLRenderCommandEncoder> encoder = task->encoder.Get();
+        task->inheritedState.Apply(encoder);
+
+        RenderDrawStreamEncoder drawStream(encoder, task->enableVertexPulling);
+        CommandIterator* iter = task->commands;
+        iter->Reset();
+        Command type;
+        while (iter->NextCommandId(&type)) {
+            drawStream.EncodeCommand(iter, type);
+        }
+        [encoder endEncoding];
+    }
+}
+
+uint64_t CountBundleDraws(RenderBundleBase* bundle) {
+    CommandIterator* commands = bundle->GetCommands();
+    commands->Reset();
+
+    uint64_t drawCount = 0;
+    Command type;
+    while (commands->NextCommandId(&type)) {
+        switch (type) {
+            case Command::Draw:
+            case Command::DrawIndexed:
+            case Command::DrawIndirect:
+            case Command::DrawIndexedIndirect:
+                drawCount++;
+                break;
+            default:
+                break;
+        }
+        SkipCommand(commands, type);
+    }
+    return drawCount;
+}
+
+// Minimum amount of draws in a render pass before it is encoded with a parallel encoder. Below
+// this the cost of the extra encoders outweighs the parallelism win.
+// TODO(crbug.com/dawn/1548): this is a guess, tune it against real bundle-heavy workloads.
+constexpr uint64_t kMinDrawsForParallelEncoding = 128;
+
 }  // anonymous namespace
 
 void RecordCopyBufferToTexture(CommandRecordingContext* commandContext,
@@ -578,7 +878,11 @@ Ref<CommandBuffer> CommandBuffer::Create(CommandEncoder* encoder,
 }
 
 CommandBuffer::CommandBuffer(CommandEncoder* enc, const CommandBufferDescriptor* desc)
-    : CommandBufferBase(enc, desc) {}
+    : CommandBufferBase(enc, desc) {
+    if (GetDevice()->IsToggleEnabled(Toggle::MetalUseParallelRenderEncoder)) {
+        GatherParallelRenderPassInfo();
+    }
+}
 
 CommandBuffer::~CommandBuffer() = default;
 
@@ -643,11 +947,16 @@ MaybeError CommandBuffer::FillCommands(CommandRecordingContext* commandContext)
 
                 LazyClearRenderPassAttachments(cmd);
                 NSRef<MTLRenderPassDescriptor> descriptor = CreateMTLRenderPassDescriptor(cmd);
-                DAWN_TRY(EncodeMetalRenderPass(
-                    ToBackend(GetDevice()), commandContext, descriptor.Get(), cmd->width,
-                    cmd->height, [this](id<MTLRenderCommandEncoder> encoder) -> MaybeError {
-                        return this->EncodeRenderPass(encoder);
-                    }));
+                if (nextRenderPassNumber < mRenderPassUsesParallelEncoding.size() &&
+                    mRenderPassUsesParallelEncoding[nextRenderPassNumber]) {
+                    DAWN_TRY(EncodeParallelRenderPass(commandContext, descriptor.Get()));
+                } else {
+                    DAWN_TRY(EncodeMetalRenderPass(
+                        ToBackend(GetDevice()), commandContext, descriptor.Get(), cmd->width,
+                        cmd->height, [this](id<MTLRenderCommandEncoder> encoder) -> MaybeError {
+                            return this->EncodeRenderPass(encoder);
+                        }));
+                }
 
                 nextRenderPassNumber++;
                 break;
@@ -990,6 +1299,18 @@ MaybeError CommandBuffer::EncodeComputePass(CommandRecordingContext* commandCont
     StorageBufferLengthTracker storageBufferLengths = {};
     BindGroupTracker bindGroups(&storageBufferLengths);
 
+    // With untracked resources, hazards between the dispatches of a pass must be ordered with
+    // explicit memory barriers since automatic tracking no longer does it per resource.
+    bool untrackedResources =
+        GetDevice()->IsToggleEnabled(Toggle::MetalUseUntrackedHazardResources);
+    auto BarrierAfterDispatch = [&](id<MTLComputeCommandEncoder> e) {
+        if (untrackedResources) {
+            if (@available(macOS 10.14, iOS 12.0, *)) {
+                [e memoryBarrierWithScope:MTLBarrierScopeBuffers | MTLBarrierScopeTextures];
+            }
+        }
+    };
+
     id<MTLComputeCommandEncoder> encoder = commandContext->BeginCompute();
 
     Command type;
@@ -1014,6 +1335,7 @@ MaybeError CommandBuffer::EncodeComputePass(CommandRecordingContext* commandCont
 
                 [encoder dispatchThreadgroups:MTLSizeMake(dispatch->x, dispatch->y, dispatch->z)
                         threadsPerThreadgroup:lastPipeline->GetLocalWorkGroupSize()];
+                BarrierAfterDispatch(encoder);
                 break;
             }
 
@@ -1029,6 +1351,7 @@ MaybeError CommandBuffer::EncodeComputePass(CommandRecordingContext* commandCont
                     dispatchThreadgroupsWithIndirectBuffer:indirectBuffer
                                       indirectBufferOffset:dispatch->indirectOffset
                                      threadsPerThreadgroup:lastPipeline->GetLocalWorkGroupSize()];
+                BarrierAfterDispatch(encoder);
                 break;
             }
 
@@ -1046,7 +1369,7 @@ MaybeError CommandBuffer::EncodeComputePass(CommandRecordingContext* commandCont
                 SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
                 uint32_t* dynamicOffsets = nullptr;
                 if (cmd->dynamicOffsetCount > 0) {
-                    dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    dynamicOffsets = mCommands.NextTrailingData<uint32_t>(cmd->dynamicOffsetCount);
                 }
 
                 bindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group.Get()),
@@ -1105,199 +1428,8 @@ MaybeError CommandBuffer::EncodeComputePass(CommandRecordingContext* commandCont
 }
 
 MaybeError CommandBuffer::EncodeRenderPass(id<MTLRenderCommandEncoder> encoder) {
-    bool enableVertexPulling = GetDevice()->IsToggleEnabled(Toggle::MetalEnableVertexPulling);
-    RenderPipeline* lastPipeline = nullptr;
-    id<MTLBuffer> indexBuffer = nullptr;
-    uint32_t indexBufferBaseOffset = 0;
-    MTLIndexType indexBufferType;
-    uint64_t indexFormatSize = 0;
-
-    StorageBufferLengthTracker storageBufferLengths = {};
-    VertexBufferTracker vertexBuffers(&storageBufferLengths);
-    BindGroupTracker bindGroups(&storageBufferLengths);
-
-    auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) {
-        switch (type) {
-            case Command::Draw: {
-                DrawCmd* draw = iter->NextCommand<DrawCmd>();
-
-                vertexBuffers.Apply(encoder, lastPipeline, enableVertexPulling);
-                bindGroups.Apply(encoder);
-                storageBufferLengths.Apply(encoder, lastPipeline, enableVertexPulling);
-
-                // The instance count must be non-zero, otherwise no-op
-                if (draw->instanceCount != 0) {
-                    // MTLFeatureSet_iOS_GPUFamily3_v1 does not support baseInstance
-                    if (draw->firstInstance == 0) {
-                        [encoder drawPrimitives:lastPipeline->GetMTLPrimitiveTopology()
-                                    vertexStart:draw->firstVertex
-                                    vertexCount:draw->vertexCount
-                                  instanceCount:draw->instanceCount];
-                    } else {
-                        [encoder drawPrimitives:lastPipeline->GetMTLPrimitiveTopology()
-                                    vertexStart:draw->firstVertex
-                                    vertexCount:draw->vertexCount
-                                  instanceCount:draw->instanceCount
-                                   baseInstance:draw->firstInstance];
-                    }
-                }
-                break;
-            }
-
-            case Command::DrawIndexed: {
-                DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
-
-                vertexBuffers.Apply(encoder, lastPipeline, enableVertexPulling);
-                bindGroups.Apply(encoder);
-                storageBufferLengths.Apply(encoder, lastPipeline, enableVertexPulling);
-
-                // The index and instance count must be non-zero, otherwise no-op
-                if (draw->indexCount != 0 && draw->instanceCount != 0) {
-                    // MTLFeatureSet_iOS_GPUFamily3_v1 does not support baseInstance and
-                    // baseVertex.
-                    if (draw->baseVertex == 0 && draw->firstInstance == 0) {
-                        [encoder drawIndexedPrimitives:lastPipeline->GetMTLPrimitiveTopology()
-                                            indexCount:draw->indexCount
-                                             indexType:indexBufferType
-                                           indexBuffer:indexBuffer
-                                     indexBufferOffset:indexBufferBaseOffset +
-                                                       draw->firstIndex * indexFormatSize
-                                         instanceCount:draw->instanceCount];
-                    } else {
-                        [encoder drawIndexedPrimitives:lastPipeline->GetMTLPrimitiveTopology()
-                                            indexCount:draw->indexCount
-                                             indexType:indexBufferType
-                                           indexBuffer:indexBuffer
-                                     indexBufferOffset:indexBufferBaseOffset +
-                                                       draw->firstIndex * indexFormatSize
-                                         instanceCount:draw->instanceCount
-                                            baseVertex:draw->baseVertex
-                                          baseInstance:draw->firstInstance];
-                    }
-                }
-                break;
-            }
-
-            case Command::DrawIndirect: {
-                DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-
-                vertexBuffers.Apply(encoder, lastPipeline, enableVertexPulling);
-                bindGroups.Apply(encoder);
-                storageBufferLengths.Apply(encoder, lastPipeline, enableVertexPulling);
-
-                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
-                id<MTLBuffer> indirectBuffer = buffer->GetMTLBuffer();
-                [encoder drawPrimitives:lastPipeline->GetMTLPrimitiveTopology()
-                          indirectBuffer:indirectBuffer
-                    indirectBufferOffset:draw->indirectOffset];
-                break;
-            }
-
-            case Command::DrawIndexedIndirect: {
-                DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
-
-                vertexBuffers.Apply(encoder, lastPipeline, enableVertexPulling);
-                bindGroups.Apply(encoder);
-                storageBufferLengths.Apply(encoder, lastPipeline, enableVertexPulling);
-
-                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
-                ASSERT(buffer != nullptr);
-
-                id<MTLBuffer> indirectBuffer = buffer->GetMTLBuffer();
-                [encoder drawIndexedPrimitives:lastPipeline->GetMTLPrimitiveTopology()
-                                     indexType:indexBufferType
-                                   indexBuffer:indexBuffer
-                             indexBufferOffset:indexBufferBaseOffset
-                                indirectBuffer:indirectBuffer
-                          indirectBufferOffset:draw->indirectOffset];
-                break;
-            }
-
-            case Command::InsertDebugMarker: {
-                InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
-                char* label = iter->NextData<char>(cmd->length + 1);
-                NSRef<NSString> mtlLabel =
-                    AcquireNSRef([[NSString alloc] initWithUTF8String:label]);
-                [encoder insertDebugSignpost:mtlLabel.Get()];
-                break;
-            }
-
-            case Command::PopDebugGroup: {
-                iter->NextCommand<PopDebugGroupCmd>();
-
-                [encoder popDebugGroup];
-                break;
-            }
-
-            case Command::PushDebugGroup: {
-                PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
-                char* label = iter->NextData<char>(cmd->length + 1);
-                NSRef<NSString> mtlLabel =
-                    AcquireNSRef([[NSString alloc] initWithUTF8String:label]);
-                [encoder pushDebugGroup:mtlLabel.Get()];
-                break;
-            }
-
-            case Command::SetRenderPipeline: {
-                SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                RenderPipeline* newPipeline = ToBackend(cmd->pipeline).Get();
-
-                vertexBuffers.OnSetPipeline(lastPipeline, newPipeline);
-                bindGroups.OnSetPipeline(newPipeline);
-
-                [encoder setDepthStencilState:newPipeline->GetMTLDepthStencilState()];
-                [encoder setFrontFacingWinding:newPipeline->GetMTLFrontFace()];
-                [encoder setCullMode:newPipeline->GetMTLCullMode()];
-                [encoder setDepthBias:newPipeline->GetDepthBias()
-                           slopeScale:newPipeline->GetDepthBiasSlopeScale()
-                                clamp:newPipeline->GetDepthBiasClamp()];
-                if (@available(macOS 10.11, iOS 11.0, *)) {
-                    MTLDepthClipMode clipMode = newPipeline->HasUnclippedDepth()
-                                                    ? MTLDepthClipModeClamp
-                                                    : MTLDepthClipModeClip;
-                    [encoder setDepthClipMode:clipMode];
-                }
-                newPipeline->Encode(encoder);
-
-                lastPipeline = newPipeline;
-                break;
-            }
-
-            case Command::SetBindGroup: {
-                SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
-                uint32_t* dynamicOffsets = nullptr;
-                if (cmd->dynamicOffsetCount > 0) {
-                    dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
-                }
-
-                bindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group.Get()),
-                                          cmd->dynamicOffsetCount, dynamicOffsets);
-                break;
-            }
-
-            case Command::SetIndexBuffer: {
-                SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
-                auto b = ToBackend(cmd->buffer.Get());
-                indexBuffer = b->GetMTLBuffer();
-                indexBufferBaseOffset = cmd->offset;
-                indexBufferType = MTLIndexFormat(cmd->format);
-                indexFormatSize = IndexFormatSize(cmd->format);
-                break;
-            }
-
-            case Command::SetVertexBuffer: {
-                SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
-
-                vertexBuffers.OnSetVertexBuffer(cmd->slot, ToBackend(cmd->buffer.Get()),
-                                                cmd->offset);
-                break;
-            }
-
-            default:
-                UNREACHABLE();
-                break;
-        }
-    };
+    RenderDrawStreamEncoder drawStream(
+        encoder, GetDevice()->IsToggleEnabled(Toggle::MetalEnableVertexPulling));
 
     Command type;
     while (mCommands.NextCommandId(&type)) {
@@ -1356,7 +1488,7 @@ MaybeError CommandBuffer::EncodeRenderPass(id<MTLRenderCommandEncoder> encoder)
                     CommandIterator* iter = bundles[i]->GetCommands();
                     iter->Reset();
                     while (iter->NextCommandId(&type)) {
-                        EncodeRenderBundleCommand(iter, type);
+                        drawStream.EncodeCommand(iter, type);
                     }
                 }
                 break;
@@ -1393,9 +1525,178 @@ MaybeError CommandBuffer::EncodeRenderPass(id<MTLRenderCommandEncoder> encoder)
             }
 
             default: {
-                EncodeRenderBundleCommand(&mCommands, type);
+                drawStream.EncodeCommand(&mCommands, type);
+                break;
+            }
+        }
+    }
+
+    // EndRenderPass should have been called
+    UNREACHABLE();
+}
+
+void CommandBuffer::GatherParallelRenderPassInfo() {
+    // The parallel path creates the render encoder itself, so it can't be combined with the
+    // workarounds in EncodeMetalRenderPass that patch the render pass descriptor and re-encode.
+    DeviceBase* device = GetDevice();
+    if (device->IsToggleEnabled(Toggle::AlwaysResolveIntoZeroLevelAndLayer) ||
+        device->IsToggleEnabled(Toggle::MetalRenderR8RG8UnormSmallMipToTempTexture) ||
+        device->IsToggleEnabled(Toggle::EmulateStoreAndMSAAResolve)) {
+        return;
+    }
+    // The untracked-resource fence chain is maintained by the CommandRecordingContext's
+    // encoders and doesn't cover subordinate encoders.
+    if (device->IsToggleEnabled(Toggle::MetalUseUntrackedHazardResources)) {
+        return;
+    }
+
+    bool inRenderPass = false;
+    bool eligible = false;
+    uint32_t bundleCount = 0;
+    uint64_t drawCount = 0;
+    std::set<RenderBundleBase*> bundlesInPass;
+
+    Command type;
+    while (mCommands.NextCommandId(&type)) {
+        switch (type) {
+            case Command::BeginRenderPass:
+                SkipCommand(&mCommands, type);
+                inRenderPass = true;
+                eligible = true;
+                bundleCount = 0;
+                drawCount = 0;
+                bundlesInPass.clear();
+                break;
+
+            case Command::EndRenderPass:
+                SkipCommand(&mCommands, type);
+                inRenderPass = false;
+                mRenderPassUsesParallelEncoding.push_back(
+                    eligible && bundleCount >= 2 && drawCount >= kMinDrawsForParallelEncoding);
+                break;
+
+            case Command::ExecuteBundles: {
+                ExecuteBundlesCmd* cmd = mCommands.NextCommand<ExecuteBundlesCmd>();
+                auto bundles = mCommands.NextData<Ref<RenderBundleBase>>(cmd->count);
+                ASSERT(inRenderPass);
+
+                bundleCount += cmd->count;
+                for (uint32_t i = 0; i < cmd->count; ++i) {
+                    // A bundle's CommandIterator can only be iterated by one worker at a time,
+                    // so executing the same bundle twice in a pass disqualifies it.
+                    if (!bundlesInPass.insert(bundles[i].Get()).second) {
+                        eligible = false;
+                    }
+                    drawCount += CountBundleDraws(bundles[i].Get());
+                }
+                break;
+            }
+
+            // Pass-wide state that EncodeParallelRenderPass replays on subordinate encoders.
+            case Command::SetViewport:
+            case Command::SetScissorRect:
+            case Command::SetStencilReference:
+            case Command::SetBlendConstant:
+                SkipCommand(&mCommands, type);
+                break;
+
+            default:
+                SkipCommand(&mCommands, type);
+                // Any inline draw-stream command, occlusion query or timestamp makes the pass
+                // ineligible: they would need a well-defined ordering against the bundles.
+                if (inRenderPass) {
+                    eligible = false;
+                }
+                break;
+        }
+    }
+}
+
+MaybeError CommandBuffer::EncodeParallelRenderPass(CommandRecordingContext* commandContext,
+                                                   MTLRenderPassDescriptor* mtlRenderPass) {
+    // GatherParallelRenderPassInfo checked that this pass contains only render bundles and the
+    // pass-wide state commands handled below.
+    bool enableVertexPulling = GetDevice()->IsToggleEnabled(Toggle::MetalEnableVertexPulling);
+    dawn::platform::WorkerTaskPool* workerTaskPool = GetDevice()->GetWorkerTaskPool();
+
+    commandContext->EndBlit();
+    id<MTLParallelRenderCommandEncoder> parallelEncoder =
+        commandContext->BeginParallelRender(mtlRenderPass);
+
+    InheritedRenderPassState inheritedState;
+    std::vector<std::unique_ptr<dawn::platform::WaitableEvent>> pendingBundles;
+
+    Command type;
+    while (mCommands.NextCommandId(&type)) {
+        switch (type) {
+            case Command::EndRenderPass: {
+                mCommands.NextCommand<EndRenderPassCmd>();
+
+                // The subordinate encoders must end encoding before the parallel encoder does.
+                for (auto& pendingBundle : pendingBundles) {
+                    pendingBundle->Wait();
+                }
+                commandContext->EndParallelRender();
+                return {};
+            }
+
+            case Command::SetStencilReference: {
+                SetStencilReferenceCmd* cmd = mCommands.NextCommand<SetStencilReferenceCmd>();
+                inheritedState.hasStencilReference = true;
+                inheritedState.stencilReference = cmd->reference;
+                break;
+            }
+
+            case Command::SetViewport: {
+                SetViewportCmd* cmd = mCommands.NextCommand<SetViewportCmd>();
+                inheritedState.hasViewport = true;
+                inheritedState.viewport.originX = cmd->x;
+                inheritedState.viewport.originY = cmd->y;
+                inheritedState.viewport.width = cmd->width;
+                inheritedState.viewport.height = cmd->height;
+                inheritedState.viewport.znear = cmd->minDepth;
+                inheritedState.viewport.zfar = cmd->maxDepth;
                 break;
             }
+
+            case Command::SetScissorRect: {
+                SetScissorRectCmd* cmd = mCommands.NextCommand<SetScissorRectCmd>();
+                inheritedState.hasScissorRect = true;
+                inheritedState.scissorRect.x = cmd->x;
+                inheritedState.scissorRect.y = cmd->y;
+                inheritedState.scissorRect.width = cmd->width;
+                inheritedState.scissorRect.height = cmd->height;
+                break;
+            }
+
+            case Command::SetBlendConstant: {
+                SetBlendConstantCmd* cmd = mCommands.NextCommand<SetBlendConstantCmd>();
+                inheritedState.hasBlendConstant = true;
+                inheritedState.blendConstant = cmd->color;
+                break;
+            }
+
+            case Command::ExecuteBundles: {
+                ExecuteBundlesCmd* cmd = mCommands.NextCommand<ExecuteBundlesCmd>();
+                auto bundles = mCommands.NextData<Ref<RenderBundleBase>>(cmd->count);
+
+                for (uint32_t i = 0; i < cmd->count; ++i) {
+                    // Subordinate encoders execute on the GPU in the order they are created
+                    // here, regardless of the order the workers encode them in.
+                    auto task = std::make_unique<BundleEncodingTask>();
+                    task->encoder = [parallelEncoder renderCommandEncoder];
+                    task->commands = bundles[i]->GetCommands();
+                    task->inheritedState = inheritedState;
+                    task->enableVertexPulling = enableVertexPulling;
+                    pendingBundles.push_back(
+                        workerTaskPool->PostWorkerTask(EncodeBundleWorkerTask, task.release()));
+                }
+                break;
+            }
+
+            default:
+                UNREACHABLE();
+                break;
         }
     }
 
@@ -33,6 +33,8 @@ class CommandRecordingContext : NonMovable {
     void MarkUsed();
     bool WasUsed() const;
 
+    void SetUntrackedFence(NSPRef<id<MTLFence>> fence);
+
     MaybeError PrepareNextCommandBuffer(id<MTLCommandQueue> queue);
     NSPRef<id<MTLCommandBuffer>> AcquireCommands();
 
@@ -45,11 +47,21 @@ class CommandRecordingContext : NonMovable {
     id<MTLRenderCommandEncoder> BeginRender(MTLRenderPassDescriptor* descriptor);
     void EndRender();
 
+    id<MTLParallelRenderCommandEncoder> BeginParallelRender(MTLRenderPassDescriptor* descriptor);
+    void EndParallelRender();
+
   private:
     NSPRef<id<MTLCommandBuffer>> mCommands;
     NSPRef<id<MTLBlitCommandEncoder>> mBlit;
     NSPRef<id<MTLComputeCommandEncoder>> mCompute;
     NSPRef<id<MTLRenderCommandEncoder>> mRender;
+    NSPRef<id<MTLParallelRenderCommandEncoder>> mParallelRender;
+
+    // Set when the MetalUseUntrackedHazardResources toggle is enabled. Resources are created
+    // without automatic hazard tracking, so every encoder waits for then updates this fence,
+    // which makes encoders execute in recording order.
+    NSPRef<id<MTLFence>> mUntrackedFence;
+
     bool mInEncoder = false;
     bool mUsed = false;
 };
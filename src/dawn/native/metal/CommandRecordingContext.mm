@@ -14,6 +14,8 @@
 
 #include "dawn/native/metal/CommandRecordingContext.h"
 
+#include <utility>
+
 #include "dawn/common/Assert.h"
 
 namespace dawn::native::metal {
@@ -32,6 +34,11 @@ id<MTLCommandBuffer> CommandRecordingContext::GetCommands() {
 void CommandRecordingContext::MarkUsed() {
     mUsed = true;
 }
+
+void CommandRecordingContext::SetUntrackedFence(NSPRef<id<MTLFence>> fence) {
+    ASSERT(mUntrackedFence == nullptr);
+    mUntrackedFence = std::move(fence);
+}
 bool CommandRecordingContext::WasUsed() const {
     return mUsed;
 }
@@ -65,6 +72,13 @@ NSPRef<id<MTLCommandBuffer>> CommandRecordingContext::AcquireCommands() {
 id<MTLBlitCommandEncoder> CommandRecordingContext::EnsureBlit() {
     ASSERT(mCommands != nullptr);
 
+    // Without automatic hazard tracking, successive commands recorded in the same blit encoder
+    // may overlap execution. End any open blit encoder so that each blit command gets its own
+    // encoder, ordered against the previous one by the fence chain.
+    if (mUntrackedFence != nullptr && mBlit != nullptr) {
+        EndBlit();
+    }
+
     if (mBlit == nullptr) {
         ASSERT(!mInEncoder);
         mInEncoder = true;
@@ -72,6 +86,11 @@ id<MTLBlitCommandEncoder> CommandRecordingContext::EnsureBlit() {
         // The encoder is created autoreleased. Retain it to avoid the autoreleasepool from
         // draining from under us.
         mBlit.Acquire([[*mCommands blitCommandEncoder] retain]);
+        if (mUntrackedFence != nullptr) {
+            if (@available(macOS 10.13, iOS 10.0, *)) {
+                [*mBlit waitForFence:mUntrackedFence.Get()];
+            }
+        }
     }
     return mBlit.Get();
 }
@@ -80,6 +99,11 @@ void CommandRecordingContext::EndBlit() {
     ASSERT(mCommands != nullptr);
 
     if (mBlit != nullptr) {
+        if (mUntrackedFence != nullptr) {
+            if (@available(macOS 10.13, iOS 10.0, *)) {
+                [*mBlit updateFence:mUntrackedFence.Get()];
+            }
+        }
         [*mBlit endEncoding];
         mBlit = nullptr;
         mInEncoder = false;
@@ -95,6 +119,11 @@ id<MTLComputeCommandEncoder> CommandRecordingContext::BeginCompute() {
     // The encoder is created autoreleased. Retain it to avoid the autoreleasepool from
     // draining from under us.
     mCompute.Acquire([[*mCommands computeCommandEncoder] retain]);
+    if (mUntrackedFence != nullptr) {
+        if (@available(macOS 10.13, iOS 10.0, *)) {
+            [*mCompute waitForFence:mUntrackedFence.Get()];
+        }
+    }
     return mCompute.Get();
 }
 
@@ -102,6 +131,11 @@ void CommandRecordingContext::EndCompute() {
     ASSERT(mCommands != nullptr);
     ASSERT(mCompute != nullptr);
 
+    if (mUntrackedFence != nullptr) {
+        if (@available(macOS 10.13, iOS 10.0, *)) {
+            [*mCompute updateFence:mUntrackedFence.Get()];
+        }
+    }
     [*mCompute endEncoding];
     mCompute = nullptr;
     mInEncoder = false;
@@ -117,6 +151,11 @@ id<MTLRenderCommandEncoder> CommandRecordingContext::BeginRender(
     // The encoder is created autoreleased. Retain it to avoid the autoreleasepool from
     // draining from under us.
     mRender.Acquire([[*mCommands renderCommandEncoderWithDescriptor:descriptor] retain]);
+    if (mUntrackedFence != nullptr) {
+        if (@available(macOS 10.13, iOS 10.0, *)) {
+            [*mRender waitForFence:mUntrackedFence.Get() beforeStages:MTLRenderStageVertex];
+        }
+    }
     return mRender.Get();
 }
 
@@ -124,9 +163,41 @@ void CommandRecordingContext::EndRender() {
     ASSERT(mCommands != nullptr);
     ASSERT(mRender != nullptr);
 
+    if (mUntrackedFence != nullptr) {
+        if (@available(macOS 10.13, iOS 10.0, *)) {
+            [*mRender updateFence:mUntrackedFence.Get() afterStages:MTLRenderStageFragment];
+        }
+    }
     [*mRender endEncoding];
     mRender = nullptr;
     mInEncoder = false;
 }
 
+id<MTLParallelRenderCommandEncoder> CommandRecordingContext::BeginParallelRender(
+    MTLRenderPassDescriptor* descriptor) {
+    ASSERT(mCommands != nullptr);
+    ASSERT(mParallelRender == nullptr);
+    ASSERT(!mInEncoder);
+    // Parallel encoding isn't used together with untracked resources, see
+    // GatherParallelRenderPassInfo.
+    ASSERT(mUntrackedFence == nullptr);
+
+    mInEncoder = true;
+    // The encoder is created autoreleased. Retain it to avoid the autoreleasepool from
+    // draining from under us.
+    mParallelRender.Acquire(
+        [[*mCommands parallelRenderCommandEncoderWithDescriptor:descriptor] retain]);
+    return mParallelRender.Get();
+}
+
+void CommandRecordingContext::EndParallelRender() {
+    ASSERT(mCommands != nullptr);
+    ASSERT(mParallelRender != nullptr);
+
+    // The caller must have already ended the subordinate encoders created from this encoder.
+    [*mParallelRender endEncoding];
+    mParallelRender = nullptr;
+    mInEncoder = false;
+}
+
 }  // namespace dawn::native::metal
@@ -15,8 +15,10 @@
 #include "dawn/native/metal/ComputePipelineMTL.h"
 
 #include "dawn/common/Math.h"
+#include "dawn/common/NSRef.h"
 #include "dawn/native/CreatePipelineAsyncTask.h"
 #include "dawn/native/metal/DeviceMTL.h"
+#include "dawn/native/metal/PipelineCacheMTL.h"
 #include "dawn/native/metal/ShaderModuleMTL.h"
 #include "dawn/native/metal/UtilsMetal.h"
 
@@ -43,15 +45,40 @@ MaybeError ComputePipeline::Initialize() {
     DAWN_TRY(CreateMTLFunction(computeStage, SingleShaderStage::Compute, ToBackend(GetLayout()),
                                &computeData));
 
+    // Creation goes through a descriptor rather than the function directly so that the
+    // device's binary archive can be attached, reusing GPU binaries compiled on previous runs.
+    NSRef<MTLComputePipelineDescriptor> descriptorRef =
+        AcquireNSRef([MTLComputePipelineDescriptor new]);
+    MTLComputePipelineDescriptor* descriptorMTL = descriptorRef.Get();
+    descriptorMTL.computeFunction = computeData.function.Get();
+
+    Ref<PipelineCache> pipelineCache;
+    if (@available(macOS 11.0, iOS 14.0, *)) {
+        pipelineCache = ToBackend(
+            GetDevice()->GetOrCreatePipelineCache(PipelineCache::DeviceArchiveKey(GetDevice())));
+        if (pipelineCache->GetBinaryArchive() != nil) {
+            descriptorMTL.binaryArchives = @[ pipelineCache->GetBinaryArchive() ];
+        }
+    }
+
     NSError* error = nullptr;
-    mMtlComputePipelineState.Acquire(
-        [mtlDevice newComputePipelineStateWithFunction:computeData.function.Get() error:&error]);
+    mMtlComputePipelineState.Acquire([mtlDevice
+        newComputePipelineStateWithDescriptor:descriptorMTL
+                                      options:MTLPipelineOptionNone
+                                   reflection:nil
+                                        error:&error]);
     if (error != nullptr) {
         return DAWN_INTERNAL_ERROR("Error creating pipeline state " +
                                    std::string([error.localizedDescription UTF8String]));
     }
     ASSERT(mMtlComputePipelineState != nil);
 
+    if (@available(macOS 11.0, iOS 14.0, *)) {
+        if (pipelineCache != nullptr) {
+            pipelineCache->AddComputePipelineFunctions(descriptorMTL);
+        }
+    }
+
     // Copy over the local workgroup size as it is passed to dispatch explicitly in Metal
     Origin3D localSize = GetStage(SingleShaderStage::Compute).metadata->localWorkgroupSize;
     mLocalWorkgroupSize = MTLSizeMake(localSize.x, localSize.y, localSize.z);
@@ -33,6 +33,7 @@
 namespace dawn::native::metal {
 
 struct KalmanInfo;
+class ResourceAllocatorManager;
 
 class Device final : public DeviceBase {
   public:
@@ -51,6 +52,8 @@ class Device final : public DeviceBase {
     CommandRecordingContext* GetPendingCommandContext();
     MaybeError SubmitPendingCommandBuffer();
 
+    ResourceAllocatorManager* GetResourceAllocatorManager() const;
+
     Ref<Texture> CreateTextureWrappingIOSurface(const ExternalImageDescriptor* descriptor,
                                                 IOSurfaceRef ioSurface);
     void WaitForCommandsToBeScheduled();
@@ -108,6 +111,9 @@ class Device final : public DeviceBase {
         const ComputePipelineDescriptor* descriptor) override;
     Ref<RenderPipelineBase> CreateUninitializedRenderPipelineImpl(
         const RenderPipelineDescriptor* descriptor) override;
+    // All pipelines share one binary archive backed cache per device, so the key passed by
+    // the first caller determines the blob the archive persists under.
+    Ref<PipelineCacheBase> GetOrCreatePipelineCacheImpl(const CacheKey& key) override;
     void InitializeComputePipelineAsyncImpl(Ref<ComputePipelineBase> computePipeline,
                                             WGPUCreateComputePipelineAsyncCallback callback,
                                             void* userdata) override;
@@ -122,11 +128,19 @@ class Device final : public DeviceBase {
 
     NSPRef<id<MTLDevice>> mMtlDevice;
     NSPRef<id<MTLCommandQueue>> mCommandQueue;
+    Ref<PipelineCache> mPipelineCache;
+    std::unique_ptr<ResourceAllocatorManager> mResourceAllocatorManager;
 
     CommandRecordingContext mCommandContext;
 
-    // The completed serial is updated in a Metal completion handler that can be fired on a
-    // different thread, so it needs to be atomic.
+    // The GPU signals this event with the serial of each command buffer as it completes, so
+    // completed serials are read directly off its signaled value instead of bouncing through
+    // per-command-buffer completion handlers.
+    NSPRef<id<MTLSharedEvent>> mSharedEvent API_AVAILABLE(macos(10.14), ios(12.0));
+
+    // The last completed serial this device observed. On systems without MTLSharedEvent it is
+    // updated from a Metal completion handler that can be fired on a different thread, so it
+    // needs to be atomic.
     std::atomic<uint64_t> mCompletedSerial;
 
     // mLastSubmittedCommands will be accessed in a Metal schedule handler that can be fired on
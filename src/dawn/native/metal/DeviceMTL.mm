@@ -25,10 +25,12 @@
 #include "dawn/native/metal/BufferMTL.h"
 #include "dawn/native/metal/CommandBufferMTL.h"
 #include "dawn/native/metal/ComputePipelineMTL.h"
+#include "dawn/native/metal/PipelineCacheMTL.h"
 #include "dawn/native/metal/PipelineLayoutMTL.h"
 #include "dawn/native/metal/QuerySetMTL.h"
 #include "dawn/native/metal/QueueMTL.h"
 #include "dawn/native/metal/RenderPipelineMTL.h"
+#include "dawn/native/metal/ResourceAllocatorManagerMTL.h"
 #include "dawn/native/metal/SamplerMTL.h"
 #include "dawn/native/metal/ShaderModuleMTL.h"
 #include "dawn/native/metal/StagingBufferMTL.h"
@@ -38,6 +40,7 @@
 #include "dawn/platform/DawnPlatform.h"
 #include "dawn/platform/tracing/TraceEvent.h"
 
+#include <algorithm>
 #include <type_traits>
 
 namespace dawn::native::metal {
@@ -130,8 +133,29 @@ MaybeError Device::Initialize(const DeviceDescriptor* descriptor) {
         return DAWN_INTERNAL_ERROR("Failed to allocate MTLCommandQueue.");
     }
 
+    if (@available(macOS 10.14, iOS 12.0, *)) {
+        mSharedEvent.Acquire([*mMtlDevice newSharedEvent]);
+        if (mSharedEvent == nil) {
+            return DAWN_INTERNAL_ERROR("Failed to allocate MTLSharedEvent.");
+        }
+    }
+
+    // When resources are created without automatic hazard tracking, a single fence chained
+    // through every encoder provides the ordering instead.
+    if (@available(macOS 10.15, iOS 13.0, *)) {
+        if (IsToggleEnabled(Toggle::MetalUseUntrackedHazardResources)) {
+            NSPRef<id<MTLFence>> fence = AcquireNSPRef([*mMtlDevice newFence]);
+            if (fence == nil) {
+                return DAWN_INTERNAL_ERROR("Failed to allocate MTLFence.");
+            }
+            mCommandContext.SetUntrackedFence(std::move(fence));
+        }
+    }
+
     DAWN_TRY(mCommandContext.PrepareNextCommandBuffer(*mCommandQueue));
 
+    mResourceAllocatorManager = std::make_unique<ResourceAllocatorManager>(this);
+
     if (IsFeatureEnabled(Feature::TimestampQuery) &&
         !IsToggleEnabled(Toggle::DisableTimestampQueryConversion)) {
         // Make a best guess of timestamp period based on device vendor info, and converge it to
@@ -152,7 +176,15 @@ MaybeError Device::Initialize(const DeviceDescriptor* descriptor) {
         }
     }
 
-    return DeviceBase::Initialize(AcquireRef(new Queue(this, &descriptor->defaultQueue)));
+    DAWN_TRY(DeviceBase::Initialize(AcquireRef(new Queue(this, &descriptor->defaultQueue))));
+
+    // Preload the binary archive from the blob cache now so that deserializing it is paid at
+    // device creation instead of on the first pipeline's critical path.
+    if (@available(macOS 11.0, iOS 14.0, *)) {
+        GetOrCreatePipelineCache(PipelineCache::DeviceArchiveKey(this));
+    }
+
+    return {};
 }
 
 void Device::InitTogglesFromDriver() {
@@ -229,6 +261,13 @@ void Device::InitTogglesFromDriver() {
     if (gpu_info::IsIntel(vendorId)) {
         SetToggle(Toggle::ApplyClearBigIntegerColorValueWithDraw, true);
     }
+
+    // Opting resources out of automatic hazard tracking requires MTLHazardTrackingMode on
+    // individual resources, which is only available on macOS 10.15 / iOS 13 and up.
+    if (@available(macOS 10.15, iOS 13.0, *)) {
+    } else {
+        ForceSetToggle(Toggle::MetalUseUntrackedHazardResources, false);
+    }
 }
 
 ResultOrError<Ref<BindGroupBase>> Device::CreateBindGroupImpl(
@@ -263,6 +302,12 @@ Ref<RenderPipelineBase> Device::CreateUninitializedRenderPipelineImpl(
     const RenderPipelineDescriptor* descriptor) {
     return RenderPipeline::CreateUninitialized(this, descriptor);
 }
+Ref<PipelineCacheBase> Device::GetOrCreatePipelineCacheImpl(const CacheKey& key) {
+    if (mPipelineCache == nullptr) {
+        mPipelineCache = PipelineCache::Create(this, key);
+    }
+    return mPipelineCache;
+}
 ResultOrError<Ref<SamplerBase>> Device::CreateSamplerImpl(const SamplerDescriptor* descriptor) {
     return Sampler::Create(this, descriptor);
 }
@@ -303,6 +348,29 @@ void Device::InitializeRenderPipelineAsyncImpl(Ref<RenderPipelineBase> renderPip
 
 ResultOrError<ExecutionSerial> Device::CheckAndUpdateCompletedSerials() {
     uint64_t frontendCompletedSerial{GetCompletedCommandSerial()};
+
+    if (@available(macOS 10.14, iOS 12.0, *)) {
+        // Each submit signals the shared event with its serial, so the latest completed serial
+        // is just the event's signaled value. The frontend can also artificially increase the
+        // serials past what was submitted, in which case its completed serial is ahead of the
+        // event.
+        uint64_t signaledSerial = [*mSharedEvent signaledValue];
+        uint64_t previous = mCompletedSerial.load();
+
+        // No completion handler is installed on this path, so the trace events paired with the
+        // BEGIN in SubmitPendingCommandBuffer are emitted here when completion is observed.
+        for (uint64_t serial = previous + 1; serial <= signaledSerial; serial++) {
+            TRACE_EVENT_ASYNC_END0(GetPlatform(), GPUWork, "DeviceMTL::SubmitPendingCommandBuffer",
+                                   serial);
+        }
+
+        uint64_t completed = std::max(signaledSerial, frontendCompletedSerial);
+        if (completed > previous) {
+            mCompletedSerial.store(completed);
+        }
+        return ExecutionSerial(mCompletedSerial.load());
+    }
+
     // sometimes we increase the serials, in which case the completed serial in
     // the device base will surpass the completed serial we have in the metal backend, so we
     // must update ours when we see that the completed serial from device base has
@@ -321,6 +389,14 @@ ResultOrError<ExecutionSerial> Device::CheckAndUpdateCompletedSerials() {
 MaybeError Device::TickImpl() {
     DAWN_TRY(SubmitPendingCommandBuffer());
 
+    mResourceAllocatorManager->Tick(GetCompletedCommandSerial());
+
+    // Serialize the binary archive at most once per tick so that pipeline creation itself
+    // never pays for it.
+    if (mPipelineCache != nullptr) {
+        DAWN_TRY(mPipelineCache->FlushIfDirty());
+    }
+
     // Just run timestamp period calculation when timestamp feature is enabled.
     if (IsFeatureEnabled(Feature::TimestampQuery)) {
         if (@available(macos 10.15, iOS 14.0, *)) {
@@ -340,6 +416,10 @@ id<MTLCommandQueue> Device::GetMTLQueue() {
     return mCommandQueue.Get();
 }
 
+ResourceAllocatorManager* Device::GetResourceAllocatorManager() const {
+    return mResourceAllocatorManager.get();
+}
+
 CommandRecordingContext* Device::GetPendingCommandContext() {
     mCommandContext.MarkUsed();
     return &mCommandContext;
@@ -374,16 +454,24 @@ MaybeError Device::SubmitPendingCommandBuffer() {
         }
     }];
 
-    // Update the completed serial once the completed handler is fired. Make a local copy of
-    // mLastSubmittedSerial so it is captured by value.
+    // Make a local copy of mLastSubmittedSerial so it is captured by value in the fallback
+    // completion handler below.
     ExecutionSerial pendingSerial = GetLastSubmittedCommandSerial();
-    // this ObjC block runs on a different thread
-    [*pendingCommands addCompletedHandler:^(id<MTLCommandBuffer>) {
-        TRACE_EVENT_ASYNC_END0(GetPlatform(), GPUWork, "DeviceMTL::SubmitPendingCommandBuffer",
-                               uint64_t(pendingSerial));
-        ASSERT(uint64_t(pendingSerial) > mCompletedSerial.load());
-        this->mCompletedSerial = uint64_t(pendingSerial);
-    }];
+    if (@available(macOS 10.14, iOS 12.0, *)) {
+        // Completion is observed by polling the event's signaled value in
+        // CheckAndUpdateCompletedSerials: no handler block is allocated per submit and there
+        // is no dispatch-queue hop between GPU completion and a CPU waiter seeing the serial.
+        [*pendingCommands encodeSignalEvent:*mSharedEvent value:uint64_t(pendingSerial)];
+    } else {
+        // Update the completed serial once the completed handler is fired.
+        // This ObjC block runs on a different thread.
+        [*pendingCommands addCompletedHandler:^(id<MTLCommandBuffer>) {
+            TRACE_EVENT_ASYNC_END0(GetPlatform(), GPUWork, "DeviceMTL::SubmitPendingCommandBuffer",
+                                   uint64_t(pendingSerial));
+            ASSERT(uint64_t(pendingSerial) > mCompletedSerial.load());
+            this->mCompletedSerial = uint64_t(pendingSerial);
+        }];
+    }
 
     TRACE_EVENT_ASYNC_BEGIN0(GetPlatform(), GPUWork, "DeviceMTL::SubmitPendingCommandBuffer",
                              uint64_t(pendingSerial));
@@ -491,6 +579,20 @@ void Device::DestroyImpl() {
     // Forget all pending commands.
     mCommandContext.AcquireCommands();
 
+    // Give pipelines compiled since the last tick a chance to persist before the device
+    // goes away.
+    if (mPipelineCache != nullptr) {
+        ConsumedError(mPipelineCache->FlushIfDirty());
+        mPipelineCache = nullptr;
+    }
+
+    // All commands are finished at this point, so the regions of every destroyed
+    // sub-allocated resource can be reclaimed before the heaps are released.
+    if (mResourceAllocatorManager != nullptr) {
+        mResourceAllocatorManager->Tick(GetCompletedCommandSerial());
+        mResourceAllocatorManager->DestroyPool();
+    }
+
     mCommandQueue = nullptr;
     mMtlDevice = nullptr;
 }
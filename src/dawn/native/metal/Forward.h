@@ -27,6 +27,8 @@ class CommandBuffer;
 class ComputePipeline;
 class Device;
 class Framebuffer;
+class Heap;
+class PipelineCache;
 class PipelineLayout;
 class QuerySet;
 class Queue;
@@ -46,10 +48,12 @@ struct MetalBackendTraits {
     using CommandBufferType = CommandBuffer;
     using ComputePipelineType = ComputePipeline;
     using DeviceType = Device;
+    using PipelineCacheType = PipelineCache;
     using PipelineLayoutType = PipelineLayout;
     using QuerySetType = QuerySet;
     using QueueType = Queue;
     using RenderPipelineType = RenderPipeline;
+    using ResourceHeapType = Heap;
     using SamplerType = Sampler;
     using ShaderModuleType = ShaderModule;
     using StagingBufferType = StagingBuffer;
@@ -0,0 +1,71 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_METAL_PIPELINECACHEMTL_H_
+#define SRC_DAWN_NATIVE_METAL_PIPELINECACHEMTL_H_
+
+#include "dawn/common/NSRef.h"
+#include "dawn/native/PipelineCache.h"
+
+#import <Metal/Metal.h>
+
+namespace dawn::native {
+class DeviceBase;
+}
+
+namespace dawn::native::metal {
+
+// Persists compiled pipeline functions across runs by wrapping an MTLBinaryArchive whose
+// serialized contents round-trip through the instance's BlobCache. The device keeps a single
+// archive that all pipelines register into. On OS versions without binary archive support the
+// cache is inert and pipelines compile as before.
+class PipelineCache final : public PipelineCacheBase {
+  public:
+    static Ref<PipelineCache> Create(DeviceBase* device, const CacheKey& key);
+
+    // Cache key under which the device's single binary archive is stored in the BlobCache.
+    static CacheKey DeviceArchiveKey(const DeviceBase* device);
+
+    DeviceBase* GetDevice() const;
+
+    // Returns nil when binary archives aren't supported or the archive failed to initialize.
+    API_AVAILABLE(macos(11.0), ios(14.0)) id<MTLBinaryArchive> GetBinaryArchive() const;
+
+    // Registers the pipeline functions of the descriptor into the archive so they are
+    // persisted by the next flush.
+    API_AVAILABLE(macos(11.0), ios(14.0))
+    void AddRenderPipelineFunctions(MTLRenderPipelineDescriptor* descriptor);
+    API_AVAILABLE(macos(11.0), ios(14.0))
+    void AddComputePipelineFunctions(MTLComputePipelineDescriptor* descriptor);
+
+    // Serializes the archive into the blob cache if anything was added since the last flush.
+    // Registering pipelines one by one and flushing once per tick keeps the serialization
+    // cost off the pipeline creation path.
+    MaybeError FlushIfDirty();
+
+  private:
+    PipelineCache(DeviceBase* device, const CacheKey& key);
+
+    void Initialize();
+    MaybeError SerializeToBlobImpl(Blob* blob) override;
+
+    DeviceBase* mDevice;
+    // id<MTLBinaryArchive>, type-erased so the member doesn't need an availability guard.
+    NSPRef<id> mBinaryArchive;
+    bool mDirty = false;
+};
+
+}  // namespace dawn::native::metal
+
+#endif  // SRC_DAWN_NATIVE_METAL_PIPELINECACHEMTL_H_
@@ -0,0 +1,148 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/metal/PipelineCacheMTL.h"
+
+#include <cstring>
+
+#include "dawn/native/Device.h"
+#include "dawn/native/metal/DeviceMTL.h"
+
+namespace dawn::native::metal {
+
+namespace {
+
+// MTLBinaryArchive can only be (de)serialized through a file URL, so blob contents
+// round-trip through a uniquely named file in the temporary directory.
+NSRef<NSURL> CreateTemporaryFileURL() {
+    NSString* filename =
+        [NSString stringWithFormat:@"dawn_binary_archive_%@",
+                                   [[NSProcessInfo processInfo] globallyUniqueString]];
+    NSString* path = [NSTemporaryDirectory() stringByAppendingPathComponent:filename];
+    return NSRef<NSURL>([NSURL fileURLWithPath:path]);
+}
+
+}  // anonymous namespace
+
+// static
+Ref<PipelineCache> PipelineCache::Create(DeviceBase* device, const CacheKey& key) {
+    Ref<PipelineCache> cache = AcquireRef(new PipelineCache(device, key));
+    cache->Initialize();
+    return cache;
+}
+
+// static
+CacheKey PipelineCache::DeviceArchiveKey(const DeviceBase* device) {
+    CacheKey key = device->GetCacheKey();
+    StreamIn(&key, std::string("MTLBinaryArchive"));
+    return key;
+}
+
+PipelineCache::PipelineCache(DeviceBase* device, const CacheKey& key)
+    : PipelineCacheBase(device->GetBlobCache(), key), mDevice(device) {}
+
+DeviceBase* PipelineCache::GetDevice() const {
+    return mDevice;
+}
+
+id<MTLBinaryArchive> PipelineCache::GetBinaryArchive() const {
+    return static_cast<id<MTLBinaryArchive>>(mBinaryArchive.Get());
+}
+
+void PipelineCache::AddRenderPipelineFunctions(MTLRenderPipelineDescriptor* descriptor) {
+    if (mBinaryArchive == nullptr) {
+        return;
+    }
+    NSError* error = nullptr;
+    if ([GetBinaryArchive() addRenderPipelineFunctionsWithDescriptor:descriptor error:&error]) {
+        mDirty = true;
+    }
+}
+
+void PipelineCache::AddComputePipelineFunctions(MTLComputePipelineDescriptor* descriptor) {
+    if (mBinaryArchive == nullptr) {
+        return;
+    }
+    NSError* error = nullptr;
+    if ([GetBinaryArchive() addComputePipelineFunctionsWithDescriptor:descriptor error:&error]) {
+        mDirty = true;
+    }
+}
+
+MaybeError PipelineCache::FlushIfDirty() {
+    if (!mDirty) {
+        return {};
+    }
+    mDirty = false;
+    return Flush();
+}
+
+MaybeError PipelineCache::SerializeToBlobImpl(Blob* blob) {
+    if (@available(macOS 11.0, iOS 14.0, *)) {
+        if (mBinaryArchive == nullptr) {
+            return {};
+        }
+
+        NSRef<NSURL> url = CreateTemporaryFileURL();
+        NSError* error = nullptr;
+        if (![GetBinaryArchive() serializeToURL:url.Get() error:&error]) {
+            // Not being able to persist the archive shouldn't fail pipeline creation.
+            return {};
+        }
+        NSData* data = [NSData dataWithContentsOfURL:url.Get()];
+        [[NSFileManager defaultManager] removeItemAtURL:url.Get() error:nil];
+        if (data != nullptr && data.length > 0) {
+            *blob = CreateBlob(data.length);
+            memcpy(blob->Data(), data.bytes, data.length);
+        }
+    }
+    return {};
+}
+
+void PipelineCache::Initialize() {
+    Blob blob = PipelineCacheBase::Initialize();
+
+    if (@available(macOS 11.0, iOS 14.0, *)) {
+        id<MTLDevice> mtlDevice = ToBackend(mDevice)->GetMTLDevice();
+
+        NSRef<NSURL> url;
+        NSRef<MTLBinaryArchiveDescriptor> descriptorRef =
+            AcquireNSRef([MTLBinaryArchiveDescriptor new]);
+        if (!blob.Empty()) {
+            url = CreateTemporaryFileURL();
+            NSData* data = [NSData dataWithBytes:blob.Data() length:blob.Size()];
+            if ([data writeToURL:url.Get() atomically:YES]) {
+                [*descriptorRef setUrl:url.Get()];
+            }
+        }
+
+        NSError* error = nullptr;
+        mBinaryArchive = AcquireNSPRef<id>(
+            [mtlDevice newBinaryArchiveWithDescriptor:descriptorRef.Get() error:&error]);
+        if (mBinaryArchive == nullptr) {
+            // A corrupt cached blob shouldn't fail device creation; fall back to a fresh
+            // archive and let it be overwritten by the next flush.
+            [*descriptorRef setUrl:nil];
+            error = nullptr;
+            mBinaryArchive = AcquireNSPRef<id>(
+                [mtlDevice newBinaryArchiveWithDescriptor:descriptorRef.Get() error:&error]);
+        }
+
+        if (url != nullptr) {
+            [[NSFileManager defaultManager] removeItemAtURL:url.Get() error:nil];
+        }
+    }
+}
+
+}  // namespace dawn::native::metal
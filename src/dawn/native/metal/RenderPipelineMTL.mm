@@ -14,9 +14,12 @@
 
 #include "dawn/native/metal/RenderPipelineMTL.h"
 
+#include <memory>
+
 #include "dawn/native/CreatePipelineAsyncTask.h"
 #include "dawn/native/VertexFormat.h"
 #include "dawn/native/metal/DeviceMTL.h"
+#include "dawn/native/metal/PipelineCacheMTL.h"
 #include "dawn/native/metal/PipelineLayoutMTL.h"
 #include "dawn/native/metal/ShaderModuleMTL.h"
 #include "dawn/native/metal/TextureMTL.h"
@@ -337,12 +340,27 @@ MaybeError RenderPipeline::Initialize() {
     }
     descriptorMTL.vertexDescriptor = vertexDesc.Get();
 
+    // Start the library compiles for all stages before waiting on any of them so the Metal
+    // compiler service works on them concurrently instead of one round trip per stage.
     const PerStage<ProgrammableStage>& allStages = GetAllStages();
     const ProgrammableStage& vertexStage = allStages[wgpu::ShaderStage::Vertex];
     ShaderModule::MetalFunctionData vertexData;
-    DAWN_TRY(CreateMTLFunction(vertexStage, SingleShaderStage::Vertex, ToBackend(GetLayout()),
-                               &vertexData, 0xFFFFFFFF, this));
+    std::unique_ptr<ShaderModule::InFlightFunctionCreation> vertexCreation;
+    DAWN_TRY_ASSIGN(vertexCreation,
+                    BeginCreateMTLFunction(vertexStage, SingleShaderStage::Vertex,
+                                           ToBackend(GetLayout()), &vertexData, 0xFFFFFFFF, this));
+
+    ShaderModule::MetalFunctionData fragmentData;
+    std::unique_ptr<ShaderModule::InFlightFunctionCreation> fragmentCreation;
+    if (GetStageMask() & wgpu::ShaderStage::Fragment) {
+        const ProgrammableStage& fragmentStage = allStages[wgpu::ShaderStage::Fragment];
+        DAWN_TRY_ASSIGN(fragmentCreation,
+                        BeginCreateMTLFunction(fragmentStage, SingleShaderStage::Fragment,
+                                               ToBackend(GetLayout()), &fragmentData,
+                                               GetSampleMask()));
+    }
 
+    DAWN_TRY(ToBackend(vertexStage.module.Get())->FinishCreateFunction(vertexCreation.get()));
     descriptorMTL.vertexFunction = vertexData.function.Get();
     if (vertexData.needsStorageBufferLength) {
         mStagesRequiringStorageBufferLength |= wgpu::ShaderStage::Vertex;
@@ -350,9 +368,8 @@ MaybeError RenderPipeline::Initialize() {
 
     if (GetStageMask() & wgpu::ShaderStage::Fragment) {
         const ProgrammableStage& fragmentStage = allStages[wgpu::ShaderStage::Fragment];
-        ShaderModule::MetalFunctionData fragmentData;
-        DAWN_TRY(CreateMTLFunction(fragmentStage, SingleShaderStage::Fragment,
-                                   ToBackend(GetLayout()), &fragmentData, GetSampleMask()));
+        DAWN_TRY(
+            ToBackend(fragmentStage.module.Get())->FinishCreateFunction(fragmentCreation.get()));
 
         descriptorMTL.fragmentFunction = fragmentData.function.Get();
         if (fragmentData.needsStorageBufferLength) {
@@ -386,6 +403,17 @@ MaybeError RenderPipeline::Initialize() {
     descriptorMTL.sampleCount = GetSampleCount();
     descriptorMTL.alphaToCoverageEnabled = IsAlphaToCoverageEnabled();
 
+    // Attach the device's binary archive so that functions compiled on previous runs are
+    // reused, and register this descriptor so the next flush persists it.
+    Ref<PipelineCache> pipelineCache;
+    if (@available(macOS 11.0, iOS 14.0, *)) {
+        pipelineCache = ToBackend(
+            GetDevice()->GetOrCreatePipelineCache(PipelineCache::DeviceArchiveKey(GetDevice())));
+        if (pipelineCache->GetBinaryArchive() != nil) {
+            descriptorMTL.binaryArchives = @[ pipelineCache->GetBinaryArchive() ];
+        }
+    }
+
     NSError* error = nullptr;
     mMtlRenderPipelineState =
         AcquireNSPRef([mtlDevice newRenderPipelineStateWithDescriptor:descriptorMTL error:&error]);
@@ -395,6 +423,12 @@ MaybeError RenderPipeline::Initialize() {
     }
     ASSERT(mMtlRenderPipelineState != nil);
 
+    if (@available(macOS 11.0, iOS 14.0, *)) {
+        if (pipelineCache != nullptr) {
+            pipelineCache->AddRenderPipelineFunctions(descriptorMTL);
+        }
+    }
+
     // Create depth stencil state and cache it, fetch the cached depth stencil state when we
     // call setDepthStencilState() for a given render pipeline in CommandEncoder, in order
     // to improve performance.
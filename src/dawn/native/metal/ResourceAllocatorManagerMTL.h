@@ -0,0 +1,82 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_METAL_RESOURCEALLOCATORMANAGERMTL_H_
+#define SRC_DAWN_NATIVE_METAL_RESOURCEALLOCATORMANAGERMTL_H_
+
+#include <array>
+#include <memory>
+
+#include "dawn/common/SerialQueue.h"
+#include "dawn/native/Error.h"
+#include "dawn/native/IntegerTypes.h"
+#include "dawn/native/ResourceMemoryAllocation.h"
+
+#import <Metal/Metal.h>
+
+namespace dawn::native::metal {
+
+class Device;
+
+// The kinds of MTLHeaps that sub-allocated resources are placed in, one per storage mode that
+// Dawn creates resources with. Metal heaps don't restrict which resource types may share a
+// heap, so a single kind covers all GPU-only buffers and textures.
+enum ResourceHeapKind {
+    Shared,   // Mappable buffers.
+    Private,  // GPU-only buffers and textures.
+
+    EnumCount,
+    InvalidEnum = EnumCount,
+};
+
+// Manages sub-allocation of resources into placement MTLHeaps, following the structure the
+// other backends use for device memory: a buddy allocator hands out regions of large heaps,
+// the heaps themselves are pooled and reused, and freed regions only become available for
+// reuse once the commands using the old resource have completed on the GPU.
+class ResourceAllocatorManager {
+  public:
+    explicit ResourceAllocatorManager(Device* device);
+    ~ResourceAllocatorManager();
+
+    // Returns a region of an MTLHeap to place a resource in, or an allocation with
+    // AllocationMethod::kInvalid when the request is not suitable for sub-allocation and the
+    // caller should create a standalone resource instead.
+    ResultOrError<ResourceMemoryAllocation> AllocateMemory(MTLStorageMode storageMode,
+                                                           uint64_t size,
+                                                           uint64_t alignment);
+
+    void DeallocateMemory(ResourceMemoryAllocation* allocation);
+
+    void Tick(ExecutionSerial completedSerial);
+
+    void DestroyPool();
+
+  private:
+    class SingleKindAllocator;
+
+    Device* mDevice;
+
+    // Explicit-placement heaps require macOS 10.15 / iOS 13; without them every resource is
+    // created standalone.
+    bool mPlacementHeapsSupported = false;
+
+    std::array<std::unique_ptr<SingleKindAllocator>, ResourceHeapKind::EnumCount>
+        mAllocatorsPerKind;
+
+    SerialQueue<ExecutionSerial, ResourceMemoryAllocation> mSubAllocationsToDelete;
+};
+
+}  // namespace dawn::native::metal
+
+#endif  // SRC_DAWN_NATIVE_METAL_RESOURCEALLOCATORMANAGERMTL_H_
@@ -0,0 +1,200 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/metal/ResourceAllocatorManagerMTL.h"
+
+#include <utility>
+
+#include "dawn/native/BuddyMemoryAllocator.h"
+#include "dawn/native/PooledResourceMemoryAllocator.h"
+#include "dawn/native/ResourceHeapAllocator.h"
+#include "dawn/native/metal/DeviceMTL.h"
+#include "dawn/native/metal/ResourceHeapMTL.h"
+
+namespace dawn::native::metal {
+
+namespace {
+
+// TODO(crbug.com/dawn/849): This is a hardcoded heurstic to choose when to
+// suballocate but it should ideally depend on the size of the memory heaps and other
+// factors.
+constexpr uint64_t kMaxSizeForSubAllocation = 4ull * 1024ull * 1024ull;  // 4MiB
+
+// Have each heap of the buddy system allocate at least a couple resources of the maximum
+// sub-allocated size.
+constexpr uint64_t kResourceHeapSize = 2 * kMaxSizeForSubAllocation;
+
+// Bounds the buddy system's virtual address tree for one heap kind; no memory is reserved
+// up front.
+constexpr uint64_t kMaxHeapSystemSize = 32ull * 1024ull * 1024ull * 1024ull;  // 32GB
+
+ResourceHeapKind GetResourceHeapKind(MTLStorageMode storageMode) {
+    switch (storageMode) {
+        case MTLStorageModeShared:
+            return Shared;
+        case MTLStorageModePrivate:
+            return Private;
+        default:
+            UNREACHABLE();
+    }
+}
+
+MTLStorageMode GetStorageMode(ResourceHeapKind kind) {
+    switch (kind) {
+        case Shared:
+            return MTLStorageModeShared;
+        case Private:
+            return MTLStorageModePrivate;
+        default:
+            UNREACHABLE();
+    }
+}
+
+}  // namespace
+
+// SingleKindAllocator combines the buddy system with the MTLHeap allocation it is a client
+// of, for a single heap kind.
+
+class ResourceAllocatorManager::SingleKindAllocator : public ResourceHeapAllocator {
+  public:
+    SingleKindAllocator(Device* device, ResourceHeapKind kind)
+        : mDevice(device),
+          mKind(kind),
+          mPooledMemoryAllocator(this),
+          mBuddySystem(kMaxHeapSystemSize, kResourceHeapSize, &mPooledMemoryAllocator) {}
+    ~SingleKindAllocator() override = default;
+
+    void DestroyPool() { mPooledMemoryAllocator.DestroyPool(); }
+
+    ResultOrError<ResourceMemoryAllocation> AllocateMemory(uint64_t size, uint64_t alignment) {
+        return mBuddySystem.Allocate(size, alignment);
+    }
+
+    void DeallocateMemory(const ResourceMemoryAllocation& allocation) {
+        mBuddySystem.Deallocate(allocation);
+    }
+
+    // Implementation of the MemoryAllocator interface to be a client of BuddyMemoryAllocator
+
+    ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(uint64_t size) override {
+        if (@available(macOS 10.15, iOS 13.0, *)) {
+            MTLStorageMode storageMode = GetStorageMode(mKind);
+
+            NSRef<MTLHeapDescriptor> descriptorRef = AcquireNSRef([MTLHeapDescriptor new]);
+            MTLHeapDescriptor* descriptor = descriptorRef.Get();
+            descriptor.size = size;
+            descriptor.storageMode = storageMode;
+            descriptor.type = MTLHeapTypePlacement;
+            // Placement heaps default to untracked hazard tracking and resources placed in
+            // them must match the heap's mode, so keep Metal's automatic tracking unless the
+            // fence chain provides the ordering instead.
+            descriptor.hazardTrackingMode =
+                mDevice->IsToggleEnabled(Toggle::MetalUseUntrackedHazardResources)
+                    ? MTLHazardTrackingModeUntracked
+                    : MTLHazardTrackingModeTracked;
+
+            NSPRef<id<MTLHeap>> mtlHeap =
+                AcquireNSPRef([mDevice->GetMTLDevice() newHeapWithDescriptor:descriptor]);
+            if (mtlHeap == nil) {
+                return DAWN_OUT_OF_MEMORY_ERROR("Failed to allocate MTLHeap");
+            }
+            return {std::make_unique<Heap>(std::move(mtlHeap), storageMode)};
+        }
+
+        // The manager only sub-allocates when placement heaps are available.
+        UNREACHABLE();
+    }
+
+    void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> heap) override {
+        // Dropping the reference releases the MTLHeap. Every region of the heap was reclaimed
+        // through Tick() before the buddy system released it, so the GPU is done with it.
+    }
+
+  private:
+    Device* mDevice;
+    ResourceHeapKind mKind;
+    PooledResourceMemoryAllocator mPooledMemoryAllocator;
+    BuddyMemoryAllocator mBuddySystem;
+};
+
+// Implementation of ResourceAllocatorManager
+
+ResourceAllocatorManager::ResourceAllocatorManager(Device* device) : mDevice(device) {
+    // Explicit-placement heaps are required so that the buddy allocator controls where every
+    // resource lands; the automatic heap type would leave placement to the driver.
+    if (@available(macOS 10.15, iOS 13.0, *)) {
+        mPlacementHeapsSupported = true;
+        for (uint32_t i = 0; i < ResourceHeapKind::EnumCount; i++) {
+            mAllocatorsPerKind[i] =
+                std::make_unique<SingleKindAllocator>(device, static_cast<ResourceHeapKind>(i));
+        }
+    }
+}
+
+ResourceAllocatorManager::~ResourceAllocatorManager() = default;
+
+ResultOrError<ResourceMemoryAllocation> ResourceAllocatorManager::AllocateMemory(
+    MTLStorageMode storageMode,
+    uint64_t size,
+    uint64_t alignment) {
+    if (!mPlacementHeapsSupported || size >= kMaxSizeForSubAllocation ||
+        mDevice->IsToggleEnabled(Toggle::DisableResourceSuballocation)) {
+        return ResourceMemoryAllocation{};
+    }
+
+    return mAllocatorsPerKind[GetResourceHeapKind(storageMode)]->AllocateMemory(size, alignment);
+}
+
+void ResourceAllocatorManager::DeallocateMemory(ResourceMemoryAllocation* allocation) {
+    switch (allocation->GetInfo().mMethod) {
+        // Resources that were created standalone never went through the manager.
+        case AllocationMethod::kInvalid:
+            break;
+
+        // Sub-allocations aren't freed immediately, otherwise another resource could be placed
+        // in the same region of the heap while the GPU is still using the old one.
+        case AllocationMethod::kSubAllocated:
+            mSubAllocationsToDelete.Enqueue(*allocation, mDevice->GetPendingCommandSerial());
+            break;
+
+        default:
+            UNREACHABLE();
+            break;
+    }
+
+    // Invalidate the allocation in case the client accidentally uses it after deallocating.
+    allocation->Invalidate();
+}
+
+void ResourceAllocatorManager::Tick(ExecutionSerial completedSerial) {
+    for (const ResourceMemoryAllocation& allocation :
+         mSubAllocationsToDelete.IterateUpTo(completedSerial)) {
+        ASSERT(allocation.GetInfo().mMethod == AllocationMethod::kSubAllocated);
+        MTLStorageMode storageMode = ToBackend(allocation.GetResourceHeap())->GetStorageMode();
+
+        mAllocatorsPerKind[GetResourceHeapKind(storageMode)]->DeallocateMemory(allocation);
+    }
+
+    mSubAllocationsToDelete.ClearUpTo(completedSerial);
+}
+
+void ResourceAllocatorManager::DestroyPool() {
+    for (auto& allocator : mAllocatorsPerKind) {
+        if (allocator != nullptr) {
+            allocator->DestroyPool();
+        }
+    }
+}
+
+}  // namespace dawn::native::metal
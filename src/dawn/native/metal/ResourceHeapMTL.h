@@ -0,0 +1,44 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_METAL_RESOURCEHEAPMTL_H_
+#define SRC_DAWN_NATIVE_METAL_RESOURCEHEAPMTL_H_
+
+#include "dawn/common/NSRef.h"
+#include "dawn/native/ResourceHeap.h"
+
+#import <Metal/Metal.h>
+
+namespace dawn::native::metal {
+
+// Wrapper for the MTLHeap that sub-allocated resources are placed in.
+class Heap final : public ResourceHeapBase {
+  public:
+    Heap(NSPRef<id<MTLHeap>> mtlHeap, MTLStorageMode storageMode);
+    ~Heap() override = default;
+
+    API_AVAILABLE(macos(10.13), ios(10.0)) id<MTLHeap> GetMTLHeap() const;
+
+    // The storage mode is cached at creation so that reclamation code can find the owning
+    // allocator without messaging the heap.
+    MTLStorageMode GetStorageMode() const;
+
+  private:
+    NSPRef<id<MTLHeap>> mMtlHeap;
+    MTLStorageMode mStorageMode;
+};
+
+}  // namespace dawn::native::metal
+
+#endif  // SRC_DAWN_NATIVE_METAL_RESOURCEHEAPMTL_H_
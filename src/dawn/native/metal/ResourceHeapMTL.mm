@@ -0,0 +1,32 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/metal/ResourceHeapMTL.h"
+
+#include <utility>
+
+namespace dawn::native::metal {
+
+Heap::Heap(NSPRef<id<MTLHeap>> mtlHeap, MTLStorageMode storageMode)
+    : mMtlHeap(std::move(mtlHeap)), mStorageMode(storageMode) {}
+
+id<MTLHeap> Heap::GetMTLHeap() const {
+    return mMtlHeap.Get();
+}
+
+MTLStorageMode Heap::GetStorageMode() const {
+    return mStorageMode;
+}
+
+}  // namespace dawn::native::metal
@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_METAL_SHADERMODULEMTL_H_
 #define SRC_DAWN_NATIVE_METAL_SHADERMODULEMTL_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -44,6 +45,23 @@ class ShaderModule final : public ShaderModuleBase {
         std::vector<uint32_t> workgroupAllocations;
     };
 
+    // An MTLLibrary compile that has been handed to the Metal compiler service but not waited
+    // on yet. CreateFunction is split around it so pipelines with multiple stages can keep all
+    // of their library compiles in flight at once instead of blocking on each round trip in
+    // turn. The destructor waits for an unfinished compile because the completion handler
+    // writes into this state.
+    struct InFlightFunctionCreation {
+        ~InFlightFunctionCreation();
+
+        MetalFunctionData* out = nullptr;
+        std::string remappedEntryPointName;
+        NSPRef<id> constantValues;
+        dispatch_semaphore_t compileDone = nullptr;
+        bool waited = false;
+        NSPRef<id<MTLLibrary>> library;
+        NSRef<NSError> compileError;
+    };
+
     // MTLFunctionConstantValues needs @available tag to compile
     // Use id (like void*) in function signature as workaround and do static cast inside
     MaybeError CreateFunction(const char* entryPointName,
@@ -54,11 +72,26 @@ class ShaderModule final : public ShaderModuleBase {
                               uint32_t sampleMask = 0xFFFFFFFF,
                               const RenderPipeline* renderPipeline = nullptr);
 
+    // Translates the shader to MSL and starts the library compile asynchronously. |out| and the
+    // returned state must stay alive until FinishCreateFunction (or the state's destructor) has
+    // run.
+    ResultOrError<std::unique_ptr<InFlightFunctionCreation>> BeginCreateFunction(
+        const char* entryPointName,
+        SingleShaderStage stage,
+        const PipelineLayout* layout,
+        MetalFunctionData* out,
+        id constantValues = nil,
+        uint32_t sampleMask = 0xFFFFFFFF,
+        const RenderPipeline* renderPipeline = nullptr);
+
+    // Waits for the library compile started by BeginCreateFunction and creates the MTLFunction.
+    MaybeError FinishCreateFunction(InFlightFunctionCreation* creation);
+
   private:
     ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor);
     ~ShaderModule() override;
     MaybeError Initialize(ShaderModuleParseResult* parseResult,
-                          OwnedCompilationMessages* compilationMessages);
+                          OwnedCompilationMessages* compilationMessages) override;
 };
 
 }  // namespace dawn::native::metal
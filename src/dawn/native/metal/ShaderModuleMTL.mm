@@ -28,7 +28,9 @@
 
 #include <tint/tint.h>
 
+#include <memory>
 #include <sstream>
+#include <utility>
 
 namespace dawn::native::metal {
 namespace {
@@ -272,6 +274,18 @@ ResultOrError<CacheResult<MslCompilation>> TranslateToMSL(DeviceBase* device,
 
 }  // namespace
 
+ShaderModule::InFlightFunctionCreation::~InFlightFunctionCreation() {
+    if (compileDone != nullptr) {
+        // The completion handler writes into this state, so if it hasn't been waited on (for
+        // example because the compile of a sibling stage failed) wait for it before tearing
+        // the state down.
+        if (!waited) {
+            dispatch_semaphore_wait(compileDone, DISPATCH_TIME_FOREVER);
+        }
+        dispatch_release(compileDone);
+    }
+}
+
 MaybeError ShaderModule::CreateFunction(const char* entryPointName,
                                         SingleShaderStage stage,
                                         const PipelineLayout* layout,
@@ -279,7 +293,22 @@ MaybeError ShaderModule::CreateFunction(const char* entryPointName,
                                         id constantValuesPointer,
                                         uint32_t sampleMask,
                                         const RenderPipeline* renderPipeline) {
-    TRACE_EVENT0(GetDevice()->GetPlatform(), General, "ShaderModuleMTL::CreateFunction");
+    std::unique_ptr<InFlightFunctionCreation> creation;
+    DAWN_TRY_ASSIGN(creation,
+                    BeginCreateFunction(entryPointName, stage, layout, out, constantValuesPointer,
+                                        sampleMask, renderPipeline));
+    return FinishCreateFunction(creation.get());
+}
+
+ResultOrError<std::unique_ptr<ShaderModule::InFlightFunctionCreation>>
+ShaderModule::BeginCreateFunction(const char* entryPointName,
+                                  SingleShaderStage stage,
+                                  const PipelineLayout* layout,
+                                  ShaderModule::MetalFunctionData* out,
+                                  id constantValuesPointer,
+                                  uint32_t sampleMask,
+                                  const RenderPipeline* renderPipeline) {
+    TRACE_EVENT0(GetDevice()->GetPlatform(), General, "ShaderModuleMTL::BeginCreateFunction");
 
     ASSERT(!IsError());
     ASSERT(out);
@@ -305,34 +334,74 @@ MaybeError ShaderModule::CreateFunction(const char* entryPointName,
         }
     }
     auto mtlDevice = ToBackend(GetDevice())->GetMTLDevice();
-    NSError* error = nullptr;
 
-    NSPRef<id<MTLLibrary>> library;
+    auto creation = std::make_unique<InFlightFunctionCreation>();
+    creation->out = out;
+    creation->remappedEntryPointName = mslCompilation->remappedEntryPointName;
+    creation->constantValues = constantValuesPointer;
+    creation->compileDone = dispatch_semaphore_create(0);
+
+    // Only a raw pointer is captured because it isn't clear how ObjC blocks handle types with
+    // copy / move constructors being referenced in the block. The state stays alive until the
+    // handler has signaled the semaphore: FinishCreateFunction and the destructor both wait on
+    // it before the state can be destroyed.
+    InFlightFunctionCreation* state = creation.get();
     {
         TRACE_EVENT0(GetDevice()->GetPlatform(), General, "MTLDevice::newLibraryWithSource");
-        library = AcquireNSPRef([mtlDevice newLibraryWithSource:mslSource.Get()
-                                                        options:compileOptions.Get()
-                                                          error:&error]);
+        [mtlDevice newLibraryWithSource:mslSource.Get()
+                                options:compileOptions.Get()
+                      completionHandler:^(id<MTLLibrary> library, NSError* error) {
+                          state->library = library;
+                          state->compileError = error;
+                          dispatch_semaphore_signal(state->compileDone);
+                      }];
+    }
+
+    if (BlobCache* cache = GetDevice()->GetBlobCache()) {
+        cache->EnsureStored(mslCompilation);
+    }
+
+    if (GetDevice()->IsToggleEnabled(Toggle::MetalEnableVertexPulling) &&
+        GetEntryPoint(entryPointName).usedVertexInputs.any()) {
+        out->needsStorageBufferLength = true;
     }
 
-    if (error != nullptr) {
+    return std::move(creation);
+}
+
+MaybeError ShaderModule::FinishCreateFunction(InFlightFunctionCreation* creation) {
+    ASSERT(creation != nullptr);
+    ASSERT(!creation->waited);
+
+    {
+        TRACE_EVENT0(GetDevice()->GetPlatform(), General, "ShaderModuleMTL::WaitForLibrary");
+        dispatch_semaphore_wait(creation->compileDone, DISPATCH_TIME_FOREVER);
+        creation->waited = true;
+    }
+
+    if (creation->compileError != nullptr) {
+        NSError* error = creation->compileError.Get();
         DAWN_INVALID_IF(error.code != MTLLibraryErrorCompileWarning,
                         "Unable to create library object: %s.",
                         [error.localizedDescription UTF8String]);
     }
+    id<MTLLibrary> library = creation->library.Get();
     ASSERT(library != nil);
 
+    ShaderModule::MetalFunctionData* out = creation->out;
     NSRef<NSString> name = AcquireNSRef(
-        [[NSString alloc] initWithUTF8String:mslCompilation->remappedEntryPointName.c_str()]);
+        [[NSString alloc] initWithUTF8String:creation->remappedEntryPointName.c_str()]);
 
     {
         TRACE_EVENT0(GetDevice()->GetPlatform(), General, "MTLLibrary::newFunctionWithName");
-        if (constantValuesPointer != nil) {
+        if (creation->constantValues != nil) {
             if (@available(macOS 10.12, *)) {
-                MTLFunctionConstantValues* constantValues = constantValuesPointer;
-                out->function = AcquireNSPRef([*library newFunctionWithName:name.Get()
-                                                             constantValues:constantValues
-                                                                      error:&error]);
+                MTLFunctionConstantValues* constantValues =
+                    static_cast<MTLFunctionConstantValues*>(creation->constantValues.Get());
+                NSError* error = nullptr;
+                out->function = AcquireNSPRef([library newFunctionWithName:name.Get()
+                                                            constantValues:constantValues
+                                                                     error:&error]);
                 if (error != nullptr) {
                     if (error.code != MTLLibraryErrorCompileWarning) {
                         return DAWN_VALIDATION_ERROR(std::string("Function compile error: ") +
@@ -344,19 +413,10 @@ MaybeError ShaderModule::CreateFunction(const char* entryPointName,
                 UNREACHABLE();
             }
         } else {
-            out->function = AcquireNSPRef([*library newFunctionWithName:name.Get()]);
+            out->function = AcquireNSPRef([library newFunctionWithName:name.Get()]);
         }
     }
 
-    if (BlobCache* cache = GetDevice()->GetBlobCache()) {
-        cache->EnsureStored(mslCompilation);
-    }
-
-    if (GetDevice()->IsToggleEnabled(Toggle::MetalEnableVertexPulling) &&
-        GetEntryPoint(entryPointName).usedVertexInputs.any()) {
-        out->needsStorageBufferLength = true;
-    }
-
     return {};
 }
 }  // namespace dawn::native::metal
@@ -25,7 +25,7 @@ namespace dawn::native::metal {
 
 class Device;
 
-class StagingBuffer : public StagingBufferBase {
+class StagingBuffer final : public StagingBufferBase {
   public:
     StagingBuffer(size_t size, Device* device);
     ~StagingBuffer() override;
@@ -23,6 +23,7 @@
 #include "dawn/common/CoreFoundationRef.h"
 #include "dawn/common/NSRef.h"
 #include "dawn/native/DawnNative.h"
+#include "dawn/native/ResourceMemoryAllocation.h"
 
 namespace dawn::native::metal {
 
@@ -74,6 +75,10 @@ class Texture final : public TextureBase {
 
     NSPRef<id<MTLTexture>> mMtlTexture;
 
+    // Only valid when the texture was placed in an MTLHeap by the ResourceAllocatorManager;
+    // kInvalid for standalone, wrapped and IOSurface-backed textures.
+    ResourceMemoryAllocation mMemoryAllocation;
+
     MTLTextureUsage mMtlUsage;
     CFRef<IOSurfaceRef> mIOSurface = nullptr;
 };
@@ -20,6 +20,8 @@
 #include "dawn/native/DynamicUploader.h"
 #include "dawn/native/EnumMaskIterator.h"
 #include "dawn/native/metal/DeviceMTL.h"
+#include "dawn/native/metal/ResourceAllocatorManagerMTL.h"
+#include "dawn/native/metal/ResourceHeapMTL.h"
 #include "dawn/native/metal/StagingBufferMTL.h"
 #include "dawn/native/metal/UtilsMetal.h"
 
@@ -648,6 +650,24 @@ NSRef<MTLTextureDescriptor> Texture::CreateMetalTextureDescriptor() const {
     mtlDesc.mipmapLevelCount = GetNumMipLevels();
     mtlDesc.storageMode = MTLStorageModePrivate;
 
+    // Transient attachments stay in tile memory and are never backed by system or GPU memory.
+    // The frontend restricts them to render attachment usage with Clear/Discard operations,
+    // which is exactly what MTLStorageModeMemoryless supports.
+    if (GetInternalUsage() & kTransientAttachment) {
+        if (@available(macOS 11.0, iOS 10.0, *)) {
+            mtlDesc.storageMode = MTLStorageModeMemoryless;
+        }
+    }
+
+    // The fence chain in the CommandRecordingContext provides the ordering instead of
+    // automatic hazard tracking. Wrapped and IOSurface textures stay tracked because other
+    // users of the underlying resource rely on it.
+    if (GetDevice()->IsToggleEnabled(Toggle::MetalUseUntrackedHazardResources)) {
+        if (@available(macOS 10.15, iOS 13.0, *)) {
+            mtlDesc.hazardTrackingMode = MTLHazardTrackingModeUntracked;
+        }
+    }
+
     // Choose the correct MTLTextureType and paper over differences in how the array layer count
     // is specified.
     switch (GetDimension()) {
@@ -716,13 +736,44 @@ MaybeError Texture::InitializeAsInternalTexture(const TextureDescriptor* descrip
 
     NSRef<MTLTextureDescriptor> mtlDesc = CreateMetalTextureDescriptor();
     mMtlUsage = [*mtlDesc usage];
-    mMtlTexture = AcquireNSPRef([device->GetMTLDevice() newTextureWithDescriptor:mtlDesc.Get()]);
+
+    // Try to place the texture in an MTLHeap first so that frequent allocations don't each
+    // pay for a standalone MTLTexture; fall back to one when the request is not suitable for
+    // sub-allocation (or placement heaps are unavailable). Memoryless textures are never
+    // backed by memory and so have nothing to place in a heap.
+    if (@available(macOS 10.15, iOS 13.0, *)) {
+        if ([*mtlDesc storageMode] == MTLStorageModePrivate) {
+            MTLSizeAndAlign sizeAndAlign =
+                [device->GetMTLDevice() heapTextureSizeAndAlignWithDescriptor:mtlDesc.Get()];
+
+            ResourceMemoryAllocation allocation;
+            DAWN_TRY_ASSIGN(allocation,
+                            device->GetResourceAllocatorManager()->AllocateMemory(
+                                MTLStorageModePrivate, sizeAndAlign.size, sizeAndAlign.align));
+            if (allocation.GetInfo().mMethod == AllocationMethod::kSubAllocated) {
+                Heap* heap = ToBackend(allocation.GetResourceHeap());
+                uint64_t offset = allocation.GetOffset();
+                mMtlTexture = AcquireNSPRef(
+                    [heap->GetMTLHeap() newTextureWithDescriptor:mtlDesc.Get() offset:offset]);
+                if (mMtlTexture == nil) {
+                    device->GetResourceAllocatorManager()->DeallocateMemory(&allocation);
+                    return DAWN_OUT_OF_MEMORY_ERROR("Failed to allocate texture.");
+                }
+                mMemoryAllocation = allocation;
+            }
+        }
+    }
 
     if (mMtlTexture == nil) {
-        return DAWN_OUT_OF_MEMORY_ERROR("Failed to allocate texture.");
+        mMtlTexture =
+            AcquireNSPRef([device->GetMTLDevice() newTextureWithDescriptor:mtlDesc.Get()]);
+        if (mMtlTexture == nil) {
+            return DAWN_OUT_OF_MEMORY_ERROR("Failed to allocate texture.");
+        }
     }
 
-    if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting)) {
+    if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting) &&
+        !(GetInternalUsage() & kTransientAttachment)) {
         DAWN_TRY(ClearTexture(device->GetPendingCommandContext(), GetAllSubresources(),
                               TextureBase::ClearValue::NonZero));
     }
@@ -772,6 +823,8 @@ void Texture::DestroyImpl() {
     TextureBase::DestroyImpl();
     mMtlTexture = nullptr;
     mIOSurface = nullptr;
+    // No-op for standalone textures; heap regions are reclaimed once the GPU is done.
+    ToBackend(GetDevice())->GetResourceAllocatorManager()->DeallocateMemory(&mMemoryAllocation);
 }
 
 id<MTLTexture> Texture::GetMTLTexture() const {
@@ -15,6 +15,8 @@
 #ifndef SRC_DAWN_NATIVE_METAL_UTILSMETAL_H_
 #define SRC_DAWN_NATIVE_METAL_UTILSMETAL_H_
 
+#include <memory>
+
 #include "dawn/native/dawn_platform.h"
 #include "dawn/native/metal/DeviceMTL.h"
 #include "dawn/native/metal/ShaderModuleMTL.h"
@@ -77,6 +79,17 @@ MaybeError CreateMTLFunction(const ProgrammableStage& programmableStage,
                              uint32_t sampleMask = 0xFFFFFFFF,
                              const RenderPipeline* renderPipeline = nullptr);
 
+// Variant of CreateMTLFunction that only starts the library compile. Finish the returned state
+// with ShaderModule::FinishCreateFunction. This lets a caller with several stages keep all of
+// their compiles in flight in the Metal compiler service at the same time.
+ResultOrError<std::unique_ptr<ShaderModule::InFlightFunctionCreation>> BeginCreateMTLFunction(
+    const ProgrammableStage& programmableStage,
+    SingleShaderStage singleShaderStage,
+    PipelineLayout* pipelineLayout,
+    ShaderModule::MetalFunctionData* functionData,
+    uint32_t sampleMask = 0xFFFFFFFF,
+    const RenderPipeline* renderPipeline = nullptr);
+
 // Allow use MTLStoreActionStoreAndMultismapleResolve because the logic in the backend is
 // first to compute what the "best" Metal render pass descriptor is, then fix it up if we
 // are not on macOS 10.12 (i.e. the EmulateStoreAndMSAAResolve toggle is on).
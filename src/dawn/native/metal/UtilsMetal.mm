@@ -14,6 +14,9 @@
 
 #include "dawn/native/metal/UtilsMetal.h"
 
+#include <memory>
+#include <utility>
+
 #include "dawn/common/Assert.h"
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/Pipeline.h"
@@ -329,13 +332,29 @@ MaybeError CreateMTLFunction(const ProgrammableStage& programmableStage,
                              ShaderModule::MetalFunctionData* functionData,
                              uint32_t sampleMask,
                              const RenderPipeline* renderPipeline) {
+    std::unique_ptr<ShaderModule::InFlightFunctionCreation> creation;
+    DAWN_TRY_ASSIGN(creation,
+                    BeginCreateMTLFunction(programmableStage, singleShaderStage, pipelineLayout,
+                                           functionData, sampleMask, renderPipeline));
+    return ToBackend(programmableStage.module.Get())->FinishCreateFunction(creation.get());
+}
+
+ResultOrError<std::unique_ptr<ShaderModule::InFlightFunctionCreation>> BeginCreateMTLFunction(
+    const ProgrammableStage& programmableStage,
+    SingleShaderStage singleShaderStage,
+    PipelineLayout* pipelineLayout,
+    ShaderModule::MetalFunctionData* functionData,
+    uint32_t sampleMask,
+    const RenderPipeline* renderPipeline) {
     ShaderModule* shaderModule = ToBackend(programmableStage.module.Get());
     const char* shaderEntryPoint = programmableStage.entryPoint.c_str();
     const auto& entryPointMetadata = programmableStage.module->GetEntryPoint(shaderEntryPoint);
+    std::unique_ptr<ShaderModule::InFlightFunctionCreation> creation;
     if (entryPointMetadata.overrides.size() == 0) {
-        DAWN_TRY(shaderModule->CreateFunction(shaderEntryPoint, singleShaderStage, pipelineLayout,
-                                              functionData, nil, sampleMask, renderPipeline));
-        return {};
+        DAWN_TRY_ASSIGN(creation, shaderModule->BeginCreateFunction(
+                                      shaderEntryPoint, singleShaderStage, pipelineLayout,
+                                      functionData, nil, sampleMask, renderPipeline));
+        return std::move(creation);
     }
 
     if (@available(macOS 10.12, *)) {
@@ -412,13 +431,16 @@ MaybeError CreateMTLFunction(const ProgrammableStage& programmableStage,
                                            atIndex:moduleConstant.id];
         }
 
-        DAWN_TRY(shaderModule->CreateFunction(shaderEntryPoint, singleShaderStage, pipelineLayout,
-                                              functionData, constantValues.Get(), sampleMask,
-                                              renderPipeline));
+        // The constant values are retained by the returned state, so they stay alive until the
+        // compile is finished even though this NSRef goes out of scope.
+        DAWN_TRY_ASSIGN(creation, shaderModule->BeginCreateFunction(
+                                      shaderEntryPoint, singleShaderStage, pipelineLayout,
+                                      functionData, constantValues.Get(), sampleMask,
+                                      renderPipeline));
     } else {
         UNREACHABLE();
     }
-    return {};
+    return std::move(creation);
 }
 
 MaybeError EncodeMetalRenderPass(Device* device,
@@ -14,6 +14,8 @@
 
 #include "dawn/native/null/DeviceNull.h"
 
+#include <algorithm>
+#include <chrono>
 #include <limits>
 #include <utility>
 
@@ -22,6 +24,7 @@
 #include "dawn/native/ErrorData.h"
 #include "dawn/native/Instance.h"
 #include "dawn/native/Surface.h"
+#include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native::null {
 
@@ -119,7 +122,7 @@ MaybeError Device::Initialize(const DeviceDescriptor* descriptor) {
 
 ResultOrError<Ref<BindGroupBase>> Device::CreateBindGroupImpl(
     const BindGroupDescriptor* descriptor) {
-    return AcquireRef(new BindGroup(this, descriptor));
+    return ToBackend(descriptor->layout)->AllocateBindGroup(this, descriptor);
 }
 ResultOrError<Ref<BindGroupLayoutBase>> Device::CreateBindGroupLayoutImpl(
     const BindGroupLayoutDescriptor* descriptor,
@@ -197,6 +200,13 @@ void Device::DestroyImpl() {
 
 MaybeError Device::WaitForIdleForDestruction() {
     mPendingOperations.clear();
+
+    // Finish the simulated timeline instantly so destruction doesn't wait on it.
+    while (!mSimulatedCompletionTimes.empty()) {
+        mLastSimulatedCompletedSerial = mSimulatedCompletionTimes.front().first;
+        mSimulatedCompletionTimes.pop();
+    }
+
     return {};
 }
 
@@ -247,7 +257,18 @@ MaybeError Device::TickImpl() {
 }
 
 ResultOrError<ExecutionSerial> Device::CheckAndUpdateCompletedSerials() {
-    return GetLastSubmittedCommandSerial();
+    if (!IsToggleEnabled(Toggle::NullBackendSimulateTimeline)) {
+        return GetLastSubmittedCommandSerial();
+    }
+
+    // Report the last serial whose simulated completion time has passed.
+    const uint64_t nowNs = GetTimelineNowNs();
+    while (!mSimulatedCompletionTimes.empty() &&
+           mSimulatedCompletionTimes.front().second <= nowNs) {
+        mLastSimulatedCompletedSerial = mSimulatedCompletionTimes.front().first;
+        mSimulatedCompletionTimes.pop();
+    }
+    return mLastSimulatedCompletedSerial;
 }
 
 void Device::AddPendingOperation(std::unique_ptr<PendingOperation> operation) {
@@ -255,6 +276,11 @@ void Device::AddPendingOperation(std::unique_ptr<PendingOperation> operation) {
 }
 
 MaybeError Device::SubmitPendingOperations() {
+    const bool simulateTimeline = IsToggleEnabled(Toggle::NullBackendSimulateTimeline);
+    if (simulateTimeline) {
+        mPendingSimulatedCostNs += mSimulatedCosts.commandNs * mPendingOperations.size();
+    }
+
     for (auto& operation : mPendingOperations) {
         operation->Execute();
     }
@@ -263,32 +289,63 @@ MaybeError Device::SubmitPendingOperations() {
     DAWN_TRY(CheckPassedSerials());
     IncrementLastSubmittedCommandSerial();
 
+    if (simulateTimeline) {
+        // The submission completes once the simulated GPU has worked through both its backlog
+        // and this submission's cost.
+        mSimulatedIdleTimeNs =
+            std::max(mSimulatedIdleTimeNs, GetTimelineNowNs()) + mPendingSimulatedCostNs;
+        mPendingSimulatedCostNs = 0;
+        mSimulatedCompletionTimes.push({GetLastSubmittedCommandSerial(), mSimulatedIdleTimeNs});
+    }
+
     return {};
 }
 
-// BindGroupDataHolder
+void Device::SetSimulatedTimelineCosts(const SimulatedTimelineCosts& costs) {
+    mSimulatedCosts = costs;
+}
 
-BindGroupDataHolder::BindGroupDataHolder(size_t size)
-    : mBindingDataAllocation(malloc(size))  // malloc is guaranteed to return a
-                                            // pointer aligned enough for the allocation
-{}
+void Device::AccumulateSimulatedCost(uint64_t costNs) {
+    mPendingSimulatedCostNs += costNs;
+}
 
-BindGroupDataHolder::~BindGroupDataHolder() {
-    free(mBindingDataAllocation);
+uint64_t Device::GetTimelineNowNs() const {
+    double platformTime = GetPlatform()->MonotonicallyIncreasingTime();
+    if (platformTime != 0) {
+        return static_cast<uint64_t>(platformTime * 1e9);
+    }
+    // The default platform doesn't implement a clock; fall back to a real one.
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
 }
 
 // BindGroup
 
 BindGroup::BindGroup(DeviceBase* device, const BindGroupDescriptor* descriptor)
-    : BindGroupDataHolder(descriptor->layout->GetBindingDataSize()),
-      BindGroupBase(device, descriptor, mBindingDataAllocation) {}
+    : BindGroupBase(this, device, descriptor) {}
+
+void BindGroup::DestroyImpl() {
+    BindGroupBase::DestroyImpl();
+    ToBackend(GetLayout())->DeallocateBindGroup(this);
+}
 
 // BindGroupLayout
 
 BindGroupLayout::BindGroupLayout(DeviceBase* device,
                                  const BindGroupLayoutDescriptor* descriptor,
                                  PipelineCompatibilityToken pipelineCompatibilityToken)
-    : BindGroupLayoutBase(device, descriptor, pipelineCompatibilityToken) {}
+    : BindGroupLayoutBase(device, descriptor, pipelineCompatibilityToken),
+      mBindGroupAllocator(MakeFrontendBindGroupAllocator<BindGroup>(4096)) {}
+
+Ref<BindGroup> BindGroupLayout::AllocateBindGroup(DeviceBase* device,
+                                                  const BindGroupDescriptor* descriptor) {
+    return AcquireRef(mBindGroupAllocator.Allocate(device, descriptor));
+}
+
+void BindGroupLayout::DeallocateBindGroup(BindGroup* bindGroup) {
+    mBindGroupAllocator.Deallocate(bindGroup);
+}
 
 // Buffer
 
@@ -342,6 +399,42 @@ void Buffer::DestroyImpl() {
 CommandBuffer::CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor)
     : CommandBufferBase(encoder, descriptor) {}
 
+uint64_t CommandBuffer::ComputeSimulatedCostNs(const SimulatedTimelineCosts& costs) {
+    uint64_t costNs = 0;
+
+    Command type;
+    while (mCommands.NextCommandId(&type)) {
+        switch (type) {
+            case Command::Draw:
+            case Command::DrawIndexed:
+            case Command::DrawIndirect:
+            case Command::DrawIndexedIndirect:
+                costNs += costs.drawNs;
+                break;
+
+            case Command::Dispatch:
+            case Command::DispatchIndirect:
+                costNs += costs.dispatchNs;
+                break;
+
+            case Command::ClearBuffer:
+            case Command::CopyBufferToBuffer:
+            case Command::CopyBufferToTexture:
+            case Command::CopyTextureToBuffer:
+            case Command::CopyTextureToTexture:
+                costNs += costs.copyNs;
+                break;
+
+            default:
+                costNs += costs.commandNs;
+                break;
+        }
+        SkipCommand(&mCommands, type);
+    }
+
+    return costNs;
+}
+
 // QuerySet
 
 QuerySet::QuerySet(Device* device, const QuerySetDescriptor* descriptor)
@@ -353,13 +446,22 @@ Queue::Queue(Device* device, const QueueDescriptor* descriptor) : QueueBase(devi
 
 Queue::~Queue() {}
 
-MaybeError Queue::SubmitImpl(uint32_t, CommandBufferBase* const*) {
+MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
     Device* device = ToBackend(GetDevice());
 
     // The Vulkan, D3D12 and Metal implementation all tick the device here,
     // for testing purposes we should also tick in the null implementation.
     DAWN_TRY(device->Tick());
 
+    if (device->IsToggleEnabled(Toggle::NullBackendSimulateTimeline)) {
+        const SimulatedTimelineCosts& costs = device->mSimulatedCosts;
+        uint64_t costNs = costs.submitOverheadNs;
+        for (uint32_t i = 0; i < commandCount; ++i) {
+            costNs += ToBackend(commands[i])->ComputeSimulatedCostNs(costs);
+        }
+        device->AccumulateSimulatedCost(costNs);
+    }
+
     return device->SubmitPendingOperations();
 }
 
@@ -16,8 +16,13 @@
 #define SRC_DAWN_NATIVE_NULL_DEVICENULL_H_
 
 #include <memory>
+#include <queue>
+#include <utility>
 #include <vector>
 
+#include "dawn/common/PlacementAllocated.h"
+#include "dawn/native/NullBackend.h"
+#include "dawn/common/SlabAllocator.h"
 #include "dawn/native/Adapter.h"
 #include "dawn/native/BindGroup.h"
 #include "dawn/native/BindGroupLayout.h"
@@ -103,6 +108,13 @@ class Device final : public DeviceBase {
     void AddPendingOperation(std::unique_ptr<PendingOperation> operation);
     MaybeError SubmitPendingOperations();
 
+    // Simulated GPU timeline, used when the null_backend_simulate_timeline toggle is enabled.
+    // Submissions are charged a cost from mSimulatedCosts and complete once the simulated GPU
+    // has worked through them, instead of instantly.
+    void SetSimulatedTimelineCosts(const SimulatedTimelineCosts& costs);
+    void AccumulateSimulatedCost(uint64_t costNs);
+    uint64_t GetTimelineNowNs() const;
+
     ResultOrError<std::unique_ptr<StagingBufferBase>> CreateStagingBuffer(size_t size) override;
     MaybeError CopyFromStagingToBuffer(StagingBufferBase* source,
                                        uint64_t sourceOffset,
@@ -164,9 +176,18 @@ class Device final : public DeviceBase {
 
     static constexpr uint64_t kMaxMemoryUsage = 512 * 1024 * 1024;
     size_t mMemoryUsage = 0;
+
+    // State of the simulated timeline: the cost model, the cost accumulated for the next
+    // submission, the time at which the simulated GPU drains its backlog, the completion time
+    // of each in-flight serial and the last serial whose completion time has passed.
+    SimulatedTimelineCosts mSimulatedCosts;
+    uint64_t mPendingSimulatedCostNs = 0;
+    uint64_t mSimulatedIdleTimeNs = 0;
+    std::queue<std::pair<ExecutionSerial, uint64_t>> mSimulatedCompletionTimes;
+    ExecutionSerial mLastSimulatedCompletedSerial{0};
 };
 
-class Adapter : public AdapterBase {
+class Adapter final : public AdapterBase {
   public:
     explicit Adapter(InstanceBase* instance);
     ~Adapter() override;
@@ -185,24 +206,14 @@ class Adapter : public AdapterBase {
     ResultOrError<Ref<DeviceBase>> CreateDeviceImpl(const DeviceDescriptor* descriptor) override;
 };
 
-// Helper class so |BindGroup| can allocate memory for its binding data,
-// before calling the BindGroupBase base class constructor.
-class BindGroupDataHolder {
-  protected:
-    explicit BindGroupDataHolder(size_t size);
-    ~BindGroupDataHolder();
-
-    void* mBindingDataAllocation;
-};
-
-// We don't have the complexity of placement-allocation of bind group data in
-// the Null backend. This class, keeps the binding data in a separate allocation for simplicity.
-class BindGroup final : private BindGroupDataHolder, public BindGroupBase {
+class BindGroup final : public BindGroupBase, public PlacementAllocated {
   public:
     BindGroup(DeviceBase* device, const BindGroupDescriptor* descriptor);
 
   private:
     ~BindGroup() override = default;
+
+    void DestroyImpl() override;
 };
 
 class BindGroupLayout final : public BindGroupLayoutBase {
@@ -211,8 +222,13 @@ class BindGroupLayout final : public BindGroupLayoutBase {
                     const BindGroupLayoutDescriptor* descriptor,
                     PipelineCompatibilityToken pipelineCompatibilityToken);
 
+    Ref<BindGroup> AllocateBindGroup(DeviceBase* device, const BindGroupDescriptor* descriptor);
+    void DeallocateBindGroup(BindGroup* bindGroup);
+
   private:
     ~BindGroupLayout() override = default;
+
+    SlabAllocator<BindGroup> mBindGroupAllocator;
 };
 
 class Buffer final : public BufferBase {
@@ -240,6 +256,9 @@ class Buffer final : public BufferBase {
 class CommandBuffer final : public CommandBufferBase {
   public:
     CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor);
+
+    // Walks the recorded commands and adds up their simulated GPU cost.
+    uint64_t ComputeSimulatedCostNs(const SimulatedTimelineCosts& costs);
 };
 
 class QuerySet final : public QuerySetBase {
@@ -279,7 +298,7 @@ class ShaderModule final : public ShaderModuleBase {
     using ShaderModuleBase::ShaderModuleBase;
 
     MaybeError Initialize(ShaderModuleParseResult* parseResult,
-                          OwnedCompilationMessages* compilationMessages);
+                          OwnedCompilationMessages* compilationMessages) override;
 };
 
 class SwapChain final : public NewSwapChainBase {
@@ -324,7 +343,7 @@ class NativeSwapChainImpl {
     wgpu::TextureFormat GetPreferredFormat() const;
 };
 
-class StagingBuffer : public StagingBufferBase {
+class StagingBuffer final : public StagingBufferBase {
   public:
     StagingBuffer(size_t size, Device* device);
     ~StagingBuffer() override;
@@ -335,7 +354,7 @@ class StagingBuffer : public StagingBufferBase {
     std::unique_ptr<uint8_t[]> mBuffer;
 };
 
-class Texture : public TextureBase {
+class Texture final : public TextureBase {
   public:
     Texture(DeviceBase* device, const TextureDescriptor* descriptor, TextureState state);
 };
@@ -29,4 +29,9 @@ DawnSwapChainImplementation CreateNativeSwapChainImpl() {
     return impl;
 }
 
+void SetSimulatedTimelineCosts(WGPUDevice device, const SimulatedTimelineCosts& costs) {
+    Device* backendDevice = ToBackend(FromAPI(device));
+    backendDevice->SetSimulatedTimelineCosts(costs);
+}
+
 }  // namespace dawn::native::null
@@ -21,7 +21,7 @@
 
 namespace dawn::native::opengl {
 
-class Adapter : public AdapterBase {
+class Adapter final : public AdapterBase {
   public:
     Adapter(InstanceBase* instance, wgpu::BackendType backendType);
 
@@ -22,7 +22,7 @@
 
 namespace dawn::native::opengl {
 
-class Backend : public BackendConnection {
+class Backend final : public BackendConnection {
   public:
     Backend(InstanceBase* instance, wgpu::BackendType backendType);
 
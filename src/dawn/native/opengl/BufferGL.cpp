@@ -15,6 +15,7 @@
 #include "dawn/native/opengl/BufferGL.h"
 
 #include <algorithm>
+#include <atomic>
 #include <utility>
 #include <vector>
 
@@ -23,6 +24,15 @@
 
 namespace dawn::native::opengl {
 
+namespace {
+
+uint64_t GetNextBufferUniqueId() {
+    static std::atomic<uint64_t> sNextUniqueId{1};
+    return sNextUniqueId.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace
+
 // Buffer
 
 // static
@@ -38,7 +48,7 @@ ResultOrError<Ref<Buffer>> Buffer::CreateInternalBuffer(Device* device,
 }
 
 Buffer::Buffer(Device* device, const BufferDescriptor* descriptor)
-    : BufferBase(device, descriptor) {
+    : BufferBase(device, descriptor), mUniqueId(GetNextBufferUniqueId()) {
     const OpenGLFunctions& gl = device->GetGL();
     // Allocate at least 4 bytes so clamped accesses are always in bounds.
     mAllocatedSize = std::max(GetSize(), uint64_t(4u));
@@ -71,6 +81,10 @@ GLuint Buffer::GetHandle() const {
     return mBuffer;
 }
 
+uint64_t Buffer::GetUniqueId() const {
+    return mUniqueId;
+}
+
 bool Buffer::EnsureDataInitialized() {
     if (!NeedsInitialization()) {
         return false;
@@ -33,6 +33,11 @@ class Buffer final : public BufferBase {
 
     GLuint GetHandle() const;
 
+    // A process-wide unique id for this buffer. GL buffer names are recycled after deletion,
+    // so caches that outlive buffer objects (like the per-pipeline VAO cache) must key on this
+    // id instead of the GL name.
+    uint64_t GetUniqueId() const;
+
     bool EnsureDataInitialized();
     bool EnsureDataInitializedAsDestination(uint64_t offset, uint64_t size);
     bool EnsureDataInitializedAsDestination(const CopyTextureToBufferCmd* copy);
@@ -50,6 +55,7 @@ class Buffer final : public BufferBase {
     void InitializeToZero();
 
     GLuint mBuffer = 0;
+    const uint64_t mUniqueId;
     void* mMappedData = nullptr;
 };
 
@@ -52,94 +52,10 @@ GLenum IndexFormatType(wgpu::IndexFormat format) {
     UNREACHABLE();
 }
 
-GLenum VertexFormatType(wgpu::VertexFormat format) {
-    switch (format) {
-        case wgpu::VertexFormat::Uint8x2:
-        case wgpu::VertexFormat::Uint8x4:
-        case wgpu::VertexFormat::Unorm8x2:
-        case wgpu::VertexFormat::Unorm8x4:
-            return GL_UNSIGNED_BYTE;
-        case wgpu::VertexFormat::Sint8x2:
-        case wgpu::VertexFormat::Sint8x4:
-        case wgpu::VertexFormat::Snorm8x2:
-        case wgpu::VertexFormat::Snorm8x4:
-            return GL_BYTE;
-        case wgpu::VertexFormat::Uint16x2:
-        case wgpu::VertexFormat::Uint16x4:
-        case wgpu::VertexFormat::Unorm16x2:
-        case wgpu::VertexFormat::Unorm16x4:
-            return GL_UNSIGNED_SHORT;
-        case wgpu::VertexFormat::Sint16x2:
-        case wgpu::VertexFormat::Sint16x4:
-        case wgpu::VertexFormat::Snorm16x2:
-        case wgpu::VertexFormat::Snorm16x4:
-            return GL_SHORT;
-        case wgpu::VertexFormat::Float16x2:
-        case wgpu::VertexFormat::Float16x4:
-            return GL_HALF_FLOAT;
-        case wgpu::VertexFormat::Float32:
-        case wgpu::VertexFormat::Float32x2:
-        case wgpu::VertexFormat::Float32x3:
-        case wgpu::VertexFormat::Float32x4:
-            return GL_FLOAT;
-        case wgpu::VertexFormat::Uint32:
-        case wgpu::VertexFormat::Uint32x2:
-        case wgpu::VertexFormat::Uint32x3:
-        case wgpu::VertexFormat::Uint32x4:
-            return GL_UNSIGNED_INT;
-        case wgpu::VertexFormat::Sint32:
-        case wgpu::VertexFormat::Sint32x2:
-        case wgpu::VertexFormat::Sint32x3:
-        case wgpu::VertexFormat::Sint32x4:
-            return GL_INT;
-        default:
-            UNREACHABLE();
-    }
-}
-
-GLboolean VertexFormatIsNormalized(wgpu::VertexFormat format) {
-    switch (format) {
-        case wgpu::VertexFormat::Unorm8x2:
-        case wgpu::VertexFormat::Unorm8x4:
-        case wgpu::VertexFormat::Snorm8x2:
-        case wgpu::VertexFormat::Snorm8x4:
-        case wgpu::VertexFormat::Unorm16x2:
-        case wgpu::VertexFormat::Unorm16x4:
-        case wgpu::VertexFormat::Snorm16x2:
-        case wgpu::VertexFormat::Snorm16x4:
-            return GL_TRUE;
-        default:
-            return GL_FALSE;
-    }
-}
-
-bool VertexFormatIsInt(wgpu::VertexFormat format) {
-    switch (format) {
-        case wgpu::VertexFormat::Uint8x2:
-        case wgpu::VertexFormat::Uint8x4:
-        case wgpu::VertexFormat::Sint8x2:
-        case wgpu::VertexFormat::Sint8x4:
-        case wgpu::VertexFormat::Uint16x2:
-        case wgpu::VertexFormat::Uint16x4:
-        case wgpu::VertexFormat::Sint16x2:
-        case wgpu::VertexFormat::Sint16x4:
-        case wgpu::VertexFormat::Uint32:
-        case wgpu::VertexFormat::Uint32x2:
-        case wgpu::VertexFormat::Uint32x3:
-        case wgpu::VertexFormat::Uint32x4:
-        case wgpu::VertexFormat::Sint32:
-        case wgpu::VertexFormat::Sint32x2:
-        case wgpu::VertexFormat::Sint32x3:
-        case wgpu::VertexFormat::Sint32x4:
-            return true;
-        default:
-            return false;
-    }
-}
-
 // Vertex buffers and index buffers are implemented as part of an OpenGL VAO that
 // corresponds to a VertexState. On the contrary in Dawn they are part of the global state.
-// This means that we have to re-apply these buffers on a VertexState change.
+// The pipeline caches one VAO per set of bound buffers, so applying a vertex state change is
+// a single glBindVertexArray except the first time a combination is seen.
 class VertexStateBufferBindingTracker {
   public:
     void OnSetIndexBuffer(BufferBase* buffer) {
@@ -159,60 +75,47 @@ class VertexStateBufferBindingTracker {
         }
 
         mIndexBufferDirty = true;
-        mDirtyVertexBuffers |= pipeline->GetVertexBufferSlotsUsed();
+        mVertexStateDirty = true;
 
         mLastPipeline = pipeline;
     }
 
-    void Apply(const OpenGLFunctions& gl) {
+    void Apply(const OpenGLFunctions& gl, PersistentPipelineState* persistentPipelineState) {
+        if (mVertexStateDirty ||
+            (mDirtyVertexBuffers & mLastPipeline->GetVertexBufferSlotsUsed()).any()) {
+            GLuint vao = ToBackend(mLastPipeline)
+                             ->GetVAOForVertexBuffers(mVertexBuffers, mVertexBufferOffsets,
+                                                      persistentPipelineState);
+            if (vao != mLastVAO) {
+                // The GL_ELEMENT_ARRAY_BUFFER binding is part of the VAO, so binding a
+                // different VAO invalidates the index buffer binding.
+                mIndexBufferDirty = true;
+                mLastVAO = vao;
+            }
+            mVertexStateDirty = false;
+            mDirtyVertexBuffers.reset();
+        }
+
         if (mIndexBufferDirty && mIndexBuffer != nullptr) {
             gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer->GetHandle());
             mIndexBufferDirty = false;
         }
-
-        for (VertexBufferSlot slot :
-             IterateBitSet(mDirtyVertexBuffers & mLastPipeline->GetVertexBufferSlotsUsed())) {
-            for (VertexAttributeLocation location :
-                 IterateBitSet(ToBackend(mLastPipeline)->GetAttributesUsingVertexBuffer(slot))) {
-                const VertexAttributeInfo& attribute = mLastPipeline->GetAttribute(location);
-
-                GLuint attribIndex = static_cast<GLuint>(static_cast<uint8_t>(location));
-                GLuint buffer = mVertexBuffers[slot]->GetHandle();
-                uint64_t offset = mVertexBufferOffsets[slot];
-
-                const VertexBufferInfo& vertexBuffer = mLastPipeline->GetVertexBuffer(slot);
-                uint32_t components = GetVertexFormatInfo(attribute.format).componentCount;
-                GLenum formatType = VertexFormatType(attribute.format);
-
-                GLboolean normalized = VertexFormatIsNormalized(attribute.format);
-                gl.BindBuffer(GL_ARRAY_BUFFER, buffer);
-                if (VertexFormatIsInt(attribute.format)) {
-                    gl.VertexAttribIPointer(
-                        attribIndex, components, formatType, vertexBuffer.arrayStride,
-                        reinterpret_cast<void*>(static_cast<intptr_t>(offset + attribute.offset)));
-                } else {
-                    gl.VertexAttribPointer(
-                        attribIndex, components, formatType, normalized, vertexBuffer.arrayStride,
-                        reinterpret_cast<void*>(static_cast<intptr_t>(offset + attribute.offset)));
-                }
-            }
-        }
-
-        mDirtyVertexBuffers.reset();
     }
 
   private:
     bool mIndexBufferDirty = false;
     Buffer* mIndexBuffer = nullptr;
 
+    bool mVertexStateDirty = false;
     ityp::bitset<VertexBufferSlot, kMaxVertexBuffers> mDirtyVertexBuffers;
     ityp::array<VertexBufferSlot, Buffer*, kMaxVertexBuffers> mVertexBuffers;
     ityp::array<VertexBufferSlot, uint64_t, kMaxVertexBuffers> mVertexBufferOffsets;
 
+    GLuint mLastVAO = 0;
     RenderPipelineBase* mLastPipeline = nullptr;
 };
 
-class BindGroupTracker : public BindGroupTrackerBase<false, uint64_t> {
+class BindGroupTracker : public BindGroupTrackerBase<true, uint64_t> {
   public:
     void OnSetPipeline(RenderPipeline* pipeline) {
         BindGroupTrackerBase::OnSetPipeline(pipeline);
@@ -226,6 +129,15 @@ class BindGroupTracker : public BindGroupTrackerBase<false, uint64_t> {
 
     void Apply(const OpenGLFunctions& gl) {
         BeforeApply();
+        if (mPipeline != mLastAppliedPipeline) {
+            // GL binding points for buffers and images come from the pipeline layout alone,
+            // so those bindings survive a pipeline change between prefix-compatible layouts.
+            // Texture units however are assigned to combined samplers when each program is
+            // linked, making sampler and sampled texture bindings program state: re-apply
+            // the groups that contain any, even if BeforeApply() inherited them.
+            mDirtyBindGroupsObjectChangedOrIsDynamic |= GroupsWithProgramBoundUnits();
+            mLastAppliedPipeline = mPipeline;
+        }
         for (BindGroupIndex index : IterateBitSet(mDirtyBindGroupsObjectChangedOrIsDynamic)) {
             ApplyBindGroup(gl, index, mBindGroups[index], mDynamicOffsetCounts[index],
                            mDynamicOffsets[index].data());
@@ -234,6 +146,21 @@ class BindGroupTracker : public BindGroupTrackerBase<false, uint64_t> {
     }
 
   private:
+    BindGroupLayoutMask GroupsWithProgramBoundUnits() const {
+        BindGroupLayoutMask mask = {};
+        for (BindGroupIndex index : IterateBitSet(mBindGroupLayoutsMask)) {
+            const BindGroupLayoutBase* bgl = mPipelineLayout->GetBindGroupLayout(index);
+            for (BindingIndex binding{0}; binding < bgl->GetBindingCount(); ++binding) {
+                BindingInfoType type = bgl->GetBindingInfo(binding).bindingType;
+                if (type == BindingInfoType::Sampler || type == BindingInfoType::Texture) {
+                    mask.set(index);
+                    break;
+                }
+            }
+        }
+        return mask;
+    }
+
     void ApplyBindGroup(const OpenGLFunctions& gl,
                         BindGroupIndex index,
                         BindGroupBase* group,
@@ -378,6 +305,7 @@ class BindGroupTracker : public BindGroupTrackerBase<false, uint64_t> {
     }
 
     PipelineGL* mPipeline = nullptr;
+    PipelineGL* mLastAppliedPipeline = nullptr;
 };
 
 void ResolveMultisampledRenderTargets(const OpenGLFunctions& gl,
@@ -814,7 +742,7 @@ MaybeError CommandBuffer::ExecuteComputePass() {
                 SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
                 uint32_t* dynamicOffsets = nullptr;
                 if (cmd->dynamicOffsetCount > 0) {
-                    dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    dynamicOffsets = mCommands.NextTrailingData<uint32_t>(cmd->dynamicOffsetCount);
                 }
                 bindGroupTracker.OnSetBindGroup(cmd->index, cmd->group.Get(),
                                                 cmd->dynamicOffsetCount, dynamicOffsets);
@@ -903,8 +831,6 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
     ASSERT(gl.CheckFramebufferStatus(GL_DRAW_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
 
     // Set defaults for dynamic state before executing clears and commands.
-    PersistentPipelineState persistentPipelineState;
-    persistentPipelineState.SetDefaultState(gl);
     gl.BlendColor(0, 0, 0, 0);
     gl.Viewport(0, 0, renderPass->width, renderPass->height);
     gl.DepthRangef(0.0, 1.0);
@@ -982,6 +908,12 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
         }
     }
 
+    // Establish the shadow state cache after the clears above, which write the depth, stencil
+    // and color masks directly. SetDefaultState forces the GL state covered by the cache back to
+    // its default values.
+    PersistentPipelineState persistentPipelineState;
+    persistentPipelineState.SetDefaultState(gl);
+
     RenderPipeline* lastPipeline = nullptr;
     uint64_t indexBufferBaseOffset = 0;
     GLenum indexBufferFormat;
@@ -994,7 +926,7 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
         switch (type) {
             case Command::Draw: {
                 DrawCmd* draw = iter->NextCommand<DrawCmd>();
-                vertexStateBufferBindingTracker.Apply(gl);
+                vertexStateBufferBindingTracker.Apply(gl, &persistentPipelineState);
                 bindGroupTracker.Apply(gl);
 
                 if (draw->firstInstance > 0) {
@@ -1012,7 +944,7 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
 
             case Command::DrawIndexed: {
                 DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
-                vertexStateBufferBindingTracker.Apply(gl);
+                vertexStateBufferBindingTracker.Apply(gl, &persistentPipelineState);
                 bindGroupTracker.Apply(gl);
 
                 if (draw->firstInstance > 0) {
@@ -1045,7 +977,7 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
 
             case Command::DrawIndirect: {
                 DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                vertexStateBufferBindingTracker.Apply(gl);
+                vertexStateBufferBindingTracker.Apply(gl, &persistentPipelineState);
                 bindGroupTracker.Apply(gl);
 
                 uint64_t indirectBufferOffset = draw->indirectOffset;
@@ -1061,7 +993,7 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
             case Command::DrawIndexedIndirect: {
                 DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
 
-                vertexStateBufferBindingTracker.Apply(gl);
+                vertexStateBufferBindingTracker.Apply(gl, &persistentPipelineState);
                 bindGroupTracker.Apply(gl);
 
                 Buffer* indirectBuffer = ToBackend(draw->indirectBuffer.Get());
@@ -1097,7 +1029,7 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
                 SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
                 uint32_t* dynamicOffsets = nullptr;
                 if (cmd->dynamicOffsetCount > 0) {
-                    dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    dynamicOffsets = iter->NextTrailingData<uint32_t>(cmd->dynamicOffsetCount);
                 }
                 bindGroupTracker.OnSetBindGroup(cmd->index, cmd->group.Get(),
                                                 cmd->dynamicOffsetCount, dynamicOffsets);
@@ -21,6 +21,20 @@
 
 namespace dawn::native::opengl {
 
+namespace {
+
+void GetContextVersion(EGLenum api, EGLint* major, EGLint* minor) {
+    if (api == EGL_OPENGL_ES_API) {
+        *major = 3;
+        *minor = 1;
+    } else {
+        *major = 4;
+        *minor = 4;
+    }
+}
+
+}  // anonymous namespace
+
 ResultOrError<std::unique_ptr<ContextEGL>> ContextEGL::Create(const EGLFunctions& egl,
                                                               EGLenum api) {
     EGLDisplay display = egl.GetCurrentDisplay();
@@ -54,26 +68,41 @@ ResultOrError<std::unique_ptr<ContextEGL>> ContextEGL::Create(const EGLFunctions
 
     DAWN_TRY(CheckEGL(egl, egl.BindAPI(api), "eglBindAPI"));
 
-    if (api == EGL_OPENGL_ES_API) {
-        major = 3;
-        minor = 1;
-    } else {
-        major = 4;
-        minor = 4;
-    }
+    GetContextVersion(api, &major, &minor);
     EGLint attrib_list[] = {
         EGL_CONTEXT_MAJOR_VERSION, major, EGL_CONTEXT_MINOR_VERSION, minor, EGL_NONE, EGL_NONE,
     };
     EGLContext context = egl.CreateContext(display, config, EGL_NO_CONTEXT, attrib_list);
     DAWN_TRY(CheckEGL(egl, context != EGL_NO_CONTEXT, "eglCreateContext"));
 
-    return std::unique_ptr<ContextEGL>(new ContextEGL(egl, display, context));
+    return std::unique_ptr<ContextEGL>(new ContextEGL(egl, display, context, config, api));
 }
 
 void ContextEGL::MakeCurrent() {
     egl.MakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, mContext);
 }
 
+std::unique_ptr<Device::Context> ContextEGL::CreateSharedContext() {
+    // Failing to create a shared context isn't fatal: the caller falls back to doing all the
+    // work on this context, so errors are swallowed instead of reported.
+    if (egl.BindAPI(mApi) == EGL_FALSE) {
+        return nullptr;
+    }
+
+    EGLint major, minor;
+    GetContextVersion(mApi, &major, &minor);
+    EGLint attrib_list[] = {
+        EGL_CONTEXT_MAJOR_VERSION, major, EGL_CONTEXT_MINOR_VERSION, minor, EGL_NONE, EGL_NONE,
+    };
+    EGLContext context = egl.CreateContext(mDisplay, mConfig, mContext, attrib_list);
+    if (context == EGL_NO_CONTEXT) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<Device::Context>(
+        new ContextEGL(egl, mDisplay, context, mConfig, mApi));
+}
+
 ContextEGL::~ContextEGL() {
     egl.DestroyContext(mDisplay, mContext);
 }
@@ -24,20 +24,27 @@
 
 namespace dawn::native::opengl {
 
-class ContextEGL : public Device::Context {
+class ContextEGL final : public Device::Context {
   public:
     static ResultOrError<std::unique_ptr<ContextEGL>> Create(const EGLFunctions& functions,
                                                              EGLenum api);
     void MakeCurrent() override;
+    std::unique_ptr<Device::Context> CreateSharedContext() override;
     ~ContextEGL() override;
 
   private:
-    ContextEGL(const EGLFunctions& functions, EGLDisplay display, EGLContext context)
-        : egl(functions), mDisplay(display), mContext(context) {}
+    ContextEGL(const EGLFunctions& functions,
+               EGLDisplay display,
+               EGLContext context,
+               EGLConfig config,
+               EGLenum api)
+        : egl(functions), mDisplay(display), mContext(context), mConfig(config), mApi(api) {}
 
     const EGLFunctions egl;
     EGLDisplay mDisplay;
     EGLContext mContext;
+    EGLConfig mConfig;
+    EGLenum mApi;
 };
 
 }  // namespace dawn::native::opengl
@@ -18,6 +18,7 @@
 
 #include "dawn/native/BackendConnection.h"
 #include "dawn/native/BindGroupLayout.h"
+#include "dawn/native/CreatePipelineAsyncTask.h"
 #include "dawn/native/ErrorData.h"
 #include "dawn/native/Instance.h"
 #include "dawn/native/StagingBuffer.h"
@@ -32,6 +33,7 @@
 #include "dawn/native/opengl/RenderPipelineGL.h"
 #include "dawn/native/opengl/SamplerGL.h"
 #include "dawn/native/opengl/ShaderModuleGL.h"
+#include "dawn/native/opengl/StagingBufferGL.h"
 #include "dawn/native/opengl/SwapChainGL.h"
 #include "dawn/native/opengl/TextureGL.h"
 
@@ -104,6 +106,19 @@ void KHRONOS_APIENTRY OnGLDebugMessage(GLenum source,
 
 namespace dawn::native::opengl {
 
+namespace {
+
+// The number of contexts created for Create*PipelineAsync worker threads. When all of them are
+// busy further pipeline creations fall back to the device thread.
+constexpr size_t kMaxWorkerContexts = 4;
+
+// The worker context the calling thread has made current, if any. Device::GetGL() keeps the
+// device context current on the device thread, but must not steal it from worker threads that
+// compile pipelines on a shared context.
+thread_local Device::Context* tCurrentWorkerContext = nullptr;
+
+}  // anonymous namespace
+
 // static
 ResultOrError<Ref<Device>> Device::Create(AdapterBase* adapter,
                                           const DeviceDescriptor* descriptor,
@@ -129,6 +144,9 @@ MaybeError Device::Initialize(const DeviceDescriptor* descriptor) {
     InitTogglesFromDriver();
     mFormatTable = BuildGLFormatTable(GetBGRAInternalFormat());
 
+    mSupportsBufferStorage =
+        gl.IsAtLeastGL(4, 4) || gl.IsGLExtensionSupported("GL_ARB_buffer_storage");
+
     // Use the debug output functionality to get notified about GL errors
     // TODO(crbug.com/dawn/1475): add support for the KHR_debug and ARB_debug_output
     // extensions
@@ -170,7 +188,40 @@ MaybeError Device::Initialize(const DeviceDescriptor* descriptor) {
     }
     gl.Enable(GL_SAMPLE_MASK);
 
-    return DeviceBase::Initialize(AcquireRef(new Queue(this, &descriptor->defaultQueue)));
+    // Ask the driver to compile and link shaders on its own internal threads where supported.
+    if (gl.IsGLExtensionSupported("GL_KHR_parallel_shader_compile")) {
+        gl.MaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    }
+
+    DAWN_TRY(DeviceBase::Initialize(AcquireRef(new Queue(this, &descriptor->defaultQueue))));
+
+    // Pipelines that sample textures without a sampler share a single non-filtering placeholder
+    // sampler, see PipelineGL. Create it upfront so that pipeline initialization on worker
+    // threads doesn't race on the device's sampler cache.
+    {
+        SamplerDescriptor desc = {};
+        ASSERT(desc.minFilter == wgpu::FilterMode::Nearest);
+        ASSERT(desc.magFilter == wgpu::FilterMode::Nearest);
+        ASSERT(desc.mipmapFilter == wgpu::FilterMode::Nearest);
+        Ref<SamplerBase> sampler;
+        DAWN_TRY_ASSIGN(sampler, GetOrCreateSampler(&desc));
+        mPlaceholderSampler = ToBackend(std::move(sampler));
+    }
+
+    // Try to create contexts that share objects with the device context so that
+    // Create*PipelineAsync can compile and link programs on worker threads. This is optional:
+    // when no shared context could be created, pipelines are created on the device thread.
+    if (mContext != nullptr) {
+        for (size_t i = 0; i < kMaxWorkerContexts; ++i) {
+            std::unique_ptr<Context> workerContext = mContext->CreateSharedContext();
+            if (workerContext == nullptr) {
+                break;
+            }
+            mIdleWorkerContexts.push_back(std::move(workerContext));
+        }
+    }
+
+    return {};
 }
 
 void Device::InitTogglesFromDriver() {
@@ -282,6 +333,80 @@ Ref<RenderPipelineBase> Device::CreateUninitializedRenderPipelineImpl(
     const RenderPipelineDescriptor* descriptor) {
     return RenderPipeline::CreateUninitialized(this, descriptor);
 }
+void Device::InitializeComputePipelineAsyncImpl(Ref<ComputePipelineBase> computePipeline,
+                                                WGPUCreateComputePipelineAsyncCallback callback,
+                                                void* userdata) {
+    std::unique_ptr<Context> workerContext = AcquireWorkerContext();
+    if (workerContext == nullptr) {
+        // No worker context is available, compile on the device thread instead.
+        DeviceBase::InitializeComputePipelineAsyncImpl(std::move(computePipeline), callback,
+                                                       userdata);
+        return;
+    }
+
+    auto task = std::make_unique<CreateComputePipelineAsyncTask>(std::move(computePipeline),
+                                                                 callback, userdata);
+    // See CreateComputePipelineAsyncTask::RunAsync for why the pointers are released here.
+    auto asyncTask = [this, contextPtr = workerContext.release(), taskPtr = task.release()] {
+        std::unique_ptr<CreateComputePipelineAsyncTask> innerTaskPtr(taskPtr);
+        std::unique_ptr<Context> innerContextPtr(contextPtr);
+
+        tCurrentWorkerContext = innerContextPtr.get();
+        innerTaskPtr->Run();
+        // Make the objects created on the worker context visible to the other contexts of the
+        // share group before the pipeline is used on the device thread.
+        GetGL().Flush();
+        tCurrentWorkerContext = nullptr;
+
+        ReleaseWorkerContext(std::move(innerContextPtr));
+    };
+    GetAsyncTaskManager()->PostTask(std::move(asyncTask));
+}
+void Device::InitializeRenderPipelineAsyncImpl(Ref<RenderPipelineBase> renderPipeline,
+                                               WGPUCreateRenderPipelineAsyncCallback callback,
+                                               void* userdata) {
+    std::unique_ptr<Context> workerContext = AcquireWorkerContext();
+    if (workerContext == nullptr) {
+        // No worker context is available, compile on the device thread instead.
+        DeviceBase::InitializeRenderPipelineAsyncImpl(std::move(renderPipeline), callback,
+                                                      userdata);
+        return;
+    }
+
+    auto task = std::make_unique<CreateRenderPipelineAsyncTask>(std::move(renderPipeline),
+                                                                callback, userdata);
+    // See CreateRenderPipelineAsyncTask::RunAsync for why the pointers are released here.
+    auto asyncTask = [this, contextPtr = workerContext.release(), taskPtr = task.release()] {
+        std::unique_ptr<CreateRenderPipelineAsyncTask> innerTaskPtr(taskPtr);
+        std::unique_ptr<Context> innerContextPtr(contextPtr);
+
+        tCurrentWorkerContext = innerContextPtr.get();
+        innerTaskPtr->Run();
+        // Make the objects created on the worker context visible to the other contexts of the
+        // share group before the pipeline is used on the device thread.
+        GetGL().Flush();
+        tCurrentWorkerContext = nullptr;
+
+        ReleaseWorkerContext(std::move(innerContextPtr));
+    };
+    GetAsyncTaskManager()->PostTask(std::move(asyncTask));
+}
+
+std::unique_ptr<Device::Context> Device::AcquireWorkerContext() {
+    std::lock_guard<std::mutex> lock(mWorkerContextMutex);
+    if (mIdleWorkerContexts.empty()) {
+        return nullptr;
+    }
+    std::unique_ptr<Context> context = std::move(mIdleWorkerContexts.back());
+    mIdleWorkerContexts.pop_back();
+    return context;
+}
+
+void Device::ReleaseWorkerContext(std::unique_ptr<Context> context) {
+    ASSERT(context != nullptr);
+    std::lock_guard<std::mutex> lock(mWorkerContextMutex);
+    mIdleWorkerContexts.push_back(std::move(context));
+}
 ResultOrError<Ref<SamplerBase>> Device::CreateSamplerImpl(const SamplerDescriptor* descriptor) {
     return AcquireRef(new Sampler(this, descriptor));
 }
@@ -314,7 +439,7 @@ void Device::SubmitFenceSync() {
     const OpenGLFunctions& gl = GetGL();
     GLsync sync = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
     IncrementLastSubmittedCommandSerial();
-    mFencesInFlight.emplace(sync, GetLastSubmittedCommandSerial());
+    mFencesInFlight.emplace_back(sync, GetLastSubmittedCommandSerial());
 }
 
 MaybeError Device::ValidateEGLImageCanBeWrapped(const TextureDescriptor* descriptor,
@@ -383,34 +508,54 @@ MaybeError Device::TickImpl() {
 ResultOrError<ExecutionSerial> Device::CheckAndUpdateCompletedSerials() {
     ExecutionSerial fenceSerial{0};
     const OpenGLFunctions& gl = GetGL();
-    while (!mFencesInFlight.empty()) {
-        auto [sync, tentativeSerial] = mFencesInFlight.front();
+    if (mFencesInFlight.empty()) {
+        return fenceSerial;
+    }
 
-        // Fence are added in order, so we can stop searching as soon
-        // as we see one that's not ready.
+    // TODO(crbug.com/dawn/633): Remove this workaround after the deadlock issue is fixed.
+    if (IsToggleEnabled(Toggle::FlushBeforeClientWaitSync)) {
+        gl.Flush();
+    }
 
-        // TODO(crbug.com/dawn/633): Remove this workaround after the deadlock issue is fixed.
-        if (IsToggleEnabled(Toggle::FlushBeforeClientWaitSync)) {
-            gl.Flush();
-        }
-        GLenum result = gl.ClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    // Fences complete in submission order, so the deque is partitioned into completed fences
+    // followed by pending ones. Binary-search for the partition point so a check issues
+    // O(log n) sync queries instead of one per completed fence.
+    size_t begin = 0;
+    size_t end = mFencesInFlight.size();
+    while (begin < end) {
+        size_t mid = begin + (end - begin) / 2;
+        GLenum result =
+            gl.ClientWaitSync(mFencesInFlight[mid].first, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        ASSERT(result != GL_WAIT_FAILED);
         if (result == GL_TIMEOUT_EXPIRED) {
-            return fenceSerial;
+            end = mid;
+        } else {
+            begin = mid + 1;
         }
-        // Update fenceSerial since fence is ready.
-        fenceSerial = tentativeSerial;
+    }
 
+    // |begin| is now the number of completed fences at the front of the deque.
+    for (size_t i = 0; i < begin; ++i) {
+        auto [sync, tentativeSerial] = mFencesInFlight.front();
+        fenceSerial = tentativeSerial;
         gl.DeleteSync(sync);
-
-        mFencesInFlight.pop();
-
+        mFencesInFlight.pop_front();
         ASSERT(fenceSerial > GetCompletedCommandSerial());
     }
     return fenceSerial;
 }
 
+bool Device::SupportsBufferStorage() const {
+    return mSupportsBufferStorage;
+}
+
 ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateStagingBuffer(size_t size) {
-    return DAWN_UNIMPLEMENTED_ERROR("Device unable to create staging buffer.");
+    if (!mSupportsBufferStorage) {
+        return DAWN_UNIMPLEMENTED_ERROR("Device unable to create staging buffer.");
+    }
+    std::unique_ptr<StagingBufferBase> stagingBuffer = std::make_unique<StagingBuffer>(size, this);
+    DAWN_TRY(stagingBuffer->Initialize());
+    return std::move(stagingBuffer);
 }
 
 MaybeError Device::CopyFromStagingToBuffer(StagingBufferBase* source,
@@ -418,7 +563,19 @@ MaybeError Device::CopyFromStagingToBuffer(StagingBufferBase* source,
                                            BufferBase* destination,
                                            uint64_t destinationOffset,
                                            uint64_t size) {
-    return DAWN_UNIMPLEMENTED_ERROR("Device unable to copy from staging buffer.");
+    ASSERT(size != 0);
+    const OpenGLFunctions& gl = GetGL();
+
+    ToBackend(destination)->EnsureDataInitializedAsDestination(destinationOffset, size);
+
+    // The staging mapping is coherent so the CPU writes are already visible to the copy. The
+    // copy executes in submission order on the GL timeline, so unlike glBufferSubData it
+    // never forces the driver to wait for previous commands reading the destination.
+    gl.BindBuffer(GL_COPY_READ_BUFFER, ToBackend(source)->GetBufferHandle());
+    gl.BindBuffer(GL_COPY_WRITE_BUFFER, ToBackend(destination)->GetHandle());
+    gl.CopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset,
+                         destinationOffset, size);
+    return {};
 }
 
 MaybeError Device::CopyFromStagingToTexture(const StagingBufferBase* source,
@@ -430,6 +587,11 @@ MaybeError Device::CopyFromStagingToTexture(const StagingBufferBase* source,
 
 void Device::DestroyImpl() {
     ASSERT(GetState() == State::Disconnected);
+    mPlaceholderSampler = nullptr;
+
+    // All pending Create*PipelineAsync tasks were waited on before disconnecting, so every
+    // worker context is idle again and can be destroyed.
+    mIdleWorkerContexts.clear();
 }
 
 MaybeError Device::WaitForIdleForDestruction() {
@@ -453,8 +615,15 @@ float Device::GetTimestampPeriodInNS() const {
     return 1.0f;
 }
 
+Sampler* Device::GetPlaceholderSampler() const {
+    ASSERT(mPlaceholderSampler != nullptr);
+    return mPlaceholderSampler.Get();
+}
+
 const OpenGLFunctions& Device::GetGL() const {
-    if (mContext) {
+    if (tCurrentWorkerContext != nullptr) {
+        tCurrentWorkerContext->MakeCurrent();
+    } else if (mContext) {
         mContext->MakeCurrent();
     }
     return mGL;
@@ -15,9 +15,11 @@
 #ifndef SRC_DAWN_NATIVE_OPENGL_DEVICEGL_H_
 #define SRC_DAWN_NATIVE_OPENGL_DEVICEGL_H_
 
+#include <deque>
 #include <memory>
-#include <queue>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 #include "dawn/native/dawn_platform.h"
 
@@ -83,10 +85,23 @@ class Device final : public DeviceBase {
 
     float GetTimestampPeriodInNS() const override;
 
+    // Returns the sampler bound for texture-only bindings, see PipelineGL.
+    Sampler* GetPlaceholderSampler() const;
+
+    // Whether immutable buffer storage (GL 4.4 or GL_ARB_buffer_storage) is available, which
+    // is what allows persistently mapped staging buffers.
+    bool SupportsBufferStorage() const;
+
     class Context {
       public:
         virtual ~Context() {}
         virtual void MakeCurrent() = 0;
+
+        // Creates a context that shares its GL objects with this one, for use on a worker
+        // thread. Returns nullptr when sharing isn't supported.
+        virtual std::unique_ptr<Context> CreateSharedContext() {
+            return nullptr;
+        }
     };
 
   private:
@@ -124,6 +139,17 @@ class Device final : public DeviceBase {
         const ComputePipelineDescriptor* descriptor) override;
     Ref<RenderPipelineBase> CreateUninitializedRenderPipelineImpl(
         const RenderPipelineDescriptor* descriptor) override;
+    void InitializeComputePipelineAsyncImpl(Ref<ComputePipelineBase> computePipeline,
+                                            WGPUCreateComputePipelineAsyncCallback callback,
+                                            void* userdata) override;
+    void InitializeRenderPipelineAsyncImpl(Ref<RenderPipelineBase> renderPipeline,
+                                           WGPUCreateRenderPipelineAsyncCallback callback,
+                                           void* userdata) override;
+
+    // Takes an idle worker context, or returns nullptr when none is available so that the
+    // caller can fall back to working on the device context.
+    std::unique_ptr<Context> AcquireWorkerContext();
+    void ReleaseWorkerContext(std::unique_ptr<Context> context);
 
     void InitTogglesFromDriver();
     GLenum GetBGRAInternalFormat() const;
@@ -133,10 +159,19 @@ class Device final : public DeviceBase {
 
     const OpenGLFunctions mGL;
 
-    std::queue<std::pair<GLsync, ExecutionSerial>> mFencesInFlight;
+    std::deque<std::pair<GLsync, ExecutionSerial>> mFencesInFlight;
 
     GLFormatTable mFormatTable;
     std::unique_ptr<Context> mContext = nullptr;
+
+    // Contexts that share objects with mContext, handed out to worker threads that compile and
+    // link pipelines for Create*PipelineAsync.
+    std::mutex mWorkerContextMutex;
+    std::vector<std::unique_ptr<Context>> mIdleWorkerContexts;
+
+    Ref<Sampler> mPlaceholderSampler;
+
+    bool mSupportsBufferStorage = false;
 };
 
 }  // namespace dawn::native::opengl
@@ -33,6 +33,7 @@ class Queue;
 class RenderPipeline;
 class Sampler;
 class ShaderModule;
+class StagingBuffer;
 class SwapChain;
 class Texture;
 class TextureView;
@@ -51,6 +52,7 @@ struct OpenGLBackendTraits {
     using RenderPipelineType = RenderPipeline;
     using SamplerType = Sampler;
     using ShaderModuleType = ShaderModule;
+    using StagingBufferType = StagingBuffer;
     using SwapChainType = SwapChain;
     using TextureType = Texture;
     using TextureViewType = TextureView;
@@ -19,7 +19,113 @@
 namespace dawn::native::opengl {
 
 void PersistentPipelineState::SetDefaultState(const OpenGLFunctions& gl) {
+    // Force the GL context to match the cached values so that the early-outs in the setters
+    // below are correct. All cache slots hold the GL default state at this point, which is also
+    // why the non-indexed blend calls (which set every draw buffer at once) can be used here.
+    gl.BindVertexArray(mVertexArrayObject);
+
+    gl.FrontFace(mFrontFace);
+    gl.Disable(GL_CULL_FACE);
+    gl.CullFace(mCullMode);
+
+    gl.Disable(GL_DEPTH_TEST);
+    gl.DepthMask(mDepthWriteMask);
+    gl.DepthFunc(mDepthCompareFunction);
+
+    gl.Disable(GL_STENCIL_TEST);
     CallGLStencilFunc(gl);
+    gl.StencilOpSeparate(GL_BACK, mStencilBackFailOperation, mStencilBackDepthFailOperation,
+                         mStencilBackPassOperation);
+    gl.StencilOpSeparate(GL_FRONT, mStencilFrontFailOperation, mStencilFrontDepthFailOperation,
+                         mStencilFrontPassOperation);
+    gl.StencilMask(mStencilWriteMask);
+
+    gl.SampleMaski(0, mSampleMask);
+    gl.Disable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+
+    gl.Disable(GL_POLYGON_OFFSET_FILL);
+    gl.PolygonOffset(mDepthBiasSlopeScale, mDepthBias);
+
+    const CachedBlendState& blendState = mBlendState[0];
+    gl.Disable(GL_BLEND);
+    gl.BlendEquationSeparate(blendState.colorBlendEquation, blendState.alphaBlendEquation);
+    gl.BlendFuncSeparate(blendState.srcColorBlendFunc, blendState.dstColorBlendFunc,
+                         blendState.srcAlphaBlendFunc, blendState.dstAlphaBlendFunc);
+    gl.ColorMask(blendState.colorWriteMask[0], blendState.colorWriteMask[1],
+                 blendState.colorWriteMask[2], blendState.colorWriteMask[3]);
+}
+
+void PersistentPipelineState::SetVertexArrayObject(const OpenGLFunctions& gl,
+                                                   GLuint vertexArrayObject) {
+    if (mVertexArrayObject == vertexArrayObject) {
+        return;
+    }
+
+    mVertexArrayObject = vertexArrayObject;
+    gl.BindVertexArray(vertexArrayObject);
+}
+
+void PersistentPipelineState::SetFrontFaceAndCulling(const OpenGLFunctions& gl,
+                                                     GLenum frontFace,
+                                                     bool cullEnabled,
+                                                     GLenum cullMode) {
+    if (mFrontFace != frontFace) {
+        mFrontFace = frontFace;
+        gl.FrontFace(frontFace);
+    }
+
+    if (mCullEnabled != cullEnabled) {
+        mCullEnabled = cullEnabled;
+        if (cullEnabled) {
+            gl.Enable(GL_CULL_FACE);
+        } else {
+            gl.Disable(GL_CULL_FACE);
+        }
+    }
+
+    // The cull face is left untouched while culling is disabled.
+    if (cullEnabled && mCullMode != cullMode) {
+        mCullMode = cullMode;
+        gl.CullFace(cullMode);
+    }
+}
+
+void PersistentPipelineState::SetDepthState(const OpenGLFunctions& gl,
+                                            bool depthTestEnabled,
+                                            GLboolean depthWriteMask,
+                                            GLenum depthCompareFunction) {
+    if (mDepthTestEnabled != depthTestEnabled) {
+        mDepthTestEnabled = depthTestEnabled;
+        if (depthTestEnabled) {
+            gl.Enable(GL_DEPTH_TEST);
+        } else {
+            gl.Disable(GL_DEPTH_TEST);
+        }
+    }
+
+    if (mDepthWriteMask != depthWriteMask) {
+        mDepthWriteMask = depthWriteMask;
+        gl.DepthMask(depthWriteMask);
+    }
+
+    if (mDepthCompareFunction != depthCompareFunction) {
+        mDepthCompareFunction = depthCompareFunction;
+        gl.DepthFunc(depthCompareFunction);
+    }
+}
+
+void PersistentPipelineState::SetStencilTestEnabled(const OpenGLFunctions& gl,
+                                                    bool stencilTestEnabled) {
+    if (mStencilTestEnabled == stencilTestEnabled) {
+        return;
+    }
+
+    mStencilTestEnabled = stencilTestEnabled;
+    if (stencilTestEnabled) {
+        gl.Enable(GL_STENCIL_TEST);
+    } else {
+        gl.Disable(GL_STENCIL_TEST);
+    }
 }
 
 void PersistentPipelineState::SetStencilFuncsAndMask(const OpenGLFunctions& gl,
@@ -38,6 +144,40 @@ void PersistentPipelineState::SetStencilFuncsAndMask(const OpenGLFunctions& gl,
     CallGLStencilFunc(gl);
 }
 
+void PersistentPipelineState::SetStencilOpsAndWriteMask(const OpenGLFunctions& gl,
+                                                        GLenum stencilBackFailOperation,
+                                                        GLenum stencilBackDepthFailOperation,
+                                                        GLenum stencilBackPassOperation,
+                                                        GLenum stencilFrontFailOperation,
+                                                        GLenum stencilFrontDepthFailOperation,
+                                                        GLenum stencilFrontPassOperation,
+                                                        uint32_t stencilWriteMask) {
+    if (mStencilBackFailOperation != stencilBackFailOperation ||
+        mStencilBackDepthFailOperation != stencilBackDepthFailOperation ||
+        mStencilBackPassOperation != stencilBackPassOperation) {
+        mStencilBackFailOperation = stencilBackFailOperation;
+        mStencilBackDepthFailOperation = stencilBackDepthFailOperation;
+        mStencilBackPassOperation = stencilBackPassOperation;
+        gl.StencilOpSeparate(GL_BACK, stencilBackFailOperation, stencilBackDepthFailOperation,
+                             stencilBackPassOperation);
+    }
+
+    if (mStencilFrontFailOperation != stencilFrontFailOperation ||
+        mStencilFrontDepthFailOperation != stencilFrontDepthFailOperation ||
+        mStencilFrontPassOperation != stencilFrontPassOperation) {
+        mStencilFrontFailOperation = stencilFrontFailOperation;
+        mStencilFrontDepthFailOperation = stencilFrontDepthFailOperation;
+        mStencilFrontPassOperation = stencilFrontPassOperation;
+        gl.StencilOpSeparate(GL_FRONT, stencilFrontFailOperation, stencilFrontDepthFailOperation,
+                             stencilFrontPassOperation);
+    }
+
+    if (mStencilWriteMask != stencilWriteMask) {
+        mStencilWriteMask = stencilWriteMask;
+        gl.StencilMask(stencilWriteMask);
+    }
+}
+
 void PersistentPipelineState::SetStencilReference(const OpenGLFunctions& gl,
                                                   uint32_t stencilReference) {
     if (mStencilReference == stencilReference) {
@@ -48,6 +188,190 @@ void PersistentPipelineState::SetStencilReference(const OpenGLFunctions& gl,
     CallGLStencilFunc(gl);
 }
 
+void PersistentPipelineState::SetSampleMask(const OpenGLFunctions& gl, GLbitfield sampleMask) {
+    if (mSampleMask == sampleMask) {
+        return;
+    }
+
+    mSampleMask = sampleMask;
+    gl.SampleMaski(0, sampleMask);
+}
+
+void PersistentPipelineState::SetAlphaToCoverageEnabled(const OpenGLFunctions& gl,
+                                                        bool alphaToCoverageEnabled) {
+    if (mAlphaToCoverageEnabled == alphaToCoverageEnabled) {
+        return;
+    }
+
+    mAlphaToCoverageEnabled = alphaToCoverageEnabled;
+    if (alphaToCoverageEnabled) {
+        gl.Enable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+    } else {
+        gl.Disable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+    }
+}
+
+void PersistentPipelineState::SetDepthBias(const OpenGLFunctions& gl,
+                                           bool depthBiasEnabled,
+                                           float slopeScale,
+                                           float depthBias,
+                                           float clamp) {
+    if (mDepthBiasEnabled != depthBiasEnabled) {
+        mDepthBiasEnabled = depthBiasEnabled;
+        if (depthBiasEnabled) {
+            gl.Enable(GL_POLYGON_OFFSET_FILL);
+        } else {
+            gl.Disable(GL_POLYGON_OFFSET_FILL);
+        }
+    }
+
+    // The bias values are left untouched while the depth bias is disabled. GL keeps them around
+    // as well so the cache stays consistent.
+    if (!depthBiasEnabled) {
+        return;
+    }
+
+    if (mDepthBiasSlopeScale == slopeScale && mDepthBias == depthBias &&
+        mDepthBiasClamp == clamp) {
+        return;
+    }
+
+    mDepthBiasSlopeScale = slopeScale;
+    mDepthBias = depthBias;
+    mDepthBiasClamp = clamp;
+    if (gl.PolygonOffsetClamp != nullptr) {
+        gl.PolygonOffsetClamp(slopeScale, depthBias, clamp);
+    } else {
+        gl.PolygonOffset(slopeScale, depthBias);
+    }
+}
+
+void PersistentPipelineState::SetBlendEnabled(const OpenGLFunctions& gl,
+                                              GLuint colorBuffer,
+                                              bool blendEnabled) {
+    CachedBlendState& blendState = mBlendState[colorBuffer];
+    if (blendState.blendEnabled == blendEnabled) {
+        return;
+    }
+
+    blendState.blendEnabled = blendEnabled;
+    if (blendEnabled) {
+        gl.Enablei(GL_BLEND, colorBuffer);
+    } else {
+        gl.Disablei(GL_BLEND, colorBuffer);
+    }
+}
+
+void PersistentPipelineState::SetBlendEquations(const OpenGLFunctions& gl,
+                                               GLuint colorBuffer,
+                                               GLenum colorBlendEquation,
+                                               GLenum alphaBlendEquation) {
+    CachedBlendState& blendState = mBlendState[colorBuffer];
+    if (blendState.colorBlendEquation == colorBlendEquation &&
+        blendState.alphaBlendEquation == alphaBlendEquation) {
+        return;
+    }
+
+    blendState.colorBlendEquation = colorBlendEquation;
+    blendState.alphaBlendEquation = alphaBlendEquation;
+    gl.BlendEquationSeparatei(colorBuffer, colorBlendEquation, alphaBlendEquation);
+}
+
+void PersistentPipelineState::SetBlendFuncs(const OpenGLFunctions& gl,
+                                            GLuint colorBuffer,
+                                            GLenum srcColorBlendFunc,
+                                            GLenum dstColorBlendFunc,
+                                            GLenum srcAlphaBlendFunc,
+                                            GLenum dstAlphaBlendFunc) {
+    CachedBlendState& blendState = mBlendState[colorBuffer];
+    if (blendState.srcColorBlendFunc == srcColorBlendFunc &&
+        blendState.dstColorBlendFunc == dstColorBlendFunc &&
+        blendState.srcAlphaBlendFunc == srcAlphaBlendFunc &&
+        blendState.dstAlphaBlendFunc == dstAlphaBlendFunc) {
+        return;
+    }
+
+    blendState.srcColorBlendFunc = srcColorBlendFunc;
+    blendState.dstColorBlendFunc = dstColorBlendFunc;
+    blendState.srcAlphaBlendFunc = srcAlphaBlendFunc;
+    blendState.dstAlphaBlendFunc = dstAlphaBlendFunc;
+    gl.BlendFuncSeparatei(colorBuffer, srcColorBlendFunc, dstColorBlendFunc, srcAlphaBlendFunc,
+                          dstAlphaBlendFunc);
+}
+
+void PersistentPipelineState::SetColorWriteMask(const OpenGLFunctions& gl,
+                                               GLuint colorBuffer,
+                                               const std::array<GLboolean, 4>& colorWriteMask) {
+    CachedBlendState& blendState = mBlendState[colorBuffer];
+    if (blendState.colorWriteMask == colorWriteMask) {
+        return;
+    }
+
+    blendState.colorWriteMask = colorWriteMask;
+    gl.ColorMaski(colorBuffer, colorWriteMask[0], colorWriteMask[1], colorWriteMask[2],
+                  colorWriteMask[3]);
+}
+
+void PersistentPipelineState::SetBlendEnabled(const OpenGLFunctions& gl, bool blendEnabled) {
+    CachedBlendState& blendState = mBlendState[0];
+    if (blendState.blendEnabled == blendEnabled) {
+        return;
+    }
+
+    blendState.blendEnabled = blendEnabled;
+    if (blendEnabled) {
+        gl.Enable(GL_BLEND);
+    } else {
+        gl.Disable(GL_BLEND);
+    }
+}
+
+void PersistentPipelineState::SetBlendEquations(const OpenGLFunctions& gl,
+                                               GLenum colorBlendEquation,
+                                               GLenum alphaBlendEquation) {
+    CachedBlendState& blendState = mBlendState[0];
+    if (blendState.colorBlendEquation == colorBlendEquation &&
+        blendState.alphaBlendEquation == alphaBlendEquation) {
+        return;
+    }
+
+    blendState.colorBlendEquation = colorBlendEquation;
+    blendState.alphaBlendEquation = alphaBlendEquation;
+    gl.BlendEquationSeparate(colorBlendEquation, alphaBlendEquation);
+}
+
+void PersistentPipelineState::SetBlendFuncs(const OpenGLFunctions& gl,
+                                            GLenum srcColorBlendFunc,
+                                            GLenum dstColorBlendFunc,
+                                            GLenum srcAlphaBlendFunc,
+                                            GLenum dstAlphaBlendFunc) {
+    CachedBlendState& blendState = mBlendState[0];
+    if (blendState.srcColorBlendFunc == srcColorBlendFunc &&
+        blendState.dstColorBlendFunc == dstColorBlendFunc &&
+        blendState.srcAlphaBlendFunc == srcAlphaBlendFunc &&
+        blendState.dstAlphaBlendFunc == dstAlphaBlendFunc) {
+        return;
+    }
+
+    blendState.srcColorBlendFunc = srcColorBlendFunc;
+    blendState.dstColorBlendFunc = dstColorBlendFunc;
+    blendState.srcAlphaBlendFunc = srcAlphaBlendFunc;
+    blendState.dstAlphaBlendFunc = dstAlphaBlendFunc;
+    gl.BlendFuncSeparate(srcColorBlendFunc, dstColorBlendFunc, srcAlphaBlendFunc,
+                         dstAlphaBlendFunc);
+}
+
+void PersistentPipelineState::SetColorWriteMask(const OpenGLFunctions& gl,
+                                               const std::array<GLboolean, 4>& colorWriteMask) {
+    CachedBlendState& blendState = mBlendState[0];
+    if (blendState.colorWriteMask == colorWriteMask) {
+        return;
+    }
+
+    blendState.colorWriteMask = colorWriteMask;
+    gl.ColorMask(colorWriteMask[0], colorWriteMask[1], colorWriteMask[2], colorWriteMask[3]);
+}
+
 void PersistentPipelineState::CallGLStencilFunc(const OpenGLFunctions& gl) {
     gl.StencilFuncSeparate(GL_BACK, mStencilBackCompareFunction, mStencilReference,
                            mStencilReadMask);
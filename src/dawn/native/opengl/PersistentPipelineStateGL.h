@@ -15,6 +15,9 @@
 #ifndef SRC_DAWN_NATIVE_OPENGL_PERSISTENTPIPELINESTATEGL_H_
 #define SRC_DAWN_NATIVE_OPENGL_PERSISTENTPIPELINESTATEGL_H_
 
+#include <array>
+
+#include "dawn/common/Constants.h"
 #include "dawn/native/dawn_platform.h"
 #include "dawn/native/opengl/opengl_platform.h"
 
@@ -22,22 +25,125 @@ namespace dawn::native::opengl {
 
 struct OpenGLFunctions;
 
+// Shadow copy of the GL state that render pipelines apply when they are bound. The setters below
+// only issue GL calls when the requested state differs from the cached state, so that binding
+// pipelines which share most of their fixed-function state (for example pipelines that differ
+// only in shaders) stays cheap even on drivers with high per-call overhead.
+//
+// The cached values start out at the GL default state and SetDefaultState() forces the context to
+// match them, so all changes to the covered state must go through this class while an instance is
+// live.
 class PersistentPipelineState {
   public:
     void SetDefaultState(const OpenGLFunctions& gl);
+
+    void SetVertexArrayObject(const OpenGLFunctions& gl, GLuint vertexArrayObject);
+    void SetFrontFaceAndCulling(const OpenGLFunctions& gl,
+                                GLenum frontFace,
+                                bool cullEnabled,
+                                GLenum cullMode);
+    void SetDepthState(const OpenGLFunctions& gl,
+                       bool depthTestEnabled,
+                       GLboolean depthWriteMask,
+                       GLenum depthCompareFunction);
+    void SetStencilTestEnabled(const OpenGLFunctions& gl, bool stencilTestEnabled);
     void SetStencilFuncsAndMask(const OpenGLFunctions& gl,
                                 GLenum stencilBackCompareFunction,
                                 GLenum stencilFrontCompareFunction,
                                 uint32_t stencilReadMask);
+    void SetStencilOpsAndWriteMask(const OpenGLFunctions& gl,
+                                   GLenum stencilBackFailOperation,
+                                   GLenum stencilBackDepthFailOperation,
+                                   GLenum stencilBackPassOperation,
+                                   GLenum stencilFrontFailOperation,
+                                   GLenum stencilFrontDepthFailOperation,
+                                   GLenum stencilFrontPassOperation,
+                                   uint32_t stencilWriteMask);
     void SetStencilReference(const OpenGLFunctions& gl, uint32_t stencilReference);
+    void SetSampleMask(const OpenGLFunctions& gl, GLbitfield sampleMask);
+    void SetAlphaToCoverageEnabled(const OpenGLFunctions& gl, bool alphaToCoverageEnabled);
+    void SetDepthBias(const OpenGLFunctions& gl,
+                      bool depthBiasEnabled,
+                      float slopeScale,
+                      float depthBias,
+                      float clamp);
+
+    void SetBlendEnabled(const OpenGLFunctions& gl, GLuint colorBuffer, bool blendEnabled);
+    void SetBlendEquations(const OpenGLFunctions& gl,
+                           GLuint colorBuffer,
+                           GLenum colorBlendEquation,
+                           GLenum alphaBlendEquation);
+    void SetBlendFuncs(const OpenGLFunctions& gl,
+                       GLuint colorBuffer,
+                       GLenum srcColorBlendFunc,
+                       GLenum dstColorBlendFunc,
+                       GLenum srcAlphaBlendFunc,
+                       GLenum dstAlphaBlendFunc);
+    void SetColorWriteMask(const OpenGLFunctions& gl,
+                           GLuint colorBuffer,
+                           const std::array<GLboolean, 4>& colorWriteMask);
+
+    // Non-indexed variants used when Toggle::DisableIndexedDrawBuffers is on. They set the state
+    // of every draw buffer at once, so they share the cache slot of color buffer 0 and must not
+    // be mixed with the indexed variants above.
+    void SetBlendEnabled(const OpenGLFunctions& gl, bool blendEnabled);
+    void SetBlendEquations(const OpenGLFunctions& gl,
+                           GLenum colorBlendEquation,
+                           GLenum alphaBlendEquation);
+    void SetBlendFuncs(const OpenGLFunctions& gl,
+                       GLenum srcColorBlendFunc,
+                       GLenum dstColorBlendFunc,
+                       GLenum srcAlphaBlendFunc,
+                       GLenum dstAlphaBlendFunc);
+    void SetColorWriteMask(const OpenGLFunctions& gl,
+                           const std::array<GLboolean, 4>& colorWriteMask);
 
   private:
     void CallGLStencilFunc(const OpenGLFunctions& gl);
 
+    struct CachedBlendState {
+        bool blendEnabled = false;
+        GLenum colorBlendEquation = GL_FUNC_ADD;
+        GLenum alphaBlendEquation = GL_FUNC_ADD;
+        GLenum srcColorBlendFunc = GL_ONE;
+        GLenum dstColorBlendFunc = GL_ZERO;
+        GLenum srcAlphaBlendFunc = GL_ONE;
+        GLenum dstAlphaBlendFunc = GL_ZERO;
+        std::array<GLboolean, 4> colorWriteMask = {GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE};
+    };
+
+    GLuint mVertexArrayObject = 0;
+
+    GLenum mFrontFace = GL_CCW;
+    bool mCullEnabled = false;
+    GLenum mCullMode = GL_BACK;
+
+    bool mDepthTestEnabled = false;
+    GLboolean mDepthWriteMask = GL_TRUE;
+    GLenum mDepthCompareFunction = GL_LESS;
+
+    bool mStencilTestEnabled = false;
     GLenum mStencilBackCompareFunction = GL_ALWAYS;
     GLenum mStencilFrontCompareFunction = GL_ALWAYS;
     GLuint mStencilReadMask = 0xffffffff;
     GLuint mStencilReference = 0;
+    GLenum mStencilBackFailOperation = GL_KEEP;
+    GLenum mStencilBackDepthFailOperation = GL_KEEP;
+    GLenum mStencilBackPassOperation = GL_KEEP;
+    GLenum mStencilFrontFailOperation = GL_KEEP;
+    GLenum mStencilFrontDepthFailOperation = GL_KEEP;
+    GLenum mStencilFrontPassOperation = GL_KEEP;
+    GLuint mStencilWriteMask = 0xffffffff;
+
+    GLbitfield mSampleMask = 0xffffffff;
+    bool mAlphaToCoverageEnabled = false;
+
+    bool mDepthBiasEnabled = false;
+    float mDepthBiasSlopeScale = 0.0f;
+    float mDepthBias = 0.0f;
+    float mDepthBiasClamp = 0.0f;
+
+    std::array<CachedBlendState, kMaxColorAttachments> mBlendState;
 };
 
 }  // namespace dawn::native::opengl
@@ -14,14 +14,19 @@
 
 #include "dawn/native/opengl/PipelineGL.h"
 
+#include <cstring>
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "dawn/common/BitSetIterator.h"
 #include "dawn/native/BindGroupLayout.h"
+#include "dawn/native/BlobCache.h"
+#include "dawn/native/CacheKey.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/Pipeline.h"
+#include "dawn/native/opengl/DeviceGL.h"
 #include "dawn/native/opengl/Forward.h"
 #include "dawn/native/opengl/OpenGLFunctions.h"
 #include "dawn/native/opengl/PipelineLayoutGL.h"
@@ -30,6 +35,20 @@
 
 namespace dawn::native::opengl {
 
+namespace {
+
+bool SupportsProgramBinary(const OpenGLFunctions& gl) {
+    if (gl.GetVersion().IsDesktop() ? !gl.IsAtLeastGL(4, 1) : !gl.IsAtLeastGLES(3, 0)) {
+        return false;
+    }
+    // Drivers may implement the entry points but expose no binary format.
+    GLint numFormats = 0;
+    gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+    return numFormats > 0;
+}
+
+}  // namespace
+
 PipelineGL::PipelineGL() : mProgram(0) {}
 
 PipelineGL::~PipelineGL() = default;
@@ -47,42 +66,105 @@ MaybeError PipelineGL::InitializeBase(const OpenGLFunctions& gl,
         }
     }
 
-    // Create an OpenGL shader for each stage and gather the list of combined samplers.
-    PerStage<CombinedSamplerInfo> combinedSamplers;
+    // Translate every active stage to GLSL first. The text feeds both program creation paths
+    // below, and the combined-sampler mapping produced alongside it is needed to assign texture
+    // units even when the program object itself is restored from a cached binary.
+    PerStage<const CompiledGLSL*> compiledStages;
     bool needsPlaceholderSampler = false;
-    std::vector<GLuint> glShaders;
     for (SingleShaderStage stage : IterateStages(activeStages)) {
         const ShaderModule* module = ToBackend(stages[stage].module.Get());
-        GLuint shader;
-        DAWN_TRY_ASSIGN(shader,
-                        module->CompileShader(gl, stages[stage], stage, &combinedSamplers[stage],
-                                              layout, &needsPlaceholderSampler));
-        gl.AttachShader(mProgram, shader);
-        glShaders.push_back(shader);
+        DAWN_TRY_ASSIGN(compiledStages[stage], module->GetCompiledGLSL(stages[stage], layout));
+        needsPlaceholderSampler |= compiledStages[stage]->needsPlaceholderSampler;
     }
 
     if (needsPlaceholderSampler) {
-        SamplerDescriptor desc = {};
-        ASSERT(desc.minFilter == wgpu::FilterMode::Nearest);
-        ASSERT(desc.magFilter == wgpu::FilterMode::Nearest);
-        ASSERT(desc.mipmapFilter == wgpu::FilterMode::Nearest);
-        mPlaceholderSampler =
-            ToBackend(layout->GetDevice()->GetOrCreateSampler(&desc).AcquireSuccess());
+        // The sampler is owned by the Device so that InitializeBase can run on a worker thread
+        // without racing on the device's sampler cache.
+        mPlaceholderSampler = ToBackend(layout->GetDevice())->GetPlaceholderSampler();
+    }
+
+    // Try to restore the linked program from a driver binary persisted in the blob cache. The
+    // generated GLSL already encodes the entry point, the flattened binding numbers and the GL
+    // version, so streaming it per stage on top of the device key (which covers the adapter and
+    // driver identity) is sufficient to key the binary.
+    BlobCache* cache = layout->GetDevice()->GetBlobCache();
+    const bool useProgramBinaryCache = cache != nullptr && SupportsProgramBinary(gl);
+    CacheKey binaryKey;
+    bool linked = false;
+    if (useProgramBinaryCache) {
+        StreamIn(&binaryKey, "OpenGLProgramBinary", layout->GetDevice()->GetCacheKey());
+        for (SingleShaderStage stage : IterateStages(activeStages)) {
+            StreamIn(&binaryKey, stage, compiledStages[stage]->glsl);
+        }
+
+        Blob blob = cache->Load(binaryKey);
+        if (blob.Size() > sizeof(GLenum)) {
+            GLenum binaryFormat;
+            memcpy(&binaryFormat, blob.Data(), sizeof(GLenum));
+            gl.ProgramBinary(mProgram, binaryFormat, blob.Data() + sizeof(GLenum),
+                             blob.Size() - sizeof(GLenum));
+
+            // A driver or GPU change invalidates stored binaries: glProgramBinary then raises
+            // GL_INVALID_OPERATION and leaves the program unlinked. Treat any failure as a plain
+            // cache miss and fall back to compiling from source.
+            GLint linkStatus = GL_FALSE;
+            gl.GetProgramiv(mProgram, GL_LINK_STATUS, &linkStatus);
+            linked = linkStatus == GL_TRUE;
+            if (!linked) {
+                gl.GetError();
+            }
+        }
     }
 
-    // Link all the shaders together.
-    gl.LinkProgram(mProgram);
+    if (!linked) {
+        // Create an OpenGL shader for each stage and link them together.
+        std::vector<GLuint> glShaders;
+        for (SingleShaderStage stage : IterateStages(activeStages)) {
+            const ShaderModule* module = ToBackend(stages[stage].module.Get());
+            GLuint shader;
+            DAWN_TRY_ASSIGN(shader, module->CompileShader(gl, *compiledStages[stage], stage));
+            gl.AttachShader(mProgram, shader);
+            glShaders.push_back(shader);
+        }
+
+        if (useProgramBinaryCache) {
+            gl.ProgramParameteri(mProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        gl.LinkProgram(mProgram);
+
+        GLint linkStatus = GL_FALSE;
+        gl.GetProgramiv(mProgram, GL_LINK_STATUS, &linkStatus);
+        if (linkStatus == GL_FALSE) {
+            GLint infoLogLength = 0;
+            gl.GetProgramiv(mProgram, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+            if (infoLogLength > 1) {
+                std::vector<char> buffer(infoLogLength);
+                gl.GetProgramInfoLog(mProgram, infoLogLength, nullptr, &buffer[0]);
+                return DAWN_FORMAT_VALIDATION_ERROR("Program link failed:\n%s", buffer.data());
+            }
+        }
 
-    GLint linkStatus = GL_FALSE;
-    gl.GetProgramiv(mProgram, GL_LINK_STATUS, &linkStatus);
-    if (linkStatus == GL_FALSE) {
-        GLint infoLogLength = 0;
-        gl.GetProgramiv(mProgram, GL_INFO_LOG_LENGTH, &infoLogLength);
+        for (GLuint glShader : glShaders) {
+            gl.DetachShader(mProgram, glShader);
+            gl.DeleteShader(glShader);
+        }
 
-        if (infoLogLength > 1) {
-            std::vector<char> buffer(infoLogLength);
-            gl.GetProgramInfoLog(mProgram, infoLogLength, nullptr, &buffer[0]);
-            return DAWN_FORMAT_VALIDATION_ERROR("Program link failed:\n%s", buffer.data());
+        if (useProgramBinaryCache) {
+            // Persist the freshly linked program, prefixed with its driver-specific format.
+            GLint binaryLength = 0;
+            gl.GetProgramiv(mProgram, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+            if (binaryLength > 0) {
+                std::vector<uint8_t> binary(sizeof(GLenum) + binaryLength);
+                GLenum binaryFormat = 0;
+                GLsizei writtenLength = 0;
+                gl.GetProgramBinary(mProgram, binaryLength, &writtenLength, &binaryFormat,
+                                    binary.data() + sizeof(GLenum));
+                if (writtenLength > 0) {
+                    memcpy(binary.data(), &binaryFormat, sizeof(GLenum));
+                    cache->Store(binaryKey, sizeof(GLenum) + writtenLength, binary.data());
+                }
+            }
         }
     }
 
@@ -92,7 +174,7 @@ MaybeError PipelineGL::InitializeBase(const OpenGLFunctions& gl,
 
     std::set<CombinedSampler> combinedSamplersSet;
     for (SingleShaderStage stage : IterateStages(activeStages)) {
-        for (const CombinedSampler& combined : combinedSamplers[stage]) {
+        for (const CombinedSampler& combined : compiledStages[stage]->combinedSamplerInfo) {
             combinedSamplersSet.insert(combined);
         }
     }
@@ -139,11 +221,6 @@ MaybeError PipelineGL::InitializeBase(const OpenGLFunctions& gl,
         textureUnit++;
     }
 
-    for (GLuint glShader : glShaders) {
-        gl.DetachShader(mProgram, glShader);
-        gl.DeleteShader(glShader);
-    }
-
     return {};
 }
 
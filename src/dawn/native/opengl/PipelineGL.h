@@ -59,8 +59,7 @@ class PipelineGL {
     std::vector<std::vector<SamplerUnit>> mUnitsForSamplers;
     std::vector<std::vector<GLuint>> mUnitsForTextures;
     std::vector<GLuint> mPlaceholderSamplerUnits;
-    // TODO(enga): This could live on the Device, or elsewhere, but currently it makes Device
-    // destruction complex as it requires the sampler to be destroyed before the sampler cache.
+    // Owned by the Device, see Device::GetPlaceholderSampler.
     Ref<Sampler> mPlaceholderSampler;
 };
 
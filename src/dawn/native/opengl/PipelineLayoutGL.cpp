@@ -14,6 +14,8 @@
 
 #include "dawn/native/opengl/PipelineLayoutGL.h"
 
+#include <utility>
+
 #include "dawn/common/BitSetIterator.h"
 #include "dawn/native/BindGroupLayout.h"
 #include "dawn/native/opengl/DeviceGL.h"
@@ -91,4 +93,20 @@ size_t PipelineLayout::GetNumSampledTextures() const {
     return mNumSampledTextures;
 }
 
+const CompiledGLSL* PipelineLayout::GetCachedGLSL(size_t moduleHash,
+                                                  const std::string& entryPoint) const {
+    auto iter = mGLSLCache.find({moduleHash, entryPoint});
+    if (iter == mGLSLCache.end()) {
+        return nullptr;
+    }
+    return &iter->second;
+}
+
+const CompiledGLSL& PipelineLayout::CacheGLSL(size_t moduleHash,
+                                              const std::string& entryPoint,
+                                              CompiledGLSL compiled) const {
+    return mGLSLCache.insert_or_assign({moduleHash, entryPoint}, std::move(compiled))
+        .first->second;
+}
+
 }  // namespace dawn::native::opengl
@@ -15,11 +15,16 @@
 #ifndef SRC_DAWN_NATIVE_OPENGL_PIPELINELAYOUTGL_H_
 #define SRC_DAWN_NATIVE_OPENGL_PIPELINELAYOUTGL_H_
 
+#include <map>
+#include <string>
+#include <utility>
+
 #include "dawn/native/PipelineLayout.h"
 
 #include "dawn/common/ityp_array.h"
-#include "dawn/common/ityp_vector.h"
+#include "dawn/common/ityp_stack_vec.h"
 #include "dawn/native/BindingInfo.h"
+#include "dawn/native/opengl/ShaderModuleGL.h"
 #include "dawn/native/opengl/opengl_platform.h"
 
 namespace dawn::native::opengl {
@@ -31,18 +36,28 @@ class PipelineLayout final : public PipelineLayoutBase {
     PipelineLayout(Device* device, const PipelineLayoutDescriptor* descriptor);
 
     using BindingIndexInfo =
-        ityp::array<BindGroupIndex, ityp::vector<BindingIndex, GLuint>, kMaxBindGroups>;
+        ityp::array<BindGroupIndex,
+                    ityp::stack_vec<BindingIndex, GLuint, kMaxOptimalBindingsPerGroup>,
+                    kMaxBindGroups>;
     const BindingIndexInfo& GetBindingIndexInfo() const;
 
     GLuint GetTextureUnitsUsed() const;
     size_t GetNumSamplers() const;
     size_t GetNumSampledTextures() const;
 
+    // Looks up the GLSL previously generated against this layout for a shader module (identified
+    // by content hash) and entry point, or returns nullptr if there is none.
+    const CompiledGLSL* GetCachedGLSL(size_t moduleHash, const std::string& entryPoint) const;
+    const CompiledGLSL& CacheGLSL(size_t moduleHash,
+                                  const std::string& entryPoint,
+                                  CompiledGLSL compiled) const;
+
   private:
     ~PipelineLayout() override = default;
     BindingIndexInfo mIndexInfo;
     size_t mNumSamplers;
     size_t mNumSampledTextures;
+    mutable std::map<std::pair<size_t, std::string>, CompiledGLSL> mGLSLCache;
 };
 
 }  // namespace dawn::native::opengl
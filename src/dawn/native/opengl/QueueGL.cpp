@@ -42,7 +42,17 @@ MaybeError Queue::WriteBufferImpl(BufferBase* buffer,
                                   uint64_t bufferOffset,
                                   const void* data,
                                   size_t size) {
-    const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
+    Device* device = ToBackend(GetDevice());
+
+    // Stream the data through DynamicUploader's fenced ring of persistently mapped staging
+    // buffers when immutable buffer storage is available: the data is memcpy'd into coherent
+    // memory and copied GPU-side, so the driver never stalls waiting for in-flight commands
+    // that still read the destination, unlike glBufferSubData which may synchronize.
+    if (device->SupportsBufferStorage()) {
+        return QueueBase::WriteBufferImpl(buffer, bufferOffset, data, size);
+    }
+
+    const OpenGLFunctions& gl = device->GetGL();
 
     ToBackend(buffer)->EnsureDataInitializedAsDestination(bufferOffset, size);
 
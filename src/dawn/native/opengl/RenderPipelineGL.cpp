@@ -14,6 +14,11 @@
 
 #include "dawn/native/opengl/RenderPipelineGL.h"
 
+#include <array>
+#include <utility>
+
+#include "dawn/native/VertexFormat.h"
+#include "dawn/native/opengl/BufferGL.h"
 #include "dawn/native/opengl/DeviceGL.h"
 #include "dawn/native/opengl/Forward.h"
 #include "dawn/native/opengl/PersistentPipelineStateGL.h"
@@ -39,22 +44,101 @@ GLenum GLPrimitiveTopology(wgpu::PrimitiveTopology primitiveTopology) {
     UNREACHABLE();
 }
 
+GLenum VertexFormatType(wgpu::VertexFormat format) {
+    switch (format) {
+        case wgpu::VertexFormat::Uint8x2:
+        case wgpu::VertexFormat::Uint8x4:
+        case wgpu::VertexFormat::Unorm8x2:
+        case wgpu::VertexFormat::Unorm8x4:
+            return GL_UNSIGNED_BYTE;
+        case wgpu::VertexFormat::Sint8x2:
+        case wgpu::VertexFormat::Sint8x4:
+        case wgpu::VertexFormat::Snorm8x2:
+        case wgpu::VertexFormat::Snorm8x4:
+            return GL_BYTE;
+        case wgpu::VertexFormat::Uint16x2:
+        case wgpu::VertexFormat::Uint16x4:
+        case wgpu::VertexFormat::Unorm16x2:
+        case wgpu::VertexFormat::Unorm16x4:
+            return GL_UNSIGNED_SHORT;
+        case wgpu::VertexFormat::Sint16x2:
+        case wgpu::VertexFormat::Sint16x4:
+        case wgpu::VertexFormat::Snorm16x2:
+        case wgpu::VertexFormat::Snorm16x4:
+            return GL_SHORT;
+        case wgpu::VertexFormat::Float16x2:
+        case wgpu::VertexFormat::Float16x4:
+            return GL_HALF_FLOAT;
+        case wgpu::VertexFormat::Float32:
+        case wgpu::VertexFormat::Float32x2:
+        case wgpu::VertexFormat::Float32x3:
+        case wgpu::VertexFormat::Float32x4:
+            return GL_FLOAT;
+        case wgpu::VertexFormat::Uint32:
+        case wgpu::VertexFormat::Uint32x2:
+        case wgpu::VertexFormat::Uint32x3:
+        case wgpu::VertexFormat::Uint32x4:
+            return GL_UNSIGNED_INT;
+        case wgpu::VertexFormat::Sint32:
+        case wgpu::VertexFormat::Sint32x2:
+        case wgpu::VertexFormat::Sint32x3:
+        case wgpu::VertexFormat::Sint32x4:
+            return GL_INT;
+        default:
+            UNREACHABLE();
+    }
+}
+
+GLboolean VertexFormatIsNormalized(wgpu::VertexFormat format) {
+    switch (format) {
+        case wgpu::VertexFormat::Unorm8x2:
+        case wgpu::VertexFormat::Unorm8x4:
+        case wgpu::VertexFormat::Snorm8x2:
+        case wgpu::VertexFormat::Snorm8x4:
+        case wgpu::VertexFormat::Unorm16x2:
+        case wgpu::VertexFormat::Unorm16x4:
+        case wgpu::VertexFormat::Snorm16x2:
+        case wgpu::VertexFormat::Snorm16x4:
+            return GL_TRUE;
+        default:
+            return GL_FALSE;
+    }
+}
+
+bool VertexFormatIsInt(wgpu::VertexFormat format) {
+    switch (format) {
+        case wgpu::VertexFormat::Uint8x2:
+        case wgpu::VertexFormat::Uint8x4:
+        case wgpu::VertexFormat::Sint8x2:
+        case wgpu::VertexFormat::Sint8x4:
+        case wgpu::VertexFormat::Uint16x2:
+        case wgpu::VertexFormat::Uint16x4:
+        case wgpu::VertexFormat::Sint16x2:
+        case wgpu::VertexFormat::Sint16x4:
+        case wgpu::VertexFormat::Uint32:
+        case wgpu::VertexFormat::Uint32x2:
+        case wgpu::VertexFormat::Uint32x3:
+        case wgpu::VertexFormat::Uint32x4:
+        case wgpu::VertexFormat::Sint32:
+        case wgpu::VertexFormat::Sint32x2:
+        case wgpu::VertexFormat::Sint32x3:
+        case wgpu::VertexFormat::Sint32x4:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void ApplyFrontFaceAndCulling(const OpenGLFunctions& gl,
+                              PersistentPipelineState* persistentPipelineState,
                               wgpu::FrontFace face,
                               wgpu::CullMode mode) {
     // Note that we invert winding direction in OpenGL. Because Y axis is up in OpenGL,
     // which is different from WebGPU and other backends (Y axis is down).
     GLenum direction = (face == wgpu::FrontFace::CCW) ? GL_CW : GL_CCW;
-    gl.FrontFace(direction);
-
-    if (mode == wgpu::CullMode::None) {
-        gl.Disable(GL_CULL_FACE);
-    } else {
-        gl.Enable(GL_CULL_FACE);
-
-        GLenum cullMode = (mode == wgpu::CullMode::Front) ? GL_FRONT : GL_BACK;
-        gl.CullFace(cullMode);
-    }
+    GLenum cullMode = (mode == wgpu::CullMode::Front) ? GL_FRONT : GL_BACK;
+    persistentPipelineState->SetFrontFaceAndCulling(gl, direction, mode != wgpu::CullMode::None,
+                                                    cullMode);
 }
 
 GLenum GLBlendFactor(wgpu::BlendFactor factor, bool alpha) {
@@ -105,43 +189,51 @@ GLenum GLBlendMode(wgpu::BlendOperation operation) {
     UNREACHABLE();
 }
 
+std::array<GLboolean, 4> GLColorWriteMask(wgpu::ColorWriteMask writeMask) {
+    return {writeMask & wgpu::ColorWriteMask::Red ? GL_TRUE : GL_FALSE,
+            writeMask & wgpu::ColorWriteMask::Green ? GL_TRUE : GL_FALSE,
+            writeMask & wgpu::ColorWriteMask::Blue ? GL_TRUE : GL_FALSE,
+            writeMask & wgpu::ColorWriteMask::Alpha ? GL_TRUE : GL_FALSE};
+}
+
 void ApplyColorState(const OpenGLFunctions& gl,
+                     PersistentPipelineState* persistentPipelineState,
                      ColorAttachmentIndex attachment,
                      const ColorTargetState* state) {
     GLuint colorBuffer = static_cast<GLuint>(static_cast<uint8_t>(attachment));
     if (state->blend != nullptr) {
-        gl.Enablei(GL_BLEND, colorBuffer);
-        gl.BlendEquationSeparatei(colorBuffer, GLBlendMode(state->blend->color.operation),
-                                  GLBlendMode(state->blend->alpha.operation));
-        gl.BlendFuncSeparatei(colorBuffer, GLBlendFactor(state->blend->color.srcFactor, false),
-                              GLBlendFactor(state->blend->color.dstFactor, false),
-                              GLBlendFactor(state->blend->alpha.srcFactor, true),
-                              GLBlendFactor(state->blend->alpha.dstFactor, true));
+        persistentPipelineState->SetBlendEnabled(gl, colorBuffer, true);
+        persistentPipelineState->SetBlendEquations(gl, colorBuffer,
+                                                   GLBlendMode(state->blend->color.operation),
+                                                   GLBlendMode(state->blend->alpha.operation));
+        persistentPipelineState->SetBlendFuncs(
+            gl, colorBuffer, GLBlendFactor(state->blend->color.srcFactor, false),
+            GLBlendFactor(state->blend->color.dstFactor, false),
+            GLBlendFactor(state->blend->alpha.srcFactor, true),
+            GLBlendFactor(state->blend->alpha.dstFactor, true));
     } else {
-        gl.Disablei(GL_BLEND, colorBuffer);
+        persistentPipelineState->SetBlendEnabled(gl, colorBuffer, false);
     }
-    gl.ColorMaski(colorBuffer, state->writeMask & wgpu::ColorWriteMask::Red,
-                  state->writeMask & wgpu::ColorWriteMask::Green,
-                  state->writeMask & wgpu::ColorWriteMask::Blue,
-                  state->writeMask & wgpu::ColorWriteMask::Alpha);
+    persistentPipelineState->SetColorWriteMask(gl, colorBuffer,
+                                               GLColorWriteMask(state->writeMask));
 }
 
-void ApplyColorState(const OpenGLFunctions& gl, const ColorTargetState* state) {
+void ApplyColorState(const OpenGLFunctions& gl,
+                     PersistentPipelineState* persistentPipelineState,
+                     const ColorTargetState* state) {
     if (state->blend != nullptr) {
-        gl.Enable(GL_BLEND);
-        gl.BlendEquationSeparate(GLBlendMode(state->blend->color.operation),
-                                 GLBlendMode(state->blend->alpha.operation));
-        gl.BlendFuncSeparate(GLBlendFactor(state->blend->color.srcFactor, false),
-                             GLBlendFactor(state->blend->color.dstFactor, false),
-                             GLBlendFactor(state->blend->alpha.srcFactor, true),
-                             GLBlendFactor(state->blend->alpha.dstFactor, true));
+        persistentPipelineState->SetBlendEnabled(gl, true);
+        persistentPipelineState->SetBlendEquations(gl, GLBlendMode(state->blend->color.operation),
+                                                   GLBlendMode(state->blend->alpha.operation));
+        persistentPipelineState->SetBlendFuncs(
+            gl, GLBlendFactor(state->blend->color.srcFactor, false),
+            GLBlendFactor(state->blend->color.dstFactor, false),
+            GLBlendFactor(state->blend->alpha.srcFactor, true),
+            GLBlendFactor(state->blend->alpha.dstFactor, true));
     } else {
-        gl.Disable(GL_BLEND);
+        persistentPipelineState->SetBlendEnabled(gl, false);
     }
-    gl.ColorMask(state->writeMask & wgpu::ColorWriteMask::Red,
-                 state->writeMask & wgpu::ColorWriteMask::Green,
-                 state->writeMask & wgpu::ColorWriteMask::Blue,
-                 state->writeMask & wgpu::ColorWriteMask::Alpha);
+    persistentPipelineState->SetColorWriteMask(gl, GLColorWriteMask(state->writeMask));
 }
 
 bool Equal(const BlendComponent& lhs, const BlendComponent& rhs) {
@@ -175,40 +267,26 @@ void ApplyDepthStencilState(const OpenGLFunctions& gl,
                             const DepthStencilState* descriptor,
                             PersistentPipelineState* persistentPipelineState) {
     // Depth writes only occur if depth is enabled
-    if (descriptor->depthCompare == wgpu::CompareFunction::Always &&
-        !descriptor->depthWriteEnabled) {
-        gl.Disable(GL_DEPTH_TEST);
-    } else {
-        gl.Enable(GL_DEPTH_TEST);
-    }
+    bool depthTestEnabled = descriptor->depthCompare != wgpu::CompareFunction::Always ||
+                            descriptor->depthWriteEnabled;
+    persistentPipelineState->SetDepthState(gl, depthTestEnabled,
+                                           descriptor->depthWriteEnabled ? GL_TRUE : GL_FALSE,
+                                           ToOpenGLCompareFunction(descriptor->depthCompare));
 
-    if (descriptor->depthWriteEnabled) {
-        gl.DepthMask(GL_TRUE);
-    } else {
-        gl.DepthMask(GL_FALSE);
-    }
-
-    gl.DepthFunc(ToOpenGLCompareFunction(descriptor->depthCompare));
-
-    if (StencilTestEnabled(descriptor)) {
-        gl.Enable(GL_STENCIL_TEST);
-    } else {
-        gl.Disable(GL_STENCIL_TEST);
-    }
+    persistentPipelineState->SetStencilTestEnabled(gl, StencilTestEnabled(descriptor));
 
     GLenum backCompareFunction = ToOpenGLCompareFunction(descriptor->stencilBack.compare);
     GLenum frontCompareFunction = ToOpenGLCompareFunction(descriptor->stencilFront.compare);
     persistentPipelineState->SetStencilFuncsAndMask(gl, backCompareFunction, frontCompareFunction,
                                                     descriptor->stencilReadMask);
 
-    gl.StencilOpSeparate(GL_BACK, OpenGLStencilOperation(descriptor->stencilBack.failOp),
-                         OpenGLStencilOperation(descriptor->stencilBack.depthFailOp),
-                         OpenGLStencilOperation(descriptor->stencilBack.passOp));
-    gl.StencilOpSeparate(GL_FRONT, OpenGLStencilOperation(descriptor->stencilFront.failOp),
-                         OpenGLStencilOperation(descriptor->stencilFront.depthFailOp),
-                         OpenGLStencilOperation(descriptor->stencilFront.passOp));
-
-    gl.StencilMask(descriptor->stencilWriteMask);
+    persistentPipelineState->SetStencilOpsAndWriteMask(
+        gl, OpenGLStencilOperation(descriptor->stencilBack.failOp),
+        OpenGLStencilOperation(descriptor->stencilBack.depthFailOp),
+        OpenGLStencilOperation(descriptor->stencilBack.passOp),
+        OpenGLStencilOperation(descriptor->stencilFront.failOp),
+        OpenGLStencilOperation(descriptor->stencilFront.depthFailOp),
+        OpenGLStencilOperation(descriptor->stencilFront.passOp), descriptor->stencilWriteMask);
 }
 
 }  // anonymous namespace
@@ -222,13 +300,19 @@ Ref<RenderPipeline> RenderPipeline::CreateUninitialized(
 
 RenderPipeline::RenderPipeline(Device* device, const RenderPipelineDescriptor* descriptor)
     : RenderPipelineBase(device, descriptor),
-      mVertexArrayObject(0),
-      mGlPrimitiveTopology(GLPrimitiveTopology(GetPrimitiveTopology())) {}
+      mGlPrimitiveTopology(GLPrimitiveTopology(GetPrimitiveTopology())) {
+    for (VertexAttributeLocation location : IterateBitSet(GetAttributeLocationsUsed())) {
+        const VertexAttributeInfo& attribute = GetAttribute(location);
+        mAttributesUsingVertexBuffer[attribute.vertexBufferSlot][location] = true;
+    }
+}
 
 MaybeError RenderPipeline::Initialize() {
     DAWN_TRY(
         InitializeBase(ToBackend(GetDevice())->GetGL(), ToBackend(GetLayout()), GetAllStages()));
-    CreateVAOForVertexState();
+    // VAOs are created lazily in GetVAOForVertexBuffers. Vertex array objects are not shared
+    // between GL contexts, so they must be created on the device context and not on the
+    // context of the worker thread that may run Initialize for Create*PipelineAsync.
     return {};
 }
 
@@ -237,7 +321,10 @@ RenderPipeline::~RenderPipeline() = default;
 void RenderPipeline::DestroyImpl() {
     RenderPipelineBase::DestroyImpl();
     const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
-    gl.DeleteVertexArrays(1, &mVertexArrayObject);
+    for (CachedVAO& entry : mVAOCache) {
+        gl.DeleteVertexArrays(1, &entry.vao);
+    }
+    mVAOCache.clear();
     gl.BindVertexArray(0);
     DeleteProgram(gl);
 }
@@ -252,18 +339,38 @@ RenderPipeline::GetAttributesUsingVertexBuffer(VertexBufferSlot slot) const {
     return mAttributesUsingVertexBuffer[slot];
 }
 
-void RenderPipeline::CreateVAOForVertexState() {
+GLuint RenderPipeline::GetVAOForVertexBuffers(
+    const ityp::array<VertexBufferSlot, Buffer*, kMaxVertexBuffers>& buffers,
+    const ityp::array<VertexBufferSlot, uint64_t, kMaxVertexBuffers>& offsets,
+    PersistentPipelineState* persistentPipelineState) {
     const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
 
-    gl.GenVertexArrays(1, &mVertexArrayObject);
-    gl.BindVertexArray(mVertexArrayObject);
+    for (auto it = mVAOCache.begin(); it != mVAOCache.end(); ++it) {
+        bool matches = true;
+        for (VertexBufferSlot slot : IterateBitSet(GetVertexBufferSlotsUsed())) {
+            if (it->bufferIds[slot] != buffers[slot]->GetUniqueId() ||
+                it->offsets[slot] != offsets[slot]) {
+                matches = false;
+                break;
+            }
+        }
+        if (matches) {
+            mVAOCache.splice(mVAOCache.begin(), mVAOCache, it);
+            persistentPipelineState->SetVertexArrayObject(gl, it->vao);
+            return it->vao;
+        }
+    }
+
+    // Bake the attribute formats and the buffer bindings into a new VAO.
+    CachedVAO entry = {};
+    gl.GenVertexArrays(1, &entry.vao);
+    persistentPipelineState->SetVertexArrayObject(gl, entry.vao);
 
     for (VertexAttributeLocation location : IterateBitSet(GetAttributeLocationsUsed())) {
-        const auto& attribute = GetAttribute(location);
+        const VertexAttributeInfo& attribute = GetAttribute(location);
         GLuint glAttrib = static_cast<GLuint>(static_cast<uint8_t>(location));
         gl.EnableVertexAttribArray(glAttrib);
 
-        mAttributesUsingVertexBuffer[attribute.vertexBufferSlot][location] = true;
         const VertexBufferInfo& vertexBuffer = GetVertexBuffer(attribute.vertexBufferSlot);
 
         if (vertexBuffer.arrayStride == 0) {
@@ -281,50 +388,62 @@ void RenderPipeline::CreateVAOForVertexState() {
                     UNREACHABLE();
             }
         }
+
+        uint64_t offset = offsets[attribute.vertexBufferSlot];
+        uint32_t components = GetVertexFormatInfo(attribute.format).componentCount;
+        GLenum formatType = VertexFormatType(attribute.format);
+
+        gl.BindBuffer(GL_ARRAY_BUFFER, buffers[attribute.vertexBufferSlot]->GetHandle());
+        if (VertexFormatIsInt(attribute.format)) {
+            gl.VertexAttribIPointer(
+                glAttrib, components, formatType, vertexBuffer.arrayStride,
+                reinterpret_cast<void*>(static_cast<intptr_t>(offset + attribute.offset)));
+        } else {
+            gl.VertexAttribPointer(
+                glAttrib, components, formatType, VertexFormatIsNormalized(attribute.format),
+                vertexBuffer.arrayStride,
+                reinterpret_cast<void*>(static_cast<intptr_t>(offset + attribute.offset)));
+        }
+    }
+
+    for (VertexBufferSlot slot : IterateBitSet(GetVertexBufferSlotsUsed())) {
+        entry.bufferIds[slot] = buffers[slot]->GetUniqueId();
+        entry.offsets[slot] = offsets[slot];
     }
+
+    mVAOCache.push_front(std::move(entry));
+    if (mVAOCache.size() > kVAOCacheSize) {
+        gl.DeleteVertexArrays(1, &mVAOCache.back().vao);
+        mVAOCache.pop_back();
+    }
+    return mVAOCache.front().vao;
 }
 
 void RenderPipeline::ApplyNow(PersistentPipelineState& persistentPipelineState) {
     const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
     PipelineGL::ApplyNow(gl);
 
-    ASSERT(mVertexArrayObject);
-    gl.BindVertexArray(mVertexArrayObject);
-
-    ApplyFrontFaceAndCulling(gl, GetFrontFace(), GetCullMode());
+    ApplyFrontFaceAndCulling(gl, &persistentPipelineState, GetFrontFace(), GetCullMode());
 
     ApplyDepthStencilState(gl, GetDepthStencilState(), &persistentPipelineState);
 
-    gl.SampleMaski(0, GetSampleMask());
-    if (IsAlphaToCoverageEnabled()) {
-        gl.Enable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-    } else {
-        gl.Disable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-    }
+    persistentPipelineState.SetSampleMask(gl, GetSampleMask());
+    persistentPipelineState.SetAlphaToCoverageEnabled(gl, IsAlphaToCoverageEnabled());
 
-    if (IsDepthBiasEnabled()) {
-        gl.Enable(GL_POLYGON_OFFSET_FILL);
-        float depthBias = GetDepthBias();
-        float slopeScale = GetDepthBiasSlopeScale();
-        if (gl.PolygonOffsetClamp != nullptr) {
-            gl.PolygonOffsetClamp(slopeScale, depthBias, GetDepthBiasClamp());
-        } else {
-            gl.PolygonOffset(slopeScale, depthBias);
-        }
-    } else {
-        gl.Disable(GL_POLYGON_OFFSET_FILL);
-    }
+    persistentPipelineState.SetDepthBias(gl, IsDepthBiasEnabled(), GetDepthBiasSlopeScale(),
+                                         GetDepthBias(), GetDepthBiasClamp());
 
     if (!GetDevice()->IsToggleEnabled(Toggle::DisableIndexedDrawBuffers)) {
         for (ColorAttachmentIndex attachmentSlot : IterateBitSet(GetColorAttachmentsMask())) {
-            ApplyColorState(gl, attachmentSlot, GetColorTargetState(attachmentSlot));
+            ApplyColorState(gl, &persistentPipelineState, attachmentSlot,
+                            GetColorTargetState(attachmentSlot));
         }
     } else {
         const ColorTargetState* prevDescriptor = nullptr;
         for (ColorAttachmentIndex attachmentSlot : IterateBitSet(GetColorAttachmentsMask())) {
             const ColorTargetState* descriptor = GetColorTargetState(attachmentSlot);
             if (!prevDescriptor) {
-                ApplyColorState(gl, descriptor);
+                ApplyColorState(gl, &persistentPipelineState, descriptor);
                 prevDescriptor = descriptor;
             } else if ((descriptor->blend == nullptr) != (prevDescriptor->blend == nullptr)) {
                 // TODO(crbug.com/dawn/582): GLES < 3.2 does not support different blend states
@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_OPENGL_RENDERPIPELINEGL_H_
 #define SRC_DAWN_NATIVE_OPENGL_RENDERPIPELINEGL_H_
 
+#include <list>
 #include <vector>
 
 #include "dawn/native/RenderPipeline.h"
@@ -24,6 +25,7 @@
 
 namespace dawn::native::opengl {
 
+class Buffer;
 class Device;
 class PersistentPipelineState;
 
@@ -36,6 +38,14 @@ class RenderPipeline final : public RenderPipelineBase, public PipelineGL {
     ityp::bitset<VertexAttributeLocation, kMaxVertexAttributes> GetAttributesUsingVertexBuffer(
         VertexBufferSlot slot) const;
 
+    // Returns a VAO holding this pipeline's attribute formats together with the given buffer
+    // bindings, creating and caching it on first use and binding it through
+    // |persistentPipelineState|. Only the slots the vertex state uses are read.
+    GLuint GetVAOForVertexBuffers(
+        const ityp::array<VertexBufferSlot, Buffer*, kMaxVertexBuffers>& buffers,
+        const ityp::array<VertexBufferSlot, uint64_t, kMaxVertexBuffers>& offsets,
+        PersistentPipelineState* persistentPipelineState);
+
     void ApplyNow(PersistentPipelineState& persistentPipelineState);
 
     MaybeError Initialize() override;
@@ -45,10 +55,21 @@ class RenderPipeline final : public RenderPipelineBase, public PipelineGL {
     ~RenderPipeline() override;
     void DestroyImpl() override;
 
-    void CreateVAOForVertexState();
-
-    // TODO(yunchao.he@intel.com): vao need to be deduplicated between pipelines.
-    GLuint mVertexArrayObject;
+    // Bounds the VAOs cached per pipeline. Lookups are a linear scan so the cap also keeps the
+    // scan short; a draw loop cycling through more buffer sets than this rebuilds VAOs.
+    static constexpr size_t kVAOCacheSize = 16;
+
+    // Keyed on Buffer::GetUniqueId, not the GL buffer name: GL recycles names after
+    // glDeleteBuffers while cached VAOs keep the old buffer object alive, so a new buffer
+    // reusing the name must not match the stale entry.
+    struct CachedVAO {
+        ityp::array<VertexBufferSlot, uint64_t, kMaxVertexBuffers> bufferIds;
+        ityp::array<VertexBufferSlot, uint64_t, kMaxVertexBuffers> offsets;
+        GLuint vao;
+    };
+
+    // Most recently used first.
+    std::list<CachedVAO> mVAOCache;
     GLenum mGlPrimitiveTopology;
 
     ityp::array<VertexBufferSlot,
@@ -135,14 +135,59 @@ MaybeError ShaderModule::Initialize(ShaderModuleParseResult* parseResult,
     return {};
 }
 
-ResultOrError<GLuint> ShaderModule::CompileShader(const OpenGLFunctions& gl,
-                                                  const ProgrammableStage& programmableStage,
-                                                  SingleShaderStage stage,
-                                                  CombinedSamplerInfo* combinedSamplers,
-                                                  const PipelineLayout* layout,
-                                                  bool* needsPlaceholderSampler) const {
+ResultOrError<const CompiledGLSL*> ShaderModule::GetCompiledGLSL(
+    const ProgrammableStage& programmableStage,
+    const PipelineLayout* layout) const {
     TRACE_EVENT0(GetDevice()->GetPlatform(), General, "TranslateToGLSL");
 
+    // The generated GLSL only depends on the module contents, the entry point and the layout, so
+    // the layout memoizes it: pipelines that recreate the same stage pairing skip the Tint
+    // transforms and generation entirely and reuse the text verbatim.
+    const CompiledGLSL* compiled =
+        layout->GetCachedGLSL(GetContentHash(), programmableStage.entryPoint);
+    if (compiled == nullptr) {
+        DAWN_TRY_ASSIGN(compiled, GenerateGLSL(programmableStage, layout));
+    }
+
+    if (GetDevice()->IsToggleEnabled(Toggle::DumpShaders)) {
+        std::ostringstream dumpedMsg;
+        dumpedMsg << "/* Dumped generated GLSL */" << std::endl << compiled->glsl;
+
+        GetDevice()->EmitLog(WGPULoggingType_Info, dumpedMsg.str().c_str());
+    }
+
+    return compiled;
+}
+
+ResultOrError<GLuint> ShaderModule::CompileShader(const OpenGLFunctions& gl,
+                                                  const CompiledGLSL& compiled,
+                                                  SingleShaderStage stage) const {
+    GLuint shader = gl.CreateShader(GLShaderType(stage));
+    const char* source = compiled.glsl.c_str();
+    gl.ShaderSource(shader, 1, &source, nullptr);
+    gl.CompileShader(shader);
+
+    GLint compileStatus = GL_FALSE;
+    gl.GetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
+    if (compileStatus == GL_FALSE) {
+        GLint infoLogLength = 0;
+        gl.GetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+        if (infoLogLength > 1) {
+            std::vector<char> buffer(infoLogLength);
+            gl.GetShaderInfoLog(shader, infoLogLength, nullptr, &buffer[0]);
+            gl.DeleteShader(shader);
+            return DAWN_FORMAT_VALIDATION_ERROR("%s\nProgram compilation failed:\n%s", source,
+                                                buffer.data());
+        }
+    }
+
+    return shader;
+}
+
+ResultOrError<const CompiledGLSL*> ShaderModule::GenerateGLSL(
+    const ProgrammableStage& programmableStage,
+    const PipelineLayout* layout) const {
     const OpenGLVersion& version = ToBackend(GetDevice())->GetGL().GetVersion();
 
     using tint::transform::BindingPoint;
@@ -242,39 +287,14 @@ ResultOrError<GLuint> ShaderModule::CompileShader(const OpenGLFunctions& gl,
                 {std::move(result.glsl), needsPlaceholderSampler, std::move(combinedSamplerInfo)}};
         });
 
-    if (GetDevice()->IsToggleEnabled(Toggle::DumpShaders)) {
-        std::ostringstream dumpedMsg;
-        dumpedMsg << "/* Dumped generated GLSL */" << std::endl << compilationResult->glsl;
-
-        GetDevice()->EmitLog(WGPULoggingType_Info, dumpedMsg.str().c_str());
-    }
-
-    GLuint shader = gl.CreateShader(GLShaderType(stage));
-    const char* source = compilationResult->glsl.c_str();
-    gl.ShaderSource(shader, 1, &source, nullptr);
-    gl.CompileShader(shader);
-
-    GLint compileStatus = GL_FALSE;
-    gl.GetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
-    if (compileStatus == GL_FALSE) {
-        GLint infoLogLength = 0;
-        gl.GetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
-
-        if (infoLogLength > 1) {
-            std::vector<char> buffer(infoLogLength);
-            gl.GetShaderInfoLog(shader, infoLogLength, nullptr, &buffer[0]);
-            gl.DeleteShader(shader);
-            return DAWN_FORMAT_VALIDATION_ERROR("%s\nProgram compilation failed:\n%s", source,
-                                                buffer.data());
-        }
-    }
-
     if (BlobCache* cache = GetDevice()->GetBlobCache()) {
         cache->EnsureStored(compilationResult);
     }
-    *needsPlaceholderSampler = compilationResult->needsPlaceholderSampler;
-    *combinedSamplers = std::move(compilationResult->combinedSamplerInfo);
-    return shader;
+
+    return &layout->CacheGLSL(GetContentHash(), programmableStage.entryPoint,
+                              {std::move(compilationResult->glsl),
+                               compilationResult->needsPlaceholderSampler,
+                               std::move(compilationResult->combinedSamplerInfo)});
 }
 
 }  // namespace dawn::native::opengl
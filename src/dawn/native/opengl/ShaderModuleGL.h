@@ -66,6 +66,16 @@ bool operator<(const CombinedSampler& a, const CombinedSampler& b);
 
 using CombinedSamplerInfo = std::vector<CombinedSampler>;
 
+// The result of translating one shader stage to GLSL. Generation only depends on the module
+// contents, the entry point and the pipeline layout, so PipelineLayout memoizes these: pipelines
+// that pair the same module and entry point with the same layout again reuse the generated text
+// and combined-sampler mapping verbatim.
+struct CompiledGLSL {
+    std::string glsl;
+    bool needsPlaceholderSampler;
+    CombinedSamplerInfo combinedSamplerInfo;
+};
+
 class ShaderModule final : public ShaderModuleBase {
   public:
     static ResultOrError<Ref<ShaderModule>> Create(Device* device,
@@ -73,18 +83,25 @@ class ShaderModule final : public ShaderModuleBase {
                                                    ShaderModuleParseResult* parseResult,
                                                    OwnedCompilationMessages* compilationMessages);
 
+    // Returns the GLSL for one stage, either from the layout's memoization cache or by running
+    // the Tint transforms and generation. The result is owned by the layout.
+    ResultOrError<const CompiledGLSL*> GetCompiledGLSL(const ProgrammableStage& programmableStage,
+                                                       const PipelineLayout* layout) const;
+
     ResultOrError<GLuint> CompileShader(const OpenGLFunctions& gl,
-                                        const ProgrammableStage& programmableStage,
-                                        SingleShaderStage stage,
-                                        CombinedSamplerInfo* combinedSamplers,
-                                        const PipelineLayout* layout,
-                                        bool* needsPlaceholderSampler) const;
+                                        const CompiledGLSL& compiled,
+                                        SingleShaderStage stage) const;
 
   private:
     ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor);
     ~ShaderModule() override = default;
     MaybeError Initialize(ShaderModuleParseResult* parseResult,
-                          OwnedCompilationMessages* compilationMessages);
+                          OwnedCompilationMessages* compilationMessages) override;
+
+    // Runs the Tint transforms and GLSL generation for one stage and stores the result in the
+    // layout's cache, returning the cached entry.
+    ResultOrError<const CompiledGLSL*> GenerateGLSL(const ProgrammableStage& programmableStage,
+                                                    const PipelineLayout* layout) const;
 };
 
 }  // namespace opengl
@@ -0,0 +1,45 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_OPENGL_STAGINGBUFFERGL_H_
+#define SRC_DAWN_NATIVE_OPENGL_STAGINGBUFFERGL_H_
+
+#include "dawn/native/StagingBuffer.h"
+#include "dawn/native/opengl/opengl_platform.h"
+
+namespace dawn::native::opengl {
+
+class Device;
+
+// A persistently mapped GL buffer with immutable storage (GL_ARB_buffer_storage). The mapping
+// is coherent, so CPU writes are visible to GL commands without any flush, and it stays valid
+// while the GPU reads from the buffer, which is what lets DynamicUploader stream uploads
+// through a fenced ring instead of synchronizing in glMapBufferRange or glBufferSubData.
+class StagingBuffer final : public StagingBufferBase {
+  public:
+    StagingBuffer(size_t size, Device* device);
+    ~StagingBuffer() override;
+
+    GLuint GetBufferHandle() const;
+
+    MaybeError Initialize() override;
+
+  private:
+    Device* mDevice;
+    GLuint mBuffer = 0;
+};
+
+}  // namespace dawn::native::opengl
+
+#endif  // SRC_DAWN_NATIVE_OPENGL_STAGINGBUFFERGL_H_
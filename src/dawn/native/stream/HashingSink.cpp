@@ -0,0 +1,86 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/stream/HashingSink.h"
+
+#include "dawn/common/HashUtils.h"
+
+namespace dawn::native::stream {
+
+namespace {
+
+// The low 64 bits of the 128-bit FNV prime 2^88 + 2^8 + 0x3b; the remaining term is 2^88.
+constexpr uint64_t kFnvPrimeLow = 0x13b;
+
+// Multiplies the 128-bit value (*hi, *lo) by the 128-bit FNV prime, modulo 2^128, using only
+// 64-bit arithmetic. The prime's 2^88 term reduces to lo << 24 in the high word since the
+// overflowing bits drop out of the modulus.
+void MultiplyByFnvPrime(uint64_t* lo, uint64_t* hi) {
+    uint64_t a = *lo >> 32;
+    uint64_t b = *lo & 0xffffffff;
+    uint64_t lowProduct = b * kFnvPrimeLow;
+    uint64_t midProduct = a * kFnvPrimeLow + (lowProduct >> 32);
+    uint64_t newLo = (midProduct << 32) | (lowProduct & 0xffffffff);
+    *hi = *hi * kFnvPrimeLow + (midProduct >> 32) + (*lo << 24);
+    *lo = newLo;
+}
+
+}  // anonymous namespace
+
+void Fingerprint::Update(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        low ^= bytes[i];
+        MultiplyByFnvPrime(&low, &high);
+    }
+}
+
+bool Fingerprint::operator==(const Fingerprint& other) const {
+    return low == other.low && high == other.high;
+}
+
+size_t Fingerprint::HashFunc::operator()(const Fingerprint& fingerprint) const {
+    size_t hash = 0;
+    HashCombine(&hash, fingerprint.low, fingerprint.high);
+    return hash;
+}
+
+Fingerprint ComputeFingerprint(const void* data, size_t size) {
+    Fingerprint fingerprint;
+    fingerprint.Update(data, size);
+    return fingerprint;
+}
+
+void* HashingSink::GetSpace(size_t bytes) {
+    Flush();
+    if (mScratch.size() < bytes) {
+        mScratch.resize(bytes);
+    }
+    mPendingBytes = bytes;
+    return mScratch.data();
+}
+
+Fingerprint HashingSink::Finalize() {
+    Flush();
+    return mFingerprint;
+}
+
+void HashingSink::Flush() {
+    if (mPendingBytes > 0) {
+        mFingerprint.Update(mScratch.data(), mPendingBytes);
+        mPendingBytes = 0;
+    }
+}
+
+}  // namespace dawn::native::stream
@@ -0,0 +1,78 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_STREAM_HASHINGSINK_H_
+#define SRC_DAWN_NATIVE_STREAM_HASHINGSINK_H_
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "dawn/native/stream/Sink.h"
+
+namespace dawn::native::stream {
+
+// A 128-bit FNV-1a fingerprint of a byte stream. Fingerprints identify serialized cache keys in
+// memory without retaining the serialized bytes. They are not cryptographic; a collision returns
+// the wrong cached value, which is acceptable at 128 bits for cache identity.
+struct Fingerprint {
+    // Initialized with the FNV-1a offset basis so that a default-constructed value is the
+    // fingerprint of the empty stream.
+    uint64_t low = 0x62b821756295c58d;
+    uint64_t high = 0x6c62272e07bb0142;
+
+    // Folds `size` bytes at `data` into the fingerprint.
+    void Update(const void* data, size_t size);
+
+    bool operator==(const Fingerprint& other) const;
+
+    // Functor for unordered containers keyed by Fingerprint.
+    struct HashFunc {
+        size_t operator()(const Fingerprint& fingerprint) const;
+    };
+
+    // Friend definition of StreamIn which can be found by ADL, making a fingerprint usable as a
+    // fixed-size field of another key.
+    friend void StreamIn(Sink* s, const Fingerprint& fp) {
+        void* space = s->GetSpace(2 * sizeof(uint64_t));
+        memcpy(space, &fp.low, sizeof(uint64_t));
+        memcpy(static_cast<uint8_t*>(space) + sizeof(uint64_t), &fp.high, sizeof(uint64_t));
+    }
+};
+
+// Convenience for fingerprinting an already materialized byte buffer.
+Fingerprint ComputeFingerprint(const void* data, size_t size);
+
+// Implementation of stream::Sink which incrementally computes the fingerprint of the streamed
+// bytes instead of storing them. Bytes written to the space returned by GetSpace() are folded
+// into the hash on the next GetSpace() or Finalize() call.
+class HashingSink : public Sink {
+  public:
+    // Implementation of stream::Sink
+    void* GetSpace(size_t bytes) override;
+
+    // Folds any outstanding bytes and returns the fingerprint of everything streamed so far.
+    Fingerprint Finalize();
+
+  private:
+    void Flush();
+
+    std::vector<uint8_t> mScratch;
+    size_t mPendingBytes = 0;
+    Fingerprint mFingerprint;
+};
+
+}  // namespace dawn::native::stream
+
+#endif  // SRC_DAWN_NATIVE_STREAM_HASHINGSINK_H_
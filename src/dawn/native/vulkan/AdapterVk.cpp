@@ -159,6 +159,11 @@ MaybeError Adapter::InitializeSupportedFeaturesImpl() {
         mSupportedFeatures.EnableFeature(Feature::IndirectFirstInstance);
     }
 
+    if (mDeviceInfo.features.multiDrawIndirect == VK_TRUE &&
+        mDeviceInfo.HasExt(DeviceExt::DrawIndirectCount)) {
+        mSupportedFeatures.EnableFeature(Feature::MultiDrawIndirect);
+    }
+
     if (mDeviceInfo.HasExt(DeviceExt::ShaderIntegerDotProduct) &&
         mDeviceInfo.shaderIntegerDotProductProperties
                 .integerDotProduct4x8BitPackedSignedAccelerated == VK_TRUE &&
@@ -25,7 +25,7 @@ namespace dawn::native::vulkan {
 
 class VulkanInstance;
 
-class Adapter : public AdapterBase {
+class Adapter final : public AdapterBase {
   public:
     Adapter(InstanceBase* instance,
             VulkanInstance* vulkanInstance,
@@ -45,7 +45,7 @@ class Device;
 // when we create multiple instances to selectively discover ICDs (like only
 // SwiftShader/iGPU/dGPU/eGPU), and only one physical device on one instance remains in use. We
 // can delete the VkInstances that are not in use to avoid holding the discrete GPU active.
-class VulkanInstance : public RefCounted {
+class VulkanInstance final : public RefCounted {
   public:
     static ResultOrError<Ref<VulkanInstance>> Create(const InstanceBase* instance, ICD icd);
     ~VulkanInstance() override;
@@ -84,7 +84,7 @@ class VulkanInstance : public RefCounted {
     std::mutex mMessageListenerDevicesMutex;
 };
 
-class Backend : public BackendConnection {
+class Backend final : public BackendConnection {
   public:
     explicit Backend(InstanceBase* instance);
     ~Backend() override;
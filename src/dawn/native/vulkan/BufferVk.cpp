@@ -15,6 +15,7 @@
 #include "dawn/native/vulkan/BufferVk.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include <limits>
 #include <utility>
@@ -62,7 +63,42 @@ VkBufferUsageFlags VulkanBufferUsage(wgpu::BufferUsage usage) {
     return flags;
 }
 
-VkPipelineStageFlags VulkanPipelineStage(wgpu::BufferUsage usage) {
+// The usage-to-stage and usage-to-access conversions run per buffer per barrier, so they are
+// precomputed into lookup tables. The internal storage bits live at the top of the usage word,
+// which makes a single dense table impractical; instead the usage is split into two 6-bit
+// halves (MapRead through Vertex, then Uniform through QueryResolve with the two internal
+// storage bits folded in). Every per-bit contribution ORs in independently, so the OR of the
+// two half lookups equals the result of the original per-bit checks.
+constexpr uint32_t kBufferUsageIndexCount = 0x40;
+constexpr uint32_t kLowBufferUsageMask = 0x3F;
+
+constexpr uint32_t HighBufferUsageIndex(wgpu::BufferUsage usage) {
+    uint32_t index = (static_cast<uint32_t>(usage) >> 6) & 0xF;
+    if (usage & kInternalStorageBuffer) {
+        index |= 0x10;
+    }
+    if (usage & kReadOnlyStorageBuffer) {
+        index |= 0x20;
+    }
+    return index;
+}
+
+constexpr wgpu::BufferUsage LowBufferUsageFromIndex(uint32_t index) {
+    return static_cast<wgpu::BufferUsage>(index & kLowBufferUsageMask);
+}
+
+constexpr wgpu::BufferUsage HighBufferUsageFromIndex(uint32_t index) {
+    wgpu::BufferUsage usage = static_cast<wgpu::BufferUsage>((index & 0xF) << 6);
+    if (index & 0x10) {
+        usage = usage | kInternalStorageBuffer;
+    }
+    if (index & 0x20) {
+        usage = usage | kReadOnlyStorageBuffer;
+    }
+    return usage;
+}
+
+constexpr VkPipelineStageFlags ComputeVulkanPipelineStage(wgpu::BufferUsage usage) {
     VkPipelineStageFlags flags = 0;
 
     if (usage & kMappableBufferUsages) {
@@ -89,7 +125,7 @@ VkPipelineStageFlags VulkanPipelineStage(wgpu::BufferUsage usage) {
     return flags;
 }
 
-VkAccessFlags VulkanAccessFlags(wgpu::BufferUsage usage) {
+constexpr VkAccessFlags ComputeVulkanAccessFlags(wgpu::BufferUsage usage) {
     VkAccessFlags flags = 0;
 
     if (usage & wgpu::BufferUsage::MapRead) {
@@ -129,6 +165,39 @@ VkAccessFlags VulkanAccessFlags(wgpu::BufferUsage usage) {
     return flags;
 }
 
+constexpr std::array<VkPipelineStageFlags, kBufferUsageIndexCount> MakeVulkanPipelineStageTable(
+    wgpu::BufferUsage (*usageFromIndex)(uint32_t)) {
+    std::array<VkPipelineStageFlags, kBufferUsageIndexCount> table{};
+    for (uint32_t i = 0; i < kBufferUsageIndexCount; ++i) {
+        table[i] = ComputeVulkanPipelineStage(usageFromIndex(i));
+    }
+    return table;
+}
+
+constexpr std::array<VkAccessFlags, kBufferUsageIndexCount> MakeVulkanAccessFlagsTable(
+    wgpu::BufferUsage (*usageFromIndex)(uint32_t)) {
+    std::array<VkAccessFlags, kBufferUsageIndexCount> table{};
+    for (uint32_t i = 0; i < kBufferUsageIndexCount; ++i) {
+        table[i] = ComputeVulkanAccessFlags(usageFromIndex(i));
+    }
+    return table;
+}
+
+constexpr auto kLowPipelineStageTable = MakeVulkanPipelineStageTable(LowBufferUsageFromIndex);
+constexpr auto kHighPipelineStageTable = MakeVulkanPipelineStageTable(HighBufferUsageFromIndex);
+constexpr auto kLowAccessFlagsTable = MakeVulkanAccessFlagsTable(LowBufferUsageFromIndex);
+constexpr auto kHighAccessFlagsTable = MakeVulkanAccessFlagsTable(HighBufferUsageFromIndex);
+
+VkPipelineStageFlags VulkanPipelineStage(wgpu::BufferUsage usage) {
+    return kLowPipelineStageTable[static_cast<uint32_t>(usage) & kLowBufferUsageMask] |
+           kHighPipelineStageTable[HighBufferUsageIndex(usage)];
+}
+
+VkAccessFlags VulkanAccessFlags(wgpu::BufferUsage usage) {
+    return kLowAccessFlagsTable[static_cast<uint32_t>(usage) & kLowBufferUsageMask] |
+           kHighAccessFlagsTable[HighBufferUsageIndex(usage)];
+}
+
 }  // namespace
 
 // static
@@ -388,7 +457,14 @@ void Buffer::SetLabelImpl() {
 void Buffer::InitializeToZero(CommandRecordingContext* recordingContext) {
     ASSERT(NeedsInitialization());
 
-    ClearBuffer(recordingContext, 0u);
+    TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+    InitializeToZeroAfterTransition(recordingContext);
+}
+
+void Buffer::InitializeToZeroAfterTransition(CommandRecordingContext* recordingContext) {
+    ASSERT(NeedsInitialization());
+
+    ClearBufferAfterTransition(recordingContext, 0u, 0, 0);
     GetDevice()->IncrementLazyClearCountForTesting();
     SetIsDataInitialized();
 }
@@ -397,12 +473,18 @@ void Buffer::ClearBuffer(CommandRecordingContext* recordingContext,
                          uint32_t clearValue,
                          uint64_t offset,
                          uint64_t size) {
+    TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+    ClearBufferAfterTransition(recordingContext, clearValue, offset, size);
+}
+
+void Buffer::ClearBufferAfterTransition(CommandRecordingContext* recordingContext,
+                                        uint32_t clearValue,
+                                        uint64_t offset,
+                                        uint64_t size) {
     ASSERT(recordingContext != nullptr);
     size = size > 0 ? size : GetAllocatedSize();
     ASSERT(size > 0);
 
-    TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
-
     Device* device = ToBackend(GetDevice());
     // VK_WHOLE_SIZE doesn't work on old Windows Intel Vulkan drivers, so we don't use it.
     // Note: Allocated size must be a multiple of 4.
@@ -43,6 +43,10 @@ class Buffer final : public BufferBase {
 
     // All the Ensure methods return true if the buffer was initialized to zero.
     bool EnsureDataInitialized(CommandRecordingContext* recordingContext);
+    // Records the fill of a lazy zero-initialization assuming the transition to CopyDst was
+    // already recorded, so that the clears of a whole synchronization scope can be batched
+    // behind a single pipeline barrier. See TransitionAndClearForSyncScope.
+    void InitializeToZeroAfterTransition(CommandRecordingContext* recordingContext);
     bool EnsureDataInitializedAsDestination(CommandRecordingContext* recordingContext,
                                             uint64_t offset,
                                             uint64_t size);
@@ -62,6 +66,10 @@ class Buffer final : public BufferBase {
                      uint32_t clearValue,
                      uint64_t offset = 0,
                      uint64_t size = 0);
+    void ClearBufferAfterTransition(CommandRecordingContext* recordingContext,
+                                    uint32_t clearValue,
+                                    uint64_t offset,
+                                    uint64_t size);
 
     MaybeError MapAsyncImpl(wgpu::MapMode mode, size_t offset, size_t size) override;
     void UnmapImpl() override;
@@ -15,6 +15,7 @@
 #include "dawn/native/vulkan/CommandBufferVk.h"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "dawn/native/BindGroupTracker.h"
@@ -38,6 +39,7 @@
 #include "dawn/native/vulkan/TextureVk.h"
 #include "dawn/native/vulkan/UtilsVulkan.h"
 #include "dawn/native/vulkan/VulkanError.h"
+#include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native::vulkan {
 
@@ -154,17 +156,95 @@ class DescriptorSetTracker : public BindGroupTrackerBase<true, uint32_t> {
 
 // Records the necessary barriers for a synchronization scope using the resource usage
 // data pre-computed in the frontend. Also performs lazy initialization if required.
+// All the barriers of the scope are accumulated in the recording context's scratch arrays and
+// issued with a single vkCmdPipelineBarrier.
 void TransitionAndClearForSyncScope(Device* device,
                                     CommandRecordingContext* recordingContext,
                                     const SyncScopeResourceUsage& scope) {
-    std::vector<VkBufferMemoryBarrier> bufferBarriers;
-    std::vector<VkImageMemoryBarrier> imageBarriers;
+    std::vector<VkBufferMemoryBarrier>& bufferBarriers = recordingContext->scratchBufferBarriers;
+    std::vector<VkImageMemoryBarrier>& imageBarriers = recordingContext->scratchImageBarriers;
+    ASSERT(bufferBarriers.empty() && imageBarriers.empty());
     VkPipelineStageFlags srcStages = 0;
     VkPipelineStageFlags dstStages = 0;
 
+    // Batch the lazy zero-initializations of the scope: the transitions to CopyDst of every
+    // buffer that needs a clear are folded in a single barrier and the fills are recorded back
+    // to back, instead of paying for one vkCmdPipelineBarrier per cleared buffer.
+    bool hasBuffersToClear = false;
+    for (size_t i = 0; i < scope.buffers.size(); ++i) {
+        Buffer* buffer = ToBackend(scope.buffers[i]);
+        if (!buffer->NeedsInitialization()) {
+            continue;
+        }
+        hasBuffersToClear = true;
+
+        VkBufferMemoryBarrier bufferBarrier;
+        if (buffer->TransitionUsageAndGetResourceBarrier(wgpu::BufferUsage::CopyDst,
+                                                         &bufferBarrier, &srcStages, &dstStages)) {
+            bufferBarriers.push_back(bufferBarrier);
+        }
+    }
+    if (hasBuffersToClear) {
+        if (!bufferBarriers.empty()) {
+            device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0,
+                                          0, nullptr, bufferBarriers.size(), bufferBarriers.data(),
+                                          0, nullptr);
+            dawn::platform::AddMetric(dawn::platform::MetricCounter::BarriersEmitted,
+                                      bufferBarriers.size());
+            bufferBarriers.clear();
+            srcStages = 0;
+            dstStages = 0;
+        }
+        for (size_t i = 0; i < scope.buffers.size(); ++i) {
+            Buffer* buffer = ToBackend(scope.buffers[i]);
+            if (buffer->NeedsInitialization()) {
+                buffer->InitializeToZeroAfterTransition(recordingContext);
+            }
+        }
+    }
+
+    // Textures get the same treatment: gather every subresource range that needs lazy
+    // initialization, fold all the transitions to CopyDst into one barrier and record the
+    // clears as one contiguous block before the pass.
+    std::vector<std::pair<Texture*, SubresourceRange>> texturesToClear;
+    if (device->IsToggleEnabled(Toggle::LazyClearResourceOnFirstUse)) {
+        for (size_t i = 0; i < scope.textures.size(); ++i) {
+            Texture* texture = ToBackend(scope.textures[i]);
+
+            // Clear subresources that are not render attachments. Render attachments will be
+            // cleared in RecordBeginRenderPass by setting the loadop to clear when the texture
+            // subresource has not been initialized before the render pass.
+            scope.textureUsages[i].Iterate(
+                [&](const SubresourceRange& range, wgpu::TextureUsage usage) {
+                    if ((usage & ~wgpu::TextureUsage::RenderAttachment) &&
+                        !texture->IsSubresourceContentInitialized(range)) {
+                        texturesToClear.emplace_back(texture, range);
+                    }
+                });
+        }
+    }
+    if (!texturesToClear.empty()) {
+        for (auto& clear : texturesToClear) {
+            clear.first->TransitionForLazyClear(recordingContext, clear.second, &imageBarriers,
+                                                &srcStages, &dstStages);
+        }
+        if (!imageBarriers.empty()) {
+            device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0,
+                                          0, nullptr, 0, nullptr, imageBarriers.size(),
+                                          imageBarriers.data());
+            dawn::platform::AddMetric(dawn::platform::MetricCounter::BarriersEmitted,
+                                      imageBarriers.size());
+            imageBarriers.clear();
+            srcStages = 0;
+            dstStages = 0;
+        }
+        for (auto& clear : texturesToClear) {
+            clear.first->EnsureSubresourceContentInitialized(recordingContext, clear.second);
+        }
+    }
+
     for (size_t i = 0; i < scope.buffers.size(); ++i) {
         Buffer* buffer = ToBackend(scope.buffers[i]);
-        buffer->EnsureDataInitialized(recordingContext);
 
         VkBufferMemoryBarrier bufferBarrier;
         if (buffer->TransitionUsageAndGetResourceBarrier(scope.bufferUsages[i], &bufferBarrier,
@@ -175,16 +255,6 @@ void TransitionAndClearForSyncScope(Device* device,
 
     for (size_t i = 0; i < scope.textures.size(); ++i) {
         Texture* texture = ToBackend(scope.textures[i]);
-
-        // Clear subresources that are not render attachments. Render attachments will be
-        // cleared in RecordBeginRenderPass by setting the loadop to clear when the texture
-        // subresource has not been initialized before the render pass.
-        scope.textureUsages[i].Iterate(
-            [&](const SubresourceRange& range, wgpu::TextureUsage usage) {
-                if (usage & ~wgpu::TextureUsage::RenderAttachment) {
-                    texture->EnsureSubresourceContentInitialized(recordingContext, range);
-                }
-            });
         texture->TransitionUsageForPass(recordingContext, scope.textureUsages[i], &imageBarriers,
                                         &srcStages, &dstStages);
     }
@@ -193,7 +263,13 @@ void TransitionAndClearForSyncScope(Device* device,
         device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
                                       nullptr, bufferBarriers.size(), bufferBarriers.data(),
                                       imageBarriers.size(), imageBarriers.data());
+        dawn::platform::AddMetric(dawn::platform::MetricCounter::BarriersEmitted,
+                                  bufferBarriers.size() + imageBarriers.size());
     }
+
+    // Clear the scratch arrays for the next scope but keep their backing allocations alive.
+    bufferBarriers.clear();
+    imageBarriers.clear();
 }
 
 MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
@@ -367,7 +443,8 @@ void ResetUsedQuerySetsOnRenderPass(Device* device,
 
         // Reset the queries between firstTrueIt and nextFalseIt (which is at most
         // lastIt)
-        device->fn.CmdResetQueryPool(commands, ToBackend(querySet)->GetHandle(), queryIndex,
+        device->fn.CmdResetQueryPool(commands, ToBackend(querySet)->GetHandle(),
+                                     ToBackend(querySet)->GetQueryPoolOffset() + queryIndex,
                                      queryCount);
 
         // Set current iterator to next false
@@ -384,12 +461,14 @@ void RecordWriteTimestampCmd(CommandRecordingContext* recordingContext,
 
     // The queries must be reset between uses, and the reset command cannot be called in render
     // pass.
+    uint32_t poolQueryIndex = ToBackend(querySet)->GetQueryPoolOffset() + queryIndex;
     if (!isRenderPass) {
-        device->fn.CmdResetQueryPool(commands, ToBackend(querySet)->GetHandle(), queryIndex, 1);
+        device->fn.CmdResetQueryPool(commands, ToBackend(querySet)->GetHandle(), poolQueryIndex,
+                                     1);
     }
 
     device->fn.CmdWriteTimestamp(commands, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
-                                 ToBackend(querySet)->GetHandle(), queryIndex);
+                                 ToBackend(querySet)->GetHandle(), poolQueryIndex);
 }
 
 void RecordResolveQuerySetCmd(VkCommandBuffer commands,
@@ -423,7 +502,8 @@ void RecordResolveQuerySetCmd(VkCommandBuffer commands,
             destinationOffset + (resolveQueryIndex - firstQuery) * sizeof(uint64_t);
 
         // Resolve the queries between firstTrueIt and nextFalseIt (which is at most lastIt)
-        device->fn.CmdCopyQueryPoolResults(commands, querySet->GetHandle(), resolveQueryIndex,
+        device->fn.CmdCopyQueryPoolResults(commands, querySet->GetHandle(),
+                                           querySet->GetQueryPoolOffset() + resolveQueryIndex,
                                            resolveQueryCount, destination->GetHandle(),
                                            resolveDestinationOffset, sizeof(uint64_t),
                                            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
@@ -946,7 +1026,7 @@ MaybeError CommandBuffer::RecordComputePass(CommandRecordingContext* recordingCo
                 BindGroup* bindGroup = ToBackend(cmd->group.Get());
                 uint32_t* dynamicOffsets = nullptr;
                 if (cmd->dynamicOffsetCount > 0) {
-                    dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    dynamicOffsets = mCommands.NextTrailingData<uint32_t>(cmd->dynamicOffsetCount);
                 }
 
                 descriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
@@ -1123,6 +1203,49 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingCon
                 break;
             }
 
+            case Command::MultiDrawIndirect: {
+                MultiDrawIndirectCmd* draw = iter->NextCommand<MultiDrawIndirectCmd>();
+                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+
+                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                if (draw->drawCountBuffer != nullptr) {
+                    Buffer* countBuffer = ToBackend(draw->drawCountBuffer.Get());
+                    device->fn.CmdDrawIndirectCount(
+                        commands, buffer->GetHandle(),
+                        static_cast<VkDeviceSize>(draw->indirectOffset), countBuffer->GetHandle(),
+                        static_cast<VkDeviceSize>(draw->drawCountBufferOffset), draw->maxDrawCount,
+                        static_cast<uint32_t>(kDrawIndirectSize));
+                } else {
+                    device->fn.CmdDrawIndirect(commands, buffer->GetHandle(),
+                                               static_cast<VkDeviceSize>(draw->indirectOffset),
+                                               draw->maxDrawCount,
+                                               static_cast<uint32_t>(kDrawIndirectSize));
+                }
+                break;
+            }
+
+            case Command::MultiDrawIndexedIndirect: {
+                MultiDrawIndexedIndirectCmd* draw =
+                    iter->NextCommand<MultiDrawIndexedIndirectCmd>();
+                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+
+                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                if (draw->drawCountBuffer != nullptr) {
+                    Buffer* countBuffer = ToBackend(draw->drawCountBuffer.Get());
+                    device->fn.CmdDrawIndexedIndirectCount(
+                        commands, buffer->GetHandle(),
+                        static_cast<VkDeviceSize>(draw->indirectOffset), countBuffer->GetHandle(),
+                        static_cast<VkDeviceSize>(draw->drawCountBufferOffset), draw->maxDrawCount,
+                        static_cast<uint32_t>(kDrawIndexedIndirectSize));
+                } else {
+                    device->fn.CmdDrawIndexedIndirect(
+                        commands, buffer->GetHandle(),
+                        static_cast<VkDeviceSize>(draw->indirectOffset), draw->maxDrawCount,
+                        static_cast<uint32_t>(kDrawIndexedIndirectSize));
+                }
+                break;
+            }
+
             case Command::InsertDebugMarker: {
                 if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
                     InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
@@ -1178,7 +1301,7 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingCon
                 BindGroup* bindGroup = ToBackend(cmd->group.Get());
                 uint32_t* dynamicOffsets = nullptr;
                 if (cmd->dynamicOffsetCount > 0) {
-                    dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    dynamicOffsets = iter->NextTrailingData<uint32_t>(cmd->dynamicOffsetCount);
                 }
 
                 descriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
@@ -1307,16 +1430,18 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingCon
             case Command::BeginOcclusionQuery: {
                 BeginOcclusionQueryCmd* cmd = mCommands.NextCommand<BeginOcclusionQueryCmd>();
 
-                device->fn.CmdBeginQuery(commands, ToBackend(cmd->querySet.Get())->GetHandle(),
-                                         cmd->queryIndex, 0);
+                QuerySet* querySet = ToBackend(cmd->querySet.Get());
+                device->fn.CmdBeginQuery(commands, querySet->GetHandle(),
+                                         querySet->GetQueryPoolOffset() + cmd->queryIndex, 0);
                 break;
             }
 
             case Command::EndOcclusionQuery: {
                 EndOcclusionQueryCmd* cmd = mCommands.NextCommand<EndOcclusionQueryCmd>();
 
-                device->fn.CmdEndQuery(commands, ToBackend(cmd->querySet.Get())->GetHandle(),
-                                       cmd->queryIndex);
+                QuerySet* querySet = ToBackend(cmd->querySet.Get());
+                device->fn.CmdEndQuery(commands, querySet->GetHandle(),
+                                       querySet->GetQueryPoolOffset() + cmd->queryIndex);
                 break;
             }
 
@@ -30,6 +30,12 @@ struct CommandRecordingContext {
     VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
     std::vector<VkSemaphore> waitSemaphores = {};
 
+    // Scratch storage for the aggregated barriers of a synchronization scope. Kept here
+    // instead of on the stack so the backing allocations are reused between pass boundaries,
+    // which would otherwise each reallocate vectors for potentially hundreds of resources.
+    std::vector<VkBufferMemoryBarrier> scratchBufferBarriers;
+    std::vector<VkImageMemoryBarrier> scratchImageBarriers;
+
     // The internal buffers used in the workaround of texture-to-texture copies with compressed
     // formats.
     std::vector<Ref<Buffer>> tempBuffers;
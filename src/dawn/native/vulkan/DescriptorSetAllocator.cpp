@@ -20,6 +20,7 @@
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/native/vulkan/FencedDeleter.h"
 #include "dawn/native/vulkan/VulkanError.h"
+#include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native::vulkan {
 
@@ -36,7 +37,10 @@ Ref<DescriptorSetAllocator> DescriptorSetAllocator::Create(
 DescriptorSetAllocator::DescriptorSetAllocator(
     BindGroupLayout* layout,
     std::map<VkDescriptorType, uint32_t> descriptorCountPerType)
-    : ObjectBase(layout->GetDevice()), mLayout(layout) {
+    : ObjectBase(layout->GetDevice()),
+      mLayout(layout),
+      mUseTransientPools(
+          layout->GetDevice()->IsToggleEnabled(Toggle::VulkanUseTransientDescriptorPools)) {
     ASSERT(layout != nullptr);
 
     // Compute the total number of descriptors for this layout.
@@ -73,7 +77,8 @@ DescriptorSetAllocator::DescriptorSetAllocator(
 
 DescriptorSetAllocator::~DescriptorSetAllocator() {
     for (auto& pool : mDescriptorPools) {
-        ASSERT(pool.freeSetIndices.size() == mMaxSets);
+        ASSERT(mUseTransientPools ? pool.liveSetCount == 0
+                                  : pool.freeSetIndices.size() == mMaxSets);
         if (pool.vkPool != VK_NULL_HANDLE) {
             Device* device = ToBackend(GetDevice());
             device->GetFencedDeleter()->DeleteWhenUnused(pool.vkPool);
@@ -83,14 +88,40 @@ DescriptorSetAllocator::~DescriptorSetAllocator() {
 
 ResultOrError<DescriptorSetAllocation> DescriptorSetAllocator::Allocate() {
     if (mAvailableDescriptorPoolIndices.empty()) {
-        DAWN_TRY(AllocateDescriptorPool());
+        // Prefer recycling a fully drained pool over creating a new one. The reset is deferred
+        // to this point so that it can surface errors and so that pools drained by bursts of
+        // deallocations don't get reset until a set is actually needed again.
+        if (mUseTransientPools && !mResetNeededPoolIndices.empty()) {
+            const PoolIndex poolIndex = mResetNeededPoolIndices.back();
+            DAWN_TRY(ResetDescriptorPool(poolIndex));
+            mResetNeededPoolIndices.pop_back();
+            mAvailableDescriptorPoolIndices.push_back(poolIndex);
+        } else {
+            DAWN_TRY(AllocateDescriptorPool());
+        }
     }
 
     ASSERT(!mAvailableDescriptorPoolIndices.empty());
 
+    // Vulkan hands out whole sets rather than individual descriptors; count sets here.
+    dawn::platform::AddMetric(dawn::platform::MetricCounter::DescriptorsAllocated, 1);
+
     const PoolIndex poolIndex = mAvailableDescriptorPoolIndices.back();
     DescriptorPool* pool = &mDescriptorPools[poolIndex];
 
+    if (mUseTransientPools) {
+        ASSERT(pool->nextFreeSetIndex < mMaxSets);
+
+        SetIndex setIndex = pool->nextFreeSetIndex++;
+        pool->liveSetCount++;
+
+        if (pool->nextFreeSetIndex == mMaxSets) {
+            mAvailableDescriptorPoolIndices.pop_back();
+        }
+
+        return DescriptorSetAllocation{pool->sets[setIndex], poolIndex, setIndex};
+    }
+
     ASSERT(!pool->freeSetIndices.empty());
 
     SetIndex setIndex = pool->freeSetIndices.back();
@@ -127,6 +158,19 @@ void DescriptorSetAllocator::FinishDeallocation(ExecutionSerial completedSerial)
     for (const Deallocation& dealloc : mPendingDeallocations.IterateUpTo(completedSerial)) {
         ASSERT(dealloc.poolIndex < mDescriptorPools.size());
 
+        if (mUseTransientPools) {
+            // Transient pools are reclaimed wholesale: once every set in an exhausted pool has
+            // been deallocated, the pool becomes eligible for vkResetDescriptorPool. Pools that
+            // still have unallocated sets keep handing those out before being reset.
+            DescriptorPool* pool = &mDescriptorPools[dealloc.poolIndex];
+            ASSERT(pool->liveSetCount > 0);
+            pool->liveSetCount--;
+            if (pool->liveSetCount == 0 && pool->nextFreeSetIndex == mMaxSets) {
+                mResetNeededPoolIndices.emplace_back(dealloc.poolIndex);
+            }
+            continue;
+        }
+
         auto& freeSetIndices = mDescriptorPools[dealloc.poolIndex].freeSetIndices;
         if (freeSetIndices.empty()) {
             mAvailableDescriptorPoolIndices.emplace_back(dealloc.poolIndex);
@@ -172,11 +216,15 @@ MaybeError DescriptorSetAllocator::AllocateDescriptorPool() {
         DAWN_TRY(std::move(result));
     }
 
+    // Transient pools hand out sets linearly through |nextFreeSetIndex| and don't use the
+    // per-set free list.
     std::vector<SetIndex> freeSetIndices;
-    freeSetIndices.reserve(mMaxSets);
+    if (!mUseTransientPools) {
+        freeSetIndices.reserve(mMaxSets);
 
-    for (SetIndex i = 0; i < mMaxSets; ++i) {
-        freeSetIndices.push_back(i);
+        for (SetIndex i = 0; i < mMaxSets; ++i) {
+            freeSetIndices.push_back(i);
+        }
     }
 
     mAvailableDescriptorPoolIndices.push_back(mDescriptorPools.size());
@@ -186,4 +234,38 @@ MaybeError DescriptorSetAllocator::AllocateDescriptorPool() {
     return {};
 }
 
+MaybeError DescriptorSetAllocator::ResetDescriptorPool(PoolIndex poolIndex) {
+    ASSERT(mUseTransientPools);
+
+    DescriptorPool* pool = &mDescriptorPools[poolIndex];
+    ASSERT(pool->liveSetCount == 0);
+    ASSERT(pool->nextFreeSetIndex == mMaxSets);
+
+    Device* device = ToBackend(GetDevice());
+
+    // Resetting the pool invalidates every descriptor set previously allocated from it, so all
+    // of them are re-allocated in a single call below. This pair of calls replaces mMaxSets
+    // individual set recyclings.
+    DAWN_TRY(CheckVkSuccess(
+        device->fn.ResetDescriptorPool(device->GetVkDevice(), pool->vkPool, 0),
+        "ResetDescriptorPool"));
+
+    std::vector<VkDescriptorSetLayout> layouts(mMaxSets, mLayout->GetHandle());
+
+    VkDescriptorSetAllocateInfo allocateInfo;
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.pNext = nullptr;
+    allocateInfo.descriptorPool = pool->vkPool;
+    allocateInfo.descriptorSetCount = mMaxSets;
+    allocateInfo.pSetLayouts = AsVkArray(layouts.data());
+
+    DAWN_TRY(CheckVkSuccess(device->fn.AllocateDescriptorSets(device->GetVkDevice(), &allocateInfo,
+                                                              AsVkArray(pool->sets.data())),
+                            "AllocateDescriptorSets"));
+
+    pool->nextFreeSetIndex = 0;
+
+    return {};
+}
+
 }  // namespace dawn::native::vulkan
@@ -29,7 +29,7 @@ namespace dawn::native::vulkan {
 
 class BindGroupLayout;
 
-class DescriptorSetAllocator : public ObjectBase {
+class DescriptorSetAllocator final : public ObjectBase {
     using PoolIndex = uint32_t;
     using SetIndex = uint16_t;
 
@@ -48,19 +48,30 @@ class DescriptorSetAllocator : public ObjectBase {
     ~DescriptorSetAllocator() override;
 
     MaybeError AllocateDescriptorPool();
+    MaybeError ResetDescriptorPool(PoolIndex poolIndex);
 
     BindGroupLayout* mLayout;
 
     std::vector<VkDescriptorPoolSize> mPoolSizes;
     SetIndex mMaxSets;
 
+    // When true, descriptor sets are allocated linearly from each pool and the whole pool is
+    // reclaimed with one vkResetDescriptorPool call once every set in it has been deallocated,
+    // instead of recycling sets individually through |freeSetIndices|.
+    bool mUseTransientPools;
+
     struct DescriptorPool {
         VkDescriptorPool vkPool;
         std::vector<VkDescriptorSet> sets;
         std::vector<SetIndex> freeSetIndices;
+
+        // Only used when |mUseTransientPools| is true.
+        SetIndex nextFreeSetIndex = 0;
+        SetIndex liveSetCount = 0;
     };
 
     std::vector<PoolIndex> mAvailableDescriptorPoolIndices;
+    std::vector<PoolIndex> mResetNeededPoolIndices;
     std::vector<DescriptorPool> mDescriptorPools;
 
     struct Deallocation {
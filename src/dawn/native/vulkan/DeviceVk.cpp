@@ -33,6 +33,7 @@
 #include "dawn/native/vulkan/FencedDeleter.h"
 #include "dawn/native/vulkan/PipelineCacheVk.h"
 #include "dawn/native/vulkan/PipelineLayoutVk.h"
+#include "dawn/native/vulkan/QueryPoolAllocatorVk.h"
 #include "dawn/native/vulkan/QuerySetVk.h"
 #include "dawn/native/vulkan/QueueVk.h"
 #include "dawn/native/vulkan/RenderPassCache.h"
@@ -50,6 +51,9 @@ namespace dawn::native::vulkan {
 
 namespace {
 
+// Bounds how many recycled semaphores the device keeps for reuse.
+constexpr size_t kMaxUnusedSemaphores = 32;
+
 // Destroy the semaphore when out of scope.
 class ScopedSignalSemaphore : public NonMovable {
   public:
@@ -117,8 +121,30 @@ MaybeError Device::Initialize(const DeviceDescriptor* descriptor) {
         mDeleter = std::make_unique<FencedDeleter>(this);
     }
 
+    // When timeline semaphores are available, track command completion with a single timeline
+    // semaphore whose counter is the last completed ExecutionSerial, instead of one VkFence per
+    // submit.
+    if (mDeviceInfo.HasExt(DeviceExt::TimelineSemaphore) &&
+        mDeviceInfo.timelineSemaphoreFeatures.timelineSemaphore == VK_TRUE) {
+        VkSemaphoreTypeCreateInfo typeCreateInfo;
+        typeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeCreateInfo.pNext = nullptr;
+        typeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeCreateInfo.initialValue = uint64_t(GetCompletedCommandSerial());
+
+        VkSemaphoreCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        createInfo.pNext = &typeCreateInfo;
+        createInfo.flags = 0;
+
+        DAWN_TRY(CheckVkSuccess(
+            fn.CreateSemaphore(mVkDevice, &createInfo, nullptr, &*mCommandTimelineSemaphore),
+            "vkCreateSemaphore"));
+    }
+
     mRenderPassCache = std::make_unique<RenderPassCache>(this);
     mResourceMemoryAllocator = std::make_unique<ResourceMemoryAllocator>(this);
+    mQueryPoolAllocator = std::make_unique<QueryPoolAllocator>(this);
 
     mExternalMemoryService = std::make_unique<external_memory::Service>(this);
     mExternalSemaphoreService = std::make_unique<external_semaphore::Service>(this);
@@ -228,18 +254,49 @@ MaybeError Device::TickImpl() {
     }
 
     mResourceMemoryAllocator->Tick(completedSerial);
+    mQueryPoolAllocator->Tick(completedSerial);
     mDeleter->Tick(completedSerial);
     mDescriptorAllocatorsPendingDeallocation.ClearUpTo(completedSerial);
 
+    for (VkSemaphore semaphore : mWaitSemaphoresPendingRecycle.IterateUpTo(completedSerial)) {
+        if (mUnusedSemaphores.size() < kMaxUnusedSemaphores) {
+            mUnusedSemaphores.push_back(semaphore);
+        } else {
+            fn.DestroySemaphore(mVkDevice, semaphore, nullptr);
+        }
+    }
+    mWaitSemaphoresPendingRecycle.ClearUpTo(completedSerial);
+
     if (mRecordingContext.used) {
         DAWN_TRY(SubmitPendingCommands());
     }
 
     DAWN_TRY(CheckDebugLayerAndGenerateErrors());
 
+    if (HasMemoryBudgetCallback()) {
+        mResourceMemoryAllocator->CheckMemoryBudget();
+    }
+
     return {};
 }
 
+void Device::ReduceMemoryUsageImpl() {
+    // Releases heaps pooled for reuse by the suballocators but that hold no live allocation.
+    mResourceMemoryAllocator->DestroyPool();
+    mQueryPoolAllocator->DestroyPool();
+}
+
+void Device::AppendMemoryReportImpl(std::vector<AllocatorMemoryInfo>* report) const {
+    // Only the sub-allocation heaps are tracked; dedicated VkDeviceMemory allocations for
+    // large resources are not, see the notes on GetTotalReservedMemory.
+    AllocatorMemoryInfo info;
+    info.name = "device memory suballocation";
+    info.reservedMemory = mResourceMemoryAllocator->GetTotalReservedMemory();
+    info.usedMemory = mResourceMemoryAllocator->GetTotalUsedMemory();
+    info.peakUsedMemory = mResourceMemoryAllocator->GetPeakUsedMemory();
+    report->push_back(info);
+}
+
 VkInstance Device::GetVkInstance() const {
     return ToBackend(GetAdapter())->GetVulkanInstance()->GetVkInstance();
 }
@@ -275,6 +332,10 @@ ResourceMemoryAllocator* Device::GetResourceMemoryAllocator() const {
     return mResourceMemoryAllocator.get();
 }
 
+QueryPoolAllocator* Device::GetQueryPoolAllocator() const {
+    return mQueryPoolAllocator.get();
+}
+
 external_semaphore::Service* Device::GetExternalSemaphoreService() const {
     return mExternalSemaphoreService.get();
 }
@@ -289,7 +350,18 @@ CommandRecordingContext* Device::GetPendingRecordingContext() {
     return &mRecordingContext;
 }
 
+bool Device::DeferPendingSubmit() {
+    // Bound how many submits may be batched so that submit-heavy workloads that never tick
+    // still flush regularly and get their resources recycled.
+    static constexpr uint32_t kMaxDeferredQueueSubmits = 16;
+
+    mDeferredSubmitCount++;
+    return mDeferredSubmitCount < kMaxDeferredQueueSubmits;
+}
+
 MaybeError Device::SubmitPendingCommands() {
+    mDeferredSubmitCount = 0;
+
     if (!mRecordingContext.used) {
         return {};
     }
@@ -313,35 +385,75 @@ MaybeError Device::SubmitPendingCommands() {
     std::vector<VkPipelineStageFlags> dstStageMasks(mRecordingContext.waitSemaphores.size(),
                                                     VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
 
+    // At most the external signal semaphore and the serial timeline semaphore are signaled.
+    std::array<VkSemaphore, 2> signalSemaphores;
+    std::array<uint64_t, 2> signalValues;
+    uint32_t signalSemaphoreCount = 0;
+    if (scopedSignalSemaphore.Get() != VK_NULL_HANDLE) {
+        signalSemaphores[signalSemaphoreCount] = scopedSignalSemaphore.Get();
+        // The value is ignored for binary semaphores.
+        signalValues[signalSemaphoreCount] = 0;
+        signalSemaphoreCount++;
+    }
+
+    VkTimelineSemaphoreSubmitInfo timelineSubmitInfo;
+    std::vector<uint64_t> waitValues;
+    if (mCommandTimelineSemaphore != VK_NULL_HANDLE) {
+        signalSemaphores[signalSemaphoreCount] = mCommandTimelineSemaphore;
+        signalValues[signalSemaphoreCount] = uint64_t(GetPendingCommandSerial());
+        signalSemaphoreCount++;
+
+        // All the wait semaphores are binary so their values are ignored, but the value counts
+        // must match the ones in VkSubmitInfo when a VkTimelineSemaphoreSubmitInfo is chained.
+        waitValues.resize(mRecordingContext.waitSemaphores.size(), 0);
+
+        timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineSubmitInfo.pNext = nullptr;
+        timelineSubmitInfo.waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size());
+        timelineSubmitInfo.pWaitSemaphoreValues = waitValues.data();
+        timelineSubmitInfo.signalSemaphoreValueCount = signalSemaphoreCount;
+        timelineSubmitInfo.pSignalSemaphoreValues = signalValues.data();
+    }
+
     VkSubmitInfo submitInfo;
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.pNext = nullptr;
+    submitInfo.pNext =
+        (mCommandTimelineSemaphore != VK_NULL_HANDLE ? &timelineSubmitInfo : nullptr);
     submitInfo.waitSemaphoreCount = static_cast<uint32_t>(mRecordingContext.waitSemaphores.size());
     submitInfo.pWaitSemaphores = AsVkArray(mRecordingContext.waitSemaphores.data());
     submitInfo.pWaitDstStageMask = dstStageMasks.data();
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &mRecordingContext.commandBuffer;
-    submitInfo.signalSemaphoreCount = (scopedSignalSemaphore.Get() == VK_NULL_HANDLE ? 0 : 1);
-    submitInfo.pSignalSemaphores = AsVkArray(scopedSignalSemaphore.InitializeInto());
+    submitInfo.signalSemaphoreCount = signalSemaphoreCount;
+    submitInfo.pSignalSemaphores = AsVkArray(signalSemaphores.data());
 
+    // With a timeline semaphore, completion is tracked by its counter value and no per-submit
+    // fence is needed.
     VkFence fence = VK_NULL_HANDLE;
-    DAWN_TRY_ASSIGN(fence, GetUnusedFence());
+    if (mCommandTimelineSemaphore == VK_NULL_HANDLE) {
+        DAWN_TRY_ASSIGN(fence, GetUnusedFence());
+    }
     DAWN_TRY_WITH_CLEANUP(
         CheckVkSuccess(fn.QueueSubmit(mQueue, 1, &submitInfo, fence), "vkQueueSubmit"), {
             // If submitting to the queue fails, move the fence back into the unused fence
             // list, as if it were never acquired. Not doing so would leak the fence since
             // it would be neither in the unused list nor in the in-flight list.
-            mUnusedFences.push_back(fence);
+            if (fence != VK_NULL_HANDLE) {
+                mUnusedFences.push_back(fence);
+            }
         });
 
-    // Enqueue the semaphores before incrementing the serial, so that they can be deleted as
-    // soon as the current submission is finished.
+    // Enqueue the semaphores before incrementing the serial, so that they can be recycled as
+    // soon as the current submission is finished. Recycled handles are reused by later
+    // swapchain acquires and semaphore imports instead of being recreated every frame.
     for (VkSemaphore semaphore : mRecordingContext.waitSemaphores) {
-        mDeleter->DeleteWhenUnused(semaphore);
+        mWaitSemaphoresPendingRecycle.Enqueue(semaphore, GetPendingCommandSerial());
     }
     IncrementLastSubmittedCommandSerial();
     ExecutionSerial lastSubmittedSerial = GetLastSubmittedCommandSerial();
-    mFencesInFlight.emplace(fence, lastSubmittedSerial);
+    if (fence != VK_NULL_HANDLE) {
+        mFencesInFlight.emplace(fence, lastSubmittedSerial);
+    }
 
     CommandPoolAndBuffer submittedCommands = {mRecordingContext.commandPool,
                                               mRecordingContext.commandBuffer};
@@ -435,6 +547,19 @@ ResultOrError<VulkanDeviceKnobs> Device::CreateDevice(VkPhysicalDevice physicalD
         featuresChain.Add(&usedKnobs.zeroInitializeWorkgroupMemoryFeatures);
     }
 
+    if (mDeviceInfo.HasExt(DeviceExt::TimelineSemaphore) &&
+        mDeviceInfo.timelineSemaphoreFeatures.timelineSemaphore == VK_TRUE) {
+        ASSERT(usedKnobs.HasExt(DeviceExt::TimelineSemaphore));
+
+        usedKnobs.timelineSemaphoreFeatures.sType =
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+
+        // Used to map ExecutionSerials onto a single timeline semaphore instead of one fence
+        // per submit. See SubmitPendingCommands and CheckAndUpdateCompletedSerials.
+        usedKnobs.timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+        featuresChain.Add(&usedKnobs.timelineSemaphoreFeatures);
+    }
+
     if (mDeviceInfo.HasExt(DeviceExt::ShaderIntegerDotProduct)) {
         ASSERT(usedKnobs.HasExt(DeviceExt::ShaderIntegerDotProduct));
 
@@ -471,6 +596,13 @@ ResultOrError<VulkanDeviceKnobs> Device::CreateDevice(VkPhysicalDevice physicalD
         usedKnobs.features.pipelineStatisticsQuery = VK_TRUE;
     }
 
+    if (IsFeatureEnabled(Feature::MultiDrawIndirect)) {
+        const VulkanDeviceInfo& deviceInfo = ToBackend(GetAdapter())->GetDeviceInfo();
+        ASSERT(deviceInfo.features.multiDrawIndirect == VK_TRUE &&
+               deviceInfo.HasExt(DeviceExt::DrawIndirectCount));
+        usedKnobs.features.multiDrawIndirect = VK_TRUE;
+    }
+
     if (IsFeatureEnabled(Feature::DepthClipControl)) {
         const VulkanDeviceInfo& deviceInfo = ToBackend(GetAdapter())->GetDeviceInfo();
         ASSERT(deviceInfo.HasExt(DeviceExt::DepthClipEnable) &&
@@ -658,7 +790,39 @@ ResultOrError<VkFence> Device::GetUnusedFence() {
     return fence;
 }
 
+ResultOrError<VkSemaphore> Device::GetUnusedSemaphore() {
+    if (!mUnusedSemaphores.empty()) {
+        // Pooled semaphores are only recycled once the submission waiting on them completed,
+        // so they are unsignaled and ready for reuse.
+        VkSemaphore semaphore = mUnusedSemaphores.back();
+        mUnusedSemaphores.pop_back();
+        return semaphore;
+    }
+
+    VkSemaphoreCreateInfo createInfo;
+    createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    DAWN_TRY(CheckVkSuccess(fn.CreateSemaphore(mVkDevice, &createInfo, nullptr, &*semaphore),
+                            "vkCreateSemaphore"));
+
+    return semaphore;
+}
+
 ResultOrError<ExecutionSerial> Device::CheckAndUpdateCompletedSerials() {
+    if (mCommandTimelineSemaphore != VK_NULL_HANDLE) {
+        // A single query of the timeline semaphore's counter replaces polling every in-flight
+        // fence: the counter is the serial of the last submission the GPU has completed.
+        uint64_t completedValue = 0;
+        VkResult result = VkResult::WrapUnsafe(INJECT_ERROR_OR_RUN(
+            fn.GetSemaphoreCounterValue(mVkDevice, mCommandTimelineSemaphore, &completedValue),
+            VK_ERROR_DEVICE_LOST));
+        DAWN_TRY(CheckVkSuccess(::VkResult(result), "vkGetSemaphoreCounterValue"));
+        return ExecutionSerial(completedValue);
+    }
+
     ExecutionSerial fenceSerial(0);
     while (!mFencesInFlight.empty()) {
         VkFence fence = mFencesInFlight.front().first;
@@ -991,6 +1155,35 @@ MaybeError Device::WaitForIdleForDestruction() {
     // (so they are as good as waited on) or success.
     DAWN_UNUSED(waitIdleResult);
 
+    // Make sure every submitted serial is complete by explicitly waiting for the timeline
+    // semaphore to reach the last submitted value.
+    if (mCommandTimelineSemaphore != VK_NULL_HANDLE &&
+        GetLastSubmittedCommandSerial() > GetCompletedCommandSerial()) {
+        uint64_t waitValue = uint64_t(GetLastSubmittedCommandSerial());
+
+        VkSemaphoreWaitInfo waitInfo;
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.pNext = nullptr;
+        waitInfo.flags = 0;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &*mCommandTimelineSemaphore;
+        waitInfo.pValues = &waitValue;
+
+        VkResult result = VkResult::WrapUnsafe(VK_TIMEOUT);
+        do {
+            // See the comment in the fence loop below for why error injection is skipped when
+            // the device is already Disconnected.
+            if (GetState() == State::Disconnected) {
+                result = VkResult::WrapUnsafe(fn.WaitSemaphores(mVkDevice, &waitInfo, UINT64_MAX));
+                continue;
+            }
+            result = VkResult::WrapUnsafe(INJECT_ERROR_OR_RUN(
+                fn.WaitSemaphores(mVkDevice, &waitInfo, UINT64_MAX), VK_ERROR_DEVICE_LOST));
+        } while (result == VK_TIMEOUT);
+        // As with vkWaitForFences below, errors are either OOM or device loss, and in both
+        // cases the workload on the GPU is as good as waited on.
+    }
+
     // Make sure all fences are complete by explicitly waiting on them all
     while (!mFencesInFlight.empty()) {
         VkFence fence = mFencesInFlight.front().first;
@@ -1091,6 +1284,11 @@ void Device::DestroyImpl() {
     }
     mUnusedFences.clear();
 
+    if (mCommandTimelineSemaphore != VK_NULL_HANDLE) {
+        fn.DestroySemaphore(mVkDevice, mCommandTimelineSemaphore, nullptr);
+        mCommandTimelineSemaphore = VK_NULL_HANDLE;
+    }
+
     ExecutionSerial completedSerial = GetCompletedCommandSerial();
     for (Ref<DescriptorSetAllocator>& allocator :
          mDescriptorAllocatorsPendingDeallocation.IterateUpTo(completedSerial)) {
@@ -1103,9 +1301,26 @@ void Device::DestroyImpl() {
     mDeleter->Tick(completedSerial);
     mDescriptorAllocatorsPendingDeallocation.ClearUpTo(completedSerial);
 
+    // All GPU work has completed; destroy the wait semaphores pending recycling and the
+    // pooled unused semaphores while the VkDevice is still alive.
+    for (VkSemaphore semaphore : mWaitSemaphoresPendingRecycle.IterateAll()) {
+        fn.DestroySemaphore(mVkDevice, semaphore, nullptr);
+    }
+    mWaitSemaphoresPendingRecycle.Clear();
+    for (VkSemaphore semaphore : mUnusedSemaphores) {
+        fn.DestroySemaphore(mVkDevice, semaphore, nullptr);
+    }
+    mUnusedSemaphores.clear();
+
     // Allow recycled memory to be deleted.
     mResourceMemoryAllocator->DestroyPool();
 
+    // Every query set has been destroyed and the GPU is idle, so after retiring the pending
+    // deallocations all pooled query pools are unused and must be destroyed while the
+    // VkDevice is still alive.
+    mQueryPoolAllocator->Tick(kMaxExecutionSerial);
+    mQueryPoolAllocator->DestroyPool();
+
     // The VkRenderPasses in the cache can be destroyed immediately since all commands referring
     // to them are guaranteed to be finished executing.
     mRenderPassCache = nullptr;
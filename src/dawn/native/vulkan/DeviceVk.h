@@ -38,6 +38,7 @@ namespace dawn::native::vulkan {
 
 class BufferUploader;
 class FencedDeleter;
+class QueryPoolAllocator;
 class RenderPassCache;
 class ResourceMemoryAllocator;
 
@@ -61,11 +62,25 @@ class Device final : public DeviceBase {
     FencedDeleter* GetFencedDeleter() const;
     RenderPassCache* GetRenderPassCache() const;
     ResourceMemoryAllocator* GetResourceMemoryAllocator() const;
+    QueryPoolAllocator* GetQueryPoolAllocator() const;
     external_semaphore::Service* GetExternalSemaphoreService() const;
 
     CommandRecordingContext* GetPendingRecordingContext();
     MaybeError SubmitPendingCommands();
 
+    // Returns a pooled unsignaled binary semaphore, or creates one if the pool is empty.
+    // Used for swapchain acquires and external semaphore imports so steady-state frames don't
+    // create and destroy a semaphore each, which is a kernel round trip on some platforms.
+    // Wait semaphores handed to a submission are returned to the pool once it completes.
+    ResultOrError<VkSemaphore> GetUnusedSemaphore();
+
+    // Only used with the VulkanBatchQueueSubmits toggle. Returns true if the commands recorded
+    // by the current Queue::Submit should stay in the pending recording context so they get
+    // coalesced into a later vkQueueSubmit, or false once enough submits have accumulated that
+    // the batch should be flushed. SubmitPendingCommands is the explicit flush and resets the
+    // heuristic.
+    bool DeferPendingSubmit();
+
     void EnqueueDeferredDeallocation(DescriptorSetAllocator* allocator);
 
     // Dawn Native API
@@ -84,6 +99,8 @@ class Device final : public DeviceBase {
         const CommandBufferDescriptor* descriptor) override;
 
     MaybeError TickImpl() override;
+    void ReduceMemoryUsageImpl() override;
+    void AppendMemoryReportImpl(std::vector<AllocatorMemoryInfo>* report) const override;
 
     ResultOrError<std::unique_ptr<StagingBufferBase>> CreateStagingBuffer(size_t size) override;
     MaybeError CopyFromStagingToBuffer(StagingBufferBase* source,
@@ -180,11 +197,17 @@ class Device final : public DeviceBase {
         mDescriptorAllocatorsPendingDeallocation;
     std::unique_ptr<FencedDeleter> mDeleter;
     std::unique_ptr<ResourceMemoryAllocator> mResourceMemoryAllocator;
+    std::unique_ptr<QueryPoolAllocator> mQueryPoolAllocator;
     std::unique_ptr<RenderPassCache> mRenderPassCache;
 
     std::unique_ptr<external_memory::Service> mExternalMemoryService;
     std::unique_ptr<external_semaphore::Service> mExternalSemaphoreService;
 
+    // Wait semaphores from completed submissions, returned to |mUnusedSemaphores| instead of
+    // being destroyed, since swapchains and interop consume one per frame and per surface.
+    SerialQueue<ExecutionSerial, VkSemaphore> mWaitSemaphoresPendingRecycle;
+    std::vector<VkSemaphore> mUnusedSemaphores;
+
     ResultOrError<VkFence> GetUnusedFence();
     ResultOrError<ExecutionSerial> CheckAndUpdateCompletedSerials() override;
 
@@ -196,6 +219,11 @@ class Device final : public DeviceBase {
     // Fences in the unused list aren't reset yet.
     std::vector<VkFence> mUnusedFences;
 
+    // When VK_KHR_timeline_semaphore is available, completed serials are tracked with this
+    // single timeline semaphore instead of per-submit fences: every submit signals it to the
+    // submit's ExecutionSerial. Stays VK_NULL_HANDLE when the fence path is used.
+    VkSemaphore mCommandTimelineSemaphore = VK_NULL_HANDLE;
+
     // For capturing messages generated by the Vulkan debug layer.
     const std::string mDebugPrefix;
     std::vector<std::string> mDebugMessages;
@@ -212,6 +240,9 @@ class Device final : public DeviceBase {
     std::vector<CommandPoolAndBuffer> mUnusedCommands;
     // There is always a valid recording context stored in mRecordingContext
     CommandRecordingContext mRecordingContext;
+    // Number of Queue::Submit calls whose commands are batched in mRecordingContext, waiting
+    // for a coalesced vkQueueSubmit. Only non-zero with the VulkanBatchQueueSubmits toggle.
+    uint32_t mDeferredSubmitCount = 0;
 
     MaybeError ImportExternalImage(const ExternalImageDescriptorVk* descriptor,
                                    ExternalMemoryHandle memoryHandle,
@@ -14,10 +14,21 @@
 
 #include "dawn/native/vulkan/FencedDeleter.h"
 
+#include <limits>
+
 #include "dawn/native/vulkan/DeviceVk.h"
 
 namespace dawn::native::vulkan {
 
+namespace {
+
+// Cap on the number of handles destroyed by a single budgeted Tick. Releasing tens of
+// thousands of objects at once would otherwise stall the frame that sees their serial
+// complete; handles over the budget carry over to subsequent ticks instead.
+constexpr uint64_t kMaxDeletionsPerTick = 2048;
+
+}  // anonymous namespace
+
 FencedDeleter::FencedDeleter(Device* device) : mDevice(device) {}
 
 FencedDeleter::~FencedDeleter() {
@@ -36,6 +47,7 @@ FencedDeleter::~FencedDeleter() {
     ASSERT(mShaderModulesToDelete.Empty());
     ASSERT(mSurfacesToDelete.Empty());
     ASSERT(mSwapChainsToDelete.Empty());
+    ASSERT(!HasPendingDeletions());
 }
 
 void FencedDeleter::DeleteWhenUnused(VkBuffer buffer) {
@@ -102,81 +114,134 @@ void FencedDeleter::Tick(ExecutionSerial completedSerial) {
     VkDevice vkDevice = mDevice->GetVkDevice();
     VkInstance instance = mDevice->GetVkInstance();
 
+    // First move every handle whose serial completed out of its serial queue. This is only
+    // pointer shuffling; the driver calls below are what the budget meters.
+    auto StageReady = [&](auto* queue, auto* readyList) {
+        for (auto handle : queue->IterateUpTo(completedSerial)) {
+            readyList->push_back(handle);
+        }
+        queue->ClearUpTo(completedSerial);
+    };
+    StageReady(&mBuffersToDelete, &mReadyBuffers);
+    StageReady(&mImagesToDelete, &mReadyImages);
+    StageReady(&mMemoriesToDelete, &mReadyMemories);
+    StageReady(&mPipelineLayoutsToDelete, &mReadyPipelineLayouts);
+    StageReady(&mRenderPassesToDelete, &mReadyRenderPasses);
+    StageReady(&mFramebuffersToDelete, &mReadyFramebuffers);
+    StageReady(&mImageViewsToDelete, &mReadyImageViews);
+    StageReady(&mShaderModulesToDelete, &mReadyShaderModules);
+    StageReady(&mPipelinesToDelete, &mReadyPipelines);
+    StageReady(&mSwapChainsToDelete, &mReadySwapChains);
+    StageReady(&mSurfacesToDelete, &mReadySurfaces);
+    StageReady(&mSemaphoresToDelete, &mReadySemaphores);
+    StageReady(&mDescriptorPoolsToDelete, &mReadyDescriptorPools);
+    StageReady(&mQueryPoolsToDelete, &mReadyQueryPools);
+    StageReady(&mSamplersToDelete, &mReadySamplers);
+
+    // The final tick at device destruction must leave nothing behind.
+    uint64_t budget = completedSerial == kMaxExecutionSerial ? std::numeric_limits<uint64_t>::max()
+                                                             : kMaxDeletionsPerTick;
+
+    // Returns false once the budget runs out before the list is drained. The categories
+    // below are walked strictly in order and the walk stops at the first undrained list so
+    // that a category never overtakes one it depends on.
+    auto DestroyReady = [&](auto* readyList, auto destroy) {
+        while (!readyList->empty()) {
+            if (budget == 0) {
+                return false;
+            }
+            destroy(readyList->back());
+            readyList->pop_back();
+            budget--;
+        }
+        return true;
+    };
+
     // Buffers and images must be deleted before memories because it is invalid to free memory
     // that still have resources bound to it.
-    for (VkBuffer buffer : mBuffersToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroyBuffer(vkDevice, buffer, nullptr);
+    if (!DestroyReady(&mReadyBuffers, [&](VkBuffer buffer) {
+            mDevice->fn.DestroyBuffer(vkDevice, buffer, nullptr);
+        })) {
+        return;
     }
-    mBuffersToDelete.ClearUpTo(completedSerial);
-    for (VkImage image : mImagesToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroyImage(vkDevice, image, nullptr);
+    if (!DestroyReady(&mReadyImages,
+                      [&](VkImage image) { mDevice->fn.DestroyImage(vkDevice, image, nullptr); })) {
+        return;
     }
-    mImagesToDelete.ClearUpTo(completedSerial);
-
-    for (VkDeviceMemory memory : mMemoriesToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.FreeMemory(vkDevice, memory, nullptr);
+    if (!DestroyReady(&mReadyMemories, [&](VkDeviceMemory memory) {
+            mDevice->fn.FreeMemory(vkDevice, memory, nullptr);
+        })) {
+        return;
     }
-    mMemoriesToDelete.ClearUpTo(completedSerial);
-
-    for (VkPipelineLayout layout : mPipelineLayoutsToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroyPipelineLayout(vkDevice, layout, nullptr);
+    if (!DestroyReady(&mReadyPipelineLayouts, [&](VkPipelineLayout layout) {
+            mDevice->fn.DestroyPipelineLayout(vkDevice, layout, nullptr);
+        })) {
+        return;
     }
-    mPipelineLayoutsToDelete.ClearUpTo(completedSerial);
-
-    for (VkRenderPass renderPass : mRenderPassesToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroyRenderPass(vkDevice, renderPass, nullptr);
+    if (!DestroyReady(&mReadyRenderPasses, [&](VkRenderPass renderPass) {
+            mDevice->fn.DestroyRenderPass(vkDevice, renderPass, nullptr);
+        })) {
+        return;
     }
-    mRenderPassesToDelete.ClearUpTo(completedSerial);
-
-    for (VkFramebuffer framebuffer : mFramebuffersToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroyFramebuffer(vkDevice, framebuffer, nullptr);
+    if (!DestroyReady(&mReadyFramebuffers, [&](VkFramebuffer framebuffer) {
+            mDevice->fn.DestroyFramebuffer(vkDevice, framebuffer, nullptr);
+        })) {
+        return;
     }
-    mFramebuffersToDelete.ClearUpTo(completedSerial);
-
-    for (VkImageView view : mImageViewsToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroyImageView(vkDevice, view, nullptr);
+    if (!DestroyReady(&mReadyImageViews, [&](VkImageView view) {
+            mDevice->fn.DestroyImageView(vkDevice, view, nullptr);
+        })) {
+        return;
     }
-    mImageViewsToDelete.ClearUpTo(completedSerial);
-
-    for (VkShaderModule module : mShaderModulesToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroyShaderModule(vkDevice, module, nullptr);
+    if (!DestroyReady(&mReadyShaderModules, [&](VkShaderModule module) {
+            mDevice->fn.DestroyShaderModule(vkDevice, module, nullptr);
+        })) {
+        return;
     }
-    mShaderModulesToDelete.ClearUpTo(completedSerial);
-
-    for (VkPipeline pipeline : mPipelinesToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroyPipeline(vkDevice, pipeline, nullptr);
+    if (!DestroyReady(&mReadyPipelines, [&](VkPipeline pipeline) {
+            mDevice->fn.DestroyPipeline(vkDevice, pipeline, nullptr);
+        })) {
+        return;
     }
-    mPipelinesToDelete.ClearUpTo(completedSerial);
 
     // Vulkan swapchains must be destroyed before their corresponding VkSurface
-    for (VkSwapchainKHR swapChain : mSwapChainsToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroySwapchainKHR(vkDevice, swapChain, nullptr);
+    if (!DestroyReady(&mReadySwapChains, [&](VkSwapchainKHR swapChain) {
+            mDevice->fn.DestroySwapchainKHR(vkDevice, swapChain, nullptr);
+        })) {
+        return;
     }
-    mSwapChainsToDelete.ClearUpTo(completedSerial);
-    for (VkSurfaceKHR surface : mSurfacesToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroySurfaceKHR(instance, surface, nullptr);
+    if (!DestroyReady(&mReadySurfaces, [&](VkSurfaceKHR surface) {
+            mDevice->fn.DestroySurfaceKHR(instance, surface, nullptr);
+        })) {
+        return;
     }
-    mSurfacesToDelete.ClearUpTo(completedSerial);
 
-    for (VkSemaphore semaphore : mSemaphoresToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroySemaphore(vkDevice, semaphore, nullptr);
+    if (!DestroyReady(&mReadySemaphores, [&](VkSemaphore semaphore) {
+            mDevice->fn.DestroySemaphore(vkDevice, semaphore, nullptr);
+        })) {
+        return;
     }
-    mSemaphoresToDelete.ClearUpTo(completedSerial);
-
-    for (VkDescriptorPool pool : mDescriptorPoolsToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroyDescriptorPool(vkDevice, pool, nullptr);
+    if (!DestroyReady(&mReadyDescriptorPools, [&](VkDescriptorPool pool) {
+            mDevice->fn.DestroyDescriptorPool(vkDevice, pool, nullptr);
+        })) {
+        return;
     }
-    mDescriptorPoolsToDelete.ClearUpTo(completedSerial);
-
-    for (VkQueryPool pool : mQueryPoolsToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroyQueryPool(vkDevice, pool, nullptr);
+    if (!DestroyReady(&mReadyQueryPools, [&](VkQueryPool pool) {
+            mDevice->fn.DestroyQueryPool(vkDevice, pool, nullptr);
+        })) {
+        return;
     }
-    mQueryPoolsToDelete.ClearUpTo(completedSerial);
+    DestroyReady(&mReadySamplers,
+                 [&](VkSampler sampler) { mDevice->fn.DestroySampler(vkDevice, sampler, nullptr); });
+}
 
-    for (VkSampler sampler : mSamplersToDelete.IterateUpTo(completedSerial)) {
-        mDevice->fn.DestroySampler(vkDevice, sampler, nullptr);
-    }
-    mSamplersToDelete.ClearUpTo(completedSerial);
+bool FencedDeleter::HasPendingDeletions() const {
+    return !mReadyBuffers.empty() || !mReadyImages.empty() || !mReadyMemories.empty() ||
+           !mReadyPipelineLayouts.empty() || !mReadyRenderPasses.empty() ||
+           !mReadyFramebuffers.empty() || !mReadyImageViews.empty() ||
+           !mReadyShaderModules.empty() || !mReadyPipelines.empty() ||
+           !mReadySwapChains.empty() || !mReadySurfaces.empty() || !mReadySemaphores.empty() ||
+           !mReadyDescriptorPools.empty() || !mReadyQueryPools.empty() || !mReadySamplers.empty();
 }
 
 }  // namespace dawn::native::vulkan
@@ -15,6 +15,8 @@
 #ifndef SRC_DAWN_NATIVE_VULKAN_FENCEDDELETER_H_
 #define SRC_DAWN_NATIVE_VULKAN_FENCEDDELETER_H_
 
+#include <vector>
+
 #include "dawn/common/SerialQueue.h"
 #include "dawn/common/vulkan_platform.h"
 #include "dawn/native/IntegerTypes.h"
@@ -44,8 +46,14 @@ class FencedDeleter {
     void DeleteWhenUnused(VkSurfaceKHR surface);
     void DeleteWhenUnused(VkSwapchainKHR swapChain);
 
+    // Destroys handles whose serial has completed. Destruction is budgeted: at most
+    // kMaxDeletionsPerTick handles are destroyed per call and the rest carry over to later
+    // ticks, except when ticking with kMaxExecutionSerial which drains everything.
     void Tick(ExecutionSerial completedSerial);
 
+    // Whether budgeted ticks still have handles left to destroy.
+    bool HasPendingDeletions() const;
+
   private:
     Device* mDevice = nullptr;
     SerialQueue<ExecutionSerial, VkBuffer> mBuffersToDelete;
@@ -63,6 +71,24 @@ class FencedDeleter {
     SerialQueue<ExecutionSerial, VkShaderModule> mShaderModulesToDelete;
     SerialQueue<ExecutionSerial, VkSurfaceKHR> mSurfacesToDelete;
     SerialQueue<ExecutionSerial, VkSwapchainKHR> mSwapChainsToDelete;
+
+    // Handles whose serial completed but whose destruction didn't fit in a previous tick's
+    // budget.
+    std::vector<VkBuffer> mReadyBuffers;
+    std::vector<VkDescriptorPool> mReadyDescriptorPools;
+    std::vector<VkDeviceMemory> mReadyMemories;
+    std::vector<VkFramebuffer> mReadyFramebuffers;
+    std::vector<VkImage> mReadyImages;
+    std::vector<VkImageView> mReadyImageViews;
+    std::vector<VkPipeline> mReadyPipelines;
+    std::vector<VkPipelineLayout> mReadyPipelineLayouts;
+    std::vector<VkQueryPool> mReadyQueryPools;
+    std::vector<VkRenderPass> mReadyRenderPasses;
+    std::vector<VkSampler> mReadySamplers;
+    std::vector<VkSemaphore> mReadySemaphores;
+    std::vector<VkShaderModule> mReadyShaderModules;
+    std::vector<VkSurfaceKHR> mReadySurfaces;
+    std::vector<VkSwapchainKHR> mReadySwapChains;
 };
 
 }  // namespace dawn::native::vulkan
@@ -163,18 +163,11 @@ DawnSwapChainError NativeSwapChainImpl::Configure(WGPUTextureFormat format,
 }
 
 DawnSwapChainError NativeSwapChainImpl::GetNextTexture(DawnSwapChainNextTexture* nextTexture) {
-    // Transiently create a semaphore that will be signaled when the presentation engine is done
-    // with the swapchain image. Further operations on the image will wait for this semaphore.
+    // Take a semaphore that will be signaled when the presentation engine is done with the
+    // swapchain image. Further operations on the image will wait for this semaphore.
     VkSemaphore semaphore = VK_NULL_HANDLE;
-    {
-        VkSemaphoreCreateInfo createInfo;
-        createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-        createInfo.pNext = nullptr;
-        createInfo.flags = 0;
-        if (mDevice->fn.CreateSemaphore(mDevice->GetVkDevice(), &createInfo, nullptr,
-                                        &*semaphore) != VK_SUCCESS) {
-            ASSERT(false);
-        }
+    if (mDevice->ConsumedError(mDevice->GetUnusedSemaphore(), &semaphore)) {
+        ASSERT(false);
     }
 
     if (mDevice->fn.AcquireNextImageKHR(mDevice->GetVkDevice(), mSwapChain,
@@ -0,0 +1,226 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/vulkan/QueryPoolAllocatorVk.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+#include "dawn/native/BuddyAllocator.h"
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/native/vulkan/UtilsVulkan.h"
+#include "dawn/native/vulkan/VulkanError.h"
+
+namespace dawn::native::vulkan {
+
+namespace {
+
+VkQueryType VulkanQueryType(wgpu::QueryType type) {
+    switch (type) {
+        case wgpu::QueryType::Occlusion:
+            return VK_QUERY_TYPE_OCCLUSION;
+        case wgpu::QueryType::PipelineStatistics:
+            return VK_QUERY_TYPE_PIPELINE_STATISTICS;
+        case wgpu::QueryType::Timestamp:
+            return VK_QUERY_TYPE_TIMESTAMP;
+    }
+    UNREACHABLE();
+}
+
+VkQueryPipelineStatisticFlags VulkanQueryPipelineStatisticFlags(
+    const std::vector<wgpu::PipelineStatisticName>& pipelineStatisticsSet) {
+    VkQueryPipelineStatisticFlags pipelineStatistics = 0;
+    for (size_t i = 0; i < pipelineStatisticsSet.size(); ++i) {
+        switch (pipelineStatisticsSet[i]) {
+            case wgpu::PipelineStatisticName::ClipperInvocations:
+                pipelineStatistics |= VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT;
+                break;
+            case wgpu::PipelineStatisticName::ClipperPrimitivesOut:
+                pipelineStatistics |= VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT;
+                break;
+            case wgpu::PipelineStatisticName::ComputeShaderInvocations:
+                pipelineStatistics |= VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+                break;
+            case wgpu::PipelineStatisticName::FragmentShaderInvocations:
+                pipelineStatistics |= VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+                break;
+            case wgpu::PipelineStatisticName::VertexShaderInvocations:
+                pipelineStatistics |= VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT;
+                break;
+        }
+    }
+
+    return pipelineStatistics;
+}
+
+// Large enough that a frame's worth of profiler query sets fits in one shared pool, small
+// enough that an idle pool doesn't hold a meaningful amount of memory.
+constexpr uint32_t kSharedQueryPoolSize = 4096;
+// Occlusion query sets up to this size are sub-allocated; larger ones would fragment the
+// shared pool and get a dedicated pool instead.
+constexpr uint32_t kMaxSuballocatedQueryCount = 256;
+// How many free dedicated pools are kept for reuse before deallocations destroy pools
+// outright.
+constexpr size_t kMaxFreeDedicatedPools = 8;
+
+}  // anonymous namespace
+
+struct SharedQueryPool {
+    explicit SharedQueryPool(VkQueryPool pool)
+        : pool(pool), allocator(kSharedQueryPoolSize) {}
+
+    VkQueryPool pool;
+    BuddyAllocator allocator;
+    // Counts live slices and slices pending deallocation; the pool may only be destroyed when
+    // it reaches zero.
+    uint32_t allocationCount = 0;
+};
+
+QueryPoolAllocator::QueryPoolAllocator(Device* device) : mDevice(device) {}
+
+QueryPoolAllocator::~QueryPoolAllocator() {
+    // The device drains the allocator and calls DestroyPool before the VkDevice goes away.
+    ASSERT(mSharedPools.empty());
+    ASSERT(mFreeDedicatedPools.empty());
+    ASSERT(mPendingDeallocations.Empty());
+}
+
+ResultOrError<VkQueryPool> QueryPoolAllocator::CreateQueryPool(
+    VkQueryType queryType,
+    uint32_t queryCount,
+    VkQueryPipelineStatisticFlags pipelineStatistics) {
+    VkQueryPoolCreateInfo createInfo;
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.pNext = NULL;
+    createInfo.flags = 0;
+    createInfo.queryType = queryType;
+    createInfo.queryCount = queryCount;
+    createInfo.pipelineStatistics = pipelineStatistics;
+
+    VkQueryPool pool = VK_NULL_HANDLE;
+    DAWN_TRY(CheckVkOOMThenSuccess(
+        mDevice->fn.CreateQueryPool(mDevice->GetVkDevice(), &createInfo, nullptr, &*pool),
+        "vkCreateQueryPool"));
+    return pool;
+}
+
+ResultOrError<QueryPoolAllocation> QueryPoolAllocator::Allocate(
+    wgpu::QueryType type,
+    uint32_t queryCount,
+    const std::vector<wgpu::PipelineStatisticName>& pipelineStatistics) {
+    QueryPoolAllocation allocation;
+    allocation.queryCount = std::max(queryCount, uint32_t(1u));
+    allocation.queryType = VulkanQueryType(type);
+    if (type == wgpu::QueryType::PipelineStatistics) {
+        allocation.pipelineStatistics = VulkanQueryPipelineStatisticFlags(pipelineStatistics);
+    }
+
+    // Small occlusion query sets are sub-allocated from shared pools. The buddy allocator
+    // works in power-of-two blocks, so the count is rounded up to one.
+    if (type == wgpu::QueryType::Occlusion &&
+        allocation.queryCount <= kMaxSuballocatedQueryCount) {
+        uint64_t blockSize = NextPowerOfTwo(allocation.queryCount);
+        SharedQueryPool* sharedPool = nullptr;
+        uint64_t offset = BuddyAllocator::kInvalidOffset;
+        for (std::unique_ptr<SharedQueryPool>& candidate : mSharedPools) {
+            offset = candidate->allocator.Allocate(blockSize);
+            if (offset != BuddyAllocator::kInvalidOffset) {
+                sharedPool = candidate.get();
+                break;
+            }
+        }
+
+        if (sharedPool == nullptr) {
+            VkQueryPool pool;
+            DAWN_TRY_ASSIGN(pool,
+                            CreateQueryPool(VK_QUERY_TYPE_OCCLUSION, kSharedQueryPoolSize, 0));
+            SetDebugName(mDevice, pool, "Dawn_SharedQueryPool");
+            mSharedPools.push_back(std::make_unique<SharedQueryPool>(pool));
+            sharedPool = mSharedPools.back().get();
+            offset = sharedPool->allocator.Allocate(blockSize);
+            ASSERT(offset != BuddyAllocator::kInvalidOffset);
+        }
+
+        sharedPool->allocationCount++;
+        allocation.pool = sharedPool->pool;
+        allocation.baseQueryIndex = static_cast<uint32_t>(offset);
+        allocation.sharedPool = sharedPool;
+        return allocation;
+    }
+
+    // Everything else gets a dedicated pool, reusing a free one of the same shape when
+    // possible.
+    for (size_t i = 0; i < mFreeDedicatedPools.size(); ++i) {
+        DedicatedPool& freePool = mFreeDedicatedPools[i];
+        if (freePool.queryType == allocation.queryType &&
+            freePool.queryCount == allocation.queryCount &&
+            freePool.pipelineStatistics == allocation.pipelineStatistics) {
+            allocation.pool = freePool.pool;
+            mFreeDedicatedPools.erase(mFreeDedicatedPools.begin() + i);
+            return allocation;
+        }
+    }
+
+    DAWN_TRY_ASSIGN(allocation.pool,
+                    CreateQueryPool(allocation.queryType, allocation.queryCount,
+                                    allocation.pipelineStatistics));
+    return allocation;
+}
+
+void QueryPoolAllocator::Deallocate(QueryPoolAllocation allocation,
+                                    ExecutionSerial lastUsageSerial) {
+    mPendingDeallocations.Enqueue(allocation, lastUsageSerial);
+}
+
+void QueryPoolAllocator::Tick(ExecutionSerial completedSerial) {
+    for (QueryPoolAllocation& allocation : mPendingDeallocations.IterateUpTo(completedSerial)) {
+        if (allocation.sharedPool != nullptr) {
+            allocation.sharedPool->allocator.Deallocate(allocation.baseQueryIndex);
+            ASSERT(allocation.sharedPool->allocationCount > 0);
+            allocation.sharedPool->allocationCount--;
+        } else if (mFreeDedicatedPools.size() < kMaxFreeDedicatedPools) {
+            mFreeDedicatedPools.push_back({allocation.pool, allocation.queryType,
+                                           allocation.queryCount,
+                                           allocation.pipelineStatistics});
+        } else {
+            // The serial completed, so the GPU is done with the pool and it can be destroyed
+            // directly.
+            mDevice->fn.DestroyQueryPool(mDevice->GetVkDevice(), allocation.pool, nullptr);
+        }
+    }
+    mPendingDeallocations.ClearUpTo(completedSerial);
+}
+
+void QueryPoolAllocator::DestroyPool() {
+    for (const DedicatedPool& freePool : mFreeDedicatedPools) {
+        mDevice->fn.DestroyQueryPool(mDevice->GetVkDevice(), freePool.pool, nullptr);
+    }
+    mFreeDedicatedPools.clear();
+
+    // A shared pool may only go away once every slice, live or pending deallocation, is gone.
+    mSharedPools.erase(std::remove_if(mSharedPools.begin(), mSharedPools.end(),
+                                      [this](const std::unique_ptr<SharedQueryPool>& sharedPool) {
+                                          if (sharedPool->allocationCount != 0) {
+                                              return false;
+                                          }
+                                          mDevice->fn.DestroyQueryPool(mDevice->GetVkDevice(),
+                                                                       sharedPool->pool, nullptr);
+                                          return true;
+                                      }),
+                       mSharedPools.end());
+}
+
+}  // namespace dawn::native::vulkan
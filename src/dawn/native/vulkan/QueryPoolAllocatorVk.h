@@ -0,0 +1,93 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_VULKAN_QUERYPOOLALLOCATORVK_H_
+#define SRC_DAWN_NATIVE_VULKAN_QUERYPOOLALLOCATORVK_H_
+
+#include <memory>
+#include <vector>
+
+#include "dawn/common/SerialQueue.h"
+#include "dawn/common/vulkan_platform.h"
+#include "dawn/native/Error.h"
+#include "dawn/native/IntegerTypes.h"
+#include "dawn/native/dawn_platform.h"
+
+namespace dawn::native::vulkan {
+
+class Device;
+
+// Defined in the .cpp; internal bookkeeping for a shared occlusion query pool.
+struct SharedQueryPool;
+
+// The range of queries a QuerySet occupies in a VkQueryPool: either a slice of a shared
+// occlusion pool or the whole of a dedicated pool.
+struct QueryPoolAllocation {
+    VkQueryPool pool = VK_NULL_HANDLE;
+    uint32_t baseQueryIndex = 0;
+    uint32_t queryCount = 0;
+    VkQueryType queryType = VK_QUERY_TYPE_OCCLUSION;
+    VkQueryPipelineStatisticFlags pipelineStatistics = 0;
+    // Non-null when the allocation is a slice of a shared pool owned by the allocator.
+    SharedQueryPool* sharedPool = nullptr;
+};
+
+// Pools VkQueryPools at the device level so that applications which create and destroy query
+// sets every frame (per-frame profilers in particular) don't hit vkCreateQueryPool in steady
+// state. Small occlusion query sets are sub-allocated into large shared pools; other query
+// types and large sets get a dedicated pool that is reused whole. Reuse is serial-gated like
+// the other pooled resources: a deallocated range only becomes available again once the last
+// submission that may reference it completes.
+class QueryPoolAllocator {
+  public:
+    explicit QueryPoolAllocator(Device* device);
+    ~QueryPoolAllocator();
+
+    ResultOrError<QueryPoolAllocation> Allocate(
+        wgpu::QueryType type,
+        uint32_t queryCount,
+        const std::vector<wgpu::PipelineStatisticName>& pipelineStatistics);
+    void Deallocate(QueryPoolAllocation allocation, ExecutionSerial lastUsageSerial);
+
+    // Retires deallocations whose serial completed, making their ranges reusable.
+    void Tick(ExecutionSerial completedSerial);
+    // Frees pooled VkQueryPools that hold no live allocation, see
+    // DeviceBase::ReduceMemoryUsage. Also used on device destruction once all pending
+    // deallocations are retired; the allocator must not outlive the VkDevice with pools
+    // still alive.
+    void DestroyPool();
+
+  private:
+    ResultOrError<VkQueryPool> CreateQueryPool(VkQueryType queryType,
+                                               uint32_t queryCount,
+                                               VkQueryPipelineStatisticFlags pipelineStatistics);
+
+    Device* mDevice;
+
+    std::vector<std::unique_ptr<SharedQueryPool>> mSharedPools;
+
+    struct DedicatedPool {
+        VkQueryPool pool;
+        VkQueryType queryType;
+        uint32_t queryCount;
+        VkQueryPipelineStatisticFlags pipelineStatistics;
+    };
+    std::vector<DedicatedPool> mFreeDedicatedPools;
+
+    SerialQueue<ExecutionSerial, QueryPoolAllocation> mPendingDeallocations;
+};
+
+}  // namespace dawn::native::vulkan
+
+#endif  // SRC_DAWN_NATIVE_VULKAN_QUERYPOOLALLOCATORVK_H_
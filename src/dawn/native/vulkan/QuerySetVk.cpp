@@ -14,57 +14,13 @@
 
 #include "dawn/native/vulkan/QuerySetVk.h"
 
-#include <algorithm>
-#include <vector>
+#include <utility>
 
 #include "dawn/native/vulkan/DeviceVk.h"
-#include "dawn/native/vulkan/FencedDeleter.h"
 #include "dawn/native/vulkan/UtilsVulkan.h"
-#include "dawn/native/vulkan/VulkanError.h"
-#include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native::vulkan {
 
-namespace {
-VkQueryType VulkanQueryType(wgpu::QueryType type) {
-    switch (type) {
-        case wgpu::QueryType::Occlusion:
-            return VK_QUERY_TYPE_OCCLUSION;
-        case wgpu::QueryType::PipelineStatistics:
-            return VK_QUERY_TYPE_PIPELINE_STATISTICS;
-        case wgpu::QueryType::Timestamp:
-            return VK_QUERY_TYPE_TIMESTAMP;
-    }
-    UNREACHABLE();
-}
-
-VkQueryPipelineStatisticFlags VulkanQueryPipelineStatisticFlags(
-    std::vector<wgpu::PipelineStatisticName> pipelineStatisticsSet) {
-    VkQueryPipelineStatisticFlags pipelineStatistics = 0;
-    for (size_t i = 0; i < pipelineStatisticsSet.size(); ++i) {
-        switch (pipelineStatisticsSet[i]) {
-            case wgpu::PipelineStatisticName::ClipperInvocations:
-                pipelineStatistics |= VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT;
-                break;
-            case wgpu::PipelineStatisticName::ClipperPrimitivesOut:
-                pipelineStatistics |= VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT;
-                break;
-            case wgpu::PipelineStatisticName::ComputeShaderInvocations:
-                pipelineStatistics |= VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
-                break;
-            case wgpu::PipelineStatisticName::FragmentShaderInvocations:
-                pipelineStatistics |= VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
-                break;
-            case wgpu::PipelineStatisticName::VertexShaderInvocations:
-                pipelineStatistics |= VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT;
-                break;
-        }
-    }
-
-    return pipelineStatistics;
-}
-}  // anonymous namespace
-
 // static
 ResultOrError<Ref<QuerySet>> QuerySet::Create(Device* device,
                                               const QuerySetDescriptor* descriptor) {
@@ -74,20 +30,10 @@ ResultOrError<Ref<QuerySet>> QuerySet::Create(Device* device,
 }
 
 MaybeError QuerySet::Initialize() {
-    VkQueryPoolCreateInfo createInfo;
-    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
-    createInfo.pNext = NULL;
-    createInfo.flags = 0;
-    createInfo.queryType = VulkanQueryType(GetQueryType());
-    createInfo.queryCount = std::max(GetQueryCount(), uint32_t(1u));
-    if (GetQueryType() == wgpu::QueryType::PipelineStatistics) {
-        createInfo.pipelineStatistics = VulkanQueryPipelineStatisticFlags(GetPipelineStatistics());
-    }
-
     Device* device = ToBackend(GetDevice());
-    DAWN_TRY(CheckVkOOMThenSuccess(
-        device->fn.CreateQueryPool(device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
-        "vkCreateQueryPool"));
+    DAWN_TRY_ASSIGN(mAllocation,
+                    device->GetQueryPoolAllocator()->Allocate(GetQueryType(), GetQueryCount(),
+                                                              GetPipelineStatistics()));
 
     SetLabelImpl();
 
@@ -95,21 +41,33 @@ MaybeError QuerySet::Initialize() {
 }
 
 VkQueryPool QuerySet::GetHandle() const {
-    return mHandle;
+    return mAllocation.pool;
+}
+
+uint32_t QuerySet::GetQueryPoolOffset() const {
+    return mAllocation.baseQueryIndex;
 }
 
 QuerySet::~QuerySet() = default;
 
 void QuerySet::DestroyImpl() {
     QuerySetBase::DestroyImpl();
-    if (mHandle != VK_NULL_HANDLE) {
-        ToBackend(GetDevice())->GetFencedDeleter()->DeleteWhenUnused(mHandle);
-        mHandle = VK_NULL_HANDLE;
+    if (mAllocation.pool != VK_NULL_HANDLE) {
+        // The pool (or the slice of it) goes back to the device's pool; it only becomes
+        // reusable once the last submission that may reference it completes.
+        Device* device = ToBackend(GetDevice());
+        device->GetQueryPoolAllocator()->Deallocate(mAllocation,
+                                                    device->GetPendingCommandSerial());
+        mAllocation = {};
     }
 }
 
 void QuerySet::SetLabelImpl() {
-    SetDebugName(ToBackend(GetDevice()), mHandle, "Dawn_QuerySet", GetLabel());
+    // Slices of a shared pool are not labeled: the native pool is shared between many query
+    // sets.
+    if (mAllocation.sharedPool == nullptr && mAllocation.pool != VK_NULL_HANDLE) {
+        SetDebugName(ToBackend(GetDevice()), mAllocation.pool, "Dawn_QuerySet", GetLabel());
+    }
 }
 
 }  // namespace dawn::native::vulkan
@@ -18,6 +18,7 @@
 #include "dawn/native/QuerySet.h"
 
 #include "dawn/common/vulkan_platform.h"
+#include "dawn/native/vulkan/QueryPoolAllocatorVk.h"
 
 namespace dawn::native::vulkan {
 
@@ -29,6 +30,9 @@ class QuerySet final : public QuerySetBase {
                                                const QuerySetDescriptor* descriptor);
 
     VkQueryPool GetHandle() const;
+    // The index of this query set's first query in the pool. Non-zero when the query set is
+    // sub-allocated from a shared pool, see QueryPoolAllocator.
+    uint32_t GetQueryPoolOffset() const;
 
   private:
     ~QuerySet() override;
@@ -39,7 +43,7 @@ class QuerySet final : public QuerySetBase {
     void DestroyImpl() override;
     void SetLabelImpl() override;
 
-    VkQueryPool mHandle = VK_NULL_HANDLE;
+    QueryPoolAllocation mAllocation;
 };
 
 }  // namespace dawn::native::vulkan
@@ -46,7 +46,12 @@ void Queue::Initialize() {
 MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
     Device* device = ToBackend(GetDevice());
 
-    DAWN_TRY(device->Tick());
+    // When submits are batched, ticking the device here would flush the commands deferred by
+    // the previous submits, so the tick is also deferred until the batch is flushed below.
+    const bool batchSubmits = device->IsToggleEnabled(Toggle::VulkanBatchQueueSubmits);
+    if (!batchSubmits) {
+        DAWN_TRY(device->Tick());
+    }
 
     TRACE_EVENT_BEGIN0(GetDevice()->GetPlatform(), Recording, "CommandBufferVk::RecordCommands");
     CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
@@ -55,6 +60,17 @@ MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* co
     }
     TRACE_EVENT_END0(GetDevice()->GetPlatform(), Recording, "CommandBufferVk::RecordCommands");
 
+    if (batchSubmits) {
+        // The recorded commands stay in the pending recording context so they get coalesced
+        // into a single vkQueueSubmit with following submits. They are flushed once enough
+        // submits accumulate or on the next device tick, typically the frame boundary.
+        if (device->DeferPendingSubmit()) {
+            return {};
+        }
+        DAWN_TRY(device->Tick());
+        return {};
+    }
+
     DAWN_TRY(device->SubmitPendingCommands());
 
     return {};
@@ -91,8 +91,12 @@ RenderPassCache::RenderPassCache(Device* device) : mDevice(device) {}
 
 RenderPassCache::~RenderPassCache() {
     std::lock_guard<std::mutex> lock(mMutex);
-    for (auto [_, renderPass] : mCache) {
-        mDevice->fn.DestroyRenderPass(mDevice->GetVkDevice(), renderPass, nullptr);
+    for (auto& entry : mCache) {
+        // |firstRenderPass| is also contained in |renderPasses| so it isn't destroyed
+        // separately.
+        for (auto [_, renderPass] : entry.second.renderPasses) {
+            mDevice->fn.DestroyRenderPass(mDevice->GetVkDevice(), renderPass, nullptr);
+        }
     }
 
     mCache.clear();
@@ -100,14 +104,35 @@ RenderPassCache::~RenderPassCache() {
 
 ResultOrError<VkRenderPass> RenderPassCache::GetRenderPass(const RenderPassCacheQuery& query) {
     std::lock_guard<std::mutex> lock(mMutex);
-    auto it = mCache.find(query);
-    if (it != mCache.end()) {
+    CompatibilityClass* compatibilityClass = &mCache[query];
+
+    auto it = compatibilityClass->renderPasses.find(query);
+    if (it != compatibilityClass->renderPasses.end()) {
         return VkRenderPass(it->second);
     }
 
     VkRenderPass renderPass;
     DAWN_TRY_ASSIGN(renderPass, CreateRenderPassForQuery(query));
-    mCache.emplace(query, renderPass);
+    compatibilityClass->renderPasses.emplace(query, renderPass);
+    if (compatibilityClass->firstRenderPass == VK_NULL_HANDLE) {
+        compatibilityClass->firstRenderPass = renderPass;
+    }
+    return renderPass;
+}
+
+ResultOrError<VkRenderPass> RenderPassCache::GetCompatibleRenderPass(
+    const RenderPassCacheQuery& query) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    CompatibilityClass* compatibilityClass = &mCache[query];
+
+    if (compatibilityClass->firstRenderPass != VK_NULL_HANDLE) {
+        return VkRenderPass(compatibilityClass->firstRenderPass);
+    }
+
+    VkRenderPass renderPass;
+    DAWN_TRY_ASSIGN(renderPass, CreateRenderPassForQuery(query));
+    compatibilityClass->renderPasses.emplace(query, renderPass);
+    compatibilityClass->firstRenderPass = renderPass;
     return renderPass;
 }
 
@@ -297,4 +322,55 @@ bool RenderPassCache::CacheFuncs::operator()(const RenderPassCacheQuery& a,
 
     return true;
 }
+
+size_t RenderPassCache::CompatibilityCacheFuncs::operator()(
+    const RenderPassCacheQuery& query) const {
+    size_t hash = Hash(query.colorMask);
+
+    HashCombine(&hash, Hash(query.resolveTargetMask));
+
+    for (ColorAttachmentIndex i : IterateBitSet(query.colorMask)) {
+        HashCombine(&hash, query.colorFormats[i]);
+    }
+
+    HashCombine(&hash, query.hasDepthStencil);
+    if (query.hasDepthStencil) {
+        HashCombine(&hash, query.depthStencilFormat);
+    }
+
+    HashCombine(&hash, query.sampleCount);
+
+    return hash;
+}
+
+bool RenderPassCache::CompatibilityCacheFuncs::operator()(const RenderPassCacheQuery& a,
+                                                          const RenderPassCacheQuery& b) const {
+    if (a.colorMask != b.colorMask) {
+        return false;
+    }
+
+    if (a.resolveTargetMask != b.resolveTargetMask) {
+        return false;
+    }
+
+    if (a.sampleCount != b.sampleCount) {
+        return false;
+    }
+
+    for (ColorAttachmentIndex i : IterateBitSet(a.colorMask)) {
+        if (a.colorFormats[i] != b.colorFormats[i]) {
+            return false;
+        }
+    }
+
+    if (a.hasDepthStencil != b.hasDepthStencil) {
+        return false;
+    }
+
+    if (a.hasDepthStencil && a.depthStencilFormat != b.depthStencilFormat) {
+        return false;
+    }
+
+    return true;
+}
 }  // namespace dawn::native::vulkan
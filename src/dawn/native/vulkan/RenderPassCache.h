@@ -72,6 +72,11 @@ struct RenderPassCacheQuery {
 // render pass. We always arrange the order of attachments in "color-depthstencil-resolve" order
 // when creating render pass and framebuffer so that we can always make sure the order of
 // attachments in the rendering pipeline matches the one of the framebuffer.
+// The cache is two-level: queries are first grouped into Vulkan render pass compatibility
+// classes (attachment formats, masks and sample count), with the load/store-op-specific passes
+// derived lazily inside each class. Pipeline creation only requires a pass compatible with the
+// ones used for recording, so it can reuse any member of the class through
+// GetCompatibleRenderPass.
 // All the operations on RenderPassCache are guaranteed to be thread-safe.
 // TODO(cwallez@chromium.org): Make it an LRU cache somehow?
 class RenderPassCache {
@@ -81,6 +86,12 @@ class RenderPassCache {
 
     ResultOrError<VkRenderPass> GetRenderPass(const RenderPassCacheQuery& query);
 
+    // Returns a render pass that is only guaranteed to be compatible with |query|: any pass
+    // already cached in the same compatibility class may be returned, regardless of its
+    // load/store ops. Use this for pipeline creation, where only compatibility matters, so
+    // that pipelines don't force the creation of an extra pass per attachment combination.
+    ResultOrError<VkRenderPass> GetCompatibleRenderPass(const RenderPassCacheQuery& query);
+
   private:
     // Does the actual VkRenderPass creation on a cache miss.
     ResultOrError<VkRenderPass> CreateRenderPassForQuery(const RenderPassCacheQuery& query) const;
@@ -91,7 +102,27 @@ class RenderPassCache {
         size_t operator()(const RenderPassCacheQuery& query) const;
         bool operator()(const RenderPassCacheQuery& a, const RenderPassCacheQuery& b) const;
     };
-    using Cache = std::unordered_map<RenderPassCacheQuery, VkRenderPass, CacheFuncs, CacheFuncs>;
+
+    // Hashes and compares only the attributes that determine render pass compatibility:
+    // attachment formats, masks and sample count. Load/store ops and read-only depth/stencil
+    // only affect ops and image layouts, which the Vulkan compatibility rules ignore.
+    struct CompatibilityCacheFuncs {
+        size_t operator()(const RenderPassCacheQuery& query) const;
+        bool operator()(const RenderPassCacheQuery& a, const RenderPassCacheQuery& b) const;
+    };
+
+    // All the render passes created for one compatibility class. |firstRenderPass| is an
+    // arbitrary member of the class (it is also in |renderPasses|) that is handed out to
+    // pipeline creation.
+    struct CompatibilityClass {
+        VkRenderPass firstRenderPass = VK_NULL_HANDLE;
+        std::unordered_map<RenderPassCacheQuery, VkRenderPass, CacheFuncs, CacheFuncs>
+            renderPasses;
+    };
+    using Cache = std::unordered_map<RenderPassCacheQuery,
+                                     CompatibilityClass,
+                                     CompatibilityCacheFuncs,
+                                     CompatibilityCacheFuncs>;
 
     Device* mDevice = nullptr;
 
@@ -528,10 +528,10 @@ MaybeError RenderPipeline::Initialize() {
     dynamic.dynamicStateCount = sizeof(dynamicStates) / sizeof(dynamicStates[0]);
     dynamic.pDynamicStates = dynamicStates;
 
-    // Get a VkRenderPass that matches the attachment formats for this pipeline, load/store ops
-    // don't matter so set them all to LoadOp::Load / StoreOp::Store. Whether the render pass
-    // has resolve target and whether depth/stencil attachment is read-only also don't matter,
-    // so set them both to false.
+    // Get a VkRenderPass that is compatible with the attachment formats for this pipeline,
+    // load/store ops don't matter so set them all to LoadOp::Load / StoreOp::Store in case a
+    // new pass has to be created. Whether the render pass has resolve target and whether
+    // depth/stencil attachment is read-only also don't matter, so set them both to false.
     VkRenderPass renderPass = VK_NULL_HANDLE;
     {
         RenderPassCacheQuery query;
@@ -549,7 +549,7 @@ MaybeError RenderPipeline::Initialize() {
         query.SetSampleCount(GetSampleCount());
 
         StreamIn(&mCacheKey, query);
-        DAWN_TRY_ASSIGN(renderPass, device->GetRenderPassCache()->GetRenderPass(query));
+        DAWN_TRY_ASSIGN(renderPass, device->GetRenderPassCache()->GetCompatibleRenderPass(query));
     }
 
     // The create info chains in a bunch of things created on the stack here or inside state
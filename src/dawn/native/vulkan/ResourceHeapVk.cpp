@@ -16,8 +16,8 @@
 
 namespace dawn::native::vulkan {
 
-ResourceHeap::ResourceHeap(VkDeviceMemory memory, size_t memoryType)
-    : mMemory(memory), mMemoryType(memoryType) {}
+ResourceHeap::ResourceHeap(VkDeviceMemory memory, size_t memoryType, uint8_t* mappedPointer)
+    : mMemory(memory), mMemoryType(memoryType), mMappedPointer(mappedPointer) {}
 
 VkDeviceMemory ResourceHeap::GetMemory() const {
     return mMemory;
@@ -27,4 +27,8 @@ size_t ResourceHeap::GetMemoryType() const {
     return mMemoryType;
 }
 
+uint8_t* ResourceHeap::GetMappedPointer() const {
+    return mMappedPointer;
+}
+
 }  // namespace dawn::native::vulkan
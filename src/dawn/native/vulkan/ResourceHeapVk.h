@@ -21,17 +21,20 @@
 namespace dawn::native::vulkan {
 
 // Wrapper for physical memory used with or without a resource object.
-class ResourceHeap : public ResourceHeapBase {
+class ResourceHeap final : public ResourceHeapBase {
   public:
-    ResourceHeap(VkDeviceMemory memory, size_t memoryType);
+    ResourceHeap(VkDeviceMemory memory, size_t memoryType, uint8_t* mappedPointer = nullptr);
     ~ResourceHeap() override = default;
 
     VkDeviceMemory GetMemory() const;
     size_t GetMemoryType() const;
+    // Non-null iff the heap's memory type is host-visible and the heap is persistently mapped.
+    uint8_t* GetMappedPointer() const;
 
   private:
     VkDeviceMemory mMemory = VK_NULL_HANDLE;
     size_t mMemoryType = 0;
+    uint8_t* mMappedPointer = nullptr;
 };
 
 }  // namespace dawn::native::vulkan
@@ -19,7 +19,11 @@
 
 #include "dawn/common/Math.h"
 #include "dawn/native/BuddyMemoryAllocator.h"
+#include "dawn/native/PerformanceTuning.h"
 #include "dawn/native/ResourceHeapAllocator.h"
+#include "dawn/native/TLSFMemoryAllocator.h"
+#include "dawn/native/vulkan/AdapterVk.h"
+#include "dawn/native/vulkan/BackendVk.h"
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/native/vulkan/FencedDeleter.h"
 #include "dawn/native/vulkan/ResourceHeapVk.h"
@@ -34,43 +38,76 @@ namespace {
 // factors.
 constexpr uint64_t kMaxSizeForSubAllocation = 4ull * 1024ull * 1024ull;  // 4MiB
 
-// Have each bucket of the buddy system allocate at least some resource of the maximum
-// size
-constexpr uint64_t kBuddyHeapsSize = 2 * kMaxSizeForSubAllocation;
+// Size of the VkDeviceMemory chunks the sub-allocators carve up, from the adapter's tuning
+// profile. Clamped down in the very unlikely case the memory heap is tiny.
+uint64_t GetSubAllocationHeapSize(Device* device, VkDeviceSize memoryHeapSize) {
+    const uint64_t heapsSize = device->GetTuningProfile().vulkanSubAllocationHeapSize;
+    ASSERT(IsPowerOfTwo(heapsSize));
+    // Each chunk must be able to hold the largest resource that gets sub-allocated.
+    ASSERT(heapsSize >= kMaxSizeForSubAllocation);
+    return std::min(uint64_t(1) << Log2(memoryHeapSize), heapsSize);
+}
+
+bool IsMemoryKindMappable(MemoryKind kind) {
+    return kind == MemoryKind::LinearMappable || kind == MemoryKind::LinearWriteMappable;
+}
 
 }  // anonymous namespace
 
-// SingleTypeAllocator is a combination of a BuddyMemoryAllocator and its client and can
-// service suballocation requests, but for a single Vulkan memory type.
+// SingleTypeAllocator combines a sub-allocator (the buddy system, or TLSF when the
+// vulkan_use_tlsf_suballocation toggle is enabled) with its client and can service
+// suballocation requests, but for a single Vulkan memory type.
 
 class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocator {
   public:
-    SingleTypeAllocator(Device* device, size_t memoryTypeIndex, VkDeviceSize memoryHeapSize)
+    SingleTypeAllocator(Device* device,
+                        size_t memoryTypeIndex,
+                        VkDeviceSize memoryHeapSize,
+                        bool persistentlyMapHeaps,
+                        bool useTLSF)
         : mDevice(device),
           mMemoryTypeIndex(memoryTypeIndex),
           mMemoryHeapSize(memoryHeapSize),
+          mPersistentlyMapHeaps(persistentlyMapHeaps),
           mPooledMemoryAllocator(this),
           mBuddySystem(
               // Round down to a power of 2 that's <= mMemoryHeapSize. This will always
-              // be a multiple of kBuddyHeapsSize because kBuddyHeapsSize is a power of 2.
+              // be a multiple of the chunk size because both are powers of 2.
               uint64_t(1) << Log2(mMemoryHeapSize),
-              // Take the min in the very unlikely case the memory heap is tiny.
-              std::min(uint64_t(1) << Log2(mMemoryHeapSize), kBuddyHeapsSize),
+              GetSubAllocationHeapSize(device, memoryHeapSize),
               &mPooledMemoryAllocator) {
-        ASSERT(IsPowerOfTwo(kBuddyHeapsSize));
+        if (useTLSF) {
+            mTLSFSystem = std::make_unique<TLSFMemoryAllocator>(
+                GetSubAllocationHeapSize(device, memoryHeapSize), &mPooledMemoryAllocator);
+        }
     }
     ~SingleTypeAllocator() override = default;
 
     void DestroyPool() { mPooledMemoryAllocator.DestroyPool(); }
 
     ResultOrError<ResourceMemoryAllocation> AllocateMemory(uint64_t size, uint64_t alignment) {
+        if (mTLSFSystem != nullptr) {
+            return mTLSFSystem->Allocate(size, alignment);
+        }
         return mBuddySystem.Allocate(size, alignment);
     }
 
     void DeallocateMemory(const ResourceMemoryAllocation& allocation) {
+        if (mTLSFSystem != nullptr) {
+            mTLSFSystem->Deallocate(allocation);
+            return;
+        }
         mBuddySystem.Deallocate(allocation);
     }
 
+    uint64_t GetReservedMemory() const {
+        return mTLSFSystem != nullptr ? mTLSFSystem->GetReservedMemory() : 0;
+    }
+
+    uint64_t GetUsedMemory() const {
+        return mTLSFSystem != nullptr ? mTLSFSystem->GetUsedMemory() : 0;
+    }
+
     // Implementation of the MemoryAllocator interface to be a client of BuddyMemoryAllocator
 
     ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(uint64_t size) override {
@@ -93,7 +130,22 @@ class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocato
                                   "vkAllocateMemory"));
 
         ASSERT(allocatedMemory != VK_NULL_HANDLE);
-        return {std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex)};
+
+        // Heaps of host-visible types are mapped once at creation and stay mapped until they
+        // are freed (vkFreeMemory implicitly unmaps), so every mappable suballocation placed
+        // in them is just a pointer offset. Mapping costs only address space, which is
+        // plentiful compared to the heap sizes the buddy system uses.
+        void* mappedPointer = nullptr;
+        if (mPersistentlyMapHeaps) {
+            DAWN_TRY_WITH_CLEANUP(
+                CheckVkSuccess(mDevice->fn.MapMemory(mDevice->GetVkDevice(), allocatedMemory, 0,
+                                                     size, 0, &mappedPointer),
+                               "vkMapMemory"),
+                { mDevice->fn.FreeMemory(mDevice->GetVkDevice(), allocatedMemory, nullptr); });
+        }
+
+        return {std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex,
+                                               static_cast<uint8_t*>(mappedPointer))};
     }
 
     void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
@@ -104,8 +156,11 @@ class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocato
     Device* mDevice;
     size_t mMemoryTypeIndex;
     VkDeviceSize mMemoryHeapSize;
+    bool mPersistentlyMapHeaps;
     PooledResourceMemoryAllocator mPooledMemoryAllocator;
     BuddyMemoryAllocator mBuddySystem;
+    // Used instead of mBuddySystem when the vulkan_use_tlsf_suballocation toggle is on.
+    std::unique_ptr<TLSFMemoryAllocator> mTLSFSystem;
 };
 
 // Implementation of ResourceMemoryAllocator
@@ -115,8 +170,17 @@ ResourceMemoryAllocator::ResourceMemoryAllocator(Device* device) : mDevice(devic
     mAllocatorsPerType.reserve(info.memoryTypes.size());
 
     for (size_t i = 0; i < info.memoryTypes.size(); i++) {
+        // Persistently map the heaps that mappable resources can be placed in, which is what
+        // lets mappable resources be suballocated. FindBestTypeIndex only puts mappable
+        // resources in host-visible and host-coherent types.
+        constexpr VkMemoryPropertyFlags kMappableFlags =
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        bool persistentlyMapHeaps =
+            (info.memoryTypes[i].propertyFlags & kMappableFlags) == kMappableFlags;
         mAllocatorsPerType.emplace_back(std::make_unique<SingleTypeAllocator>(
-            mDevice, i, info.memoryHeaps[info.memoryTypes[i].heapIndex].size));
+            mDevice, i, info.memoryHeaps[info.memoryTypes[i].heapIndex].size,
+            persistentlyMapHeaps,
+            mDevice->IsToggleEnabled(Toggle::VulkanUseTLSFSuballocation)));
     }
 }
 
@@ -130,11 +194,14 @@ ResultOrError<ResourceMemoryAllocation> ResourceMemoryAllocator::Allocate(
     ASSERT(memoryType >= 0);
 
     VkDeviceSize size = requirements.size;
-
-    // Sub-allocate non-mappable resources because at the moment the mapped pointer
-    // is part of the resource and not the heap, which doesn't match the Vulkan model.
-    // TODO(crbug.com/dawn/849): allow sub-allocating mappable resources, maybe.
-    if (requirements.size < kMaxSizeForSubAllocation && kind != MemoryKind::LinearMappable &&
+    bool mappable = IsMemoryKindMappable(kind);
+
+    // Mappable resources can be suballocated too because the heaps of host-visible memory
+    // types are persistently mapped; the resource's mapped pointer is then just an offset
+    // into the heap's mapping. This matters for applications that create thousands of small
+    // uniform and staging buffers: each one would otherwise pay for its own vkAllocateMemory
+    // and vkMapMemory. (crbug.com/dawn/849)
+    if (requirements.size < kMaxSizeForSubAllocation &&
         !mDevice->IsToggleEnabled(Toggle::DisableResourceSuballocation)) {
         // When sub-allocating, Vulkan requires that we respect bufferImageGranularity. Some
         // hardware puts information on the memory's page table entry and allocating a linear
@@ -155,6 +222,18 @@ ResultOrError<ResourceMemoryAllocation> ResourceMemoryAllocator::Allocate(
         DAWN_TRY_ASSIGN(subAllocation, mAllocatorsPerType[memoryType]->AllocateMemory(
                                            requirements.size, alignment));
         if (subAllocation.GetInfo().mMethod != AllocationMethod::kInvalid) {
+            mPeakUsedMemory = std::max(mPeakUsedMemory, GetTotalUsedMemory());
+            if (mappable) {
+                uint8_t* heapBase =
+                    ToBackend(subAllocation.GetResourceHeap())->GetMappedPointer();
+                // The memory type is host-visible and host-coherent so its heaps are created
+                // persistently mapped.
+                ASSERT(heapBase != nullptr);
+                return ResourceMemoryAllocation(subAllocation.GetInfo(),
+                                                subAllocation.GetOffset(),
+                                                subAllocation.GetResourceHeap(),
+                                                heapBase + subAllocation.GetOffset());
+            }
             return std::move(subAllocation);
         }
     }
@@ -163,20 +242,16 @@ ResultOrError<ResourceMemoryAllocation> ResourceMemoryAllocator::Allocate(
     std::unique_ptr<ResourceHeapBase> resourceHeap;
     DAWN_TRY_ASSIGN(resourceHeap, mAllocatorsPerType[memoryType]->AllocateResourceHeap(size));
 
-    void* mappedPointer = nullptr;
-    if (kind == MemoryKind::LinearMappable) {
-        DAWN_TRY_WITH_CLEANUP(
-            CheckVkSuccess(mDevice->fn.MapMemory(mDevice->GetVkDevice(),
-                                                 ToBackend(resourceHeap.get())->GetMemory(), 0,
-                                                 size, 0, &mappedPointer),
-                           "vkMapMemory"),
-            { mAllocatorsPerType[memoryType]->DeallocateResourceHeap(std::move(resourceHeap)); });
+    uint8_t* mappedPointer = nullptr;
+    if (mappable) {
+        // The heap was created persistently mapped because its memory type is host-visible.
+        mappedPointer = ToBackend(resourceHeap.get())->GetMappedPointer();
+        ASSERT(mappedPointer != nullptr);
     }
 
     AllocationInfo info;
     info.mMethod = AllocationMethod::kDirect;
-    return ResourceMemoryAllocation(info, /*offset*/ 0, resourceHeap.release(),
-                                    static_cast<uint8_t*>(mappedPointer));
+    return ResourceMemoryAllocation(info, /*offset*/ 0, resourceHeap.release(), mappedPointer);
 }
 
 void ResourceMemoryAllocator::Deallocate(ResourceMemoryAllocation* allocation) {
@@ -228,7 +303,7 @@ void ResourceMemoryAllocator::Tick(ExecutionSerial completedSerial) {
 
 int ResourceMemoryAllocator::FindBestTypeIndex(VkMemoryRequirements requirements, MemoryKind kind) {
     const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
-    bool mappable = kind == MemoryKind::LinearMappable;
+    bool mappable = IsMemoryKindMappable(kind);
 
     // Find a suitable memory type for this allocation
     int bestType = -1;
@@ -256,12 +331,33 @@ int ResourceMemoryAllocator::FindBestTypeIndex(VkMemoryRequirements requirements
             continue;
         }
 
-        // For non-mappable resources, favor device local memory.
+        // For transient attachments, favor lazily allocated memory above everything else so
+        // that tile-based GPUs can keep the attachment in tile-local storage. Types without
+        // the property stay acceptable fallbacks for GPUs that don't expose it.
+        if (kind == MemoryKind::LazilyAllocated) {
+            bool currentLazilyAllocated =
+                info.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+            bool bestLazilyAllocated = info.memoryTypes[bestType].propertyFlags &
+                                       VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+            if (currentLazilyAllocated != bestLazilyAllocated) {
+                if (currentLazilyAllocated) {
+                    bestType = static_cast<int>(i);
+                }
+                continue;
+            }
+        }
+
+        // For non-mappable resources, favor device local memory. Do the same for memory that's
+        // only written by the CPU: on resizable BAR systems a DEVICE_LOCAL | HOST_VISIBLE type
+        // is available, and writing uploads through it avoids staging the data in system memory
+        // first. Mappable-for-reading resources keep host memory because reads from
+        // write-combined device memory are extremely slow.
+        bool preferDeviceLocal = !mappable || kind == MemoryKind::LinearWriteMappable;
         bool currentDeviceLocal =
             info.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
         bool bestDeviceLocal =
             info.memoryTypes[bestType].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-        if (!mappable && (currentDeviceLocal != bestDeviceLocal)) {
+        if (preferDeviceLocal && (currentDeviceLocal != bestDeviceLocal)) {
             if (currentDeviceLocal) {
                 bestType = static_cast<int>(i);
             }
@@ -286,4 +382,54 @@ void ResourceMemoryAllocator::DestroyPool() {
     }
 }
 
+uint64_t ResourceMemoryAllocator::GetTotalReservedMemory() const {
+    uint64_t reservedMemory = 0;
+    for (const auto& alloc : mAllocatorsPerType) {
+        reservedMemory += alloc->GetReservedMemory();
+    }
+    return reservedMemory;
+}
+
+uint64_t ResourceMemoryAllocator::GetTotalUsedMemory() const {
+    uint64_t usedMemory = 0;
+    for (const auto& alloc : mAllocatorsPerType) {
+        usedMemory += alloc->GetUsedMemory();
+    }
+    return usedMemory;
+}
+
+uint64_t ResourceMemoryAllocator::GetPeakUsedMemory() const {
+    return mPeakUsedMemory;
+}
+
+void ResourceMemoryAllocator::CheckMemoryBudget() {
+    if (!mDevice->GetDeviceInfo().HasExt(DeviceExt::MemoryBudget)) {
+        return;
+    }
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties = {};
+    budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2 memoryProperties = {};
+    memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    memoryProperties.pNext = &budgetProperties;
+
+    Adapter* adapter = ToBackend(mDevice->GetAdapter());
+    adapter->GetVulkanInstance()->GetFunctions().GetPhysicalDeviceMemoryProperties2(
+        adapter->GetPhysicalDevice(), &memoryProperties);
+
+    // Report the total over the device-local heaps: that's the memory allocations compete for
+    // and the counterpart of the D3D12 local memory segment.
+    uint64_t usage = 0;
+    uint64_t budget = 0;
+    for (uint32_t i = 0; i < memoryProperties.memoryProperties.memoryHeapCount; ++i) {
+        if (memoryProperties.memoryProperties.memoryHeaps[i].flags &
+            VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            usage += budgetProperties.heapUsage[i];
+            budget += budgetProperties.heapBudget[i];
+        }
+    }
+    mDevice->NotifyMemoryBudgetChanged(usage, budget);
+}
+
 }  // namespace dawn::native::vulkan
@@ -30,10 +30,16 @@ namespace dawn::native::vulkan {
 class Device;
 
 // Various kinds of memory that influence the result of the allocation. For example, to take
-// into account mappability and Vulkan's bufferImageGranularity.
+// into account mappability and Vulkan's bufferImageGranularity. LinearWriteMappable is for
+// memory that's only ever written by the CPU (like staging buffers for uploads) and prefers
+// DEVICE_LOCAL | HOST_VISIBLE memory types so that on resizable BAR systems the writes land
+// directly in device-local memory. LazilyAllocated is for transient attachments and prefers
+// LAZILY_ALLOCATED memory types so that tile-based GPUs never back the image with RAM.
 enum class MemoryKind {
+    LazilyAllocated,
     Linear,
     LinearMappable,
+    LinearWriteMappable,
     Opaque,
 };
 
@@ -50,14 +56,29 @@ class ResourceMemoryAllocator {
 
     void Tick(ExecutionSerial completedSerial);
 
+    // Queries VK_EXT_memory_budget for the process's device-local usage and budget and forwards
+    // them to DeviceBase::NotifyMemoryBudgetChanged. No-op when the extension is unavailable.
+    void CheckMemoryBudget();
+
     int FindBestTypeIndex(VkMemoryRequirements requirements, MemoryKind kind);
 
+    // Fragmentation metrics summed over all memory types: the device memory reserved in
+    // sub-allocation heaps and the part of it occupied by live sub-allocations. Only tracked
+    // by the TLSF sub-allocator; both return 0 when the buddy system is in use.
+    uint64_t GetTotalReservedMemory() const;
+    uint64_t GetTotalUsedMemory() const;
+
+    // High-water mark of GetTotalUsedMemory over the device's lifetime.
+    uint64_t GetPeakUsedMemory() const;
+
   private:
     Device* mDevice;
 
     class SingleTypeAllocator;
     std::vector<std::unique_ptr<SingleTypeAllocator>> mAllocatorsPerType;
 
+    uint64_t mPeakUsedMemory = 0;
+
     SerialQueue<ExecutionSerial, ResourceMemoryAllocation> mSubAllocationsToDelete;
 };
 
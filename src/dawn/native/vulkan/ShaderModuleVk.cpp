@@ -144,7 +144,9 @@ ShaderModule::ShaderModule(Device* device, const ShaderModuleDescriptor* descrip
 
 MaybeError ShaderModule::Initialize(ShaderModuleParseResult* parseResult,
                                     OwnedCompilationMessages* compilationMessages) {
-    if (GetDevice()->IsRobustnessEnabled()) {
+    // For a deferred parse this first runs with an unparsed result and again on the worker
+    // thread once the program exists; the transform only applies to the second run.
+    if (GetDevice()->IsRobustnessEnabled() && parseResult->HasParsedShader()) {
         ScopedTintICEHandler scopedICEHandler(GetDevice());
 
         tint::transform::Robustness robustness;
@@ -51,7 +51,7 @@ class ShaderModule final : public ShaderModuleBase {
     ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor);
     ~ShaderModule() override;
     MaybeError Initialize(ShaderModuleParseResult* parseResult,
-                          OwnedCompilationMessages* compilationMessages);
+                          OwnedCompilationMessages* compilationMessages) override;
     void DestroyImpl() override;
 
     // New handles created by GetHandleAndSpirv at pipeline creation time.
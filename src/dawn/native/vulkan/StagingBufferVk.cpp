@@ -43,8 +43,10 @@ MaybeError StagingBuffer::Initialize() {
     VkMemoryRequirements requirements;
     mDevice->fn.GetBufferMemoryRequirements(mDevice->GetVkDevice(), mBuffer, &requirements);
 
+    // Staging buffers are only ever written by the CPU, so prefer device-local host-visible
+    // (resizable BAR) memory when it is available.
     DAWN_TRY_ASSIGN(mAllocation, mDevice->GetResourceMemoryAllocator()->Allocate(
-                                     requirements, MemoryKind::LinearMappable));
+                                     requirements, MemoryKind::LinearWriteMappable));
 
     DAWN_TRY(CheckVkSuccess(
         mDevice->fn.BindBufferMemory(mDevice->GetVkDevice(), mBuffer,
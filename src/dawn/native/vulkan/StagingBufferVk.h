@@ -23,7 +23,7 @@ namespace dawn::native::vulkan {
 
 class Device;
 
-class StagingBuffer : public StagingBufferBase {
+class StagingBuffer final : public StagingBufferBase {
   public:
     StagingBuffer(size_t size, Device* device);
     ~StagingBuffer() override;
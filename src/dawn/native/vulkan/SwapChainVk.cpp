@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <limits>
 #include <utility>
+#include <vector>
 
 #include "dawn/common/Compiler.h"
 #include "dawn/native/Instance.h"
@@ -585,6 +586,36 @@ MaybeError SwapChain::PresentImpl() {
     presentInfo.pImageIndices = &mLastImageIndex;
     presentInfo.pResults = nullptr;
 
+    // Forward the damage hint with VK_KHR_incremental_present when possible. When presents go
+    // through the blit path the swapchain size doesn't match the API size so the rects wouldn't
+    // map to swapchain pixels; just present the full image in that case.
+    std::vector<VkRectLayerKHR> damageRects;
+    VkPresentRegionKHR presentRegion;
+    VkPresentRegionsKHR presentRegions;
+    const std::vector<PresentDamageRect>& damage = GetNextPresentDamage();
+    if (!damage.empty() && !mConfig.needsBlit &&
+        device->GetDeviceInfo().HasExt(DeviceExt::IncrementalPresent)) {
+        damageRects.reserve(damage.size());
+        for (const PresentDamageRect& rect : damage) {
+            VkRectLayerKHR rectLayer;
+            rectLayer.offset.x = static_cast<int32_t>(rect.x);
+            rectLayer.offset.y = static_cast<int32_t>(rect.y);
+            rectLayer.extent.width = rect.width;
+            rectLayer.extent.height = rect.height;
+            rectLayer.layer = 0;
+            damageRects.push_back(rectLayer);
+        }
+
+        presentRegion.rectangleCount = static_cast<uint32_t>(damageRects.size());
+        presentRegion.pRectangles = damageRects.data();
+
+        presentRegions.sType = VK_STRUCTURE_TYPE_PRESENT_REGIONS_KHR;
+        presentRegions.pNext = nullptr;
+        presentRegions.swapchainCount = 1;
+        presentRegions.pRegions = &presentRegion;
+        presentInfo.pNext = &presentRegions;
+    }
+
     // Free the texture before present so error handling doesn't skip that step.
     mTexture->APIDestroy();
     mTexture = nullptr;
@@ -619,17 +650,10 @@ ResultOrError<Ref<TextureViewBase>> SwapChain::GetCurrentTextureViewImpl() {
 ResultOrError<Ref<TextureViewBase>> SwapChain::GetCurrentTextureViewInternal(bool isReentrant) {
     Device* device = ToBackend(GetDevice());
 
-    // Transiently create a semaphore that will be signaled when the presentation engine is done
-    // with the swapchain image. Further operations on the image will wait for this semaphore.
-    VkSemaphoreCreateInfo createInfo;
-    createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-    createInfo.pNext = nullptr;
-    createInfo.flags = 0;
-
+    // Take a semaphore that will be signaled when the presentation engine is done with the
+    // swapchain image. Further operations on the image will wait for this semaphore.
     VkSemaphore semaphore = VK_NULL_HANDLE;
-    DAWN_TRY(CheckVkSuccess(
-        device->fn.CreateSemaphore(device->GetVkDevice(), &createInfo, nullptr, &*semaphore),
-        "CreateSemaphore"));
+    DAWN_TRY_ASSIGN(semaphore, device->GetUnusedSemaphore());
 
     VkResult result = VkResult::WrapUnsafe(device->fn.AcquireNextImageKHR(
         device->GetVkDevice(), mSwapChain, std::numeric_limits<uint64_t>::max(), semaphore,
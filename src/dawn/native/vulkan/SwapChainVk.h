@@ -27,7 +27,7 @@ class Device;
 class Texture;
 struct VulkanSurfaceInfo;
 
-class OldSwapChain : public OldSwapChainBase {
+class OldSwapChain final : public OldSwapChainBase {
   public:
     static Ref<OldSwapChain> Create(Device* device, const SwapChainDescriptor* descriptor);
 
@@ -42,7 +42,7 @@ class OldSwapChain : public OldSwapChainBase {
     wgpu::TextureUsage mTextureUsage;
 };
 
-class SwapChain : public NewSwapChainBase {
+class SwapChain final : public NewSwapChainBase {
   public:
     static ResultOrError<Ref<SwapChain>> Create(Device* device,
                                                 Surface* surface,
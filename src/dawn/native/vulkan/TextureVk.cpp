@@ -14,6 +14,7 @@
 
 #include "dawn/native/vulkan/TextureVk.h"
 
+#include <array>
 #include <utility>
 
 #include "dawn/common/Assert.h"
@@ -59,10 +60,36 @@ VkImageViewType VulkanImageViewType(wgpu::TextureViewDimension dimension) {
     UNREACHABLE();
 }
 
+// The conversions from usages to access and stage flags run per subresource per barrier, so
+// they are precomputed into lookup tables over the barrier-relevant usage combinations: the
+// five API usage bits with kReadOnlyRenderAttachment folded in next to them. Present is
+// special-cased before the lookup (it is never combined with other usages) and the remaining
+// internal bits do not affect barriers, matching the per-bit checks the tables are built from.
+constexpr uint32_t kApiTextureUsageMask = 0x1F;
+constexpr uint32_t kReadOnlyRenderAttachmentIndexBit = 0x20;
+constexpr uint32_t kTextureUsageIndexCount = 0x40;
+
+constexpr uint32_t TextureUsageIndex(wgpu::TextureUsage usage) {
+    uint32_t index = static_cast<uint32_t>(usage) & kApiTextureUsageMask;
+    if (usage & kReadOnlyRenderAttachment) {
+        index |= kReadOnlyRenderAttachmentIndexBit;
+    }
+    return index;
+}
+
+constexpr wgpu::TextureUsage TextureUsageFromIndex(uint32_t index) {
+    wgpu::TextureUsage usage = static_cast<wgpu::TextureUsage>(index & kApiTextureUsageMask);
+    if (index & kReadOnlyRenderAttachmentIndexBit) {
+        usage = usage | kReadOnlyRenderAttachment;
+    }
+    return usage;
+}
+
 // Computes which vulkan access type could be required for the given Dawn usage.
 // TODO(crbug.com/dawn/269): We shouldn't need any access usages for srcAccessMask when
 // the previous usage is readonly because an execution dependency is sufficient.
-VkAccessFlags VulkanAccessFlags(wgpu::TextureUsage usage, const Format& format) {
+constexpr VkAccessFlags ComputeVulkanAccessFlags(wgpu::TextureUsage usage,
+                                                 bool hasDepthOrStencil) {
     VkAccessFlags flags = 0;
 
     if (usage & wgpu::TextureUsage::CopySrc) {
@@ -78,7 +105,7 @@ VkAccessFlags VulkanAccessFlags(wgpu::TextureUsage usage, const Format& format)
         flags |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
     }
     if (usage & wgpu::TextureUsage::RenderAttachment) {
-        if (format.HasDepthOrStencil()) {
+        if (hasDepthOrStencil) {
             flags |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
                      VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
         } else {
@@ -88,37 +115,15 @@ VkAccessFlags VulkanAccessFlags(wgpu::TextureUsage usage, const Format& format)
     if (usage & kReadOnlyRenderAttachment) {
         flags |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
     }
-    if (usage & kPresentTextureUsage) {
-        // The present usage is only used internally by the swapchain and is never used in
-        // combination with other usages.
-        ASSERT(usage == kPresentTextureUsage);
-        // The Vulkan spec has the following note:
-        //
-        //   When transitioning the image to VK_IMAGE_LAYOUT_SHARED_PRESENT_KHR or
-        //   VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, there is no need to delay subsequent
-        //   processing, or perform any visibility operations (as vkQueuePresentKHR performs
-        //   automatic visibility operations). To achieve this, the dstAccessMask member of
-        //   the VkImageMemoryBarrier should be set to 0, and the dstStageMask parameter
-        //   should be set to VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT.
-        //
-        // So on the transition to Present we don't need an access flag. The other
-        // direction doesn't matter because swapchain textures always start a new frame
-        // as uninitialized.
-        flags |= 0;
-    }
 
     return flags;
 }
 
 // Computes which Vulkan pipeline stage can access a texture in the given Dawn usage
-VkPipelineStageFlags VulkanPipelineStage(wgpu::TextureUsage usage, const Format& format) {
+constexpr VkPipelineStageFlags ComputeVulkanPipelineStage(wgpu::TextureUsage usage,
+                                                          bool hasDepthOrStencil) {
     VkPipelineStageFlags flags = 0;
 
-    if (usage == wgpu::TextureUsage::None) {
-        // This only happens when a texture is initially created (and for srcAccessMask) in
-        // which case there is no need to wait on anything to stop accessing this texture.
-        return VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-    }
     if (usage & (wgpu::TextureUsage::CopySrc | wgpu::TextureUsage::CopyDst)) {
         flags |= VK_PIPELINE_STAGE_TRANSFER_BIT;
     }
@@ -133,13 +138,70 @@ VkPipelineStageFlags VulkanPipelineStage(wgpu::TextureUsage usage, const Format&
         flags |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
     }
     if (usage & (wgpu::TextureUsage::RenderAttachment | kReadOnlyRenderAttachment)) {
-        if (format.HasDepthOrStencil()) {
+        if (hasDepthOrStencil) {
             flags |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
                      VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
         } else {
             flags |= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         }
     }
+
+    return flags;
+}
+
+constexpr std::array<VkAccessFlags, kTextureUsageIndexCount> MakeVulkanAccessFlagsTable(
+    bool hasDepthOrStencil) {
+    std::array<VkAccessFlags, kTextureUsageIndexCount> table{};
+    for (uint32_t i = 0; i < kTextureUsageIndexCount; ++i) {
+        table[i] = ComputeVulkanAccessFlags(TextureUsageFromIndex(i), hasDepthOrStencil);
+    }
+    return table;
+}
+
+constexpr std::array<VkPipelineStageFlags, kTextureUsageIndexCount> MakeVulkanPipelineStageTable(
+    bool hasDepthOrStencil) {
+    std::array<VkPipelineStageFlags, kTextureUsageIndexCount> table{};
+    for (uint32_t i = 0; i < kTextureUsageIndexCount; ++i) {
+        table[i] = ComputeVulkanPipelineStage(TextureUsageFromIndex(i), hasDepthOrStencil);
+    }
+    return table;
+}
+
+constexpr auto kColorAccessFlagsTable = MakeVulkanAccessFlagsTable(false);
+constexpr auto kDepthStencilAccessFlagsTable = MakeVulkanAccessFlagsTable(true);
+constexpr auto kColorPipelineStageTable = MakeVulkanPipelineStageTable(false);
+constexpr auto kDepthStencilPipelineStageTable = MakeVulkanPipelineStageTable(true);
+
+VkAccessFlags VulkanAccessFlags(wgpu::TextureUsage usage, const Format& format) {
+    if (usage & kPresentTextureUsage) {
+        // The present usage is only used internally by the swapchain and is never used in
+        // combination with other usages.
+        ASSERT(usage == kPresentTextureUsage);
+        // The Vulkan spec has the following note:
+        //
+        //   When transitioning the image to VK_IMAGE_LAYOUT_SHARED_PRESENT_KHR or
+        //   VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, there is no need to delay subsequent
+        //   processing, or perform any visibility operations (as vkQueuePresentKHR performs
+        //   automatic visibility operations). To achieve this, the dstAccessMask member of
+        //   the VkImageMemoryBarrier should be set to 0, and the dstStageMask parameter
+        //   should be set to VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT.
+        //
+        // So on the transition to Present we don't need an access flag. The other
+        // direction doesn't matter because swapchain textures always start a new frame
+        // as uninitialized.
+        return 0;
+    }
+
+    return format.HasDepthOrStencil() ? kDepthStencilAccessFlagsTable[TextureUsageIndex(usage)]
+                                      : kColorAccessFlagsTable[TextureUsageIndex(usage)];
+}
+
+VkPipelineStageFlags VulkanPipelineStage(wgpu::TextureUsage usage, const Format& format) {
+    if (usage == wgpu::TextureUsage::None) {
+        // This only happens when a texture is initially created (and for srcAccessMask) in
+        // which case there is no need to wait on anything to stop accessing this texture.
+        return VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    }
     if (usage & kPresentTextureUsage) {
         // The present usage is only used internally by the swapchain and is never used in
         // combination with other usages.
@@ -156,9 +218,12 @@ VkPipelineStageFlags VulkanPipelineStage(wgpu::TextureUsage usage, const Format&
         // So on the transition to Present we use the "bottom of pipe" stage. The other
         // direction doesn't matter because swapchain textures always start a new frame
         // as uninitialized.
-        flags |= VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        return VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
     }
 
+    VkPipelineStageFlags flags = format.HasDepthOrStencil()
+                                     ? kDepthStencilPipelineStageTable[TextureUsageIndex(usage)]
+                                     : kColorPipelineStageTable[TextureUsageIndex(usage)];
     // A zero value isn't a valid pipeline stage mask
     ASSERT(flags != 0);
     return flags;
@@ -474,6 +539,9 @@ VkImageUsageFlags VulkanImageUsage(wgpu::TextureUsage usage, const Format& forma
     if (usage & kReadOnlyRenderAttachment) {
         flags |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
     }
+    if (usage & kTransientAttachment) {
+        flags |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    }
 
     return flags;
 }
@@ -684,8 +752,13 @@ MaybeError Texture::InitializeAsInternalTexture(VkImageUsageFlags extraUsages) {
 
     // We always set VK_IMAGE_USAGE_TRANSFER_DST_BIT unconditionally beause the Vulkan images
     // that are used in vkCmdClearColorImage() must have been created with this flag, which is
-    // also required for the implementation of robust resource initialization.
-    createInfo.usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    // also required for the implementation of robust resource initialization. The exception is
+    // transient attachments: VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT may only be combined with
+    // attachment usages, and the frontend guarantees they are only cleared through render pass
+    // load operations.
+    if (!(GetInternalUsage() & kTransientAttachment)) {
+        createInfo.usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    }
 
     DAWN_TRY(CheckVkSuccess(
         device->fn.CreateImage(device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
@@ -695,8 +768,13 @@ MaybeError Texture::InitializeAsInternalTexture(VkImageUsageFlags extraUsages) {
     VkMemoryRequirements requirements;
     device->fn.GetImageMemoryRequirements(device->GetVkDevice(), mHandle, &requirements);
 
-    DAWN_TRY_ASSIGN(mMemoryAllocation, device->GetResourceMemoryAllocator()->Allocate(
-                                           requirements, MemoryKind::Opaque));
+    // Transient attachments prefer lazily allocated memory so that tile-based GPUs can keep
+    // their contents in tile-local storage and never back them with RAM.
+    MemoryKind memoryKind = (GetInternalUsage() & kTransientAttachment)
+                                ? MemoryKind::LazilyAllocated
+                                : MemoryKind::Opaque;
+    DAWN_TRY_ASSIGN(mMemoryAllocation,
+                    device->GetResourceMemoryAllocator()->Allocate(requirements, memoryKind));
 
     DAWN_TRY(CheckVkSuccess(
         device->fn.BindImageMemory(device->GetVkDevice(), mHandle,
@@ -704,7 +782,8 @@ MaybeError Texture::InitializeAsInternalTexture(VkImageUsageFlags extraUsages) {
                                    mMemoryAllocation.GetOffset()),
         "BindImageMemory"));
 
-    if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting)) {
+    if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting) &&
+        !(GetInternalUsage() & kTransientAttachment)) {
         DAWN_TRY(ClearTexture(ToBackend(GetDevice())->GetPendingRecordingContext(),
                               GetAllSubresources(), TextureBase::ClearValue::NonZero));
     }
@@ -1147,6 +1226,20 @@ void Texture::TransitionUsageNow(CommandRecordingContext* recordingContext,
     }
 }
 
+void Texture::TransitionForLazyClear(CommandRecordingContext* recordingContext,
+                                     const SubresourceRange& range,
+                                     std::vector<VkImageMemoryBarrier>* imageBarriers,
+                                     VkPipelineStageFlags* srcStages,
+                                     VkPipelineStageFlags* dstStages) {
+    size_t transitionBarrierStart = imageBarriers->size();
+    TransitionUsageAndGetResourceBarrier(wgpu::TextureUsage::CopyDst, range, imageBarriers,
+                                         srcStages, dstStages);
+
+    if (mExternalState != ExternalState::InternalOnly) {
+        TweakTransitionForExternalUsage(recordingContext, imageBarriers, transitionBarrierStart);
+    }
+}
+
 void Texture::TransitionUsageAndGetResourceBarrier(wgpu::TextureUsage usage,
                                                    const SubresourceRange& range,
                                                    std::vector<VkImageMemoryBarrier>* imageBarriers,
@@ -1257,9 +1350,12 @@ MaybeError Texture::ClearTexture(CommandRecordingContext* recordingContext,
                                         GetHandle(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                                         regions.size(), regions.data());
     } else {
+        // Gather the subresources to clear first, merging contiguous layers of a level into a
+        // single VkImageSubresourceRange, so the whole request is recorded with one
+        // vkCmdClear*Image call instead of one per subresource.
+        std::vector<VkImageSubresourceRange> imageRanges;
         for (uint32_t level = range.baseMipLevel; level < range.baseMipLevel + range.levelCount;
              ++level) {
-            imageRange.baseMipLevel = level;
             for (uint32_t layer = range.baseArrayLayer;
                  layer < range.baseArrayLayer + range.layerCount; ++layer) {
                 Aspect aspects = Aspect::None;
@@ -1277,46 +1373,80 @@ MaybeError Texture::ClearTexture(CommandRecordingContext* recordingContext,
                     continue;
                 }
 
-                imageRange.aspectMask = VulkanAspectMask(aspects);
+                VkImageAspectFlags aspectMask = VulkanAspectMask(aspects);
+                if (!imageRanges.empty()) {
+                    VkImageSubresourceRange& last = imageRanges.back();
+                    if (last.aspectMask == aspectMask && last.baseMipLevel == level &&
+                        last.baseArrayLayer + last.layerCount == layer) {
+                        last.layerCount++;
+                        continue;
+                    }
+                }
+
+                imageRange.aspectMask = aspectMask;
+                imageRange.baseMipLevel = level;
                 imageRange.baseArrayLayer = layer;
+                imageRanges.push_back(imageRange);
+            }
+        }
 
-                if (aspects & (Aspect::Depth | Aspect::Stencil | Aspect::CombinedDepthStencil)) {
-                    VkClearDepthStencilValue clearDepthStencilValue[1];
-                    clearDepthStencilValue[0].depth = fClearColor;
-                    clearDepthStencilValue[0].stencil = uClearColor;
-                    device->fn.CmdClearDepthStencilImage(recordingContext->commandBuffer,
-                                                         GetHandle(),
-                                                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                                         clearDepthStencilValue, 1, &imageRange);
-                } else {
-                    ASSERT(aspects == Aspect::Color);
-                    VkClearColorValue clearColorValue;
-                    switch (GetFormat().GetAspectInfo(Aspect::Color).baseType) {
-                        case wgpu::TextureComponentType::Float:
-                            clearColorValue.float32[0] = fClearColor;
-                            clearColorValue.float32[1] = fClearColor;
-                            clearColorValue.float32[2] = fClearColor;
-                            clearColorValue.float32[3] = fClearColor;
-                            break;
-                        case wgpu::TextureComponentType::Sint:
-                            clearColorValue.int32[0] = sClearColor;
-                            clearColorValue.int32[1] = sClearColor;
-                            clearColorValue.int32[2] = sClearColor;
-                            clearColorValue.int32[3] = sClearColor;
-                            break;
-                        case wgpu::TextureComponentType::Uint:
-                            clearColorValue.uint32[0] = uClearColor;
-                            clearColorValue.uint32[1] = uClearColor;
-                            clearColorValue.uint32[2] = uClearColor;
-                            clearColorValue.uint32[3] = uClearColor;
-                            break;
-                        case wgpu::TextureComponentType::DepthComparison:
-                            UNREACHABLE();
-                    }
-                    device->fn.CmdClearColorImage(recordingContext->commandBuffer, GetHandle(),
-                                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                                  &clearColorValue, 1, &imageRange);
+        // Fold consecutive levels that cover the same layers into a single range. After this
+        // the common case of a fully uninitialized texture is one range for the whole request.
+        size_t mergedCount = 0;
+        for (size_t i = 1; i < imageRanges.size(); ++i) {
+            VkImageSubresourceRange& last = imageRanges[mergedCount];
+            const VkImageSubresourceRange& current = imageRanges[i];
+            if (last.aspectMask == current.aspectMask &&
+                last.baseMipLevel + last.levelCount == current.baseMipLevel &&
+                last.baseArrayLayer == current.baseArrayLayer &&
+                last.layerCount == current.layerCount) {
+                last.levelCount++;
+            } else {
+                imageRanges[++mergedCount] = current;
+            }
+        }
+
+        if (!imageRanges.empty()) {
+            imageRanges.resize(mergedCount + 1);
+
+            if (GetFormat().aspects &
+                (Aspect::Depth | Aspect::Stencil | Aspect::CombinedDepthStencil)) {
+                VkClearDepthStencilValue clearDepthStencilValue[1];
+                clearDepthStencilValue[0].depth = fClearColor;
+                clearDepthStencilValue[0].stencil = uClearColor;
+                device->fn.CmdClearDepthStencilImage(
+                    recordingContext->commandBuffer, GetHandle(),
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, clearDepthStencilValue,
+                    imageRanges.size(), imageRanges.data());
+            } else {
+                ASSERT(GetFormat().aspects == Aspect::Color);
+                VkClearColorValue clearColorValue;
+                switch (GetFormat().GetAspectInfo(Aspect::Color).baseType) {
+                    case wgpu::TextureComponentType::Float:
+                        clearColorValue.float32[0] = fClearColor;
+                        clearColorValue.float32[1] = fClearColor;
+                        clearColorValue.float32[2] = fClearColor;
+                        clearColorValue.float32[3] = fClearColor;
+                        break;
+                    case wgpu::TextureComponentType::Sint:
+                        clearColorValue.int32[0] = sClearColor;
+                        clearColorValue.int32[1] = sClearColor;
+                        clearColorValue.int32[2] = sClearColor;
+                        clearColorValue.int32[3] = sClearColor;
+                        break;
+                    case wgpu::TextureComponentType::Uint:
+                        clearColorValue.uint32[0] = uClearColor;
+                        clearColorValue.uint32[1] = uClearColor;
+                        clearColorValue.uint32[2] = uClearColor;
+                        clearColorValue.uint32[3] = uClearColor;
+                        break;
+                    case wgpu::TextureComponentType::DepthComparison:
+                        UNREACHABLE();
                 }
+                device->fn.CmdClearColorImage(recordingContext->commandBuffer, GetHandle(),
+                                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                              &clearColorValue, imageRanges.size(),
+                                              imageRanges.data());
             }
         }
     }
@@ -1357,12 +1487,12 @@ VkImageLayout Texture::GetCurrentLayoutForSwapChain() const {
 // static
 ResultOrError<Ref<TextureView>> TextureView::Create(TextureBase* texture,
                                                     const TextureViewDescriptor* descriptor) {
-    Ref<TextureView> view = AcquireRef(new TextureView(texture, descriptor));
-    DAWN_TRY(view->Initialize(descriptor));
-    return view;
+    // The VkImageView is created lazily in GetHandle: with views interned per texture, many
+    // views are requested but never bound and shouldn't pay for a vkCreateImageView.
+    return AcquireRef(new TextureView(texture, descriptor));
 }
 
-MaybeError TextureView::Initialize(const TextureViewDescriptor* descriptor) {
+MaybeError TextureView::CreateVkImageView() {
     if ((GetTexture()->GetInternalUsage() &
          ~(wgpu::TextureUsage::CopySrc | wgpu::TextureUsage::CopyDst)) == 0) {
         // If the texture view has no other usage than CopySrc and CopyDst, then it can't
@@ -1371,7 +1501,7 @@ MaybeError TextureView::Initialize(const TextureViewDescriptor* descriptor) {
         return {};
     }
 
-    // Texture could be destroyed by the time we make a view.
+    // Texture could be destroyed by the time the view is first bound.
     if (GetTexture()->GetTextureState() == Texture::TextureState::Destroyed) {
         return {};
     }
@@ -1383,7 +1513,7 @@ MaybeError TextureView::Initialize(const TextureViewDescriptor* descriptor) {
     createInfo.pNext = nullptr;
     createInfo.flags = 0;
     createInfo.image = ToBackend(GetTexture())->GetHandle();
-    createInfo.viewType = VulkanImageViewType(descriptor->dimension);
+    createInfo.viewType = VulkanImageViewType(GetDimension());
 
     const Format& textureFormat = GetTexture()->GetFormat();
     if (textureFormat.HasStencil() &&
@@ -1395,7 +1525,7 @@ MaybeError TextureView::Initialize(const TextureViewDescriptor* descriptor) {
         // format.
         createInfo.format = VulkanImageFormat(device, textureFormat.format);
     } else {
-        createInfo.format = VulkanImageFormat(device, descriptor->format);
+        createInfo.format = VulkanImageFormat(device, GetFormat().format);
     }
 
     createInfo.components = VkComponentMapping{VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G,
@@ -1420,6 +1550,7 @@ MaybeError TextureView::Initialize(const TextureViewDescriptor* descriptor) {
 TextureView::~TextureView() {}
 
 void TextureView::DestroyImpl() {
+    TextureViewBase::DestroyImpl();
     Device* device = ToBackend(GetTexture()->GetDevice());
 
     if (mHandle != VK_NULL_HANDLE) {
@@ -1428,7 +1559,13 @@ void TextureView::DestroyImpl() {
     }
 }
 
-VkImageView TextureView::GetHandle() const {
+VkImageView TextureView::GetHandle() {
+    if (mHandle == VK_NULL_HANDLE) {
+        Device* device = ToBackend(GetTexture()->GetDevice());
+        if (device->ConsumedError(CreateVkImageView(), "creating image view for %s", this)) {
+            return VK_NULL_HANDLE;
+        }
+    }
     return mHandle;
 }
 
@@ -81,6 +81,15 @@ class Texture final : public TextureBase {
     // Eagerly transition the texture for export.
     void TransitionEagerlyForExport(CommandRecordingContext* recordingContext);
 
+    // Transitions `range` to the usage lazy clears are recorded with, appending the barriers to
+    // `imageBarriers` so that the transitions for all the clears of a pass can be issued with a
+    // single vkCmdPipelineBarrier before the clears themselves.
+    void TransitionForLazyClear(CommandRecordingContext* recordingContext,
+                                const SubresourceRange& range,
+                                std::vector<VkImageMemoryBarrier>* imageBarriers,
+                                VkPipelineStageFlags* srcStages,
+                                VkPipelineStageFlags* dstStages);
+
     void EnsureSubresourceContentInitialized(CommandRecordingContext* recordingContext,
                                              const SubresourceRange& range);
 
@@ -198,13 +207,16 @@ class TextureView final : public TextureViewBase {
   public:
     static ResultOrError<Ref<TextureView>> Create(TextureBase* texture,
                                                   const TextureViewDescriptor* descriptor);
-    VkImageView GetHandle() const;
+    // Creates the VkImageView on first use. Returns VK_NULL_HANDLE when the texture was
+    // destroyed or creation failed; callers already skip such views and the corresponding
+    // commands fail validation before submission.
+    VkImageView GetHandle();
 
   private:
     ~TextureView() override;
     void DestroyImpl() override;
     using TextureViewBase::TextureViewBase;
-    MaybeError Initialize(const TextureViewDescriptor* descriptor);
+    MaybeError CreateVkImageView();
 
     // Dawn API
     void SetLabelImpl() override;
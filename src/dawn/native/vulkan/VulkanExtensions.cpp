@@ -148,9 +148,11 @@ static constexpr std::array<DeviceExtInfo, kDeviceExtCount> sDeviceExtInfos{{
     {DeviceExt::_16BitStorage, "VK_KHR_16bit_storage", VulkanVersion_1_1},
     {DeviceExt::SamplerYCbCrConversion, "VK_KHR_sampler_ycbcr_conversion", VulkanVersion_1_1},
 
+    {DeviceExt::DrawIndirectCount, "VK_KHR_draw_indirect_count", VulkanVersion_1_2},
     {DeviceExt::DriverProperties, "VK_KHR_driver_properties", VulkanVersion_1_2},
     {DeviceExt::ImageFormatList, "VK_KHR_image_format_list", VulkanVersion_1_2},
     {DeviceExt::ShaderFloat16Int8, "VK_KHR_shader_float16_int8", VulkanVersion_1_2},
+    {DeviceExt::TimelineSemaphore, "VK_KHR_timeline_semaphore", VulkanVersion_1_2},
 
     {DeviceExt::ShaderIntegerDotProduct, "VK_KHR_shader_integer_dot_product", VulkanVersion_1_3},
     {DeviceExt::ZeroInitializeWorkgroupMemory, "VK_KHR_zero_initialize_workgroup_memory",
@@ -164,7 +166,9 @@ static constexpr std::array<DeviceExtInfo, kDeviceExtCount> sDeviceExtInfos{{
 
     {DeviceExt::DepthClipEnable, "VK_EXT_depth_clip_enable", NeverPromoted},
     {DeviceExt::ImageDrmFormatModifier, "VK_EXT_image_drm_format_modifier", NeverPromoted},
+    {DeviceExt::MemoryBudget, "VK_EXT_memory_budget", NeverPromoted},
     {DeviceExt::Swapchain, "VK_KHR_swapchain", NeverPromoted},
+    {DeviceExt::IncrementalPresent, "VK_KHR_incremental_present", NeverPromoted},
     {DeviceExt::SubgroupSizeControl, "VK_EXT_subgroup_size_control", NeverPromoted},
     //
 }};
@@ -204,6 +208,7 @@ DeviceExtSet EnsureDependencies(const DeviceExtSet& advertisedExts,
         switch (ext) {
             // Happy extensions don't need anybody else!
             case DeviceExt::BindMemory2:
+            case DeviceExt::DrawIndirectCount:
             case DeviceExt::GetMemoryRequirements2:
             case DeviceExt::Maintenance1:
             case DeviceExt::ImageFormatList:
@@ -238,6 +243,10 @@ DeviceExtSet EnsureDependencies(const DeviceExtSet& advertisedExts,
                 hasDependencies = instanceExts[InstanceExt::Surface];
                 break;
 
+            case DeviceExt::IncrementalPresent:
+                hasDependencies = HasDep(DeviceExt::Swapchain);
+                break;
+
             case DeviceExt::SamplerYCbCrConversion:
                 hasDependencies = HasDep(DeviceExt::Maintenance1) &&
                                   HasDep(DeviceExt::BindMemory2) &&
@@ -246,7 +255,9 @@ DeviceExtSet EnsureDependencies(const DeviceExtSet& advertisedExts,
                 break;
 
             case DeviceExt::DriverProperties:
+            case DeviceExt::MemoryBudget:
             case DeviceExt::ShaderFloat16Int8:
+            case DeviceExt::TimelineSemaphore:
                 hasDependencies = HasDep(DeviceExt::GetPhysicalDeviceProperties2);
                 break;
 
@@ -87,9 +87,11 @@ enum class DeviceExt {
     SamplerYCbCrConversion,
 
     // Promoted to 1.2
+    DrawIndirectCount,
     DriverProperties,
     ImageFormatList,
     ShaderFloat16Int8,
+    TimelineSemaphore,
 
     // Promoted to 1.3
     ShaderIntegerDotProduct,
@@ -105,7 +107,9 @@ enum class DeviceExt {
     // Others
     DepthClipEnable,
     ImageDrmFormatModifier,
+    MemoryBudget,
     Swapchain,
+    IncrementalPresent,
     SubgroupSizeControl,
 
     EnumCount,
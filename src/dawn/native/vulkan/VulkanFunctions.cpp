@@ -368,6 +368,57 @@ MaybeError VulkanFunctions::LoadDeviceProcs(VkDevice device, const VulkanDeviceI
         GET_DEVICE_PROC(QueuePresentKHR);
     }
 
+    if (deviceInfo.HasExt(DeviceExt::TimelineSemaphore)) {
+        // The extension may only be present because it was promoted in the device's
+        // apiVersion, in which case only the core entry points are guaranteed to exist, and
+        // conversely a pre-1.2 driver only guarantees the KHR-suffixed ones. Try the core
+        // names first and fall back to the KHR names.
+        GetSemaphoreCounterValue = AsVkFn<PFN_vkGetSemaphoreCounterValue>(
+            GetDeviceProcAddr(device, "vkGetSemaphoreCounterValue"));
+        if (GetSemaphoreCounterValue == nullptr) {
+            GetSemaphoreCounterValue = AsVkFn<PFN_vkGetSemaphoreCounterValueKHR>(
+                GetDeviceProcAddr(device, "vkGetSemaphoreCounterValueKHR"));
+        }
+        if (GetSemaphoreCounterValue == nullptr) {
+            return DAWN_INTERNAL_ERROR("Couldn't get proc vkGetSemaphoreCounterValue");
+        }
+
+        WaitSemaphores =
+            AsVkFn<PFN_vkWaitSemaphores>(GetDeviceProcAddr(device, "vkWaitSemaphores"));
+        if (WaitSemaphores == nullptr) {
+            WaitSemaphores =
+                AsVkFn<PFN_vkWaitSemaphoresKHR>(GetDeviceProcAddr(device, "vkWaitSemaphoresKHR"));
+        }
+        if (WaitSemaphores == nullptr) {
+            return DAWN_INTERNAL_ERROR("Couldn't get proc vkWaitSemaphores");
+        }
+    }
+
+    if (deviceInfo.HasExt(DeviceExt::DrawIndirectCount)) {
+        // As for the timeline semaphore entry points, the extension may only be present
+        // through promotion in the device's apiVersion, so try the core names first and fall
+        // back to the KHR names.
+        CmdDrawIndirectCount = AsVkFn<PFN_vkCmdDrawIndirectCount>(
+            GetDeviceProcAddr(device, "vkCmdDrawIndirectCount"));
+        if (CmdDrawIndirectCount == nullptr) {
+            CmdDrawIndirectCount = AsVkFn<PFN_vkCmdDrawIndirectCountKHR>(
+                GetDeviceProcAddr(device, "vkCmdDrawIndirectCountKHR"));
+        }
+        if (CmdDrawIndirectCount == nullptr) {
+            return DAWN_INTERNAL_ERROR("Couldn't get proc vkCmdDrawIndirectCount");
+        }
+
+        CmdDrawIndexedIndirectCount = AsVkFn<PFN_vkCmdDrawIndexedIndirectCount>(
+            GetDeviceProcAddr(device, "vkCmdDrawIndexedIndirectCount"));
+        if (CmdDrawIndexedIndirectCount == nullptr) {
+            CmdDrawIndexedIndirectCount = AsVkFn<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+                GetDeviceProcAddr(device, "vkCmdDrawIndexedIndirectCountKHR"));
+        }
+        if (CmdDrawIndexedIndirectCount == nullptr) {
+            return DAWN_INTERNAL_ERROR("Couldn't get proc vkCmdDrawIndexedIndirectCount");
+        }
+    }
+
     if (deviceInfo.HasExt(DeviceExt::GetMemoryRequirements2)) {
         GET_DEVICE_PROC(GetBufferMemoryRequirements2);
         GET_DEVICE_PROC(GetImageMemoryRequirements2);
@@ -311,6 +311,14 @@ struct VulkanFunctions {
     VkFn<PFN_vkImportSemaphoreFdKHR> ImportSemaphoreFdKHR = nullptr;
     VkFn<PFN_vkGetSemaphoreFdKHR> GetSemaphoreFdKHR = nullptr;
 
+    // VK_KHR_timeline_semaphore (or core for Vulkan 1.2+)
+    VkFn<PFN_vkGetSemaphoreCounterValue> GetSemaphoreCounterValue = nullptr;
+    VkFn<PFN_vkWaitSemaphores> WaitSemaphores = nullptr;
+
+    // VK_KHR_draw_indirect_count (or core for Vulkan 1.2+)
+    VkFn<PFN_vkCmdDrawIndirectCount> CmdDrawIndirectCount = nullptr;
+    VkFn<PFN_vkCmdDrawIndexedIndirectCount> CmdDrawIndexedIndirectCount = nullptr;
+
     // VK_KHR_get_memory_requirements2
     VkFn<PFN_vkGetBufferMemoryRequirements2KHR> GetBufferMemoryRequirements2 = nullptr;
     VkFn<PFN_vkGetImageMemoryRequirements2KHR> GetImageMemoryRequirements2 = nullptr;
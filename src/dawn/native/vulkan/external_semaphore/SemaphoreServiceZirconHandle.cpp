@@ -64,15 +64,10 @@ bool Service::Supported() {
 ResultOrError<VkSemaphore> Service::ImportSemaphore(ExternalSemaphoreHandle handle) {
     DAWN_INVALID_IF(handle == ZX_HANDLE_INVALID, "Importing a semaphore with an invalid handle.");
 
+    // Importing below replaces the payload of the handle, so a recycled semaphore from the
+    // device's pool works just as well as a freshly created one.
     VkSemaphore semaphore = VK_NULL_HANDLE;
-    VkSemaphoreCreateInfo info;
-    info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-    info.pNext = nullptr;
-    info.flags = 0;
-
-    DAWN_TRY(CheckVkSuccess(
-        mDevice->fn.CreateSemaphore(mDevice->GetVkDevice(), &info, nullptr, &*semaphore),
-        "vkCreateSemaphore"));
+    DAWN_TRY_ASSIGN(semaphore, mDevice->GetUnusedSemaphore());
 
     VkImportSemaphoreZirconHandleInfoFUCHSIA importSemaphoreHandleInfo;
     importSemaphoreHandleInfo.sType = VK_STRUCTURE_TYPE_IMPORT_SEMAPHORE_ZIRCON_HANDLE_INFO_FUCHSIA;
@@ -14,46 +14,85 @@
 
 #include "src/dawn/node/binding/AsyncRunner.h"
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
 
 namespace wgpu::binding {
 
+namespace {
+
+// Upper bound on the tick backoff. Keeps the idle cost of a long-running GPU job to a few dozen
+// wakeups per second while bounding the added completion latency.
+constexpr uint64_t kMaxTickDelayMs = 16;
+
+}  // namespace
+
 AsyncRunner::AsyncRunner(Napi::Env env, wgpu::Device device) : env_(env), device_(device) {}
 
 void AsyncRunner::Begin() {
     assert(count_ != std::numeric_limits<decltype(count_)>::max());
-    if (count_++ == 0) {
-        QueueTick();
-    }
+    count_++;
+    // New work usually completes quickly (or needs a Tick() to make progress at all), so drop
+    // any backoff and poll on the next loop iteration.
+    tick_delay_ms_ = 0;
+    QueueTick(0);
 }
 
 void AsyncRunner::End() {
     assert(count_ > 0);
     count_--;
+    // A task completed: more completions are likely imminent, so poll eagerly again.
+    completed_since_tick_ = true;
+    tick_delay_ms_ = 0;
 }
 
-void AsyncRunner::QueueTick() {
-    // TODO(crbug.com/dawn/1127): We probably want to reduce the frequency at which this gets
-    // called.
-    if (tick_queued_) {
+void AsyncRunner::ScheduleFlush() {
+    // The just-submitted work may complete before the loop goes idle, so tick as soon as
+    // possible instead of waiting out a backoff delay.
+    tick_delay_ms_ = 0;
+    if (count_ > 0) {
+        QueueTick(0);
+    }
+}
+
+void AsyncRunner::QueueTick(uint64_t delay_ms) {
+    if (tick_queued_ && delay_ms >= queued_tick_delay_ms_) {
         return;
     }
+    // Note: if an immediate tick is requested while a delayed one is already queued, the stale
+    // timeout callback still fires later. That results in at most one extra Tick(), which is
+    // harmless.
     tick_queued_ = true;
-    env_.Global()
-        .Get("setImmediate")
-        .As<Napi::Function>()
-        .Call({
-            // TODO(crbug.com/dawn/1127): Create once, reuse.
-            Napi::Function::New(env_,
-                                [this](const Napi::CallbackInfo&) {
-                                    tick_queued_ = false;
-                                    if (count_ > 0) {
-                                        device_.Tick();
-                                        QueueTick();
-                                    }
-                                }),
-        });
+    queued_tick_delay_ms_ = delay_ms;
+    // TODO(crbug.com/dawn/1127): Create once, reuse.
+    auto tick = Napi::Function::New(env_, [this](const Napi::CallbackInfo&) {
+        tick_queued_ = false;
+        if (count_ == 0) {
+            tick_delay_ms_ = 0;
+            return;
+        }
+        completed_since_tick_ = false;
+        device_.Tick();
+        if (completed_since_tick_) {
+            // Progress was made; keep polling every loop iteration.
+            tick_delay_ms_ = 0;
+        } else {
+            // Nothing completed; back off exponentially so waiting on a long GPU job doesn't
+            // spin the loop.
+            tick_delay_ms_ =
+                std::min(tick_delay_ms_ == 0 ? 1 : tick_delay_ms_ * 2, kMaxTickDelayMs);
+        }
+        if (count_ > 0) {
+            QueueTick(tick_delay_ms_);
+        }
+    });
+    if (delay_ms == 0) {
+        env_.Global().Get("setImmediate").As<Napi::Function>().Call({tick});
+    } else {
+        env_.Global().Get("setTimeout").As<Napi::Function>().Call(
+            {tick, Napi::Number::New(env_, static_cast<double>(delay_ms))});
+    }
 }
 
 }  // namespace wgpu::binding
@@ -25,28 +25,36 @@
 namespace wgpu::binding {
 
 // AsyncRunner is used to poll a wgpu::Device with calls to Tick() while there are asynchronous
-// tasks in flight.
+// tasks in flight. Polling is adaptive: a tick is scheduled for the next event loop iteration
+// while tasks keep completing, and backs off exponentially (up to a small cap) while nothing
+// completes, so waiting on a long GPU job does not spin the loop.
 class AsyncRunner {
   public:
     AsyncRunner(Napi::Env env, wgpu::Device device);
 
     // Begin() should be called when a new asynchronous task is started.
-    // If the number of executing asynchronous tasks transitions from 0 to 1, then a function
-    // will be scheduled on the main JavaScript thread to call wgpu::Device::Tick() whenever the
-    // thread is idle. This will be repeatedly called until the number of executing asynchronous
-    // tasks reaches 0 again.
+    // While the number of executing asynchronous tasks is non-zero, a function will be
+    // repeatedly scheduled on the main JavaScript thread to call wgpu::Device::Tick().
     void Begin();
 
     // End() should be called once the asynchronous task has finished.
     // Every call to Begin() should eventually result in a call to End().
     void End();
 
+    // ScheduleFlush() should be called after work is submitted to a queue. If asynchronous
+    // tasks are in flight, any tick backoff is reset and a tick is scheduled for the next loop
+    // iteration so their completions are observed promptly.
+    void ScheduleFlush();
+
   private:
-    void QueueTick();
+    void QueueTick(uint64_t delay_ms);
     Napi::Env env_;
     wgpu::Device const device_;
     uint64_t count_ = 0;
     bool tick_queued_ = false;
+    uint64_t queued_tick_delay_ms_ = 0;
+    uint64_t tick_delay_ms_ = 0;
+    bool completed_since_tick_ = false;
 };
 
 // AsyncTask is a RAII helper for calling AsyncRunner::Begin() on construction, and
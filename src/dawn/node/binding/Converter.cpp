@@ -24,10 +24,77 @@
 
 namespace wgpu::binding {
 
+// A fixed-size block that conversions are bump-allocated from. Retired slabs go to a
+// thread-local pool instead of the heap so that the next Converter on the thread reuses them.
+struct Converter::Slab {
+    static constexpr size_t kPayloadSize = 16384 - sizeof(Slab*) - sizeof(size_t);
+
+    Slab* next = nullptr;
+    size_t used = 0;
+    alignas(std::max_align_t) uint8_t payload[kPayloadSize];
+};
+
+namespace {
+
+// dawn.node runs all conversions on the JS thread, so the pool needs no lock. Capped so a
+// one-off descriptor burst does not pin memory forever.
+constexpr size_t kMaxPooledSlabs = 8;
+
+struct SlabPool {
+    std::vector<Converter::Slab*> slabs;
+    ~SlabPool() {
+        for (auto* slab : slabs) {
+            delete slab;
+        }
+    }
+};
+thread_local SlabPool slabPool;
+
+}  // namespace
+
+void* Converter::AllocateBytes(size_t size, size_t align) {
+    if (size > Slab::kPayloadSize) {
+        // operator new aligns to max_align_t, which covers every converted Dawn struct.
+        void* ptr = ::operator new(size);
+        overflow_.push_back(ptr);
+        return ptr;
+    }
+
+    size_t offset = slabs_ != nullptr ? (slabs_->used + align - 1) & ~(align - 1) : 0;
+    if (slabs_ == nullptr || offset + size > Slab::kPayloadSize) {
+        Slab* slab;
+        if (!slabPool.slabs.empty()) {
+            slab = slabPool.slabs.back();
+            slabPool.slabs.pop_back();
+            slab->used = 0;
+        } else {
+            slab = new Slab();
+        }
+        slab->next = slabs_;
+        slabs_ = slab;
+        offset = 0;
+    }
+
+    slabs_->used = offset + size;
+    return &slabs_->payload[offset];
+}
+
 Converter::~Converter() {
     for (auto& free : free_) {
         free();
     }
+    for (void* ptr : overflow_) {
+        ::operator delete(ptr);
+    }
+    while (slabs_ != nullptr) {
+        Slab* slab = slabs_;
+        slabs_ = slab->next;
+        if (slabPool.slabs.size() < kMaxPooledSlabs) {
+            slabPool.slabs.push_back(slab);
+        } else {
+            delete slab;
+        }
+    }
 }
 
 bool Converter::Convert(wgpu::Extent3D& out, const interop::GPUExtent3D& in) {
@@ -16,6 +16,7 @@
 #define SRC_DAWN_NODE_BINDING_CONVERTER_H_
 
 #include <functional>
+#include <new>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -66,6 +67,10 @@ using ImplOf = typename ImplOfTraits<T>::type;
 // As the Dawn C++ API uses raw C pointers for a number of its interfaces, Converter performs
 // heap allocations for conversions of vector or optional types. These pointers are
 // automatically freed when the Converter is destructed.
+//
+// Trivially destructible conversions are bump-allocated from slabs that are recycled between
+// Converters on the same thread, so the common one-Converter-per-call pattern performs no heap
+// allocations in steady state.
 class Converter {
   public:
     explicit Converter(Napi::Env e) : env(e) {}
@@ -398,14 +403,30 @@ class Converter {
     Napi::Env env;
 
     // Allocate() allocates and constructs an array of 'n' elements, and returns a pointer to
-    // the first element. The array is freed when the Converter is destructed.
+    // the first element. The array is valid until the Converter is destructed.
     template <typename T>
     T* Allocate(size_t n = 1) {
-        auto* ptr = new T[n]{};
-        free_.emplace_back([ptr] { delete[] ptr; });
-        return ptr;
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            // The Dawn descriptor structs all take this path, straight into the slab arena.
+            T* ptr = static_cast<T*>(AllocateBytes(sizeof(T) * n, alignof(T)));
+            for (size_t i = 0; i < n; i++) {
+                new (&ptr[i]) T{};
+            }
+            return ptr;
+        } else {
+            auto* ptr = new T[n]{};
+            free_.emplace_back([ptr] { delete[] ptr; });
+            return ptr;
+        }
     }
 
+    // Bump-allocates from the slab chain, pulling recycled slabs from a thread-local pool.
+    // Allocations larger than a slab get their own overflow block.
+    void* AllocateBytes(size_t size, size_t align);
+
+    struct Slab;
+    Slab* slabs_ = nullptr;
+    std::vector<void*> overflow_;
     std::vector<std::function<void()>> free_;
 };
 
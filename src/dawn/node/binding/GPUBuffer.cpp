@@ -134,6 +134,9 @@ interop::ArrayBuffer GPUBuffer::getMappedRange(Napi::Env env,
         Errors::OperationError(env).ThrowAsJavaScriptException();
         return {};
     }
+    // The returned ArrayBuffer is an external buffer wrapping the mapped memory directly:
+    // reads and writes through it are zero-copy. It is detached on unmap() / destroy() (see
+    // DetachMappings()), after which the mapped pointer is no longer reachable from JS.
     auto array_buffer = Napi::ArrayBuffer::New(env, ptr, s);
     // TODO(crbug.com/dawn/1135): Ownership here is the wrong way around.
     mapped_.emplace_back(Mapping{start, end, Napi::Persistent(array_buffer)});
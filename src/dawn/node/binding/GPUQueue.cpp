@@ -44,6 +44,7 @@ void GPUQueue::submit(Napi::Env env,
         return;
     }
     queue_.Submit(bufs_size, bufs.data());
+    async_->ScheduleFlush();
 }
 
 interop::Promise<void> GPUQueue::onSubmittedWorkDone(Napi::Env env) {
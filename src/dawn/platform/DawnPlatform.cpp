@@ -14,6 +14,7 @@
 
 #include "dawn/platform/DawnPlatform.h"
 
+#include <atomic>
 #include <memory>
 
 #include "dawn/common/Assert.h"
@@ -21,10 +22,62 @@
 
 namespace dawn::platform {
 
+namespace {
+
+constexpr uint32_t kNumMetricCounters = static_cast<uint32_t>(MetricCounter::Count);
+
+// Each shard keeps its counters on dedicated cache lines so concurrent threads incrementing
+// the same counter do not bounce a line between cores. Shards are assigned to threads
+// round-robin on first use.
+constexpr size_t kNumMetricShards = 8;
+
+struct alignas(64) MetricShard {
+    std::atomic<uint64_t> counters[kNumMetricCounters] = {};
+};
+
+MetricShard sMetricShards[kNumMetricShards];
+
+size_t GetMetricShardIndex() {
+    static std::atomic<size_t> sNextShard{0};
+    thread_local size_t sShardIndex =
+        sNextShard.fetch_add(1, std::memory_order_relaxed) % kNumMetricShards;
+    return sShardIndex;
+}
+
+}  // namespace
+
+void AddMetric(MetricCounter counter, uint64_t value) {
+    ASSERT(counter < MetricCounter::Count);
+    sMetricShards[GetMetricShardIndex()].counters[static_cast<uint32_t>(counter)].fetch_add(
+        value, std::memory_order_relaxed);
+}
+
+MetricsSnapshot SnapshotMetrics() {
+    MetricsSnapshot snapshot;
+    for (const MetricShard& shard : sMetricShards) {
+        for (uint32_t i = 0; i < kNumMetricCounters; ++i) {
+            snapshot.counters[i] += shard.counters[i].load(std::memory_order_relaxed);
+        }
+    }
+    return snapshot;
+}
+
+void ResetMetricsForTesting() {
+    for (MetricShard& shard : sMetricShards) {
+        for (uint32_t i = 0; i < kNumMetricCounters; ++i) {
+            shard.counters[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
 CachingInterface::CachingInterface() = default;
 
 CachingInterface::~CachingInterface() = default;
 
+bool CachingInterface::LoadDataFileRegion(const void*, size_t, FileRegion*) {
+    return false;
+}
+
 Platform::Platform() = default;
 
 Platform::~Platform() = default;
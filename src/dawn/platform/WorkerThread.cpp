@@ -14,9 +14,8 @@
 
 #include "dawn/platform/WorkerThread.h"
 
-#include <condition_variable>
-#include <functional>
-#include <thread>
+#include <algorithm>
+#include <utility>
 
 #include "dawn/common/Assert.h"
 
@@ -70,6 +69,23 @@ class AsyncWaitableEvent final : public dawn::platform::WaitableEvent {
 
 namespace dawn::platform {
 
+AsyncWorkerThreadPool::AsyncWorkerThreadPool(uint32_t maxThreads)
+    : mMaxThreads(maxThreads > 0 ? maxThreads
+                                 : std::max(1u, std::thread::hardware_concurrency())) {}
+
+AsyncWorkerThreadPool::~AsyncWorkerThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsShuttingDown = true;
+    }
+    // Workers drain the remaining queued tasks before exiting, so every returned WaitableEvent
+    // still completes.
+    mCondition.notify_all();
+    for (std::thread& thread : mThreads) {
+        thread.join();
+    }
+}
+
 std::unique_ptr<dawn::platform::WaitableEvent> AsyncWorkerThreadPool::PostWorkerTask(
     dawn::platform::PostWorkerTaskCallback callback,
     void* userdata) {
@@ -81,10 +97,41 @@ std::unique_ptr<dawn::platform::WaitableEvent> AsyncWorkerThreadPool::PostWorker
         waitableEventImpl->MarkAsComplete();
     };
 
-    std::thread thread(doTask);
-    thread.detach();
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ASSERT(!mIsShuttingDown);
+        mPendingTasks.push(std::move(doTask));
+
+        // Start another worker only when no idle one can pick the task up; threads are kept for
+        // the lifetime of the pool once started.
+        if (mIdleThreads == 0 && mThreads.size() < mMaxThreads) {
+            mThreads.emplace_back(&AsyncWorkerThreadPool::ThreadLoop, this);
+        }
+    }
+    mCondition.notify_one();
 
     return waitableEvent;
 }
 
+void AsyncWorkerThreadPool::ThreadLoop() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mIdleThreads++;
+        mCondition.wait(lock, [this] { return mIsShuttingDown || !mPendingTasks.empty(); });
+        mIdleThreads--;
+
+        if (mPendingTasks.empty()) {
+            ASSERT(mIsShuttingDown);
+            return;
+        }
+
+        std::function<void()> task = std::move(mPendingTasks.front());
+        mPendingTasks.pop();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
 }  // namespace dawn::platform
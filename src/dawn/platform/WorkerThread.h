@@ -15,18 +15,44 @@
 #ifndef SRC_DAWN_PLATFORM_WORKERTHREAD_H_
 #define SRC_DAWN_PLATFORM_WORKERTHREAD_H_
 
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
 
 #include "dawn/common/NonCopyable.h"
 #include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::platform {
 
+// Fixed-size thread pool used as the default WorkerTaskPool when the embedder doesn't provide
+// one. Threads are started on demand up to a cap so that applications which never post async
+// work pay nothing, and they are joined on destruction after the queued tasks have drained.
 class AsyncWorkerThreadPool : public dawn::platform::WorkerTaskPool, public NonCopyable {
   public:
+    // A maxThreads of 0 selects the hardware concurrency.
+    explicit AsyncWorkerThreadPool(uint32_t maxThreads = 0);
+    ~AsyncWorkerThreadPool() override;
+
     std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTask(
         dawn::platform::PostWorkerTaskCallback callback,
         void* userdata) override;
+
+  private:
+    void ThreadLoop();
+
+    const uint32_t mMaxThreads;
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::queue<std::function<void()>> mPendingTasks;
+    std::vector<std::thread> mThreads;
+    uint32_t mIdleThreads = 0;
+    bool mIsShuttingDown = false;
 };
 
 }  // namespace dawn::platform
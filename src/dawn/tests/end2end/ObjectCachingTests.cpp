@@ -360,6 +360,31 @@ TEST_P(ObjectCachingTest, SamplerDeduplication) {
     EXPECT_EQ(sampler.Get() == sameSampler.Get(), !UsesWire());
 }
 
+// Test that TextureViews are correctly deduplicated per texture.
+TEST_P(ObjectCachingTest, TextureViewDeduplication) {
+    wgpu::TextureDescriptor textureDesc;
+    textureDesc.size = {4, 4, 1};
+    textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    textureDesc.usage = wgpu::TextureUsage::TextureBinding;
+    textureDesc.mipLevelCount = 2;
+    wgpu::Texture texture = device.CreateTexture(&textureDesc);
+    wgpu::Texture otherTexture = device.CreateTexture(&textureDesc);
+
+    wgpu::TextureView view = texture.CreateView();
+    wgpu::TextureView sameView = texture.CreateView();
+
+    wgpu::TextureViewDescriptor otherViewDesc;
+    otherViewDesc.baseMipLevel = 1;
+    wgpu::TextureView otherView = texture.CreateView(&otherViewDesc);
+
+    // The cache is per texture: the same descriptor on another texture is another view.
+    wgpu::TextureView otherTextureView = otherTexture.CreateView();
+
+    EXPECT_NE(view.Get(), otherView.Get());
+    EXPECT_NE(view.Get(), otherTextureView.Get());
+    EXPECT_EQ(view.Get() == sameView.Get(), !UsesWire());
+}
+
 DAWN_INSTANTIATE_TEST(ObjectCachingTest,
                       D3D12Backend(),
                       MetalBackend(),
@@ -0,0 +1,95 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+constexpr unsigned int kNumIterations = 1000;
+
+}  // namespace
+
+// Test the performance of creating, binding, and destroying transient bind groups. Engines that
+// build bind groups per draw or per frame stress the bind group allocator and the backend
+// descriptor allocators; each iteration creates a fresh bind group, binds it for a minimal
+// dispatch, and lets it die when the command buffer completes.
+class BindGroupChurnPerf : public DawnPerfTest {
+  public:
+    BindGroupChurnPerf() : DawnPerfTest(kNumIterations, 1) {}
+    ~BindGroupChurnPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTest::SetUp();
+
+        wgpu::BufferDescriptor uniformDesc = {};
+        uniformDesc.size = 4 * sizeof(float);
+        uniformDesc.usage = wgpu::BufferUsage::Uniform;
+        mUniformBuffer = device.CreateBuffer(&uniformDesc);
+
+        wgpu::BufferDescriptor storageDesc = {};
+        storageDesc.size = 4 * sizeof(float);
+        storageDesc.usage = wgpu::BufferUsage::Storage;
+        mStorageBuffer = device.CreateBuffer(&storageDesc);
+
+        wgpu::ComputePipelineDescriptor pipelineDesc = {};
+        pipelineDesc.compute.module = utils::CreateShaderModule(device, R"(
+            struct Params {
+                value : vec4<f32>
+            }
+            @group(0) @binding(0) var<uniform> params : Params;
+            @group(0) @binding(1) var<storage, read_write> output : Params;
+
+            @compute @workgroup_size(1) fn main() {
+                output.value = params.value;
+            }
+        )");
+        pipelineDesc.compute.entryPoint = "main";
+        mPipeline = device.CreateComputePipeline(&pipelineDesc);
+    }
+
+  private:
+    void Step() override {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetPipeline(mPipeline);
+
+        for (unsigned int i = 0; i < kNumIterations; ++i) {
+            wgpu::BindGroup bindGroup =
+                utils::MakeBindGroup(device, mPipeline.GetBindGroupLayout(0),
+                                     {{0, mUniformBuffer}, {1, mStorageBuffer}});
+            pass.SetBindGroup(0, bindGroup);
+            pass.DispatchWorkgroups(1);
+        }
+
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    wgpu::Buffer mUniformBuffer;
+    wgpu::Buffer mStorageBuffer;
+    wgpu::ComputePipeline mPipeline;
+};
+
+TEST_P(BindGroupChurnPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(BindGroupChurnPerf,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      VulkanBackend());
@@ -0,0 +1,91 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sstream>
+#include <string>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+constexpr unsigned int kNumPipelines = 16;
+
+}  // namespace
+
+// Test the throughput of asynchronous compute pipeline compilation. Each step kicks off a batch
+// of CreateComputePipelineAsync calls and then ticks the device until every callback has fired,
+// so the measurement covers shader translation and backend compilation, including any worker
+// thread parallelism. Every shader is unique to defeat the shader module and pipeline caches;
+// otherwise later steps would only measure cache lookups.
+class CreatePipelineAsyncPerf : public DawnPerfTest {
+  public:
+    CreatePipelineAsyncPerf() : DawnPerfTest(kNumPipelines, 1) {}
+    ~CreatePipelineAsyncPerf() override = default;
+
+  private:
+    std::string GenerateUniqueShader() {
+        std::ostringstream ostream;
+        ostream << R"(
+            @group(0) @binding(0) var<storage, read_write> output : array<f32>;
+
+            @compute @workgroup_size(64) fn main(@builtin(global_invocation_id) id : vec3<u32>) {
+                output[id.x] = f32(id.x) + )"
+                << mNumPipelinesCreated << R"(.0;
+            }
+        )";
+        return ostream.str();
+    }
+
+    static void PipelineCreatedCallback(WGPUCreatePipelineAsyncStatus status,
+                                        WGPUComputePipeline pipeline,
+                                        const char* message,
+                                        void* userdata) {
+        CreatePipelineAsyncPerf* test = static_cast<CreatePipelineAsyncPerf*>(userdata);
+        EXPECT_EQ(WGPUCreatePipelineAsyncStatus::WGPUCreatePipelineAsyncStatus_Success, status);
+        // The pipeline is dropped immediately; only the compilation time is interesting.
+        wgpu::ComputePipeline::Acquire(pipeline);
+        test->mNumPipelinesPending--;
+    }
+
+    void Step() override {
+        for (unsigned int i = 0; i < kNumPipelines; ++i) {
+            wgpu::ComputePipelineDescriptor pipelineDesc = {};
+            std::string shader = GenerateUniqueShader();
+            pipelineDesc.compute.module = utils::CreateShaderModule(device, shader.c_str());
+            pipelineDesc.compute.entryPoint = "main";
+            mNumPipelinesCreated++;
+            mNumPipelinesPending++;
+            device.CreateComputePipelineAsync(&pipelineDesc, PipelineCreatedCallback, this);
+        }
+
+        while (mNumPipelinesPending > 0) {
+            WaitABit();
+        }
+    }
+
+    uint64_t mNumPipelinesCreated = 0;
+    unsigned int mNumPipelinesPending = 0;
+};
+
+TEST_P(CreatePipelineAsyncPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(CreatePipelineAsyncPerf,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      VulkanBackend());
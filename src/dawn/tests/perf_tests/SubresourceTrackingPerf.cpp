@@ -147,3 +147,113 @@ DAWN_INSTANTIATE_TEST_P(SubresourceTrackingPerf,
                         {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
                         {1, 4, 16, 256},
                         {2, 3, 8});
+
+// Test the performance of barrier generation when the subresources of a texture keep divergent
+// states. Every step transitions half of the array layers to CopyDst with small copies and then
+// samples the whole texture in a render pass, which forces the backends to merge the divergent
+// per-subresource states back together with individual barriers instead of one whole-texture
+// barrier. The half that diverges alternates between steps so the states never settle.
+class DivergentSubresourceBarrierPerf : public DawnPerfTestWithParams<SubresourceTrackingParams> {
+  public:
+    static constexpr unsigned int kNumIterations = 50;
+
+    DivergentSubresourceBarrierPerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
+    ~DivergentSubresourceBarrierPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTestWithParams<SubresourceTrackingParams>::SetUp();
+        const SubresourceTrackingParams& params = GetParam();
+
+        wgpu::TextureDescriptor materialDesc;
+        materialDesc.dimension = wgpu::TextureDimension::e2D;
+        materialDesc.size = {1u << (params.mipLevelCount - 1), 1u << (params.mipLevelCount - 1),
+                             params.arrayLayerCount};
+        materialDesc.mipLevelCount = params.mipLevelCount;
+        materialDesc.usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst;
+        materialDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        mMaterials = device.CreateTexture(&materialDesc);
+
+        wgpu::TextureDescriptor uploadTexDesc = materialDesc;
+        uploadTexDesc.size.depthOrArrayLayers = 1;
+        uploadTexDesc.mipLevelCount = 1;
+        uploadTexDesc.usage = wgpu::TextureUsage::CopySrc;
+        mUploadTexture = device.CreateTexture(&uploadTexDesc);
+
+        wgpu::TextureDescriptor rtDesc;
+        rtDesc.size = {1, 1, 1};
+        rtDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        rtDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        mRenderTarget = device.CreateTexture(&rtDesc).CreateView();
+
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+            @vertex fn main() -> @builtin(position) vec4<f32> {
+                return vec4<f32>(1.0, 0.0, 0.0, 1.0);
+            }
+        )");
+        pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            @group(0) @binding(0) var materials : texture_2d_array<f32>;
+            @fragment fn main() -> @location(0) vec4<f32> {
+                let foo : vec2<i32> = textureDimensions(materials);
+                return vec4<f32>(1.0, 0.0, 0.0, 1.0);
+            }
+        )");
+        mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        mBindGroup = utils::MakeBindGroup(device, mPipeline.GetBindGroupLayout(0),
+                                          {{0, mMaterials.CreateView()}});
+    }
+
+  private:
+    void Step() override {
+        const SubresourceTrackingParams& params = GetParam();
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+
+        // Make every other layer diverge to CopyDst while the rest stay sampleable.
+        for (uint32_t layer = mFrameParity; layer < params.arrayLayerCount; layer += 2) {
+            wgpu::ImageCopyTexture sourceView;
+            sourceView.texture = mUploadTexture;
+
+            wgpu::ImageCopyTexture destView;
+            destView.texture = mMaterials;
+            destView.origin.z = layer;
+
+            wgpu::Extent3D copySize = {1u << (params.mipLevelCount - 1),
+                                       1u << (params.mipLevelCount - 1), 1};
+
+            encoder.CopyTextureToTexture(&sourceView, &destView, &copySize);
+        }
+        mFrameParity ^= 1;
+
+        // Sampling the whole texture forces all the diverged subresources back to a common
+        // state.
+        {
+            utils::ComboRenderPassDescriptor renderPass({mRenderTarget});
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+            pass.SetPipeline(mPipeline);
+            pass.SetBindGroup(0, mBindGroup);
+            pass.Draw(3);
+            pass.End();
+        }
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    wgpu::Texture mUploadTexture;
+    wgpu::Texture mMaterials;
+    wgpu::TextureView mRenderTarget;
+    wgpu::RenderPipeline mPipeline;
+    wgpu::BindGroup mBindGroup;
+    uint32_t mFrameParity = 0;
+};
+
+TEST_P(DivergentSubresourceBarrierPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(DivergentSubresourceBarrierPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {16, 64, 256},
+                        {1, 3});
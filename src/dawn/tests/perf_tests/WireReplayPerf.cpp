@@ -0,0 +1,194 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/utils/Timer.h"
+#include "dawn/wire/WireServer.h"
+
+namespace {
+
+// Swallows return traffic; replay has no client to deliver it to.
+class DiscardingSerializer : public dawn::wire::CommandSerializer {
+  public:
+    size_t GetMaximumAllocationSize() const override {
+        return 1024 * 1024;
+    }
+    void* GetCmdSpace(size_t size) override {
+        if (size > mScratch.size()) {
+            mScratch.resize(size);
+        }
+        return mScratch.data();
+    }
+    bool Flush() override {
+        return true;
+    }
+
+  private:
+    std::vector<char> mScratch;
+};
+
+}  // namespace
+
+// Replays a wire command stream captured with WireServer::StartCapture against the test's
+// backend at full speed. The capture to replay is given through the DAWN_WIRE_REPLAY_CAPTURE
+// environment variable; without it the test is skipped. The capture must have been taken from a
+// connection whose device was injected as id 1 generation 0 (what a single-device embedder
+// gets) and that used the inline memory transfer service.
+//
+// Each step replays the whole capture through a fresh WireServer. Commands are fed to the
+// server one at a time along the boundaries recorded in their headers, so in addition to the
+// framework's overall step timing the test reports time and count per wire command id. Ids
+// index the command enum generated from dawn_wire.json in declaration order; they are stable
+// for a given tree, which is what regression comparison needs.
+class WireReplayPerf : public DawnPerfTest {
+  public:
+    WireReplayPerf() : DawnPerfTest(1, 1) {}
+    ~WireReplayPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTest::SetUp();
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        const char* capturePath = getenv("DAWN_WIRE_REPLAY_CAPTURE");
+        DAWN_TEST_UNSUPPORTED_IF(capturePath == nullptr);
+
+        std::ifstream file(capturePath, std::ios::binary);
+        ASSERT_TRUE(file.is_open()) << "Cannot open capture " << capturePath;
+
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        ASSERT_EQ(magic, dawn::wire::kWireCaptureMagic);
+        ASSERT_EQ(version, dawn::wire::kWireCaptureVersion);
+
+        while (true) {
+            uint64_t bufferSize = 0;
+            file.read(reinterpret_cast<char*>(&bufferSize), sizeof(bufferSize));
+            if (!file) {
+                break;
+            }
+            std::vector<char> buffer(bufferSize);
+            file.read(buffer.data(), static_cast<std::streamsize>(bufferSize));
+            ASSERT_TRUE(static_cast<bool>(file)) << "Truncated capture " << capturePath;
+            mBuffers.push_back(std::move(buffer));
+        }
+        ASSERT_FALSE(mBuffers.empty());
+
+        mTimer.reset(utils::CreateTimer());
+    }
+
+    void ReportPerCommandResults() {
+        for (const auto& [commandId, timing] : mCommandTimings) {
+            std::ostringstream trace;
+            trace << "cmd_" << commandId;
+            PrintResult(trace.str() + "_count", static_cast<unsigned int>(timing.count),
+                        "commands", false);
+            PrintResult(trace.str(), timing.seconds * 1e6, "us", false);
+        }
+    }
+
+  private:
+    struct CommandTiming {
+        uint64_t count = 0;
+        double seconds = 0;
+    };
+
+    void Step() override {
+        DiscardingSerializer serializer;
+        DawnProcTable procs = dawn::native::GetProcs();
+        dawn::wire::WireServerDescriptor serverDesc = {};
+        serverDesc.procs = &procs;
+        serverDesc.serializer = &serializer;
+
+        // A fresh server per replay so object ids allocated by the capture start from a clean
+        // table every time.
+        dawn::wire::WireServer server(serverDesc);
+        ASSERT_TRUE(server.InjectDevice(device.Get(), 1, 0));
+
+        // Bytes of a command that started in a previous buffer and its id; the server
+        // accumulates the partial data itself, this only tracks where the next header starts.
+        size_t pendingBytes = 0;
+        uint32_t pendingId = 0;
+
+        for (const std::vector<char>& buffer : mBuffers) {
+            size_t offset = 0;
+            while (offset < buffer.size()) {
+                uint32_t commandId;
+                uint64_t commandSize;
+                if (pendingBytes > 0) {
+                    commandId = pendingId;
+                    commandSize = pendingBytes;
+                } else {
+                    // Each command starts with a uint64_t size then a uint32_t command id
+                    // (static_asserted in the generated wire code).
+                    ASSERT_GE(buffer.size() - offset, sizeof(uint64_t) + sizeof(uint32_t));
+                    memcpy(&commandSize, buffer.data() + offset, sizeof(commandSize));
+                    memcpy(&commandId, buffer.data() + offset + sizeof(uint64_t),
+                           sizeof(commandId));
+                    ASSERT_GT(commandSize, 0u);
+                }
+
+                size_t slice =
+                    static_cast<size_t>(std::min<uint64_t>(commandSize, buffer.size() - offset));
+
+                double start = mTimer->GetAbsoluteTime();
+                const volatile char* result = server.HandleCommands(buffer.data() + offset, slice);
+                double elapsed = mTimer->GetAbsoluteTime() - start;
+                ASSERT_NE(result, nullptr);
+
+                CommandTiming& timing = mCommandTimings[commandId];
+                timing.seconds += elapsed;
+                if (pendingBytes == 0) {
+                    timing.count++;
+                }
+
+                if (slice < commandSize) {
+                    pendingBytes = static_cast<size_t>(commandSize) - slice;
+                    pendingId = commandId;
+                } else {
+                    pendingBytes = 0;
+                }
+                offset += slice;
+            }
+        }
+        ASSERT_EQ(pendingBytes, 0u);
+    }
+
+    std::vector<std::vector<char>> mBuffers;
+    std::map<uint32_t, CommandTiming> mCommandTimings;
+    std::unique_ptr<utils::Timer> mTimer;
+};
+
+TEST_P(WireReplayPerf, Run) {
+    RunTest();
+    ReportPerCommandResults();
+}
+
+DAWN_INSTANTIATE_TEST(WireReplayPerf,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      VulkanBackend());
@@ -0,0 +1,112 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace {
+
+constexpr unsigned int kNumDraws = 2000;
+constexpr uint32_t kUniformSize = 256;
+
+}  // namespace
+
+// Test the serialize/deserialize throughput of the wire on dense command traffic. Each step
+// records a render pass with one bind group switch and one draw per iteration through the test's
+// WireHelper, so every client command is serialized, flushed, and deserialized by the wire server
+// before it reaches the backend. The test only runs with the wire; without it there is nothing to
+// measure.
+class WireRoundTripPerf : public DawnPerfTest {
+  public:
+    WireRoundTripPerf() : DawnPerfTest(kNumDraws, 1) {}
+    ~WireRoundTripPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTest::SetUp();
+        DAWN_TEST_UNSUPPORTED_IF(!UsesWire());
+
+        wgpu::TextureDescriptor colorDesc = {};
+        colorDesc.size = {1, 1, 1};
+        colorDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        colorDesc.usage = wgpu::TextureUsage::RenderAttachment;
+        mColorAttachment = device.CreateTexture(&colorDesc).CreateView();
+
+        wgpu::BufferDescriptor uniformDesc = {};
+        uniformDesc.size = kUniformSize;
+        uniformDesc.usage = wgpu::BufferUsage::Uniform;
+        mUniformBuffer = device.CreateBuffer(&uniformDesc);
+
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+            @vertex fn main() -> @builtin(position) vec4<f32> {
+                return vec4<f32>(0.0, 0.0, 0.0, 1.0);
+            }
+        )");
+        pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            struct Params {
+                color : vec4<f32>
+            }
+            @group(0) @binding(0) var<uniform> params : Params;
+
+            @fragment fn main() -> @location(0) vec4<f32> {
+                return params.color;
+            }
+        )");
+        pipelineDesc.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
+        mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+        mBindGroup = utils::MakeBindGroup(device, mPipeline.GetBindGroupLayout(0),
+                                          {{0, mUniformBuffer, 0, kUniformSize}});
+    }
+
+  private:
+    void Step() override {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+
+        utils::ComboRenderPassDescriptor renderPass({mColorAttachment});
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(mPipeline);
+
+        for (unsigned int i = 0; i < kNumDraws; ++i) {
+            pass.SetBindGroup(0, mBindGroup);
+            pass.Draw(1);
+        }
+
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+
+        // Push the serialized commands through the wire server.
+        FlushWire();
+    }
+
+    wgpu::TextureView mColorAttachment;
+    wgpu::Buffer mUniformBuffer;
+    wgpu::BindGroup mBindGroup;
+    wgpu::RenderPipeline mPipeline;
+};
+
+TEST_P(WireRoundTripPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(WireRoundTripPerf,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      VulkanBackend());
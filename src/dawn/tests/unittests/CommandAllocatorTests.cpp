@@ -500,4 +500,101 @@ TEST(CommandAllocator, AcquireCommandBlocks) {
     iterator.MakeEmptyAsDataWasDestroyed();
 }
 
+// Test allocating a command with an inline trailing payload and reading it back.
+TEST(CommandAllocator, TrailingData) {
+    CommandAllocator allocator;
+
+    uint8_t mySize = 8;
+    uint8_t myOffset = 3;
+    uint32_t myValues[5] = {6, 42, 0xFFFFFFFF, 0, 54};
+
+    {
+        uint32_t* values = nullptr;
+        CommandPushConstants* pushConstants =
+            allocator.AllocateWithTrailingData<CommandPushConstants>(CommandType::PushConstants, 5,
+                                                                     &values);
+        pushConstants->size = mySize;
+        pushConstants->offset = myOffset;
+        for (size_t i = 0; i < 5; i++) {
+            values[i] = myValues[i];
+        }
+
+        // A trailing count of 0 degenerates to a plain command allocation.
+        uint32_t* noValues = nullptr;
+        CommandDraw* draw =
+            allocator.AllocateWithTrailingData<CommandDraw>(CommandType::Draw, 0, &noValues);
+        ASSERT_EQ(noValues, nullptr);
+        draw->first = 42;
+        draw->count = 16;
+    }
+
+    {
+        CommandIterator iterator(std::move(allocator));
+        CommandType type;
+
+        bool hasNext = iterator.NextCommandId(&type);
+        ASSERT_TRUE(hasNext);
+        ASSERT_EQ(type, CommandType::PushConstants);
+
+        CommandPushConstants* pushConstants = iterator.NextCommand<CommandPushConstants>();
+        ASSERT_EQ(pushConstants->size, mySize);
+        ASSERT_EQ(pushConstants->offset, myOffset);
+
+        uint32_t* values = iterator.NextTrailingData<uint32_t>(5);
+        for (size_t i = 0; i < 5; i++) {
+            ASSERT_EQ(values[i], myValues[i]);
+        }
+
+        hasNext = iterator.NextCommandId(&type);
+        ASSERT_TRUE(hasNext);
+        ASSERT_EQ(type, CommandType::Draw);
+
+        CommandDraw* draw = iterator.NextCommand<CommandDraw>();
+        ASSERT_EQ(draw->first, 42u);
+        ASSERT_EQ(draw->count, 16u);
+
+        hasNext = iterator.NextCommandId(&type);
+        ASSERT_FALSE(hasNext);
+
+        iterator.MakeEmptyAsDataWasDestroyed();
+    }
+}
+
+// Test that the allocation stats count command structs and payloads, and reset with the
+// allocator.
+TEST(CommandAllocator, AllocationStats) {
+    CommandAllocator allocator;
+    ASSERT_EQ(allocator.GetAllocatedBytes(), 0u);
+    ASSERT_EQ(allocator.GetAllocatedCommandCount(), 0u);
+
+    allocator.Allocate<CommandDraw>(CommandType::Draw);
+    ASSERT_EQ(allocator.GetAllocatedBytes(), sizeof(CommandDraw));
+    ASSERT_EQ(allocator.GetAllocatedCommandCount(), 1u);
+
+    // Secondary data allocations count toward bytes but not toward the command count.
+    allocator.AllocateData<uint32_t>(5);
+    ASSERT_EQ(allocator.GetAllocatedBytes(), sizeof(CommandDraw) + 5 * sizeof(uint32_t));
+    ASSERT_EQ(allocator.GetAllocatedCommandCount(), 1u);
+
+    // Inline trailing payloads count as a single command.
+    uint32_t* values = nullptr;
+    allocator.AllocateWithTrailingData<CommandPushConstants>(CommandType::PushConstants, 5,
+                                                             &values);
+    ASSERT_EQ(allocator.GetAllocatedBytes(), sizeof(CommandDraw) + 5 * sizeof(uint32_t) +
+                                                 Align(sizeof(CommandPushConstants),
+                                                       alignof(uint32_t)) +
+                                                 5 * sizeof(uint32_t));
+    ASSERT_EQ(allocator.GetAllocatedCommandCount(), 2u);
+
+    // The stats follow the allocator on move and reset with it.
+    CommandAllocator moved = std::move(allocator);
+    ASSERT_EQ(allocator.GetAllocatedBytes(), 0u);
+    ASSERT_EQ(allocator.GetAllocatedCommandCount(), 0u);
+    ASSERT_EQ(moved.GetAllocatedCommandCount(), 2u);
+
+    moved.Reset();
+    ASSERT_EQ(moved.GetAllocatedBytes(), 0u);
+    ASSERT_EQ(moved.GetAllocatedCommandCount(), 0u);
+}
+
 }  // namespace dawn::native
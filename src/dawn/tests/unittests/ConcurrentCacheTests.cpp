@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "dawn/common/ConcurrentCache.h"
 #include "dawn/native/AsyncTask.h"
@@ -108,3 +109,26 @@ TEST_F(ConcurrentCacheTest, EraseAfterInsertion) {
     ASSERT_TRUE(insertOutput.second);
     ASSERT_EQ(1u, erasedObjectCount);
 }
+
+// Test that objects with different hashes (landing in different shards of the cache) can be
+// inserted and found concurrently.
+TEST_F(ConcurrentCacheTest, InsertDifferentObjectsAtSameTime) {
+    static constexpr size_t kObjectCount = 64;
+    std::vector<std::unique_ptr<SimpleCachedObject>> objects;
+    for (size_t i = 0; i < kObjectCount; ++i) {
+        objects.push_back(std::make_unique<SimpleCachedObject>(i));
+    }
+
+    ConcurrentCache<SimpleCachedObject>* cachePtr = &mCache;
+    for (auto& object : objects) {
+        SimpleCachedObject* objectPtr = object.get();
+        mTaskManager.PostTask(dawn::native::AsyncTask(
+            [cachePtr, objectPtr] { cachePtr->Insert(objectPtr); }));
+    }
+
+    mTaskManager.WaitAllPendingTasks();
+
+    for (auto& object : objects) {
+        ASSERT_EQ(object.get(), cachePtr->Find(object.get()));
+    }
+}
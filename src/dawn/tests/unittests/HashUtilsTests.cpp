@@ -0,0 +1,45 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <vector>
+
+#include "dawn/common/HashUtils.h"
+#include "gtest/gtest.h"
+
+// Test that HashBytes only depends on the bytes, not on the buffer they live in.
+TEST(HashUtilsTests, HashBytesEqualContent) {
+    const char data[] = "some descriptor contents to hash";
+    std::vector<char> copy(data, data + sizeof(data));
+    ASSERT_EQ(HashBytes(data, sizeof(data)), HashBytes(copy.data(), copy.size()));
+}
+
+// Test that HashBytes distinguishes contents for every size around the word-sized chunking,
+// including the byte-at-a-time tail.
+TEST(HashUtilsTests, HashBytesTailSensitivity) {
+    for (size_t size = 1; size <= 2 * sizeof(uint64_t) + 1; ++size) {
+        std::vector<uint8_t> a(size, 0x3C);
+        std::vector<uint8_t> b = a;
+        // Flip a bit in the last byte so only the tail differs.
+        b[size - 1] ^= 1;
+        EXPECT_NE(HashBytes(a.data(), size), HashBytes(b.data(), size)) << "size " << size;
+    }
+}
+
+// Test that a range doesn't hash like its zero-padded prefix.
+TEST(HashUtilsTests, HashBytesLengthSensitivity) {
+    std::vector<uint8_t> data(16, 0);
+    EXPECT_NE(HashBytes(data.data(), 8), HashBytes(data.data(), 16));
+    EXPECT_NE(HashBytes(data.data(), 0), HashBytes(data.data(), 1));
+}
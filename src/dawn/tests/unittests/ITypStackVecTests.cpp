@@ -0,0 +1,76 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/common/TypedInteger.h"
+#include "dawn/common/ityp_stack_vec.h"
+#include "gtest/gtest.h"
+
+class ITypStackVecTest : public testing::Test {
+  protected:
+    using Key = TypedInteger<struct KeyT, uint32_t>;
+    using Val = TypedInteger<struct ValT, uint32_t>;
+
+    static constexpr size_t kStaticCapacity = 4;
+
+    using StackVec = ityp::stack_vec<Key, Val, kStaticCapacity>;
+};
+
+// Test creation and initialization of the stack_vec.
+TEST_F(ITypStackVecTest, Creation) {
+    // Default constructor initializes to empty
+    {
+        StackVec vec;
+        ASSERT_EQ(vec.size(), Key(0));
+    }
+
+    // Size constructor initializes contents to 0
+    {
+        StackVec vec(Key(3));
+        ASSERT_EQ(vec.size(), Key(3));
+
+        for (Key i(0); i < Key(3); ++i) {
+            ASSERT_EQ(vec[i], Val(0));
+        }
+    }
+}
+
+// Test pushing values, including past the inline capacity.
+TEST_F(ITypStackVecTest, PushBack) {
+    StackVec vec;
+
+    // Push within the inline capacity, then beyond it to spill to the heap.
+    for (uint32_t i = 0; i < 3 * kStaticCapacity; i++) {
+        vec.push_back(Val(i));
+        ASSERT_EQ(vec.size(), Key(i + 1));
+    }
+
+    for (Key i(0); i < vec.size(); ++i) {
+        ASSERT_EQ(vec[i], Val(static_cast<uint32_t>(i)));
+    }
+}
+
+// Test resizing the stack_vec past the inline capacity.
+TEST_F(ITypStackVecTest, Resize) {
+    StackVec vec;
+
+    vec.resize(Key(3 * kStaticCapacity));
+    ASSERT_EQ(vec.size(), Key(3 * kStaticCapacity));
+
+    for (Key i(0); i < vec.size(); ++i) {
+        vec[i] = Val(static_cast<uint32_t>(i));
+    }
+    for (Key i(0); i < vec.size(); ++i) {
+        ASSERT_EQ(vec[i], Val(static_cast<uint32_t>(i)));
+    }
+}
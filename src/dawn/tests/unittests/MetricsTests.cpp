@@ -0,0 +1,71 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <thread>
+#include <vector>
+
+#include "dawn/platform/DawnPlatform.h"
+#include "gtest/gtest.h"
+
+namespace dawn::platform {
+
+class MetricsTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        ResetMetricsForTesting();
+    }
+    void TearDown() override {
+        ResetMetricsForTesting();
+    }
+};
+
+// Test that increments show up in snapshots and that counters are independent.
+TEST_F(MetricsTests, Basic) {
+    MetricsSnapshot empty = SnapshotMetrics();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(MetricCounter::Count); ++i) {
+        EXPECT_EQ(empty.counters[i], 0u);
+    }
+
+    AddMetric(MetricCounter::CommandsEncoded, 10);
+    AddMetric(MetricCounter::CommandsEncoded, 5);
+    AddMetric(MetricCounter::StagingBytesAllocated, 4096);
+
+    MetricsSnapshot snapshot = SnapshotMetrics();
+    EXPECT_EQ(snapshot.Get(MetricCounter::CommandsEncoded), 15u);
+    EXPECT_EQ(snapshot.Get(MetricCounter::StagingBytesAllocated), 4096u);
+    EXPECT_EQ(snapshot.Get(MetricCounter::BarriersEmitted), 0u);
+}
+
+// Test that increments from many threads (more than there are shards) are all accounted for.
+TEST_F(MetricsTests, ThreadedIncrements) {
+    constexpr uint32_t kNumThreads = 16;
+    constexpr uint32_t kIncrementsPerThread = 10000;
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([] {
+            for (uint32_t j = 0; j < kIncrementsPerThread; ++j) {
+                AddMetric(MetricCounter::ObjectCacheHits, 1);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    MetricsSnapshot snapshot = SnapshotMetrics();
+    EXPECT_EQ(snapshot.Get(MetricCounter::ObjectCacheHits), kNumThreads * kIncrementsPerThread);
+}
+
+}  // namespace dawn::platform
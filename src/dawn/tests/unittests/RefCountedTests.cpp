@@ -396,3 +396,30 @@ TEST(Ref, InitializeInto) {
     ref = nullptr;
     EXPECT_TRUE(deleted);
 }
+
+// Test BorrowedRef doesn't add a reference.
+TEST(BorrowedRef, DoesNotAddRef) {
+    bool deleted = false;
+    Ref<RCTest> owner(new RCTest(&deleted));
+    owner->Release();
+    EXPECT_EQ(owner->GetRefCountForTesting(), 1u);
+
+    {
+        BorrowedRef<RCTest> borrowed = owner;
+        EXPECT_EQ(borrowed.Get(), owner.Get());
+        EXPECT_EQ(borrowed->GetThis(), owner.Get());
+        EXPECT_EQ(owner->GetRefCountForTesting(), 1u);
+    }
+
+    EXPECT_EQ(owner->GetRefCountForTesting(), 1u);
+    EXPECT_FALSE(deleted);
+}
+
+// Test BorrowedRef defaults to null and converts back to a raw pointer.
+TEST(BorrowedRef, DefaultsToNull) {
+    BorrowedRef<RCTest> borrowed;
+    EXPECT_EQ(borrowed.Get(), nullptr);
+
+    RCTest* raw = borrowed;
+    EXPECT_EQ(raw, nullptr);
+}
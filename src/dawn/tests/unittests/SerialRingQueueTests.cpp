@@ -0,0 +1,167 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+#include <vector>
+
+#include "dawn/common/SerialRingQueue.h"
+#include "gtest/gtest.h"
+
+using TestSerialRingQueue = SerialRingQueue<uint64_t, int>;
+
+// A number of basic tests for SerialRingQueue that are difficult to split from one another
+TEST(SerialRingQueue, BasicTest) {
+    TestSerialRingQueue queue;
+
+    // Queue starts empty
+    ASSERT_TRUE(queue.Empty());
+
+    // Iterating on empty queue 1) works 2) doesn't produce any values
+    for (int value : queue.IterateAll()) {
+        DAWN_UNUSED(value);
+        ASSERT_TRUE(false);
+    }
+
+    // Enqueuing values as const ref or rvalue ref
+    queue.Enqueue(1, 0);
+    queue.Enqueue(2, 0);
+    queue.Enqueue(std::move(3), 1);
+
+    // Iterating over a non-empty queue produces the expected result
+    std::vector<int> expectedValues = {1, 2, 3};
+    for (int value : queue.IterateAll()) {
+        EXPECT_EQ(expectedValues.front(), value);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+
+    // Clear works and makes the queue empty and iteration does nothing.
+    queue.Clear();
+    ASSERT_TRUE(queue.Empty());
+
+    for (int value : queue.IterateAll()) {
+        DAWN_UNUSED(value);
+        ASSERT_TRUE(false);
+    }
+}
+
+// Test IterateUpTo
+TEST(SerialRingQueue, IterateUpTo) {
+    TestSerialRingQueue queue;
+
+    queue.Enqueue(1, 0);
+    queue.Enqueue(2, 1);
+    queue.Enqueue(3, 2);
+
+    std::vector<int> expectedValues = {1, 2};
+    for (int value : queue.IterateUpTo(1)) {
+        EXPECT_EQ(expectedValues.front(), value);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+    EXPECT_EQ(queue.LastSerial(), 2u);
+}
+
+// Test ClearUpTo
+TEST(SerialRingQueue, ClearUpTo) {
+    TestSerialRingQueue queue;
+
+    queue.Enqueue(1, 0);
+    queue.Enqueue(2, 0);
+    queue.Enqueue(3, 1);
+
+    queue.ClearUpTo(0);
+    EXPECT_EQ(queue.LastSerial(), 1u);
+
+    std::vector<int> expectedValues = {3};
+    for (int value : queue.IterateAll()) {
+        EXPECT_EQ(expectedValues.front(), value);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+}
+
+// Test FirstSerial
+TEST(SerialRingQueue, FirstSerial) {
+    TestSerialRingQueue queue;
+
+    queue.Enqueue(1, 0);
+    queue.Enqueue(2, 1);
+    queue.Enqueue(3, 2);
+
+    EXPECT_EQ(queue.FirstSerial(), 0u);
+
+    queue.ClearUpTo(1);
+    EXPECT_EQ(queue.FirstSerial(), 2u);
+
+    queue.Clear();
+    queue.Enqueue(1, 6);
+    EXPECT_EQ(queue.FirstSerial(), 6u);
+}
+
+// Test LastSerial
+TEST(SerialRingQueue, LastSerial) {
+    TestSerialRingQueue queue;
+
+    queue.Enqueue(1, 0);
+    EXPECT_EQ(queue.LastSerial(), 0u);
+
+    queue.Enqueue(2, 1);
+    EXPECT_EQ(queue.LastSerial(), 1u);
+}
+
+// Test that the ring stays correct when the head wraps around the end of the buffer while
+// entries are enqueued and dequeued in lock step, including across a growth of the buffer.
+TEST(SerialRingQueue, WrapAround) {
+    TestSerialRingQueue queue;
+
+    uint64_t serial = 0;
+    int value = 0;
+
+    // Fill up some of the ring.
+    for (int i = 0; i < 10; i++) {
+        queue.Enqueue(value++, serial++);
+    }
+
+    // Enqueue and dequeue in lock step, many times the initial capacity of the ring, so the
+    // head wraps around the buffer repeatedly.
+    int expected = 0;
+    for (int i = 0; i < 1000; i++) {
+        queue.Enqueue(value++, serial++);
+        for (int v : queue.IterateUpTo(queue.FirstSerial())) {
+            EXPECT_EQ(expected, v);
+        }
+        queue.ClearUpTo(queue.FirstSerial());
+        expected++;
+    }
+
+    // Grow while the head is in the middle of the ring.
+    for (int i = 0; i < 100; i++) {
+        queue.Enqueue(value++, serial++);
+    }
+
+    std::vector<int> expectedValues;
+    for (int i = expected; i < value; i++) {
+        expectedValues.push_back(i);
+    }
+    for (int v : queue.IterateAll()) {
+        EXPECT_EQ(expectedValues.front(), v);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+}
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <set>
+#include <thread>
 #include <vector>
 
 #include "dawn/common/Math.h"
@@ -179,3 +180,29 @@ TEST(SlabAllocatorTests, AllocateDeallocateMany) {
         allocator.Deallocate(object);
     }
 }
+
+// Test allocation and deallocation of many objects from multiple threads concurrently.
+TEST(SlabAllocatorTests, ThreadedAllocateDeallocate) {
+    SlabAllocator<Foo> allocator(17 * sizeof(Foo));
+
+    constexpr int kNumThreads = 4;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kNumThreads; ++t) {
+        threads.emplace_back([&allocator] {
+            for (int iteration = 0; iteration < 100; ++iteration) {
+                std::vector<Foo*> objects;
+                for (int i = 0; i < 50; ++i) {
+                    objects.push_back(allocator.Allocate(i));
+                }
+                for (int i = 0; i < 50; ++i) {
+                    // Check that the value hasn't been trampled by another thread.
+                    EXPECT_EQ(objects[i]->value, i);
+                    allocator.Deallocate(objects[i]);
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
@@ -666,6 +666,79 @@ TEST(SubresourceStorageTest, AspectDecompressionUpdatesLayer0) {
     EXPECT_EQ(3, s.Get(Aspect::Color, 0, 1));
 }
 
+// Check that IterateCoalescedRanges() visits each subresource exactly once with the correct
+// data and returns the number of ranges produced so tests can assert on coalescing.
+template <typename T>
+uint32_t CheckCoalescedIteration(const SubresourceStorage<T>& s) {
+    RangeTracker tracker(s);
+    uint32_t rangeCount = 0;
+    s.IterateCoalescedRanges([&](const SubresourceRange& range, const T& data) {
+        rangeCount++;
+        for (Aspect aspect : IterateEnumMask(range.aspects)) {
+            for (uint32_t layer = range.baseArrayLayer;
+                 layer < range.baseArrayLayer + range.layerCount; layer++) {
+                for (uint32_t level = range.baseMipLevel;
+                     level < range.baseMipLevel + range.levelCount; level++) {
+                    EXPECT_EQ(data, s.Get(aspect, layer, level));
+                }
+            }
+        }
+        tracker.Track(range);
+    });
+    tracker.CheckTrackedExactly(SubresourceRange::MakeFull(s.GetAspectsForTesting(),
+                                                           s.GetArrayLayerCountForTesting(),
+                                                           s.GetMipLevelCountForTesting()));
+    return rangeCount;
+}
+
+// Test that a fully compressed aspect is visited as a single coalesced range.
+TEST(SubresourceStorageTest, CoalescedIterationCompressedAspect) {
+    SubresourceStorage<int> s(Aspect::Color, 4, 3, 7);
+    EXPECT_EQ(CheckCoalescedIteration(s), 1u);
+}
+
+// Test that runs of compressed layers with equal data are coalesced into multi-layer ranges.
+TEST(SubresourceStorageTest, CoalescedIterationLayerRuns) {
+    const uint32_t kLayers = 6;
+    const uint32_t kLevels = 2;
+    SubresourceStorage<int> s(Aspect::Color, kLayers, kLevels);
+
+    // Update layers 2-3 as full layers so they stay compressed but differ from the rest.
+    s.Update({Aspect::Color, {2, 2}, {0, kLevels}},
+             [](const SubresourceRange&, int* data) { *data += 1; });
+
+    // Expected ranges: layers [0, 2), layers [2, 4), layers [4, 6).
+    EXPECT_EQ(CheckCoalescedIteration(s), 3u);
+}
+
+// Test that runs of equal mip levels in a decompressed layer are coalesced.
+TEST(SubresourceStorageTest, CoalescedIterationMipRuns) {
+    const uint32_t kLayers = 1;
+    const uint32_t kLevels = 6;
+    SubresourceStorage<int> s(Aspect::Color, kLayers, kLevels);
+
+    // Decompress the layer by updating levels 2-3 only.
+    s.Update({Aspect::Color, {0, 1}, {2, 2}},
+             [](const SubresourceRange&, int* data) { *data += 1; });
+
+    // Expected ranges: levels [0, 2), levels [2, 4), levels [4, 6).
+    EXPECT_EQ(CheckCoalescedIteration(s), 3u);
+}
+
+// Test coalescing with a mix of compressed layer runs and a decompressed layer.
+TEST(SubresourceStorageTest, CoalescedIterationMixed) {
+    const uint32_t kLayers = 4;
+    const uint32_t kLevels = 3;
+    SubresourceStorage<int> s(Aspect::Color, kLayers, kLevels);
+
+    // Decompress layer 1 by touching a single subresource.
+    s.Update(SubresourceRange::MakeSingle(Aspect::Color, 1, 1),
+             [](const SubresourceRange&, int* data) { *data += 1; });
+
+    // Expected ranges: layer 0, three mip runs in layer 1, layers [2, 4).
+    EXPECT_EQ(CheckCoalescedIteration(s), 5u);
+}
+
 // Bugs found while testing:
 //  - mLayersCompressed not initialized to true.
 //  - DecompressLayer setting Compressed to true instead of false.
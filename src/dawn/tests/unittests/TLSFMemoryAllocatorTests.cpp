@@ -0,0 +1,200 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "dawn/native/ResourceHeapAllocator.h"
+#include "dawn/native/TLSFMemoryAllocator.h"
+#include "gtest/gtest.h"
+
+namespace dawn::native {
+
+class PlaceholderTLSFResourceHeapAllocator : public ResourceHeapAllocator {
+  public:
+    ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(uint64_t size) override {
+        return std::make_unique<ResourceHeapBase>();
+    }
+    void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {}
+};
+
+class PlaceholderTLSFResourceAllocator {
+  public:
+    explicit PlaceholderTLSFResourceAllocator(uint64_t heapSize)
+        : mAllocator(heapSize, &mHeapAllocator) {}
+
+    ResourceMemoryAllocation Allocate(uint64_t allocationSize, uint64_t alignment = 1) {
+        ResultOrError<ResourceMemoryAllocation> result =
+            mAllocator.Allocate(allocationSize, alignment);
+        return (result.IsSuccess()) ? result.AcquireSuccess() : ResourceMemoryAllocation{};
+    }
+
+    void Deallocate(ResourceMemoryAllocation& allocation) { mAllocator.Deallocate(allocation); }
+
+    uint64_t ComputeTotalNumOfHeapsForTesting() const {
+        return mAllocator.ComputeTotalNumOfHeapsForTesting();
+    }
+
+    uint64_t GetReservedMemory() const { return mAllocator.GetReservedMemory(); }
+    uint64_t GetUsedMemory() const { return mAllocator.GetUsedMemory(); }
+
+  private:
+    PlaceholderTLSFResourceHeapAllocator mHeapAllocator;
+    TLSFMemoryAllocator mAllocator;
+};
+
+// The smallest heap size the allocator supports with its default 64 byte minimum block size
+// and 16 second-level subdivisions.
+constexpr uint64_t kHeapSize = 4096;
+
+// Verify a single resource allocation in a single heap, and that the heap is released with it.
+TEST(TLSFMemoryAllocatorTests, SingleHeap) {
+    PlaceholderTLSFResourceAllocator allocator(kHeapSize);
+
+    // Cannot allocate more than the heap size.
+    ResourceMemoryAllocation invalidAllocation = allocator.Allocate(kHeapSize * 2);
+    ASSERT_EQ(invalidAllocation.GetInfo().mMethod, AllocationMethod::kInvalid);
+
+    // Allocate the whole heap.
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(kHeapSize);
+    ASSERT_EQ(allocation1.GetInfo().mBlockOffset, 0u);
+    ASSERT_EQ(allocation1.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+
+    allocator.Deallocate(allocation1);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 0u);
+}
+
+// Verify allocations pack tightly in one heap instead of being rounded to powers of two.
+TEST(TLSFMemoryAllocatorTests, NoPowerOfTwoRounding) {
+    PlaceholderTLSFResourceAllocator allocator(kHeapSize);
+
+    // 320 is not a power of two; a buddy system would round it to 512. TLSF only rounds to
+    // the 64 byte minimum block size so the second allocation starts right after the first.
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(320);
+    ASSERT_EQ(allocation1.GetInfo().mBlockOffset, 0u);
+    ASSERT_EQ(allocator.GetUsedMemory(), 320u);
+
+    ResourceMemoryAllocation allocation2 = allocator.Allocate(320);
+    ASSERT_EQ(allocation2.GetInfo().mBlockOffset, 320u);
+    ASSERT_EQ(allocation2.GetResourceHeap(), allocation1.GetResourceHeap());
+    ASSERT_EQ(allocator.GetUsedMemory(), 640u);
+
+    // Sizes are rounded up to the 64 byte minimum block size.
+    ResourceMemoryAllocation allocation3 = allocator.Allocate(100);
+    ASSERT_EQ(allocation3.GetInfo().mBlockOffset, 640u);
+    ASSERT_EQ(allocator.GetUsedMemory(), 640u + 128u);
+
+    allocator.Deallocate(allocation1);
+    allocator.Deallocate(allocation2);
+    allocator.Deallocate(allocation3);
+    ASSERT_EQ(allocator.GetUsedMemory(), 0u);
+}
+
+// Verify a freed block coalesces with its neighbors and can be re-used at the same offset.
+TEST(TLSFMemoryAllocatorTests, CoalesceAndReuse) {
+    PlaceholderTLSFResourceAllocator allocator(kHeapSize);
+
+    ResourceMemoryAllocation allocationA = allocator.Allocate(512);
+    ResourceMemoryAllocation allocationB = allocator.Allocate(512);
+    ResourceMemoryAllocation allocationC = allocator.Allocate(512);
+    ASSERT_EQ(allocationB.GetInfo().mBlockOffset, 512u);
+    ASSERT_EQ(allocationC.GetInfo().mBlockOffset, 1024u);
+
+    // Free the middle block, then a same-size allocation takes its place exactly.
+    allocator.Deallocate(allocationB);
+    ResourceMemoryAllocation allocationD = allocator.Allocate(512);
+    ASSERT_EQ(allocationD.GetInfo().mBlockOffset, 512u);
+
+    // Free the middle block again plus its right neighbor: they coalesce, and an allocation
+    // larger than either hole alone fits in the merged one.
+    allocator.Deallocate(allocationD);
+    allocator.Deallocate(allocationC);
+    ResourceMemoryAllocation allocationE = allocator.Allocate(1024);
+    ASSERT_EQ(allocationE.GetInfo().mBlockOffset, 512u);
+
+    allocator.Deallocate(allocationA);
+    allocator.Deallocate(allocationE);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 0u);
+}
+
+// Verify a second heap is created when the first cannot fit an allocation, and that heaps are
+// released as soon as they are empty even with other heaps still live.
+TEST(TLSFMemoryAllocatorTests, MultipleHeaps) {
+    PlaceholderTLSFResourceAllocator allocator(kHeapSize);
+
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(kHeapSize - 1024);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+
+    // Does not fit in the 1024 bytes left of the first heap.
+    ResourceMemoryAllocation allocation2 = allocator.Allocate(2048);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 2u);
+    ASSERT_NE(allocation1.GetResourceHeap(), allocation2.GetResourceHeap());
+
+    // But a small allocation re-uses the first heap's remaining space.
+    ResourceMemoryAllocation allocation3 = allocator.Allocate(1024);
+    ASSERT_EQ(allocation3.GetResourceHeap(), allocation1.GetResourceHeap());
+    ASSERT_EQ(allocation3.GetOffset(), kHeapSize - 1024);
+
+    allocator.Deallocate(allocation2);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+
+    allocator.Deallocate(allocation1);
+    allocator.Deallocate(allocation3);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 0u);
+}
+
+// Verify allocations with an alignment larger than the minimum block size are aligned and the
+// padding in front of them is re-usable.
+TEST(TLSFMemoryAllocatorTests, AlignedAllocations) {
+    PlaceholderTLSFResourceAllocator allocator(kHeapSize);
+
+    // Misalign the heap with a small allocation first.
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(64);
+
+    ResourceMemoryAllocation allocation2 = allocator.Allocate(1024, 1024);
+    ASSERT_EQ(allocation2.GetOffset() % 1024, 0u);
+    ASSERT_EQ(allocation2.GetResourceHeap(), allocation1.GetResourceHeap());
+
+    // The padding between the two allocations went back to the free lists.
+    ResourceMemoryAllocation allocation3 = allocator.Allocate(512);
+    ASSERT_EQ(allocation3.GetInfo().mBlockOffset, 64u);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+
+    allocator.Deallocate(allocation1);
+    allocator.Deallocate(allocation2);
+    allocator.Deallocate(allocation3);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 0u);
+}
+
+// Verify the fragmentation metrics report reserved and used memory.
+TEST(TLSFMemoryAllocatorTests, FragmentationMetrics) {
+    PlaceholderTLSFResourceAllocator allocator(kHeapSize);
+    ASSERT_EQ(allocator.GetReservedMemory(), 0u);
+    ASSERT_EQ(allocator.GetUsedMemory(), 0u);
+
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(1024);
+    ResourceMemoryAllocation allocation2 = allocator.Allocate(kHeapSize);
+    ASSERT_EQ(allocator.GetReservedMemory(), 2 * kHeapSize);
+    ASSERT_EQ(allocator.GetUsedMemory(), 1024u + kHeapSize);
+
+    allocator.Deallocate(allocation2);
+    ASSERT_EQ(allocator.GetReservedMemory(), kHeapSize);
+    ASSERT_EQ(allocator.GetUsedMemory(), 1024u);
+
+    allocator.Deallocate(allocation1);
+    ASSERT_EQ(allocator.GetReservedMemory(), 0u);
+    ASSERT_EQ(allocator.GetUsedMemory(), 0u);
+}
+
+}  // namespace dawn::native
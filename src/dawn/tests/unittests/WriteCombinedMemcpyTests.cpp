@@ -0,0 +1,82 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <vector>
+
+#include "dawn/common/WriteCombinedMemcpy.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Copies |size| bytes at the given destination and source misalignments and checks the result
+// byte-for-byte, including that the bytes surrounding the destination range are untouched.
+void TestCopy(size_t size, size_t dstMisalignment, size_t srcMisalignment) {
+    constexpr size_t kGuardSize = 64;
+    constexpr uint8_t kGuardValue = 0xAB;
+
+    std::vector<uint8_t> src(size + srcMisalignment);
+    for (size_t i = 0; i < size; ++i) {
+        src[srcMisalignment + i] = static_cast<uint8_t>(i * 7 + 13);
+    }
+
+    std::vector<uint8_t> dst(size + dstMisalignment + 2 * kGuardSize, kGuardValue);
+    uint8_t* dstStart = dst.data() + kGuardSize + dstMisalignment;
+
+    MemcpyToWriteCombinedMemory(dstStart, src.data() + srcMisalignment, size);
+
+    EXPECT_EQ(memcmp(dstStart, src.data() + srcMisalignment, size), 0)
+        << "size " << size << " dst misalignment " << dstMisalignment << " src misalignment "
+        << srcMisalignment;
+    for (size_t i = 0; i < kGuardSize + dstMisalignment; ++i) {
+        ASSERT_EQ(dst[i], kGuardValue) << "guard byte " << i << " before the destination";
+    }
+    for (size_t i = kGuardSize + dstMisalignment + size; i < dst.size(); ++i) {
+        ASSERT_EQ(dst[i], kGuardValue) << "guard byte " << i << " after the destination";
+    }
+}
+
+}  // namespace
+
+// Test small copies that stay on the plain memcpy path.
+TEST(WriteCombinedMemcpyTests, SmallCopies) {
+    for (size_t size : {size_t(0), size_t(1), size_t(15), size_t(16), size_t(100)}) {
+        TestCopy(size, 0, 0);
+        TestCopy(size, 1, 0);
+    }
+}
+
+// Test large copies that take the streaming path, at every destination misalignment so the
+// head, aligned bulk, and tail splits are all exercised.
+TEST(WriteCombinedMemcpyTests, LargeCopiesAllDstMisalignments) {
+    for (size_t dstMisalignment = 0; dstMisalignment < 16; ++dstMisalignment) {
+        TestCopy(4096, dstMisalignment, 0);
+    }
+}
+
+// Test that an unaligned source is handled by the streaming path.
+TEST(WriteCombinedMemcpyTests, LargeCopiesUnalignedSrc) {
+    for (size_t srcMisalignment : {size_t(1), size_t(7), size_t(15)}) {
+        TestCopy(4096, 0, srcMisalignment);
+        TestCopy(4096, 5, srcMisalignment);
+    }
+}
+
+// Test sizes that leave a partial cache line and a partial vector at the end of the copy.
+TEST(WriteCombinedMemcpyTests, LargeCopiesRaggedTail) {
+    for (size_t extra : {size_t(1), size_t(15), size_t(16), size_t(17), size_t(63)}) {
+        TestCopy(4096 + extra, 0, 0);
+        TestCopy(4096 + extra, 9, 3);
+    }
+}
@@ -0,0 +1,163 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+#include <vector>
+
+#include "dawn/native/CommandBuffer.h"
+#include "dawn/native/Commands.h"
+#include "dawn/tests/DawnNativeTest.h"
+
+namespace dawn::native {
+
+class PassReorderingTests : public DawnNativeTest {
+  protected:
+    WGPUDevice CreateTestDevice() override {
+        wgpu::DeviceDescriptor deviceDescriptor = {};
+        wgpu::DawnTogglesDeviceDescriptor togglesDesc = {};
+        deviceDescriptor.nextInChain = &togglesDesc;
+
+        // Timestamp queries are used to check that query-recording passes stay pinned.
+        wgpu::FeatureName requiredFeature = wgpu::FeatureName::TimestampQuery;
+        deviceDescriptor.requiredFeatures = &requiredFeature;
+        deviceDescriptor.requiredFeaturesCount = 1;
+
+        const char* enabledToggle = "reorder_passes_on_finish";
+        togglesDesc.forceEnabledToggles = &enabledToggle;
+        togglesDesc.forceEnabledTogglesCount = 1;
+
+        const char* disabledToggle = "disallow_unsafe_apis";
+        togglesDesc.forceDisabledToggles = &disabledToggle;
+        togglesDesc.forceDisabledTogglesCount = 1;
+
+        return adapter.CreateDevice(&deviceDescriptor);
+    }
+
+    wgpu::Buffer CreateCopyBuffer() {
+        wgpu::BufferDescriptor descriptor = {};
+        descriptor.size = 4;
+        descriptor.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+        return device.CreateBuffer(&descriptor);
+    }
+
+    // Expects the next command to be a buffer-to-buffer copy from |source| to |destination|.
+    void ExpectCopy(CommandIterator* commands, wgpu::Buffer source, wgpu::Buffer destination) {
+        Command commandId;
+        ASSERT_TRUE(commands->NextCommandId(&commandId));
+        ASSERT_EQ(commandId, Command::CopyBufferToBuffer);
+        auto* copy = commands->NextCommand<CopyBufferToBufferCmd>();
+        EXPECT_EQ(ToAPI(copy->source.Get()), source.Get());
+        EXPECT_EQ(ToAPI(copy->destination.Get()), destination.Get());
+    }
+
+    // Expects the next commands to be an empty compute pass.
+    void ExpectEmptyComputePass(CommandIterator* commands) {
+        Command commandId;
+        ASSERT_TRUE(commands->NextCommandId(&commandId));
+        ASSERT_EQ(commandId, Command::BeginComputePass);
+        commands->NextCommand<BeginComputePassCmd>();
+        ASSERT_TRUE(commands->NextCommandId(&commandId));
+        ASSERT_EQ(commandId, Command::EndComputePass);
+        commands->NextCommand<EndComputePassCmd>();
+    }
+};
+
+// Test that independent copies separated by an unrelated pass are grouped together.
+TEST_F(PassReorderingTests, IndependentCopiesGrouped) {
+    wgpu::Buffer a = CreateCopyBuffer();
+    wgpu::Buffer b = CreateCopyBuffer();
+    wgpu::Buffer c = CreateCopyBuffer();
+    wgpu::Buffer d = CreateCopyBuffer();
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(a, 0, b, 0, 4);
+    encoder.BeginComputePass().End();
+    encoder.CopyBufferToBuffer(c, 0, d, 0, 4);
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    // No segment conflicts with another, so the copies get scheduled back to back and the
+    // compute pass moves after them.
+    CommandIterator* commands = FromAPI(commandBuffer.Get())->GetCommandIteratorForTesting();
+    ExpectCopy(commands, a, b);
+    ExpectCopy(commands, c, d);
+    ExpectEmptyComputePass(commands);
+
+    Command commandId;
+    ASSERT_FALSE(commands->NextCommandId(&commandId));
+}
+
+// Test that copies with a write-read dependency keep their relative order when reordered.
+TEST_F(PassReorderingTests, DependentCopiesKeepOrder) {
+    wgpu::Buffer a = CreateCopyBuffer();
+    wgpu::Buffer b = CreateCopyBuffer();
+    wgpu::Buffer c = CreateCopyBuffer();
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(a, 0, b, 0, 4);
+    encoder.BeginComputePass().End();
+    encoder.CopyBufferToBuffer(b, 0, c, 0, 4);
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    // The second copy reads |b| which the first copy writes, so it may not move before it. The
+    // unrelated compute pass still moves out of the way so the copies become adjacent.
+    CommandIterator* commands = FromAPI(commandBuffer.Get())->GetCommandIteratorForTesting();
+    ExpectCopy(commands, a, b);
+    ExpectCopy(commands, b, c);
+    ExpectEmptyComputePass(commands);
+
+    Command commandId;
+    ASSERT_FALSE(commands->NextCommandId(&commandId));
+}
+
+// Test that a pass recording timestamp queries is not moved across other segments.
+TEST_F(PassReorderingTests, QueryPassPinned) {
+    wgpu::Buffer a = CreateCopyBuffer();
+    wgpu::Buffer b = CreateCopyBuffer();
+    wgpu::Buffer c = CreateCopyBuffer();
+    wgpu::Buffer d = CreateCopyBuffer();
+
+    wgpu::QuerySetDescriptor querySetDesc = {};
+    querySetDesc.type = wgpu::QueryType::Timestamp;
+    querySetDesc.count = 1;
+    wgpu::QuerySet querySet = device.CreateQuerySet(&querySetDesc);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(a, 0, b, 0, 4);
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.WriteTimestamp(querySet, 0);
+    pass.End();
+    encoder.CopyBufferToBuffer(c, 0, d, 0, 4);
+    wgpu::CommandBuffer commandBuffer = encoder.Finish();
+
+    // The pass writes a timestamp so it acts as a reordering barrier and the copies stay on
+    // either side of it even though they don't conflict.
+    CommandIterator* commands = FromAPI(commandBuffer.Get())->GetCommandIteratorForTesting();
+    ExpectCopy(commands, a, b);
+
+    Command commandId;
+    ASSERT_TRUE(commands->NextCommandId(&commandId));
+    ASSERT_EQ(commandId, Command::BeginComputePass);
+    commands->NextCommand<BeginComputePassCmd>();
+    ASSERT_TRUE(commands->NextCommandId(&commandId));
+    ASSERT_EQ(commandId, Command::WriteTimestamp);
+    commands->NextCommand<WriteTimestampCmd>();
+    ASSERT_TRUE(commands->NextCommandId(&commandId));
+    ASSERT_EQ(commandId, Command::EndComputePass);
+    commands->NextCommand<EndComputePassCmd>();
+
+    ExpectCopy(commands, c, d);
+    ASSERT_FALSE(commands->NextCommandId(&commandId));
+}
+
+}  // namespace dawn::native
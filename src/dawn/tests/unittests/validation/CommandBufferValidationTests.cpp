@@ -398,3 +398,63 @@ TEST_F(CommandBufferValidationTest, EncodeAfterDeviceDestroyed) {
         ASSERT_DEVICE_ERROR(encoder.Finish(), HasSubstr("[Invalid CommandEncoder] is invalid."));
     }
 }
+
+// Test the validation of stitching sub-encoders into another encoder.
+TEST_F(CommandBufferValidationTest, StitchCommands) {
+    // Control case: stitching two sub-encoders in order and finishing works.
+    {
+        wgpu::CommandEncoder first = device.CreateCommandEncoder();
+        first.InsertDebugMarker("first");
+        wgpu::CommandEncoder second = device.CreateCommandEncoder();
+        second.InsertDebugMarker("second");
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.StitchCommands(first);
+        encoder.StitchCommands(second);
+        encoder.Finish();
+    }
+
+    // Error case: an encoder cannot be stitched into itself.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.StitchCommands(encoder);
+        ASSERT_DEVICE_ERROR(encoder.Finish(), HasSubstr("cannot be stitched into itself"));
+    }
+
+    // Error case: a stitched encoder is consumed and cannot be finished.
+    {
+        wgpu::CommandEncoder source = device.CreateCommandEncoder();
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.StitchCommands(source);
+        encoder.Finish();
+        ASSERT_DEVICE_ERROR(source.Finish(), HasSubstr("Command encoding already finished."));
+    }
+
+    // Error case: an already finished encoder cannot be stitched.
+    {
+        wgpu::CommandEncoder source = device.CreateCommandEncoder();
+        source.Finish();
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.StitchCommands(source);
+        ASSERT_DEVICE_ERROR(encoder.Finish(), HasSubstr("Command encoding already finished."));
+    }
+
+    // Error case: a sub-encoder with an open pass cannot be stitched.
+    {
+        wgpu::CommandEncoder source = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = source.BeginComputePass();
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.StitchCommands(source);
+        ASSERT_DEVICE_ERROR(encoder.Finish(),
+                            HasSubstr("Command buffer recording ended before"));
+    }
+
+    // Error case: errors deferred on a sub-encoder surface on the stitching encoder.
+    {
+        wgpu::CommandEncoder source = device.CreateCommandEncoder();
+        source.InjectValidationError("sub-encoder error");
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.StitchCommands(source);
+        ASSERT_DEVICE_ERROR(encoder.Finish(), HasSubstr("sub-encoder error"));
+    }
+}
@@ -14,6 +14,7 @@
 
 #include "dawn/tests/unittests/validation/ValidationTest.h"
 
+#include "dawn/native/dawn_platform.h"
 #include "dawn/utils/WGPUHelpers.h"
 
 class InternalUsageValidationDisabledTest : public ValidationTest {};
@@ -314,3 +315,53 @@ TEST_F(TextureInternalUsageValidationTest, CommandValidation) {
         encoder.Finish();
     }
 }
+
+// Test the validation of the transient attachment internal usage.
+TEST_F(TextureInternalUsageValidationTest, TransientAttachment) {
+    wgpu::DawnTextureInternalUsageDescriptor internalDesc = {};
+    internalDesc.internalUsage = dawn::native::kTransientAttachment;
+
+    wgpu::TextureDescriptor textureDesc = {};
+    textureDesc.size = {1, 1};
+    textureDesc.usage = wgpu::TextureUsage::RenderAttachment;
+    textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    textureDesc.nextInChain = &internalDesc;
+
+    // Control case: the transient usage combined with only the render attachment usage.
+    wgpu::Texture texture = device.CreateTexture(&textureDesc);
+
+    // The transient usage may not be combined with any other usage.
+    textureDesc.usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::TextureBinding;
+    ASSERT_DEVICE_ERROR(device.CreateTexture(&textureDesc));
+    textureDesc.usage = wgpu::TextureUsage::RenderAttachment;
+
+    // Control case: a transient attachment is cleared on load and discarded on store.
+    utils::ComboRenderPassDescriptor renderPass({texture.CreateView()});
+    renderPass.cColorAttachments[0].loadOp = wgpu::LoadOp::Clear;
+    renderPass.cColorAttachments[0].storeOp = wgpu::StoreOp::Discard;
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.End();
+        encoder.Finish();
+    }
+
+    // Loading the contents of a transient attachment is an error.
+    renderPass.cColorAttachments[0].loadOp = wgpu::LoadOp::Load;
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    // Storing the contents of a transient attachment is an error.
+    renderPass.cColorAttachments[0].loadOp = wgpu::LoadOp::Clear;
+    renderPass.cColorAttachments[0].storeOp = wgpu::StoreOp::Store;
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.End();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+}
@@ -93,6 +93,21 @@ TEST_F(QueueSubmitValidationTest, CommandBufferSubmittedTwice) {
     ASSERT_DEVICE_ERROR(queue.Submit(1, &commandBuffer));
 }
 
+// Test that a command buffer finished with DawnCommandBufferReuseDescriptor may be submitted
+// multiple times.
+TEST_F(QueueSubmitValidationTest, CommandBufferSubmittedTwiceWithReuseDescriptor) {
+    wgpu::DawnCommandBufferReuseDescriptor reuseDesc;
+    reuseDesc.allowMultipleSubmits = true;
+    wgpu::CommandBufferDescriptor descriptor;
+    descriptor.nextInChain = &reuseDesc;
+
+    wgpu::CommandBuffer commandBuffer = device.CreateCommandEncoder().Finish(&descriptor);
+    wgpu::Queue queue = device.GetQueue();
+
+    queue.Submit(1, &commandBuffer);
+    queue.Submit(1, &commandBuffer);
+}
+
 // Test resubmitting failed command buffers
 TEST_F(QueueSubmitValidationTest, CommandBufferSubmittedFailed) {
     // Create a map-write buffer
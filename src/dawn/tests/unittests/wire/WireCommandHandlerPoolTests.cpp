@@ -0,0 +1,226 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dawn/wire/Wire.h"
+#include "gtest/gtest.h"
+
+namespace dawn::wire {
+
+namespace {
+
+// CommandHandler that records the bytes of every HandleCommands call and fails on chunks
+// whose first byte is kFailureMarker, standing in for a wire server hitting a fatal
+// deserialization error. Reading the recorded batches is safe once the pool reports idle:
+// WaitIdle synchronizes with the worker through the pool mutex.
+class RecordingHandler final : public CommandHandler {
+  public:
+    static constexpr char kFailureMarker = '\xFF';
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        // The pool must never run one connection's handler concurrently.
+        EXPECT_EQ(mConcurrentCalls.fetch_add(1), 0u);
+        std::vector<char> batch(size);
+        for (size_t i = 0; i < size; i++) {
+            batch[i] = commands[i];
+        }
+        mBatches.push_back(batch);
+        mConcurrentCalls.fetch_sub(1);
+        if (size > 0 && batch[0] == kFailureMarker) {
+            return nullptr;
+        }
+        return commands + size;
+    }
+
+    const std::vector<std::vector<char>>& Batches() const { return mBatches; }
+
+  private:
+    std::vector<std::vector<char>> mBatches;
+    std::atomic<uint32_t> mConcurrentCalls{0};
+};
+
+std::vector<char> MakeChunk(uint64_t sequence, size_t size = 64) {
+    std::vector<char> chunk(size);
+    memcpy(chunk.data(), &sequence, sizeof(sequence));
+    for (size_t i = sizeof(sequence); i < size; i++) {
+        chunk[i] = static_cast<char>(sequence + i);
+    }
+    return chunk;
+}
+
+}  // anonymous namespace
+
+// Chunks submitted to one wrapped handler are delivered intact and in submission order.
+TEST(WireCommandHandlerPoolTests, InOrderDelivery) {
+    CommandHandlerPool pool(2);
+    RecordingHandler handler;
+    std::unique_ptr<CommandHandler> wrapped = pool.Wrap(&handler);
+
+    std::vector<std::vector<char>> chunks;
+    for (uint64_t i = 0; i < 100; i++) {
+        chunks.push_back(MakeChunk(i));
+        ASSERT_NE(wrapped->HandleCommands(chunks[i].data(), chunks[i].size()), nullptr);
+    }
+    pool.WaitIdle();
+
+    ASSERT_EQ(handler.Batches().size(), chunks.size());
+    for (size_t i = 0; i < chunks.size(); i++) {
+        EXPECT_EQ(handler.Batches()[i], chunks[i]);
+    }
+}
+
+// The wrapped handler copies the command data, so the caller's buffer may be reused as soon
+// as HandleCommands returns.
+TEST(WireCommandHandlerPoolTests, CommandDataIsCopied) {
+    CommandHandlerPool pool(1);
+    RecordingHandler handler;
+    std::unique_ptr<CommandHandler> wrapped = pool.Wrap(&handler);
+
+    std::vector<char> buffer = MakeChunk(1);
+    std::vector<char> original = buffer;
+    ASSERT_NE(wrapped->HandleCommands(buffer.data(), buffer.size()), nullptr);
+    memset(buffer.data(), 0, buffer.size());
+    pool.WaitIdle();
+
+    ASSERT_EQ(handler.Batches().size(), 1u);
+    EXPECT_EQ(handler.Batches()[0], original);
+}
+
+// Distinct connections run on distinct pool threads at the same time. Each handler waits to
+// observe the other one running; the test only completes if they overlap.
+TEST(WireCommandHandlerPoolTests, ConnectionsRunInParallel) {
+    class RendezvousHandler final : public CommandHandler {
+      public:
+        RendezvousHandler(std::atomic<bool>* self, std::atomic<bool>* other)
+            : mSelf(self), mOther(other) {}
+
+        const volatile char* HandleCommands(const volatile char* commands,
+                                            size_t size) override {
+            mSelf->store(true);
+            // Bounded wait so a serialization bug fails the expectation instead of hanging.
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (!mOther->load() && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+            EXPECT_TRUE(mOther->load());
+            return commands + size;
+        }
+
+      private:
+        std::atomic<bool>* mSelf;
+        std::atomic<bool>* mOther;
+    };
+
+    CommandHandlerPool pool(2);
+    std::atomic<bool> firstRunning{false};
+    std::atomic<bool> secondRunning{false};
+    RendezvousHandler firstHandler(&firstRunning, &secondRunning);
+    RendezvousHandler secondHandler(&secondRunning, &firstRunning);
+    std::unique_ptr<CommandHandler> first = pool.Wrap(&firstHandler);
+    std::unique_ptr<CommandHandler> second = pool.Wrap(&secondHandler);
+
+    char chunk[8] = {};
+    ASSERT_NE(first->HandleCommands(chunk, sizeof(chunk)), nullptr);
+    ASSERT_NE(second->HandleCommands(chunk, sizeof(chunk)), nullptr);
+    pool.WaitIdle();
+}
+
+// Several connections submitting from their own threads stay isolated and ordered.
+TEST(WireCommandHandlerPoolTests, ConcurrentConnectionsStayIsolated) {
+    constexpr size_t kConnectionCount = 4;
+    constexpr uint64_t kChunksPerConnection = 100;
+
+    CommandHandlerPool pool(4);
+    std::vector<RecordingHandler> handlers(kConnectionCount);
+    std::vector<std::unique_ptr<CommandHandler>> wrapped;
+    for (RecordingHandler& handler : handlers) {
+        wrapped.push_back(pool.Wrap(&handler));
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kConnectionCount; i++) {
+        threads.emplace_back([&wrapped, i] {
+            for (uint64_t sequence = 0; sequence < kChunksPerConnection; sequence++) {
+                std::vector<char> chunk = MakeChunk(sequence);
+                ASSERT_NE(wrapped[i]->HandleCommands(chunk.data(), chunk.size()), nullptr);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    pool.WaitIdle();
+
+    for (const RecordingHandler& handler : handlers) {
+        ASSERT_EQ(handler.Batches().size(), kChunksPerConnection);
+        for (uint64_t sequence = 0; sequence < kChunksPerConnection; sequence++) {
+            EXPECT_EQ(handler.Batches()[sequence], MakeChunk(sequence));
+        }
+    }
+}
+
+// A processing error is reported on the next submission for that connection, queued chunks
+// behind the failing one are dropped, and other connections are unaffected.
+TEST(WireCommandHandlerPoolTests, ErrorSurfacesOnNextSubmission) {
+    CommandHandlerPool pool(1);
+    RecordingHandler failingHandler;
+    RecordingHandler healthyHandler;
+    std::unique_ptr<CommandHandler> failing = pool.Wrap(&failingHandler);
+    std::unique_ptr<CommandHandler> healthy = pool.Wrap(&healthyHandler);
+
+    std::vector<char> good = MakeChunk(0);
+    std::vector<char> bad = MakeChunk(1);
+    bad[0] = RecordingHandler::kFailureMarker;
+    std::vector<char> afterBad = MakeChunk(2);
+
+    ASSERT_NE(failing->HandleCommands(good.data(), good.size()), nullptr);
+    ASSERT_NE(failing->HandleCommands(bad.data(), bad.size()), nullptr);
+    failing->HandleCommands(afterBad.data(), afterBad.size());
+    pool.WaitIdle();
+
+    // The chunk behind the failing one never reaches the wrapped handler, whether it was
+    // still queued when the failure happened or rejected at submission.
+    ASSERT_LE(failingHandler.Batches().size(), 2u);
+    EXPECT_EQ(failingHandler.Batches()[0], good);
+
+    // The error sticks for later submissions on this connection only.
+    EXPECT_EQ(failing->HandleCommands(good.data(), good.size()), nullptr);
+    ASSERT_NE(healthy->HandleCommands(good.data(), good.size()), nullptr);
+    pool.WaitIdle();
+    ASSERT_EQ(healthyHandler.Batches().size(), 1u);
+    EXPECT_EQ(healthyHandler.Batches()[0], good);
+}
+
+// Destroying a wrapped handler drains the commands already submitted for it.
+TEST(WireCommandHandlerPoolTests, DestructionDrainsSubmittedCommands) {
+    CommandHandlerPool pool(2);
+    RecordingHandler handler;
+    std::unique_ptr<CommandHandler> wrapped = pool.Wrap(&handler);
+
+    for (uint64_t i = 0; i < 50; i++) {
+        std::vector<char> chunk = MakeChunk(i);
+        ASSERT_NE(wrapped->HandleCommands(chunk.data(), chunk.size()), nullptr);
+    }
+    wrapped = nullptr;
+
+    EXPECT_EQ(handler.Batches().size(), 50u);
+}
+
+}  // namespace dawn::wire
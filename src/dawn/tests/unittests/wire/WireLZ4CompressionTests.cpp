@@ -0,0 +1,351 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "dawn/wire/LZ4Compression.h"
+#include "dawn/wire/Wire.h"
+#include "gtest/gtest.h"
+
+namespace dawn::wire {
+
+namespace {
+
+// The frame layout produced by the compressing serializer: two little-endian uint64 sizes
+// followed by the payload. Tests build malformed headers against this layout.
+constexpr size_t kFrameHeaderSize = 2 * sizeof(uint64_t);
+
+std::vector<char> MakeCompressibleData(size_t size) {
+    const char pattern[] = "the quick brown fox jumps over the lazy dog. ";
+    std::vector<char> data(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = pattern[i % (sizeof(pattern) - 1)];
+    }
+    return data;
+}
+
+std::vector<char> MakeIncompressibleData(size_t size) {
+    // xorshift keeps the data deterministic while defeating the greedy matcher.
+    std::vector<char> data(size);
+    uint32_t state = 0xdeadbeef;
+    for (size_t i = 0; i < size; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        data[i] = static_cast<char>(state);
+    }
+    return data;
+}
+
+std::vector<char> Compress(const std::vector<char>& src) {
+    std::vector<char> dst(LZ4CompressBound(src.size()));
+    size_t compressedSize = LZ4CompressBlock(src.data(), src.size(), dst.data(), dst.size());
+    EXPECT_NE(compressedSize, 0u);
+    dst.resize(compressedSize);
+    return dst;
+}
+
+// CommandSerializer that records every byte it is handed, standing in for the transport under
+// the compressing serializer. The maximum allocation size is configurable to exercise the
+// frame-splitting path.
+class RecordingSerializer final : public CommandSerializer {
+  public:
+    explicit RecordingSerializer(size_t maxAllocationSize = 65536)
+        : mMaxAllocationSize(maxAllocationSize) {}
+
+    void* GetCmdSpace(size_t size) override {
+        EXPECT_LE(size, mMaxAllocationSize);
+        size_t offset = mBytes.size();
+        mBytes.resize(offset + size);
+        return mBytes.data() + offset;
+    }
+
+    bool Flush() override {
+        mFlushCount++;
+        return true;
+    }
+
+    size_t GetMaximumAllocationSize() const override { return mMaxAllocationSize; }
+
+    const std::vector<char>& Bytes() const { return mBytes; }
+    uint32_t FlushCount() const { return mFlushCount; }
+
+  private:
+    size_t mMaxAllocationSize;
+    std::vector<char> mBytes;
+    uint32_t mFlushCount = 0;
+};
+
+// CommandHandler that records the bytes of every HandleCommands call, standing in for the
+// wire server under the decompressing handler.
+class RecordingHandler final : public CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        std::vector<char> batch(size);
+        for (size_t i = 0; i < size; i++) {
+            batch[i] = commands[i];
+        }
+        mBatches.push_back(std::move(batch));
+        return commands + size;
+    }
+
+    const std::vector<std::vector<char>>& Batches() const { return mBatches; }
+
+  private:
+    std::vector<std::vector<char>> mBatches;
+};
+
+// Serializes |data| as one flush batch through the compressing serializer and returns the
+// framed bytes that reached the transport.
+std::vector<char> FrameBatch(const std::vector<char>& data, size_t maxAllocationSize = 65536) {
+    RecordingSerializer transport(maxAllocationSize);
+    std::unique_ptr<CommandSerializer> compressing =
+        CreateCompressingCommandSerializer(&transport);
+
+    void* cmdSpace = compressing->GetCmdSpace(data.size());
+    EXPECT_NE(cmdSpace, nullptr);
+    memcpy(cmdSpace, data.data(), data.size());
+    EXPECT_TRUE(compressing->Flush());
+    EXPECT_EQ(transport.FlushCount(), 1u);
+
+    return transport.Bytes();
+}
+
+std::vector<char> MakeFrame(uint64_t compressedSize,
+                            uint64_t uncompressedSize,
+                            const std::vector<char>& payload) {
+    std::vector<char> frame(kFrameHeaderSize + payload.size());
+    memcpy(frame.data(), &compressedSize, sizeof(compressedSize));
+    memcpy(frame.data() + sizeof(compressedSize), &uncompressedSize, sizeof(uncompressedSize));
+    memcpy(frame.data() + kFrameHeaderSize, payload.data(), payload.size());
+    return frame;
+}
+
+}  // anonymous namespace
+
+// Compressible data round-trips through the block codec and actually shrinks.
+TEST(LZ4CompressionTests, CompressibleRoundTrip) {
+    std::vector<char> src = MakeCompressibleData(4096);
+    std::vector<char> compressed = Compress(src);
+    EXPECT_LT(compressed.size(), src.size());
+
+    std::vector<char> decompressed(src.size());
+    ASSERT_TRUE(LZ4DecompressBlock(compressed.data(), compressed.size(), decompressed.data(),
+                                   decompressed.size()));
+    EXPECT_EQ(src, decompressed);
+}
+
+// Incompressible data still round-trips; the bound leaves room for the expansion.
+TEST(LZ4CompressionTests, IncompressibleRoundTrip) {
+    std::vector<char> src = MakeIncompressibleData(4096);
+    std::vector<char> compressed = Compress(src);
+
+    std::vector<char> decompressed(src.size());
+    ASSERT_TRUE(LZ4DecompressBlock(compressed.data(), compressed.size(), decompressed.data(),
+                                   decompressed.size()));
+    EXPECT_EQ(src, decompressed);
+}
+
+// Sizes around the matcher's small-input cutoffs and length-nibble boundaries round-trip.
+TEST(LZ4CompressionTests, BoundarySizesRoundTrip) {
+    for (size_t size : {size_t(1), size_t(11), size_t(12), size_t(13), size_t(15), size_t(16),
+                        size_t(64), size_t(255), size_t(256), size_t(270)}) {
+        std::vector<char> src = MakeCompressibleData(size);
+        std::vector<char> compressed = Compress(src);
+
+        std::vector<char> decompressed(size);
+        ASSERT_TRUE(LZ4DecompressBlock(compressed.data(), compressed.size(),
+                                       decompressed.data(), decompressed.size()))
+            << "size " << size;
+        EXPECT_EQ(src, decompressed) << "size " << size;
+    }
+}
+
+// Compression reports failure instead of overflowing when the output does not fit.
+TEST(LZ4CompressionTests, CompressOutputTooSmall) {
+    std::vector<char> src = MakeIncompressibleData(4096);
+    std::vector<char> dst(src.size() / 2);
+    EXPECT_EQ(LZ4CompressBlock(src.data(), src.size(), dst.data(), dst.size()), 0u);
+}
+
+// A truncated stream cannot produce the expected output size.
+TEST(LZ4CompressionTests, DecompressRejectsTruncatedInput) {
+    std::vector<char> src = MakeCompressibleData(4096);
+    std::vector<char> compressed = Compress(src);
+
+    std::vector<char> decompressed(src.size());
+    for (size_t truncated : {compressed.size() - 1, compressed.size() / 2, size_t(1), size_t(0)}) {
+        EXPECT_FALSE(LZ4DecompressBlock(compressed.data(), truncated, decompressed.data(),
+                                        decompressed.size()))
+            << "truncated to " << truncated;
+    }
+}
+
+// Decompression only succeeds for the exact uncompressed size the stream encodes.
+TEST(LZ4CompressionTests, DecompressRejectsWrongOutputSize) {
+    std::vector<char> src = MakeCompressibleData(4096);
+    std::vector<char> compressed = Compress(src);
+
+    std::vector<char> decompressed(src.size() + 1);
+    EXPECT_FALSE(LZ4DecompressBlock(compressed.data(), compressed.size(), decompressed.data(),
+                                    src.size() + 1));
+    EXPECT_FALSE(LZ4DecompressBlock(compressed.data(), compressed.size(), decompressed.data(),
+                                    src.size() - 1));
+}
+
+// Flipping any single byte of a valid stream must not read or write out of bounds. The result
+// may be a failure or a same-sized different payload; the sanitizer bots check the rest.
+TEST(LZ4CompressionTests, DecompressCorruptedInputDoesNotOverflow) {
+    std::vector<char> src = MakeCompressibleData(1024);
+    std::vector<char> compressed = Compress(src);
+
+    std::vector<char> decompressed(src.size());
+    for (size_t i = 0; i < compressed.size(); i++) {
+        std::vector<char> corrupted = compressed;
+        corrupted[i] = static_cast<char>(corrupted[i] ^ 0xFF);
+        LZ4DecompressBlock(corrupted.data(), corrupted.size(), decompressed.data(),
+                           decompressed.size());
+    }
+}
+
+// An offset pointing before the start of the output is rejected. An all-zero "compressed"
+// payload encodes exactly that: a zero-literal token followed by a zero offset.
+TEST(LZ4CompressionTests, DecompressRejectsInvalidOffset) {
+    std::vector<char> garbage(16, 0);
+    std::vector<char> decompressed(64);
+    EXPECT_FALSE(
+        LZ4DecompressBlock(garbage.data(), garbage.size(), decompressed.data(),
+                           decompressed.size()));
+}
+
+// A compressible batch round-trips through the framing layer and shrinks on the transport.
+TEST(CommandCompressionTests, CompressedFrameRoundTrip) {
+    std::vector<char> data = MakeCompressibleData(4096);
+    std::vector<char> framed = FrameBatch(data);
+    EXPECT_LT(framed.size(), kFrameHeaderSize + data.size());
+
+    RecordingHandler handler;
+    std::unique_ptr<CommandHandler> decompressing = CreateDecompressingCommandHandler(&handler);
+    ASSERT_NE(decompressing->HandleCommands(framed.data(), framed.size()), nullptr);
+
+    ASSERT_EQ(handler.Batches().size(), 1u);
+    EXPECT_EQ(handler.Batches()[0], data);
+}
+
+// A batch that does not shrink is stored uncompressed in its frame and still round-trips.
+TEST(CommandCompressionTests, StoredFrameRoundTrip) {
+    std::vector<char> data = MakeIncompressibleData(4096);
+    std::vector<char> framed = FrameBatch(data);
+    EXPECT_EQ(framed.size(), kFrameHeaderSize + data.size());
+
+    RecordingHandler handler;
+    std::unique_ptr<CommandHandler> decompressing = CreateDecompressingCommandHandler(&handler);
+    ASSERT_NE(decompressing->HandleCommands(framed.data(), framed.size()), nullptr);
+
+    ASSERT_EQ(handler.Batches().size(), 1u);
+    EXPECT_EQ(handler.Batches()[0], data);
+}
+
+// Frames larger than the transport's maximum allocation size are split into several
+// GetCmdSpace calls without altering the framed bytes.
+TEST(CommandCompressionTests, FrameSplitToTransportAllocationSize) {
+    std::vector<char> data = MakeCompressibleData(4096);
+    std::vector<char> framed = FrameBatch(data, 16);
+    EXPECT_EQ(framed, FrameBatch(data));
+}
+
+// A frame delivered one byte at a time is reassembled and handled exactly once.
+TEST(CommandCompressionTests, FrameReassembledAcrossDeliveries) {
+    std::vector<char> data = MakeCompressibleData(4096);
+    std::vector<char> framed = FrameBatch(data);
+
+    RecordingHandler handler;
+    std::unique_ptr<CommandHandler> decompressing = CreateDecompressingCommandHandler(&handler);
+    for (size_t i = 0; i < framed.size(); i++) {
+        ASSERT_NE(decompressing->HandleCommands(framed.data() + i, 1), nullptr);
+    }
+
+    ASSERT_EQ(handler.Batches().size(), 1u);
+    EXPECT_EQ(handler.Batches()[0], data);
+}
+
+// Several frames arriving in one buffer are each handled as their own batch.
+TEST(CommandCompressionTests, MultipleFramesInOneDelivery) {
+    std::vector<char> first = MakeCompressibleData(512);
+    std::vector<char> second = MakeIncompressibleData(512);
+    std::vector<char> framed = FrameBatch(first);
+    std::vector<char> secondFramed = FrameBatch(second);
+    framed.insert(framed.end(), secondFramed.begin(), secondFramed.end());
+
+    RecordingHandler handler;
+    std::unique_ptr<CommandHandler> decompressing = CreateDecompressingCommandHandler(&handler);
+    ASSERT_NE(decompressing->HandleCommands(framed.data(), framed.size()), nullptr);
+
+    ASSERT_EQ(handler.Batches().size(), 2u);
+    EXPECT_EQ(handler.Batches()[0], first);
+    EXPECT_EQ(handler.Batches()[1], second);
+}
+
+// An incomplete frame is buffered, not handled, until the rest of it arrives.
+TEST(CommandCompressionTests, TruncatedFrameWaitsForMoreData) {
+    std::vector<char> data = MakeCompressibleData(4096);
+    std::vector<char> framed = FrameBatch(data);
+
+    RecordingHandler handler;
+    std::unique_ptr<CommandHandler> decompressing = CreateDecompressingCommandHandler(&handler);
+    size_t split = kFrameHeaderSize + 1;
+    ASSERT_NE(decompressing->HandleCommands(framed.data(), split), nullptr);
+    EXPECT_EQ(handler.Batches().size(), 0u);
+
+    ASSERT_NE(decompressing->HandleCommands(framed.data() + split, framed.size() - split),
+              nullptr);
+    ASSERT_EQ(handler.Batches().size(), 1u);
+    EXPECT_EQ(handler.Batches()[0], data);
+}
+
+// A header advertising an uncompressed size above the frame cap is a fatal error, so a
+// corrupted peer cannot force a giant allocation.
+TEST(CommandCompressionTests, OversizedFrameRejected) {
+    constexpr uint64_t kOverFrameCap = uint64_t(1024) * 1024 * 1024 + 1;
+    std::vector<char> frame = MakeFrame(16, kOverFrameCap, std::vector<char>(16, 0));
+
+    RecordingHandler handler;
+    std::unique_ptr<CommandHandler> decompressing = CreateDecompressingCommandHandler(&handler);
+    EXPECT_EQ(decompressing->HandleCommands(frame.data(), frame.size()), nullptr);
+    EXPECT_EQ(handler.Batches().size(), 0u);
+}
+
+// A header whose compressed size exceeds its uncompressed size is malformed by construction.
+TEST(CommandCompressionTests, CompressedLargerThanUncompressedRejected) {
+    std::vector<char> frame = MakeFrame(32, 16, std::vector<char>(32, 0));
+
+    RecordingHandler handler;
+    std::unique_ptr<CommandHandler> decompressing = CreateDecompressingCommandHandler(&handler);
+    EXPECT_EQ(decompressing->HandleCommands(frame.data(), frame.size()), nullptr);
+    EXPECT_EQ(handler.Batches().size(), 0u);
+}
+
+// A frame whose payload is not a valid LZ4 stream is a fatal error, not a delivery.
+TEST(CommandCompressionTests, CorruptCompressedPayloadRejected) {
+    std::vector<char> frame = MakeFrame(8, 64, std::vector<char>(8, 0));
+
+    RecordingHandler handler;
+    std::unique_ptr<CommandHandler> decompressing = CreateDecompressingCommandHandler(&handler);
+    EXPECT_EQ(decompressing->HandleCommands(frame.data(), frame.size()), nullptr);
+    EXPECT_EQ(handler.Batches().size(), 0u);
+}
+
+}  // namespace dawn::wire
@@ -639,6 +639,82 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapWriteSuccess) {
     EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(serverHandle)).Times(1);
 }
 
+// Test that Unmap only flushes the writable subrange handed out by GetMappedRange instead of
+// the whole mapped region.
+TEST_F(WireMemoryTransferServiceTests, BufferMapWriteFlushesOnlyRangeHandedOut) {
+    // Use a buffer large enough that a strict subrange can be requested.
+    constexpr size_t kLargeBufferSize = 64;
+    static uint32_t largeBufferContent[kLargeBufferSize / sizeof(uint32_t)] = {};
+
+    ClientWriteHandle* clientHandle = clientMemoryTransferService.NewWriteHandle();
+    EXPECT_CALL(clientMemoryTransferService, OnCreateWriteHandle(kLargeBufferSize))
+        .WillOnce(InvokeWithoutArgs([=]() { return clientHandle; }));
+    ExpectWriteHandleSerialization(clientHandle);
+
+    WGPUBufferDescriptor descriptor = {};
+    descriptor.size = kLargeBufferSize;
+    descriptor.usage = WGPUBufferUsage_MapWrite;
+
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &descriptor);
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+
+    ServerWriteHandle* serverHandle = ExpectServerWriteHandleDeserialization();
+
+    FlushClient();
+
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kLargeBufferSize, ToMockBufferMapCallback,
+                       nullptr);
+
+    // Mock a successful callback.
+    EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Write, 0, kLargeBufferSize, _, _))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Success);
+        }));
+    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleGetData(clientHandle))
+        .WillOnce(Return(largeBufferContent));
+    EXPECT_CALL(api, BufferGetMappedRange(apiBuffer, 0, kLargeBufferSize))
+        .WillOnce(Return(largeBufferContent));
+
+    FlushClient();
+
+    // The client receives a successful callback.
+    EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Success, _)).Times(1);
+
+    FlushServer();
+
+    // The client requests a writable pointer to a strict subrange of the mapping.
+    ASSERT_NE(nullptr, wgpuBufferGetMappedRange(buffer, 8, 16));
+
+    // On Unmap, only the subrange handed out is serialized.
+    EXPECT_CALL(clientMemoryTransferService,
+                OnWriteHandleSizeOfSerializeDataUpdate(clientHandle, 8u, 16u))
+        .WillOnce(InvokeWithoutArgs([&]() { return sizeof(mWriteHandleSerializeDataInfo); }));
+    EXPECT_CALL(clientMemoryTransferService,
+                OnWriteHandleSerializeDataUpdate(clientHandle, _, 8u, 16u))
+        .WillOnce(WithArg<1>([&](void* serializePointer) {
+            memcpy(serializePointer, &mWriteHandleSerializeDataInfo,
+                   sizeof(mWriteHandleSerializeDataInfo));
+            return sizeof(mWriteHandleSerializeDataInfo);
+        }));
+
+    wgpuBufferUnmap(buffer);
+
+    // The server deserializes the data update message for the same subrange.
+    EXPECT_CALL(serverMemoryTransferService,
+                OnWriteHandleDeserializeDataUpdate(serverHandle,
+                                                   Pointee(Eq(mWriteHandleSerializeDataInfo)),
+                                                   sizeof(mWriteHandleSerializeDataInfo), 8u, 16u))
+        .WillOnce(Return(true));
+    EXPECT_CALL(api, BufferUnmap(apiBuffer)).Times(1);
+
+    FlushClient();
+
+    // The handle is destroyed once the buffer is destroyed.
+    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
+    EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(serverHandle)).Times(1);
+}
+
 // Test WriteHandle destroy behavior
 TEST_F(WireMemoryTransferServiceTests, BufferMapWriteDestroy) {
     WGPUBuffer buffer;
@@ -0,0 +1,207 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dawn/wire/Wire.h"
+#include "gtest/gtest.h"
+
+namespace dawn::wire {
+
+namespace {
+
+// Fixed-size test command so the merged byte stream can be parsed back: the recording thread
+// and a per-thread sequence number identify each command.
+struct TestCommand {
+    uint64_t threadId;
+    uint64_t sequence;
+};
+
+// CommandSerializer that records every byte it is handed, standing in for the wrapped
+// single-threaded serializer.
+class RecordingSerializer final : public CommandSerializer {
+  public:
+    void* GetCmdSpace(size_t size) override {
+        size_t offset = mBytes.size();
+        mBytes.resize(offset + size);
+        return mBytes.data() + offset;
+    }
+
+    bool Flush() override {
+        mFlushCount++;
+        return true;
+    }
+
+    size_t GetMaximumAllocationSize() const override { return 65536; }
+
+    // Parses the recorded bytes back into test commands. The merge strips the staging
+    // records, so the stream is the plain concatenation of the recorded commands.
+    std::vector<TestCommand> Commands() const {
+        EXPECT_EQ(mBytes.size() % sizeof(TestCommand), 0u);
+        std::vector<TestCommand> commands(mBytes.size() / sizeof(TestCommand));
+        memcpy(commands.data(), mBytes.data(), mBytes.size());
+        return commands;
+    }
+
+    const std::vector<char>& Bytes() const { return mBytes; }
+    uint32_t FlushCount() const { return mFlushCount; }
+
+  private:
+    std::vector<char> mBytes;
+    uint32_t mFlushCount = 0;
+};
+
+void RecordCommand(CommandSerializer* serializer, uint64_t threadId, uint64_t sequence) {
+    TestCommand command{threadId, sequence};
+    void* cmdSpace = serializer->GetCmdSpace(sizeof(command));
+    ASSERT_NE(cmdSpace, nullptr);
+    memcpy(cmdSpace, &command, sizeof(command));
+}
+
+}  // anonymous namespace
+
+// Commands recorded by one thread reach the wrapped serializer in recording order.
+TEST(WireMultiProducerCommandSerializerTests, SingleThreadOrdering) {
+    RecordingSerializer recording;
+    std::unique_ptr<CommandSerializer> serializer =
+        CreateMultiProducerCommandSerializer(&recording);
+    EXPECT_EQ(serializer->GetMaximumAllocationSize(), recording.GetMaximumAllocationSize());
+
+    for (uint64_t i = 0; i < 100; i++) {
+        RecordCommand(serializer.get(), 0, i);
+    }
+    EXPECT_EQ(recording.Bytes().size(), 0u);
+    ASSERT_TRUE(serializer->Flush());
+    EXPECT_EQ(recording.FlushCount(), 1u);
+
+    std::vector<TestCommand> commands = recording.Commands();
+    ASSERT_EQ(commands.size(), 100u);
+    for (uint64_t i = 0; i < 100; i++) {
+        EXPECT_EQ(commands[i].sequence, i);
+    }
+}
+
+// Flushing twice does not replay the commands of the first flush.
+TEST(WireMultiProducerCommandSerializerTests, StagedCommandsClearedByFlush) {
+    RecordingSerializer recording;
+    std::unique_ptr<CommandSerializer> serializer =
+        CreateMultiProducerCommandSerializer(&recording);
+
+    RecordCommand(serializer.get(), 0, 0);
+    ASSERT_TRUE(serializer->Flush());
+    ASSERT_TRUE(serializer->Flush());
+    EXPECT_EQ(recording.FlushCount(), 2u);
+    EXPECT_EQ(recording.Commands().size(), 1u);
+
+    RecordCommand(serializer.get(), 0, 1);
+    ASSERT_TRUE(serializer->Flush());
+    std::vector<TestCommand> commands = recording.Commands();
+    ASSERT_EQ(commands.size(), 2u);
+    EXPECT_EQ(commands[1].sequence, 1u);
+}
+
+// Commands recorded concurrently all arrive, and each thread's commands keep their relative
+// order in the merged stream.
+TEST(WireMultiProducerCommandSerializerTests, ConcurrentRecording) {
+    constexpr uint64_t kThreadCount = 8;
+    constexpr uint64_t kCommandsPerThread = 1000;
+
+    RecordingSerializer recording;
+    std::unique_ptr<CommandSerializer> serializer =
+        CreateMultiProducerCommandSerializer(&recording);
+
+    std::vector<std::thread> threads;
+    for (uint64_t threadId = 0; threadId < kThreadCount; threadId++) {
+        threads.emplace_back([&serializer, threadId] {
+            for (uint64_t i = 0; i < kCommandsPerThread; i++) {
+                RecordCommand(serializer.get(), threadId, i);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    ASSERT_TRUE(serializer->Flush());
+
+    std::vector<TestCommand> commands = recording.Commands();
+    ASSERT_EQ(commands.size(), kThreadCount * kCommandsPerThread);
+    std::map<uint64_t, uint64_t> nextSequence;
+    for (const TestCommand& command : commands) {
+        EXPECT_EQ(command.sequence, nextSequence[command.threadId]);
+        nextSequence[command.threadId]++;
+    }
+    for (uint64_t threadId = 0; threadId < kThreadCount; threadId++) {
+        EXPECT_EQ(nextSequence[threadId], kCommandsPerThread);
+    }
+}
+
+// A command recorded after another thread's recording completed merges after it, so
+// dependencies established by handing an object between threads keep their wire order.
+TEST(WireMultiProducerCommandSerializerTests, CrossThreadOrdering) {
+    RecordingSerializer recording;
+    std::unique_ptr<CommandSerializer> serializer =
+        CreateMultiProducerCommandSerializer(&recording);
+
+    std::thread first([&serializer] { RecordCommand(serializer.get(), 1, 0); });
+    first.join();
+    RecordCommand(serializer.get(), 2, 0);
+    ASSERT_TRUE(serializer->Flush());
+
+    std::vector<TestCommand> commands = recording.Commands();
+    ASSERT_EQ(commands.size(), 2u);
+    EXPECT_EQ(commands[0].threadId, 1u);
+    EXPECT_EQ(commands[1].threadId, 2u);
+}
+
+// Distinct serializer instances used from the same thread keep separate staging buffers.
+TEST(WireMultiProducerCommandSerializerTests, InstancesDoNotShareBuffers) {
+    RecordingSerializer firstRecording;
+    RecordingSerializer secondRecording;
+    std::unique_ptr<CommandSerializer> first =
+        CreateMultiProducerCommandSerializer(&firstRecording);
+    std::unique_ptr<CommandSerializer> second =
+        CreateMultiProducerCommandSerializer(&secondRecording);
+
+    RecordCommand(first.get(), 1, 0);
+    RecordCommand(second.get(), 2, 0);
+    RecordCommand(first.get(), 1, 1);
+    ASSERT_TRUE(first->Flush());
+    ASSERT_TRUE(second->Flush());
+
+    std::vector<TestCommand> firstCommands = firstRecording.Commands();
+    ASSERT_EQ(firstCommands.size(), 2u);
+    EXPECT_EQ(firstCommands[0].threadId, 1u);
+    EXPECT_EQ(firstCommands[1].sequence, 1u);
+
+    std::vector<TestCommand> secondCommands = secondRecording.Commands();
+    ASSERT_EQ(secondCommands.size(), 1u);
+    EXPECT_EQ(secondCommands[0].threadId, 2u);
+}
+
+// An empty flush still flushes the wrapped serializer so buffered transports make progress.
+TEST(WireMultiProducerCommandSerializerTests, EmptyFlushForwards) {
+    RecordingSerializer recording;
+    std::unique_ptr<CommandSerializer> serializer =
+        CreateMultiProducerCommandSerializer(&recording);
+
+    ASSERT_TRUE(serializer->Flush());
+    EXPECT_EQ(recording.FlushCount(), 1u);
+    EXPECT_EQ(recording.Bytes().size(), 0u);
+}
+
+}  // namespace dawn::wire
@@ -22,6 +22,7 @@ namespace dawn::wire {
 using testing::_;
 using testing::InvokeWithoutArgs;
 using testing::Mock;
+using testing::Return;
 
 class MockQueueWorkDoneCallback {
   public:
@@ -77,6 +78,37 @@ TEST_F(WireQueueTests, OnSubmittedWorkDoneError) {
     FlushServer();
 }
 
+// Test that several completions arriving in the same server flush are delivered as one
+// watermark that fans out to every registered callback on the client.
+TEST_F(WireQueueTests, OnSubmittedWorkDoneWatermarkFanOut) {
+    wgpuQueueOnSubmittedWorkDone(queue, 0u, ToMockQueueWorkDone, this);
+    wgpuQueueOnSubmittedWorkDone(queue, 0u, ToMockQueueWorkDone, this);
+    EXPECT_CALL(api, OnQueueOnSubmittedWorkDone(apiQueue, 0u, _, _))
+        .Times(2)
+        .WillRepeatedly(InvokeWithoutArgs([&]() {
+            api.CallQueueOnSubmittedWorkDoneCallback(apiQueue, WGPUQueueWorkDoneStatus_Success);
+        }));
+    FlushClient();
+
+    EXPECT_CALL(*mockQueueWorkDoneCallback, Call(WGPUQueueWorkDoneStatus_Success, this)).Times(2);
+    FlushServer();
+}
+
+// Test that a completion firing outside of any command stream (as from the embedder ticking
+// the device while the client is quiescent) is returned immediately instead of waiting for
+// the end-of-stream flush of a later command batch.
+TEST_F(WireQueueTests, OnSubmittedWorkDoneOutsideCommandStream) {
+    wgpuQueueOnSubmittedWorkDone(queue, 0u, ToMockQueueWorkDone, this);
+    EXPECT_CALL(api, OnQueueOnSubmittedWorkDone(apiQueue, 0u, _, _)).Times(1);
+    FlushClient();
+
+    // Fire the completion directly, not from inside the server's HandleCommands.
+    api.CallQueueOnSubmittedWorkDoneCallback(apiQueue, WGPUQueueWorkDoneStatus_Success);
+
+    EXPECT_CALL(*mockQueueWorkDoneCallback, Call(WGPUQueueWorkDoneStatus_Success, this)).Times(1);
+    FlushServer();
+}
+
 // Test registering an OnSubmittedWorkDone then disconnecting the wire calls the callback with
 // device loss
 TEST_F(WireQueueTests, OnSubmittedWorkDoneBeforeDisconnect) {
@@ -193,6 +225,41 @@ TEST_F(WireQueueTests, DeviceThenDefaultQueueReleased) {
     DefaultApiDeviceWasReleased();
 }
 
+// Test that writes the client can prove invalid are rejected client-side: the server sees the
+// injected error but never the write itself, while valid writes are forwarded unchanged.
+TEST_F(WireQueueTests, WriteBufferClientSideValidation) {
+    WGPUBufferDescriptor descriptor = {};
+    descriptor.size = 16;
+    descriptor.usage = WGPUBufferUsage_CopyDst;
+
+    WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &descriptor);
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+    FlushClient();
+
+    uint32_t data[8] = {};
+
+    // An unaligned offset is rejected without serializing the write.
+    wgpuQueueWriteBuffer(queue, buffer, 2, data, 4);
+    EXPECT_CALL(api, DeviceInjectError(apiDevice, WGPUErrorType_Validation, _)).Times(1);
+    FlushClient();
+
+    // An unaligned size is rejected without serializing the write.
+    wgpuQueueWriteBuffer(queue, buffer, 0, data, 3);
+    EXPECT_CALL(api, DeviceInjectError(apiDevice, WGPUErrorType_Validation, _)).Times(1);
+    FlushClient();
+
+    // A write past the end of the buffer is rejected without serializing the write.
+    wgpuQueueWriteBuffer(queue, buffer, 0, data, 32);
+    EXPECT_CALL(api, DeviceInjectError(apiDevice, WGPUErrorType_Validation, _)).Times(1);
+    FlushClient();
+
+    // A valid write is forwarded to the server.
+    wgpuQueueWriteBuffer(queue, buffer, 0, data, 16);
+    EXPECT_CALL(api, QueueWriteBuffer(apiQueue, apiBuffer, 0, _, 16)).Times(1);
+    FlushClient();
+}
+
 // Only one default queue is supported now so we cannot test ~Queue triggering ClearAllCallbacks
 // since it is always destructed after the test TearDown, and we cannot create a new queue obj
 // with wgpuDeviceGetQueue
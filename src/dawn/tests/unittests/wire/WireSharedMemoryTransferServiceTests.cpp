@@ -0,0 +1,253 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/common/Platform.h"
+
+#if DAWN_PLATFORM_IS(POSIX)
+
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dawn/wire/SharedMemoryTransferHelpers.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireServer.h"
+#include "gtest/gtest.h"
+
+namespace dawn::wire {
+
+namespace {
+
+// Mirror of the serialized create info layout: two little-endian uint64 sizes followed by the
+// segment name. Tests build malformed create infos against this layout.
+struct SegmentCreateInfo {
+    uint64_t size;
+    uint64_t nameLength;
+};
+
+std::string MakeTestSegmentName() {
+    static uint64_t sCounter = 0;
+    return "/dawn-wire-test-" + std::to_string(getpid()) + "-" + std::to_string(sCounter++);
+}
+
+std::vector<char> MakeCreateInfo(uint64_t size, uint64_t nameLength, const std::string& name) {
+    SegmentCreateInfo info{size, nameLength};
+    std::vector<char> result(sizeof(info) + name.length());
+    memcpy(result.data(), &info, sizeof(info));
+    memcpy(result.data() + sizeof(info), name.data(), name.length());
+    return result;
+}
+
+std::vector<char> SerializeCreate(client::MemoryTransferService::WriteHandle* handle) {
+    std::vector<char> result(handle->SerializeCreateSize());
+    handle->SerializeCreate(result.data());
+    return result;
+}
+
+std::vector<char> SerializeCreate(client::MemoryTransferService::ReadHandle* handle) {
+    std::vector<char> result(handle->SerializeCreateSize());
+    handle->SerializeCreate(result.data());
+    return result;
+}
+
+class WireSharedMemoryTransferServiceTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        mClientService = client::CreateSharedMemoryTransferService();
+        mServerService = server::CreateSharedMemoryTransferService();
+        ASSERT_NE(mClientService, nullptr);
+        ASSERT_NE(mServerService, nullptr);
+    }
+
+    std::unique_ptr<client::MemoryTransferService> mClientService;
+    std::unique_ptr<server::MemoryTransferService> mServerService;
+};
+
+}  // anonymous namespace
+
+// Both sides of a deserialized segment address the same pages.
+TEST(SharedMemorySegmentTests, CreateAndDeserializeShareData) {
+    SharedMemorySegment created;
+    ASSERT_TRUE(created.Create(MakeTestSegmentName(), 4096));
+    ASSERT_NE(created.GetData(), nullptr);
+    EXPECT_EQ(created.GetSize(), 4096u);
+
+    std::vector<char> createInfo(created.SerializeCreateSize());
+    created.SerializeCreate(createInfo.data());
+
+    SharedMemorySegment opened;
+    ASSERT_TRUE(opened.Deserialize(createInfo.data(), createInfo.size()));
+    EXPECT_EQ(opened.GetSize(), 4096u);
+
+    memset(created.GetData(), 0xAB, 4096);
+    EXPECT_EQ(memcmp(opened.GetData(), created.GetData(), 4096), 0);
+    static_cast<char*>(opened.GetData())[0] = 0x17;
+    EXPECT_EQ(static_cast<char*>(created.GetData())[0], 0x17);
+
+    opened.Destroy(false);
+    created.Destroy(true);
+}
+
+// A name can be reused once the creating side unlinked it.
+TEST(SharedMemorySegmentTests, CreateRequiresFreshName) {
+    std::string name = MakeTestSegmentName();
+    SharedMemorySegment first;
+    ASSERT_TRUE(first.Create(name, 64));
+
+    SharedMemorySegment second;
+    EXPECT_FALSE(second.Create(name, 64));
+
+    first.Destroy(true);
+    ASSERT_TRUE(second.Create(name, 64));
+    second.Destroy(true);
+}
+
+// Malformed create infos never produce a handle on the server.
+TEST_F(WireSharedMemoryTransferServiceTests, DeserializeRejectsMalformedCreateInfo) {
+    std::string name = "/dawn-wire-test-does-not-exist";
+    std::vector<char> valid = MakeCreateInfo(64, name.length(), name);
+
+    server::MemoryTransferService::WriteHandle* writeHandle = nullptr;
+    server::MemoryTransferService::ReadHandle* readHandle = nullptr;
+
+    // Nothing to deserialize at all.
+    EXPECT_FALSE(mServerService->DeserializeWriteHandle(nullptr, 0, &writeHandle));
+    EXPECT_FALSE(mServerService->DeserializeReadHandle(nullptr, 0, &readHandle));
+
+    // Truncated header.
+    for (size_t size : {size_t(1), sizeof(SegmentCreateInfo) - 1}) {
+        EXPECT_FALSE(mServerService->DeserializeWriteHandle(valid.data(), size, &writeHandle));
+        EXPECT_FALSE(mServerService->DeserializeReadHandle(valid.data(), size, &readHandle));
+    }
+
+    // A zero-sized segment.
+    std::vector<char> zeroSize = MakeCreateInfo(0, name.length(), name);
+    EXPECT_FALSE(
+        mServerService->DeserializeWriteHandle(zeroSize.data(), zeroSize.size(), &writeHandle));
+
+    // An empty name.
+    std::vector<char> emptyName = MakeCreateInfo(64, 0, "");
+    EXPECT_FALSE(
+        mServerService->DeserializeWriteHandle(emptyName.data(), emptyName.size(), &writeHandle));
+
+    // A name length beyond what shm_open could ever accept.
+    std::vector<char> hugeName = MakeCreateInfo(64, 256, name);
+    EXPECT_FALSE(
+        mServerService->DeserializeWriteHandle(hugeName.data(), hugeName.size(), &writeHandle));
+
+    // A name length pointing past the end of the create info.
+    std::vector<char> shortName = MakeCreateInfo(64, name.length() + 1, name);
+    EXPECT_FALSE(
+        mServerService->DeserializeWriteHandle(shortName.data(), shortName.size(), &writeHandle));
+
+    // A well-formed create info naming a segment that does not exist.
+    EXPECT_FALSE(mServerService->DeserializeWriteHandle(valid.data(), valid.size(), &writeHandle));
+    EXPECT_FALSE(mServerService->DeserializeReadHandle(valid.data(), valid.size(), &readHandle));
+
+    EXPECT_EQ(writeHandle, nullptr);
+    EXPECT_EQ(readHandle, nullptr);
+}
+
+// A forged size larger than the real segment is caught before the size is trusted.
+TEST_F(WireSharedMemoryTransferServiceTests, DeserializeRejectsForgedSize) {
+    std::unique_ptr<client::MemoryTransferService::WriteHandle> clientHandle(
+        mClientService->CreateWriteHandle(64));
+    ASSERT_NE(clientHandle, nullptr);
+    std::vector<char> createInfo = SerializeCreate(clientHandle.get());
+
+    std::vector<char> forged = createInfo;
+    uint64_t forgedSize = 1 << 20;
+    memcpy(forged.data(), &forgedSize, sizeof(forgedSize));
+
+    server::MemoryTransferService::WriteHandle* serverHandle = nullptr;
+    EXPECT_FALSE(
+        mServerService->DeserializeWriteHandle(forged.data(), forged.size(), &serverHandle));
+
+    // The untampered create info deserializes fine.
+    ASSERT_TRUE(
+        mServerService->DeserializeWriteHandle(createInfo.data(), createInfo.size(),
+                                               &serverHandle));
+    delete serverHandle;
+}
+
+// Data written by the client lands in the mapped buffer through an empty data update command.
+TEST_F(WireSharedMemoryTransferServiceTests, WriteHandleRoundTrip) {
+    constexpr size_t kSize = 64;
+    std::unique_ptr<client::MemoryTransferService::WriteHandle> clientHandle(
+        mClientService->CreateWriteHandle(kSize));
+    ASSERT_NE(clientHandle, nullptr);
+    ASSERT_NE(clientHandle->GetData(), nullptr);
+
+    std::vector<char> createInfo = SerializeCreate(clientHandle.get());
+    server::MemoryTransferService::WriteHandle* serverHandle = nullptr;
+    ASSERT_TRUE(mServerService->DeserializeWriteHandle(createInfo.data(), createInfo.size(),
+                                                       &serverHandle));
+
+    // The update command carries no payload; the data moves through the shared pages.
+    EXPECT_EQ(clientHandle->SizeOfSerializeDataUpdate(0, kSize), 0u);
+    for (size_t i = 0; i < kSize; i++) {
+        static_cast<char*>(clientHandle->GetData())[i] = static_cast<char>(i);
+    }
+
+    char target[kSize] = {};
+    serverHandle->SetTarget(target);
+    serverHandle->SetDataLength(kSize);
+    ASSERT_TRUE(serverHandle->DeserializeDataUpdate(nullptr, 0, 0, kSize));
+    EXPECT_EQ(memcmp(target, clientHandle->GetData(), kSize), 0);
+
+    // A non-empty payload or an out-of-bounds range is rejected.
+    char bogus = 0;
+    EXPECT_FALSE(serverHandle->DeserializeDataUpdate(&bogus, 1, 0, kSize));
+    EXPECT_FALSE(serverHandle->DeserializeDataUpdate(nullptr, 0, 1, kSize));
+    EXPECT_FALSE(serverHandle->DeserializeDataUpdate(nullptr, 0, kSize + 1, 0));
+
+    delete serverHandle;
+}
+
+// Data written by the server is visible to the client through the shared pages.
+TEST_F(WireSharedMemoryTransferServiceTests, ReadHandleRoundTrip) {
+    constexpr size_t kSize = 64;
+    std::unique_ptr<client::MemoryTransferService::ReadHandle> clientHandle(
+        mClientService->CreateReadHandle(kSize));
+    ASSERT_NE(clientHandle, nullptr);
+
+    std::vector<char> createInfo = SerializeCreate(clientHandle.get());
+    server::MemoryTransferService::ReadHandle* serverHandle = nullptr;
+    ASSERT_TRUE(mServerService->DeserializeReadHandle(createInfo.data(), createInfo.size(),
+                                                      &serverHandle));
+
+    char data[kSize];
+    for (size_t i = 0; i < kSize; i++) {
+        data[i] = static_cast<char>(kSize - i);
+    }
+    EXPECT_EQ(serverHandle->SizeOfSerializeDataUpdate(0, kSize), 0u);
+    serverHandle->SerializeDataUpdate(data, 0, kSize, nullptr);
+
+    ASSERT_TRUE(clientHandle->DeserializeDataUpdate(nullptr, 0, 0, kSize));
+    EXPECT_EQ(memcmp(clientHandle->GetData(), data, kSize), 0);
+
+    // A non-empty payload or an out-of-bounds range is rejected.
+    char bogus = 0;
+    EXPECT_FALSE(clientHandle->DeserializeDataUpdate(&bogus, 1, 0, kSize));
+    EXPECT_FALSE(clientHandle->DeserializeDataUpdate(nullptr, 0, 1, kSize));
+
+    delete serverHandle;
+}
+
+}  // namespace dawn::wire
+
+#endif  // DAWN_PLATFORM_IS(POSIX)
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <vector>
 
 #include "dawn/native/Buffer.h"
@@ -25,10 +26,13 @@ namespace {
 void EncodeConvertTimestampsToNanoseconds(wgpu::CommandEncoder encoder,
                                           wgpu::Buffer timestamps,
                                           wgpu::Buffer availability,
-                                          wgpu::Buffer params) {
+                                          wgpu::Buffer ranges,
+                                          wgpu::Buffer params,
+                                          uint32_t totalQueryCount) {
     ASSERT_TRUE(dawn::native::EncodeConvertTimestampsToNanoseconds(
                     dawn::native::FromAPI(encoder.Get()), dawn::native::FromAPI(timestamps.Get()),
-                    dawn::native::FromAPI(availability.Get()), dawn::native::FromAPI(params.Get()))
+                    dawn::native::FromAPI(availability.Get()), dawn::native::FromAPI(ranges.Get()),
+                    dawn::native::FromAPI(params.Get()), totalQueryCount)
                     .IsSuccess());
 }
 
@@ -110,6 +114,17 @@ class QueryInternalShaderTests : public DawnTest {
     // Timestamps available state
     const std::vector<uint32_t> availabilities = {0, 1, 1, 0, 1, 1, 1, 1, 1, 1};
 
+    // The availability bitset passed to the shader packs one bit per query into u32 words.
+    std::vector<uint32_t> PackedAvailability() const {
+        std::vector<uint32_t> words((kQueryCount + 31) / 32, 0);
+        for (uint32_t i = 0; i < kQueryCount; ++i) {
+            if (availabilities[i] != 0) {
+                words[i / 32] |= 1u << (i % 32);
+            }
+        }
+        return words;
+    }
+
     const std::vector<uint64_t> GetExpectedResults(const std::vector<uint64_t>& origin,
                                                    uint32_t start,
                                                    uint32_t firstQuery,
@@ -130,13 +145,14 @@ class QueryInternalShaderTests : public DawnTest {
         return expected;
     }
 
-    void RunTest(uint32_t firstQuery,
-                 uint32_t queryCount,
-                 uint32_t destinationOffset,
-                 float period) {
-        ASSERT(destinationOffset % 256 == 0);
-
-        uint64_t size = queryCount * sizeof(uint64_t) + destinationOffset;
+    void RunTest(const std::vector<dawn::native::TimestampResolveRange>& ranges, float period) {
+        uint64_t size = 0;
+        uint32_t totalQueryCount = 0;
+        for (const dawn::native::TimestampResolveRange& range : ranges) {
+            ASSERT(range.offset % 256 == 0);
+            size = std::max(size, uint64_t(range.count) * sizeof(uint64_t) + range.offset);
+            totalQueryCount += range.count;
+        }
 
         // The resolve buffer storing original timestamps and the converted values
         wgpu::BufferDescriptor timestampsDesc;
@@ -145,39 +161,55 @@ class QueryInternalShaderTests : public DawnTest {
                                wgpu::BufferUsage::CopyDst;
         wgpu::Buffer timestampsBuffer = device.CreateBuffer(&timestampsDesc);
 
-        // Set sentinel values to check the slots before the destination offset should not be
-        // converted
+        // Set sentinel values to check the slots outside the ranges should not be converted
         std::vector<uint64_t> timestampValues(size / sizeof(uint64_t), 1u);
-        uint32_t start = destinationOffset / sizeof(uint64_t);
-        for (uint32_t i = 0; i < queryCount; i++) {
-            timestampValues[start + i] = querySetValues[firstQuery + i];
+        for (const dawn::native::TimestampResolveRange& range : ranges) {
+            uint32_t start = range.offset / sizeof(uint64_t);
+            for (uint32_t i = 0; i < range.count; i++) {
+                timestampValues[start + i] = querySetValues[range.first + i];
+            }
         }
         // Write sentinel values and orignal timestamps to timestamps buffer
         queue.WriteBuffer(timestampsBuffer, 0, timestampValues.data(), size);
 
-        // The buffer indicating which values are available timestamps
-        wgpu::Buffer availabilityBuffer =
-            utils::CreateBufferFromData(device, availabilities.data(),
-                                        kQueryCount * sizeof(uint32_t), wgpu::BufferUsage::Storage);
+        // The buffer indicating which values are available timestamps, one bit per query
+        std::vector<uint32_t> availabilityWords = PackedAvailability();
+        wgpu::Buffer availabilityBuffer = utils::CreateBufferFromData(
+            device, availabilityWords.data(), availabilityWords.size() * sizeof(uint32_t),
+            wgpu::BufferUsage::Storage);
+
+        // The buffer holding the resolved ranges converted by this dispatch
+        wgpu::Buffer rangesBuffer = utils::CreateBufferFromData(
+            device, ranges.data(), ranges.size() * sizeof(dawn::native::TimestampResolveRange),
+            wgpu::BufferUsage::Storage);
 
         // The params uniform buffer
-        dawn::native::TimestampParams params(firstQuery, queryCount, destinationOffset, period);
+        dawn::native::TimestampParams params(ranges.size(), period);
         wgpu::Buffer paramsBuffer = utils::CreateBufferFromData(device, &params, sizeof(params),
                                                                 wgpu::BufferUsage::Uniform);
 
         wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
         EncodeConvertTimestampsToNanoseconds(encoder, timestampsBuffer, availabilityBuffer,
-                                             paramsBuffer);
+                                             rangesBuffer, paramsBuffer, totalQueryCount);
         wgpu::CommandBuffer commands = encoder.Finish();
         queue.Submit(1, &commands);
 
-        const std::vector<uint64_t> expected =
-            GetExpectedResults(timestampValues, start, firstQuery, queryCount, period);
+        std::vector<uint64_t> expected = timestampValues;
+        for (const dawn::native::TimestampResolveRange& range : ranges) {
+            expected = GetExpectedResults(expected, range.offset / sizeof(uint64_t), range.first,
+                                          range.count, period);
+        }
 
         EXPECT_BUFFER(timestampsBuffer, 0, size,
                       new InternalShaderExpectation(expected.data(), size / sizeof(uint64_t)))
-            << "Conversion test for period:" << period << " firstQuery:" << firstQuery
-            << " queryCount:" << queryCount << " destinationOffset:" << destinationOffset;
+            << "Conversion test for period:" << period << " rangeCount:" << ranges.size();
+    }
+
+    void RunTest(uint32_t firstQuery,
+                 uint32_t queryCount,
+                 uint32_t destinationOffset,
+                 float period) {
+        RunTest({{firstQuery, queryCount, destinationOffset}}, period);
     }
 };
 
@@ -218,6 +250,11 @@ TEST_P(QueryInternalShaderTests, TimestampComputeShader) {
         // Convert partial timestamps in timestamps buffer with offset 256
         // Test for ResolveQuerySet(querySet, 1, 4, timestampsBuffer, 256)
         RunTest(1, 4, 256, period);
+
+        // Convert two resolved ranges with a single dispatch
+        // Test for ResolveQuerySet(querySet, 0, 3, timestampsBuffer, 0) followed by
+        // ResolveQuerySet(querySet, 4, 6, timestampsBuffer, 256) in the same command encoder
+        RunTest({{0, 3, 0}, {4, 6, 256}}, period);
     }
 }
 
@@ -16,9 +16,11 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 #include <utility>
 
 #include "dawn/common/Alloc.h"
+#include "dawn/common/Math.h"
 
 namespace dawn::wire {
 
@@ -47,7 +49,17 @@ const volatile char* ChunkedCommandHandler::HandleCommands(const volatile char*
             // Once the chunked command is complete, pass the data to the command handler
             // implemenation.
             auto chunkedCommandData = std::move(mChunkedCommandData);
-            if (HandleCommandsImpl(chunkedCommandData.get(), mChunkedCommandPutOffset) == nullptr) {
+            const volatile char* result =
+                HandleCommandsImpl(chunkedCommandData.get(), mChunkedCommandPutOffset);
+
+            // Retain the buffer for the next chunked command if it is the largest seen so far.
+            if (mChunkedCommandAllocationSize > mRetainedChunkedCommandDataSize) {
+                mRetainedChunkedCommandData = std::move(chunkedCommandData);
+                mRetainedChunkedCommandDataSize = mChunkedCommandAllocationSize;
+            }
+            mChunkedCommandAllocationSize = 0;
+
+            if (result == nullptr) {
                 // |HandleCommandsImpl| returns nullptr on error. Forward any errors
                 // out.
                 return nullptr;
@@ -65,10 +77,24 @@ ChunkedCommandHandler::ChunkedCommandsResult ChunkedCommandHandler::BeginChunked
     ASSERT(!mChunkedCommandData);
 
     // Reserve space for all the command data we're expecting, and copy the initial data
-    // to the start of the memory.
-    mChunkedCommandData.reset(AllocNoThrow<char>(commandSize));
-    if (!mChunkedCommandData) {
-        return ChunkedCommandsResult::Error;
+    // to the start of the memory. The retained buffer from a previous chunked command is
+    // reused when it is large enough; otherwise the allocation is rounded up to a
+    // power-of-two size class so that commands of similar sizes hit the retained buffer
+    // instead of reallocating.
+    if (mRetainedChunkedCommandDataSize >= commandSize) {
+        mChunkedCommandData = std::move(mRetainedChunkedCommandData);
+        mChunkedCommandAllocationSize = mRetainedChunkedCommandDataSize;
+        mRetainedChunkedCommandDataSize = 0;
+    } else {
+        size_t allocationSize = commandSize;
+        if (commandSize <= std::numeric_limits<size_t>::max() / 2) {
+            allocationSize = static_cast<size_t>(NextPowerOfTwo(commandSize));
+        }
+        mChunkedCommandData.reset(AllocNoThrow<char>(allocationSize));
+        if (!mChunkedCommandData) {
+            return ChunkedCommandsResult::Error;
+        }
+        mChunkedCommandAllocationSize = allocationSize;
     }
 
     memcpy(mChunkedCommandData.get(), const_cast<const char*>(commands), initialSize);
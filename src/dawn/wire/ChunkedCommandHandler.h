@@ -65,6 +65,13 @@ class ChunkedCommandHandler : public CommandHandler {
     size_t mChunkedCommandRemainingSize = 0;
     size_t mChunkedCommandPutOffset = 0;
     std::unique_ptr<char[]> mChunkedCommandData;
+    size_t mChunkedCommandAllocationSize = 0;
+
+    // The last reassembly buffer, retained at its high-water size so that steady streams of
+    // chunked commands (large WriteBuffer uploads) reuse a single allocation instead of
+    // allocating and freeing one per command.
+    std::unique_ptr<char[]> mRetainedChunkedCommandData;
+    size_t mRetainedChunkedCommandDataSize = 0;
 };
 
 }  // namespace dawn::wire
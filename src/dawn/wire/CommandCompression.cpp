@@ -0,0 +1,233 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#include "dawn/common/Alloc.h"
+#include "dawn/common/Assert.h"
+#include "dawn/wire/LZ4Compression.h"
+#include "dawn/wire/Wire.h"
+
+namespace dawn::wire {
+
+namespace {
+
+// Frame emitted for each flush batch. compressedSize == uncompressedSize means the payload is
+// stored uncompressed, which happens when compression would not shrink the batch.
+struct FrameHeader {
+    uint64_t compressedSize;
+    uint64_t uncompressedSize;
+};
+
+// Upper bound on a single frame's uncompressed size. Batches are bounded by how much the
+// client serializes between flushes; this guard keeps a corrupted or malicious header from
+// triggering a giant allocation on the receiving side.
+constexpr uint64_t kMaxFrameSize = 1024 * 1024 * 1024;
+
+// Growable byte buffer backed by AllocNoThrow so that peer-controlled sizes fail gracefully
+// instead of aborting on allocation failure.
+class ByteBuffer {
+  public:
+    // Returns a pointer to `size` fresh bytes appended at the end, or nullptr on failure.
+    char* Allocate(size_t size) {
+        if (size > mCapacity - mSize) {
+            size_t newCapacity = std::max(mCapacity + mCapacity / 2, mSize + size);
+            newCapacity = std::max(newCapacity, size_t(16384));
+            std::unique_ptr<char[]> newData(AllocNoThrow<char>(newCapacity));
+            if (!newData) {
+                return nullptr;
+            }
+            if (mSize > 0) {
+                memcpy(newData.get(), mData.get(), mSize);
+            }
+            mData = std::move(newData);
+            mCapacity = newCapacity;
+        }
+        char* result = mData.get() + mSize;
+        mSize += size;
+        return result;
+    }
+
+    bool Append(const void* data, size_t size) {
+        char* dst = Allocate(size);
+        if (dst == nullptr) {
+            return false;
+        }
+        memcpy(dst, data, size);
+        return true;
+    }
+
+    // Discards the first `count` bytes, keeping the rest.
+    void PopFront(size_t count) {
+        ASSERT(count <= mSize);
+        memmove(mData.get(), mData.get() + count, mSize - count);
+        mSize -= count;
+    }
+
+    void Clear() { mSize = 0; }
+
+    char* Data() { return mData.get(); }
+    size_t Size() const { return mSize; }
+
+  private:
+    std::unique_ptr<char[]> mData;
+    size_t mSize = 0;
+    size_t mCapacity = 0;
+};
+
+class CompressingCommandSerializer final : public CommandSerializer {
+  public:
+    explicit CompressingCommandSerializer(CommandSerializer* serializer)
+        : mSerializer(serializer) {}
+    ~CompressingCommandSerializer() override = default;
+
+    void* GetCmdSpace(size_t size) override { return mBatch.Allocate(size); }
+
+    bool Flush() override {
+        if (mBatch.Size() == 0) {
+            return mSerializer->Flush();
+        }
+
+        FrameHeader header;
+        header.uncompressedSize = mBatch.Size();
+        const char* payload = mBatch.Data();
+
+        mScratch.Clear();
+        size_t bound = LZ4CompressBound(mBatch.Size());
+        char* scratch = mScratch.Allocate(bound);
+        size_t compressedSize =
+            scratch != nullptr ? LZ4CompressBlock(mBatch.Data(), mBatch.Size(), scratch, bound)
+                               : 0;
+        if (compressedSize != 0 && compressedSize < mBatch.Size()) {
+            header.compressedSize = compressedSize;
+            payload = scratch;
+        } else {
+            // Compression failed or did not help; store the batch as-is.
+            header.compressedSize = mBatch.Size();
+        }
+
+        bool success = SendBytes(&header, sizeof(header)) &&
+                       SendBytes(payload, static_cast<size_t>(header.compressedSize));
+        mBatch.Clear();
+        if (!success) {
+            return false;
+        }
+        return mSerializer->Flush();
+    }
+
+    size_t GetMaximumAllocationSize() const override {
+        return mSerializer->GetMaximumAllocationSize();
+    }
+
+    void OnSerializeError() override { mSerializer->OnSerializeError(); }
+
+  private:
+    // Forwards a byte range to the wrapped serializer, splitting it to respect the wrapped
+    // serializer's maximum allocation size.
+    bool SendBytes(const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        size_t maxAllocationSize = mSerializer->GetMaximumAllocationSize();
+        while (size > 0) {
+            size_t chunkSize = std::min(size, maxAllocationSize);
+            void* cmdSpace = mSerializer->GetCmdSpace(chunkSize);
+            if (cmdSpace == nullptr) {
+                return false;
+            }
+            memcpy(cmdSpace, bytes, chunkSize);
+            bytes += chunkSize;
+            size -= chunkSize;
+        }
+        return true;
+    }
+
+    CommandSerializer* mSerializer;
+    ByteBuffer mBatch;
+    ByteBuffer mScratch;
+};
+
+class DecompressingCommandHandler final : public CommandHandler {
+  public:
+    explicit DecompressingCommandHandler(CommandHandler* handler) : mHandler(handler) {}
+    ~DecompressingCommandHandler() override = default;
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        // Frames may be split across transport packets; buffer until a whole frame arrived.
+        if (!mReceived.Append(const_cast<const char*>(commands), size)) {
+            return nullptr;
+        }
+
+        size_t consumed = 0;
+        while (true) {
+            size_t remaining = mReceived.Size() - consumed;
+            if (remaining < sizeof(FrameHeader)) {
+                break;
+            }
+            FrameHeader header;
+            memcpy(&header, mReceived.Data() + consumed, sizeof(header));
+            if (header.compressedSize > header.uncompressedSize ||
+                header.uncompressedSize > kMaxFrameSize) {
+                return nullptr;
+            }
+            size_t compressedSize = static_cast<size_t>(header.compressedSize);
+            size_t uncompressedSize = static_cast<size_t>(header.uncompressedSize);
+            if (remaining - sizeof(header) < compressedSize) {
+                break;
+            }
+            const char* payload = mReceived.Data() + consumed + sizeof(header);
+
+            if (compressedSize == uncompressedSize) {
+                // Stored frame; the payload is the command data itself.
+                if (mHandler->HandleCommands(payload, uncompressedSize) == nullptr) {
+                    return nullptr;
+                }
+            } else {
+                mDecompressed.Clear();
+                char* decompressed = mDecompressed.Allocate(uncompressedSize);
+                if (decompressed == nullptr ||
+                    !LZ4DecompressBlock(payload, compressedSize, decompressed,
+                                        uncompressedSize)) {
+                    return nullptr;
+                }
+                if (mHandler->HandleCommands(decompressed, uncompressedSize) == nullptr) {
+                    return nullptr;
+                }
+            }
+            consumed += sizeof(header) + compressedSize;
+        }
+
+        mReceived.PopFront(consumed);
+        return commands + size;
+    }
+
+  private:
+    CommandHandler* mHandler;
+    ByteBuffer mReceived;
+    ByteBuffer mDecompressed;
+};
+
+}  // anonymous namespace
+
+std::unique_ptr<CommandSerializer> CreateCompressingCommandSerializer(
+    CommandSerializer* serializer) {
+    return std::make_unique<CompressingCommandSerializer>(serializer);
+}
+
+std::unique_ptr<CommandHandler> CreateDecompressingCommandHandler(CommandHandler* handler) {
+    return std::make_unique<DecompressingCommandHandler>(handler);
+}
+
+}  // namespace dawn::wire
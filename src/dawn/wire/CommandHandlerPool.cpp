@@ -0,0 +1,188 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/wire/Wire.h"
+
+namespace dawn::wire {
+
+// Each wrapped handler is a strand: its submitted command chunks form a FIFO that at most one
+// worker drains at a time, so one connection's commands never reorder or run concurrently
+// while distinct connections spread over the pool threads.
+class CommandHandlerPool::Impl {
+  public:
+    struct Connection {
+        CommandHandler* handler;
+        // Chunks submitted but not yet processed. Guarded by the pool mutex.
+        std::deque<std::vector<char>> pending;
+        // True while a worker owns this strand. Guarded by the pool mutex.
+        bool scheduled = false;
+        // Set when the wrapped handler reported an error; further submissions fail.
+        bool failed = false;
+    };
+
+    class PooledCommandHandler final : public CommandHandler {
+      public:
+        PooledCommandHandler(std::shared_ptr<Impl> pool, Connection* connection)
+            : mPool(std::move(pool)), mConnection(connection) {}
+
+        ~PooledCommandHandler() override { mPool->DrainConnection(mConnection); }
+
+        const volatile char* HandleCommands(const volatile char* commands,
+                                            size_t size) override {
+            if (!mPool->Submit(mConnection, commands, size)) {
+                return nullptr;
+            }
+            return commands + size;
+        }
+
+      private:
+        std::shared_ptr<Impl> mPool;
+        Connection* mConnection;
+    };
+
+    explicit Impl(uint32_t threadCount) {
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        mWorkers.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; i++) {
+            mWorkers.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ~Impl() {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mShutdown = true;
+        }
+        mWorkCondition.notify_all();
+        for (std::thread& worker : mWorkers) {
+            worker.join();
+        }
+    }
+
+    Connection* CreateConnection(CommandHandler* handler) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mConnections.push_back(std::make_unique<Connection>());
+        mConnections.back()->handler = handler;
+        return mConnections.back().get();
+    }
+
+    // Returns false if the connection previously failed.
+    bool Submit(Connection* connection, const volatile char* commands, size_t size) {
+        std::vector<char> chunk(size);
+        memcpy(chunk.data(), const_cast<const char*>(commands), size);
+
+        bool schedule = false;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (connection->failed) {
+                return false;
+            }
+            connection->pending.push_back(std::move(chunk));
+            if (!connection->scheduled) {
+                connection->scheduled = true;
+                mReady.push_back(connection);
+                schedule = true;
+            }
+        }
+        if (schedule) {
+            mWorkCondition.notify_one();
+        }
+        return true;
+    }
+
+    void WaitIdle() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mIdleCondition.wait(lock, [this] {
+            return std::all_of(mConnections.begin(), mConnections.end(),
+                               [](const std::unique_ptr<Connection>& connection) {
+                                   return !connection->scheduled && connection->pending.empty();
+                               });
+        });
+    }
+
+    // Blocks until the commands already submitted for |connection| are processed.
+    void DrainConnection(Connection* connection) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mIdleCondition.wait(lock, [connection] {
+            return !connection->scheduled && connection->pending.empty();
+        });
+    }
+
+  private:
+    void WorkerLoop() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true) {
+            mWorkCondition.wait(lock, [this] { return mShutdown || !mReady.empty(); });
+            if (mShutdown && mReady.empty()) {
+                return;
+            }
+            Connection* connection = mReady.front();
+            mReady.pop_front();
+
+            // Drain this strand. Only this worker touches the wrapped handler until the
+            // strand is marked unscheduled again.
+            while (!connection->pending.empty()) {
+                std::vector<char> chunk = std::move(connection->pending.front());
+                connection->pending.pop_front();
+
+                lock.unlock();
+                bool success =
+                    connection->handler->HandleCommands(chunk.data(), chunk.size()) != nullptr;
+                lock.lock();
+
+                if (!success) {
+                    connection->failed = true;
+                    connection->pending.clear();
+                }
+            }
+            connection->scheduled = false;
+            mIdleCondition.notify_all();
+        }
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mWorkCondition;
+    std::condition_variable mIdleCondition;
+    std::vector<std::unique_ptr<Connection>> mConnections;
+    std::deque<Connection*> mReady;
+    std::vector<std::thread> mWorkers;
+    bool mShutdown = false;
+};
+
+CommandHandlerPool::CommandHandlerPool(uint32_t threadCount)
+    : mImpl(std::make_shared<Impl>(threadCount)) {}
+
+CommandHandlerPool::~CommandHandlerPool() = default;
+
+std::unique_ptr<CommandHandler> CommandHandlerPool::Wrap(CommandHandler* handler) {
+    return std::make_unique<Impl::PooledCommandHandler>(mImpl, mImpl->CreateConnection(handler));
+}
+
+void CommandHandlerPool::WaitIdle() {
+    mImpl->WaitIdle();
+}
+
+}  // namespace dawn::wire
@@ -0,0 +1,234 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/wire/LZ4Compression.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace dawn::wire {
+
+namespace {
+
+// Format constants from the LZ4 block specification.
+constexpr size_t kMinMatch = 4;
+// The last 5 bytes of a block are always literals.
+constexpr size_t kLastLiterals = 5;
+// Matches may not start closer than this to the end of the block.
+constexpr size_t kMatchFindLimit = 12;
+constexpr size_t kMaxOffset = 65535;
+
+constexpr uint32_t kHashLog = 12;
+constexpr uint32_t kHashTableSize = 1u << kHashLog;
+
+uint32_t HashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - kHashLog);
+}
+
+uint32_t ReadU32(const uint8_t* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+}  // anonymous namespace
+
+size_t LZ4CompressBound(size_t srcSize) {
+    return srcSize + srcSize / 255 + 16;
+}
+
+size_t LZ4CompressBlock(const void* srcData, size_t srcSize, void* dstData, size_t dstCapacity) {
+    const uint8_t* const src = static_cast<const uint8_t*>(srcData);
+    uint8_t* const dst = static_cast<uint8_t*>(dstData);
+    const uint8_t* const iend = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* const oend = dst + dstCapacity;
+
+    // Writes the 255-run continuation of a length that did not fit in its token nibble.
+    auto WriteLength = [&op, oend](size_t value) -> bool {
+        while (value >= 255) {
+            if (op >= oend) {
+                return false;
+            }
+            *op++ = 255;
+            value -= 255;
+        }
+        if (op >= oend) {
+            return false;
+        }
+        *op++ = static_cast<uint8_t>(value);
+        return true;
+    };
+
+    // Emits one sequence: a token, the literal run, and (unless this is the final
+    // literals-only sequence, signalled by matchLen == 0) the match offset and length.
+    auto EmitSequence = [&op, oend, &WriteLength](const uint8_t* literals, size_t litLen,
+                                                  size_t offset, size_t matchLen) -> bool {
+        if (op >= oend) {
+            return false;
+        }
+        uint8_t* const token = op++;
+        if (litLen >= 15) {
+            *token = 15 << 4;
+            if (!WriteLength(litLen - 15)) {
+                return false;
+            }
+        } else {
+            *token = static_cast<uint8_t>(litLen << 4);
+        }
+        if (static_cast<size_t>(oend - op) < litLen) {
+            return false;
+        }
+        if (litLen > 0) {
+            memcpy(op, literals, litLen);
+            op += litLen;
+        }
+
+        if (matchLen == 0) {
+            return true;
+        }
+        if (static_cast<size_t>(oend - op) < 2) {
+            return false;
+        }
+        op[0] = static_cast<uint8_t>(offset & 0xFF);
+        op[1] = static_cast<uint8_t>(offset >> 8);
+        op += 2;
+        size_t matchLenCode = matchLen - kMinMatch;
+        if (matchLenCode >= 15) {
+            *token |= 15;
+            if (!WriteLength(matchLenCode - 15)) {
+                return false;
+            }
+        } else {
+            *token |= static_cast<uint8_t>(matchLenCode);
+        }
+        return true;
+    };
+
+    const uint8_t* anchor = src;
+    if (srcSize >= kMatchFindLimit) {
+        uint32_t hashTable[kHashTableSize] = {};
+        const uint8_t* const mflimit = iend - kMatchFindLimit;
+        const uint8_t* const matchlimit = iend - kLastLiterals;
+
+        const uint8_t* ip = src;
+        while (ip <= mflimit) {
+            uint32_t sequence = ReadU32(ip);
+            uint32_t hash = HashSequence(sequence);
+            size_t candidate = hashTable[hash];
+            size_t current = static_cast<size_t>(ip - src);
+            hashTable[hash] = static_cast<uint32_t>(current);
+
+            if (candidate >= current || current - candidate > kMaxOffset ||
+                ReadU32(src + candidate) != sequence) {
+                ip++;
+                continue;
+            }
+
+            const uint8_t* match = src + candidate + kMinMatch;
+            const uint8_t* cur = ip + kMinMatch;
+            while (cur < matchlimit && *cur == *match) {
+                cur++;
+                match++;
+            }
+            size_t matchLen = static_cast<size_t>(cur - ip);
+
+            if (!EmitSequence(anchor, static_cast<size_t>(ip - anchor), current - candidate,
+                              matchLen)) {
+                return 0;
+            }
+            ip += matchLen;
+            anchor = ip;
+        }
+    }
+
+    if (!EmitSequence(anchor, static_cast<size_t>(iend - anchor), 0, 0)) {
+        return 0;
+    }
+    return static_cast<size_t>(op - dst);
+}
+
+bool LZ4DecompressBlock(const void* srcData, size_t srcSize, void* dstData, size_t dstSize) {
+    const uint8_t* ip = static_cast<const uint8_t*>(srcData);
+    const uint8_t* const iend = ip + srcSize;
+    uint8_t* const dst = static_cast<uint8_t*>(dstData);
+    uint8_t* op = dst;
+    uint8_t* const oend = dst + dstSize;
+
+    // Reads the 255-run continuation of a length whose token nibble was saturated.
+    auto ReadLength = [&ip, iend](size_t nibble, size_t* length) -> bool {
+        size_t value = nibble;
+        if (nibble == 15) {
+            uint8_t byte;
+            do {
+                if (ip >= iend) {
+                    return false;
+                }
+                byte = *ip++;
+                value += byte;
+            } while (byte == 255);
+        }
+        *length = value;
+        return true;
+    };
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+
+        size_t litLen;
+        if (!ReadLength(token >> 4, &litLen)) {
+            return false;
+        }
+        if (litLen > static_cast<size_t>(iend - ip) || litLen > static_cast<size_t>(oend - op)) {
+            return false;
+        }
+        memcpy(op, ip, litLen);
+        ip += litLen;
+        op += litLen;
+
+        if (ip == iend) {
+            // The final sequence is literals-only.
+            break;
+        }
+
+        if (static_cast<size_t>(iend - ip) < 2) {
+            return false;
+        }
+        size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+            return false;
+        }
+
+        size_t matchLen;
+        if (!ReadLength(token & 15, &matchLen)) {
+            return false;
+        }
+        matchLen += kMinMatch;
+        if (matchLen > static_cast<size_t>(oend - op)) {
+            return false;
+        }
+
+        // Byte-wise copy: the match may overlap the bytes being written.
+        const uint8_t* match = op - offset;
+        for (size_t i = 0; i < matchLen; i++) {
+            op[i] = match[i];
+        }
+        op += matchLen;
+    }
+
+    return op == oend;
+}
+
+}  // namespace dawn::wire
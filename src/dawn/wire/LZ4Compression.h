@@ -0,0 +1,40 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_WIRE_LZ4COMPRESSION_H_
+#define SRC_DAWN_WIRE_LZ4COMPRESSION_H_
+
+#include <cstddef>
+
+namespace dawn::wire {
+
+// Self-contained implementation of the LZ4 block format used to compress wire command
+// batches, so that the compression layer carries no external dependency. The compressor is
+// the greedy single-pass variant; output is readable by any LZ4 block decoder.
+
+// Upper bound on the compressed size of `srcSize` bytes of input.
+size_t LZ4CompressBound(size_t srcSize);
+
+// Compresses `srcSize` bytes from `src` into `dst`. Returns the compressed size, or 0 if the
+// output does not fit in `dstCapacity`.
+size_t LZ4CompressBlock(const void* src, size_t srcSize, void* dst, size_t dstCapacity);
+
+// Decompresses a block of exactly `dstSize` uncompressed bytes. Returns false if the input is
+// malformed or does not decode to exactly `dstSize` bytes; never reads or writes out of
+// bounds, so the input may come from an untrusted peer.
+bool LZ4DecompressBlock(const void* src, size_t srcSize, void* dst, size_t dstSize);
+
+}  // namespace dawn::wire
+
+#endif  // SRC_DAWN_WIRE_LZ4COMPRESSION_H_
@@ -0,0 +1,208 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "dawn/common/Alloc.h"
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+#include "dawn/wire/Wire.h"
+
+namespace dawn::wire {
+
+namespace {
+
+// Each staged command is stored as this header followed by its payload, with the next record
+// starting at the following 8-byte boundary so payloads stay suitably aligned.
+struct RecordHeader {
+    uint64_t epoch;
+    uint64_t size;
+};
+
+// Byte buffer a single thread stages its commands into. Only the owning thread appends;
+// the flushing thread reads it while no thread is recording.
+class ThreadBuffer {
+  public:
+    char* Allocate(size_t size) {
+        if (size > mCapacity - mSize) {
+            size_t newCapacity = std::max(mCapacity + mCapacity / 2, mSize + size);
+            newCapacity = std::max(newCapacity, size_t(16384));
+            std::unique_ptr<char[]> newData(AllocNoThrow<char>(newCapacity));
+            if (!newData) {
+                return nullptr;
+            }
+            if (mSize > 0) {
+                memcpy(newData.get(), mData.get(), mSize);
+            }
+            mData = std::move(newData);
+            mCapacity = newCapacity;
+        }
+        char* result = mData.get() + mSize;
+        mSize += size;
+        return result;
+    }
+
+    void Clear() { mSize = 0; }
+
+    char* Data() { return mData.get(); }
+    size_t Size() const { return mSize; }
+
+  private:
+    std::unique_ptr<char[]> mData;
+    size_t mSize = 0;
+    size_t mCapacity = 0;
+};
+
+class MultiProducerCommandSerializer final : public CommandSerializer {
+  public:
+    explicit MultiProducerCommandSerializer(CommandSerializer* serializer)
+        : mSerializer(serializer), mInstanceId(sNextInstanceId.fetch_add(1)) {}
+    ~MultiProducerCommandSerializer() override = default;
+
+    void* GetCmdSpace(size_t size) override {
+        ThreadBuffer* buffer = GetThreadBuffer();
+        if (buffer == nullptr) {
+            return nullptr;
+        }
+
+        // Stamp the record with a global epoch so that the merge at flush time replays
+        // commands in the order they were recorded. A command that depends on another (for
+        // example one referencing an object another thread created) is always recorded after
+        // it: the creating call returns only once its command is staged, and handing the
+        // object to another thread establishes the ordering.
+        RecordHeader header;
+        header.epoch = mNextEpoch.fetch_add(1, std::memory_order_relaxed);
+        header.size = size;
+
+        char* record = buffer->Allocate(sizeof(RecordHeader) + Align(size, 8));
+        if (record == nullptr) {
+            return nullptr;
+        }
+        memcpy(record, &header, sizeof(header));
+        return record + sizeof(RecordHeader);
+    }
+
+    bool Flush() override {
+        // The caller must guarantee no thread is recording while Flush runs; the registry
+        // lock only guards against concurrent first-time thread registration.
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // Cursor into one thread's staged records for the epoch merge.
+        struct Cursor {
+            ThreadBuffer* buffer;
+            size_t offset = 0;
+        };
+        std::vector<Cursor> cursors;
+        cursors.reserve(mThreadBuffers.size());
+        for (auto& buffer : mThreadBuffers) {
+            if (buffer->Size() > 0) {
+                cursors.push_back({buffer.get()});
+            }
+        }
+
+        bool success = true;
+        while (success) {
+            // Pick the cursor whose next record carries the smallest epoch. The per-thread
+            // buffers are individually epoch-ordered, so this merges the global order.
+            Cursor* next = nullptr;
+            uint64_t nextEpoch = 0;
+            for (Cursor& cursor : cursors) {
+                if (cursor.offset >= cursor.buffer->Size()) {
+                    continue;
+                }
+                RecordHeader header;
+                memcpy(&header, cursor.buffer->Data() + cursor.offset, sizeof(header));
+                if (next == nullptr || header.epoch < nextEpoch) {
+                    next = &cursor;
+                    nextEpoch = header.epoch;
+                }
+            }
+            if (next == nullptr) {
+                break;
+            }
+
+            RecordHeader header;
+            memcpy(&header, next->buffer->Data() + next->offset, sizeof(header));
+            size_t size = static_cast<size_t>(header.size);
+            void* cmdSpace = mSerializer->GetCmdSpace(size);
+            if (cmdSpace == nullptr) {
+                success = false;
+                break;
+            }
+            memcpy(cmdSpace, next->buffer->Data() + next->offset + sizeof(RecordHeader), size);
+            next->offset += sizeof(RecordHeader) + Align(size, 8);
+        }
+
+        for (auto& buffer : mThreadBuffers) {
+            buffer->Clear();
+        }
+        if (!success) {
+            return false;
+        }
+        return mSerializer->Flush();
+    }
+
+    size_t GetMaximumAllocationSize() const override {
+        return mSerializer->GetMaximumAllocationSize();
+    }
+
+    void OnSerializeError() override { mSerializer->OnSerializeError(); }
+
+  private:
+    ThreadBuffer* GetThreadBuffer() {
+        // Cached per thread and per serializer instance. Instances are keyed by a unique ID
+        // rather than their address so that a stale entry for a destroyed serializer can
+        // never be revived by an allocation at the same address.
+        thread_local std::unordered_map<uint64_t, ThreadBuffer*> tlsBuffers;
+        auto it = tlsBuffers.find(mInstanceId);
+        if (it != tlsBuffers.end()) {
+            return it->second;
+        }
+
+        auto buffer = std::make_unique<ThreadBuffer>();
+        ThreadBuffer* result = buffer.get();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mThreadBuffers.push_back(std::move(buffer));
+        }
+        tlsBuffers.emplace(mInstanceId, result);
+        return result;
+    }
+
+    static std::atomic<uint64_t> sNextInstanceId;
+
+    CommandSerializer* mSerializer;
+    const uint64_t mInstanceId;
+    std::atomic<uint64_t> mNextEpoch{0};
+
+    // Guards mThreadBuffers; taken on first-time thread registration and during Flush.
+    std::mutex mMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> mThreadBuffers;
+};
+
+std::atomic<uint64_t> MultiProducerCommandSerializer::sNextInstanceId{1};
+
+}  // anonymous namespace
+
+std::unique_ptr<CommandSerializer> CreateMultiProducerCommandSerializer(
+    CommandSerializer* serializer) {
+    return std::make_unique<MultiProducerCommandSerializer>(serializer);
+}
+
+}  // namespace dawn::wire
@@ -0,0 +1,176 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/wire/SharedMemoryTransferHelpers.h"
+
+#if DAWN_PLATFORM_IS(POSIX)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+
+namespace dawn::wire {
+
+namespace {
+
+// Fixed-size header of the serialized create info; the segment name follows it.
+struct SegmentCreateInfo {
+    uint64_t size;
+    uint64_t nameLength;
+};
+
+// shm_open names are limited to NAME_MAX on most systems; anything longer than this is
+// certainly not a name we produced.
+constexpr uint64_t kMaxNameLength = 255;
+
+}  // anonymous namespace
+
+SharedMemorySegment::SharedMemorySegment() = default;
+
+SharedMemorySegment::~SharedMemorySegment() {
+    Destroy(false);
+}
+
+SharedMemorySegment::SharedMemorySegment(SharedMemorySegment&& other)
+    : mName(std::move(other.mName)), mData(other.mData), mSize(other.mSize) {
+    other.mName.clear();
+    other.mData = nullptr;
+    other.mSize = 0;
+}
+
+SharedMemorySegment& SharedMemorySegment::operator=(SharedMemorySegment&& other) {
+    if (this != &other) {
+        Destroy(false);
+        mName = std::move(other.mName);
+        mData = other.mData;
+        mSize = other.mSize;
+        other.mName.clear();
+        other.mData = nullptr;
+        other.mSize = 0;
+    }
+    return *this;
+}
+
+bool SharedMemorySegment::Create(const std::string& name, size_t size) {
+    ASSERT(mData == nullptr);
+    ASSERT(size > 0);
+    ASSERT(name.length() <= kMaxNameLength);
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    // The mapping keeps the segment alive; the descriptor is no longer needed.
+    close(fd);
+    if (data == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    mName = name;
+    mData = data;
+    mSize = size;
+    return true;
+}
+
+bool SharedMemorySegment::Deserialize(const void* deserializePointer, size_t deserializeSize) {
+    ASSERT(mData == nullptr);
+
+    SegmentCreateInfo info;
+    if (deserializePointer == nullptr || deserializeSize < sizeof(info)) {
+        return false;
+    }
+    memcpy(&info, deserializePointer, sizeof(info));
+    if (info.size == 0 || static_cast<uint64_t>(static_cast<size_t>(info.size)) != info.size ||
+        info.nameLength == 0 || info.nameLength > kMaxNameLength ||
+        deserializeSize - sizeof(info) < info.nameLength) {
+        return false;
+    }
+    std::string name(static_cast<const char*>(deserializePointer) + sizeof(info),
+                     static_cast<size_t>(info.nameLength));
+
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        return false;
+    }
+    // Check the segment is at least as large as announced so the size can be trusted for
+    // bounds checks; a mismatch means the create info was corrupted or forged.
+    struct stat segmentStat;
+    if (fstat(fd, &segmentStat) != 0 ||
+        static_cast<uint64_t>(segmentStat.st_size) < info.size) {
+        close(fd);
+        return false;
+    }
+    void* data =
+        mmap(nullptr, static_cast<size_t>(info.size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    mName = std::move(name);
+    mData = data;
+    mSize = static_cast<size_t>(info.size);
+    return true;
+}
+
+void SharedMemorySegment::Destroy(bool unlinkName) {
+    if (mData != nullptr) {
+        munmap(mData, mSize);
+        mData = nullptr;
+    }
+    if (unlinkName && !mName.empty()) {
+        shm_unlink(mName.c_str());
+    }
+    mName.clear();
+    mSize = 0;
+}
+
+size_t SharedMemorySegment::SerializeCreateSize() const {
+    ASSERT(mData != nullptr);
+    return sizeof(SegmentCreateInfo) + mName.length();
+}
+
+void SharedMemorySegment::SerializeCreate(void* serializePointer) const {
+    ASSERT(mData != nullptr);
+    SegmentCreateInfo info;
+    info.size = mSize;
+    info.nameLength = mName.length();
+    memcpy(serializePointer, &info, sizeof(info));
+    memcpy(static_cast<char*>(serializePointer) + sizeof(info), mName.data(), mName.length());
+}
+
+void* SharedMemorySegment::GetData() const {
+    return mData;
+}
+
+size_t SharedMemorySegment::GetSize() const {
+    return mSize;
+}
+
+}  // namespace dawn::wire
+
+#endif  // DAWN_PLATFORM_IS(POSIX)
@@ -0,0 +1,70 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_WIRE_SHAREDMEMORYTRANSFERHELPERS_H_
+#define SRC_DAWN_WIRE_SHAREDMEMORYTRANSFERHELPERS_H_
+
+#include "dawn/common/Platform.h"
+
+#if DAWN_PLATFORM_IS(POSIX)
+
+#include <cstddef>
+#include <string>
+
+namespace dawn::wire {
+
+// A named POSIX shared memory segment mapped into the process, used by the shared memory
+// MemoryTransferService implementations so that the client and the server sides of the wire
+// can address the same pages. The creating side serializes {size, name} in the handle create
+// info and the other side opens the segment by name.
+class SharedMemorySegment {
+  public:
+    SharedMemorySegment();
+    ~SharedMemorySegment();
+
+    SharedMemorySegment(SharedMemorySegment&& other);
+    SharedMemorySegment& operator=(SharedMemorySegment&& other);
+
+    SharedMemorySegment(const SharedMemorySegment&) = delete;
+    SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+    // Creates and maps a new segment of `size` bytes. The name must not already exist.
+    bool Create(const std::string& name, size_t size);
+
+    // Maps the segment described by create info produced with SerializeCreate on the other
+    // side of the wire. The deserialized size and name length are validated against
+    // `deserializeSize` before use.
+    bool Deserialize(const void* deserializePointer, size_t deserializeSize);
+
+    // Unmaps the segment. When `unlinkName` is true the name is also removed so the kernel
+    // can reclaim the pages once all mappings are gone; only the creating side should unlink.
+    void Destroy(bool unlinkName);
+
+    size_t SerializeCreateSize() const;
+    void SerializeCreate(void* serializePointer) const;
+
+    void* GetData() const;
+    size_t GetSize() const;
+
+  private:
+    std::string mName;
+    void* mData = nullptr;
+    size_t mSize = 0;
+};
+
+}  // namespace dawn::wire
+
+#endif  // DAWN_PLATFORM_IS(POSIX)
+
+#endif  // SRC_DAWN_WIRE_SHAREDMEMORYTRANSFERHELPERS_H_
@@ -17,12 +17,28 @@
 #include <algorithm>
 
 namespace dawn::wire {
+
+namespace {
+
+// Size of the first heap arena; subsequent arenas double up to kMaxArenaSize.
+constexpr size_t kMinArenaSize = 4096;
+constexpr size_t kMaxArenaSize = 1024 * 1024;
+
+// Retained capacity budget. Arenas past the budget are freed on Reset() so a one-off
+// allocation spike doesn't pin its high-water mark forever.
+constexpr size_t kMaxRetainedSize = 4 * 1024 * 1024;
+
+}  // anonymous namespace
+
 WireDeserializeAllocator::WireDeserializeAllocator() {
     Reset();
 }
 
 WireDeserializeAllocator::~WireDeserializeAllocator() {
-    Reset();
+    for (const Arena& arena : mArenas) {
+        free(arena.data);
+    }
+    mArenas.clear();
 }
 
 void* WireDeserializeAllocator::GetSpace(size_t size) {
@@ -34,27 +50,49 @@ void* WireDeserializeAllocator::GetSpace(size_t size) {
         return buffer;
     }
 
-    // Otherwise allocate a new buffer and try again.
-    size_t allocationSize = std::max(size, size_t(2048));
+    // Then reuse a retained arena if one is large enough.
+    while (mNextArena < mArenas.size()) {
+        const Arena& arena = mArenas[mNextArena++];
+        if (arena.capacity >= size) {
+            mCurrentBuffer = arena.data;
+            mRemainingSize = arena.capacity;
+            return GetSpace(size);
+        }
+    }
+
+    // Otherwise allocate a new arena, doubling the previous capacity so that a workload's
+    // high-water mark is reached in O(log n) allocations.
+    size_t allocationSize = kMinArenaSize;
+    if (!mArenas.empty()) {
+        allocationSize = std::min(mArenas.back().capacity * 2, kMaxArenaSize);
+    }
+    allocationSize = std::max(allocationSize, size);
+
     char* allocation = static_cast<char*>(malloc(allocationSize));
     if (allocation == nullptr) {
         return nullptr;
     }
 
-    mAllocations.push_back(allocation);
+    mArenas.push_back({allocation, allocationSize});
+    mRetainedSize += allocationSize;
+    mNextArena = mArenas.size();
     mCurrentBuffer = allocation;
     mRemainingSize = allocationSize;
     return GetSpace(size);
 }
 
 void WireDeserializeAllocator::Reset() {
-    for (auto* allocation : mAllocations) {
-        free(allocation);
+    // Trim back to the retention budget, dropping the most recently added arenas first.
+    while (mRetainedSize > kMaxRetainedSize) {
+        mRetainedSize -= mArenas.back().capacity;
+        free(mArenas.back().data);
+        mArenas.pop_back();
     }
-    mAllocations.clear();
 
-    // The initial buffer is the inline buffer so that some allocations can be skipped
+    // Rewind to the inline buffer; retained arenas are reused in order as it overflows.
+    mNextArena = 0;
     mCurrentBuffer = mStaticBuffer;
     mRemainingSize = sizeof(mStaticBuffer);
 }
+
 }  // namespace dawn::wire
@@ -20,9 +20,10 @@
 #include "dawn/wire/WireCmd_autogen.h"
 
 namespace dawn::wire {
-// A really really simple implementation of the DeserializeAllocator. It's main feature
-// is that it has some inline storage so as to avoid allocations for the majority of
-// commands.
+// A simple implementation of the DeserializeAllocator. It has some inline storage so as to
+// avoid allocations for the majority of commands, and overflows into a chain of
+// geometrically-growing arenas that is retained across Reset() (up to a budget), so
+// steady-state deserialization of large commands causes no heap traffic.
 class WireDeserializeAllocator : public DeserializeAllocator {
   public:
     WireDeserializeAllocator();
@@ -33,10 +34,20 @@ class WireDeserializeAllocator : public DeserializeAllocator {
     void Reset();
 
   private:
+    struct Arena {
+        char* data;
+        size_t capacity;
+    };
+
     size_t mRemainingSize = 0;
     char* mCurrentBuffer = nullptr;
     char mStaticBuffer[2048];
-    std::vector<char*> mAllocations;
+
+    // Retained arenas in allocation order; mNextArena indexes the first one not yet reused
+    // since the last Reset().
+    std::vector<Arena> mArenas;
+    size_t mNextArena = 0;
+    size_t mRetainedSize = 0;
 };
 }  // namespace dawn::wire
 
@@ -58,6 +58,14 @@ WGPUDevice WireServer::GetDevice(uint32_t id, uint32_t generation) {
     return mImpl->GetDevice(id, generation);
 }
 
+bool WireServer::StartCapture(const char* filePath) {
+    return mImpl->StartCapture(filePath);
+}
+
+void WireServer::StopCapture() {
+    mImpl->StopCapture();
+}
+
 bool WireServer::IsDeviceKnown(WGPUDevice device) const {
     return mImpl->IsDeviceKnown(device);
 }
@@ -21,6 +21,10 @@ namespace dawn::wire::client {
 
 Adapter::~Adapter() {
     mRequestDeviceRequests.CloseAll([](RequestDeviceData* request) {
+        // Speculative requests already ran their callback when they were made.
+        if (request->speculative) {
+            return;
+        }
         request->callback(WGPURequestDeviceStatus_Unknown, nullptr,
                           "Adapter destroyed before callback", request->userdata);
     });
@@ -28,6 +32,11 @@ Adapter::~Adapter() {
 
 void Adapter::CancelCallbacksForDisconnect() {
     mRequestDeviceRequests.CloseAll([](RequestDeviceData* request) {
+        // Speculative requests already ran their callback; the disconnect reaches the
+        // application through the device lost callback instead.
+        if (request->speculative) {
+            return;
+        }
         request->callback(WGPURequestDeviceStatus_Unknown, nullptr, "GPU connection lost",
                           request->userdata);
     });
@@ -70,9 +79,16 @@ void Adapter::RequestDevice(const WGPUDeviceDescriptor* descriptor,
         callback(WGPURequestDeviceStatus_Error, nullptr, "GPU connection lost", userdata);
         return;
     }
+    if (mSpeculationFailed) {
+        // This adapter was handed out speculatively but its request failed; replay the error.
+        callback(WGPURequestDeviceStatus_Error, nullptr, mSpeculationError.c_str(), userdata);
+        return;
+    }
 
+    bool speculative = client->AreSpeculativeRequestsEnabled();
     Device* device = client->Make<Device>();
-    uint64_t serial = mRequestDeviceRequests.Add({callback, device->GetWireId(), userdata});
+    uint64_t serial =
+        mRequestDeviceRequests.Add({callback, device->GetWireId(), userdata, speculative});
 
     AdapterRequestDeviceCmd cmd;
     cmd.adapterId = GetWireId();
@@ -81,6 +97,12 @@ void Adapter::RequestDevice(const WGPUDeviceDescriptor* descriptor,
     cmd.descriptor = descriptor;
 
     client->SerializeCommand(cmd);
+
+    if (speculative) {
+        // Hand the device out immediately so that commands against it pipeline; the reply
+        // backfills its limits and features, or runs its device lost callback on failure.
+        callback(WGPURequestDeviceStatus_Success, ToAPI(device), nullptr, userdata);
+    }
 }
 
 bool Client::DoAdapterRequestDeviceCallback(Adapter* adapter,
@@ -106,7 +128,9 @@ bool Adapter::OnRequestDeviceCallback(uint64_t requestSerial,
                                       const WGPUFeatureName* features) {
     RequestDeviceData request;
     if (!mRequestDeviceRequests.Acquire(requestSerial, &request)) {
-        return false;
+        // Speculative requests may have been closed early by MarkSpeculationFailed, so a
+        // reply for an unknown serial isn't an error then.
+        return mSpeculationFailed;
     }
 
     Client* client = GetClient();
@@ -115,6 +139,12 @@ bool Adapter::OnRequestDeviceCallback(uint64_t requestSerial,
     // If the return status is a failure we should give a null device to the callback and
     // free the allocation.
     if (status != WGPURequestDeviceStatus_Success) {
+        if (request.speculative) {
+            // The callback already ran with the device; backfill the failure through the
+            // device lost callback. The application keeps the last reference.
+            device->HandleDeviceLost(WGPUDeviceLostReason_Undefined, message);
+            return true;
+        }
         client->Free(device);
         request.callback(status, nullptr, message, request.userdata);
         return true;
@@ -123,10 +153,34 @@ bool Adapter::OnRequestDeviceCallback(uint64_t requestSerial,
     device->SetLimits(limits);
     device->SetFeatures(features, featuresCount);
 
+    if (request.speculative) {
+        return true;
+    }
     request.callback(status, ToAPI(device), message, request.userdata);
     return true;
 }
 
+void Adapter::MarkSpeculationFailed(const char* message) {
+    mSpeculationFailed = true;
+    mSpeculationError = message != nullptr ? message : "RequestAdapter failed";
+
+    // Replay the failure into device requests that pipelined against this adapter. The server
+    // drops those requests without replying, so they are closed here. Speculative requests
+    // already ran their callback with a device; the error arrives through its lost callback.
+    Client* client = GetClient();
+    mRequestDeviceRequests.CloseAll([&](RequestDeviceData* request) {
+        if (!request->speculative) {
+            request->callback(WGPURequestDeviceStatus_Error, nullptr, mSpeculationError.c_str(),
+                              request->userdata);
+            return;
+        }
+        Device* device = client->Get<Device>(request->deviceObjectId);
+        if (device != nullptr) {
+            device->HandleDeviceLost(WGPUDeviceLostReason_Undefined, mSpeculationError.c_str());
+        }
+    });
+}
+
 WGPUDevice Adapter::CreateDevice(const WGPUDeviceDescriptor*) {
     dawn::ErrorLog() << "adapter.CreateDevice not supported with dawn_wire.";
     return nullptr;
@@ -15,6 +15,8 @@
 #ifndef SRC_DAWN_WIRE_CLIENT_ADAPTER_H_
 #define SRC_DAWN_WIRE_CLIENT_ADAPTER_H_
 
+#include <string>
+
 #include "dawn/webgpu.h"
 
 #include "dawn/wire/WireClient.h"
@@ -50,6 +52,10 @@ class Adapter final : public ObjectBase {
                                  uint32_t featuresCount,
                                  const WGPUFeatureName* features);
 
+    // Called when this adapter was handed out speculatively but its request failed on the
+    // server. Fails in-flight and future RequestDevice calls with |message|.
+    void MarkSpeculationFailed(const char* message);
+
     // Unimplementable. Only availale in dawn_native.
     WGPUDevice CreateDevice(const WGPUDeviceDescriptor*);
 
@@ -61,8 +67,14 @@ class Adapter final : public ObjectBase {
         WGPURequestDeviceCallback callback = nullptr;
         ObjectId deviceObjectId;
         void* userdata = nullptr;
+        // True when the callback already ran speculatively and the reply only backfills
+        // the result. See WireClientDescriptor::speculativeRequests.
+        bool speculative = false;
     };
     RequestTracker<RequestDeviceData> mRequestDeviceRequests;
+
+    bool mSpeculationFailed = false;
+    std::string mSpeculationError;
 };
 
 }  // namespace dawn::wire::client
@@ -14,6 +14,7 @@
 
 #include "dawn/wire/client/Buffer.h"
 
+#include <algorithm>
 #include <limits>
 #include <utility>
 
@@ -270,6 +271,18 @@ void* Buffer::GetMappedRange(size_t offset, size_t size) {
     if (!IsMappedForWriting() || !CheckGetMappedRangeOffsetSize(offset, size)) {
         return nullptr;
     }
+
+    // Track the union of the writable ranges handed out so that Unmap may flush only data the
+    // application could actually have written.
+    size_t rangeSize = size == WGPU_WHOLE_MAP_SIZE ? mSize - offset : size;
+    if (mDirtyBegin == mDirtyEnd) {
+        mDirtyBegin = offset;
+        mDirtyEnd = offset + rangeSize;
+    } else {
+        mDirtyBegin = std::min(mDirtyBegin, offset);
+        mDirtyEnd = std::max(mDirtyEnd, offset + rangeSize);
+    }
+
     return static_cast<uint8_t*>(mMappedData) + offset;
 }
 
@@ -298,16 +311,26 @@ void Buffer::Unmap() {
         // Writes need to be flushed before Unmap is sent. Unmap calls all associated
         // in-flight callbacks which may read the updated data.
 
+        // Only the union of the writable ranges handed out by GetMappedRange needs to be
+        // flushed: the application has no pointer into the rest of the mapping. Fall back to
+        // the whole mapped region if no writable range was handed out.
+        size_t flushOffset = mMapOffset;
+        size_t flushSize = mMapSize;
+        if (mDirtyBegin != mDirtyEnd) {
+            flushOffset = mDirtyBegin;
+            flushSize = mDirtyEnd - mDirtyBegin;
+        }
+
         // Get the serialization size of data update writes.
         size_t writeDataUpdateInfoLength =
-            mWriteHandle->SizeOfSerializeDataUpdate(mMapOffset, mMapSize);
+            mWriteHandle->SizeOfSerializeDataUpdate(flushOffset, flushSize);
 
         BufferUpdateMappedDataCmd cmd;
         cmd.bufferId = GetWireId();
         cmd.writeDataUpdateInfoLength = writeDataUpdateInfoLength;
         cmd.writeDataUpdateInfo = nullptr;
-        cmd.offset = mMapOffset;
-        cmd.size = mMapSize;
+        cmd.offset = flushOffset;
+        cmd.size = flushSize;
 
         client->SerializeCommand(
             cmd, writeDataUpdateInfoLength, [&](SerializeBuffer* serializeBuffer) {
@@ -339,6 +362,8 @@ void Buffer::Unmap() {
     mMapState = MapState::Unmapped;
     mMapOffset = 0;
     mMapSize = 0;
+    mDirtyBegin = 0;
+    mDirtyEnd = 0;
 
     // Tag all mapping requests still in flight as unmapped before callback.
     mRequests.ForAll([](MapRequestData* request) {
@@ -413,6 +438,8 @@ void Buffer::FreeMappedData() {
 
     mMapOffset = 0;
     mMapSize = 0;
+    mDirtyBegin = 0;
+    mDirtyEnd = 0;
     mReadHandle = nullptr;
     mWriteHandle = nullptr;
     mMappedData = nullptr;
@@ -103,6 +103,10 @@ class Buffer final : public ObjectBase {
     void* mMappedData = nullptr;
     size_t mMapOffset = 0;
     size_t mMapSize = 0;
+    // Union of the writable ranges handed out by GetMappedRange for the current mapping, in
+    // buffer offsets. Empty (begin == end) means no writable pointer was handed out.
+    size_t mDirtyBegin = 0;
+    size_t mDirtyEnd = 0;
 
     std::weak_ptr<bool> mDeviceIsAlive;
 };
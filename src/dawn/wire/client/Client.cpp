@@ -37,8 +37,13 @@ class NoopCommandSerializer final : public CommandSerializer {
 
 }  // anonymous namespace
 
-Client::Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService)
-    : ClientBase(), mSerializer(serializer), mMemoryTransferService(memoryTransferService) {
+Client::Client(CommandSerializer* serializer,
+               MemoryTransferService* memoryTransferService,
+               bool speculativeRequests)
+    : ClientBase(),
+      mSerializer(serializer),
+      mMemoryTransferService(memoryTransferService),
+      mSpeculativeRequests(speculativeRequests) {
     if (mMemoryTransferService == nullptr) {
         // If a MemoryTransferService is not provided, fall back to inline memory.
         mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
@@ -36,7 +36,9 @@ class MemoryTransferService;
 
 class Client : public ClientBase {
   public:
-    Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService);
+    Client(CommandSerializer* serializer,
+           MemoryTransferService* memoryTransferService,
+           bool speculativeRequests = false);
     ~Client() override;
 
     // Make<T>(arg1, arg2, arg3) creates a new T, calling a constructor of the form:
@@ -70,6 +72,9 @@ class Client : public ClientBase {
 
     MemoryTransferService* GetMemoryTransferService() const { return mMemoryTransferService; }
 
+    // See WireClientDescriptor::speculativeRequests.
+    bool AreSpeculativeRequestsEnabled() const { return mSpeculativeRequests; }
+
     ReservedTexture ReserveTexture(WGPUDevice device, const WGPUTextureDescriptor* descriptor);
     ReservedSwapChain ReserveSwapChain(WGPUDevice device);
     ReservedDevice ReserveDevice();
@@ -106,6 +111,7 @@ class Client : public ClientBase {
     MemoryTransferService* mMemoryTransferService = nullptr;
     std::unique_ptr<MemoryTransferService> mOwnedMemoryTransferService = nullptr;
     PerObjectType<LinkedList<ObjectBase>> mObjects;
+    bool mSpeculativeRequests = false;
     bool mDisconnected = false;
 };
 
@@ -88,13 +88,13 @@ bool Client::DoBufferMapAsyncCallback(Buffer* buffer,
 }
 
 bool Client::DoQueueWorkDoneCallback(Queue* queue,
-                                     uint64_t requestSerial,
+                                     uint64_t completedSerial,
                                      WGPUQueueWorkDoneStatus status) {
     // The queue might have been deleted or recreated so this isn't an error.
     if (queue == nullptr) {
         return true;
     }
-    return queue->OnWorkDoneCallback(requestSerial, status);
+    return queue->OnWorkDoneWatermark(completedSerial, status);
 }
 
 bool Client::DoDeviceCreateComputePipelineAsyncCallback(Device* device,
@@ -0,0 +1,143 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Platform.h"
+#include "dawn/wire/SharedMemoryTransferHelpers.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/client/Client.h"
+
+#if DAWN_PLATFORM_IS(POSIX)
+#include <atomic>
+#include <string>
+
+#include <unistd.h>
+#endif  // DAWN_PLATFORM_IS(POSIX)
+
+namespace dawn::wire::client {
+
+#if DAWN_PLATFORM_IS(POSIX)
+
+namespace {
+
+std::string MakeUniqueSegmentName() {
+    static std::atomic<uint64_t> sCounter{0};
+    return "/dawn-wire-" + std::to_string(getpid()) + "-" +
+           std::to_string(sCounter.fetch_add(1));
+}
+
+}  // anonymous namespace
+
+// Maps the same pages on the client and the server so that buffer data never travels through
+// the wire buffer: the client reads and writes the shared pages directly and data update
+// commands carry no payload. The client side owns the segment name and unlinks it when the
+// handle is destructed, so the server must have deserialized the handle creation (which is
+// ordered before any other command referencing it) by then; this holds whenever the embedder
+// flushes commands promptly.
+class SharedMemoryTransferService : public MemoryTransferService {
+    class ReadHandleImpl : public ReadHandle {
+      public:
+        explicit ReadHandleImpl(SharedMemorySegment segment) : mSegment(std::move(segment)) {}
+
+        ~ReadHandleImpl() override { mSegment.Destroy(true); }
+
+        size_t SerializeCreateSize() override { return mSegment.SerializeCreateSize(); }
+
+        void SerializeCreate(void* serializePointer) override {
+            mSegment.SerializeCreate(serializePointer);
+        }
+
+        const void* GetData() override { return mSegment.GetData(); }
+
+        bool DeserializeDataUpdate(const void* deserializePointer,
+                                   size_t deserializeSize,
+                                   size_t offset,
+                                   size_t size) override {
+            // The data was written by the server directly into the shared pages; only the
+            // range needs validation.
+            if (deserializeSize != 0) {
+                return false;
+            }
+            return offset <= mSegment.GetSize() && size <= mSegment.GetSize() - offset;
+        }
+
+      private:
+        SharedMemorySegment mSegment;
+    };
+
+    class WriteHandleImpl : public WriteHandle {
+      public:
+        explicit WriteHandleImpl(SharedMemorySegment segment) : mSegment(std::move(segment)) {}
+
+        ~WriteHandleImpl() override { mSegment.Destroy(true); }
+
+        size_t SerializeCreateSize() override { return mSegment.SerializeCreateSize(); }
+
+        void SerializeCreate(void* serializePointer) override {
+            mSegment.SerializeCreate(serializePointer);
+        }
+
+        void* GetData() override { return mSegment.GetData(); }
+
+        size_t SizeOfSerializeDataUpdate(size_t offset, size_t size) override {
+            ASSERT(offset <= mSegment.GetSize());
+            ASSERT(size <= mSegment.GetSize() - offset);
+            // The server reads the data out of the shared pages; nothing to serialize.
+            return 0;
+        }
+
+        void SerializeDataUpdate(void* serializePointer, size_t offset, size_t size) override {}
+
+      private:
+        SharedMemorySegment mSegment;
+    };
+
+  public:
+    SharedMemoryTransferService() {}
+    ~SharedMemoryTransferService() override = default;
+
+    ReadHandle* CreateReadHandle(size_t size) override {
+        SharedMemorySegment segment;
+        if (!segment.Create(MakeUniqueSegmentName(), size)) {
+            return nullptr;
+        }
+        return new ReadHandleImpl(std::move(segment));
+    }
+
+    WriteHandle* CreateWriteHandle(size_t size) override {
+        SharedMemorySegment segment;
+        if (!segment.Create(MakeUniqueSegmentName(), size)) {
+            return nullptr;
+        }
+        // Shared memory from shm_open/ftruncate is already zero-initialized.
+        return new WriteHandleImpl(std::move(segment));
+    }
+};
+
+std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService() {
+    return std::make_unique<SharedMemoryTransferService>();
+}
+
+#else  // DAWN_PLATFORM_IS(POSIX)
+
+std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService() {
+    return nullptr;
+}
+
+#endif  // DAWN_PLATFORM_IS(POSIX)
+
+}  // namespace dawn::wire::client
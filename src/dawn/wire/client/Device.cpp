@@ -230,7 +230,7 @@ WGPUQueue Device::GetQueue() {
     if (mQueue == nullptr) {
         // Get the primary queue for this device.
         Client* client = GetClient();
-        mQueue = client->Make<Queue>();
+        mQueue = client->Make<Queue>(this);
 
         DeviceGetQueueCmd cmd;
         cmd.self = ToAPI(this);
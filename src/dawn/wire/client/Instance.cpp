@@ -20,6 +20,10 @@ namespace dawn::wire::client {
 
 Instance::~Instance() {
     mRequestAdapterRequests.CloseAll([](RequestAdapterData* request) {
+        // Speculative requests already ran their callback when they were made.
+        if (request->speculative) {
+            return;
+        }
         request->callback(WGPURequestAdapterStatus_Unknown, nullptr,
                           "Instance destroyed before callback", request->userdata);
     });
@@ -27,6 +31,10 @@ Instance::~Instance() {
 
 void Instance::CancelCallbacksForDisconnect() {
     mRequestAdapterRequests.CloseAll([](RequestAdapterData* request) {
+        // Speculative requests already ran their callback when they were made.
+        if (request->speculative) {
+            return;
+        }
         request->callback(WGPURequestAdapterStatus_Unknown, nullptr, "GPU connection lost",
                           request->userdata);
     });
@@ -41,8 +49,10 @@ void Instance::RequestAdapter(const WGPURequestAdapterOptions* options,
         return;
     }
 
+    bool speculative = client->AreSpeculativeRequestsEnabled();
     Adapter* adapter = client->Make<Adapter>();
-    uint64_t serial = mRequestAdapterRequests.Add({callback, adapter->GetWireId(), userdata});
+    uint64_t serial =
+        mRequestAdapterRequests.Add({callback, adapter->GetWireId(), userdata, speculative});
 
     InstanceRequestAdapterCmd cmd;
     cmd.instanceId = GetWireId();
@@ -51,6 +61,12 @@ void Instance::RequestAdapter(const WGPURequestAdapterOptions* options,
     cmd.options = options;
 
     client->SerializeCommand(cmd);
+
+    if (speculative) {
+        // Hand the adapter out immediately so that requests against it pipeline; the reply
+        // backfills its properties, or fails subsequent RequestDevice calls on it.
+        callback(WGPURequestAdapterStatus_Success, ToAPI(adapter), nullptr, userdata);
+    }
 }
 
 bool Client::DoInstanceRequestAdapterCallback(Instance* instance,
@@ -87,6 +103,13 @@ bool Instance::OnRequestAdapterCallback(uint64_t requestSerial,
     // If the return status is a failure we should give a null adapter to the callback and
     // free the allocation.
     if (status != WGPURequestAdapterStatus_Success) {
+        if (request.speculative) {
+            // The callback already ran with the adapter, and the application may hold it or
+            // have device requests in flight against it; replay the error through those
+            // instead of freeing it.
+            adapter->MarkSpeculationFailed(message);
+            return true;
+        }
         client->Free(adapter);
         request.callback(status, nullptr, message, request.userdata);
         return true;
@@ -96,6 +119,9 @@ bool Instance::OnRequestAdapterCallback(uint64_t requestSerial,
     adapter->SetLimits(limits);
     adapter->SetFeatures(features, featuresCount);
 
+    if (request.speculative) {
+        return true;
+    }
     request.callback(status, ToAPI(adapter), message, request.userdata);
     return true;
 }
@@ -47,6 +47,9 @@ class Instance final : public ObjectBase {
         WGPURequestAdapterCallback callback = nullptr;
         ObjectId adapterObjectId;
         void* userdata = nullptr;
+        // True when the callback already ran speculatively and the reply only backfills
+        // the result. See WireClientDescriptor::speculativeRequests.
+        bool speculative = false;
     };
     RequestTracker<RequestAdapterData> mRequestAdapterRequests;
 };
@@ -14,22 +14,25 @@
 
 #include "dawn/wire/client/Queue.h"
 
+#include "dawn/wire/client/Buffer.h"
 #include "dawn/wire/client/Client.h"
 #include "dawn/wire/client/Device.h"
 
 namespace dawn::wire::client {
 
+Queue::Queue(const ObjectBaseParams& params, Device* device)
+    : ObjectBase(params), mDevice(device) {}
+
 Queue::~Queue() {
     ClearAllCallbacks(WGPUQueueWorkDoneStatus_Unknown);
 }
 
-bool Queue::OnWorkDoneCallback(uint64_t requestSerial, WGPUQueueWorkDoneStatus status) {
-    OnWorkDoneData request;
-    if (!mOnWorkDoneRequests.Acquire(requestSerial, &request)) {
-        return false;
-    }
-
-    request.callback(status, request.userdata);
+bool Queue::OnWorkDoneWatermark(uint64_t completedSerial, WGPUQueueWorkDoneStatus status) {
+    // The watermark may cover requests that were already completed by a disconnect, so
+    // covering no request at all isn't an error.
+    mOnWorkDoneRequests.AcquireAllUpTo(completedSerial, [status](OnWorkDoneData* request) {
+        request->callback(status, request->userdata);
+    });
     return true;
 }
 
@@ -55,6 +58,26 @@ void Queue::OnSubmittedWorkDone(uint64_t signalValue,
 void Queue::WriteBuffer(WGPUBuffer cBuffer, uint64_t bufferOffset, const void* data, size_t size) {
     Buffer* buffer = FromAPI(cBuffer);
 
+    // Validate the write range against client-known buffer state so that malformed writes
+    // neither copy their payload over the wire nor need a server round trip to surface the
+    // error. The server still validates everything it receives; it never trusts the client.
+    if (bufferOffset % 4 != 0) {
+        mDevice->InjectError(WGPUErrorType_Validation,
+                             "Queue::WriteBuffer bufferOffset is not a multiple of 4");
+        return;
+    }
+    if (size % 4 != 0) {
+        mDevice->InjectError(WGPUErrorType_Validation,
+                             "Queue::WriteBuffer size is not a multiple of 4");
+        return;
+    }
+    const uint64_t bufferSize = buffer->GetSize();
+    if (bufferOffset > bufferSize || size > bufferSize - bufferOffset) {
+        mDevice->InjectError(WGPUErrorType_Validation,
+                             "Queue::WriteBuffer write range does not fit in the buffer");
+        return;
+    }
+
     QueueWriteBufferCmd cmd;
     cmd.queueId = GetWireId();
     cmd.bufferId = buffer->GetWireId();
@@ -23,12 +23,16 @@
 
 namespace dawn::wire::client {
 
+class Device;
+
 class Queue final : public ObjectBase {
   public:
-    using ObjectBase::ObjectBase;
+    Queue(const ObjectBaseParams& params, Device* device);
     ~Queue() override;
 
-    bool OnWorkDoneCallback(uint64_t requestSerial, WGPUQueueWorkDoneStatus status);
+    // The server coalesces work-done completions into a watermark: every tracked request with
+    // a serial up to |completedSerial| completed with |status| and has its callback called.
+    bool OnWorkDoneWatermark(uint64_t completedSerial, WGPUQueueWorkDoneStatus status);
 
     // Dawn API
     void OnSubmittedWorkDone(uint64_t signalValue,
@@ -50,6 +54,10 @@ class Queue final : public ObjectBase {
         void* userdata = nullptr;
     };
     RequestTracker<OnWorkDoneData> mOnWorkDoneRequests;
+
+    // The device this queue was retrieved from, used to inject errors found by client-side
+    // validation without a server round trip.
+    Device* mDevice;
 };
 
 }  // namespace dawn::wire::client
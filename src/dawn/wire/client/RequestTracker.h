@@ -64,6 +64,19 @@ class RequestTracker : NonCopyable {
         }
     }
 
+    // Acquires every request with a serial up to |serial| and calls f on each, in serial
+    // order. Reentrant additions from inside f get serials greater than |serial| and are not
+    // visited.
+    template <typename F>
+    void AcquireAllUpTo(uint64_t serial, F&& f) {
+        while (!mRequests.empty() && mRequests.begin()->first <= serial) {
+            auto it = mRequests.begin();
+            Request request = std::move(it->second);
+            mRequests.erase(it);
+            f(&request);
+        }
+    }
+
     template <typename F>
     void ForAll(F&& f) {
         for (auto& [_, request] : mRequests) {
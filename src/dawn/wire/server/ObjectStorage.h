@@ -148,6 +148,12 @@ class KnownObjectsBase {
         return &mKnown[id];
     }
 
+    // Returns true iff the ID has been allocated before but is not currently allocated, for
+    // example because a failed request freed its reservation server-side first.
+    bool IsFreedId(uint32_t id) const {
+        return id != 0 && id < mKnown.size() && mKnown[id].state == AllocationState::Free;
+    }
+
     // Marks an ID as deallocated
     void Free(uint32_t id) {
         ASSERT(id < mKnown.size());
@@ -35,6 +35,8 @@ Server::Server(const DawnProcTable& procs,
 }
 
 Server::~Server() {
+    StopCapture();
+
     // Un-set the error and lost callbacks since we cannot forward them
     // after the server has been destroyed.
     for (WGPUDevice device : DeviceObjects().GetAllHandles()) {
@@ -43,6 +45,35 @@ Server::~Server() {
     DestroyAllObjects(mProcs);
 }
 
+const volatile char* Server::HandleCommands(const volatile char* commands, size_t size) {
+    if (mCaptureFile != nullptr) {
+        // Record the buffer with its exact framing so a replay can hand the same sequence of
+        // buffers back to HandleCommands, including any chunking the client performed.
+        uint64_t bufferSize = size;
+        fwrite(&bufferSize, sizeof(bufferSize), 1, mCaptureFile);
+        fwrite(const_cast<const char*>(commands), 1, size, mCaptureFile);
+    }
+    return ChunkedCommandHandler::HandleCommands(commands, size);
+}
+
+bool Server::StartCapture(const char* filePath) {
+    StopCapture();
+    mCaptureFile = fopen(filePath, "wb");
+    if (mCaptureFile == nullptr) {
+        return false;
+    }
+    fwrite(&kWireCaptureMagic, sizeof(kWireCaptureMagic), 1, mCaptureFile);
+    fwrite(&kWireCaptureVersion, sizeof(kWireCaptureVersion), 1, mCaptureFile);
+    return true;
+}
+
+void Server::StopCapture() {
+    if (mCaptureFile != nullptr) {
+        fclose(mCaptureFile);
+        mCaptureFile = nullptr;
+    }
+}
+
 bool Server::InjectTexture(WGPUTexture texture,
                            uint32_t id,
                            uint32_t generation,
@@ -15,8 +15,10 @@
 #ifndef SRC_DAWN_WIRE_SERVER_SERVER_H_
 #define SRC_DAWN_WIRE_SERVER_SERVER_H_
 
+#include <cstdio>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "dawn/wire/ChunkedCommandSerializer.h"
 #include "dawn/wire/server/ServerBase_autogen.h"
@@ -150,9 +152,18 @@ class Server : public ServerBase {
            MemoryTransferService* memoryTransferService);
     ~Server() override;
 
+    // CommandHandler implementation. Appends the raw stream to the capture file when capture
+    // is active before dispatching through ChunkedCommandHandler.
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override;
+
     // ChunkedCommandHandler implementation
     const volatile char* HandleCommandsImpl(const volatile char* commands, size_t size) override;
 
+    // Starts appending every buffer passed to HandleCommands to |filePath|, preserving the
+    // exact framing the client produced. Returns false if the file cannot be opened.
+    bool StartCapture(const char* filePath);
+    void StopCapture();
+
     bool InjectTexture(WGPUTexture texture,
                        uint32_t id,
                        uint32_t generation,
@@ -194,6 +205,32 @@ class Server : public ServerBase {
     void SetForwardingDeviceCallbacks(ObjectData<WGPUDevice>* deviceObject);
     void ClearDeviceCallbacks(WGPUDevice device);
 
+    // Queue writes are not issued to the native queue immediately: consecutive WriteBuffer
+    // commands of a flush gather their data into mPendingQueueWriteData and adjacent writes to
+    // the same buffer merge into a single native call. Any other command acts as a barrier and
+    // flushes the pending writes so native calls still happen in wire order. See
+    // Server::DoQueueWriteBuffer.
+    struct PendingQueueWrite {
+        WGPUQueue queue;
+        WGPUBuffer buffer;
+        uint64_t offset;
+        size_t dataOffset;
+        size_t size;
+    };
+    void WillHandleCommand(WireCmd cmdId);
+    void FlushPendingQueueWrites();
+
+    // Work-done completions are coalesced the same way on the return path: completions
+    // observed while handling a command stream only advance a per-queue watermark, flushed as
+    // a single return command at the end of the stream. See Server::OnQueueWorkDone.
+    struct QueueWorkDoneWatermark {
+        ObjectHandle queue;
+        uint64_t completedSerial;
+        WGPUQueueWorkDoneStatus status;
+    };
+    void SerializeQueueWorkDoneWatermark(const QueueWorkDoneWatermark& watermark);
+    void FlushQueueWorkDoneWatermarks();
+
     // Error callbacks
     void OnUncapturedError(ObjectHandle device, WGPUErrorType type, const char* message);
     void OnDeviceLost(ObjectHandle device, WGPUDeviceLostReason reason, const char* message);
@@ -225,6 +262,17 @@ class Server : public ServerBase {
 
 #include "dawn/wire/server/ServerPrototypes_autogen.inc"
 
+    std::vector<PendingQueueWrite> mPendingQueueWrites;
+    std::vector<uint8_t> mPendingQueueWriteData;
+    // Few queues exist at a time, so a linear scan by handle is fine.
+    std::vector<QueueWorkDoneWatermark> mQueueWorkDoneWatermarks;
+    // True while HandleCommandsImpl is on the stack. Work-done completions only accumulate
+    // into watermarks during a command stream, where the end-of-stream flush is guaranteed to
+    // run; completions firing outside of one (from the embedder ticking the device) are
+    // serialized immediately so a quiescent client is not starved. Set by the generated
+    // HandleCommandsImpl.
+    bool mIsHandlingCommands = false;
+
     WireDeserializeAllocator mAllocator;
     ChunkedCommandSerializer mSerializer;
     DawnProcTable mProcs;
@@ -232,6 +280,8 @@ class Server : public ServerBase {
     MemoryTransferService* mMemoryTransferService = nullptr;
 
     std::shared_ptr<bool> mIsAlive;
+
+    FILE* mCaptureFile = nullptr;
 };
 
 std::unique_ptr<MemoryTransferService> CreateInlineMemoryTransferService();
@@ -25,7 +25,17 @@ bool Server::DoAdapterRequestDevice(ObjectId adapterId,
                                     const WGPUDeviceDescriptor* descriptor) {
     auto* adapter = AdapterObjects().Get(adapterId);
     if (adapter == nullptr) {
-        return false;
+        // The adapter may have been freed because its own request failed while the client
+        // pipelined this request against it speculatively. The client already failed this
+        // request when it received the adapter error, which was serialized before this
+        // command, so drop it; the device ID is still reserved and freed to keep the ID
+        // bookkeeping of both sides in sync.
+        auto* droppedData = DeviceObjects().Allocate(deviceHandle.id, AllocationState::Reserved);
+        if (droppedData == nullptr) {
+            return false;
+        }
+        DeviceObjects().Free(deviceHandle.id);
+        return true;
     }
 
     auto* resultData = DeviceObjects().Allocate(deviceHandle.id, AllocationState::Reserved);
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <limits>
 
 #include "dawn/common/Assert.h"
@@ -19,15 +20,60 @@
 
 namespace dawn::wire::server {
 
+namespace {
+
+// Writes larger than this don't benefit from gathering and go straight to the native queue.
+constexpr uint64_t kMaxCoalescedWriteSize = 64 * 1024;
+// Cap on the staging gather buffer so a flush full of writes doesn't hold arbitrary memory.
+constexpr size_t kMaxPendingWriteDataSize = 1024 * 1024;
+
+}  // anonymous namespace
+
 void Server::OnQueueWorkDone(QueueWorkDoneUserdata* data, WGPUQueueWorkDoneStatus status) {
+    // Outside of a command stream (the embedder ticking the device with no client traffic)
+    // there is no upcoming end-of-stream flush, so return the completion immediately instead
+    // of starving a quiescent client until its next command.
+    if (!mIsHandlingCommands) {
+        SerializeQueueWorkDoneWatermark({data->queue, data->requestSerial, status});
+        return;
+    }
+
+    // Completions aren't returned to the client one by one. Requests complete in registration
+    // order, so completions observed while handling a command stream only advance a per-queue
+    // watermark that is sent as a single return command at the end of the stream; the client
+    // fans it out to its tracked callbacks.
+    for (QueueWorkDoneWatermark& watermark : mQueueWorkDoneWatermarks) {
+        if (watermark.queue.id == data->queue.id &&
+            watermark.queue.generation == data->queue.generation) {
+            if (watermark.status != status) {
+                // Completions with different statuses may not be folded into one watermark.
+                // Flush the previous batch and start a new one.
+                SerializeQueueWorkDoneWatermark(watermark);
+                watermark.status = status;
+            }
+            watermark.completedSerial = std::max(watermark.completedSerial, data->requestSerial);
+            return;
+        }
+    }
+    mQueueWorkDoneWatermarks.push_back({data->queue, data->requestSerial, status});
+}
+
+void Server::SerializeQueueWorkDoneWatermark(const QueueWorkDoneWatermark& watermark) {
     ReturnQueueWorkDoneCallbackCmd cmd;
-    cmd.queue = data->queue;
-    cmd.requestSerial = data->requestSerial;
-    cmd.status = status;
+    cmd.queue = watermark.queue;
+    cmd.completedSerial = watermark.completedSerial;
+    cmd.status = watermark.status;
 
     SerializeCommand(cmd);
 }
 
+void Server::FlushQueueWorkDoneWatermarks() {
+    for (const QueueWorkDoneWatermark& watermark : mQueueWorkDoneWatermarks) {
+        SerializeQueueWorkDoneWatermark(watermark);
+    }
+    mQueueWorkDoneWatermarks.clear();
+}
+
 bool Server::DoQueueOnSubmittedWorkDone(ObjectId queueId,
                                         uint64_t signalValue,
                                         uint64_t requestSerial) {
@@ -62,11 +108,57 @@ bool Server::DoQueueWriteBuffer(ObjectId queueId,
         return false;
     }
 
-    mProcs.queueWriteBuffer(queue->handle, buffer->handle, bufferOffset, data,
-                            static_cast<size_t>(size));
+    // Large writes bypass the staging gather buffer, but the pending writes must be issued
+    // first so writes to the same buffer still land in wire order.
+    if (size > kMaxCoalescedWriteSize) {
+        FlushPendingQueueWrites();
+        mProcs.queueWriteBuffer(queue->handle, buffer->handle, bufferOffset, data,
+                                static_cast<size_t>(size));
+        return true;
+    }
+
+    if (mPendingQueueWriteData.size() + static_cast<size_t>(size) > kMaxPendingWriteDataSize) {
+        FlushPendingQueueWrites();
+    }
+
+    // The command data lives in the deserialization buffer which is recycled after each
+    // command, so the bytes are copied into the server's gather buffer.
+    size_t dataOffset = mPendingQueueWriteData.size();
+    mPendingQueueWriteData.insert(mPendingQueueWriteData.end(), data, data + size);
+
+    // Merge with the previous write when it ends exactly where this one starts; the data is
+    // already contiguous in the gather buffer.
+    if (!mPendingQueueWrites.empty()) {
+        PendingQueueWrite& last = mPendingQueueWrites.back();
+        if (last.queue == queue->handle && last.buffer == buffer->handle &&
+            last.offset + last.size == bufferOffset) {
+            last.size += static_cast<size_t>(size);
+            return true;
+        }
+    }
+
+    mPendingQueueWrites.push_back(
+        {queue->handle, buffer->handle, bufferOffset, dataOffset, static_cast<size_t>(size)});
     return true;
 }
 
+void Server::FlushPendingQueueWrites() {
+    for (const PendingQueueWrite& write : mPendingQueueWrites) {
+        mProcs.queueWriteBuffer(write.queue, write.buffer, write.offset,
+                                mPendingQueueWriteData.data() + write.dataOffset, write.size);
+    }
+    mPendingQueueWrites.clear();
+    mPendingQueueWriteData.clear();
+}
+
+void Server::WillHandleCommand(WireCmd cmdId) {
+    // Only another WriteBuffer may jump the deferred writes. Everything else, including
+    // WriteTexture, Submit, and object destruction, must observe them in wire order.
+    if (cmdId != WireCmd::QueueWriteBuffer && !mPendingQueueWrites.empty()) {
+        FlushPendingQueueWrites();
+    }
+}
+
 bool Server::DoQueueWriteTexture(ObjectId queueId,
                                  const WGPUImageCopyTexture* destination,
                                  const uint8_t* data,
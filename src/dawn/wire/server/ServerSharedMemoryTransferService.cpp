@@ -0,0 +1,131 @@
+// Copyright 2022 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Platform.h"
+#include "dawn/wire/SharedMemoryTransferHelpers.h"
+#include "dawn/wire/WireServer.h"
+#include "dawn/wire/server/Server.h"
+
+#if DAWN_PLATFORM_IS(POSIX)
+#include <utility>
+#endif  // DAWN_PLATFORM_IS(POSIX)
+
+namespace dawn::wire::server {
+
+#if DAWN_PLATFORM_IS(POSIX)
+
+// Server side of the shared memory transfer service. Handles map the segment created by the
+// client so that data updates move through a single memcpy between the shared pages and the
+// mapped buffer memory instead of traversing the wire buffer.
+class SharedMemoryTransferService : public MemoryTransferService {
+  public:
+    class ReadHandleImpl : public ReadHandle {
+      public:
+        explicit ReadHandleImpl(SharedMemorySegment segment) : mSegment(std::move(segment)) {}
+        ~ReadHandleImpl() override { mSegment.Destroy(false); }
+
+        size_t SizeOfSerializeDataUpdate(size_t offset, size_t size) override {
+            // The data is copied into the shared pages; the command carries no payload.
+            return 0;
+        }
+
+        void SerializeDataUpdate(const void* data,
+                                 size_t offset,
+                                 size_t size,
+                                 void* serializePointer) override {
+            if (size > 0) {
+                ASSERT(data != nullptr);
+                ASSERT(offset <= mSegment.GetSize());
+                ASSERT(size <= mSegment.GetSize() - offset);
+                memcpy(static_cast<uint8_t*>(mSegment.GetData()) + offset, data, size);
+            }
+        }
+
+      private:
+        SharedMemorySegment mSegment;
+    };
+
+    class WriteHandleImpl : public WriteHandle {
+      public:
+        explicit WriteHandleImpl(SharedMemorySegment segment) : mSegment(std::move(segment)) {}
+        ~WriteHandleImpl() override { mSegment.Destroy(false); }
+
+        bool DeserializeDataUpdate(const void* deserializePointer,
+                                   size_t deserializeSize,
+                                   size_t offset,
+                                   size_t size) override {
+            // The client wrote the data into the shared pages; the command payload is empty.
+            if (deserializeSize != 0 || mTargetData == nullptr) {
+                return false;
+            }
+            if (offset > mDataLength || size > mDataLength - offset) {
+                return false;
+            }
+            if (offset > mSegment.GetSize() || size > mSegment.GetSize() - offset) {
+                return false;
+            }
+            memcpy(static_cast<uint8_t*>(mTargetData) + offset,
+                   static_cast<const uint8_t*>(mSegment.GetData()) + offset, size);
+            return true;
+        }
+
+      private:
+        SharedMemorySegment mSegment;
+    };
+
+    SharedMemoryTransferService() {}
+    ~SharedMemoryTransferService() override = default;
+
+    bool DeserializeReadHandle(const void* deserializePointer,
+                               size_t deserializeSize,
+                               ReadHandle** readHandle) override {
+        ASSERT(readHandle != nullptr);
+        SharedMemorySegment segment;
+        if (!segment.Deserialize(deserializePointer, deserializeSize)) {
+            return false;
+        }
+        *readHandle = new ReadHandleImpl(std::move(segment));
+        return true;
+    }
+
+    bool DeserializeWriteHandle(const void* deserializePointer,
+                                size_t deserializeSize,
+                                WriteHandle** writeHandle) override {
+        ASSERT(writeHandle != nullptr);
+        SharedMemorySegment segment;
+        if (!segment.Deserialize(deserializePointer, deserializeSize)) {
+            return false;
+        }
+        *writeHandle = new WriteHandleImpl(std::move(segment));
+        return true;
+    }
+};
+
+std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService() {
+    return std::make_unique<SharedMemoryTransferService>();
+}
+
+#else  // DAWN_PLATFORM_IS(POSIX)
+
+std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService() {
+    return nullptr;
+}
+
+#endif  // DAWN_PLATFORM_IS(POSIX)
+
+}  // namespace dawn::wire::server
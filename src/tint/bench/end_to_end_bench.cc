@@ -0,0 +1,136 @@
+// Copyright 2022 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "src/tint/bench/benchmark.h"
+
+namespace tint::bench {
+namespace {
+
+// The benchmarks in this file measure full WGSL compiles - parse, resolve,
+// sanitizing transforms and backend generation - per backend writer. The
+// per-phase benchmarks (reader/wgsl/parser_bench.cc and the per-writer
+// generator_bench.cc files) attribute time to the individual phases; these
+// track the total an embedder pays for one shader module.
+
+#if TINT_BUILD_SPV_WRITER
+void CompileSPIRV(benchmark::State& state, std::string input_name) {
+    auto res = LoadInputFile(input_name);
+    if (auto err = std::get_if<Error>(&res)) {
+        state.SkipWithError(err->msg.c_str());
+        return;
+    }
+    auto& file = std::get<Source::File>(res);
+    for (auto _ : state) {
+        auto program = reader::wgsl::Parse(&file);
+        if (program.Diagnostics().contains_errors()) {
+            state.SkipWithError(program.Diagnostics().str().c_str());
+            return;
+        }
+        auto gen = writer::spirv::Generate(&program, {});
+        if (!gen.error.empty()) {
+            state.SkipWithError(gen.error.c_str());
+            return;
+        }
+    }
+}
+
+TINT_BENCHMARK_WGSL_PROGRAMS(CompileSPIRV);
+#endif  // TINT_BUILD_SPV_WRITER
+
+#if TINT_BUILD_HLSL_WRITER
+void CompileHLSL(benchmark::State& state, std::string input_name) {
+    auto res = LoadInputFile(input_name);
+    if (auto err = std::get_if<Error>(&res)) {
+        state.SkipWithError(err->msg.c_str());
+        return;
+    }
+    auto& file = std::get<Source::File>(res);
+    for (auto _ : state) {
+        auto program = reader::wgsl::Parse(&file);
+        if (program.Diagnostics().contains_errors()) {
+            state.SkipWithError(program.Diagnostics().str().c_str());
+            return;
+        }
+        auto gen = writer::hlsl::Generate(&program, {});
+        if (!gen.error.empty()) {
+            state.SkipWithError(gen.error.c_str());
+            return;
+        }
+    }
+}
+
+TINT_BENCHMARK_WGSL_PROGRAMS(CompileHLSL);
+#endif  // TINT_BUILD_HLSL_WRITER
+
+#if TINT_BUILD_MSL_WRITER
+void CompileMSL(benchmark::State& state, std::string input_name) {
+    auto res = LoadInputFile(input_name);
+    if (auto err = std::get_if<Error>(&res)) {
+        state.SkipWithError(err->msg.c_str());
+        return;
+    }
+    auto& file = std::get<Source::File>(res);
+    for (auto _ : state) {
+        auto program = reader::wgsl::Parse(&file);
+        if (program.Diagnostics().contains_errors()) {
+            state.SkipWithError(program.Diagnostics().str().c_str());
+            return;
+        }
+        auto gen = writer::msl::Generate(&program, {});
+        if (!gen.error.empty()) {
+            state.SkipWithError(gen.error.c_str());
+            return;
+        }
+    }
+}
+
+TINT_BENCHMARK_WGSL_PROGRAMS(CompileMSL);
+#endif  // TINT_BUILD_MSL_WRITER
+
+#if TINT_BUILD_GLSL_WRITER
+void CompileGLSL(benchmark::State& state, std::string input_name) {
+    auto res = LoadInputFile(input_name);
+    if (auto err = std::get_if<Error>(&res)) {
+        state.SkipWithError(err->msg.c_str());
+        return;
+    }
+    auto& file = std::get<Source::File>(res);
+    for (auto _ : state) {
+        auto program = reader::wgsl::Parse(&file);
+        if (program.Diagnostics().contains_errors()) {
+            state.SkipWithError(program.Diagnostics().str().c_str());
+            return;
+        }
+        for (auto& fn : program.AST().Functions()) {
+            if (!fn->IsEntryPoint()) {
+                continue;
+            }
+            auto ep = program.Symbols().NameFor(fn->symbol);
+            auto gen = writer::glsl::Generate(&program, {}, ep);
+            if (!gen.error.empty()) {
+                state.SkipWithError(gen.error.c_str());
+                return;
+            }
+        }
+    }
+}
+
+TINT_BENCHMARK_WGSL_PROGRAMS(CompileGLSL);
+#endif  // TINT_BUILD_GLSL_WRITER
+
+}  // namespace
+}  // namespace tint::bench
@@ -131,6 +131,12 @@ ${transforms}
   --xcrun                   -- Path to xcrun executable, used to validate MSL output.
                                When specified, automatically enables MSL validation
   --overrides               -- Override values as IDENTIFIER=VALUE, comma-separated.
+  --batch <file>            -- Batch mode. Each non-empty line of <file> is a
+                               whitespace-separated tint argument list, run as one
+                               job in this process, amortizing process startup over
+                               many shaders. Use "-" to read jobs from stdin.
+                               Lines starting with # are ignored. Exits non-zero if
+                               any job fails.
 )";
 
 Format parse_format(const std::string& fmt) {
@@ -982,24 +988,9 @@ bool GenerateGlsl(const tint::Program* program, const Options& options) {
 #endif  // TINT_BUILD_GLSL_WRITER
 }
 
-}  // namespace
-
-int main(int argc, const char** argv) {
-    std::vector<std::string> args(argv, argv + argc);
+int RunJob(const std::vector<std::string>& args) {
     Options options;
 
-    tint::SetInternalCompilerErrorReporter(&TintInternalCompilerErrorReporter);
-
-#if TINT_BUILD_WGSL_WRITER
-    tint::Program::printer = [](const tint::Program* program) {
-        auto result = tint::writer::wgsl::Generate(program, {});
-        if (!result.error.empty()) {
-            return "error: " + result.error;
-        }
-        return result.wgsl;
-    };
-#endif  // TINT_BUILD_WGSL_WRITER
-
     if (!ParseArgs(args, &options)) {
         std::cerr << "Failed to parse arguments." << std::endl;
         return 1;
@@ -1344,3 +1335,70 @@ int main(int argc, const char** argv) {
 
     return 0;
 }
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+    std::vector<std::string> args(argv, argv + argc);
+
+    tint::SetInternalCompilerErrorReporter(&TintInternalCompilerErrorReporter);
+
+#if TINT_BUILD_WGSL_WRITER
+    tint::Program::printer = [](const tint::Program* program) {
+        auto result = tint::writer::wgsl::Generate(program, {});
+        if (!result.error.empty()) {
+            return "error: " + result.error;
+        }
+        return result.wgsl;
+    };
+#endif  // TINT_BUILD_WGSL_WRITER
+
+    // Batch mode runs many jobs in a single process, as process startup dominates wall time
+    // when compiling large batches of small shaders.
+    if (args.size() >= 2 && args[1] == "--batch") {
+        if (args.size() != 3) {
+            std::cerr << "--batch expects a single job file argument (or - for stdin), and no "
+                         "other arguments."
+                      << std::endl;
+            return 1;
+        }
+
+        std::ifstream file;
+        bool use_stdin = args[2] == "-";
+        if (!use_stdin) {
+            file.open(args[2]);
+            if (!file) {
+                std::cerr << "Failed to open batch file: " << args[2] << std::endl;
+                return 1;
+            }
+        }
+        std::istream& jobs = use_stdin ? std::cin : file;
+
+        int failed = 0;
+        int line_num = 0;
+        std::string line;
+        while (std::getline(jobs, line)) {
+            line_num++;
+            std::vector<std::string> job_args{args[0]};
+            std::istringstream tokens(line);
+            std::string token;
+            while (tokens >> token) {
+                job_args.push_back(token);
+            }
+            if (job_args.size() == 1 || job_args[1][0] == '#') {
+                continue;
+            }
+            if (RunJob(job_args) != 0) {
+                std::cerr << "Batch job failed at line " << line_num << ": " << line << std::endl;
+                failed++;
+            }
+        }
+        if (failed > 0) {
+            std::cerr << failed << " batch job(s) failed." << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    return RunJob(args);
+}
@@ -14,6 +14,7 @@
 
 #include "src/tint/inspector/inspector.h"
 
+#include <array>
 #include <limits>
 #include <utility>
 
@@ -41,6 +42,7 @@
 #include "src/tint/sem/module.h"
 #include "src/tint/sem/multisampled_texture.h"
 #include "src/tint/sem/sampled_texture.h"
+#include "src/tint/sem/sampler.h"
 #include "src/tint/sem/statement.h"
 #include "src/tint/sem/storage_texture.h"
 #include "src/tint/sem/struct.h"
@@ -56,16 +58,6 @@ namespace tint::inspector {
 
 namespace {
 
-void AppendResourceBindings(std::vector<ResourceBinding>* dest,
-                            const std::vector<ResourceBinding>& orig) {
-    TINT_ASSERT(Inspector, dest);
-    if (!dest) {
-        return;
-    }
-
-    dest->reserve(dest->size() + orig.size());
-    dest->insert(dest->end(), orig.begin(), orig.end());
-}
 
 std::tuple<ComponentType, CompositionType> CalculateComponentAndComposition(const sem::Type* type) {
     if (type->is_float_scalar()) {
@@ -333,22 +325,84 @@ std::vector<ResourceBinding> Inspector::GetResourceBindings(const std::string& e
         return {};
     }
 
+    auto cached = resource_bindings_cache_.find(entry_point);
+    if (cached != resource_bindings_cache_.end()) {
+        return cached->second;
+    }
+
+    // Gather all the bindings in a single walk of the transitively referenced globals instead
+    // of one walk per resource type, keeping the result grouped by resource type in the order
+    // the per-type getters would have been appended.
+    constexpr size_t kNumResourceTypes =
+        static_cast<size_t>(ResourceBinding::ResourceType::kExternalTexture) + 1u;
+    std::array<std::vector<ResourceBinding>, kNumResourceTypes> grouped;
+
+    auto* func_sem = program_->Sem().Get(func);
+    for (auto* global : func_sem->TransitivelyReferencedGlobals()) {
+        if (!global->Declaration()->HasBindingPoint()) {
+            continue;
+        }
+        auto binding_info = global->BindingPoint();
+        auto* unwrapped_type = global->Type()->UnwrapRef();
+
+        ResourceBinding entry;
+        entry.bind_group = binding_info.group;
+        entry.binding = binding_info.binding;
+
+        if (global->StorageClass() == ast::StorageClass::kUniform ||
+            global->StorageClass() == ast::StorageClass::kStorage) {
+            if (global->StorageClass() == ast::StorageClass::kUniform) {
+                entry.resource_type = ResourceBinding::ResourceType::kUniformBuffer;
+            } else if (global->Access() == ast::Access::kRead) {
+                entry.resource_type = ResourceBinding::ResourceType::kReadOnlyStorageBuffer;
+            } else {
+                entry.resource_type = ResourceBinding::ResourceType::kStorageBuffer;
+            }
+            entry.size = unwrapped_type->Size();
+            if (auto* str = unwrapped_type->As<sem::Struct>()) {
+                entry.size_no_padding = str->SizeNoPadding();
+            } else {
+                entry.size_no_padding = entry.size;
+            }
+        } else if (auto* sampler = unwrapped_type->As<sem::Sampler>()) {
+            entry.resource_type = sampler->IsComparison()
+                                      ? ResourceBinding::ResourceType::kComparisonSampler
+                                      : ResourceBinding::ResourceType::kSampler;
+        } else if (auto* texture = unwrapped_type->As<sem::Texture>()) {
+            entry.dim = TypeTextureDimensionToResourceBindingTextureDimension(texture->dim());
+            if (auto* sampled = texture->As<sem::SampledTexture>()) {
+                entry.resource_type = ResourceBinding::ResourceType::kSampledTexture;
+                entry.sampled_kind = BaseTypeToSampledKind(sampled->type());
+            } else if (auto* multisampled = texture->As<sem::MultisampledTexture>()) {
+                entry.resource_type = ResourceBinding::ResourceType::kMultisampledTexture;
+                entry.sampled_kind = BaseTypeToSampledKind(multisampled->type());
+            } else if (auto* storage = texture->As<sem::StorageTexture>()) {
+                entry.resource_type = ResourceBinding::ResourceType::kWriteOnlyStorageTexture;
+                entry.sampled_kind = BaseTypeToSampledKind(storage->type());
+                entry.image_format =
+                    TypeTexelFormatToResourceBindingTexelFormat(storage->texel_format());
+            } else if (texture->Is<sem::DepthTexture>()) {
+                entry.resource_type = ResourceBinding::ResourceType::kDepthTexture;
+            } else if (texture->Is<sem::DepthMultisampledTexture>()) {
+                entry.resource_type = ResourceBinding::ResourceType::kDepthMultisampledTexture;
+            } else if (texture->Is<sem::ExternalTexture>()) {
+                entry.resource_type = ResourceBinding::ResourceType::kExternalTexture;
+            } else {
+                continue;
+            }
+        } else {
+            continue;
+        }
+
+        grouped[static_cast<size_t>(entry.resource_type)].push_back(entry);
+    }
+
     std::vector<ResourceBinding> result;
-    for (auto fn : {
-             &Inspector::GetUniformBufferResourceBindings,
-             &Inspector::GetStorageBufferResourceBindings,
-             &Inspector::GetReadOnlyStorageBufferResourceBindings,
-             &Inspector::GetSamplerResourceBindings,
-             &Inspector::GetComparisonSamplerResourceBindings,
-             &Inspector::GetSampledTextureResourceBindings,
-             &Inspector::GetMultisampledTextureResourceBindings,
-             &Inspector::GetWriteOnlyStorageTextureResourceBindings,
-             &Inspector::GetDepthTextureResourceBindings,
-             &Inspector::GetDepthMultisampledTextureResourceBindings,
-             &Inspector::GetExternalTextureResourceBindings,
-         }) {
-        AppendResourceBindings(&result, (this->*fn)(entry_point));
+    for (auto& group : grouped) {
+        result.insert(result.end(), group.begin(), group.end());
     }
+
+    resource_bindings_cache_.emplace(entry_point, result);
     return result;
 }
 
@@ -66,6 +66,9 @@ class Inspector {
     ///          including all uniform storage buffers.
     uint32_t GetStorageSize(const std::string& entry_point);
 
+    /// Gathers the bindings of every resource type in a single walk of the entry point's
+    /// transitively referenced globals, and caches the result so repeated queries for the same
+    /// entry point are cheap.
     /// @param entry_point name of the entry point to get information about.
     /// @returns vector of all of the resource bindings.
     std::vector<ResourceBinding> GetResourceBindings(const std::string& entry_point);
@@ -156,6 +159,7 @@ class Inspector {
     std::unique_ptr<
         std::unordered_map<std::string, utils::UniqueVector<sem::SamplerTexturePair, 4>>>
         sampler_targets_;
+    std::unordered_map<std::string, std::vector<ResourceBinding>> resource_bindings_cache_;
 
     /// @param name name of the entry point to find
     /// @returns a pointer to the entry point if it exists, otherwise returns
@@ -14,6 +14,7 @@
 
 #include "src/tint/reader/wgsl/lexer.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cmath>
 #include <cstring>
@@ -64,6 +65,15 @@ bool read_blankspace(std::string_view str, size_t i, bool* is_blankspace, size_t
     return true;
 }
 
+// Whether the byte is an ASCII XID_Continue character [A-Za-z0-9_]. The lexer bulk-consumes
+// runs of these without UTF-8 decoding, since decoding and the XID_Continue range search
+// dominate identifier lexing; everything else takes the decoding path.
+bool is_ascii_ident_char(char c) {
+    auto b = static_cast<uint8_t>(c);
+    return (b >= 'a' && b <= 'z') || (b >= 'A' && b <= 'Z') || (b >= '0' && b <= '9') ||
+           b == '_';
+}
+
 uint32_t dec_value(char c) {
     if (c >= '0' && c <= '9') {
         return static_cast<uint32_t>(c - '0');
@@ -92,7 +102,9 @@ Lexer::~Lexer() = default;
 
 std::vector<Token> Lexer::Lex() {
     std::vector<Token> tokens;
-    tokens.reserve(kDefaultListSize);
+    // Reserve for the token density of typical WGSL, which is a little under one token per four
+    // characters, so that lexing large programs doesn't repeatedly reallocate and move the list.
+    tokens.reserve(std::max(kDefaultListSize, file_->content.data.size() / 4));
     while (true) {
         tokens.emplace_back(next());
 
@@ -243,6 +255,20 @@ Token Lexer::skip_blankspace_and_comments() {
                 continue;
             }
 
+            // Bulk-skip runs of ASCII space and horizontal tab, by far the most common
+            // blankspace, without per-codepoint decoding.
+            {
+                auto l = line();
+                size_t p = pos();
+                while (p < l.size() && (l[p] == ' ' || l[p] == '\t')) {
+                    p++;
+                }
+                set_pos(p);
+                if (is_eol()) {
+                    continue;
+                }
+            }
+
             bool is_blankspace;
             size_t blankspace_size;
             if (!read_blankspace(line(), pos(), &is_blankspace, &blankspace_size)) {
@@ -904,7 +930,14 @@ Token Lexer::try_ident() {
     auto start = pos();
 
     // Must begin with an XID_Source unicode character, or underscore
-    {
+    if (char first = at(pos()); static_cast<uint8_t>(first) < 0x80) {
+        // ASCII fast path: of the ASCII characters only the letters are XID_Start, plus the
+        // explicitly allowed underscore.
+        if (!is_ascii_ident_char(first) || is_digit(first)) {
+            return {};
+        }
+        advance(1);
+    } else {
         auto* utf8 = reinterpret_cast<const uint8_t*>(&at(pos()));
         auto [code_point, n] = text::utf8::Decode(utf8, length() - pos());
         if (n == 0) {
@@ -919,6 +952,21 @@ Token Lexer::try_ident() {
     }
 
     while (!is_eol()) {
+        // Bulk-consume the run of ASCII identifier characters. Only a non-ASCII byte needs
+        // decoding and the XID_Continue range search below.
+        {
+            auto l = line();
+            size_t p = pos();
+            while (p < l.size() && is_ascii_ident_char(l[p])) {
+                p++;
+            }
+            set_pos(p);
+            if (is_eol() || static_cast<uint8_t>(l[p]) < 0x80) {
+                // An ASCII byte that isn't an identifier character ends the identifier.
+                break;
+            }
+        }
+
         // Must continue with an XID_Continue unicode character
         auto* utf8 = reinterpret_cast<const uint8_t*>(&at(pos()));
         auto [code_point, n] = text::utf8::Decode(utf8, line().size() - pos());
@@ -2034,7 +2034,7 @@ Maybe<const ast::IfStatement*> ParserImpl::if_statement() {
         return IfInfo{source, condition.value, body.value};
     };
 
-    std::vector<IfInfo> statements;
+    utils::Vector<IfInfo, 4> statements;
 
     // Parse the first if statement.
     auto first_if = parse_if();
@@ -2043,7 +2043,7 @@ Maybe<const ast::IfStatement*> ParserImpl::if_statement() {
     } else if (!first_if.matched) {
         return Failure::kNoMatch;
     }
-    statements.push_back(first_if.value);
+    statements.Push(first_if.value);
 
     // Parse the components of every "else {if}" in the chain.
     const ast::Statement* last_stmt = nullptr;
@@ -2057,7 +2057,7 @@ Maybe<const ast::IfStatement*> ParserImpl::if_statement() {
         if (else_if.errored) {
             return Failure::kErrored;
         } else if (else_if.matched) {
-            statements.push_back(else_if.value);
+            statements.Push(else_if.value);
             continue;
         }
 
@@ -3203,7 +3203,7 @@ Maybe<const ast::Expression*> ParserImpl::core_lhs_expression() {
 // lhs_expression
 //   : ( STAR | AND )* core_lhs_expression postfix_expression?
 Maybe<const ast::Expression*> ParserImpl::lhs_expression() {
-    std::vector<const Token*> prefixes;
+    utils::Vector<const Token*, 4> prefixes;
     while (peek_is(Token::Type::kStar) || peek_is(Token::Type::kAnd) ||
            peek_is(Token::Type::kAndAnd)) {
         auto& t = next();
@@ -3213,14 +3213,14 @@ Maybe<const ast::Expression*> ParserImpl::lhs_expression() {
             split_token(Token::Type::kAnd, Token::Type::kAnd);
         }
 
-        prefixes.push_back(&t);
+        prefixes.Push(&t);
     }
 
     auto core_expr = core_lhs_expression();
     if (core_expr.errored) {
         return Failure::kErrored;
     } else if (!core_expr.matched) {
-        if (prefixes.empty()) {
+        if (prefixes.IsEmpty()) {
             return Failure::kNoMatch;
         }
 
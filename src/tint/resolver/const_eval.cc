@@ -257,6 +257,10 @@ struct Splat : Constant {
     utils::Result<const Constant*> Convert(ProgramBuilder& builder,
                                            const sem::Type* target_ty,
                                            const Source& source) const override {
+        if (target_ty == type) {
+            // If the types are identical, then no conversion is needed.
+            return this;
+        }
         // Convert the single splatted element type.
         // Note: This file is the only place where `sem::Constant`s are created, so this static_cast
         // is safe.
@@ -301,6 +305,10 @@ struct Composite : Constant {
     utils::Result<const Constant*> Convert(ProgramBuilder& builder,
                                            const sem::Type* target_ty,
                                            const Source& source) const override {
+        if (target_ty == type) {
+            // If the types are identical, then no conversion is needed.
+            return this;
+        }
         // Convert each of the composite element types.
         auto* el_ty = sem::Type::ElementOf(target_ty);
         utils::Vector<const sem::Constant*, 4> conv_els;
@@ -878,10 +886,16 @@ utils::Result<const sem::Constant*> ConstEval::Convert(const sem::Type* target_t
     if (value->Type() == target_ty) {
         return value;
     }
+    auto key = std::make_tuple(value, target_ty);
+    if (auto memoized = converted_values_.Get(key)) {
+        return *memoized;
+    }
     auto conv = static_cast<const Constant*>(value)->Convert(builder, target_ty, source);
     if (!conv) {
+        // Don't memoize failures: a diagnostic was raised and resolving aborts.
         return utils::Failure;
     }
+    converted_values_.Add(key, conv.Get());
     return conv.Get();
 }
 
@@ -17,7 +17,9 @@
 
 #include <stddef.h>
 #include <string>
+#include <tuple>
 
+#include "src/tint/utils/hashmap.h"
 #include "src/tint/utils/result.h"
 #include "src/tint/utils/vector.h"
 
@@ -260,6 +262,13 @@ class ConstEval {
     void AddWarning(const std::string& msg, const Source& source) const;
 
     ProgramBuilder& builder;
+
+    /// Memoized results of successful Convert() calls, keyed on the source constant and the
+    /// target type. Constants are immutable so the result only depends on the key, and the
+    /// converted value is shared between all the uses: a large `const` lookup table is
+    /// converted once instead of at every materialization site that references it.
+    utils::Hashmap<std::tuple<const sem::Constant*, const sem::Type*>, const sem::Constant*, 8>
+        converted_values_;
 };
 
 }  // namespace tint::resolver
@@ -29,6 +29,8 @@ class SymbolTable;
 
 namespace tint::sem {
 
+class Manager;
+
 /// Supported memory layouts for calculating sizes
 enum class MemoryLayout { kUniformBuffer, kStorageBuffer };
 
@@ -39,6 +41,16 @@ class Type : public Castable<Type, Node> {
     Type(Type&&);
     ~Type() override;
 
+    /// kInvalidUniqueID is the value of UniqueID() for types that were not constructed through a
+    /// sem::Manager.
+    static constexpr uint32_t kInvalidUniqueID = 0xffffffffu;
+
+    /// @returns the unique identifier of the type, assigned by the owning sem::Manager when the
+    /// type is first constructed. Identifiers are small and densely allocated, so they can be
+    /// used as array indexes. As types are interned by the manager, two types have the same
+    /// identifier if and only if they are the same type.
+    uint32_t UniqueID() const { return unique_id_; }
+
     /// @returns a hash of the type.
     virtual size_t Hash() const = 0;
 
@@ -165,6 +177,11 @@ class Type : public Castable<Type, Node> {
 
   protected:
     Type();
+
+  private:
+    friend class Manager;
+
+    uint32_t unique_id_ = kInvalidUniqueID;
 };
 
 }  // namespace tint::sem
@@ -59,6 +59,20 @@ class Manager final : public utils::UniqueAllocator<Type> {
         return out;
     }
 
+    /// @param args the arguments used to construct the type.
+    /// @return a pointer to an instance of `TYPE` with the provided arguments. If an existing
+    ///         instance of `TYPE` has been constructed, then the same pointer is returned.
+    ///         Newly constructed types are assigned the next Type::UniqueID() identifier.
+    template <typename TYPE = Type, typename... ARGS>
+    TYPE* Get(ARGS&&... args) {
+        size_t count = items.size();
+        TYPE* type = utils::UniqueAllocator<Type>::Get<TYPE>(std::forward<ARGS>(args)...);
+        if (items.size() > count) {
+            type->unique_id_ = static_cast<uint32_t>(count);
+        }
+        return type;
+    }
+
     /// @returns an iterator to the beginning of the types
     Iterator begin() const { return allocator.Objects().begin(); }
     /// @returns an iterator to the end of the types
@@ -62,6 +62,31 @@ TEST_F(TypeManagerTest, GetDifferentTypeReturnsDifferentPtr) {
     EXPECT_TRUE(t2->Is<U32>());
 }
 
+TEST_F(TypeManagerTest, UniqueIDsAreDenselyAllocated) {
+    Manager tm;
+    auto* i32 = tm.Get<I32>();
+    auto* u32 = tm.Get<U32>();
+    EXPECT_EQ(i32->UniqueID(), 0u);
+    EXPECT_EQ(u32->UniqueID(), 1u);
+
+    // Getting an existing type must not assign a new identifier.
+    auto* i32_2 = tm.Get<I32>();
+    EXPECT_EQ(i32_2->UniqueID(), 0u);
+}
+
+TEST_F(TypeManagerTest, WrapContinuesUniqueIDs) {
+    Manager inner;
+    auto* i32 = inner.Get<I32>();
+
+    Manager outer = Manager::Wrap(inner);
+    auto* i32_2 = outer.Get<I32>();
+    EXPECT_EQ(i32_2, i32);
+    EXPECT_EQ(i32_2->UniqueID(), 0u);
+
+    auto* u32 = outer.Get<U32>();
+    EXPECT_EQ(u32->UniqueID(), 1u);
+}
+
 TEST_F(TypeManagerTest, WrapDoesntAffectInner) {
     Manager inner;
     Manager outer = Manager::Wrap(inner);
@@ -16,6 +16,7 @@
 #ifndef SRC_TINT_SOURCE_H_
 #define SRC_TINT_SOURCE_H_
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <string_view>
@@ -73,13 +74,15 @@ class Source {
     };
 
     /// Location holds a 1-based line and column index.
+    /// Line and column are stored as 32-bit values to keep Source small, as a Source is
+    /// embedded in every AST node.
     class Location {
       public:
         /// the 1-based line number. 0 represents no line information.
-        size_t line = 0;
+        uint32_t line = 0;
         /// the 1-based column number in utf8-code units (bytes).
         /// 0 represents no column information.
-        size_t column = 0;
+        uint32_t column = 0;
 
         /// Returns true of `this` location is lexicographically less than `rhs`
         /// @param rhs location to compare against
@@ -120,7 +123,8 @@ class Source {
         /// @param n the number of characters to shift by
         /// @returns a Range with a #begin and #end column shifted by `n`
         inline Range operator+(size_t n) const {
-            return Range{{begin.line, begin.column + n}, {end.line, end.column + n}};
+            return Range{{begin.line, static_cast<uint32_t>(begin.column + n)},
+                         {end.line, static_cast<uint32_t>(end.column + n)}};
         }
 
         /// Returns true of `this` range is not equal to `rhs`
@@ -33,52 +33,45 @@ SymbolTable& SymbolTable::operator=(SymbolTable&&) = default;
 Symbol SymbolTable::Register(const std::string& name) {
     TINT_ASSERT(Symbol, !name.empty());
 
-    auto it = name_to_symbol_.find(name);
-    if (it != name_to_symbol_.end()) {
-        return it->second;
-    }
+    return name_to_symbol_.GetOrCreate(name, [&] { return RegisterInternal(name); });
+}
 
+Symbol SymbolTable::RegisterInternal(const std::string& name) {
 #if TINT_SYMBOL_STORE_DEBUG_NAME
-    Symbol sym(next_symbol_, program_id_, name);
+    Symbol sym(static_cast<uint32_t>(names_.size() + 1), program_id_, name);
 #else
-    Symbol sym(next_symbol_, program_id_);
+    Symbol sym(static_cast<uint32_t>(names_.size() + 1), program_id_);
 #endif
-    ++next_symbol_;
-
-    name_to_symbol_[name] = sym;
-    symbol_to_name_[sym] = name;
-
+    names_.push_back(name);
     return sym;
 }
 
 Symbol SymbolTable::Get(const std::string& name) const {
-    auto it = name_to_symbol_.find(name);
-    return it != name_to_symbol_.end() ? it->second : Symbol();
+    auto* sym = name_to_symbol_.Find(name);
+    return sym ? *sym : Symbol();
 }
 
 std::string SymbolTable::NameFor(const Symbol symbol) const {
     TINT_ASSERT_PROGRAM_IDS_EQUAL(Symbol, program_id_, symbol);
-    auto it = symbol_to_name_.find(symbol);
-    if (it == symbol_to_name_.end()) {
+    auto value = symbol.value();
+    if (value == 0 || value > names_.size()) {
         return symbol.to_str();
     }
-
-    return it->second;
+    return names_[value - 1];
 }
 
 Symbol SymbolTable::New(std::string prefix /* = "" */) {
     if (prefix.empty()) {
         prefix = "tint_symbol";
     }
-    auto it = name_to_symbol_.find(prefix);
-    if (it == name_to_symbol_.end()) {
+    if (!name_to_symbol_.Contains(prefix)) {
         return Register(prefix);
     }
     std::string name;
     size_t i = 1;
     do {
         name = prefix + "_" + std::to_string(i++);
-    } while (name_to_symbol_.count(name));
+    } while (name_to_symbol_.Contains(name));
     return Register(name);
 }
 
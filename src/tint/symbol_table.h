@@ -16,9 +16,10 @@
 #define SRC_TINT_SYMBOL_TABLE_H_
 
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "src/tint/symbol.h"
+#include "src/tint/utils/hashmap.h"
 
 namespace tint {
 
@@ -68,13 +69,14 @@ class SymbolTable {
     /// value
     Symbol New(std::string name = "");
 
-    /// Foreach calls the callback function `F` for each symbol in the table.
+    /// Foreach calls the callback function `F` for each symbol in the table,
+    /// in order of registration.
     /// @param callback must be a function or function-like object with the
     /// signature: `void(Symbol, const std::string&)`
     template <typename F>
     void Foreach(F&& callback) const {
-        for (auto it : symbol_to_name_) {
-            callback(it.first, it.second);
+        for (size_t i = 0; i < names_.size(); i++) {
+            callback(Symbol(static_cast<uint32_t>(i + 1), program_id_), names_[i]);
         }
     }
 
@@ -82,11 +84,14 @@ class SymbolTable {
     tint::ProgramID ProgramID() const { return program_id_; }
 
   private:
-    // The value to be associated to the next registered symbol table entry.
-    uint32_t next_symbol_ = 1;
-
-    std::unordered_map<Symbol, std::string> symbol_to_name_;
-    std::unordered_map<std::string, Symbol> name_to_symbol_;
+    Symbol RegisterInternal(const std::string& name);
+
+    // Names of the registered symbols. As symbol values are densely allocated starting at 1, the
+    // name of a symbol is the entry at index `value() - 1`.
+    std::vector<std::string> names_;
+    // Map of name to symbol. The open-addressing map keeps the hash of each name alongside the
+    // entry, so lookups of colliding names don't re-hash the full string.
+    utils::Hashmap<std::string, Symbol, 8> name_to_symbol_;
     tint::ProgramID program_id_;
 };
 
@@ -47,7 +47,11 @@ bool BindingRemapper::ShouldRun(const Program*, const DataMap& inputs) const {
     return false;
 }
 
-void BindingRemapper::Run(CloneContext& ctx, const DataMap& inputs, DataMap&) const {
+bool BindingRemapper::SupportsFusion() const {
+    return true;
+}
+
+void BindingRemapper::RegisterEdits(CloneContext& ctx, const DataMap& inputs, DataMap&) const {
     auto* remappings = inputs.Get<Remappings>();
     if (!remappings) {
         ctx.dst->Diagnostics().add_error(
@@ -151,8 +155,6 @@ void BindingRemapper::Run(CloneContext& ctx, const DataMap& inputs, DataMap&) co
             }
         }
     }
-
-    ctx.Clone();
 }
 
 }  // namespace tint::transform
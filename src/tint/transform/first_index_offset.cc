@@ -58,7 +58,13 @@ bool FirstIndexOffset::ShouldRun(const Program* program, const DataMap&) const {
     return false;
 }
 
-void FirstIndexOffset::Run(CloneContext& ctx, const DataMap& inputs, DataMap& outputs) const {
+bool FirstIndexOffset::SupportsFusion() const {
+    return true;
+}
+
+void FirstIndexOffset::RegisterEdits(CloneContext& ctx,
+                                     const DataMap& inputs,
+                                     DataMap& outputs) const {
     // Get the uniform buffer binding point
     uint32_t ub_binding = binding_;
     uint32_t ub_group = group_;
@@ -150,8 +156,6 @@ void FirstIndexOffset::Run(CloneContext& ctx, const DataMap& inputs, DataMap& ou
         });
     }
 
-    ctx.Clone();
-
     outputs.Add<Data>(has_vertex_or_instance_index);
 }
 
@@ -108,14 +108,18 @@ class FirstIndexOffset final : public Castable<FirstIndexOffset, Transform> {
     /// @returns true if this transform should be run for the given program
     bool ShouldRun(const Program* program, const DataMap& data = {}) const override;
 
+    /// @returns true. The transform only registers clone edits, so a Manager may fuse it with
+    /// adjacent fusable transforms.
+    bool SupportsFusion() const override;
+
   protected:
-    /// Runs the transform using the CloneContext built for transforming a
-    /// program. Run() is responsible for calling Clone() on the CloneContext.
+    /// Registers the uniform buffer and the builtin-offsetting expression replacements on
+    /// `ctx` without calling Clone().
     /// @param ctx the CloneContext primed with the input program and
     /// ProgramBuilder
     /// @param inputs optional extra transform-specific input data
     /// @param outputs optional extra transform-specific output data
-    void Run(CloneContext& ctx, const DataMap& inputs, DataMap& outputs) const override;
+    void RegisterEdits(CloneContext& ctx, const DataMap& inputs, DataMap& outputs) const override;
 
   private:
     uint32_t binding_ = 0;
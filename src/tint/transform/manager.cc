@@ -32,8 +32,26 @@ Manager::Manager() = default;
 Manager::~Manager() = default;
 
 Output Manager::Run(const Program* program, const DataMap& data) const {
-    const Program* in = program;
+    Output out;
+    if (RunTransforms(program, data, out) == program) {
+        // No transform was run. The caller keeps ownership of the input program, so the output
+        // needs its own copy.
+        out.program = program->Clone();
+    }
+    return out;
+}
+
+Output Manager::Run(Program&& program, const DataMap& data) const {
+    Output out;
+    if (RunTransforms(&program, data, out) == &program) {
+        // No transform was run. The input program is owned, so it can be moved into the output
+        // instead of being cloned.
+        out.program = std::move(program);
+    }
+    return out;
+}
 
+const Program* Manager::RunTransforms(const Program* in, const DataMap& data, Output& out) const {
 #if TINT_PRINT_PROGRAM_FOR_EACH_TRANSFORM
     auto print_program = [&](const char* msg, const Transform* transform) {
         auto wgsl = Program::printer(in);
@@ -46,8 +64,38 @@ Output Manager::Run(const Program* program, const DataMap& data) const {
     };
 #endif
 
-    Output out;
-    for (const auto& transform : transforms_) {
+    for (size_t i = 0; i < transforms_.size();) {
+        // Gather the run of consecutive transforms that support fusion and want to run, so
+        // that they all share a single clone of the program.
+        size_t fused_end = i;
+        while (fused_end < transforms_.size() && transforms_[fused_end]->SupportsFusion() &&
+               transforms_[fused_end]->ShouldRun(in, data)) {
+            fused_end++;
+        }
+
+        if (fused_end - i > 1) {
+            TINT_IF_PRINT_PROGRAM(print_program("Input to fused", transforms_[i].get()));
+
+            ProgramBuilder builder;
+            CloneContext ctx(&builder, in);
+            for (size_t j = i; j < fused_end; j++) {
+                transforms_[j]->RegisterEdits(ctx, data, out.data);
+            }
+            ctx.Clone();
+            out.program = Program(std::move(builder));
+            in = &out.program;
+            if (!in->IsValid()) {
+                TINT_IF_PRINT_PROGRAM(print_program("Invalid output of fused",
+                                                    transforms_[fused_end - 1].get()));
+                return in;
+            }
+            i = fused_end;
+            continue;
+        }
+
+        const auto& transform = transforms_[i];
+        i++;
+
         if (!transform->ShouldRun(in, data)) {
             TINT_IF_PRINT_PROGRAM(std::cout << "Skipping " << transform->TypeInfo().name
                                             << std::endl);
@@ -61,19 +109,17 @@ Output Manager::Run(const Program* program, const DataMap& data) const {
         in = &out.program;
         if (!in->IsValid()) {
             TINT_IF_PRINT_PROGRAM(print_program("Invalid output of", transform.get()));
-            return out;
-        }
-
-        if (transform == transforms_.back()) {
-            TINT_IF_PRINT_PROGRAM(print_program("Output of", transform.get()));
+            return in;
         }
     }
 
-    if (program == in) {
-        out.program = program->Clone();
-    }
+    TINT_IF_PRINT_PROGRAM({
+        if (!transforms_.empty()) {
+            print_program("Output of", transforms_.back().get());
+        }
+    });
 
-    return out;
+    return in;
 }
 
 }  // namespace tint::transform
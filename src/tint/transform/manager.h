@@ -53,7 +53,20 @@ class Manager final : public Castable<Manager, Transform> {
     /// @returns the transformed program and diagnostics
     Output Run(const Program* program, const DataMap& data = {}) const override;
 
+    /// Runs the transforms on `program`, consuming it and returning the transformation result.
+    /// Unlike the overload taking a pointer, if none of the transforms need to run then `program`
+    /// is moved into the result instead of being cloned.
+    /// @param program the source program to transform
+    /// @param data optional extra transform-specific input data
+    /// @returns the transformed program and diagnostics
+    Output Run(Program&& program, const DataMap& data = {}) const;
+
   private:
+    /// Runs the transforms on `in`, writing the output of the last transform that ran to `out`.
+    /// @returns a pointer to the program produced by the last transform that ran, or `in` if no
+    /// transform was run. In the latter case `out.program` is left default-constructed.
+    const Program* RunTransforms(const Program* in, const DataMap& data, Output& out) const;
+
     std::vector<std::unique_ptr<Transform>> transforms_;
 };
 
@@ -97,6 +97,13 @@ struct Robustness::State {
             size.expr = b.Call("arrayLength", b.AddressOf(arr));
         }
 
+        // If the size is statically known and the index is provably in bounds, then there's
+        // nothing to clamp, and the expression can be cloned unchanged. This must be decided
+        // before anything is cloned into the output program.
+        if (!size.expr && IndexProvablyInBounds(expr->index, size.u32)) {
+            return nullptr;
+        }
+
         // Calculate the maximum possible index value (size-1u)
         // Size must be positive (non-zero), so we can safely subtract 1 here
         // without underflow.
@@ -194,6 +201,43 @@ struct Robustness::State {
         return b.IndexAccessor(src, obj, idx.expr);
     }
 
+    /// Performs a simple static range analysis of the index expression of an accessor on an
+    /// object with a statically-known element count.
+    /// @param idx the index expression, in the source program
+    /// @param size the element count of the indexed object
+    /// @returns true if `idx` is provably in the range [0, size)
+    bool IndexProvablyInBounds(const ast::Expression* idx, uint32_t size) {
+        auto& sem = ctx.src->Sem();
+        if (auto* constant = sem.Get(idx)->ConstantValue()) {
+            auto val = std::get<AInt>(constant->Value());
+            if (constant->Type()->Is<sem::I32>()) {
+                auto i = static_cast<int32_t>(val);
+                return i >= 0 && static_cast<uint32_t>(i) < size;
+            }
+            if (constant->Type()->Is<sem::U32>()) {
+                return static_cast<uint32_t>(val) < size;
+            }
+            return false;
+        }
+        if (auto* binary = idx->As<ast::BinaryExpression>()) {
+            auto* rhs_constant = sem.Get(binary->rhs)->ConstantValue();
+            if (!rhs_constant) {
+                return false;
+            }
+            auto rhs = static_cast<int64_t>(std::get<AInt>(rhs_constant->Value()));
+            if (binary->IsModulo()) {
+                // `x % C` with unsigned operands and 0 < C <= size is always in [0, C).
+                auto* ty = sem.Get(idx)->Type()->UnwrapRef();
+                return ty->Is<sem::U32>() && rhs > 0 && static_cast<uint64_t>(rhs) <= size;
+            }
+            if (binary->IsAnd()) {
+                // `x & C` with C in [0, size) is always in [0, C], as C's sign bit is clear.
+                return rhs >= 0 && static_cast<uint64_t>(rhs) < size;
+            }
+        }
+        return false;
+    }
+
     /// @param type builtin type
     /// @returns true if the given builtin is a texture function that requires
     /// argument clamping,
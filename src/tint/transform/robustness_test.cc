@@ -21,7 +21,7 @@ namespace {
 
 using RobustnessTest = TransformTest;
 
-TEST_F(RobustnessTest, Array_Let_Idx_Clamp) {
+TEST_F(RobustnessTest, Array_Let_Idx_InBounds) {
     auto* src = R"(
 var<private> a : array<f32, 3>;
 
@@ -38,7 +38,7 @@ var<private> a : array<f32, 3>;
 const c : u32 = 1u;
 
 fn f() {
-  let b : f32 = a[1u];
+  let b : f32 = a[c];
 }
 )";
 
@@ -47,7 +47,7 @@ fn f() {
     EXPECT_EQ(expect, str(got));
 }
 
-TEST_F(RobustnessTest, Array_Const_Idx_Clamp) {
+TEST_F(RobustnessTest, Array_Const_Idx_InBounds) {
     auto* src = R"(
 var<private> a : array<f32, 3>;
 
@@ -64,7 +64,7 @@ var<private> a : array<f32, 3>;
 const c : u32 = 1u;
 
 fn f() {
-  let b : f32 = a[1u];
+  let b : f32 = a[c];
 }
 )";
 
@@ -73,7 +73,7 @@ fn f() {
     EXPECT_EQ(expect, str(got));
 }
 
-TEST_F(RobustnessTest, Array_Let_Idx_Clamp_OutOfOrder) {
+TEST_F(RobustnessTest, Array_Let_Idx_InBounds_OutOfOrder) {
     auto* src = R"(
 fn f() {
   let b : f32 = a[c];
@@ -86,7 +86,7 @@ var<private> a : array<f32, 3>;
 
     auto* expect = R"(
 fn f() {
-  let b : f32 = a[1u];
+  let b : f32 = a[c];
 }
 
 const c : u32 = 1u;
@@ -99,7 +99,7 @@ var<private> a : array<f32, 3>;
     EXPECT_EQ(expect, str(got));
 }
 
-TEST_F(RobustnessTest, Array_Const_Idx_Clamp_OutOfOrder) {
+TEST_F(RobustnessTest, Array_Const_Idx_InBounds_OutOfOrder) {
     auto* src = R"(
 fn f() {
   let b : f32 = a[c];
@@ -112,7 +112,7 @@ var<private> a : array<f32, 3>;
 
     auto* expect = R"(
 fn f() {
-  let b : f32 = a[1u];
+  let b : f32 = a[c];
 }
 
 const c : u32 = 1u;
@@ -281,6 +281,110 @@ var<private> a : array<f32, 3>;
     EXPECT_EQ(expect, str(got));
 }
 
+TEST_F(RobustnessTest, Array_Idx_ModuloSize) {
+    auto* src = R"(
+var<private> a : array<f32, 3>;
+
+var<private> i : u32;
+
+fn f() {
+  var b : f32 = a[i % 3u];
+}
+)";
+
+    auto* expect = R"(
+var<private> a : array<f32, 3>;
+
+var<private> i : u32;
+
+fn f() {
+  var b : f32 = a[(i % 3u)];
+}
+)";
+
+    auto got = Run<Robustness>(src);
+
+    EXPECT_EQ(expect, str(got));
+}
+
+TEST_F(RobustnessTest, Array_Idx_ModuloTooLarge) {
+    auto* src = R"(
+var<private> a : array<f32, 3>;
+
+var<private> i : u32;
+
+fn f() {
+  var b : f32 = a[i % 4u];
+}
+)";
+
+    auto* expect = R"(
+var<private> a : array<f32, 3>;
+
+var<private> i : u32;
+
+fn f() {
+  var b : f32 = a[min((i % 4u), 2u)];
+}
+)";
+
+    auto got = Run<Robustness>(src);
+
+    EXPECT_EQ(expect, str(got));
+}
+
+TEST_F(RobustnessTest, Array_Idx_MaskedConstant) {
+    auto* src = R"(
+var<private> a : array<f32, 3>;
+
+var<private> i : i32;
+
+fn f() {
+  var b : f32 = a[i & 1];
+}
+)";
+
+    auto* expect = R"(
+var<private> a : array<f32, 3>;
+
+var<private> i : i32;
+
+fn f() {
+  var b : f32 = a[(i & 1)];
+}
+)";
+
+    auto got = Run<Robustness>(src);
+
+    EXPECT_EQ(expect, str(got));
+}
+
+TEST_F(RobustnessTest, Array_Idx_MaskTooLarge) {
+    auto* src = R"(
+var<private> a : array<f32, 3>;
+
+var<private> i : i32;
+
+fn f() {
+  var b : f32 = a[i & 4];
+}
+)";
+
+    auto* expect = R"(
+var<private> a : array<f32, 3>;
+
+var<private> i : i32;
+
+fn f() {
+  var b : f32 = a[min(u32((i & 4)), 2u)];
+}
+)";
+
+    auto got = Run<Robustness>(src);
+
+    EXPECT_EQ(expect, str(got));
+}
+
 TEST_F(RobustnessTest, Array_Idx_Negative) {
     auto* src = R"(
 var<private> a : array<f32, 3>;
@@ -842,7 +946,7 @@ var<private> a : mat3x2<f32>;
 var<private> c : i32;
 
 fn f() {
-  var b : f32 = a[min(u32(((c + 2) - 3)), 2u)][1i];
+  var b : f32 = a[min(u32(((c + 2) - 3)), 2u)][1];
 }
 )";
 
@@ -864,7 +968,7 @@ var<private> a : mat3x2<f32>;
 
     auto* expect = R"(
 fn f() {
-  var b : f32 = a[min(u32(((c + 2) - 3)), 2u)][1i];
+  var b : f32 = a[min(u32(((c + 2) - 3)), 2u)][1];
 }
 
 var<private> c : i32;
@@ -894,7 +998,7 @@ var<private> a : mat3x2<f32>;
 var<private> c : i32;
 
 fn f() {
-  var b : f32 = a[1i][min(u32(((c + 2) - 3)), 1u)];
+  var b : f32 = a[1][min(u32(((c + 2) - 3)), 1u)];
 }
 )";
 
@@ -916,7 +1020,7 @@ var<private> a : mat3x2<f32>;
 
     auto* expect = R"(
 fn f() {
-  var b : f32 = a[1i][min(u32(((c + 2) - 3)), 1u)];
+  var b : f32 = a[1][min(u32(((c + 2) - 3)), 1u)];
 }
 
 var<private> c : i32;
@@ -942,7 +1046,7 @@ fn f() {
 var<private> a : mat3x2<f32>;
 
 fn f() {
-  var b : f32 = a[0i][1i];
+  var b : f32 = a[0i][1];
 }
 )";
 
@@ -962,7 +1066,7 @@ var<private> a : mat3x2<f32>;
 
     auto* expect = R"(
 fn f() {
-  var b : f32 = a[0i][1i];
+  var b : f32 = a[0i][1];
 }
 
 var<private> a : mat3x2<f32>;
@@ -986,7 +1090,7 @@ fn f() {
 var<private> a : mat3x2<f32>;
 
 fn f() {
-  var b : f32 = a[2i][0i];
+  var b : f32 = a[2][0i];
 }
 )";
 
@@ -1006,7 +1110,7 @@ var<private> a : mat3x2<f32>;
 
     auto* expect = R"(
 fn f() {
-  var b : f32 = a[2i][0i];
+  var b : f32 = a[2][0i];
 }
 
 var<private> a : mat3x2<f32>;
@@ -1030,7 +1134,7 @@ fn f() {
 var<private> a : mat3x2<f32>;
 
 fn f() {
-  var b : f32 = a[2i][1i];
+  var b : f32 = a[2i][1];
 }
 )";
 
@@ -1050,7 +1154,7 @@ var<private> a : mat3x2<f32>;
 
     auto* expect = R"(
 fn f() {
-  var b : f32 = a[2i][1i];
+  var b : f32 = a[2i][1];
 }
 
 var<private> a : mat3x2<f32>;
@@ -1074,7 +1178,7 @@ fn f() {
 var<private> a : mat3x2<f32>;
 
 fn f() {
-  var b : f32 = a[2i][1i];
+  var b : f32 = a[2][1i];
 }
 )";
 
@@ -1094,7 +1198,7 @@ var<private> a : mat3x2<f32>;
 
     auto* expect = R"(
 fn f() {
-  var b : f32 = a[2i][1i];
+  var b : f32 = a[2][1i];
 }
 
 var<private> a : mat3x2<f32>;
@@ -1551,8 +1655,8 @@ struct U {
 
 fn f() {
   var i32_sa1 : f32 = s.a[3i];
-  var i32_sa2 : f32 = s.a[1i];
-  var i32_sa3 : f32 = s.a[0i];
+  var i32_sa2 : f32 = s.a[1];
+  var i32_sa3 : f32 = s.a[0];
   var i32_sa4 : f32 = s.a[0i];
   var i32_sa5 : f32 = s.a[0i];
   var i32_sb1 : f32 = s.b[min(4u, (arrayLength(&(s.b)) - 1u))];
@@ -1561,8 +1665,8 @@ fn f() {
   var i32_sb4 : f32 = s.b[min(0u, (arrayLength(&(s.b)) - 1u))];
   var i32_sb5 : f32 = s.b[min(0u, (arrayLength(&(s.b)) - 1u))];
   var i32_ua1 : f32 = u.a[3i].x;
-  var i32_ua2 : f32 = u.a[1i].x;
-  var i32_ua3 : f32 = u.a[0i].x;
+  var i32_ua2 : f32 = u.a[1].x;
+  var i32_ua3 : f32 = u.a[0].x;
   var i32_ua4 : f32 = u.a[0i].x;
   var i32_ua5 : f32 = u.a[0i].x;
   var u32_sa1 : f32 = s.a[0u];
@@ -1624,8 +1728,8 @@ fn f() {
   var i32_sb4 : f32 = s.b[-1];
   var i32_sb5 : f32 = s.b[-4];
   var i32_ua1 : f32 = u.a[3i].x;
-  var i32_ua2 : f32 = u.a[1i].x;
-  var i32_ua3 : f32 = u.a[0i].x;
+  var i32_ua2 : f32 = u.a[1].x;
+  var i32_ua3 : f32 = u.a[0].x;
   var i32_ua4 : f32 = u.a[0i].x;
   var i32_ua5 : f32 = u.a[0i].x;
   var u32_sa1 : f32 = s.a[0u];
@@ -1679,8 +1783,8 @@ struct U {
 
 fn f() {
   var i32_sa1 : f32 = s.a[3i];
-  var i32_sa2 : f32 = s.a[1i];
-  var i32_sa3 : f32 = s.a[0i];
+  var i32_sa2 : f32 = s.a[1];
+  var i32_sa3 : f32 = s.a[0];
   var i32_sa4 : f32 = s.a[0i];
   var i32_sa5 : f32 = s.a[0i];
   var i32_sb1 : f32 = s.b[min(4u, (arrayLength(&(s.b)) - 1u))];
@@ -15,9 +15,11 @@
 #include "src/tint/transform/substitute_override.h"
 
 #include <functional>
+#include <utility>
 
 #include "src/tint/program_builder.h"
 #include "src/tint/sem/variable.h"
+#include "src/tint/transform/manager.h"
 
 TINT_INSTANTIATE_TYPEINFO(tint::transform::SubstituteOverride);
 TINT_INSTANTIATE_TYPEINFO(tint::transform::SubstituteOverride::Config);
@@ -93,4 +95,17 @@ SubstituteOverride::Config::~Config() = default;
 
 SubstituteOverride::Config& SubstituteOverride::Config::operator=(const Config&) = default;
 
+Program SpecializeOverrides(const Program* program,
+                            const std::unordered_map<OverrideId, double>& values) {
+    SubstituteOverride::Config cfg;
+    cfg.map = values;
+
+    DataMap data;
+    data.Add<SubstituteOverride::Config>(std::move(cfg));
+
+    Manager manager;
+    manager.Add<SubstituteOverride>();
+    return std::move(manager.Run(program, data).program);
+}
+
 }  // namespace tint::transform
@@ -86,6 +86,20 @@ class SubstituteOverride final : public Castable<SubstituteOverride, Transform>
     void Run(CloneContext& ctx, const DataMap& inputs, DataMap& outputs) const override;
 };
 
+/// Specializes the override constants of `program` with the values of `values`, returning the
+/// specialized program.
+///
+/// This is intended as a cheap final pass for embedders that compile a module once and stamp out
+/// many override permutations of it: only the override substitution runs (with constant folding
+/// happening as the result is re-resolved), the rest of the module is reused through a single
+/// clone.
+///
+/// @param program the program to specialize
+/// @param values the map of override identifier to the override value
+/// @returns the specialized program
+Program SpecializeOverrides(const Program* program,
+                            const std::unordered_map<OverrideId, double>& values);
+
 }  // namespace tint::transform
 
 #endif  // SRC_TINT_TRANSFORM_SUBSTITUTE_OVERRIDE_H_
@@ -238,5 +238,38 @@ fn main() -> @builtin(position) vec4<f32> {
     EXPECT_EQ(expect, str(got));
 }
 
+TEST_F(SubstituteOverrideTest, SpecializeOverrides) {
+    auto* src = R"(
+@id(0) override width: i32;
+@id(1) override height = 1i;
+
+@vertex
+fn main() -> @builtin(position) vec4<f32> {
+  return vec4<f32>();
+}
+)";
+
+    auto* expect = R"(
+const width : i32 = 42i;
+
+const height = 11i;
+
+@vertex
+fn main() -> @builtin(position) vec4<f32> {
+  return vec4<f32>();
+}
+)";
+
+    Source::File file("test", src);
+    auto program = reader::wgsl::Parse(&file);
+    ASSERT_TRUE(program.IsValid()) << program.Diagnostics().str();
+
+    // The same program can be specialized any number of times.
+    auto specialized =
+        SpecializeOverrides(&program, {{OverrideId{0}, 42.0}, {OverrideId{1}, 11.0}});
+
+    EXPECT_EQ(expect, str(specialized));
+}
+
 }  // namespace
 }  // namespace tint::transform
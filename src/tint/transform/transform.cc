@@ -54,15 +54,29 @@ Output Transform::Run(const Program* program, const DataMap& data /* = {} */) co
     return output;
 }
 
-void Transform::Run(CloneContext& ctx, const DataMap&, DataMap&) const {
+void Transform::Run(CloneContext& ctx, const DataMap& inputs, DataMap& outputs) const {
+    if (SupportsFusion()) {
+        RegisterEdits(ctx, inputs, outputs);
+        ctx.Clone();
+        return;
+    }
     TINT_UNIMPLEMENTED(Transform, ctx.dst->Diagnostics())
         << "Transform::Run() unimplemented for " << TypeInfo().name;
 }
 
+void Transform::RegisterEdits(CloneContext& ctx, const DataMap&, DataMap&) const {
+    TINT_UNIMPLEMENTED(Transform, ctx.dst->Diagnostics())
+        << "Transform::RegisterEdits() unimplemented for " << TypeInfo().name;
+}
+
 bool Transform::ShouldRun(const Program*, const DataMap&) const {
     return true;
 }
 
+bool Transform::SupportsFusion() const {
+    return false;
+}
+
 void Transform::RemoveStatement(CloneContext& ctx, const ast::Statement* stmt) {
     auto* sem = ctx.src->Sem().Get(stmt);
     if (auto* block = tint::As<sem::BlockStatement>(sem->Parent())) {
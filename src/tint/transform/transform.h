@@ -150,6 +150,8 @@ class Output {
     DataMap data;
 };
 
+class Manager;
+
 /// Interface for Program transforms
 class Transform : public Castable<Transform> {
   public:
@@ -169,6 +171,11 @@ class Transform : public Castable<Transform> {
     /// @returns true if this transform should be run for the given program
     virtual bool ShouldRun(const Program* program, const DataMap& data = {}) const;
 
+    /// @returns true if this transform only registers clone edits against the source program,
+    /// implementing RegisterEdits() instead of Run(). A Manager fuses consecutive transforms
+    /// that support fusion into a single clone of the AST.
+    virtual bool SupportsFusion() const;
+
   protected:
     /// Runs the transform using the CloneContext built for transforming a
     /// program. Run() is responsible for calling Clone() on the CloneContext.
@@ -178,6 +185,17 @@ class Transform : public Castable<Transform> {
     /// @param outputs optional extra transform-specific output data
     virtual void Run(CloneContext& ctx, const DataMap& inputs, DataMap& outputs) const;
 
+    /// Registers this transform's clone edits on `ctx` without calling Clone(). Only called
+    /// for transforms whose SupportsFusion() returns true. Implementations must only inspect
+    /// the source program and its semantic information; edits registered by transforms fused
+    /// into the same clone must be disjoint (CloneContext errors on conflicting ReplaceAll
+    /// handlers).
+    /// @param ctx the CloneContext primed with the input program and
+    /// ProgramBuilder
+    /// @param inputs optional extra transform-specific input data
+    /// @param outputs optional extra transform-specific output data
+    virtual void RegisterEdits(CloneContext& ctx, const DataMap& inputs, DataMap& outputs) const;
+
     /// Removes the statement `stmt` from the transformed program.
     /// RemoveStatement handles edge cases, like statements in the initializer and
     /// continuing of for-loops.
@@ -192,6 +210,10 @@ class Transform : public Castable<Transform> {
     /// @returns a ast::Type that when resolved, will produce the semantic type
     /// `ty`.
     static const ast::Type* CreateASTTypeFor(CloneContext& ctx, const sem::Type* ty);
+
+  private:
+    // The Manager calls RegisterEdits() directly when fusing transforms.
+    friend class Manager;
 };
 
 }  // namespace tint::transform
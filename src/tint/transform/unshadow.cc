@@ -107,6 +107,24 @@ Unshadow::Unshadow() = default;
 
 Unshadow::~Unshadow() = default;
 
+bool Unshadow::ShouldRun(const Program* program, const DataMap&) const {
+    for (auto* node : program->ASTNodes().Objects()) {
+        if (auto* var = node->As<ast::Variable>()) {
+            if (auto* local = program->Sem().Get<sem::LocalVariable>(var)) {
+                if (local->Shadows()) {
+                    return true;
+                }
+            }
+            if (auto* param = program->Sem().Get<sem::Parameter>(var)) {
+                if (param->Shadows()) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
 void Unshadow::Run(CloneContext& ctx, const DataMap&, DataMap&) const {
     State(ctx).Run();
 }
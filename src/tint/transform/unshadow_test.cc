@@ -21,6 +21,47 @@ namespace {
 
 using UnshadowTest = TransformTest;
 
+TEST_F(UnshadowTest, ShouldRunEmptyModule) {
+    auto* src = R"()";
+
+    EXPECT_FALSE(ShouldRun<Unshadow>(src));
+}
+
+TEST_F(UnshadowTest, ShouldRunNoShadows) {
+    auto* src = R"(
+var<private> a : i32;
+
+fn F(b : i32) {
+  var c : i32;
+}
+)";
+
+    EXPECT_FALSE(ShouldRun<Unshadow>(src));
+}
+
+TEST_F(UnshadowTest, ShouldRunLocalShadowsGlobal) {
+    auto* src = R"(
+var<private> a : i32;
+
+fn F() {
+  var a : i32;
+}
+)";
+
+    EXPECT_TRUE(ShouldRun<Unshadow>(src));
+}
+
+TEST_F(UnshadowTest, ShouldRunParamShadowsGlobal) {
+    auto* src = R"(
+var<private> a : i32;
+
+fn F(a : i32) {
+}
+)";
+
+    EXPECT_TRUE(ShouldRun<Unshadow>(src));
+}
+
 TEST_F(UnshadowTest, EmptyModule) {
     auto* src = "";
     auto* expect = "";
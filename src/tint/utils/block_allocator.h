@@ -17,12 +17,87 @@
 
 #include <array>
 #include <cstring>
+#include <type_traits>
 #include <utility>
 
 #include "src/tint/utils/bitcast.h"
 #include "src/tint/utils/math.h"
 
 namespace tint::utils {
+namespace detail {
+
+/// Block is a chunk of memory used by a BlockAllocator to hold object allocations.
+/// Blocks form a linked list, and are allocated out of heap memory.
+///
+/// Note: We're not using std::aligned_storage here as this warns / errors on MSVC.
+template <size_t SIZE, size_t ALIGNMENT>
+struct alignas(ALIGNMENT) Block {
+    /// The memory that object allocations are made from
+    uint8_t data[SIZE];
+    /// The next block in the linked list, or nullptr
+    Block<SIZE, ALIGNMENT>* next;
+};
+
+/// BlockPool is a thread-local free-list of Blocks, shared by all BlockAllocators with the same
+/// block size and alignment. Recycling blocks across allocator instances avoids repeated trips to
+/// the heap allocator when programs are built and destructed in quick succession.
+template <size_t SIZE, size_t ALIGNMENT>
+class BlockPool {
+    using Block = detail::Block<SIZE, ALIGNMENT>;
+
+  public:
+    /// @returns a block taken from the pool, or newly allocated from the heap if the pool is
+    /// empty. The block's contents and `next` pointer are uninitialized.
+    static Block* Acquire() {
+        auto& free_list = FreeList();
+        if (free_list.root != nullptr) {
+            auto* block = free_list.root;
+            free_list.root = block->next;
+            free_list.count--;
+            return block;
+        }
+        return new Block;
+    }
+
+    /// Returns @p block to the pool, or frees it if the pool is already holding kMaxBlocks.
+    /// @param block the block to recycle
+    static void Release(Block* block) {
+        auto& free_list = FreeList();
+        if (free_list.count >= kMaxBlocks) {
+            delete block;
+            return;
+        }
+        block->next = free_list.root;
+        free_list.root = block;
+        free_list.count++;
+    }
+
+  private:
+    /// Maximum number of blocks kept for reuse, so that a one-off large program doesn't pin its
+    /// entire footprint for the lifetime of the thread.
+    static constexpr size_t kMaxBlocks = 16;
+
+    struct List {
+        Block* root = nullptr;
+        size_t count = 0;
+
+        ~List() {
+            for (auto* block = root; block != nullptr;) {
+                auto* next = block->next;
+                delete block;
+                block = next;
+            }
+        }
+    };
+
+    /// @returns the free-list for the calling thread
+    static List& FreeList() {
+        static thread_local List list;
+        return list;
+    }
+};
+
+}  // namespace detail
 
 /// A container and allocator of objects of (or deriving from) the template type `T`.
 /// Objects are allocated by calling Create(), and are owned by the BlockAllocator.
@@ -41,14 +116,11 @@ class BlockAllocator {
         Pointers* next;
     };
 
-    /// Block is linked list of memory blocks.
-    /// Blocks are allocated out of heap memory.
-    ///
-    /// Note: We're not using std::aligned_storage here as this warns / errors on MSVC.
-    struct alignas(BLOCK_ALIGNMENT) Block {
-        uint8_t data[BLOCK_SIZE];
-        Block* next;
-    };
+    /// The memory blocks that allocations are made from, recycled through a thread-local pool.
+    using Block = detail::Block<BLOCK_SIZE, BLOCK_ALIGNMENT>;
+
+    /// The thread-local pool that blocks are acquired from and released to.
+    using Pool = detail::BlockPool<BLOCK_SIZE, BLOCK_ALIGNMENT>;
 
     // Forward declaration
     template <bool IS_CONST>
@@ -184,13 +256,19 @@ class BlockAllocator {
 
     /// Frees all allocations from the allocator.
     void Reset() {
-        for (auto ptr : Objects()) {
-            ptr->~T();
+        // When T is trivially destructible there are no destructors to run, and blocks can be
+        // recycled wholesale without walking the object list. Create() statically asserts that
+        // types deriving from T have a virtual (and so non-trivial) destructor, so in this case
+        // every object is exactly a T.
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (auto ptr : Objects()) {
+                ptr->~T();
+            }
         }
         auto* block = data.block.root;
         while (block != nullptr) {
             auto* next = block->next;
-            delete block;
+            Pool::Release(block);
             block = next;
         }
         data = {};
@@ -215,9 +293,9 @@ class BlockAllocator {
 
         block.current_offset = utils::RoundUp(alignof(TYPE), block.current_offset);
         if (block.current_offset + sizeof(TYPE) > BLOCK_SIZE) {
-            // Allocate a new block from the heap
+            // Acquire a new block from the pool or the heap
             auto* prev_block = block.current;
-            block.current = new Block;
+            block.current = Pool::Acquire();
             if (!block.current) {
                 return nullptr;  // out of memory
             }
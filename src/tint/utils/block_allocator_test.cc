@@ -133,6 +133,19 @@ TEST_F(BlockAllocatorTest, MoveAssign) {
     }
 }
 
+TEST_F(BlockAllocatorTest, ReusesBlocksAfterReset) {
+    using Allocator = BlockAllocator<int>;
+
+    Allocator allocator;
+    int* first = allocator.Create(42);
+    allocator.Reset();
+
+    // The released block is recycled through the thread-local pool, so the next allocation on
+    // this thread reuses the same memory.
+    int* second = allocator.Create(24);
+    EXPECT_EQ(first, second);
+}
+
 TEST_F(BlockAllocatorTest, ObjectOrder) {
     using Allocator = BlockAllocator<int>;
 
@@ -270,6 +270,10 @@ GeneratorImpl::GeneratorImpl(const Program* program) : TextGenerator(program) {}
 GeneratorImpl::~GeneratorImpl() = default;
 
 bool GeneratorImpl::Generate() {
+    // Roughly one line of HLSL is emitted for every four AST nodes. Reserving up front avoids
+    // repeatedly regrowing the line vector when emitting large modules.
+    current_buffer_->lines.reserve(builder_.ASTNodes().Count() / 4);
+
     const TypeInfo* last_kind = nullptr;
     size_t last_padding_line = 0;
 
@@ -312,10 +316,19 @@ bool GeneratorImpl::Generate() {
                 return true;
             },
             [&](const ast::Function* func) {
-                if (func->IsEntryPoint()) {
-                    return EmitEntryPointFunction(func);
+                // Each function is emitted into its own buffer, which is appended to the module
+                // buffer in declaration order. This keeps one function's output independent of the
+                // buffer state left by another, so function emission can later be farmed out to
+                // separate threads and stitched together deterministically.
+                TextBuffer func_buffer;
+                bool emitted;
+                {
+                    TINT_SCOPED_ASSIGNMENT(current_buffer_, &func_buffer);
+                    emitted = func->IsEntryPoint() ? EmitEntryPointFunction(func)
+                                                   : EmitFunction(func);
                 }
-                return EmitFunction(func);
+                current_buffer_->Append(func_buffer);
+                return emitted;
             },
             [&](Default) {
                 TINT_ICE(Writer, diagnostics_)
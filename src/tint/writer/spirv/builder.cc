@@ -491,7 +491,7 @@ bool Builder::GenerateEntryPoint(const ast::Function* func, uint32_t id) {
 
         operands.push_back(Operand(var_id));
     }
-    push_entry_point(spv::Op::OpEntryPoint, operands);
+    push_entry_point(spv::Op::OpEntryPoint, std::move(operands));
 
     return true;
 }
@@ -548,7 +548,7 @@ bool Builder::GenerateExecutionModes(const ast::Function* func, uint32_t id) {
             }
 
             // Generate the WorkgroupSize builtin.
-            push_type(spv::Op::OpSpecConstantComposite, wgsize_ops);
+            push_type(spv::Op::OpSpecConstantComposite, std::move(wgsize_ops));
             push_annot(spv::Op::OpDecorate, {wgsize_result, U32Operand(SpvDecorationBuiltIn),
                                              U32Operand(SpvBuiltInWorkgroupSize)});
         } else {
@@ -639,7 +639,7 @@ bool Builder::GenerateFunction(const ast::Function* func_ast) {
         RegisterVariable(param, param_id);
     }
 
-    push_function(Function{definition_inst, result_op(), std::move(params)});
+    push_function(Function{std::move(definition_inst), result_op(), std::move(params)});
 
     for (auto* stmt : func_ast->body->statements) {
         if (!GenerateStatement(stmt)) {
@@ -1075,7 +1075,7 @@ bool Builder::GenerateMemberAccessor(const ast::MemberAccessorExpression* expr,
                 ops.push_back(Operand(id));
             }
 
-            if (!push_function_inst(spv::Op::OpAccessChain, ops)) {
+            if (!push_function_inst(spv::Op::OpAccessChain, std::move(ops))) {
                 return false;
             }
 
@@ -1100,7 +1100,7 @@ bool Builder::GenerateMemberAccessor(const ast::MemberAccessorExpression* expr,
             ops.push_back(Operand(idx));
         }
 
-        if (!push_function_inst(spv::Op::OpVectorShuffle, ops)) {
+        if (!push_function_inst(spv::Op::OpVectorShuffle, std::move(ops))) {
             return false;
         }
         info->source_id = result_id;
@@ -1179,7 +1179,7 @@ uint32_t Builder::GenerateAccessorExpression(const ast::Expression* expr) {
             ops.push_back(Operand(id));
         }
 
-        if (!push_function_inst(spv::Op::OpAccessChain, ops)) {
+        if (!push_function_inst(spv::Op::OpAccessChain, std::move(ops))) {
             return false;
         }
         info.source_id = result_id;
@@ -1515,11 +1515,11 @@ uint32_t Builder::GenerateTypeConstructorOrConversion(const sem::Call* call,
         ops[kOpsResultIdx] = result;
 
         if (result_is_spec_composite) {
-            push_type(spv::Op::OpSpecConstantComposite, ops);
+            push_type(spv::Op::OpSpecConstantComposite, std::move(ops));
         } else if (result_is_constant_composite) {
-            push_type(spv::Op::OpConstantComposite, ops);
+            push_type(spv::Op::OpConstantComposite, std::move(ops));
         } else {
-            if (!push_function_inst(spv::Op::OpCompositeConstruct, ops)) {
+            if (!push_function_inst(spv::Op::OpCompositeConstruct, std::move(ops))) {
                 return 0;
             }
         }
@@ -1899,7 +1899,7 @@ uint32_t Builder::GenerateConstantVectorSplatIfNeeded(const sem::Vector* type, u
         for (uint32_t i = 0; i < type->Width(); i++) {
             ops.push_back(Operand(value_id));
         }
-        push_type(spv::Op::OpConstantComposite, ops);
+        push_type(spv::Op::OpConstantComposite, std::move(ops));
 
         const_splat_to_id_[key] = result_id;
         return result_id;
@@ -1994,7 +1994,7 @@ uint32_t Builder::GenerateSplat(uint32_t scalar_id, const sem::Type* vec_type) {
     for (size_t i = 0; i < vec_type->As<sem::Vector>()->Width(); ++i) {
         ops.push_back(Operand(scalar_id));
     }
-    if (!push_function_inst(spv::Op::OpCompositeConstruct, ops)) {
+    if (!push_function_inst(spv::Op::OpCompositeConstruct, std::move(ops))) {
         return 0;
     }
 
@@ -2055,7 +2055,7 @@ uint32_t Builder::GenerateMatrixAddOrSub(uint32_t lhs_id,
     auto result_mat_id = result_op();
     ops.insert(ops.begin(), result_mat_id);
     ops.insert(ops.begin(), Operand(GenerateTypeIfNeeded(type)));
-    if (!push_function_inst(spv::Op::OpCompositeConstruct, ops)) {
+    if (!push_function_inst(spv::Op::OpCompositeConstruct, std::move(ops))) {
         return 0;
     }
 
@@ -2473,7 +2473,7 @@ uint32_t Builder::GenerateBuiltinCall(const sem::Call* call, const sem::Builtin*
             params.push_back(
                 Operand(uint32_t(type->As<sem::Struct>()->Declaration()->members.Length() - 1)));
 
-            if (!push_function_inst(spv::Op::OpArrayLength, params)) {
+            if (!push_function_inst(spv::Op::OpArrayLength, std::move(params))) {
                 return 0;
             }
             return result_id;
@@ -2682,7 +2682,7 @@ uint32_t Builder::GenerateBuiltinCall(const sem::Call* call, const sem::Builtin*
         }
     }
 
-    if (!push_function_inst(op, params)) {
+    if (!push_function_inst(op, std::move(params))) {
         return 0;
     }
 
@@ -3095,7 +3095,7 @@ bool Builder::GenerateTextureBuiltin(const sem::Call* call,
         return false;
     }
 
-    if (!push_function_inst(op, spirv_params)) {
+    if (!push_function_inst(op, std::move(spirv_params))) {
         return false;
     }
 
@@ -3573,7 +3573,7 @@ bool Builder::GenerateSwitchStatement(const ast::SwitchStatement* stmt) {
                             {Operand(merge_block_id), U32Operand(SpvSelectionControlMaskNone)})) {
         return false;
     }
-    if (!push_function_inst(spv::Op::OpSwitch, params)) {
+    if (!push_function_inst(spv::Op::OpSwitch, std::move(params))) {
         return false;
     }
 
@@ -3796,7 +3796,11 @@ uint32_t Builder::GenerateTypeIfNeeded(const sem::Type* type) {
             builder_.create<sem::Pointer>(ref->StoreType(), ref->StorageClass(), ast::kReadWrite);
     }
 
-    return utils::GetOrCreate(type_to_id_, type, [&]() -> uint32_t {
+    if (auto existing_id = LookupTypeId(type)) {
+        return existing_id;
+    }
+
+    auto generate = [&]() -> uint32_t {
         auto result = result_op();
         auto id = std::get<uint32_t>(result);
         bool ok = Switch(
@@ -3851,12 +3855,18 @@ uint32_t Builder::GenerateTypeIfNeeded(const sem::Type* type) {
                 // Register all three access types of StorageTexture names. In
                 // SPIR-V, we must output a single type, while the variable is
                 // annotated with the access type. Doing this ensures we de-dupe.
-                type_to_id_[builder_.create<sem::StorageTexture>(
-                    tex->dim(), tex->texel_format(), ast::Access::kRead, tex->type())] = id;
-                type_to_id_[builder_.create<sem::StorageTexture>(
-                    tex->dim(), tex->texel_format(), ast::Access::kWrite, tex->type())] = id;
-                type_to_id_[builder_.create<sem::StorageTexture>(
-                    tex->dim(), tex->texel_format(), ast::Access::kReadWrite, tex->type())] = id;
+                RegisterTypeId(
+                    builder_.create<sem::StorageTexture>(tex->dim(), tex->texel_format(),
+                                                         ast::Access::kRead, tex->type()),
+                    id);
+                RegisterTypeId(
+                    builder_.create<sem::StorageTexture>(tex->dim(), tex->texel_format(),
+                                                         ast::Access::kWrite, tex->type()),
+                    id);
+                RegisterTypeId(
+                    builder_.create<sem::StorageTexture>(tex->dim(), tex->texel_format(),
+                                                         ast::Access::kReadWrite, tex->type()),
+                    id);
                 return true;
             },
             [&](const sem::Texture* tex) { return GenerateTextureType(tex, result); },
@@ -3866,10 +3876,10 @@ uint32_t Builder::GenerateTypeIfNeeded(const sem::Type* type) {
                 // Register both of the sampler type names. In SPIR-V they're the same
                 // sampler type, so we need to match that when we do the dedup check.
                 if (s->kind() == ast::SamplerKind::kSampler) {
-                    type_to_id_[builder_.create<sem::Sampler>(
-                        ast::SamplerKind::kComparisonSampler)] = id;
+                    RegisterTypeId(
+                        builder_.create<sem::Sampler>(ast::SamplerKind::kComparisonSampler), id);
                 } else {
-                    type_to_id_[builder_.create<sem::Sampler>(ast::SamplerKind::kSampler)] = id;
+                    RegisterTypeId(builder_.create<sem::Sampler>(ast::SamplerKind::kSampler), id);
                 }
                 return true;
             },
@@ -3883,7 +3893,28 @@ uint32_t Builder::GenerateTypeIfNeeded(const sem::Type* type) {
         }
 
         return id;
-    });
+    };
+
+    auto id = generate();
+    if (id != 0) {
+        RegisterTypeId(type, id);
+    }
+    return id;
+}
+
+uint32_t Builder::LookupTypeId(const sem::Type* type) const {
+    const uint32_t unique_id = type->UniqueID();
+    TINT_ASSERT(Writer, unique_id != sem::Type::kInvalidUniqueID);
+    return unique_id < type_to_id_.size() ? type_to_id_[unique_id] : 0u;
+}
+
+void Builder::RegisterTypeId(const sem::Type* type, uint32_t id) {
+    const uint32_t unique_id = type->UniqueID();
+    TINT_ASSERT(Writer, unique_id != sem::Type::kInvalidUniqueID);
+    if (unique_id >= type_to_id_.size()) {
+        type_to_id_.resize(unique_id + 1, 0u);
+    }
+    type_to_id_[unique_id] = id;
 }
 
 bool Builder::GenerateTextureType(const sem::Texture* texture, const Operand& result) {
@@ -4247,7 +4278,7 @@ SpvImageFormat Builder::convert_texel_format_to_spv(const ast::TexelFormat forma
     return SpvImageFormatUnknown;
 }
 
-bool Builder::push_function_inst(spv::Op op, const OperandList& operands) {
+bool Builder::push_function_inst(spv::Op op, OperandList operands) {
     if (functions_.empty()) {
         std::ostringstream ss;
         ss << "Internal error: trying to add SPIR-V instruction " << int(op)
@@ -4255,7 +4286,7 @@ bool Builder::push_function_inst(spv::Op op, const OperandList& operands) {
         error_ = ss.str();
         return false;
     }
-    functions_.back().push_inst(op, operands);
+    functions_.back().push_inst(op, std::move(operands));
     return true;
 }
 
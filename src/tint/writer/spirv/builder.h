@@ -18,6 +18,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "spirv/unified1/spirv.h"
@@ -121,65 +122,65 @@ class Builder {
     /// Adds an instruction to the ext import
     /// @param op the op to set
     /// @param operands the operands for the instruction
-    void push_ext_import(spv::Op op, const OperandList& operands) {
-        ext_imports_.push_back(Instruction{op, operands});
+    void push_ext_import(spv::Op op, OperandList operands) {
+        ext_imports_.push_back(Instruction{op, std::move(operands)});
     }
     /// @returns the ext imports
     const InstructionList& ext_imports() const { return ext_imports_; }
     /// Adds an instruction to the memory model
     /// @param op the op to set
     /// @param operands the operands for the instruction
-    void push_memory_model(spv::Op op, const OperandList& operands) {
-        memory_model_.push_back(Instruction{op, operands});
+    void push_memory_model(spv::Op op, OperandList operands) {
+        memory_model_.push_back(Instruction{op, std::move(operands)});
     }
     /// @returns the memory model
     const InstructionList& memory_model() const { return memory_model_; }
     /// Adds an instruction to the entry points
     /// @param op the op to set
     /// @param operands the operands for the instruction
-    void push_entry_point(spv::Op op, const OperandList& operands) {
-        entry_points_.push_back(Instruction{op, operands});
+    void push_entry_point(spv::Op op, OperandList operands) {
+        entry_points_.push_back(Instruction{op, std::move(operands)});
     }
     /// @returns the entry points
     const InstructionList& entry_points() const { return entry_points_; }
     /// Adds an instruction to the execution modes
     /// @param op the op to set
     /// @param operands the operands for the instruction
-    void push_execution_mode(spv::Op op, const OperandList& operands) {
-        execution_modes_.push_back(Instruction{op, operands});
+    void push_execution_mode(spv::Op op, OperandList operands) {
+        execution_modes_.push_back(Instruction{op, std::move(operands)});
     }
     /// @returns the execution modes
     const InstructionList& execution_modes() const { return execution_modes_; }
     /// Adds an instruction to the debug
     /// @param op the op to set
     /// @param operands the operands for the instruction
-    void push_debug(spv::Op op, const OperandList& operands) {
-        debug_.push_back(Instruction{op, operands});
+    void push_debug(spv::Op op, OperandList operands) {
+        debug_.push_back(Instruction{op, std::move(operands)});
     }
     /// @returns the debug instructions
     const InstructionList& debug() const { return debug_; }
     /// Adds an instruction to the types
     /// @param op the op to set
     /// @param operands the operands for the instruction
-    void push_type(spv::Op op, const OperandList& operands) {
-        types_.push_back(Instruction{op, operands});
+    void push_type(spv::Op op, OperandList operands) {
+        types_.push_back(Instruction{op, std::move(operands)});
     }
     /// @returns the type instructions
     const InstructionList& types() const { return types_; }
     /// Adds an instruction to the annotations
     /// @param op the op to set
     /// @param operands the operands for the instruction
-    void push_annot(spv::Op op, const OperandList& operands) {
-        annotations_.push_back(Instruction{op, operands});
+    void push_annot(spv::Op op, OperandList operands) {
+        annotations_.push_back(Instruction{op, std::move(operands)});
     }
     /// @returns the annotations
     const InstructionList& annots() const { return annotations_; }
 
     /// Adds a function to the builder
     /// @param func the function to add
-    void push_function(const Function& func) {
-        functions_.push_back(func);
+    void push_function(Function func) {
         current_label_id_ = func.label_id();
+        functions_.push_back(std::move(func));
     }
     /// @returns the functions
     const std::vector<Function>& functions() const { return functions_; }
@@ -188,15 +189,15 @@ class Builder {
     /// @param op the operation
     /// @param operands the operands
     /// @returns true if we succeeded
-    bool push_function_inst(spv::Op op, const OperandList& operands);
+    bool push_function_inst(spv::Op op, OperandList operands);
     /// Pushes a variable to the current function
     /// @param operands the variable operands
-    void push_function_var(const OperandList& operands) {
+    void push_function_var(OperandList operands) {
         if (functions_.empty()) {
             TINT_ICE(Writer, builder_.Diagnostics())
                 << "push_function_var() called without a function";
         }
-        functions_.back().push_var(operands);
+        functions_.back().push_var(std::move(operands));
     }
 
     /// @returns true if the current instruction insertion point is
@@ -466,6 +467,13 @@ class Builder {
     /// @param type the type to create
     /// @returns the ID to use for the given type. Returns 0 on unknown type.
     uint32_t GenerateTypeIfNeeded(const sem::Type* type);
+    /// @param type the type to look up
+    /// @returns the SPIR-V type id registered for `type`, or 0 if none has been registered
+    uint32_t LookupTypeId(const sem::Type* type) const;
+    /// Registers `id` as the SPIR-V type id for `type`
+    /// @param type the type to register
+    /// @param id the SPIR-V type id
+    void RegisterTypeId(const sem::Type* type, uint32_t id);
     /// Generates a texture type declaration
     /// @param texture the texture to generate
     /// @param result the result operand
@@ -616,7 +624,8 @@ class Builder {
     std::unordered_map<std::string, uint32_t> import_name_to_id_;
     std::unordered_map<Symbol, uint32_t> func_symbol_to_id_;
     std::unordered_map<sem::CallTargetSignature, uint32_t> func_sig_to_id_;
-    std::unordered_map<const sem::Type*, uint32_t> type_to_id_;
+    // SPIR-V type ids, indexed by sem::Type::UniqueID(). 0 means not yet generated.
+    std::vector<uint32_t> type_to_id_;
     std::unordered_map<ScalarConstant, uint32_t> const_to_id_;
     std::unordered_map<const sem::Type*, uint32_t> const_null_to_id_;
     std::unordered_map<uint64_t, uint32_t> const_splat_to_id_;
@@ -16,6 +16,7 @@
 #define SRC_TINT_WRITER_SPIRV_FUNCTION_H_
 
 #include <functional>
+#include <utility>
 
 #include "src/tint/writer/spirv/instruction.h"
 
@@ -32,12 +33,13 @@ class Function {
     /// @param declaration the function declaration
     /// @param label_op the operand for function's entry block label
     /// @param params the function parameters
-    Function(const Instruction& declaration,
-             const Operand& label_op,
-             const InstructionList& params);
+    Function(Instruction declaration, Operand label_op, InstructionList params);
     /// Copy constructor
     /// @param other the function to copy
     Function(const Function& other);
+    /// Move constructor
+    /// @param other the function to move
+    Function(Function&& other);
     ~Function();
 
     /// Iterates over the function call the cb on each instruction
@@ -53,16 +55,16 @@ class Function {
     /// Adds an instruction to the instruction list
     /// @param op the op to set
     /// @param operands the operands for the instruction
-    void push_inst(spv::Op op, const OperandList& operands) {
-        instructions_.push_back(Instruction{op, operands});
+    void push_inst(spv::Op op, OperandList operands) {
+        instructions_.push_back(Instruction{op, std::move(operands)});
     }
     /// @returns the instruction list
     const InstructionList& instructions() const { return instructions_; }
 
     /// Adds a variable to the variable list
     /// @param operands the operands for the variable
-    void push_var(const OperandList& operands) {
-        vars_.push_back(Instruction{spv::Op::OpVariable, operands});
+    void push_var(OperandList operands) {
+        vars_.push_back(Instruction{spv::Op::OpVariable, std::move(operands)});
     }
     /// @returns the variable list
     const InstructionList& variables() const { return vars_; }
@@ -31,6 +31,8 @@ class Instruction {
     Instruction(spv::Op op, OperandList operands);
     /// Copy Constructor
     Instruction(const Instruction&);
+    /// Move Constructor
+    Instruction(Instruction&&);
     ~Instruction();
 
     /// @returns the instructions op
@@ -76,6 +76,10 @@ void TextGenerator::TextBuffer::Append(const std::string& line) {
     lines.emplace_back(Line{current_indent, line});
 }
 
+void TextGenerator::TextBuffer::Append(std::string&& line) {
+    lines.emplace_back(Line{current_indent, std::move(line)});
+}
+
 void TextGenerator::TextBuffer::Insert(const std::string& line, size_t before, uint32_t indent) {
     if (before >= lines.size()) {
         diag::List d;
@@ -89,6 +93,7 @@ void TextGenerator::TextBuffer::Insert(const std::string& line, size_t before, u
 }
 
 void TextGenerator::TextBuffer::Append(const TextBuffer& tb) {
+    lines.reserve(lines.size() + tb.lines.size());
     for (auto& line : tb.lines) {
         // TODO(bclayton): inefficient, consider optimizing
         lines.emplace_back(Line{current_indent + line.indent, line.content});
@@ -114,17 +119,24 @@ void TextGenerator::TextBuffer::Insert(const TextBuffer& tb, size_t before, uint
 }
 
 std::string TextGenerator::TextBuffer::String(uint32_t indent /* = 0 */) const {
-    std::stringstream ss;
+    // Measure first so the result is built in a single allocation.
+    size_t len = 0;
     for (auto& line : lines) {
         if (!line.content.empty()) {
-            for (uint32_t i = 0; i < indent + line.indent; i++) {
-                ss << " ";
-            }
-            ss << line.content;
+            len += indent + line.indent + line.content.size();
         }
-        ss << std::endl;
+        len += 1;  // '\n'
     }
-    return ss.str();
+    std::string str;
+    str.reserve(len);
+    for (auto& line : lines) {
+        if (!line.content.empty()) {
+            str.append(indent + line.indent, ' ');
+            str.append(line.content);
+        }
+        str.push_back('\n');
+    }
+    return str;
 }
 
 TextGenerator::ScopedParen::ScopedParen(std::ostream& stream) : s(stream) {
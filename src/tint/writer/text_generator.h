@@ -57,6 +57,10 @@ class TextGenerator {
         /// @param line the line to append to the TextBuffer
         void Append(const std::string& line);
 
+        /// Appends the line to the end of the TextBuffer
+        /// @param line the line to append to the TextBuffer
+        void Append(std::string&& line);
+
         /// Inserts the line to the TextBuffer before the line with index `before`
         /// @param line the line to append to the TextBuffer
         /// @param before the zero-based index of the line to insert the text before